@@ -112,7 +112,7 @@ entity AddressResolutionProcess is
     siIPTX_MacLkpReq_TVALID          : in    std_logic;
     siIPTX_MacLkpReq_TREADY          : out   std_logic;
     --     
-    soIPTX_MacLkpRep_TDATA           : out   std_logic_vector(55 downto 0); -- (8+48)-1=55={Hit+MacValue}
+    soIPTX_MacLkpRep_TDATA           : out   std_logic_vector(55 downto 0); -- (8+48)-1=55={Epoch+Hit+MacValue}
     soIPTX_MacLkpRep_TVALID          : out   std_logic;
     soIPTX_MacLkpRep_TREADY          : in    std_logic
   );
@@ -151,7 +151,7 @@ architecture Structural of AddressResolutionProcess is
       siIPTX_MacLkpReq_TVALID : in  std_logic;
       siIPTX_MacLkpReq_TREADY : out std_logic;
       --   
-      soIPTX_MacLkpRep_TDATA  : out std_logic_vector(55 downto 0); -- (8+48)-1=55={Hit+MacValue}
+      soIPTX_MacLkpRep_TDATA  : out std_logic_vector(55 downto 0); -- (8+48)-1=55={Epoch+Hit+MacValue}
       soIPTX_MacLkpRep_TVALID : out std_logic;
       soIPTX_MacLkpRep_TREADY : in  std_logic;
       -- CAM Interfaces
@@ -197,7 +197,7 @@ architecture Structural of AddressResolutionProcess is
       siIPTX_MacLkpReq_V_V_TVALID : in  std_logic;
       siIPTX_MacLkpReq_V_V_TREADY : out std_logic;
       --   
-      soIPTX_MacLkpRep_V_TDATA  : out std_logic_vector(55 downto 0); -- (8+48)-1=55={Hit+MacValue}
+      soIPTX_MacLkpRep_V_TDATA  : out std_logic_vector(55 downto 0); -- (8+48)-1=55={Epoch+Hit+MacValue}
       soIPTX_MacLkpRep_V_TVALID : out std_logic;
       soIPTX_MacLkpRep_V_TREADY : in  std_logic;
       -- CAM Interfaces
@@ -66,8 +66,7 @@ add_files     ${srcDir}/tss.cpp
 add_files     ${srcDir}/tss.hpp
 add_files     ${srcDir}/hss.cpp
 add_files     ${srcDir}/hss.hpp
-add_files     ${srcDir}/cam8.hpp
-#add_files     ${srcDir}/cam16.hpp
+add_files     ${srcDir}/cam.hpp
 add_files     ${srcDir}/../../../../../hls/network.hpp
 add_files     ${srcDir}/../../network_utils.hpp
 add_files     ${srcDir}/../../network_utils.cpp
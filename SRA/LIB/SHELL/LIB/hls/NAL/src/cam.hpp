@@ -0,0 +1,509 @@
+/*******************************************************************************
+ * Copyright 2016 -- 2021 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+/*****************************************************************************
+ * @file       : cam.hpp
+ * @brief      : Parameterised Content Address Memories (CAM).
+ *
+ * System:     : cloudFPGA
+ * Component   : Shell, Network Abstraction Layer (NAL)
+ * Language    : Vivado HLS
+ *
+ * @details    : This file provides two flavours of CAM:
+ *  - CamN<K,V,N>         : A fully-associative CAM of N entries held in
+ *                          registers. All the entries are compared in
+ *                          parallel and the lowest matching (or free) index
+ *                          is selected by a priority encoder. Use it for
+ *                          small N (e.g. up to 64).
+ *  - HashCam<K,V,N,WAYS> : A set-associative CAM of N entries held in
+ *                          WAYS memory banks. A key is hashed into one of
+ *                          N/WAYS sets and only the WAYS entries of that set
+ *                          are compared. Use it for large N. The number of
+ *                          sets is rounded up to a power of two.
+ *  - CamSel<K,V,N,HASHED> : Selects one of the two flavours above at compile
+ *                          time, such that a cache can follow a configurable
+ *                          size.
+ *
+ * \ingroup NAL
+ * \addtogroup NAL
+ * \{
+ *****************************************************************************/
+
+
+#ifndef _NAL_CAM_H_
+#define _NAL_CAM_H_
+
+#include <stdio.h>
+#include <string>
+#include <stdint.h>
+#include "ap_int.h"
+
+#ifndef _NAL_KVP_DEF_
+#define _NAL_KVP_DEF_
+template<typename K, typename V>
+struct KeyValuePair {
+  public:
+    K   key;
+    V   value;
+    bool      valid;
+    KeyValuePair() {
+      key = 0x0;
+      value = 0x0;
+      valid = false;
+    }
+    KeyValuePair(K key, V value) :
+      key(key), value(value), valid(true) {}
+    KeyValuePair(K key, V value, bool valid) :
+      key(key), value(value), valid(valid) {}
+};
+#endif
+
+/*******************************************************************************
+ * @brief Return the index of the least significant bit set in a vector.
+ *
+ * @param[in]  vec  The vector to encode.
+ *
+ * @return the index of the first bit set, or -1 if none is set.
+ *******************************************************************************/
+template<int N>
+int camPriorityEncode(ap_uint<N> vec)
+{
+#pragma HLS INLINE
+  int idx = -1;
+  for (int i = N-1; i >= 0; i--) {
+#pragma HLS UNROLL
+    if (vec[i] == 1) {
+      idx = i;
+    }
+  }
+  return idx;
+}
+
+/*******************************************************************************
+ * @brief Round X up to a power of two at compile time (e.g. the number of
+ *         sets of a HashCam, which is masked out of the hash of a key).
+ *******************************************************************************/
+template<int X, int P=1, bool DONE=(P >= X)>
+struct CamPow2Ceil {
+    static const int value = CamPow2Ceil<X, 2*P>::value;
+};
+
+template<int X, int P>
+struct CamPow2Ceil<X, P, true> {
+    static const int value = P;
+};
+
+
+/*******************************************************************************
+ *
+ * FULLY-ASSOCIATIVE CAM
+ *
+ *******************************************************************************/
+template<typename K, typename V, int N>
+struct CamN {
+  protected:
+    KeyValuePair<K,V> CamArray[N];
+
+    /*******************************************************************************
+     * @brief Compare all the valid entries against a key.
+     *
+     * @param[in]  key  The key to compare.
+     *
+     * @return a vector with a bit set for every matching entry.
+     *******************************************************************************/
+    ap_uint<N> matchKey(K key)
+    {
+#pragma HLS INLINE
+      ap_uint<N> match = 0;
+      for (int i = 0; i < N; i++) {
+#pragma HLS UNROLL
+        match[i] = (CamArray[i].valid == true) && (CamArray[i].key == key);
+      }
+      return match;
+    }
+
+    /*******************************************************************************
+     * @brief Compare all the valid entries against a value.
+     *
+     * @param[in]  value  The value to compare.
+     *
+     * @return a vector with a bit set for every matching entry.
+     *******************************************************************************/
+    ap_uint<N> matchValue(V value)
+    {
+#pragma HLS INLINE
+      ap_uint<N> match = 0;
+      for (int i = 0; i < N; i++) {
+#pragma HLS UNROLL
+        match[i] = (CamArray[i].valid == true) && (CamArray[i].value == value);
+      }
+      return match;
+    }
+
+  public:
+    CamN() {
+#pragma HLS ARRAY_PARTITION variable=CamArray complete dim=1
+#pragma HLS pipeline II=1
+      for (int i = 0; i < N; i++) {
+#pragma HLS UNROLL
+        CamArray[i].valid = false;
+      }
+    }
+    /*******************************************************************************
+     * @brief Search the CAM array for a key.
+     *
+     * @param[in]  key   The key to lookup.
+     * @param[out] value The value corresponding to that key.
+     *
+     * @return true if the the key was found.
+     *******************************************************************************/
+    bool lookup(K key, V &value)
+    {
+#pragma HLS pipeline II=1
+#pragma HLS INLINE
+      int idx = camPriorityEncode<N>(matchKey(key));
+      if (idx != -1) {
+        value = CamArray[idx].value;
+        return true;
+      }
+      return false;
+    }
+
+    /*******************************************************************************
+     * @brief Reverse-search the CAM array for a key to a value.
+     *
+     * @param[in]  value   The value to lookup.
+     * @param[out] key     The key corresponding to that value (or the first match).
+     *
+     * @return true if the the key was found.
+     *******************************************************************************/
+    bool reverse_lookup(V value, K &key)
+    {
+#pragma HLS pipeline II=1
+#pragma HLS INLINE
+      int idx = camPriorityEncode<N>(matchValue(value));
+      if (idx != -1) {
+        key = CamArray[idx].key;
+        return true;
+      }
+      return false;
+    }
+
+    /*******************************************************************************
+     * @brief Insert a new key-value pair in the CAM array.
+     *
+     * @param[in]  KeyValuePair  The key-value pair to insert.
+     *
+     * @return true if the the key was inserted.
+     *******************************************************************************/
+    bool insert(KeyValuePair<K,V> kVP)
+    {
+#pragma HLS pipeline II=1
+#pragma HLS INLINE
+      ap_uint<N> freeVec = 0;
+      for (int i = 0; i < N; i++) {
+#pragma HLS UNROLL
+        freeVec[i] = (CamArray[i].valid == false);
+      }
+      int idx = camPriorityEncode<N>(freeVec);
+      if (idx != -1) {
+        CamArray[idx] = kVP;
+        return true;
+      }
+      return false;
+    }
+
+    bool insert(K key, V value)
+    {
+#pragma HLS INLINE
+      return insert(KeyValuePair<K,V>(key,value,true));
+    }
+
+    /*******************************************************************************
+     * @brief Search the CAM array for a key and updates the corresponding value.
+     *
+     * @param[in]  key   The key to lookup.
+     * @param[out] value The new value for that key
+     *
+     * @return true if the the key was found and updated
+     *******************************************************************************/
+    bool update(K key, V value)
+    {
+#pragma HLS pipeline II=1
+#pragma HLS INLINE
+      int idx = camPriorityEncode<N>(matchKey(key));
+      if (idx != -1) {
+        CamArray[idx].value = value;
+        return true;
+      }
+      return false;
+    }
+
+    bool update(KeyValuePair<K,V> kVP)
+    {
+#pragma HLS INLINE
+      return update(kVP.key, kVP.value);
+    }
+
+    /*******************************************************************************
+     * @brief Remove a key-value pair from the CAM array.
+     *
+     * @param[in]  key  The key of the entry to be removed.
+     *
+     * @return true if the the key was deleted.
+     ******************************************************************************/
+    bool deleteEntry(K key)
+    {
+#pragma HLS pipeline II=1
+#pragma HLS INLINE
+      int idx = camPriorityEncode<N>(matchKey(key));
+      if (idx != -1) {
+        CamArray[idx].valid = false;
+        return true;
+      }
+      return false;
+    }
+
+    /*******************************************************************************
+     * @brief Invalidate all entries of the CAM array.
+     *
+     ******************************************************************************/
+    void reset()
+    {
+#pragma HLS pipeline II=1
+#pragma HLS INLINE
+      for (int i = 0; i < N; i++) {
+#pragma HLS UNROLL
+        CamArray[i].valid = false;
+      }
+    }
+
+    /*******************************************************************************
+     * @brief Invalidate all entries of the CAM array (same interface as HashCam).
+     *
+     * @return true, since the entire array is invalidated at once.
+     ******************************************************************************/
+    bool resetStep()
+    {
+#pragma HLS INLINE
+      reset();
+      return true;
+    }
+};
+
+
+/*******************************************************************************
+ *
+ * SET-ASSOCIATIVE (HASHED) CAM
+ *
+ *******************************************************************************
+ * The key is XOR-folded into a set index, and only the WAYS entries of that
+ *  set are compared in parallel. Every way is stored in its own memory bank,
+ *  which keeps the cost of a lookup independent of N. The N/WAYS sets are
+ *  rounded up to a power of two, such that the set index is a mask of the hash.
+ * A key whose set is full is not inserted. The caller must handle the 'false'
+ *  returned by 'insert()'.
+ * A reverse lookup would require a scan of all the sets and is therefore not
+ *  supported by this flavour. Also, the reset of the table is sequential (one
+ *  set per call of 'resetStep()').
+ *******************************************************************************/
+template<typename K, typename V, int N, int WAYS=4>
+struct HashCam {
+  protected:
+    static const int SETS = CamPow2Ceil<(N+WAYS-1)/WAYS>::value;
+    typedef char HashCam_sets_must_be_a_power_of_two[((SETS & (SETS-1)) == 0) ? 1 : -1];
+    KeyValuePair<K,V> CamArray[WAYS][SETS];
+    int               resetIdx;
+
+    /*******************************************************************************
+     * @brief Compute the set index of a key.
+     *******************************************************************************/
+    int hash(K key)
+    {
+#pragma HLS INLINE
+      ap_uint<64> vec  = key;
+      ap_uint<32> fold = vec(31,0) ^ vec(63,32);
+      fold = fold ^ (fold >> 16);
+      return (fold.to_uint() & (SETS-1));
+    }
+
+    /*******************************************************************************
+     * @brief Compare the valid entries of a set against a key.
+     *******************************************************************************/
+    ap_uint<WAYS> matchKey(int set, K key)
+    {
+#pragma HLS INLINE
+      ap_uint<WAYS> match = 0;
+      for (int w = 0; w < WAYS; w++) {
+#pragma HLS UNROLL
+        match[w] = (CamArray[w][set].valid == true) && (CamArray[w][set].key == key);
+      }
+      return match;
+    }
+
+  public:
+    HashCam() {
+#pragma HLS ARRAY_PARTITION variable=CamArray complete dim=1
+      resetIdx = 0;
+      for (int s = 0; s < SETS; s++) {
+        for (int w = 0; w < WAYS; w++) {
+#pragma HLS UNROLL
+          CamArray[w][s].valid = false;
+        }
+      }
+    }
+
+    /*******************************************************************************
+     * @brief Search the CAM for a key.
+     *
+     * @param[in]  key   The key to lookup.
+     * @param[out] value The value corresponding to that key.
+     *
+     * @return true if the the key was found.
+     *******************************************************************************/
+    bool lookup(K key, V &value)
+    {
+#pragma HLS pipeline II=1
+#pragma HLS INLINE
+      int set = hash(key);
+      int way = camPriorityEncode<WAYS>(matchKey(set, key));
+      if (way != -1) {
+        value = CamArray[way][set].value;
+        return true;
+      }
+      return false;
+    }
+
+    /*******************************************************************************
+     * @brief Insert a new key-value pair in the CAM.
+     *
+     * @param[in]  KeyValuePair  The key-value pair to insert.
+     *
+     * @return true if the the key was inserted, false if its set is full.
+     *******************************************************************************/
+    bool insert(KeyValuePair<K,V> kVP)
+    {
+#pragma HLS pipeline II=1
+#pragma HLS INLINE
+      int set = hash(kVP.key);
+      ap_uint<WAYS> freeVec = 0;
+      for (int w = 0; w < WAYS; w++) {
+#pragma HLS UNROLL
+        freeVec[w] = (CamArray[w][set].valid == false);
+      }
+      int way = camPriorityEncode<WAYS>(freeVec);
+      if (way != -1) {
+        CamArray[way][set] = kVP;
+        return true;
+      }
+      return false;
+    }
+
+    bool insert(K key, V value)
+    {
+#pragma HLS INLINE
+      return insert(KeyValuePair<K,V>(key,value,true));
+    }
+
+    /*******************************************************************************
+     * @brief Search the CAM for a key and updates the corresponding value.
+     *
+     * @param[in]  key   The key to lookup.
+     * @param[out] value The new value for that key
+     *
+     * @return true if the the key was found and updated
+     *******************************************************************************/
+    bool update(K key, V value)
+    {
+#pragma HLS pipeline II=1
+#pragma HLS INLINE
+      int set = hash(key);
+      int way = camPriorityEncode<WAYS>(matchKey(set, key));
+      if (way != -1) {
+        CamArray[way][set].value = value;
+        return true;
+      }
+      return false;
+    }
+
+    bool update(KeyValuePair<K,V> kVP)
+    {
+#pragma HLS INLINE
+      return update(kVP.key, kVP.value);
+    }
+
+    /*******************************************************************************
+     * @brief Remove a key-value pair from the CAM.
+     *
+     * @param[in]  key  The key of the entry to be removed.
+     *
+     * @return true if the the key was deleted.
+     ******************************************************************************/
+    bool deleteEntry(K key)
+    {
+#pragma HLS pipeline II=1
+#pragma HLS INLINE
+      int set = hash(key);
+      int way = camPriorityEncode<WAYS>(matchKey(set, key));
+      if (way != -1) {
+        CamArray[way][set].valid = false;
+        return true;
+      }
+      return false;
+    }
+
+    /*******************************************************************************
+     * @brief Invalidate one set of the CAM.
+     *
+     * @return true when the last set was invalidated.
+     ******************************************************************************/
+    bool resetStep()
+    {
+#pragma HLS pipeline II=1
+#pragma HLS INLINE
+      for (int w = 0; w < WAYS; w++) {
+#pragma HLS UNROLL
+        CamArray[w][resetIdx].valid = false;
+      }
+      if (resetIdx == SETS-1) {
+        resetIdx = 0;
+        return true;
+      }
+      resetIdx++;
+      return false;
+    }
+};
+
+
+/*******************************************************************************
+ * Compile-time selection of the CAM flavour.
+ *  Both flavours provide 'lookup', 'insert', 'update', 'deleteEntry' and
+ *  'resetStep'.
+ *******************************************************************************/
+template<typename K, typename V, int N, bool HASHED>
+struct CamSel {
+    typedef CamN<K,V,N>      type;
+};
+
+template<typename K, typename V, int N>
+struct CamSel<K,V,N,true> {
+    typedef HashCam<K,V,N,4> type;
+};
+
+
+#endif
+
+/*! \} */
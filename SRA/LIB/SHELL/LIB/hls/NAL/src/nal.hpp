@@ -93,6 +93,9 @@
 //#define MAX_MRT_SIZE 128
 #define MAX_MRT_SIZE 64
 
+//number of NodeId/IPv4 pairs cached by the UDP sub-system (one CamN per direction)
+#define NAL_MRT_CACHE_SIZE (MAX_MRT_SIZE)
+
 
 #include "../../FMC/src/fmc.hpp"
 
@@ -184,6 +187,8 @@ enum NalCntIncType {NID_MISS_RX = 0, NID_MISS_TX, PCOR_TX, TCP_CON_FAIL, LAST_RX
 
 
 #define MAX_NAL_SESSIONS (TOE_MAX_SESSIONS)
+//the session-length CAM of pTcpRRh becomes set-associative beyond that many sessions
+#define NAL_CAM_HASH_THRESHOLD 64
 #define NAL_STREAMING_SPLIT_TCP (ZYC2_MSS)
 //#define NAL_STREAMING_SPLIT_TCP (ZYC2_MSS - 8)
 
@@ -336,8 +341,7 @@ uint8_t extractByteCnt(NetworkWord currWord);
 #include "uss.hpp"
 #include "tss.hpp"
 #include "hss.hpp"
-#include "cam8.hpp"
-//#include "cam16.hpp"
+#include "cam.hpp"
 
 void nal_main(
     // ----- link to FMC -----
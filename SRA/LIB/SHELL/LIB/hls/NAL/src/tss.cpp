@@ -243,19 +243,15 @@ void pTcpRRh(
 #pragma HLS RESET variable=rrhFsmState
 
   //-- STATIC DATAFLOW VARIABLES --------------------------------------------
-  static Cam8<SessionId,TcpDatLen> sessionLength = Cam8<SessionId,TcpDatLen>();
-#ifndef __SYNTHESIS__
-  if(MAX_NAL_SESSIONS != 8)
-  {
-    printf("\n\t\tERROR: pTcpRRh is currently configured to support only 8 parallel sessions! Abort.\n(Currently, the use of \'Cam8\' must be updated accordingly by hand.)\n");
-    exit(-1);
-  }
-#endif
+  typedef CamSel<SessionId,TcpDatLen,MAX_NAL_SESSIONS,(MAX_NAL_SESSIONS > NAL_CAM_HASH_THRESHOLD)>::type SessionLengthCam;
+  static SessionLengthCam sessionLength = SessionLengthCam();
 
   static stream<NalWaitingData> waitingSessions ("sTcpRRh_WaitingSessions");
   static stream<NalWaitingData> session_reinsert ("sTcpRRh_sessions_to_reinsert");
+  static stream<TcpAppNotif> notif_retry ("sTcpRRh_notifs_to_retry");
 #pragma HLS STREAM variable=waitingSessions  depth=8
 #pragma HLS STREAM variable=session_reinsert  depth=8
+#pragma HLS STREAM variable=notif_retry  depth=8
 
   static TcpDatLen waiting_length = 0;
   static TcpAppNotif notif_pRrh = TcpAppNotif();
@@ -272,17 +268,21 @@ void pTcpRRh(
   static PacketLen fmc_fifo_free_cnt = NAL_MAX_FIFO_DEPTHS_BYTES;
 
   //-- LOCAL DATAFLOW VARIABLES ---------------------------------------------
+  bool retry_later = false;
 
   switch(rrhFsmState)
   {
     default:
     case RRH_RESET:
-      sessionLength.reset();
-      go_back_to_ack_wait_fmc = false;
-      go_back_to_ack_wait_role = false;
-      role_fifo_free_cnt = NAL_MAX_FIFO_DEPTHS_BYTES;
-      fmc_fifo_free_cnt = NAL_MAX_FIFO_DEPTHS_BYTES;
-      rrhFsmState = RRH_WAIT_NOTIF;
+      //the HashCam flavour is invalidated one set per cycle
+      if(sessionLength.resetStep())
+      {
+        go_back_to_ack_wait_fmc = false;
+        go_back_to_ack_wait_role = false;
+        role_fifo_free_cnt = NAL_MAX_FIFO_DEPTHS_BYTES;
+        fmc_fifo_free_cnt = NAL_MAX_FIFO_DEPTHS_BYTES;
+        rrhFsmState = RRH_WAIT_NOTIF;
+      }
       break;
     case RRH_WAIT_NOTIF:
       if(*layer_4_enabled == 0 || *piNTS_ready == 0)
@@ -329,10 +329,19 @@ void pTcpRRh(
       {
         rrhFsmState = RRH_START_REQUEST;
       }
+      else if(!notif_retry.empty()
+          && !go_back_to_ack_wait_fmc && !go_back_to_ack_wait_role
+          )
+      {
+        //no session is waiting anymore, hence the waiting table is empty
+        notif_retry.read(notif_pRrh);
+        already_waiting = sessionLength.lookup(notif_pRrh.sessionID, waiting_length);
+        rrhFsmState = RRH_PROCESS_NOTIF;
+      }
       break;
     case RRH_PROCESS_NOTIF:
       if(!waitingSessions.full() && !sAddNewTriple_TcpRrh.full()
-          && !sMarkAsPriv.full()
+          && !sMarkAsPriv.full() && !notif_retry.full()
         )
       {
         if(already_waiting)
@@ -340,16 +349,13 @@ void pTcpRRh(
           sessionLength.update(notif_pRrh.sessionID, notif_pRrh.tcpDatLen + waiting_length);
           printf("[TCP-RRH] adding %d to waiting sessions for session %d.\n",(int) notif_pRrh.tcpDatLen, (int) notif_pRrh.sessionID);
 
+        } else if(!sessionLength.insert(notif_pRrh.sessionID, notif_pRrh.tcpDatLen))
+        {
+          //the set of this session is full (HashCam flavour), retry once the waiting sessions are served
+          notif_retry.write(notif_pRrh);
+          retry_later = true;
+          printf("[TCP-RRH] no space left in the waiting table for session %d, will retry later.\n", (int) notif_pRrh.sessionID);
         } else {
-          sessionLength.insert(notif_pRrh.sessionID, notif_pRrh.tcpDatLen);
-          //bool found_slot = sessionLength.insert(notif_pRrh.sessionID, notif_pRrh.tcpDatLen);
-          //if(!found_slot)
-          //{
-          //  //we have a problem...
-          //  //but shouldn't happen actually since we have the same size as the table in TOE...
-          //  printf("[TCP-RRH:PANIC] We don't have space left in the waiting table...\n");
-          //  break;
-          //} else {
           NalNewTableEntry ne_struct = NalNewTableEntry(newTriple(notif_pRrh.ip4SrcAddr, notif_pRrh.tcpSrcPort, notif_pRrh.tcpDstPort),
               notif_pRrh.sessionID);
           sAddNewTriple_TcpRrh.write(ne_struct);
@@ -362,7 +368,6 @@ void pTcpRRh(
           NalWaitingData new_sess = NalWaitingData(notif_pRrh.sessionID, is_fmc);
           waitingSessions.write(new_sess);
           printf("[TCP-RRH] adding %d with %d bytes as new waiting session.\n", (int) notif_pRrh.sessionID, (int) notif_pRrh.tcpDatLen);
-          //}
         }
         if(go_back_to_ack_wait_fmc)
         {
@@ -371,6 +376,11 @@ void pTcpRRh(
         else if(go_back_to_ack_wait_role)
         {
           rrhFsmState = RRH_WAIT_ROLE;
+        }
+        else if(retry_later)
+        {
+          //the full set may belong to sessions to reinsert
+          rrhFsmState = RRH_WAIT_NOTIF;
         } else {
           rrhFsmState = RRH_START_REQUEST;
         }
@@ -533,6 +543,10 @@ void pTcpRRh(
         {
           session_reinsert.read();
         }
+        if(!notif_retry.empty())
+        {
+          notif_retry.read();
+        }
         if(!fmc_write_cnt_sig.empty())
         {
           fmc_write_cnt_sig.read();
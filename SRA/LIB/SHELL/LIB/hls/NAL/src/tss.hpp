@@ -41,7 +41,7 @@
 #include <stdint.h>
 
 #include "nal.hpp"
-#include "cam8.hpp"
+#include "cam.hpp"
 
 using namespace hls;
 
@@ -69,15 +69,9 @@ void pUdpTX(
 
   //-- STATIC CONTROL VARIABLES (with RESET) --------------------------------
   static FsmStateUdp fsmStateTX_Udp = FSM_RESET;
-  static NodeId cached_nodeid_udp_tx = UNUSED_SESSION_ENTRY_VALUE;
-  static Ip4Addr cached_ip4addr_udp_tx = 0;
-  static bool cache_init = false;
   static uint8_t evs_loop_i = 0;
 
 #pragma HLS RESET variable=fsmStateTX_Udp
-#pragma HLS RESET variable=cached_nodeid_udp_tx
-#pragma HLS RESET variable=cached_ip4addr_udp_tx
-#pragma HLS RESET variable=cache_init
 #pragma HLS RESET variable=evs_loop_i
 
   //-- STATIC DATAFLOW VARIABLES --------------------------------------------
@@ -89,6 +83,7 @@ void pUdpTX(
   static UdpAppMeta txMeta;
   static NrcPort src_port;
   static NrcPort dst_port;
+  static CamN<NodeId,Ip4Addr,NAL_MRT_CACHE_SIZE> udpTxCache = CamN<NodeId,Ip4Addr,NAL_MRT_CACHE_SIZE>();
 
   static stream<NalEventNotif> evsStreams[6];
 
@@ -102,7 +97,7 @@ void pUdpTX(
       fsmStateTX_Udp = FSM_W8FORMETA;
       udpTX_packet_length = 0;
       udpTX_current_packet_length = 0;
-      cache_init = false;
+      udpTxCache.reset();
       break;
 
     case FSM_W8FORMETA:
@@ -110,9 +105,7 @@ void pUdpTX(
       {
         if(cache_inval_sig.read())
         {
-          cache_init = false; 
-          cached_nodeid_udp_tx = UNUSED_SESSION_ENTRY_VALUE;
-          cached_ip4addr_udp_tx = 0;
+          udpTxCache.reset();
         }
         break;
       }
@@ -153,9 +146,8 @@ void pUdpTX(
         txMeta = UdpAppMeta(*ipAddrBE, src_port, 0, dst_port);
 
         //request ip if necessary
-        if(cache_init && cached_nodeid_udp_tx == dst_rank)
+        if(udpTxCache.lookup(dst_rank, dst_ip_addr))
         {
-          dst_ip_addr = cached_ip4addr_udp_tx;
           fsmStateTX_Udp = FSM_FIRST_ACC;
           printf("used UDP TX id cache\n");
         } else {
@@ -172,9 +164,11 @@ void pUdpTX(
       {
         dst_ip_addr = sGetIpRep_UdpTx.read();
         //TODO: need new FSM states
-        cached_nodeid_udp_tx = dst_rank;
-        cached_ip4addr_udp_tx = dst_ip_addr;
-        cache_init = true;
+        if(!udpTxCache.insert(dst_rank, dst_ip_addr))
+        { //cache is full, start over
+          udpTxCache.reset();
+          udpTxCache.insert(dst_rank, dst_ip_addr);
+        }
         fsmStateTX_Udp = FSM_FIRST_ACC;
       }
       break;
@@ -487,17 +481,11 @@ void pUdpRx(
 
   //-- STATIC CONTROL VARIABLES (with RESET) --------------------------------
   static FsmStateUdp fsmStateRX_Udp = FSM_W8FORMETA;
-  static NodeId cached_udp_rx_id = 0;
-  static Ip4Addr cached_udp_rx_ipaddr = 0;
   static NodeId own_rank = 0;
-  static bool cache_init = false;
   static uint8_t evs_loop_i = 0;
 
 #pragma HLS RESET variable=fsmStateRX_Udp
-#pragma HLS RESET variable=cached_udp_rx_id
-#pragma HLS RESET variable=cached_udp_rx_ipaddr
 #pragma HLS RESET variable=own_rank
-#pragma HLS RESET variable=cache_init
 #pragma HLS RESET variable=evs_loop_i
 
   //-- STATIC DATAFLOW VARIABLES --------------------------------------------
@@ -505,6 +493,7 @@ void pUdpRx(
   static UdpAppDLen udpRxLen;
   static NodeId src_id = INVALID_MRT_VALUE;
   static NetworkMeta in_meta;
+  static CamN<Ip4Addr,NodeId,NAL_MRT_CACHE_SIZE> udpRxCache = CamN<Ip4Addr,NodeId,NAL_MRT_CACHE_SIZE>();
 
   static stream<NalEventNotif> evsStreams[4];
 
@@ -525,9 +514,7 @@ void pUdpRx(
       {
         if(cache_inval_sig.read())
         {
-          cached_udp_rx_id = 0;
-          cached_udp_rx_ipaddr = 0;
-          cache_init = false;
+          udpRxCache.reset();
         }
         break;
       } else if(!sConfigUpdate.empty())
@@ -536,9 +523,7 @@ void pUdpRx(
         if(ca.config_addr == NAL_CONFIG_OWN_RANK)
         {
           own_rank = (NodeId) ca.update_value;
-          cache_init = false;
-          cached_udp_rx_id = 0;
-          cached_udp_rx_ipaddr = 0;
+          udpRxCache.reset();
         }
         break;
       } else if ( !siUOE_Meta.empty()
@@ -554,7 +539,7 @@ void pUdpRx(
         {
           fsmStateRX_Udp = FSM_DROP_PACKET;
           //no notifications necessary, UOE counts?
-          cache_init = false;
+          udpRxCache.reset();
           break;
         }
 
@@ -562,10 +547,9 @@ void pUdpRx(
         in_meta = NetworkMeta(own_rank, udpRxMeta.udpDstPort, 0, udpRxMeta.udpSrcPort, udpRxLen);
 
         //ask cache
-        if(cache_init && cached_udp_rx_ipaddr == udpRxMeta.ip4SrcAddr)
+        if(udpRxCache.lookup(udpRxMeta.ip4SrcAddr, src_id))
         {
           printf("used UDP RX id cache\n");
-          src_id = cached_udp_rx_id;
           fsmStateRX_Udp = FSM_FIRST_ACC;
         } else {
           sGetNidReq_UdpRx.write(udpRxMeta.ip4SrcAddr);
@@ -579,9 +563,12 @@ void pUdpRx(
       if(!sGetNidRep_UdpRx.empty())
       {
         src_id = sGetNidRep_UdpRx.read();
-        cached_udp_rx_ipaddr = udpRxMeta.ip4SrcAddr;
-        cached_udp_rx_id = src_id;
-        cache_init = true;
+        if(src_id != ((NodeId) INVALID_MRT_VALUE)
+            && !udpRxCache.insert(udpRxMeta.ip4SrcAddr, src_id))
+        { //cache is full, start over
+          udpRxCache.reset();
+          udpRxCache.insert(udpRxMeta.ip4SrcAddr, src_id);
+        }
         fsmStateRX_Udp = FSM_FIRST_ACC;
       }
       break;
@@ -596,7 +583,6 @@ void pUdpRx(
           evsStreams[0].write_nb(new_ev_not);
           printf("[UDP-RX:ERROR]invalid src_id, packet will be dropped.\n");
           fsmStateRX_Udp = FSM_DROP_PACKET;
-          cache_init = false;
           break;
         }
         //status
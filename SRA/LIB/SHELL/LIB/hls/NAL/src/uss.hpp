@@ -41,6 +41,7 @@
 #include <stdint.h>
 
 #include "nal.hpp"
+#include "cam.hpp"
 
 using namespace hls;
 
@@ -30,6 +30,7 @@
 #include <stdio.h>
 #include <hls_stream.h>
 #include <inttypes.h>
+#include <time.h>
 
 #include "../src/nal.hpp"
 #include "../../simulation_utils.hpp"
@@ -61,6 +62,11 @@ using namespace std;
 //-- TESTBENCH GLOBAL VARIABLES
 //------------------------------------------------------
 #define MAX_SIM_CYCLES   450
+
+//------------------------------------------------------
+//-- CAM MICROBENCHMARK
+//------------------------------------------------------
+#define CAM_BENCH_ROUNDS 2000
 //---------------------------------------------------------
 //-- DEFAULT LOCAL FPGA AND FOREIGN HOST SOCKETS
 //--  By default, the following sockets will be used by the
@@ -1076,6 +1082,97 @@ void pTOE(
 }
 
 
+/*****************************************************************************
+ * @brief Microbenchmark of the fully-associative CamN<K,V,N>.
+ * @ingroup NRC
+ *
+ * @details
+ *  Fills a CAM of N entries and performs N lookups per round. The C-sim
+ *  only reports the host time per lookup. The latency and II of the
+ *  synthesized CAM are given by the csynth report of the instantiating
+ *  process.
+ * @return the number of errors.
+ ******************************************************************************/
+template<int N>
+int benchCamN()
+{
+    CamN<SessionId,TcpDatLen,N> cam = CamN<SessionId,TcpDatLen,N>();
+    int nrErr = 0;
+
+    for(int i = 0; i < N; i++)
+    {
+        if(!cam.insert((SessionId) (i*7+1), (TcpDatLen) i))
+        {
+            nrErr++;
+        }
+    }
+    if(cam.insert((SessionId) 0, (TcpDatLen) 0))
+    { //the CAM must be full by now
+        nrErr++;
+    }
+    clock_t start = clock();
+    for(int r = 0; r < CAM_BENCH_ROUNDS; r++)
+    {
+        for(int i = 0; i < N; i++)
+        {
+            TcpDatLen value = 0;
+            if(!cam.lookup((SessionId) (i*7+1), value) || value != i)
+            {
+                nrErr++;
+            }
+        }
+    }
+    double nsPerLkp = (1e9 * (clock() - start)) / CLOCKS_PER_SEC / (CAM_BENCH_ROUNDS * N);
+    printf("[TB-BENCH] CamN    N=%5d : %8.1f ns/lookup (host), errors=%d\n",
+        N, nsPerLkp, nrErr);
+    return nrErr;
+}
+
+/*****************************************************************************
+ * @brief Microbenchmark of the set-associative HashCam<K,V,N,WAYS>.
+ * @ingroup NRC
+ *
+ * @details
+ *  Fills a CAM of N entries up to half of its capacity with sequential keys
+ *  and performs a lookup for every key. Insertions that find their set full
+ *  are reported as overflows (and not as errors).
+ * @return the number of errors.
+ ******************************************************************************/
+template<int N, int WAYS>
+int benchHashCam()
+{
+    HashCam<SessionId,TcpDatLen,N,WAYS> cam = HashCam<SessionId,TcpDatLen,N,WAYS>();
+    int nrErr = 0;
+    int nrOvf = 0;
+    bool inserted[N/2];
+
+    for(int i = 0; i < N/2; i++)
+    {
+        inserted[i] = cam.insert((SessionId) i, (TcpDatLen) i);
+        if(!inserted[i])
+        {
+            nrOvf++;
+        }
+    }
+    clock_t start = clock();
+    for(int r = 0; r < CAM_BENCH_ROUNDS; r++)
+    {
+        for(int i = 0; i < N/2; i++)
+        {
+            TcpDatLen value = 0;
+            bool hit = cam.lookup((SessionId) i, value);
+            if(hit != inserted[i] || (hit && value != i))
+            {
+                nrErr++;
+            }
+        }
+    }
+    double nsPerLkp = (1e9 * (clock() - start)) / CLOCKS_PER_SEC / (CAM_BENCH_ROUNDS * (N/2));
+    printf("[TB-BENCH] HashCam N=%5d : %8.1f ns/lookup (host), overflows=%d, errors=%d\n",
+        N, nsPerLkp, nrOvf, nrErr);
+    return nrErr;
+}
+
 /*****************************************************************************
  * @brief Main Testbench Loop; Emulates also the behavior of the UDP Offload Engine (UOE).
  * @ingroup NRC
@@ -1094,6 +1191,22 @@ int main() {
 
     simCnt = 0;
     nrErr  = 0;
+
+    //------------------------------------------------------
+    //-- CAM MICROBENCHMARK (lookup cost versus N)
+    //------------------------------------------------------
+    int camErr = 0;
+    camErr += benchCamN<8>();
+    camErr += benchCamN<16>();
+    camErr += benchCamN<MAX_NAL_SESSIONS>();
+    camErr += benchCamN<MAX_MRT_SIZE>();
+    camErr += benchHashCam<256,4>();
+    camErr += benchHashCam<4096,4>();
+    camErr += benchHashCam<1000,4>();  //the 250 sets are rounded up to 256
+    if(camErr)
+    {
+        printf("## ERROR - CAM MICROBENCHMARK FAILED (RC=%d) !!!\n", camErr);
+    }
   
     //prepare MRT (routing table)
     for(int i = 0; i < MAX_MRT_SIZE + NUMBER_CONFIG_WORDS + NUMBER_STATUS_WORDS; i++)
@@ -1440,7 +1553,7 @@ int main() {
                                             ../../../../test/ifsROLE_Urif_Data.dat");
     if (rc2)
         printf("## Error : File \'ofsURIF_Udmx_Data.dat\' does not match \'ifsROLE_Urif_Data.dat\'.\n");
-    nrErr += rc1 + rc2;
+    nrErr += rc1 + rc2 + camErr;
 
     printf("#####################################################\n");
     if (nrErr)
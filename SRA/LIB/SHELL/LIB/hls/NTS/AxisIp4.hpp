@@ -132,6 +132,11 @@
 // the presence of option(s) and is indicated by the field IHL>5.
 #define IP4_HEADER_LEN      20      // In bytes
 
+// The two least significant bits of the ToS field carry the ECN codepoint (RFC-3168)
+#define IP4_ECN_NOT_ECT     0x00    // Not ECN-Capable Transport
+#define IP4_ECN_ECT0        0x02    // ECN-Capable Transport, ECT(0)
+#define IP4_ECN_CE          0x03    // Congestion Experienced
+
 /*********************************************************
  * IPv4 - HEADER FIELDS IN LITTLE-ENDIAN (LE) ORDER.
  *   As received or transmitted by the 10GbE MAC.
@@ -211,8 +216,9 @@ class AxisIp4: public AxisRaw {
                                                                    tdata.range(52, 48) = offset(12, 8);   }
     Ip4FragOff  getIp4FragOff()                 {          return (tdata.range(52, 48) << 8 |
                                                                    tdata.range(63, 56));                  }
-    // Set the IP4 Flags
+    // Set-Get the IP4 Flags
     void        setIp4Flags(Ip4Flags flags)     {                  tdata.range(55, 53) = flags;           }
+    Ip4Flags    getIp4Flags()                   {           return tdata.range(55, 53);                   }
     // Set-Get the IP4 Time to Live
     void        setIp4TtL(Ip4TtL ttl)           {                  tdata.range( 7,  0) = ttl;             }
     Ip4TtL      getIp4TtL()                     {           return tdata.range( 7,  0);                   }
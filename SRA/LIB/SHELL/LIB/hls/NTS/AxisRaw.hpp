@@ -109,12 +109,24 @@
 
 /***********************************************
  * AXIS RAW - DEFINITIONS
+ *  The width of the NTS datapath is set by 'ARW'.
+ *  Only the following are generic on the width:
+ *   - the class 'AxisRawT' and 'fieldEndsInChunk()',
+ *   - the checksum library ('nts_csum.hpp'),
+ *   - the IP checksum accumulator of the IPRX,
+ *   - the header parser of 'axis_width'.
+ *  The derived classes (.e.g 'AxisIp4') and the
+ *  other parsers of IPRX, IPTX, UOE and TOE still
+ *  hard-code the positions of the header fields
+ *  for 64 bits. 'ARW' must therefore remain 64.
  ***********************************************/
-#define AXIS_RAW_WIDTH_AT_10GE  64
+#define AXIS_RAW_WIDTH_AT_10GE   64
+#define AXIS_RAW_WIDTH_AT_25GE  128
+#define AXIS_RAW_WIDTH_AT_40GE  256
+#define AXIS_RAW_WIDTH_AT_100GE 512
 #define ARW                     AXIS_RAW_WIDTH_AT_10GE
 
 #define TLAST       1
-
 /***********************************************
  * AXIS_RAW - TYPE FIELDS DEFINITION
  *   FYI - 'LE' stands for Little-Endian order.
@@ -159,24 +171,29 @@ void pAxisRawCast(
 
 /*******************************************************************************
  * AXIS_RAW - RAW AXIS-4 STREAMING INTERFACE
- *  An AxisRaw is logically divided into 'ARW/8' bytes. The validity of a given
+ *  An AxisRaw is logically divided into 'W/8' bytes. The validity of a given
  *  byte is qualified by the 'tkeep' field, while the assertion of the 'tlast'
  *  bit indicates the end of a stream.
+ *  The class is templated on the width 'W' of the chunk (.i.e 64, 128, 256 or
+ *  512 bits) and the type 'AxisRaw' designates the chunk of the width 'ARW'
+ *  used by the NTS. Whatever the width, the byte B[n] of a chunk sits in the
+ *  lane 'n' (.i.e bits 8*n+7 down to 8*n), as with the 10GbE MAC.
  *
  * @Warning: Members of this class are kept public for compatibility issues with
  *  the legacy code.
  *
  *******************************************************************************/
-class AxisRaw {
+template<int W>
+class AxisRawT {
 
   protected:
-    LE_tData    tdata;
-    LE_tKeep    tkeep;
-    LE_tLast    tlast;
+    ap_uint<W>      tdata;
+    ap_uint<W/8>    tkeep;
+    ap_uint<1>      tlast;
 
   public:
-    AxisRaw()       {}
-    AxisRaw(LE_tData tdata, LE_tKeep tkeep, LE_tLast tlast) :
+    AxisRawT()      {}
+    AxisRawT(ap_uint<W> tdata, ap_uint<W/8> tkeep, ap_uint<1> tlast) :
             tdata(tdata), tkeep(tkeep), tlast(tlast) {}
 
     /******************************************************
@@ -185,65 +202,47 @@ class AxisRaw {
 
     /* Get a range of the 'tdata' member in Big-Endian (BE) order
      *       +---------------+---------------+---------------+---------------+
-     * tdata |ARW-1                   (Little-Endian)                       0|
+     * tdata |W-1                     (Little-Endian)                       0|
      *       +---------------+---------------+---------------+---------------+
+     *  FYI - The range must span an integer number of bytes.
      */
-    tData getTData(int leHi=ARW-1, int leLo=0) const {
-        switch (leHi-leLo) {
-            case 64-1 : return byteSwap64(tdata.range(leHi, leLo)); break;
-            case 32-1 : return byteSwap32(tdata.range(leHi, leLo)); break;
-            case 16-1 : return byteSwap16(tdata.range(leHi, leLo)); break;
-            case  8-1 : return           (tdata.range(leHi, leLo)); break;
-            default : break;
+    ap_uint<W> getTData(int leHi=W-1, int leLo=0) const {
+        if (((leHi-leLo+1) % 8) != 0) {
+            std::cout << "ASSERT - AxisRaw::getTData() - Unsupported range.\n"; assert(false);
         }
-        std::cout << "ASSERT - AxisRaw::getTData() - Unsupported range.\n"; assert(false);
-        return tdata;
+        return byteSwap(tdata.range(leHi, leLo), (leHi-leLo+1)/8);
     }
     /* Get a range of the 'tkeep' member in Big-Endian (BE) order
      *       +---------------+---------------+
-     * tkeep |ARW/8-1      (LE)             0|
+     * tkeep |W/8-1        (LE)             0|
      *       +---------------+---------------+
      */
-    tKeep getTKeep(int leHi=ARW/8-1, int leLo=0) const {
-        switch (leHi-leLo) {
-            case 8-1 : return bitSwap8(tkeep.range(leHi, leLo)); break;
-            case 4-1 : return bitSwap4(tkeep.range(leHi, leLo)); break;
-            case 2-1 : return bitSwap2(tkeep.range(leHi, leLo)); break;
-            case 1-1 : return         (tkeep[leLo]); break;
-            default : break;
-        }
-        std::cout << "ASSERT - AxisRaw::getTKeep() - Unsupported range.\n"; assert(false);
-        return tkeep;
+    ap_uint<W/8> getTKeep(int leHi=W/8-1, int leLo=0) const {
+        return bitSwap(tkeep.range(leHi, leLo), leHi-leLo+1);
     }
     // Get the 'tlast' member
-    tLast getTLast() const {
+    ap_uint<1> getTLast() const {
         return tlast;
     }
 
     /* Set the 'tdata' member from a parameter encoded in Big-Endian (BE) order
      *       +---------------+---------------+---------------+---------------+
-     * tdata |ARW-1                   (Little-Endian)                       0|
+     * tdata |W-1                     (Little-Endian)                       0|
      *       +---------------+---------------+---------------+---------------+
      */
-    void setTData(tData data) {
-        switch (ARW) {
-            case 64 : tdata = byteSwap64(data); break;
-            default : std::cout << "ASSERT - AxisRaw::setTData() - Unsupported Axis raw width.\n"; break;
-        }
+    void setTData(ap_uint<W> data) {
+        tdata = byteSwap(data, W/8);
     }
     /* Set the 'tkeep' member from a parameter encoded in Big-Endian (BE) order
      *       +---------------+---------------+
-     * tkeep |ARW/8-1      (LE)             0|
+     * tkeep |W/8-1        (LE)             0|
      *       +---------------+---------------+
      */
-    void setTKeep(tKeep keep) {
-        switch (ARW) {
-            case 64 : tkeep = bitSwap8(keep); break;
-            default : std::cout << "ASSERT - AxisRaw::setTKeep() - Unsupported Axis raw width.\n"; break;
-        }
+    void setTKeep(ap_uint<W/8> keep) {
+        tkeep = bitSwap(keep, W/8);
     }
     // Set the 'tlast' member
-    void setTLast(tLast last) {
+    void setTLast(ap_uint<1> last) {
         tlast = last;
         if (last) {  // [FIXME-Remove and create a 'setTLastAndClear()]
             // Always zero the bytes which have their tkeep-bit cleared.
@@ -253,31 +252,55 @@ class AxisRaw {
         }
     }
 
+    /* Get a header field of 'N' bytes located at byte 'byteOff' of the chunk
+     *  and return it in Big-Endian (BE) order. The field may start at any byte
+     *  of the chunk but must not extend past its last byte.
+     */
+    template<int N> ap_uint<8*N> getBeField(int byteOff) const {
+        #pragma HLS INLINE
+        ap_uint<8*N> field;
+        for (int i=0; i<N; i++) {
+        #pragma HLS UNROLL
+            field.range(8*(N-1-i)+7, 8*(N-1-i)) = tdata.range(8*(byteOff+i)+7, 8*(byteOff+i));
+        }
+        return field;
+    }
+    /* Set a header field of 'N' bytes located at byte 'byteOff' of the chunk
+     *  from a parameter encoded in Big-Endian (BE) order.
+     */
+    template<int N> void setBeField(ap_uint<8*N> field, int byteOff) {
+        #pragma HLS INLINE
+        for (int i=0; i<N; i++) {
+        #pragma HLS UNROLL
+            tdata.range(8*(byteOff+i)+7, 8*(byteOff+i)) = field.range(8*(N-1-i)+7, 8*(N-1-i));
+        }
+    }
+
     /******************************************************
      * LITTLE-ENDIAN SETTERS AND GETTERS
      ******************************************************/
     // Return the 'tdata' field in Little-Endian order
-    LE_tData getLE_TData(int leHi=ARW-1, int leLo=0) const {
+    ap_uint<W> getLE_TData(int leHi=W-1, int leLo=0) const {
         return tdata.range(leHi, leLo);
     }
     // Get the 'tkeep' field with respect to the 'tdata' field encoded in Little-Endian order
-    LE_tKeep getLE_TKeep(int leHi=ARW/8-1, int leLo=0) const {
+    ap_uint<W/8> getLE_TKeep(int leHi=W/8-1, int leLo=0) const {
         return tkeep.range(leHi, leLo);
     }
     // Get the tlast bit
-    LE_tLast getLE_TLast() const {
+    ap_uint<1> getLE_TLast() const {
         return tlast;
     }
     // Set the 'tdata' field with a 'data' encoded in Little-Endian order
-    void setLE_TData(LE_tData data, int leHi=ARW-1, int leLo=0) {
+    void setLE_TData(ap_uint<W> data, int leHi=W-1, int leLo=0) {
         tdata.range(leHi, leLo) = data.range(leHi-leLo, 0);
     }
     // Set the 'tkeep' field with respect to the 'tdata' field encoded in Little-Endian order
-    void setLE_TKeep(LE_tKeep keep, int leHi=ARW/8-1, int leLo=0) {
+    void setLE_TKeep(ap_uint<W/8> keep, int leHi=W/8-1, int leLo=0) {
         tkeep.range(leHi, leLo) = keep;
     }
     // Set the tlast field
-    void setLE_TLast(LE_tLast last) {
+    void setLE_TLast(ap_uint<1> last) {
         tlast = last;
     }
 
@@ -287,101 +310,89 @@ class AxisRaw {
 
     /* Get higher-half part of member 'tdata' and return it in BE order
      *       +---------------+---------------+---------------+---------------+
-     * tdata |ARW-1     Lower-Half         (LE)        Higher-Half          0|
+     * tdata |W-1       Lower-Half         (LE)        Higher-Half          0|
      *       +---------------+---------------+---------------+---------------+
      */
-    tDataHalf getTDataHi() const {
-        return getTData(ARW/2-1, 0);
+    ap_uint<W/2> getTDataHi() const {
+        return getTData(W/2-1, 0);
     }
     /* Get lower-half part of member 'tdata' and return it in BE order
      *       +---------------+---------------+---------------+---------------+
-     * tdata |ARW-1     Lower-Half         (LE)        Higher-Half          0|
+     * tdata |W-1       Lower-Half         (LE)        Higher-Half          0|
      *       +---------------+---------------+---------------+---------------+
      */
-    tDataHalf getTDataLo() const {
-        return getTData(ARW-1, ARW/2);
+    ap_uint<W/2> getTDataLo() const {
+        return getTData(W-1, W/2);
     }
     /* Get higher-half part of member 'tkeep' and return it in BE order
      *       +----------------------+-------------------+
-     * tkeep |ARW/8-1  Lower-Half  (LE)   Higher-Half  0|
+     * tkeep |W/8-1    Lower-Half  (LE)   Higher-Half  0|
      *       +----------------------+-------------------+
      */
-    tKeepHalf getTKeepHi() const {
-        return getTKeep(ARW/8/2-1, 0);
+    ap_uint<W/16> getTKeepHi() const {
+        return getTKeep(W/8/2-1, 0);
     }
     /* Get lower-half part of member 'tkeep' and return it in BE order
       *       +----------------------+-------------------+
-      * tkeep |ARW/8-1  Lower-Half  (LE)   Higher-Half  0|
+      * tkeep |W/8-1    Lower-Half  (LE)   Higher-Half  0|
       *       +----------------------+-------------------+
       */
-    tKeepHalf getTKeepLo() const {
-        return getTKeep(ARW/8-1, ARW/8/2);
+    ap_uint<W/16> getTKeepLo() const {
+        return getTKeep(W/8-1, W/8/2);
     }
 
     /* Set higher-half part of 'tdata' from a parameter encoded in BE order
      *       +---------------+---------------+---------------+---------------+
-     * tdata |ARW-1     Lower-Half         (LE)        Higher-Half          0|
+     * tdata |W-1       Lower-Half         (LE)        Higher-Half          0|
      *       +---------------+---------------+---------------+---------------+
      */
-    void setTDataHi(tDataHalf halfData) {
-        switch (ARW) {
-            case 64 : tdata.range(ARW/2-1, 0) = byteSwap32(halfData); break;
-            default : std::cout << "ASSERT - AxisRaw::setTDataHi() - Unsupported Axis raw width.\n"; break;
-        }
+    void setTDataHi(ap_uint<W/2> halfData) {
+        tdata.range(W/2-1, 0) = byteSwap(halfData, W/16);
     }
     /* Set lower-half part of 'tdata' from a parameter encoded in BE order
      *       +---------------+---------------+---------------+---------------+
-     * tdata |ARW-1     Lower-Half         (LE)        Higher-Half          0|
+     * tdata |W-1       Lower-Half         (LE)        Higher-Half          0|
      *       +---------------+---------------+---------------+---------------+
      */
-    void setTDataLo(tDataHalf halfData) {
-        switch (ARW) {
-            case 64 : tdata.range(ARW-1, ARW/2) = byteSwap32(halfData); break;
-            default : std::cout << "ASSERT - AxisRaw::setTDataLo() - Unsupported Axis raw width.\n"; break;
-        }
+    void setTDataLo(ap_uint<W/2> halfData) {
+        tdata.range(W-1, W/2) = byteSwap(halfData, W/16);
     }
     /* Set higher-half part of 'tkeep' from a parameter encoded in BE order
      *       +----------------------+-------------------+
-     * tkeep |ARW/8-1  Lower-Half  (LE)   Higher-Half  0|
+     * tkeep |W/8-1    Lower-Half  (LE)   Higher-Half  0|
      *       +----------------------+-------------------+
      */
-    void setTKeepHi(tKeepHalf halfKeep) {
-        switch (ARW) {
-            case 64 : tkeep(ARW/8/2-1, 0) = bitSwap4(halfKeep); break;
-            default : std::cout << "ASSERT - AxisRaw::setTKeepHi() - Unsupported Axis raw width.\n"; break;
-        }
+    void setTKeepHi(ap_uint<W/16> halfKeep) {
+        tkeep(W/8/2-1, 0) = bitSwap(halfKeep, W/16);
     }
     /* Set lower-half part of 'tkeep' from a parameter encoded in BE order
      *       +----------------------+-------------------+
-     * tkeep |ARW/8-1  Lower-Half  (LE)   Higher-Half  0|
+     * tkeep |W/8-1    Lower-Half  (LE)   Higher-Half  0|
      *       +----------------------+-------------------+
      */
-    void setTKeepLo(tKeepHalf halfKeep) {
-        switch (ARW) {
-            case 64 : tkeep(ARW/8-1, ARW/8/2) = bitSwap4(halfKeep); break;
-            default : std::cout << "ASSERT - AxisRaw::setTKeepLo() - Unsupported Axis raw width.\n"; break;
-        }
+    void setTKeepLo(ap_uint<W/16> halfKeep) {
+        tkeep(W/8-1, W/8/2) = bitSwap(halfKeep, W/16);
     }
 
     /******************************************************
      * LITTLE-ENDIAN HELPERS
      ******************************************************/
-    // Get the 'tdata' field in Little-Endian order and return its upper-half part (.i.e data(31,0))
-    LE_tDataHalf getLE_TDataHi() const {
-        return getLE_TData().range(31, 0);  // [TODO]
+    // Get the 'tdata' field in Little-Endian order and return its upper-half part (.i.e data(W/2-1,0))
+    ap_uint<W/2> getLE_TDataHi() const {
+        return tdata.range(W/2-1, 0);
     }
-    // Get the 'tdata' field in Little-Endian order and return its lower-half part (.i.e, data(63,32)
-    LE_tDataHalf getLE_TDataLo() const {
-        return getLE_TData().range(63, 32);  // [TODO]
+    // Get the 'tdata' field in Little-Endian order and return its lower-half part (.i.e, data(W-1,W/2)
+    ap_uint<W/2> getLE_TDataLo() const {
+        return tdata.range(W-1, W/2);
     }
 
-    // Set the 'tdata' field with the upper-half part of a 'data' encoded in Little-Endian order (.i.e, data(31,0))
-    void setLE_TDataHi(LE_tData data) {
-        tdata.range(31, 0) = data.range(31, 0);  // [TODO]
+    // Set the 'tdata' field with the upper-half part of a 'data' encoded in Little-Endian order (.i.e, data(W/2-1,0))
+    void setLE_TDataHi(ap_uint<W> data) {
+        tdata.range(W/2-1, 0) = data.range(W/2-1, 0);
     }
-    // Set the 'tdata' field with the lower-half part of a 'data' encoded in Little-Endian order (.i.e, data(63,32))
-    void setLE_TDataLo(LE_tData data) {
-        tdata.range(63, 32) = data.range(63, 32);  // [TODO]
+    // Set the 'tdata' field with the lower-half part of a 'data' encoded in Little-Endian order (.i.e, data(W-1,W/2))
+    void setLE_TDataLo(ap_uint<W> data) {
+        tdata.range(W-1, W/2) = data.range(W-1, W/2);
     }
 
     /******************************************************
@@ -389,22 +400,11 @@ class AxisRaw {
      ******************************************************/
     // Zero the bytes which have their tkeep-bit cleared
     void clearUnusedBytes() {
-        //for (int i=0, leHi=ARW/8-1, leLo=0; i<ARW/8; i++) {  // ARW/8 = noBytes
-        //    #pragma HLS UNROLL factor=8
-        //    if (tkeep[i] == 0) {
-        //        tdata.range(leHi+8*i, leLo+8*i) = 0x00;
-        //    }
-        int leHi=ARW/8-1;
-        int leLo=0;
-        switch(this->tkeep){
-            case 0x00: tdata.range(leHi+8*0, leLo+8*0) = 0x00; // No break here
-            case 0x01: tdata.range(leHi+8*1, leLo+8*1) = 0x00; // No break here
-            case 0x03: tdata.range(leHi+8*2, leLo+8*2) = 0x00; // No break here
-            case 0x07: tdata.range(leHi+8*3, leLo+8*3) = 0x00; // No break here
-            case 0x0F: tdata.range(leHi+8*4, leLo+8*4) = 0x00; // No break here
-            case 0x1F: tdata.range(leHi+8*5, leLo+8*5) = 0x00; // No break here
-            case 0x3F: tdata.range(leHi+8*6, leLo+8*6) = 0x00; // No break here
-            case 0x7F: tdata.range(leHi+8*7, leLo+8*7) = 0x00; // No break here
+        for (int i=0; i<W/8; i++) {
+        #pragma HLS UNROLL
+            if (tkeep[i] == 0) {
+                tdata.range(8*i+7, 8*i) = 0x00;
+            }
         }
     }
     // Get the length of this chunk (in bytes)
@@ -413,8 +413,8 @@ class AxisRaw {
     }
     // Get the length of the higher-half part of this chunk (in bytes)
     int getLenHi() {
-        if (keepToLen() > ARW/8/2) {
-            return (ARW/8/2);
+        if (keepToLen() > W/8/2) {
+            return (W/8/2);
         }
         else {
             return keepToLen();
@@ -422,8 +422,8 @@ class AxisRaw {
     }
     // Get the length of the lower-half part of this chunk (in bytes)
     int getLenLo() {
-        if (keepToLen() > ARW/8/2) {
-             return (keepToLen()-ARW/8/2);
+        if (keepToLen() > W/8/2) {
+             return (keepToLen()-W/8/2);
          }
          else {
              return 0;
@@ -432,7 +432,7 @@ class AxisRaw {
 
     // Assess the consistency of 'tkeep' and 'tlast'
     bool isValid() const {
-        if (((tlast == 0) and (tkeep != 0xFF)) or
+        if (((tlast == 0) and (tkeep.and_reduce() == 0)) or
             ((tlast == 1) and (keepToLen() == 0))) {
             return false;
         }
@@ -447,53 +447,70 @@ class AxisRaw {
     // }
 
   protected:
-    // Return the number of valid bytes
+    // Return the number of valid bytes (or 0 if the tkeep-bits are not contiguous from bit 0)
     int keepToLen() const {
-        switch(this->tkeep){
-            case 0x01: return 1; break;
-            case 0x03: return 2; break;
-            case 0x07: return 3; break;
-            case 0x0F: return 4; break;
-            case 0x1F: return 5; break;
-            case 0x3F: return 6; break;
-            case 0x7F: return 7; break;
-            case 0xFF: return 8; break;
+        int len = 0;
+        for (int i=0; i<W/8; i++) {
+        #pragma HLS UNROLL
+            if ((tkeep[i] == 1) and (len == i)) {
+                len = i+1;
+            }
         }
-        return 0;
+        if ((tkeep >> len) != 0) {
+            return 0;
+        }
+        return len;
     }
 
   private:
-    // Reverse the bits within a pair.
-    ap_uint<2> bitSwap2(ap_uint<2> inputVector) const {
-        return (inputVector.range(0,1));
-    }
-    // Reverse the bits within a nibble.
-    ap_uint<4> bitSwap4(ap_uint<4> inputVector) const {
-        return (inputVector.range(0,3));
-    }
-    // Reverse the bits within a byte.
-    ap_uint<8> bitSwap8(ap_uint<8> inputVector) const {
-        return (inputVector.range(0,7));
-    }
-    // Swap the two bytes of a word (.i.e, 16 bits).
-    ap_uint<16> byteSwap16(ap_uint<16> inputVector) const {
-        return (inputVector.range(7,0), inputVector(15, 8));
-    }
-    // Swap the four bytes of a double-word (.i.e, 32 bits).
-    ap_uint<32> byteSwap32(ap_uint<32> inpDWord) const {
-        return (inpDWord.range( 7, 0), inpDWord.range(15,  8),
-                inpDWord.range(23,16), inpDWord.range(31, 24));
-    }
-    // Swap the eight bytes of a quad-word (.i.e, 64 bits).
-    ap_uint<64> byteSwap64(ap_uint<64> inpQWord) const {
-        return (inpQWord.range( 7, 0), inpQWord(15,  8),
-                inpQWord.range(23,16), inpQWord(31, 24),
-                inpQWord.range(39,32), inpQWord(47, 40),
-                inpQWord.range(55,48), inpQWord(63, 56));
+    // Reverse the order of the 'nrBits' least significant bits of a vector.
+    ap_uint<W/8> bitSwap(ap_uint<W/8> inpVector, int nrBits) const {
+        ap_uint<W/8> outVector = 0;
+        for (int i=0; i<W/8; i++) {
+        #pragma HLS UNROLL
+            if (i < nrBits) {
+                outVector[nrBits-1-i] = inpVector[i];
+            }
+        }
+        return outVector;
+    }
+    // Reverse the order of the 'nrBytes' least significant bytes of a vector.
+    ap_uint<W> byteSwap(ap_uint<W> inpVector, int nrBytes) const {
+        ap_uint<W> outVector = 0;
+        for (int i=0; i<W/8; i++) {
+        #pragma HLS UNROLL
+            if (i < nrBytes) {
+                outVector.range(8*(nrBytes-1-i)+7, 8*(nrBytes-1-i)) = inpVector.range(8*i+7, 8*i);
+            }
+        }
+        return outVector;
     }
 
 };
 
+//-- The chunk of the NTS datapath
+typedef AxisRawT<ARW> AxisRaw;
+//--  The derived classes index their header fields for 8-byte chunks
+typedef char ARW_must_be_64_for_the_derived_Axis_classes[(ARW == AXIS_RAW_WIDTH_AT_10GE) ? 1 : -1];
+
+/*******************************************************************************
+ * @brief Returns true if the last byte of a field falls within a chunk.
+ *
+ * @param[in] fieldOff  The byte offset of the field in the frame.
+ * @param[in] fieldLen  The length of the field in bytes.
+ * @param[in] chunkOff  The byte offset of the chunk in the frame.
+ * @param[in] chunkLen  The length of the chunk in bytes.
+ *
+ * @details
+ *  A width-generic parser extracts a field upon the chunk holding its last
+ *   byte, from a window made of this chunk and of the previous one.
+ *******************************************************************************/
+inline bool fieldEndsInChunk(int fieldOff, int fieldLen, int chunkOff, int chunkLen) {
+    #pragma HLS INLINE
+    int fieldEnd = fieldOff + fieldLen - 1;
+    return ((fieldEnd >= chunkOff) and (fieldEnd < (chunkOff + chunkLen)));
+}
+
 #endif
 
 /*! \} */
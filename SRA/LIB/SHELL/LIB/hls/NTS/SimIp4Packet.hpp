@@ -337,6 +337,8 @@ class SimIp4Packet {
     int          getIpFragmentOffset()               { return pktQ[0].getIp4FragOff();       }
     // Set the IP Flags field
     void         setIpFlags(int flags)               {        pktQ[0].setIp4Flags(flags);    }
+    // Get the IP Flags field
+    int          getIpFlags()                        { return pktQ[0].getIp4Flags();         }
     // Set the IP Time To Live field
     void         setIpTimeToLive(Ip4TtL ttl)         {        pktQ[1].setIp4TtL(ttl);        }
     // Get the IP Time To Live field
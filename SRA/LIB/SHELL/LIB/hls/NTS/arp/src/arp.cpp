@@ -91,8 +91,10 @@ using namespace hls;
  *  If the 'OPERation' field is an ARP-REQUEST, the extracted metadata structure
  *  is forwarded to the ArpPacketSender (APs) which will use that information to
  *  to build an ARP-REPLY packet in response to the incoming ARP-REQUEST.
- *  Next, the {MAC,IP} binding of the ARP-Sender is systematically forwarded to
- *  the ARP-CAM for insertion.
+ *  Next, the {MAC,IP} binding of the ARP-Sender is forwarded to the ARP-CAM for
+ *  insertion or refresh, unless the sender address is null (.i.e ARP-PROBE) or
+ *  is our own IP address. A gratuitous ARP (SPA=TPA) is not answered but it
+ *  updates the binding of its sender at once.
  *
  * @warning
  *  The format of the incoming ARP-over-ETHERNET is as follow:
@@ -190,17 +192,33 @@ void pArpPacketReceiver(
         } // End of: switch
 
         if (currChunk.getLE_TLast() == 1) {
+            bool isProbe  = (apr_meta.arpSendProtAddr == 0);
+            bool isMyself = (apr_meta.arpSendProtAddr == piMMIO_IpAddress);
             if (apr_opCode == ARP_OPER_REQUEST) {
-                if (arp_targProtAddr == piMMIO_IpAddress) {
+                if ((arp_targProtAddr == piMMIO_IpAddress) and not isMyself) {
                     soAPs_Meta.write(apr_meta);
                 }
                 else if (DEBUG_LEVEL & TRACE_APR) {
                     printInfo(myName,"Skip ARP reply because requested TPA does not match our IP address.\n");
                 }
             }
-            // Always ask the CAM to add the {MAC,IP} binding of the ARP-Sender
-            soACc_UpdateReq.write(ArpBindPair(apr_meta.arpSendHwAddr,
-                                              apr_meta.arpSendProtAddr));
+            if (isProbe or isMyself) {
+                // An ARP-PROBE (SPA=0) or a sender claiming our own IP address
+                if (DEBUG_LEVEL & TRACE_APR) {
+                    printInfo(myName, "Skip CAM update because SPA is null or is our IP address.\n");
+                }
+            }
+            else {
+                if ((apr_meta.arpSendProtAddr == arp_targProtAddr) and (DEBUG_LEVEL & TRACE_APR)) {
+                    printInfo(myName, "Received a gratuitous ARP (SPA=TPA) from:\n");
+                    printArpBindPair(myName, ArpBindPair(apr_meta.arpSendHwAddr,
+                                                         apr_meta.arpSendProtAddr));
+                }
+                // Ask the CAM to add or to refresh the {MAC,IP} binding of the
+                //  ARP-Sender. A gratuitous ARP is handled the same way.
+                soACc_UpdateReq.write(ArpBindPair(apr_meta.arpSendHwAddr,
+                                                  apr_meta.arpSendProtAddr));
+            }
             apr_chunkCount = 0;
         }
         else {
@@ -356,6 +374,27 @@ void pArpPacketSender(
     } // End-of: switch (aps_fsmState)
 }
 
+#ifndef __SYNTHESIS__
+  //-- The number of refreshes, expiries and MAC moves of [ACc] (for the testbench only)
+  static unsigned int accNrRefreshes = 0;
+  static unsigned int accNrExpiries  = 0;
+  static unsigned int accNrMoves     = 0;
+
+  /*****************************************************************************
+   * @brief Return the statistics of the aging of the ARP bindings of [ACc].
+   *
+   * @param[out] nrRefreshes The number of ARP-REQUESTs fired to refresh a binding.
+   * @param[out] nrExpiries  The number of bindings removed from the CAM upon expiry.
+   * @param[out] nrMoves     The number of bindings whose MAC address has changed.
+   *****************************************************************************/
+  void getArpAgingStats(unsigned int &nrRefreshes, unsigned int &nrExpiries,
+                        unsigned int &nrMoves) {
+      nrRefreshes = accNrRefreshes;
+      nrExpiries  = accNrExpiries;
+      nrMoves     = accNrMoves;
+  }
+#endif
+
 /*******************************************************************************
  * ARP CAM Controller (ACc)
  *
@@ -372,6 +411,25 @@ void pArpPacketSender(
  *  This is the front-end process of the RTL ContentAddressableMemory (CAM). It
  *  serves the MAC lookup requests from the IpTxHandler (IPTX) and MAC update
  *  requests from the ArpPacketReceiver (APr).
+ *  A lookup miss fires an ARP-REQUEST, unless one was already fired for the
+ *  same IPv4 address less than ARP_REQ_RETRY_CYCLES ago. This is because the
+ *  IPTX keeps looking up the next hops of its pending packets until they get
+ *  resolved. An address is no longer pending once its binding is updated.
+ *  Up to ARP_LKP_IN_FLIGHT lookups are issued back-to-back to the CAM and are
+ *  replied in order, while an update is carried out concurrently. Every reply
+ *  carries the epoch of the CAM, which is incremented upon every completed
+ *  update, so that the IPTX can flush the MAC addresses it has cached.
+ *  Every binding is also kept in an aging table along with the tick of its
+ *  last confirmation by an incoming ARP packet. A confirmation that does not
+ *  change the binding only refreshes this tick and does not touch the CAM.
+ *  When idle, the aging table is scanned one entry per cycle. A binding older
+ *  than ARP_REFRESH_TICKS is refreshed with a broadcast ARP-REQUEST (retried
+ *  every ARP_REFRESH_RETRY_TICKS), such that it never expires while its owner
+ *  keeps answering. A binding older than ARP_ENTRY_TTL_TICKS is deleted from
+ *  the CAM. The aging table is cleared upon reset and is ARP_AGING_WAYS-way
+ *  set-associative. A new binding only evicts a binding from the CAM when all
+ *  the ways of its set are taken, in which case the least recently confirmed
+ *  binding of the set is evicted.
  *
  *******************************************************************************/
 void pArpCamController(
@@ -391,72 +449,331 @@ void pArpCamController(
     const char *myName  = concat3(THIS_NAME, "/", "ACc");
 
     //-- STATIC CONTROL VARIABLES (with RESET) ---------------------------------
-    static enum FsmStates { ACC_IDLE, ACC_UPDATE, ACC_LOOKUP } acc_fsmState=ACC_IDLE;
-    #pragma HLS RESET                                 variable=acc_fsmState
+    static enum UpdFsmStates { UPD_INIT=0, UPD_IDLE, UPD_WAIT, UPD_INSERT } acc_updFsmState=UPD_INIT;
+    #pragma HLS RESET           variable=acc_updFsmState
+    static bool                 acc_updInsert=false;  // An INSERT follows an eviction
+    #pragma HLS RESET           variable=acc_updInsert
+    static ArpEpoch             acc_epoch=0;
+    #pragma HLS RESET           variable=acc_epoch
+    static int                  acc_lkpHead=0;  // The oldest lookup in flight
+    #pragma HLS RESET           variable=acc_lkpHead
+    static int                  acc_lkpTail=0;
+    #pragma HLS RESET           variable=acc_lkpTail
+    static int                  acc_lkpCnt=0;   // The number of lookups in flight
+    #pragma HLS RESET           variable=acc_lkpCnt
+    static bool                 acc_reqValid[ARP_PENDING_REQS];
+    #pragma HLS RESET           variable=acc_reqValid
+    #pragma HLS ARRAY_PARTITION variable=acc_reqValid complete dim=1
+    static int                  acc_reqVictim=0;
+    #pragma HLS RESET           variable=acc_reqVictim
+    static ap_uint<32>          acc_cycleCnt=0;  // Free-running cycle counter
+    #pragma HLS RESET           variable=acc_cycleCnt
+    static ap_uint<32>          acc_tickCnt=0;   // Free-running aging tick counter
+    #pragma HLS RESET           variable=acc_tickCnt
+    static ap_uint<32>          acc_tickPrescaler=0;
+    #pragma HLS RESET           variable=acc_tickPrescaler
+    static ap_uint<8>           acc_scanIdx=0;
+    #pragma HLS RESET           variable=acc_scanIdx
+    static ap_uint<6>           acc_initIdx=0;   // The set of the aging table to clear
+    #pragma HLS RESET           variable=acc_initIdx
+    static bool                 acc_wrSetValid=false;
+    #pragma HLS RESET           variable=acc_wrSetValid
 
     //-- STATIC DATAFLOW VARIABLES ---------------------------------------------
-    static Ip4Addr    acc_ipLkpKey;
-
-    switch(acc_fsmState) {
-    case ACC_IDLE:
-        if (!siIPTX_MacLkpReq.empty()) {
-            acc_ipLkpKey = siIPTX_MacLkpReq.read();
-            if (acc_ipLkpKey == IP4_BROADCAST_ADDR) {
-                // Reply with Ethernet broadcast address and return immediately
-                soIPTX_MacLkpRep.write(ArpLkpReply(ETH_BROADCAST_ADDR, LKP_HIT));
-                acc_fsmState = ACC_IDLE;
+    static Ip4Addr    acc_lkpKey[ARP_LKP_IN_FLIGHT];
+    #pragma HLS ARRAY_PARTITION variable=acc_lkpKey  complete dim=1
+    static Ip4Addr    acc_reqAddr[ARP_PENDING_REQS];
+    #pragma HLS ARRAY_PARTITION variable=acc_reqAddr complete dim=1
+    static ap_uint<32> acc_reqTime[ARP_PENDING_REQS];  // Cycle of the last ARP-REQUEST
+    #pragma HLS ARRAY_PARTITION variable=acc_reqTime complete dim=1
+    static ArpBindPair          acc_updBind;    // The binding to insert after an eviction
+    static ArpAgingEntry        AGING_TABLE[ARP_AGING_SETS][ARP_AGING_WAYS];
+    #pragma HLS RESOURCE        variable=AGING_TABLE core=RAM_T2P_BRAM
+    #pragma HLS ARRAY_PARTITION variable=AGING_TABLE complete dim=2
+    #pragma HLS DATA_PACK       variable=AGING_TABLE
+    #pragma HLS DEPENDENCE      variable=AGING_TABLE inter false
+    // FYI - The set written in the previous cycle is read from this bypass
+    static ArpAgingEntry        acc_wrSet[ARP_AGING_WAYS];
+    #pragma HLS ARRAY_PARTITION variable=acc_wrSet complete dim=1
+    static ap_uint<6>           acc_wrSetIdx;
+
+    //-- DYNAMIC VARIABLES -----------------------------------------------------
+    bool    isPending = false;
+    bool    isFree    = false;
+    int     reqIdx    = acc_reqVictim;
+    bool    lkpPop    = false;
+    bool    lkpPush   = false;
+    Ip4Addr ipLkpKey  = acc_lkpKey[acc_lkpHead];
+    bool    doArpReq  = false;  // Single write site of 'soAPs_Meta'
+    Ip4Addr arpReqAddr;
+    bool    doUpd     = false;  // Single write site of 'soCAM_MacUpdReq'
+    RtlMacUpdateRequest updReq;
+    bool    doAging   = false;  // Single write site of 'AGING_TABLE'
+    ap_uint<6>    agingSetIdx;
+    int           agingWay  = 0;
+    ArpAgingEntry agingEntry;
+    ArpAgingEntry agingSet[ARP_AGING_WAYS];
+    #pragma HLS ARRAY_PARTITION variable=agingSet complete dim=1
+
+    acc_cycleCnt++;
+    if (acc_tickPrescaler == ARP_TICK_CYCLES-1) {
+        acc_tickPrescaler = 0;
+        acc_tickCnt++;
+    }
+    else {
+        acc_tickPrescaler++;
+    }
+
+    //-- Reply to the oldest lookup in flight ----------------------------------
+    if ((acc_lkpCnt > 0) and !soIPTX_MacLkpRep.full()) {
+        if (ipLkpKey == IP4_BROADCAST_ADDR) {
+            // Reply with Ethernet broadcast address without querying the CAM
+            soIPTX_MacLkpRep.write(ArpLkpReply(ETH_BROADCAST_ADDR, LKP_HIT, acc_epoch));
+            lkpPop = true;
+        }
+        else if (!siCAM_MacLkpRep.empty() and !soAPs_Meta.full()) {
+            // FYI - A miss may have to fire an ARP-REQUEST via 'soAPs_Meta'
+            RtlMacLookupReply macLkpReply = siCAM_MacLkpRep.read();
+            soIPTX_MacLkpRep.write(ArpLkpReply(macLkpReply.value, macLkpReply.hit, acc_epoch));
+            lkpPop = true;
+            if (!macLkpReply.hit) {
+                for (int i=0; i<ARP_PENDING_REQS; i++) {
+                  #pragma HLS UNROLL
+                    if (acc_reqValid[i] and (acc_reqAddr[i] == ipLkpKey)) {
+                        isPending = true;
+                        reqIdx    = i;
+                    }
+                    else if (not acc_reqValid[i] and not isFree and not isPending) {
+                        isFree    = true;
+                        reqIdx    = i;
+                    }
+                }
+                if (isPending and ((ap_uint<32>)(acc_cycleCnt - acc_reqTime[reqIdx]) < ARP_REQ_RETRY_CYCLES)) {
+                    if (DEBUG_LEVEL & TRACE_ACC) {
+                        printInfo(myName, "NO-HIT. An ARP-REQUEST is already pending for:\n");
+                        printIp4Addr(myName, ipLkpKey);
+                    }
+                }
+                else {
+                    if (DEBUG_LEVEL & TRACE_ACC) {
+                        printInfo(myName, "NO-HIT. Go and fire an ARP-REQUEST for:\n");
+                        printIp4Addr(myName, ipLkpKey);
+                    }
+                    doArpReq   = true;
+                    arpReqAddr = ipLkpKey;
+                    if (not isPending and not isFree) {
+                        // Recycle the entries in a round-robin fashion
+                        acc_reqVictim = (acc_reqVictim == ARP_PENDING_REQS-1) ? 0 : acc_reqVictim+1;
+                    }
+                    acc_reqValid[reqIdx] = true;
+                    acc_reqAddr[reqIdx]  = ipLkpKey;
+                    acc_reqTime[reqIdx]  = acc_cycleCnt;
+                }
             }
             else {
                 if (DEBUG_LEVEL & TRACE_ACC) {
-                    printInfo(myName, "FSM=ACC_IDLE - Request CAM to lookup MAC address binded to:\n");
-                    printIp4Addr(myName, acc_ipLkpKey);
+                    printInfo(myName, "HIT. Retrieved following address from CAM:\n");
+                    printEthAddr(myName, macLkpReply.value);
                 }
-                soCAM_MacLkpReq.write(RtlMacLookupRequest(acc_ipLkpKey));
-                acc_fsmState = ACC_LOOKUP;
             }
         }
-        else if (!siAPr_UpdateReq.empty()) {
-            ArpBindPair arpBind = siAPr_UpdateReq.read();
-            if (DEBUG_LEVEL & TRACE_ACC) {
-                printInfo(myName, "FSM=ACC_IDLE - Request CAM to update:\n");
-                printArpBindPair(myName, ArpBindPair(arpBind.macAddr, arpBind.ip4Addr));
-            }
-            soCAM_MacUpdReq.write(RtlMacUpdateRequest(arpBind.ip4Addr, arpBind.macAddr, ARP_INSERT));
-            acc_fsmState = ACC_UPDATE;
+        if (lkpPop) {
+            acc_lkpHead = (acc_lkpHead == ARP_LKP_IN_FLIGHT-1) ? 0 : acc_lkpHead+1;
         }
-        break;
-    case ACC_UPDATE:
-        if(!siCAM_MacUpdRep.empty()) {
-            siCAM_MacUpdRep.read();  // Consume the reply without actually acting on it
+    }
+
+    //-- Issue a new lookup ----------------------------------------------------
+    if (!siIPTX_MacLkpReq.empty() and (acc_lkpCnt < ARP_LKP_IN_FLIGHT) and !soCAM_MacLkpReq.full()) {
+        Ip4Addr newLkpKey = siIPTX_MacLkpReq.read();
+        if (newLkpKey != IP4_BROADCAST_ADDR) {
             if (DEBUG_LEVEL & TRACE_ACC) {
-                printInfo(myName, "FSM=ACC_UPDATE - Done with CAM update.\n");
+                printInfo(myName, "Request CAM to lookup MAC address binded to:\n");
+                printIp4Addr(myName, newLkpKey);
             }
-            acc_fsmState = ACC_IDLE;
+            soCAM_MacLkpReq.write(RtlMacLookupRequest(newLkpKey));
         }
+        acc_lkpKey[acc_lkpTail] = newLkpKey;
+        acc_lkpTail = (acc_lkpTail == ARP_LKP_IN_FLIGHT-1) ? 0 : acc_lkpTail+1;
+        lkpPush = true;
+    }
+    if (lkpPush and not lkpPop) {
+        acc_lkpCnt++;
+    }
+    else if (lkpPop and not lkpPush) {
+        acc_lkpCnt--;
+    }
+
+    //-- Update the CAM and age its bindings -----------------------------------
+    switch (acc_updFsmState) {
+    case UPD_INIT:
+        //-- Clear one set of the aging table per cycle
+        agingSetIdx = acc_initIdx;
+        for (int w=0; w<ARP_AGING_WAYS; w++) {
+          #pragma HLS UNROLL
+            agingSet[w] = ArpAgingEntry(0, 0, 0, 0, false);
+        }
+        agingEntry = agingSet[0];
+        doAging    = true;
+        if (acc_initIdx == ARP_AGING_SETS-1) {
+            acc_updFsmState = UPD_IDLE;
+        }
+        acc_initIdx++;
         break;
-    case ACC_LOOKUP:
-        if(!siCAM_MacLkpRep.empty()) {
-            RtlMacLookupReply macLkpReply = siCAM_MacLkpRep.read();
-            if (DEBUG_LEVEL & TRACE_ACC) {
-                printInfo(myName, "FSM=ACC_LOOKUP\n");
+    case UPD_IDLE:
+        if (!siAPr_UpdateReq.empty() and !soCAM_MacUpdReq.full()) {
+            ArpBindPair arpBind = siAPr_UpdateReq.read();
+            agingSetIdx = arpBind.ip4Addr(15,8) ^ arpBind.ip4Addr(7,0);
+            for (int w=0; w<ARP_AGING_WAYS; w++) {
+              #pragma HLS UNROLL
+                agingSet[w] = (acc_wrSetValid and (acc_wrSetIdx == agingSetIdx)) ?
+                              acc_wrSet[w] : AGING_TABLE[agingSetIdx][w];
             }
-            soIPTX_MacLkpRep.write(ArpLkpReply(macLkpReply.value, macLkpReply.hit));
-            if (!macLkpReply.hit) {
+            //-- Select the way of the binding, else a free way, else the
+            //--  least recently confirmed way of the set
+            bool wayHit  = false;
+            bool wayFree = false;
+            int  hitWay  = 0;
+            int  freeWay = 0;
+            int  oldWay  = 0;
+            for (int w=0; w<ARP_AGING_WAYS; w++) {
+              #pragma HLS UNROLL
+                if (agingSet[w].valid and (agingSet[w].ip4Addr == arpBind.ip4Addr)) {
+                    wayHit = true;
+                    hitWay = w;
+                }
+                else if (not agingSet[w].valid and not wayFree) {
+                    wayFree = true;
+                    freeWay = w;
+                }
+                if ((ap_uint<32>)(acc_tickCnt - agingSet[w].confirmed) >
+                    (ap_uint<32>)(acc_tickCnt - agingSet[oldWay].confirmed)) {
+                    oldWay = w;
+                }
+            }
+            agingWay = (wayHit) ? hitWay : (wayFree) ? freeWay : oldWay;
+            ArpAgingEntry oldEntry = agingSet[agingWay];
+            if (oldEntry.valid and (oldEntry.ip4Addr == arpBind.ip4Addr) and
+                                   (oldEntry.macAddr == arpBind.macAddr)) {
+                // The binding is confirmed. Only refresh its timestamps.
+                if (DEBUG_LEVEL & TRACE_ACC) {
+                    printInfo(myName, "Refresh the binding of:\n");
+                    printArpBindPair(myName, ArpBindPair(arpBind.macAddr, arpBind.ip4Addr));
+                }
+            }
+            else if (oldEntry.valid and (oldEntry.ip4Addr != arpBind.ip4Addr)) {
+                // Evict the colliding binding from the CAM before the insertion
                 if (DEBUG_LEVEL & TRACE_ACC) {
-                    printInfo(myName, "NO-HIT. Go and fire an ARP-REQUEST for:\n");
-                    printIp4Addr(myName, acc_ipLkpKey);
+                    printInfo(myName, "Request CAM to evict:\n");
+                    printArpBindPair(myName, ArpBindPair(oldEntry.macAddr, oldEntry.ip4Addr));
                 }
-                soAPs_Meta.write(acc_ipLkpKey);
+                doUpd         = true;
+                updReq        = RtlMacUpdateRequest(oldEntry.ip4Addr, oldEntry.macAddr, ARP_DELETE);
+                acc_updBind   = arpBind;
+                acc_updInsert = true;
+                acc_updFsmState = UPD_WAIT;
             }
             else {
                 if (DEBUG_LEVEL & TRACE_ACC) {
-                    printInfo(myName, "HIT. Retrieved following address from CAM:\n");
-                    printEthAddr(myName, macLkpReply.value);
+                    printInfo(myName, "Request CAM to update:\n");
+                    printArpBindPair(myName, ArpBindPair(arpBind.macAddr, arpBind.ip4Addr));
+                }
+              #ifndef __SYNTHESIS__
+                if (oldEntry.valid) {
+                    accNrMoves++;
+                }
+              #endif
+                doUpd  = true;
+                updReq = RtlMacUpdateRequest(arpBind.ip4Addr, arpBind.macAddr, ARP_INSERT);
+                acc_updFsmState = UPD_WAIT;
+            }
+            doAging    = true;
+            agingEntry = ArpAgingEntry(arpBind.ip4Addr, arpBind.macAddr,
+                                       acc_tickCnt, acc_tickCnt, true);
+            for (int i=0; i<ARP_PENDING_REQS; i++) {
+              #pragma HLS UNROLL
+                if (acc_reqAddr[i] == arpBind.ip4Addr) {
+                    acc_reqValid[i] = false;
                 }
             }
-            acc_fsmState = ACC_IDLE;
+        }
+        else if (!doArpReq and !soAPs_Meta.full() and !soCAM_MacUpdReq.full()) {
+            //-- Scan one entry of the aging table
+            agingSetIdx = acc_scanIdx / ARP_AGING_WAYS;
+            agingWay    = acc_scanIdx % ARP_AGING_WAYS;
+            for (int w=0; w<ARP_AGING_WAYS; w++) {
+              #pragma HLS UNROLL
+                agingSet[w] = (acc_wrSetValid and (acc_wrSetIdx == agingSetIdx)) ?
+                              acc_wrSet[w] : AGING_TABLE[agingSetIdx][w];
+            }
+            agingEntry = agingSet[agingWay];
+            if (agingEntry.valid) {
+                if ((ap_uint<32>)(acc_tickCnt - agingEntry.confirmed) >= ARP_ENTRY_TTL_TICKS) {
+                    if (DEBUG_LEVEL & TRACE_ACC) {
+                        printInfo(myName, "Request CAM to delete expired binding:\n");
+                        printArpBindPair(myName, ArpBindPair(agingEntry.macAddr, agingEntry.ip4Addr));
+                    }
+                    doUpd  = true;
+                    updReq = RtlMacUpdateRequest(agingEntry.ip4Addr, agingEntry.macAddr, ARP_DELETE);
+                    acc_updFsmState  = UPD_WAIT;
+                    agingEntry.valid = false;
+                    doAging = true;
+                  #ifndef __SYNTHESIS__
+                    accNrExpiries++;
+                  #endif
+                }
+                else if (((ap_uint<32>)(acc_tickCnt - agingEntry.confirmed) >= ARP_REFRESH_TICKS) and
+                         ((ap_uint<32>)(acc_tickCnt - agingEntry.probed)    >= ARP_REFRESH_RETRY_TICKS)) {
+                    if (DEBUG_LEVEL & TRACE_ACC) {
+                        printInfo(myName, "Fire an ARP-REQUEST to refresh:\n");
+                        printIp4Addr(myName, agingEntry.ip4Addr);
+                    }
+                    doArpReq   = true;
+                    arpReqAddr = agingEntry.ip4Addr;
+                    agingEntry.probed = acc_tickCnt;
+                    doAging = true;
+                  #ifndef __SYNTHESIS__
+                    accNrRefreshes++;
+                  #endif
+                }
+            }
+            acc_scanIdx++;
         }
         break;
+    case UPD_WAIT:
+        if (!siCAM_MacUpdRep.empty()) {
+            siCAM_MacUpdRep.read();  // Consume the reply without actually acting on it
+            acc_epoch++;
+            acc_updFsmState = (acc_updInsert) ? UPD_INSERT : UPD_IDLE;
+            if (DEBUG_LEVEL & TRACE_ACC) {
+                printInfo(myName, "Done with CAM update (epoch=%d).\n", acc_epoch.to_int());
+            }
+        }
+        break;
+    case UPD_INSERT:
+        if (!soCAM_MacUpdReq.full()) {
+            doUpd  = true;
+            updReq = RtlMacUpdateRequest(acc_updBind.ip4Addr, acc_updBind.macAddr, ARP_INSERT);
+            acc_updInsert = false;
+            acc_updFsmState = UPD_WAIT;
+        }
+        break;
+    } // End-of: switch (acc_updFsmState)
+
+    if (doUpd) {
+        soCAM_MacUpdReq.write(updReq);
+    }
+    if (doArpReq) {
+        soAPs_Meta.write(arpReqAddr);
+    }
+    if (doAging) {
+        agingSet[agingWay] = agingEntry;
+        for (int w=0; w<ARP_AGING_WAYS; w++) {
+          #pragma HLS UNROLL
+            AGING_TABLE[agingSetIdx][w] = agingSet[w];
+            acc_wrSet[w] = agingSet[w];
+        }
+        acc_wrSetIdx   = agingSetIdx;
+        acc_wrSetValid = true;
     }
 }
 
@@ -80,6 +80,50 @@ class ArpMeta  // ARP Metadata
     ArpMeta() {}
 };
 
+/********************************************
+ * Pending ARP-REQUESTS
+ *  One entry per next hop that the IPTX may
+ *  keep polling while it is being resolved.
+ ********************************************/
+static const int         ARP_PENDING_REQS     = IPTX_ARP_PARK_DSTS;
+static const ap_uint<32> ARP_REQ_RETRY_CYCLES = (ARP_REQ_RETRY_US/0.0064) + 1;
+
+/********************************************
+ * Aging of the ARP Bindings
+ *  The bindings are aged with a coarse tick
+ *  of 1ms. The testbench uses a tick of one
+ *  clock cycle and a much shorter second.
+ *  The aging table is set-associative and a
+ *  set is indexed by IP[15:8]^IP[7:0].
+ ********************************************/
+static const int         ARP_AGING_WAYS       = 4;
+static const int         ARP_AGING_SETS       = 64;
+static const int         ARP_AGING_ENTRIES    = ARP_AGING_SETS * ARP_AGING_WAYS;
+#ifndef __SYNTHESIS__
+  static const ap_uint<32> ARP_TICK_CYCLES    = 1;
+  static const ap_uint<32> ARP_TIME_1s        = 100;  // In ticks
+#else
+  static const ap_uint<32> ARP_TICK_CYCLES    = (1000/0.0064);
+  static const ap_uint<32> ARP_TIME_1s        = 1000; // In ticks
+#endif
+static const ap_uint<32> ARP_REFRESH_TICKS    = ARP_REFRESH_S   * ARP_TIME_1s;
+static const ap_uint<32> ARP_ENTRY_TTL_TICKS  = ARP_ENTRY_TTL_S * ARP_TIME_1s;
+static const ap_uint<32> ARP_REFRESH_RETRY_TICKS = ARP_TIME_1s;
+
+class ArpAgingEntry {
+  public:
+    Ip4Addr         ip4Addr;
+    EthAddr         macAddr;
+    ap_uint<32>     confirmed;  // Tick of the last ARP packet from this binding
+    ap_uint<32>     probed;     // Tick of the last refresh ARP-REQUEST
+    ValBool         valid;
+    ArpAgingEntry() {}
+    ArpAgingEntry(Ip4Addr ip4Addr, EthAddr macAddr, ap_uint<32> confirmed,
+                  ap_uint<32> probed, ValBool valid) :
+        ip4Addr(ip4Addr), macAddr(macAddr), confirmed(confirmed),
+        probed(probed), valid(valid) {}
+};
+
 /********************************************
  * CAM / Lookup OpCodes
  ********************************************/
@@ -203,6 +247,11 @@ class RtlMacLookupReply {
     );
 #endif    // HLS_VERSION
 
+#ifndef __SYNTHESIS__
+  void getArpAgingStats(unsigned int &nrRefreshes, unsigned int &nrExpiries,
+                        unsigned int &nrMoves);
+#endif
+
 #endif
 
 /*! \} */
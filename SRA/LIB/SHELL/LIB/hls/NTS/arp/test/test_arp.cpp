@@ -373,6 +373,128 @@ void pEmulateCam(
 
 } // End-of: pEmulateCam()
 
+/*******************************************************************************
+ * @brief Write an ARP-over-ETHERNET frame into a stream.
+ *
+ * @param[out] soData  The stream to write.
+ * @param[in]  ethDA   The MAC destination address of the frame.
+ * @param[in]  oper    The ARP operation (REQUEST or REPLY).
+ * @param[in]  sha     The Sender Hardware Address.
+ * @param[in]  spa     The Sender Protocol Address.
+ * @param[in]  tha     The Target Hardware Address.
+ * @param[in]  tpa     The Target Protocol Address.
+ *******************************************************************************/
+void writeArpFrame(
+        stream<AxisEth> &soData,
+        EthAddr          ethDA,
+        ArpOper          oper,
+        EthAddr          sha,
+        Ip4Addr          spa,
+        EthAddr          tha,
+        Ip4Addr          tpa)
+{
+    for (int i=0; i<6; i++) {
+        AxisEth chunk(0, 0xFF, 0);
+        switch(i) {
+        case 0:
+            chunk.setEthDstAddr(ethDA);
+            chunk.setEthSrcAddrHi(sha);
+            break;
+        case 1:
+            chunk.setEthSrcAddrLo(sha);
+            chunk.setEthertType(ETH_ETHERTYPE_ARP);
+            chunk.setArpHwType(ARP_HTYPE_ETHERNET);
+            break;
+        case 2:
+            chunk.setArpProtType(ARP_PTYPE_IPV4);
+            chunk.setArpHwLen(ARP_HLEN_ETHERNET);
+            chunk.setArpProtLen(ARP_PLEN_IPV4);
+            chunk.setArpOper(oper);
+            chunk.setArpShaHi(sha);
+            break;
+        case 3:
+            chunk.setArpShaLo(sha);
+            chunk.setArpSpa(spa);
+            break;
+        case 4:
+            chunk.setArpTha(tha);
+            chunk.setArpTpaHi(tpa);
+            break;
+        case 5:
+            chunk.setArpTpaLo(tpa);
+            chunk.setLE_TKeep(0x03);
+            chunk.setLE_TLast(TLAST);
+            break;
+        }
+        soData.write(chunk);
+    }
+}
+
+/*******************************************************************************
+ * @brief Emulate a peer which answers the ARP-REQUESTs of the ARP server (ARS).
+ *
+ * @param[in]  siARS_Data   The ARP frames from [ARS].
+ * @param[out] soARS_Data   The ARP frames to [ARS].
+ * @param[in]  myMacAddress The MAC  address of the FPGA.
+ * @param[in]  myIp4Address The IPv4 address of the FPGA.
+ * @param[in]  peerMac      The current MAC address of the peer.
+ * @param[in]  peerIsAlive  Answers the ARP-REQUESTs when true.
+ * @param[out] nrPeerReqs   Incremented upon every ARP-REQUEST for the peer.
+ *
+ * @details
+ *  The ARP-REQUESTs are answered after PEER_REPLY_LATENCY cycles. Any other
+ *  frame from [ARS] is consumed and discarded.
+ *******************************************************************************/
+void pEmulatePeer(
+        stream<AxisEth>  &siARS_Data,
+        stream<AxisEth>  &soARS_Data,
+        EthAddr           myMacAddress,
+        Ip4Addr           myIp4Address,
+        EthAddr           peerMac,
+        bool              peerIsAlive,
+        int              &nrPeerReqs)
+{
+    static int       chunkCnt  = 0;
+    static ArpOper   arpOper   = 0;
+    static Ip4Addr   arpTpa    = 0;
+    static int       replyWait = -1;  // Cycles before replying, -1 when none
+
+    if (!siARS_Data.empty()) {
+        AxisEth chunk = siARS_Data.read();
+        switch(chunkCnt) {
+        case 2:
+            arpOper = chunk.getArpOper();
+            break;
+        case 4:
+            arpTpa(31,16) = chunk.getArpTpaHi();
+            break;
+        case 5:
+            arpTpa(15, 0) = chunk.getArpTpaLo();
+            break;
+        }
+        chunkCnt++;
+        if (chunk.getTLast()) {
+            if ((arpOper == ARP_OPER_REQUEST) and (arpTpa == PEER_IP4_ADDRESS)) {
+                nrPeerReqs++;
+                if (peerIsAlive) {
+                    replyWait = PEER_REPLY_LATENCY;
+                }
+            }
+            chunkCnt = 0;
+        }
+    }
+    if (replyWait == 0) {
+        if (peerIsAlive) {
+            writeArpFrame(soARS_Data, myMacAddress, ARP_OPER_REPLY, peerMac,
+                          PEER_IP4_ADDRESS, myMacAddress, myIp4Address);
+        }
+        replyWait = -1;
+    }
+    else if (replyWait > 0) {
+        replyWait--;
+    }
+}
+
 #if HLS_VERSION != 2017
 /*******************************************************************************
  * @brief A wrapper for the Toplevel of the Address Resolution Protocol (ARP)
@@ -745,6 +867,210 @@ int main(int argc, char* argv[]) {
         hostMapIter++;
     }
 
+    printf("\n\n");
+    printInfo(THIS_NAME, "############################################################################\n");
+    printInfo(THIS_NAME, "## TESTBENCH 'test_arp' PART-4 STARTS HERE                                ##\n");
+    printInfo(THIS_NAME, "############################################################################\n");
+
+    //-----------------------------------------------------
+    //-- MAIN LOOP-4 : Age the binding of a peer which
+    //--    silently moves its MAC address, then announces
+    //--    a new move with a gratuitous ARP, and finally
+    //--    dies. The lookups of the peer are expected to
+    //--    hit as long as it is alive, and the window
+    //--    during which they return its former MAC address
+    //--    is measured for each move.
+    //--    A neighbour whose binding falls in the same set
+    //--    of the aging table is also expected to hit.
+    //--    FYI - The ETH traffic of this loop is consumed
+    //--    by the peer and is not part of the golden file.
+    //-----------------------------------------------------
+    enum { PH_BIND=0, PH_SILENT_MOVE, PH_STEADY, PH_GRATUITOUS, PH_DEATH, PH_DONE } phase = PH_BIND;
+    const char *phaseName[] = { "BIND", "SILENT_MOVE", "STEADY", "GRATUITOUS", "DEATH", "DONE" };
+    const unsigned int silentMaxWindow = ARP_REFRESH_TICKS*ARP_TICK_CYCLES + ARP_AGING_ENTRIES + 2*PEER_REPLY_LATENCY;
+    const unsigned int deathMaxWindow  = ARP_ENTRY_TTL_TICKS*ARP_TICK_CYCLES + ARP_AGING_ENTRIES + 2*PEER_REPLY_LATENCY;
+    const unsigned int steadyCycles    = ARP_ENTRY_TTL_TICKS*ARP_TICK_CYCLES + ARP_AGING_ENTRIES;
+    EthAddr      peerMac      = 0x0A0B0C0D0E01;
+    EthAddr      peerMacPrev  = peerMac;
+    bool         peerIsAlive  = true;
+    int          nrPeerReqs   = 0;
+    int          nrSteadyReqs = 0;
+    unsigned int phaseStart   = gSimCycCnt;
+    unsigned int lkpCycle     = 0;
+    unsigned int silentWindow = 0, garpWindow = 0, deathWindow = 0;
+    bool         nborHit      = false;
+
+    // The peer and its neighbour announce themselves by requesting the MAC address of the FPGA
+    writeArpFrame(ssIPRX_ARS_Data, ETH_BROADCAST_ADDR, ARP_OPER_REQUEST, peerMac,
+                  PEER_IP4_ADDRESS, 0, myIp4Address);
+    writeArpFrame(ssIPRX_ARS_Data, ETH_BROADCAST_ADDR, ARP_OPER_REQUEST, NBOR_MAC_ADDRESS,
+                  NBOR_IP4_ADDRESS, 0, myIp4Address);
+    tbRun = (nrErr == 0) ? (silentMaxWindow + steadyCycles + deathMaxWindow + 2*TB_GRACE_TIME) : 0;
+    while (tbRun and (phase != PH_DONE)) {
+      //-- RUN DUT --------------------------------------
+      #if HLS_VERSION == 2017
+        arp_top(
+            myMacAddress,
+            myIp4Address,
+            ssIPRX_ARS_Data,
+            ssARS_ETH_Data,
+            ssIPTX_ARS_MacLkpReq,
+            ssARS_IPTX_MacLkpRep,
+            ssARS_CAM_MacLkpReq,
+            ssCAM_ARS_MacLkpRep,
+            ssARS_CAM_MacUpdReq,
+            ssCAM_ARS_MacUpdRep);
+      #else
+        arp_top_wrap(
+            myMacAddress,
+            myIp4Address,
+            ssIPRX_ARS_Data,
+            ssARS_ETH_Data,
+            ssIPTX_ARS_MacLkpReq,
+            ssARS_IPTX_MacLkpRep,
+            ssARS_CAM_MacLkpReq,
+            ssCAM_ARS_MacLkpRep,
+            ssARS_CAM_MacUpdReq,
+            ssCAM_ARS_MacUpdRep);
+      #endif
+
+        //-- EMULATE ARP CAM ------------------------------
+        pEmulateCam(
+            ssARS_CAM_MacLkpReq,
+            ssCAM_ARS_MacLkpRep,
+            ssARS_CAM_MacUpdReq,
+            ssCAM_ARS_MacUpdRep
+        );
+
+        //-- EMULATE THE PEER -----------------------------
+        pEmulatePeer(
+            ssARS_ETH_Data,
+            ssIPRX_ARS_Data,
+            myMacAddress,
+            myIp4Address,
+            peerMac,
+            peerIsAlive,
+            nrPeerReqs);
+
+        //-- EMULATE THE LOOKUPS OF IPTX ------------------
+        if (++lkpCycle == IPTX_LKP_PERIOD) {
+            ssIPTX_ARS_MacLkpReq.write(PEER_IP4_ADDRESS);
+            lkpCycle = 0;
+        }
+        if ((phase == PH_SILENT_MOVE) and (gSimCycCnt - phaseStart == TB_GRACE_TIME)) {
+            // Check that the binding of the neighbour was not evicted by the peer
+            ssIPTX_ARS_MacLkpReq.write(NBOR_IP4_ADDRESS);
+        }
+        if (!ssARS_IPTX_MacLkpRep.empty()) {
+            ArpLkpReply lkpRep = ssARS_IPTX_MacLkpRep.read();
+            unsigned int elapsed = gSimCycCnt - phaseStart;
+            switch (phase) {
+            case PH_BIND:
+                if (lkpRep.hit and (lkpRep.macAddress == peerMac)) {
+                    // Move the MAC address of the peer without telling anyone
+                    peerMacPrev = peerMac;
+                    peerMac     = 0x0A0B0C0D0E02;
+                    phase       = PH_SILENT_MOVE;
+                    phaseStart  = gSimCycCnt;
+                }
+                break;
+            case PH_SILENT_MOVE:
+                if (not lkpRep.hit) {
+                    printError(THIS_NAME, "Phase %s - Received a \'NO_HIT\' while the peer is alive (@%d).\n",
+                               phaseName[phase], gSimCycCnt);
+                    nrErr++;
+                }
+                else if (lkpRep.macAddress == NBOR_MAC_ADDRESS) {
+                    nborHit = true;
+                }
+                else if (lkpRep.macAddress == peerMac) {
+                    silentWindow = elapsed;
+                    phase        = PH_STEADY;
+                    phaseStart   = gSimCycCnt;
+                    nrSteadyReqs = nrPeerReqs;
+                }
+                break;
+            case PH_STEADY:
+                if ((not lkpRep.hit) or (lkpRep.macAddress != peerMac)) {
+                    printError(THIS_NAME, "Phase %s - Received a wrong MAC lookup reply (@%d).\n",
+                               phaseName[phase], gSimCycCnt);
+                    printEthAddr(THIS_NAME, "  Expected : ", peerMac);
+                    printEthAddr(THIS_NAME, "  Received : ", lkpRep.macAddress);
+                    nrErr++;
+                }
+                if (elapsed >= steadyCycles) {
+                    // Move the MAC address of the peer and announce it
+                    peerMacPrev = peerMac;
+                    peerMac     = 0x0A0B0C0D0E03;
+                    writeArpFrame(ssIPRX_ARS_Data, ETH_BROADCAST_ADDR, ARP_OPER_REQUEST, peerMac,
+                                  PEER_IP4_ADDRESS, 0, PEER_IP4_ADDRESS);
+                    nrSteadyReqs = nrPeerReqs - nrSteadyReqs;
+                    phase        = PH_GRATUITOUS;
+                    phaseStart   = gSimCycCnt;
+                }
+                break;
+            case PH_GRATUITOUS:
+                if (not lkpRep.hit) {
+                    printError(THIS_NAME, "Phase %s - Received a \'NO_HIT\' while the peer is alive (@%d).\n",
+                               phaseName[phase], gSimCycCnt);
+                    nrErr++;
+                }
+                else if (lkpRep.macAddress == peerMac) {
+                    garpWindow  = elapsed;
+                    peerIsAlive = false;
+                    phase       = PH_DEATH;
+                    phaseStart  = gSimCycCnt;
+                }
+                break;
+            case PH_DEATH:
+                if (not lkpRep.hit) {
+                    deathWindow = elapsed;
+                    phase       = PH_DONE;
+                }
+                break;
+            default:
+                break;
+            }
+        }
+
+        tbRun--;
+        stepSim();
+    } // End of: while()
+
+    unsigned int nrRefreshes, nrExpiries, nrMoves;
+    getArpAgingStats(nrRefreshes, nrExpiries, nrMoves);
+    printInfo(THIS_NAME, "Aging of the ARP bindings:\n");
+    printInfo(THIS_NAME, "\tLoss window upon a silent MAC move     = %5d cycles (max=%d).\n", silentWindow, silentMaxWindow);
+    printInfo(THIS_NAME, "\tLoss window upon a gratuitous ARP move = %5d cycles (max=%d).\n", garpWindow, GARP_MAX_WINDOW);
+    printInfo(THIS_NAME, "\tExpiry of the binding of a dead peer   = %5d cycles (max=%d).\n", deathWindow, deathMaxWindow);
+    printInfo(THIS_NAME, "\tRefreshes=%d, Expiries=%d, Moves=%d.\n", nrRefreshes, nrExpiries, nrMoves);
+    if (phase != PH_DONE) {
+        printError(THIS_NAME, "The aging test did not complete (stuck in phase %s).\n", phaseName[phase]);
+        nrErr++;
+    }
+    else {
+        if (silentWindow > silentMaxWindow) {
+            printError(THIS_NAME, "The binding of the peer was not refreshed in time upon a silent MAC move.\n");
+            nrErr++;
+        }
+        if (garpWindow > GARP_MAX_WINDOW) {
+            printError(THIS_NAME, "The binding of the peer was not updated in time upon a gratuitous ARP.\n");
+            nrErr++;
+        }
+        if (deathWindow > deathMaxWindow) {
+            printError(THIS_NAME, "The binding of the dead peer did not expire in time.\n");
+            nrErr++;
+        }
+        if (nrSteadyReqs == 0) {
+            printError(THIS_NAME, "The binding of the peer was never refreshed while it was alive.\n");
+            nrErr++;
+        }
+        if (not nborHit) {
+            printError(THIS_NAME, "The binding of a neighbour in the same aging set was lost.\n");
+            nrErr++;
+        }
+    }
+
     printInfo(THIS_NAME, "############################################################################\n");
     printInfo(THIS_NAME, "## TESTBENCH 'test_arp' ENDS HERE                                         ##\n");
     printInfo(THIS_NAME, "############################################################################\n");
@@ -58,6 +58,20 @@
 
 const Ip4Addr RESERVED_SENDER_PROTOCOL_ADDRESS = 0xCAFEFADE; // Do not use in DAT files
 
+//---------------------------------------------------------
+//-- TESTBENCH DEFINES FOR THE AGING OF THE ARP BINDINGS
+//--  A peer moves its MAC address and the window during
+//--  which the lookups still return its former address
+//--  is measured.
+//---------------------------------------------------------
+#define PEER_REPLY_LATENCY   50  // Cycles before the peer answers an ARP-REQUEST
+#define IPTX_LKP_PERIOD      20  // Cycles between two lookups of the peer
+#define GARP_MAX_WINDOW     100  // Max loss window upon a gratuitous ARP (in cycles)
+
+const Ip4Addr PEER_IP4_ADDRESS = 0x0A0CC863; // 10.12.200.99 - Do not use in DAT files
+const Ip4Addr NBOR_IP4_ADDRESS = 0x0A0C63C8; // 10.12.99.200 - Same aging set as the peer
+const EthAddr NBOR_MAC_ADDRESS = 0x0A0B0C0D0EFF;
+
 //---------------------------------------------------------
 //-- TESTBENCH GLOBAL VARIABLES
 //--  These variables might be updated/overwritten by the
@@ -0,0 +1,93 @@
+/*
+ * Copyright 2016 -- 2021 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*******************************************************************************
+ * @file       : axis_width.cpp
+ * @brief      : Width-generic AXI4-Stream parsers of the NTS.
+ *
+ * System:     : cloudFPGA
+ * Component   : Shell, Network Transport Stack (NTS)
+ * Language    : Vivado HLS
+ *
+ * \ingroup NTS
+ * \addtogroup NTS_AXIS
+ * \{
+ *******************************************************************************/
+
+#include "axis_width.hpp"
+
+using namespace hls;
+
+/*******************************************************************************
+ * @brief Main process of the width-generic parsers at 100GbE.
+ *
+ * @param[in]  siMAC_Data        The frames from the MAC as chunks of 512 bits.
+ * @param[out] soMeta            The extracted header fields (one per frame).
+ * @param[in]  piMMIO_Ip4Address The IPv4 address from MMIO (in network order).
+ * @param[in]  siICa_Data        The IPv4 frames to the IP Checksum Accumulator (ICa).
+ * @param[out] soICa_Data        The IPv4 packets re-aligned by [ICa].
+ * @param[out] soICa_IpVer       The IP version from [ICa].
+ * @param[out] soICa_DropCmd     The fragment drop command from [ICa].
+ * @param[out] soICa_HdrSum      The sum of the IPv4 header from [ICa].
+ *
+ * @details
+ *  This entity is only used to synthesize the width-generic parsers at the
+ *  widest chunk width and to assess that they still close timing at II=1. It
+ *  instantiates the header parser of this sub-project along with the IP
+ *  Checksum Accumulator of the IPRX (see 'iprx.hpp'). The testbench exercises
+ *  the other widths directly in C-simulation.
+ *******************************************************************************/
+void axis_width(
+        //-- AXI4-Stream Header Parser (AHP)
+        stream<AxisRawT<AXIS_RAW_WIDTH_AT_100GE> > &siMAC_Data,
+        stream<AxisHdrMeta>                        &soMeta,
+        //-- IPRX / IP Checksum Accumulator (ICa)
+        Ip4Addr                                     piMMIO_Ip4Address,
+        stream<AxisRawT<AXIS_RAW_WIDTH_AT_100GE> > &siICa_Data,
+        stream<AxisRawT<AXIS_RAW_WIDTH_AT_100GE> > &soICa_Data,
+        stream<Ip4Version>                         &soICa_IpVer,
+        stream<CmdBit>                             &soICa_DropCmd,
+        stream<IpHdrSum>                           &soICa_HdrSum)
+{
+    //-- DIRECTIVES FOR THE BLOCK ---------------------------------------------
+    #pragma HLS INTERFACE ap_ctrl_none port=return
+    #pragma HLS INTERFACE axis off     port=siMAC_Data
+    #pragma HLS INTERFACE axis off     port=soMeta
+    #pragma HLS DATA_PACK              variable=soMeta
+    #pragma HLS INTERFACE ap_stable    port=piMMIO_Ip4Address
+    #pragma HLS INTERFACE axis off     port=siICa_Data
+    #pragma HLS INTERFACE axis off     port=soICa_Data
+    #pragma HLS INTERFACE axis off     port=soICa_IpVer
+    #pragma HLS INTERFACE axis off     port=soICa_DropCmd
+    #pragma HLS INTERFACE axis off     port=soICa_HdrSum
+    #pragma HLS DATA_PACK              variable=soICa_HdrSum
+
+    #pragma HLS DATAFLOW
+
+    pAxisHeaderParser<AXIS_RAW_WIDTH_AT_100GE>(
+            siMAC_Data,
+            soMeta);
+
+    pIpChecksumAccumulator<AXIS_RAW_WIDTH_AT_100GE>(
+            piMMIO_Ip4Address,
+            siICa_Data,
+            soICa_Data,
+            soICa_IpVer,
+            soICa_DropCmd,
+            soICa_HdrSum);
+}
+
+/*! \} */
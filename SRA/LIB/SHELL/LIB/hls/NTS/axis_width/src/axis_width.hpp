@@ -0,0 +1,177 @@
+/*
+ * Copyright 2016 -- 2021 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*******************************************************************************
+ * @file       : axis_width.hpp
+ * @brief      : Width-generic AXI4-Stream Header Parser (AHP).
+ *
+ * System:     : cloudFPGA
+ * Component   : Shell, Network Transport Stack (NTS)
+ * Language    : Vivado HLS
+ *
+ * \ingroup NTS
+ * \addtogroup NTS_AXIS
+ * \{
+ *******************************************************************************/
+
+#ifndef _AXIS_WIDTH_H_
+#define _AXIS_WIDTH_H_
+
+#include "../../../NTS/nts_utils.hpp"
+#include "../../../NTS/iprx/src/iprx.hpp"
+
+using namespace hls;
+
+/*******************************************************************************
+ * HEADER PARSER - FIELD OFFSETS
+ *  The offsets are given in bytes from the start of the Ethernet frame. The
+ *  offsets of the layer-4 ports are relative to the start of the IPv4 header.
+ *******************************************************************************/
+#define AHP_ETH_TYPE_OFF    12
+#define AHP_IP4_HDR_OFF     14
+#define AHP_IP4_IHL_OFF     (AHP_IP4_HDR_OFF+ 0)
+#define AHP_IP4_TOTLEN_OFF  (AHP_IP4_HDR_OFF+ 2)
+#define AHP_IP4_PROT_OFF    (AHP_IP4_HDR_OFF+ 9)
+#define AHP_IP4_SA_OFF      (AHP_IP4_HDR_OFF+12)
+#define AHP_IP4_DA_OFF      (AHP_IP4_HDR_OFF+16)
+
+/*******************************************************************************
+ * Header Metadata
+ *  The header fields of an Ethernet/IPv4/Layer-4 frame as extracted by [AHP].
+ *******************************************************************************/
+class AxisHdrMeta {
+  public:
+    EtherType   etherType;
+    Ip4HdrLen   ipHdrLen;   // In 32-bit words
+    Ip4TotalLen ipTotLen;
+    Ip4Prot     ipProt;
+    Ip4Addr     ipSa;
+    Ip4Addr     ipDa;
+    Ly4Port     l4SrcPort;
+    Ly4Port     l4DstPort;
+    AxisHdrMeta() :
+        etherType(0), ipHdrLen(0), ipTotLen(0), ipProt(0),
+        ipSa(0), ipDa(0), l4SrcPort(0), l4DstPort(0) {}
+};
+
+/*******************************************************************************
+ * @brief AXI4-Stream Header Parser (AHP)
+ *
+ * @param[in]  siData  The incoming Ethernet frames as chunks of 'W' bits.
+ * @param[out] soMeta  The extracted header fields (one per frame).
+ *
+ * @details
+ *  Extracts the Ethernet, IPv4 and layer-4 header fields of a frame at a rate
+ *  of one chunk per clock cycle, whatever the width 'W' of the chunk. The
+ *  current chunk is concatenated with the previous one into a window of '2*W'
+ *  bits, which holds every field ending in the current chunk as long as the
+ *  field is not larger than a chunk. A field is therefore extracted at any
+ *  alignment, even when it straddles two chunks, and the offset of the
+ *  layer-4 ports is derived from the IPv4 header length on the fly.
+ *  The metadata of a frame is forwarded upon its last chunk and is cleared
+ *  afterwards, such that a field missing from a short frame reads as zero.
+ *******************************************************************************/
+template<int W>
+void pAxisHeaderParser(
+        stream<AxisRawT<W> >  &siData,
+        stream<AxisHdrMeta>   &soMeta)
+{
+    //-- DIRECTIVES FOR THIS PROCESS ------------------------------------------
+    #pragma HLS INLINE off
+    #pragma HLS PIPELINE II=1 enable_flush
+
+    //-- STATIC CONTROL VARIABLES (with RESET) --------------------------------
+    static ap_uint<16>      ahp_chunkCnt=0;
+    #pragma HLS RESET                 variable=ahp_chunkCnt
+
+    //-- STATIC DATAFLOW VARIABLES --------------------------------------------
+    static ap_uint<W>       ahp_prevData;
+    static AxisHdrMeta      ahp_meta;
+
+    //-- DYNAMIC VARIABLES ----------------------------------------------------
+    AxisRawT<W>             currChunk;
+    AxisRawT<2*W>           window;
+
+    if (!siData.empty() and !soMeta.full()) {
+        siData.read(currChunk);
+        //-- The previous chunk goes into the lower bytes of the window
+        window.setLE_TData(ahp_prevData,              W-1,   0);
+        window.setLE_TData(currChunk.getLE_TData(), 2*W-1,   W);
+        int chunkOff = ahp_chunkCnt * (W/8);
+        int winOff   = chunkOff - (W/8);
+
+        if (fieldEndsInChunk(AHP_ETH_TYPE_OFF, 2, chunkOff, W/8)) {
+            ahp_meta.etherType = window.template getBeField<2>(AHP_ETH_TYPE_OFF - winOff);
+        }
+        Ip4HdrLen ihl = ahp_meta.ipHdrLen;
+        if (fieldEndsInChunk(AHP_IP4_IHL_OFF, 1, chunkOff, W/8)) {
+            ihl = window.template getBeField<1>(AHP_IP4_IHL_OFF - winOff).range(3, 0);
+            ahp_meta.ipHdrLen = ihl;
+        }
+        if (fieldEndsInChunk(AHP_IP4_TOTLEN_OFF, 2, chunkOff, W/8)) {
+            ahp_meta.ipTotLen = window.template getBeField<2>(AHP_IP4_TOTLEN_OFF - winOff);
+        }
+        if (fieldEndsInChunk(AHP_IP4_PROT_OFF, 1, chunkOff, W/8)) {
+            ahp_meta.ipProt = window.template getBeField<1>(AHP_IP4_PROT_OFF - winOff);
+        }
+        if (fieldEndsInChunk(AHP_IP4_SA_OFF, 4, chunkOff, W/8)) {
+            ahp_meta.ipSa = window.template getBeField<4>(AHP_IP4_SA_OFF - winOff);
+        }
+        if (fieldEndsInChunk(AHP_IP4_DA_OFF, 4, chunkOff, W/8)) {
+            ahp_meta.ipDa = window.template getBeField<4>(AHP_IP4_DA_OFF - winOff);
+        }
+        int l4Off = AHP_IP4_HDR_OFF + 4*ihl;
+        if (fieldEndsInChunk(l4Off, 2, chunkOff, W/8)) {
+            ahp_meta.l4SrcPort = window.template getBeField<2>(l4Off - winOff);
+        }
+        if (fieldEndsInChunk(l4Off+2, 2, chunkOff, W/8)) {
+            ahp_meta.l4DstPort = window.template getBeField<2>(l4Off+2 - winOff);
+        }
+
+        if (currChunk.getTLast()) {
+            soMeta.write(ahp_meta);
+            // Clear the fields, such that a short frame never reports the
+            //  fields of the previous one
+            ahp_meta = AxisHdrMeta();
+            ahp_chunkCnt = 0;
+        }
+        else {
+            ahp_chunkCnt++;
+        }
+        ahp_prevData = currChunk.getLE_TData();
+    }
+}
+
+/*******************************************************************************
+ *
+ * @brief ENTITY - Width-generic parsers at 100GbE (AHP and IPRX/ICa)
+ *
+ *******************************************************************************/
+void axis_width(
+        //-- AXI4-Stream Header Parser (AHP)
+        stream<AxisRawT<AXIS_RAW_WIDTH_AT_100GE> > &siMAC_Data,
+        stream<AxisHdrMeta>                        &soMeta,
+        //-- IPRX / IP Checksum Accumulator (ICa)
+        Ip4Addr                                     piMMIO_Ip4Address,
+        stream<AxisRawT<AXIS_RAW_WIDTH_AT_100GE> > &siICa_Data,
+        stream<AxisRawT<AXIS_RAW_WIDTH_AT_100GE> > &soICa_Data,
+        stream<Ip4Version>                         &soICa_IpVer,
+        stream<CmdBit>                             &soICa_DropCmd,
+        stream<IpHdrSum>                           &soICa_HdrSum);
+
+#endif
+
+/*! \} */
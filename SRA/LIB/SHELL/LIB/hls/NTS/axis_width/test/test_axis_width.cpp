@@ -0,0 +1,533 @@
+/*
+ * Copyright 2016 -- 2021 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*******************************************************************************
+ * @file       : test_axis_width.cpp
+ * @brief      : Testbench for the width-generic AXI4-Stream parsers.
+ *
+ * System:     : cloudFPGA
+ * Component   : Shell, Network Transport Stack (NTS)
+ * Language    : Vivado HLS
+ *
+ * \ingroup NTS_AXIS
+ * \addtogroup NTS_AXIS_TEST
+ * \{
+ *******************************************************************************/
+
+#include "test_axis_width.hpp"
+
+using namespace hls;
+using namespace std;
+
+//---------------------------------------------------------
+// HELPERS FOR THE DEBUGGING TRACES
+//  .e.g: DEBUG_LEVEL = (TRACE_RCV)
+//---------------------------------------------------------
+#define THIS_NAME "TB"
+
+#define TRACE_OFF    0x0000
+#define TRACE_RCV    1 << 1
+#define TRACE_ALL    0xFFFF
+#define DEBUG_LEVEL (TRACE_OFF)
+
+/*******************************************************************************
+ * @brief Increment the simulation counter
+ *******************************************************************************/
+void stepSim() {
+    gSimCycCnt++;
+    if (gTraceEvent) {
+        printInfo(THIS_NAME, "-- [@%4.4d] -----------------------------\n", gSimCycCnt);
+        gTraceEvent = false;
+    }
+}
+
+/*******************************************************************************
+ * @brief Build an Ethernet/IPv4/Layer-4 frame.
+ *
+ * @param[in]  frmLen  The length of the frame in bytes.
+ * @param[in]  ihl     The IPv4 header length in 32-bit words.
+ * @param[out] bytes   The bytes of the frame.
+ * @param[out] meta    The header fields expected from the DUT.
+ *******************************************************************************/
+void buildFrame(int frmLen, int ihl, vector<ap_uint<8> > &bytes, AxisHdrMeta &meta) {
+    bytes.resize(frmLen);
+    for (int i=0; i<frmLen; i++) {
+        bytes[i] = rand() & 0xFF;
+    }
+    meta.etherType = ETH_ETHERTYPE_IP4;
+    meta.ipHdrLen  = ihl;
+    meta.ipTotLen  = frmLen - AHP_IP4_HDR_OFF;
+    meta.ipProt    = (rand() & 1) ? IP4_PROT_TCP : IP4_PROT_UDP;
+    meta.ipSa      = rand();
+    meta.ipDa      = rand();
+    meta.l4SrcPort = rand() & 0xFFFF;
+    meta.l4DstPort = rand() & 0xFFFF;
+    //-- Store the fields in network byte order
+    bytes[AHP_ETH_TYPE_OFF+0]   = meta.etherType.range(15,  8);
+    bytes[AHP_ETH_TYPE_OFF+1]   = meta.etherType.range( 7,  0);
+    bytes[AHP_IP4_IHL_OFF]      = 0x40 | ihl;
+    bytes[AHP_IP4_TOTLEN_OFF+0] = meta.ipTotLen.range(15,  8);
+    bytes[AHP_IP4_TOTLEN_OFF+1] = meta.ipTotLen.range( 7,  0);
+    bytes[AHP_IP4_PROT_OFF]     = meta.ipProt;
+    for (int i=0; i<4; i++) {
+        bytes[AHP_IP4_SA_OFF+i] = meta.ipSa.range(31-8*i, 24-8*i);
+        bytes[AHP_IP4_DA_OFF+i] = meta.ipDa.range(31-8*i, 24-8*i);
+    }
+    int l4Off = AHP_IP4_HDR_OFF + 4*ihl;
+    bytes[l4Off+0] = meta.l4SrcPort.range(15,  8);
+    bytes[l4Off+1] = meta.l4SrcPort.range( 7,  0);
+    bytes[l4Off+2] = meta.l4DstPort.range(15,  8);
+    bytes[l4Off+3] = meta.l4DstPort.range( 7,  0);
+}
+
+/*******************************************************************************
+ * @brief Write the bytes of a frame into a stream of 'W'-bit chunks.
+ *
+ * @return the number of chunks written.
+ *******************************************************************************/
+template<int W>
+int writeFrame(stream<AxisRawT<W> > &ss, const vector<ap_uint<8> > &bytes) {
+    int nrChunks = 0;
+    for (size_t off=0; off<bytes.size(); off+=W/8) {
+        ap_uint<W>   data = 0;
+        ap_uint<W/8> keep = 0;
+        for (int i=0; (i<W/8) and ((off+i)<bytes.size()); i++) {
+            data.range(8*i+7, 8*i) = bytes[off+i];
+            keep[i] = 1;
+        }
+        ss.write(AxisRawT<W>(data, keep, ((off+W/8) >= bytes.size()) ? 1 : 0));
+        nrChunks++;
+    }
+    return nrChunks;
+}
+
+/*******************************************************************************
+ * @brief Build an Ethernet/IPv4/Layer-4 frame with a valid IPv4 header.
+ *
+ * @param[in]  frmLen    The length of the frame in bytes.
+ * @param[in]  ihl       The IPv4 header length in 32-bit words.
+ * @param[in]  isForUs   Set the IPv4 destination address to TB_MMIO_IP4_ADDR.
+ * @param[out] bytes     The bytes of the frame.
+ * @param[out] meta      The header fields expected from the DUT.
+ *******************************************************************************/
+void buildIp4Frame(int frmLen, int ihl, bool isForUs, vector<ap_uint<8> > &bytes, AxisHdrMeta &meta) {
+    buildFrame(frmLen, ihl, bytes, meta);
+    //-- Don't fragment
+    bytes[AHP_IP4_HDR_OFF+6] = 0x40;
+    bytes[AHP_IP4_HDR_OFF+7] = 0x00;
+    if (isForUs) {
+        meta.ipDa = TB_MMIO_IP4_ADDR;
+        for (int i=0; i<4; i++) {
+            bytes[AHP_IP4_DA_OFF+i] = meta.ipDa.range(31-8*i, 24-8*i);
+        }
+    }
+    //-- Compute the header checksum
+    bytes[AHP_IP4_HDR_OFF+10] = 0;
+    bytes[AHP_IP4_HDR_OFF+11] = 0;
+    unsigned int sum = 0;
+    for (int i=AHP_IP4_HDR_OFF; i<AHP_IP4_HDR_OFF+4*ihl; i+=2) {
+        sum += (bytes[i].to_uint() << 8) + bytes[i+1].to_uint();
+        sum  = (sum & 0xFFFF) + (sum >> 16);
+    }
+    bytes[AHP_IP4_HDR_OFF+10] = (~sum >> 8) & 0xFF;
+    bytes[AHP_IP4_HDR_OFF+11] = (~sum >> 0) & 0xFF;
+}
+
+/*******************************************************************************
+ * @brief Run one cycle of the header parser (AHP) of width 'W'. The widest
+ *   one is run through the synthesis top-level.
+ *******************************************************************************/
+template<int W>
+void runAhp(stream<AxisRawT<W> > &siData, stream<AxisHdrMeta> &soMeta) {
+    pAxisHeaderParser<W>(siData, soMeta);
+}
+template<>
+void runAhp<AXIS_RAW_WIDTH_AT_100GE>(stream<AxisRawT<AXIS_RAW_WIDTH_AT_100GE> > &siData,
+                                     stream<AxisHdrMeta> &soMeta) {
+    static stream<AxisRawT<AXIS_RAW_WIDTH_AT_100GE> > ssIcaData("ssIcaData");
+    static stream<AxisRawT<AXIS_RAW_WIDTH_AT_100GE> > ssIcaIp4("ssIcaIp4");
+    static stream<Ip4Version>   ssIcaIpVer("ssIcaIpVer");
+    static stream<CmdBit>       ssIcaDropCmd("ssIcaDropCmd");
+    static stream<IpHdrSum>     ssIcaHdrSum("ssIcaHdrSum");
+    axis_width(siData, soMeta, TB_MMIO_IP4_ADDR,
+               ssIcaData, ssIcaIp4, ssIcaIpVer, ssIcaDropCmd, ssIcaHdrSum);
+}
+
+/*******************************************************************************
+ * @brief Run one cycle of the IP Checksum Accumulator (ICa) of the IPRX with a
+ *   width 'W'. The widest one is run through the synthesis top-level.
+ *******************************************************************************/
+template<int W>
+void runIca(stream<AxisRawT<W> > &siData, stream<AxisRawT<W> > &soData,
+            stream<Ip4Version> &soIpVer, stream<CmdBit> &soDropCmd, stream<IpHdrSum> &soHdrSum) {
+    pIpChecksumAccumulator<W>(TB_MMIO_IP4_ADDR, siData, soData, soIpVer, soDropCmd, soHdrSum);
+}
+template<>
+void runIca<AXIS_RAW_WIDTH_AT_100GE>(stream<AxisRawT<AXIS_RAW_WIDTH_AT_100GE> > &siData,
+                                     stream<AxisRawT<AXIS_RAW_WIDTH_AT_100GE> > &soData,
+                                     stream<Ip4Version> &soIpVer, stream<CmdBit> &soDropCmd,
+                                     stream<IpHdrSum> &soHdrSum) {
+    static stream<AxisRawT<AXIS_RAW_WIDTH_AT_100GE> > ssAhpData("ssAhpData");
+    static stream<AxisHdrMeta>  ssAhpMeta("ssAhpMeta");
+    axis_width(ssAhpData, ssAhpMeta, TB_MMIO_IP4_ADDR,
+               siData, soData, soIpVer, soDropCmd, soHdrSum);
+}
+
+/*******************************************************************************
+ * @brief Assess the byte-wise accessors of an 'AxisRawT<W>' at every alignment.
+ *
+ * @return the number of errors.
+ *******************************************************************************/
+template<int W>
+int testAccessors() {
+    int nrErr = 0;
+    for (int byteOff=0; byteOff<=(W/8-4); byteOff++) {
+        AxisRawT<W> chunk(0, 0, 0);
+        ap_uint<32> field = 0xA1B2C3D4 ^ byteOff;
+        chunk.template setBeField<4>(field, byteOff);
+        //-- The MSB of the field must come first on the wire (.i.e in the lowest lane)
+        if ((chunk.getLE_TData(8*byteOff+7, 8*byteOff) != ap_uint<W>(field.range(31, 24))) or
+            (chunk.template getBeField<4>(byteOff) != field)) {
+            printError(THIS_NAME, "W=%3d - Accessors failed at byte offset %d.\n", W, byteOff);
+            nrErr++;
+        }
+    }
+    for (int len=1; len<=W/8; len++) {
+        ap_uint<W/8> keep = 0;
+        for (int i=0; i<len; i++) {
+            keep[i] = 1;
+        }
+        AxisRawT<W> chunk(~ap_uint<W>(0), keep, 0);
+        chunk.setTLast(TLAST);
+        if ((chunk.getLen() != len) or !chunk.isValid() or
+            ((len < W/8) and (chunk.getLE_TData(W-1, 8*len) != 0))) {
+            printError(THIS_NAME, "W=%3d - Length of a chunk of %d bytes is %d.\n", W, len, chunk.getLen());
+            nrErr++;
+        }
+    }
+    return nrErr;
+}
+
+/*******************************************************************************
+ * @brief Assess the checksum library on chunks of 'W' bits against a serial
+ *  reference implementation, and assess its incremental update (RFC-1624).
+ *
+ * @return the number of errors.
+ *******************************************************************************/
+template<int W>
+int testChecksum() {
+    int nrErr = 0;
+    vector<ap_uint<8> > bytes;
+    AxisHdrMeta         meta;
+    for (int frmLen=AHP_IP4_HDR_OFF+24; frmLen<=(AHP_IP4_HDR_OFF+24+W/8); frmLen++) {
+        buildFrame(frmLen, 5, bytes, meta);
+        //-- Serial reference
+        unsigned int refSum = 0;
+        for (int i=0; i<frmLen; i++) {
+            refSum += (i % 2) ? bytes[i].to_uint() : (bytes[i].to_uint() << 8);
+            refSum  = (refSum & 0xFFFF) + (refSum >> 16);
+        }
+        Csum refCsum = ~refSum & 0xFFFF;
+        //-- Chunk-based
+        stream<AxisRawT<W> > ssData;
+        writeFrame<W>(ssData, bytes);
+        CsumAcc csumAcc = 0;
+        while (!ssData.empty()) {
+            csumAcc = csumAccumulate<W>(csumAcc, ssData.read());
+        }
+        if (csumFinalize(csumAcc) != refCsum) {
+            printError(THIS_NAME, "W=%3d - Checksum of %d bytes is 0x%4.4X instead of 0x%4.4X.\n",
+                       W, frmLen, csumFinalize(csumAcc).to_uint(), refCsum.to_uint());
+            nrErr++;
+        }
+        //-- Rewrite the IPv4 destination address and update the checksum incrementally
+        Ip4Addr newIpDa = meta.ipDa ^ 0x5A5A0F0F;
+        for (int i=0; i<4; i++) {
+            bytes[AHP_IP4_DA_OFF+i] = newIpDa.range(31-8*i, 24-8*i);
+        }
+        writeFrame<W>(ssData, bytes);
+        csumAcc = 0;
+        while (!ssData.empty()) {
+            csumAcc = csumAccumulate<W>(csumAcc, ssData.read());
+        }
+        Csum updCsum = csumUpdate32(refCsum, meta.ipDa, newIpDa);
+        if (updCsum != csumFinalize(csumAcc)) {
+            printError(THIS_NAME, "W=%3d - Incremental checksum update failed for %d bytes.\n",
+                       W, frmLen);
+            nrErr++;
+        }
+    }
+    return nrErr;
+}
+
+/*******************************************************************************
+ * @brief Stream 'TB_NR_FRAMES' frames of 'frmLen' bytes through the header
+ *   parser (AHP) of width 'W' and check the extracted header fields.
+ *
+ * @return the number of errors.
+ *******************************************************************************/
+template<int W>
+int testHeaderParser(int frmLen) {
+    stream<AxisRawT<W> >  ssData("ssData");
+    stream<AxisHdrMeta>   ssMeta("ssMeta");
+    vector<AxisHdrMeta>   expMeta(TB_NR_FRAMES);
+    vector<ap_uint<8> >   bytes;
+    int nrErr    = 0;
+    int nrChunks = 0;
+
+    //-- Vary the IPv4 header length to move the layer-4 ports across the chunk
+    int maxIhl = (frmLen - AHP_IP4_HDR_OFF - 4) / 4;
+    if (maxIhl > 15) {
+        maxIhl = 15;
+    }
+    for (int f=0; f<TB_NR_FRAMES; f++) {
+        buildFrame(frmLen, 5 + (f % (maxIhl-4)), bytes, expMeta[f]);
+        nrChunks += writeFrame<W>(ssData, bytes);
+    }
+
+    int nrCycles = 0;
+    int nrMeta   = 0;
+    while ((nrMeta < TB_NR_FRAMES) and (nrCycles < (nrChunks + TB_GRACE_TIME))) {
+        runAhp<W>(ssData, ssMeta);
+        nrCycles++;
+        stepSim();
+        if (!ssMeta.empty()) {
+            AxisHdrMeta meta = ssMeta.read();
+            AxisHdrMeta &exp = expMeta[nrMeta];
+            if ((meta.etherType != exp.etherType) or (meta.ipHdrLen  != exp.ipHdrLen)  or
+                (meta.ipTotLen  != exp.ipTotLen)  or (meta.ipProt    != exp.ipProt)    or
+                (meta.ipSa      != exp.ipSa)      or (meta.ipDa      != exp.ipDa)      or
+                (meta.l4SrcPort != exp.l4SrcPort) or (meta.l4DstPort != exp.l4DstPort)) {
+                printError(THIS_NAME, "W=%3d - [AHP] Frame #%d - Header fields do not match (IHL=%d).\n",
+                           W, nrMeta, exp.ipHdrLen.to_int());
+                nrErr++;
+            }
+            nrMeta++;
+        }
+    }
+    if (nrMeta != TB_NR_FRAMES) {
+        printError(THIS_NAME, "W=%3d - [AHP] Received %d metadata instead of %d.\n", W, nrMeta, TB_NR_FRAMES);
+        nrErr++;
+    }
+    return nrErr;
+}
+
+/*******************************************************************************
+ * @brief Assess that the header parser (AHP) does not report the fields of a
+ *   previous frame for a frame which is too short to hold them.
+ *
+ * @return the number of errors.
+ *******************************************************************************/
+template<int W>
+int testShortFrame() {
+    stream<AxisRawT<W> >  ssData("ssData");
+    stream<AxisHdrMeta>   ssMeta("ssMeta");
+    vector<ap_uint<8> >   bytes;
+    AxisHdrMeta           expMeta;
+    int nrErr = 0;
+
+    //-- A full frame followed by a frame which ends within the IPv4 header
+    buildFrame(128, 5, bytes, expMeta);
+    writeFrame<W>(ssData, bytes);
+    bytes.resize(AHP_IP4_HDR_OFF+8);
+    writeFrame<W>(ssData, bytes);
+    for (int i=0; i<(128/(W/8)+TB_GRACE_TIME); i++) {
+        runAhp<W>(ssData, ssMeta);
+        stepSim();
+    }
+    if (ssMeta.size() != 2) {
+        printError(THIS_NAME, "W=%3d - [AHP] Received %d metadata instead of 2.\n", W, (int)ssMeta.size());
+        return 1;
+    }
+    ssMeta.read();
+    AxisHdrMeta meta = ssMeta.read();
+    if ((meta.ipSa != 0) or (meta.ipDa != 0) or (meta.l4SrcPort != 0) or (meta.l4DstPort != 0)) {
+        printError(THIS_NAME, "W=%3d - [AHP] A short frame reports the fields of the previous frame.\n", W);
+        nrErr++;
+    }
+    return nrErr;
+}
+
+/*******************************************************************************
+ * @brief Stream 'TB_NR_FRAMES' frames of 'frmLen' bytes through the IP
+ *   Checksum Accumulator (ICa) of the IPRX with a width 'W', check its outputs
+ *   and report its throughput.
+ *
+ * @return the number of errors.
+ *
+ * @details
+ *  Every call of the DUT models one clock cycle of a process pipelined at
+ *   II=1. The input stream is filled beforehand and the outputs are drained
+ *   upon every cycle, such that the count of cycles is only set by the DUT.
+ *   It includes the cycles which the FSM of [ICa] spends without reading any
+ *   input (.i.e, the flush of the tail of a frame after it was re-aligned on
+ *   the IPv4 header). The throughput is the number of bytes of the frames
+ *   over the number of cycles it took to output the last byte at the clock
+ *   frequency of the NTS.
+ *******************************************************************************/
+template<int W>
+int benchIpRx(int frmLen) {
+    stream<AxisRawT<W> >  ssData("ssData");
+    stream<AxisRawT<W> >  ssIp4("ssIp4");
+    stream<Ip4Version>    ssIpVer("ssIpVer");
+    stream<CmdBit>        ssDropCmd("ssDropCmd");
+    stream<IpHdrSum>      ssHdrSum("ssHdrSum");
+    vector<vector<ap_uint<8> > > expBytes(TB_NR_FRAMES);
+    vector<ap_uint<8> >   rcvBytes;
+    AxisHdrMeta           meta;
+    int nrErr    = 0;
+    int nrChunks = 0;
+    int nrBytes  = 0;
+
+    int maxIhl = (frmLen - AHP_IP4_HDR_OFF - 4) / 4;
+    if (maxIhl > 15) {
+        maxIhl = 15;
+    }
+    for (int f=0; f<TB_NR_FRAMES; f++) {
+        buildIp4Frame(frmLen, 5 + (f % (maxIhl-4)), (f % 2) == 0, expBytes[f], meta);
+        nrChunks += writeFrame<W>(ssData, expBytes[f]);
+        nrBytes  += frmLen;
+    }
+
+    int nrCycles = 0;
+    int nrPkts   = 0;
+    int nrVers   = 0;
+    int nrDrops  = 0;
+    int nrSums   = 0;
+    while ((nrPkts < TB_NR_FRAMES) and (nrCycles < (2*nrChunks + TB_GRACE_TIME))) {
+        runIca<W>(ssData, ssIp4, ssIpVer, ssDropCmd, ssHdrSum);
+        nrCycles++;
+        stepSim();
+        if (!ssIpVer.empty()) {
+            if (ssIpVer.read() != 4) {
+                printError(THIS_NAME, "W=%3d - [ICa] Frame #%d - Bad IP version.\n", W, nrVers);
+                nrErr++;
+            }
+            nrVers++;
+        }
+        if (!ssDropCmd.empty()) {
+            if (ssDropCmd.read() != CMD_KEEP) {
+                printError(THIS_NAME, "W=%3d - [ICa] Frame #%d - Unexpected drop command.\n", W, nrDrops);
+                nrErr++;
+            }
+            nrDrops++;
+        }
+        if (!ssHdrSum.empty()) {
+            IpHdrSum hdrSum = ssHdrSum.read();
+            if ((csumFinalize(hdrSum.sum) != 0) or (hdrSum.ipMatch != ((nrSums % 2) == 0))) {
+                printError(THIS_NAME, "W=%3d - [ICa] Frame #%d - Bad header sum (0x%4.4X) or address match (%d).\n",
+                           W, nrSums, csumFinalize(hdrSum.sum).to_uint(), hdrSum.ipMatch);
+                nrErr++;
+            }
+            nrSums++;
+        }
+        if (!ssIp4.empty()) {
+            AxisRawT<W> chunk = ssIp4.read();
+            for (int i=0; i<W/8; i++) {
+                if (chunk.getLE_TKeep()[i]) {
+                    rcvBytes.push_back(chunk.getLE_TData(8*i+7, 8*i));
+                }
+            }
+            if (chunk.getTLast()) {
+                vector<ap_uint<8> > &exp = expBytes[nrPkts];
+                if (rcvBytes != vector<ap_uint<8> >(exp.begin()+AHP_IP4_HDR_OFF, exp.end())) {
+                    printError(THIS_NAME, "W=%3d - [ICa] Frame #%d - The IPv4 packet (%d bytes) does not match.\n",
+                               W, nrPkts, (int)rcvBytes.size());
+                    nrErr++;
+                }
+                rcvBytes.clear();
+                nrPkts++;
+            }
+        }
+    }
+    if ((nrPkts != TB_NR_FRAMES) or (nrVers != TB_NR_FRAMES) or
+        (nrDrops != TB_NR_FRAMES) or (nrSums != TB_NR_FRAMES)) {
+        printError(THIS_NAME, "W=%3d - [ICa] Received %d/%d/%d/%d packets/versions/commands/sums instead of %d.\n",
+                   W, nrPkts, nrVers, nrDrops, nrSums, TB_NR_FRAMES);
+        nrErr++;
+    }
+    double gbps = (8.0 * nrBytes * TB_CLOCK_MHZ) / (1000.0 * nrCycles);
+    printInfo(THIS_NAME, "W=%3d | FrmLen=%4d | Chunks=%6d | Cycles=%6d | Throughput=%7.2f Gb/s\n",
+              W, frmLen, nrChunks, nrCycles, gbps);
+    return nrErr;
+}
+
+/*******************************************************************************
+ * @brief Run the benchmark of every frame size for a given width.
+ *******************************************************************************/
+template<int W>
+int benchAllSizes() {
+    const int frmLens[] = { 64, 65, 128, 512, 1024, 1518 };
+    int nrErr = testAccessors<W>() + testChecksum<W>() + testShortFrame<W>();
+    for (unsigned i=0; i<sizeof(frmLens)/sizeof(frmLens[0]); i++) {
+        nrErr += testHeaderParser<W>(frmLens[i]);
+        nrErr += benchIpRx<W>(frmLens[i]);
+    }
+    return nrErr;
+}
+
+/*****************************************************************************
+ * @brief Main function (does not use any parameter).
+ ******************************************************************************/
+int main(int argc, char* argv[])
+{
+    //------------------------------------------------------
+    //-- TESTBENCH GLOBAL VARIABLES
+    //------------------------------------------------------
+    gTraceEvent   = false;
+    gFatalError   = false;
+    gSimCycCnt    = 0;
+
+    //------------------------------------------------------
+    //-- TESTBENCH LOCAL VARIABLES
+    //------------------------------------------------------
+    int nrErr = 0;  // Tb error counter.
+
+    srand(0xC10D);
+
+    printInfo(THIS_NAME, "############################################################################\n");
+    printInfo(THIS_NAME, "## TESTBENCH 'test_axis_width' STARTS HERE                                ##\n");
+    printInfo(THIS_NAME, "##   (Throughput of the IPRX/ICa is given at %6.2f MHz)                 ##\n", TB_CLOCK_MHZ);
+    printInfo(THIS_NAME, "############################################################################\n");
+
+    nrErr += benchAllSizes<AXIS_RAW_WIDTH_AT_10GE>();
+    nrErr += benchAllSizes<AXIS_RAW_WIDTH_AT_25GE>();
+    nrErr += benchAllSizes<AXIS_RAW_WIDTH_AT_40GE>();
+    nrErr += benchAllSizes<AXIS_RAW_WIDTH_AT_100GE>();
+
+    //---------------------------------------------------------------
+    //-- PRINT TESTBENCH STATUS
+    //---------------------------------------------------------------
+    printf("\n\n");
+    printInfo(THIS_NAME, "This testbench was executed with the following parameters: \n");
+    printInfo(THIS_NAME, "\t==> Number of frames per size and width = %d \n", TB_NR_FRAMES);
+    printf("\n");
+
+    if (nrErr) {
+        printError(THIS_NAME, "###########################################################\n");
+        printError(THIS_NAME, "#### TEST BENCH FAILED : TOTAL NUMBER OF ERROR(S) = %2d ####\n", nrErr);
+        printError(THIS_NAME, "###########################################################\n");
+    }
+    else {
+        printInfo(THIS_NAME, "#############################################################\n");
+        printInfo(THIS_NAME, "####               SUCCESSFUL END OF TEST                ####\n");
+        printInfo(THIS_NAME, "#############################################################\n");
+    }
+
+    return nrErr;
+}
+
+/*! \} */
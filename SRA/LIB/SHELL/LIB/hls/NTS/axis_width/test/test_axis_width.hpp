@@ -0,0 +1,54 @@
+/*
+ * Copyright 2016 -- 2021 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*******************************************************************************
+ * @file       : test_axis_width.hpp
+ * @brief      : Testbench for the width-generic AXI4-Stream parsers.
+ *
+ * System:     : cloudFPGA
+ * Component   : Shell, Network Transport Stack (NTS)
+ * Language    : Vivado HLS
+ *
+ * \ingroup NTS_AXIS
+ * \addtogroup NTS_AXIS_TEST
+ * \{
+ *******************************************************************************/
+
+#ifndef _TEST_AXIS_WIDTH_H_
+#define _TEST_AXIS_WIDTH_H_
+
+#include <vector>
+
+#include "../src/axis_width.hpp"
+
+//---------------------------------------------------------
+//-- TESTBENCH GLOBAL DEFINES
+//---------------------------------------------------------
+#define TB_NR_FRAMES       250   // Number of frames per frame size and width
+#define TB_CLOCK_MHZ    156.25   // Frequency of the NTS clock
+#define TB_GRACE_TIME       25   // Adds some cycles to drain the DUT before exiting
+#define TB_MMIO_IP4_ADDR  0x0A0CC801  // The IPv4 address of the FPGA (10.12.200.1)
+
+//---------------------------------------------------------
+//-- TESTBENCH GLOBAL VARIABLES
+//---------------------------------------------------------
+bool            gTraceEvent   = false;
+bool            gFatalError   = false;
+unsigned int    gSimCycCnt    = 0;
+
+#endif
+
+/*! \} */
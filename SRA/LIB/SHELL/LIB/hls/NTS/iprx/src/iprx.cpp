@@ -225,7 +225,7 @@ void pMacProtocolDetector(
  *******************************************************************************/
 void pIpLengthChecker(
         stream<AxisEth>     &siMPd_Data,
-        stream<AxisEth>     &soICa_Data)
+        stream<AxisRaw>     &soICa_Data)
 {
     //-- DIRECTIVES FOR THIS PROCESS -------------------------------------------
     #pragma HLS INLINE off
@@ -306,186 +306,7 @@ void pIpLengthChecker(
     }
 }
 
-/*******************************************************************************
- * IP Checksum Checker (ICa)
- *
- * @param[in]  piMMIO_Ip4Address The IPv4 address from MMIO (in network order).
- * @param[in]  siILc_Data        Data stream from IpLengthChecker (ILc).
- * @param[out] soIId_Data        Data stream to IpInvalidDropper (IId).
- * @param[out] soIId_IpVer       The IP version to [IId].
- * @param[out] soIId_DropCmd     Tell [IId] to drop this IP packet.
- * @param[out] soICc_SubSums     Four sub-checksums to IpChecksumChecker (ICc).
- *
- * @details
- *  This process computes four sub-sums in parallel to later assess the checksum
- *  of the IPv4 header.
- *******************************************************************************/
-void pIpChecksumAccumulator(
-        Ip4Addr               piMMIO_Ip4Address,
-        stream<AxisEth>      &siILc_Data,
-        stream<AxisIp4>      &soIId_Data,
-        stream<Ip4Version>   &soIId_IpVer,
-        stream<CmdBit>       &soIId_DropCmd,
-        stream<SubSums>      &soICc_SubSums)
-{
-    //-- DIRECTIVES FOR THIS PROCESS -------------------------------------------
-    #pragma HLS INLINE off
-    #pragma HLS PIPELINE II=1 enable_flush
-
-    const char *myName  = concat3(THIS_NAME, "/", "ICa");
-
-    //-- STATIC CONTROL VARIABLES (with RESET) ---------------------------------
-    static bool                ica_wasLastChunk=false;
-    #pragma HLS RESET variable=ica_wasLastChunk
-    static ap_uint<3>          ica_chunkCount=0;
-    #pragma HLS RESET variable=ica_chunkCount
-
-    //-- STATIC DATAFLOW VARIABLES --------------------------------------------
-    static ap_uint<17> ica_ipHdrSums[4];
-    static ap_uint<8>  ica_ipHdrLen;
-    static LE_Ip4Addr  ica_dstIpAddress;
-    static AxisEth     ica_prevChunk;
-
-    //-- DYNAMIC VARIABLES -----------------------------------------------------
-    AxisEth     currChunk;
-    AxisIp4     sendChunk;
-    ap_uint<16> ip4FlagsAndFragOff;
-    bool        ipAddrMatch;
-
-    currChunk.setLE_TLast(0);
-    if (!siILc_Data.empty() && !ica_wasLastChunk && !soIId_IpVer.full() &&
-        !soIId_DropCmd.full() && !soICc_SubSums.full() && !soIId_Data.full()) {
-        siILc_Data.read(currChunk);
-
-        switch (ica_chunkCount) {
-        case 0:
-            // Skip because chunk contains MAC_SA[1:0] | MAC_DA[5:0]
-            for (int i=0; i<4 ;++i) {
-                ica_ipHdrSums[i] = 0;
-            }
-            ica_chunkCount++;
-            break;
-        case 1:
-            // Retrieve the IP version field
-            soIId_IpVer.write(currChunk.getIp4Version());
-            // Retrieve the Internet Header Length
-            ica_ipHdrLen = currChunk.getIp4HdrLen();
-            // Retrieve the first two bytes of the IPv4 header
-            ica_ipHdrSums[3].range(15,12) = currChunk.getIp4Version();
-            ica_ipHdrSums[3].range(11, 8) = currChunk.getIp4HdrLen();
-            ica_ipHdrSums[3].range( 7, 0) = currChunk.getIp4ToS();
-            ica_chunkCount++;
-            break;
-        case 2:
-            // Check for fragmentation in this cycle. Need to check the MF flag.
-            // If set, then drop. If not set, then check the fragment offset and
-            // if it is non-zero then drop.
-            ip4FlagsAndFragOff = byteSwap16(currChunk.getLE_TData().range(47, 32));
-            if (ip4FlagsAndFragOff.range(12, 0) != 0 || ip4FlagsAndFragOff.bit(13) != 0) {
-                soIId_DropCmd.write(CMD_DROP);
-                if (ip4FlagsAndFragOff.bit(13) != 0) {
-                    printWarn(myName, "The More Fragments (MF) is set but IP fragmentation is not supported (yet).\n");
-                }
-                if (ip4FlagsAndFragOff.range(12, 0) != 0) {
-                    printWarn(myName, "Fragment offset is set but not supported (yet) !!!\n");
-                }
-            }
-            else {
-                soIId_DropCmd.write(CMD_KEEP);
-            }
-            for (int i = 0; i < 4; i++) {
-              #pragma HLS unroll
-                ica_ipHdrSums[i] += byteSwap16(currChunk.getLE_TData().range(i*16+15, i*16));
-                ica_ipHdrSums[i] = (ica_ipHdrSums[i] + (ica_ipHdrSums[i] >> 16)) & 0xFFFF;
-            }
-            ica_ipHdrLen -= 2;
-            ica_chunkCount++;
-            break;
-        case 3:
-            ica_dstIpAddress.range(31, 16) = currChunk.getIp4DstAddrHi();
-            for (int i = 0; i < 4; i++) {
-              #pragma HLS unroll
-                ica_ipHdrSums[i] += byteSwap16(currChunk.getLE_TData().range(i*16+15, i*16));
-                ica_ipHdrSums[i] = (ica_ipHdrSums[i] + (ica_ipHdrSums[i] >> 16)) & 0xFFFF;
-            }
-            ica_ipHdrLen -= 2;
-            ica_chunkCount++;
-            break;
-
-        default:
-            if (ica_chunkCount == 4) {
-                ica_dstIpAddress(15, 0) = currChunk.getIp4DstAddrLo();
-            }
-            switch (ica_ipHdrLen) {
-            case 0:
-                break;
-            case 1:
-                // Sum up part0
-                ica_ipHdrSums[0] += currChunk.getIp4DstAddrLo();
-                ica_ipHdrSums[0] = (ica_ipHdrSums[0] + (ica_ipHdrSums[0] >> 16)) & 0xFFFF;
-                ica_ipHdrLen = 0;
-                // Assess destination IP address (FYI - IP Broadcast addresses are dropped)
-                if (ica_dstIpAddress == piMMIO_Ip4Address) {
-                    ipAddrMatch = true;
-                }
-                else {
-                    ipAddrMatch = false;
-                }
-                soICc_SubSums.write(SubSums(ica_ipHdrSums, ipAddrMatch));
-                break;
-            case 2:
-                // Sum up parts 0-2
-                for (int i = 0; i < 4; i++) {
-                  #pragma HLS unroll
-                    ica_ipHdrSums[i] += byteSwap16(currChunk.getLE_TData().range(i*16+15, i*16));
-                    ica_ipHdrSums[i] = (ica_ipHdrSums[i] + (ica_ipHdrSums[i] >> 16)) & 0xFFFF;
-                }
-                ica_ipHdrLen = 0;
-                // Assess destination IP address (FYI - IP Broadcast addresses are dropped)
-                if (ica_dstIpAddress == piMMIO_Ip4Address) {
-                    // || ica_dstIpAddress == 0xFFFFFFFF) {
-                ipAddrMatch = true;
-                }
-                else {
-                    ipAddrMatch = false;
-                }
-                soICc_SubSums.write(SubSums(ica_ipHdrSums, ipAddrMatch));
-                break;
-            default:
-                // Sum up everything
-                for (int i = 0; i < 4; i++) {
-                  #pragma HLS unroll
-                    ica_ipHdrSums[i] += byteSwap16(currChunk.getLE_TData().range(i*16+15, i*16));
-                    ica_ipHdrSums[i] = (ica_ipHdrSums[i] + (ica_ipHdrSums[i] >> 16)) & 0xFFFF;
-                }
-                ica_ipHdrLen -= 2;
-                break;
-            }
-            break;
-        } // End of: switch(ica_chunkCount)f
-
-        if (ica_chunkCount > 2) {
-            // Send AxisIp4 chunks while re-aligning the outgoing chunks
-            sendChunk = AxisIp4((currChunk.getLE_TData().range(47, 0), ica_prevChunk.getLE_TData().range(63, 48)),
-                                (currChunk.getLE_TKeep().range( 5, 0), ica_prevChunk.getLE_TKeep().range( 7,  6)),
-                                (currChunk.getLE_TKeep()[6] == 0));
-            soIId_Data.write(sendChunk);
-        }
-        ica_prevChunk = currChunk;
-        if (currChunk.getLE_TLast()) {
-            ica_chunkCount = 0;
-            ica_wasLastChunk = !sendChunk.getLE_TLast();
-        }
-    }
-    else if(ica_wasLastChunk && !soIId_Data.full()) {
-        // Send remaining Chunk;
-        sendChunk = AxisIp4(ica_prevChunk.getLE_TData().range(63, 48),
-                            ica_prevChunk.getLE_TKeep().range( 7,  6),
-                            TLAST);
-        soIId_Data.write(sendChunk);
-        ica_wasLastChunk = false;
-    }
-}
+//-- The IP Checksum Accumulator (ICa) is templated on the chunk width (see 'iprx.hpp')
 
 /*******************************************************************************
  * IP Invalid Dropper (IId)
@@ -502,7 +323,7 @@ void pIpChecksumAccumulator(
  *   valid (siICc_CsumValid). Otherwise, the IPv4 packet is passed on.
  *******************************************************************************/
 void pIpInvalidDropper(
-        stream<AxisIp4>      &siICa_Data,
+        stream<AxisRaw>      &siICa_Data,
         stream<Ip4Version>   &siICa_IpVer,
         stream<ValBit>       &siICa_DropFrag,
         stream<ValBit>       &siICc_CsumValid,
@@ -525,7 +346,7 @@ void pIpInvalidDropper(
     case FSM_IDLE:
         if (!siICc_CsumValid.empty() && !siICa_IpVer.empty() && !siICa_DropFrag.empty() &&
             !siICa_Data.empty() && !soICl_Data.full()) {
-            siICa_Data.read(currChunk);
+            currChunk = siICa_Data.read();
             // Assess validity of the current IPv4 packet
             ValBit csumValid = (siICc_CsumValid.read() == 1);        // CSUM is valid
             ValBit isIpv4Pkt = (siICa_IpVer.read()     == 4);        // IP Version is 4
@@ -545,7 +366,7 @@ void pIpInvalidDropper(
         break;
     case FSM_FWD:
         if(!siICa_Data.empty() && !soICl_Data.full()) {
-            siICa_Data.read(currChunk);
+            currChunk = siICa_Data.read();
             soICl_Data.write(currChunk);
             if (currChunk.getLE_TLast()) {
                 iid_fsmState = FSM_IDLE;
@@ -554,7 +375,7 @@ void pIpInvalidDropper(
         break;
     case FSM_DROP:
         if(!siICa_Data.empty()){
-            siICa_Data.read(currChunk);
+            currChunk = siICa_Data.read();
             if (currChunk.getLE_TLast()) {
                 iid_fsmState = FSM_IDLE;
             }
@@ -633,15 +454,16 @@ void pIpCutLength(
 /*******************************************************************************
  * IPv4 Checksum Checker (ICc)
  *
- * @param[in]  siICa_SubSums    Four sub-checksums from IpChecksumAccumulator (ICa).
+ * @param[in]  siICa_HdrSum     The sum of the IPv4 header from IpChecksumAccumulator (ICa).
  * @param[out] soIId_CsumValid  Checksum valid information.
  *
  * @details
- *  This process computes the final IP header checksum by adding the 4 subsums.
+ *  This process folds the sum of the IPv4 header. Because the header includes
+ *  its own checksum, the header is valid when the complement of that sum is 0.
  *
  *******************************************************************************/
 void pIpChecksumChecker(
-        stream<SubSums>   &siICa_SubSums,
+        stream<IpHdrSum>  &siICa_HdrSum,
         stream<ValBit>    &soIId_CsumValid)
 {
     //-- DIRECTIVES FOR THIS PROCESS -------------------------------------------
@@ -650,20 +472,13 @@ void pIpChecksumChecker(
 
     const char *myName  = concat3(THIS_NAME, "/", "ICc");
 
-    if (!siICa_SubSums.empty() && !soIId_CsumValid.full()) {
-        SubSums ipHdrSums = siICa_SubSums.read();
-
-        ipHdrSums.sum0 += ipHdrSums.sum2;
-        ipHdrSums.sum1 += ipHdrSums.sum3;
-        ipHdrSums.sum0 = (ipHdrSums.sum0 + (ipHdrSums.sum0 >> 16)) & 0xFFFF;
-        ipHdrSums.sum1 = (ipHdrSums.sum1 + (ipHdrSums.sum1 >> 16)) & 0xFFFF;
-        ipHdrSums.sum0 += ipHdrSums.sum1;
-        ipHdrSums.sum0 = (ipHdrSums.sum0 + (ipHdrSums.sum0 >> 16)) & 0xFFFF;
-        ipHdrSums.sum0 = ~ipHdrSums.sum0;
-        if (ipHdrSums.sum0(15, 0) != 0x0000) {
-            printError(myName, "Bad IP header checksum: Expected 0x0000 - Computed 0x%4.4X\n", ipHdrSums.sum0(15, 0).to_int());
+    if (!siICa_HdrSum.empty() && !soIId_CsumValid.full()) {
+        IpHdrSum ipHdrSum = siICa_HdrSum.read();
+        Csum     ipHdrCsum = csumFinalize(ipHdrSum.sum);
+        if (ipHdrCsum != 0x0000) {
+            printError(myName, "Bad IP header checksum: Expected 0x0000 - Computed 0x%4.4X\n", ipHdrCsum.to_int());
         }
-        soIId_CsumValid.write((ipHdrSums.sum0(15, 0) == 0x0000) && ipHdrSums.ipMatch);
+        soIId_CsumValid.write((ipHdrCsum == 0x0000) && ipHdrSum.ipMatch);
     }
 }
 
@@ -869,19 +684,19 @@ void iprx(
     #pragma HLS STREAM     variable=ssMPdToILc_Data     depth=32
 
     //-- IPv4 Length Checker (ILc)
-    static stream<AxisEth>          ssILcToICa_Data     ("ssILcToICa_Data");
+    static stream<AxisRaw>          ssILcToICa_Data     ("ssILcToICa_Data");
     #pragma HLS STREAM     variable=ssILcToICa_Data     depth=32
 
     //-- IPv4 Checksum Accumulator (ICa)
-    static stream<AxisIp4>          ssICaToIId_Data     ("ssICaToIId_Data");
+    static stream<AxisRaw>          ssICaToIId_Data     ("ssICaToIId_Data");
     #pragma HLS STREAM     variable=ssICaToIId_Data     depth=1024 // Must hold IP header for checksum checking
     static stream<Ip4Version>       ssICaToIId_IpVer    ("ssICaToIId_IpVer");
     #pragma HLS STREAM     variable=ssICaToIId_IpVer    depth=32
     static stream<CmdBit>           ssICaToIId_DropFrag ("ssICaToIId_DropFrag");
     #pragma HLS STREAM     variable=ssICaToIId_DropFrag depth=32
-    static stream<SubSums>          ssICaToICc_SubSums  ("ssICaToICc_SubSums");
-    #pragma HLS DATA_PACK  variable=ssICaToICc_SubSums
-    #pragma HLS STREAM     variable=ssICaToICc_SubSums  depth=32
+    static stream<IpHdrSum>         ssICaToICc_HdrSum   ("ssICaToICc_HdrSum");
+    #pragma HLS DATA_PACK  variable=ssICaToICc_HdrSum
+    #pragma HLS STREAM     variable=ssICaToICc_HdrSum   depth=32
 
     //-- IPv4 Invalid Dropper (IId)
     static stream<AxisIp4>          ssIIdToICl_Data     ("ssIIdToICl_Data");
@@ -913,16 +728,16 @@ void iprx(
             ssMPdToILc_Data,
             ssILcToICa_Data);
 
-    pIpChecksumAccumulator(
+    pIpChecksumAccumulator<ARW>(
             piMMIO_Ip4Address,
             ssILcToICa_Data,
             ssICaToIId_Data,
             ssICaToIId_IpVer,
             ssICaToIId_DropFrag,
-            ssICaToICc_SubSums);
+            ssICaToICc_HdrSum);
 
     pIpChecksumChecker(
-            ssICaToICc_SubSums,
+            ssICaToICc_HdrSum,
             ssICcToIId_CsumVal);
 
     pIpInvalidDropper(
@@ -68,22 +68,172 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 const UdpLen  MaxDatagramSize = 32768; // Maximum size of an IP datagram in bytes [FIXME - Why not 65535?]
 
 /***********************************************
- * SUB-CHECKSUMS COMPUTATION
+ * IPv4 HEADER SUM
  ***********************************************/
-class SubSums {
+class IpHdrSum {
   public:
-    ap_uint<17>         sum0;
-    ap_uint<17>         sum1;
-    ap_uint<17>         sum2;
-    ap_uint<17>         sum3;
+    CsumAcc             sum;      // The unfolded sum of the IPv4 header
     bool                ipMatch;
-    SubSums() {}
-    SubSums(ap_uint<17> sums[4], bool match) :
-        sum0(sums[0]), sum1(sums[1]), sum2(sums[2]), sum3(sums[3]), ipMatch(match) {}
-    SubSums(ap_uint<17> s0, ap_uint<17> s1, ap_uint<17> s2, ap_uint<17> s3, bool match) :
-        sum0(s0), sum1(s1), sum2(s2), sum3(s3), ipMatch(match) {}
+    IpHdrSum() {}
+    IpHdrSum(CsumAcc sum, bool match) :
+        sum(sum), ipMatch(match) {}
 };
 
+/*******************************************************************************
+ * IP Checksum Accumulator (ICa)
+ *
+ * @param[in]  piMMIO_Ip4Address The IPv4 address from MMIO (in network order).
+ * @param[in]  siILc_Data        Data stream from IpLengthChecker (ILc).
+ * @param[out] soIId_Data        Data stream to IpInvalidDropper (IId).
+ * @param[out] soIId_IpVer       The IP version to [IId].
+ * @param[out] soIId_DropCmd     Tell [IId] to drop this IP packet.
+ * @param[out] soICc_HdrSum      The sum of the IPv4 header to IpChecksumChecker (ICc).
+ *
+ * @details
+ *  This process accumulates the 16-bit words of the IPv4 header with the
+ *  checksum library of the NTS (see 'nts_csum.hpp'). The IPv4 header starts at
+ *  the even byte #14 of the Ethernet frame, which keeps its words aligned on
+ *  the 16-bit lanes of the chunks. The bytes of the chunks that do not belong
+ *  to the header are masked out with the 'tkeep' field.
+ *  The process is templated on the width 'W' of the chunks. The header fields
+ *  are extracted upon the chunk holding their last byte, from a window made of
+ *  this chunk and of the previous one (see 'fieldEndsInChunk()'), and the
+ *  outgoing chunks are re-aligned on the first byte of the IPv4 header. The
+ *  state of a frame is cleared upon its last chunk.
+ *******************************************************************************/
+template<int W>
+void pIpChecksumAccumulator(
+        Ip4Addr                piMMIO_Ip4Address,
+        stream<AxisRawT<W> >  &siILc_Data,
+        stream<AxisRawT<W> >  &soIId_Data,
+        stream<Ip4Version>    &soIId_IpVer,
+        stream<CmdBit>        &soIId_DropCmd,
+        stream<IpHdrSum>      &soICc_HdrSum)
+{
+    //-- DIRECTIVES FOR THIS PROCESS -------------------------------------------
+    #pragma HLS INLINE off
+    #pragma HLS PIPELINE II=1 enable_flush
+
+    const char *myName  = concat3("IPRX", "/", "ICa");
+
+    //-- The IPv4 header starts in chunk #IP4_CHUNK at byte #IP4_LANE
+    const int IP4_HDR_OFF = 14;
+    const int IP4_CHUNK   = IP4_HDR_OFF / (W/8);
+    const int IP4_LANE    = IP4_HDR_OFF % (W/8);
+
+    //-- STATIC CONTROL VARIABLES (with RESET) ---------------------------------
+    static bool                ica_wasLastChunk=false;
+    #pragma HLS RESET variable=ica_wasLastChunk
+    static ap_uint<4>          ica_chunkCount=0;  // Saturates past the largest IPv4 header
+    #pragma HLS RESET variable=ica_chunkCount
+
+    //-- STATIC DATAFLOW VARIABLES --------------------------------------------
+    static CsumAcc      ica_ipHdrAcc;
+    static Ip4HdrLen    ica_ipHdrLen;
+    static Ip4Addr      ica_dstIpAddress;
+    static AxisRawT<W>  ica_prevChunk;
+
+    //-- DYNAMIC VARIABLES -----------------------------------------------------
+    AxisRawT<W>   currChunk;
+    AxisRawT<2*W> window;
+    AxisRawT<W>   sendChunk;
+
+    if (!siILc_Data.empty() && !ica_wasLastChunk && !soIId_IpVer.full() &&
+        !soIId_DropCmd.full() && !soICc_HdrSum.full() && !soIId_Data.full()) {
+        siILc_Data.read(currChunk);
+        //-- The previous chunk goes into the lower bytes of the window
+        window.setLE_TData(ica_prevChunk.getLE_TData(),   W-1,   0);
+        window.setLE_TData(currChunk.getLE_TData(),     2*W-1,   W);
+        window.setLE_TKeep(ica_prevChunk.getLE_TKeep(), W/8-1,   0);
+        window.setLE_TKeep(currChunk.getLE_TKeep(),   2*W/8-1, W/8);
+        int chunkOff = ica_chunkCount * (W/8);
+        int winOff   = chunkOff - (W/8);
+
+        //-- Retrieve the IP version and the Internet Header Length
+        Ip4HdrLen ipHdrLen = ica_ipHdrLen;
+        if (fieldEndsInChunk(IP4_HDR_OFF, 1, chunkOff, W/8)) {
+            ap_uint<8> verAndIhl = window.template getBeField<1>(IP4_HDR_OFF - winOff);
+            soIId_IpVer.write(verAndIhl.range(7, 4));
+            ipHdrLen = verAndIhl.range(3, 0);
+            ica_ipHdrLen = ipHdrLen;
+        }
+
+        //-- Check for fragmentation. Need to check the MF flag. If set, then
+        //--  drop. If not set, then check the fragment offset and if it is
+        //--  non-zero then drop. The flags end before the protocol field.
+        //-- FYI - The fragments of a UDP datagram are kept when the UOE
+        //--  reassembles them (see UOE_IP_REASM).
+        if (fieldEndsInChunk(IP4_HDR_OFF+9, 1, chunkOff, W/8)) {
+            ap_uint<16> ip4FlagsAndFragOff = window.template getBeField<2>(IP4_HDR_OFF+6 - winOff);
+            Ip4Prot     ip4Prot            = window.template getBeField<1>(IP4_HDR_OFF+9 - winOff);
+            if ((ip4FlagsAndFragOff.range(12, 0) != 0 || ip4FlagsAndFragOff.bit(13) != 0) and
+                not (UOE_IP_REASM and (ip4Prot == IP4_PROT_UDP))) {
+                soIId_DropCmd.write(CMD_DROP);
+                if (ip4FlagsAndFragOff.bit(13) != 0) {
+                    printWarn(myName, "The More Fragments (MF) is set but IP fragmentation is only supported for UDP.\n");
+                }
+                if (ip4FlagsAndFragOff.range(12, 0) != 0) {
+                    printWarn(myName, "Fragment offset is set but IP fragmentation is only supported for UDP.\n");
+                }
+            }
+            else {
+                soIId_DropCmd.write(CMD_KEEP);
+            }
+        }
+
+        //-- Retrieve the destination address
+        Ip4Addr dstIpAddress = ica_dstIpAddress;
+        if (fieldEndsInChunk(IP4_HDR_OFF+16, 4, chunkOff, W/8)) {
+            dstIpAddress = window.template getBeField<4>(IP4_HDR_OFF+16 - winOff);
+            ica_dstIpAddress = dstIpAddress;
+        }
+
+        //-- Accumulate the header bytes of this chunk
+        int      hdrEnd  = IP4_HDR_OFF + 4*ipHdrLen;
+        ap_uint<W/8> hdrKeep = 0;
+        for (int i=0; i<W/8; i++) {
+        #pragma HLS UNROLL
+            if (((chunkOff+i) >= IP4_HDR_OFF) and ((chunkOff+i) < hdrEnd)) {
+                hdrKeep[i] = 1;
+            }
+        }
+        CsumAcc ipHdrAcc = (ica_chunkCount == IP4_CHUNK) ? (CsumAcc)0 : ica_ipHdrAcc;
+        ipHdrAcc = csumAccumulate<W>(ipHdrAcc, AxisRawT<W>(currChunk.getLE_TData(), hdrKeep, 0));
+        ica_ipHdrAcc = ipHdrAcc;
+        if (fieldEndsInChunk(IP4_HDR_OFF, 4*ipHdrLen, chunkOff, W/8)) {
+            // Assess destination IP address (FYI - IP Broadcast addresses are dropped)
+            soICc_HdrSum.write(IpHdrSum(ipHdrAcc, (dstIpAddress == piMMIO_Ip4Address)));
+        }
+
+        if (ica_chunkCount > IP4_CHUNK) {
+            // Send the chunks while re-aligning them on the IPv4 header
+            sendChunk = AxisRawT<W>(window.getLE_TData(8*IP4_LANE+W-1, 8*IP4_LANE),
+                                    window.getLE_TKeep(IP4_LANE+W/8-1, IP4_LANE),
+                                    (currChunk.getLE_TLast() and (currChunk.getLE_TKeep()[IP4_LANE] == 0)));
+            soIId_Data.write(sendChunk);
+        }
+        ica_prevChunk = currChunk;
+        if (currChunk.getLE_TLast()) {
+            // The remaining bytes of the last chunk are sent upon the next cycle
+            ica_wasLastChunk = (ica_chunkCount >= IP4_CHUNK) and (currChunk.getLE_TKeep()[IP4_LANE] == 1);
+            ica_chunkCount   = 0;
+            ica_ipHdrLen     = 0;
+            ica_dstIpAddress = 0;
+        }
+        else if (ica_chunkCount != 15) {
+            ica_chunkCount++;
+        }
+    }
+    else if (ica_wasLastChunk && !soIId_Data.full()) {
+        // Send remaining Chunk;
+        sendChunk = AxisRawT<W>(ica_prevChunk.getLE_TData(W-1, 8*IP4_LANE),
+                                ica_prevChunk.getLE_TKeep(W/8-1, IP4_LANE),
+                                TLAST);
+        soIId_Data.write(sendChunk);
+        ica_wasLastChunk = false;
+    }
+}
+
 /*******************************************************************************
  *
  * ENTITY - IP RX HANDLER (IPRX)
@@ -161,6 +161,8 @@ if { $hlsCSim} {
     csim_design -argv "../../../../test/testVectors/siL3_WrongSubNet.dat"
     csim_design -argv "../../../../test/testVectors/siUOE_RampDgrmSize.dat"   
     csim_design -argv "../../../../test/testVectors/siL3_IpOptions.dat"   
+    csim_design -argv "../../../../test/testVectors/siL3_ArpMiss.dat"
+    csim_design -argv "../../../../test/testVectors/siL3_SmallPkts.dat"
     puts "#############################################################"
     puts "####                                                     ####"
     puts "####          SUCCESSFUL END OF C SIMULATION             ####"
@@ -72,6 +72,7 @@ using namespace hls;
 #define TRACE_ICI  1 << 2
 #define TRACE_IAE  1 << 3
 #define TRACE_MAI  1 << 4
+#define TRACE_MAR  1 << 5
 #define TRACE_ALL  0xFFFF
 
 #define DEBUG_LEVEL (TRACE_OFF)
@@ -87,6 +88,9 @@ using namespace hls;
  * @details
  *  This process computes the IPv4 header checksum and forwards it to the
  *  next process which will insert it into the header of the incoming packet.
+ *  The header words are accumulated with the checksum library of the NTS (see
+ *  'nts_csum.hpp') and the checksum is emitted along with the last chunk of
+ *  the header, such that a minimum-size packet can be forwarded at line-rate.
  *
  * @Warning
  *  The IP header is formatted for transmission over a 64-bits interface which
@@ -116,123 +120,61 @@ void pHeaderChecksumAccumulator(
     const char *myName  = concat3(THIS_NAME, "/", "HCa");
 
     //-- STATIC CONTROL VARIABLES (with RESET) --------------------------------
-    static bool                             hca_csumWritten=true;
-    #pragma HLS RESET              variable=hca_csumWritten
-    static enum FsmState {S0=0, S1, S2, S3} hca_fsmState=S0;
-    #pragma HLS RESET              variable=hca_fsmState
-    static ap_uint<17>                      hca_ipHdrCsum[4]={0, 0, 0, 0};
-    #pragma HLS RESET              variable=hca_ipHdrCsum
-    #pragma HLS ARRAY_PARTITION    variable=hca_ipHdrCsum complete dim=1
     static ap_uint<3>                       hca_chunkCount=0;
     #pragma HLS RESET              variable=hca_chunkCount
 
     //-- STATIC DATAFLOW VARIABLES --------------------------------------------
     static ap_uint<4>                       hca_ipHdrLen;
+    static CsumAcc                          hca_ipHdrAcc;
 
     //-- DYNAMIC VARIABLES ----------------------------------------------------
     AxisIp4     currChunk;
-    Ip4HdrCsum  tempHdrCsum;
+    CsumAcc     ipHdrAcc;
+    LE_tKeep    hdrKeep = 0xFF;  // The bytes of the chunk to accumulate
+    bool        isHdrEnd = false;
 
-    currChunk.setLE_TLast(0);
-    if(!hca_csumWritten) {
-        switch (hca_fsmState) {
-        case S0:
-            hca_ipHdrCsum[0] += hca_ipHdrCsum[2];
-            hca_ipHdrCsum[1] += hca_ipHdrCsum[3];
-            hca_ipHdrCsum[0] = (hca_ipHdrCsum[0] + (hca_ipHdrCsum[0] >> 16)) & 0xFFFF;
-            hca_ipHdrCsum[1] = (hca_ipHdrCsum[1] + (hca_ipHdrCsum[1] >> 16)) & 0xFFFF;
-            hca_fsmState = S1;
-            break;
-        case S1:
-            hca_ipHdrCsum[0] += hca_ipHdrCsum[1];
-            hca_ipHdrCsum[0] = (hca_ipHdrCsum[0] + (hca_ipHdrCsum[0] >> 16)) & 0xFFFF;
-            hca_fsmState = S2;
-            break;
-        case S2:
-            hca_ipHdrCsum[0] = ~hca_ipHdrCsum[0];
-            soICi_Csum.write(hca_ipHdrCsum[0](15, 0));
-            hca_fsmState = S3;
-            break;
-        case S3:
-            hca_ipHdrCsum[0] = 0;
-            hca_ipHdrCsum[1] = 0;
-            hca_ipHdrCsum[2] = 0;
-            hca_ipHdrCsum[3] = 0;
-            hca_csumWritten = true;
-            hca_fsmState = S0;
-            break;
-        }
-    }
-    else if (!siL3MUX_Data.empty() and !soICi_Data.full() and hca_csumWritten) {
+    if (!siL3MUX_Data.empty() and !soICi_Data.full() and !soICi_Csum.full()) {
         siL3MUX_Data.read(currChunk);
+        ipHdrAcc = (hca_chunkCount == 0) ? CsumAcc(0) : hca_ipHdrAcc;
         // Process the IPv4 header.
         //  Remember that the Internet Header Length (IHL) field contains the
         //  size of the IPv4 header specified in number of 32-bit words, and
         //  its default minimum value is 5.
         switch (hca_chunkCount) {
         case 0:
-            hca_ipHdrLen = currChunk.getIp4HdrLen();
             //-- Accumulate 1st IPv4 header qword [Frag|Ident|TotLen|ToS|IHL]
-            for (int i=0; i<4; i++) {
-              #pragma HLS UNROLL
-                tempHdrCsum( 7, 0) = currChunk.getLE_TData().range(i*16+15, i*16+8);
-                tempHdrCsum(15, 8) = currChunk.getLE_TData().range(i*16+7,  i*16);
-                hca_ipHdrCsum[i]  += tempHdrCsum;
-                hca_ipHdrCsum[i]   = (hca_ipHdrCsum[i] + (hca_ipHdrCsum[i] >> 16)) & 0xFFFF;
-            }
+            hca_ipHdrLen = currChunk.getIp4HdrLen() - 2;
             hca_chunkCount++;
-            hca_ipHdrLen -= 2;
             break;
         case 1:
             //-- Accumulate 2nd IPv4 header qword [SA|HdCsum|Prot|TTL]
-            for (int i=0; i<4; i++) {
-              #pragma HLS UNROLL
-                if (i != 1) {
-                    // Skip 3rd and 4th bytes. They contain the IP header checksum.
-                    tempHdrCsum( 7, 0) = currChunk.getLE_TData().range(i*16+15, i*16+8);
-                    tempHdrCsum(15, 8) = currChunk.getLE_TData().range(i*16+7,  i*16);
-                    hca_ipHdrCsum[i]  += tempHdrCsum;
-                    hca_ipHdrCsum[i]  = (hca_ipHdrCsum[i] + (hca_ipHdrCsum[i] >> 16)) & 0xFFFF;
-                }
-            }
-            hca_chunkCount++;
+            //--  Skip 3rd and 4th bytes. They contain the IP header checksum.
+            hdrKeep = 0xF3;
             hca_ipHdrLen -= 2;
+            hca_chunkCount++;
             break;
         default:
-            switch (hca_ipHdrLen) {
-            case 0:
-                //-- We are done with the checksum header processing
-                break;
-            case 1:
+            if (hca_ipHdrLen == 1) {
                 //-- Accumulate half of the 3rd IPv4 header qword [DA] or
                 //-- Accumulate the last IPv4 option dword
-                for (int i = 0; i < 2; i++) {
-                  #pragma HLS UNROLL
-                    tempHdrCsum( 7, 0) = currChunk.getLE_TData().range(i*16+15, i*16+8);
-                    tempHdrCsum(15, 8) = currChunk.getLE_TData().range(i*16+7,  i*16);
-                    hca_ipHdrCsum[i]  += tempHdrCsum;
-                    hca_ipHdrCsum[i]   = (hca_ipHdrCsum[i] + (hca_ipHdrCsum[i] >> 16)) & 0xFFFF;
-                }
+                hdrKeep = 0x0F;
                 hca_ipHdrLen = 0;
-                hca_csumWritten = false;
-                break;
-            default:
-                // Sum up everything
-                for (int i = 0; i < 4; i++) {
-                  #pragma HLS UNROLL
-                    tempHdrCsum( 7, 0) = currChunk.getLE_TData().range(i*16+15, i*16+8);
-                    tempHdrCsum(15, 8) = currChunk.getLE_TData().range(i*16+7,  i*16);
-                    hca_ipHdrCsum[i] += tempHdrCsum;
-                    hca_ipHdrCsum[i] = (hca_ipHdrCsum[i] + (hca_ipHdrCsum[i] >> 16)) & 0xFFFF;
-                }
+                isHdrEnd = true;
+            }
+            else if (hca_ipHdrLen != 0) {
                 hca_ipHdrLen -= 2;
-                if (hca_ipHdrLen == 0) {
-                    hca_csumWritten = false;
-                }
-                break;
-            } // End-of: switch ipHeaderLen
+                isHdrEnd = (hca_ipHdrLen == 0);
+            }
+            else {
+                //-- We are done with the checksum header processing
+                hdrKeep = 0x00;
+            }
             break;
         } // End-of: switch(hca_chunkCount)
+        hca_ipHdrAcc = csumAccumulate<ARW>(ipHdrAcc, AxisRaw(currChunk.getLE_TData(), hdrKeep, 0));
+        if (isHdrEnd) {
+            soICi_Csum.write(csumFinalize(hca_ipHdrAcc));
+        }
         soICi_Data.write(currChunk);
         if (currChunk.getLE_TLast()) {
             hca_chunkCount = 0;
@@ -310,19 +252,21 @@ void pIpChecksumInsert(
  * @param[in]  piMMIO_GatewayAddrThe default gateway address from [MMIO].
  * @param[in]  siICi_Data        The data stream from IpChecksumInserter ICi).
  * @param[out] soMAi_Data        The data stream to MacAddressInserter (MAi).
- * @param[out] soARP_LookupReq   IPv4 address lookup request to [ARP].
+ * @param[out] soMAr_NextHop     The IPv4 address of the next hop to MacAddressResolver (MAr).
  *
  * @details
  *  This process extracts the IP destination address from the incoming stream
- *  and forwards it to the Address Resolution Protocol server (ARP) in order to
- *  look up the corresponding MAC address.
+ *  and forwards the address of the next hop (i.e. the destination itself or
+ *  the default gateway) to the MacAddressResolver (MAr) which will retrieve
+ *  the corresponding MAC address from its cache or from the Address Resolution
+ *  Protocol server (ARP).
  *******************************************************************************/
 void pIp4AddressExtractor(
         Ip4Addr              piMMIO_SubNetMask,
         Ip4Addr              piMMIO_GatewayAddr,
         stream<AxisIp4>     &siICi_Data,
         stream<AxisIp4>     &soMAi_Data,
-        stream<Ip4Addr>     &soARP_LookupReq)
+        stream<Ip4Addr>     &soMAr_NextHop)
 {
     //-- DIRECTIVES FOR THIS PROCESS -------------------------------------------
     #pragma HLS INLINE off
@@ -344,10 +288,10 @@ void pIp4AddressExtractor(
             ipDestAddr = currChunk.getIp4DstAddr();
             if ((ipDestAddr & piMMIO_SubNetMask) == (piMMIO_GatewayAddr & piMMIO_SubNetMask)
               || (ipDestAddr == 0xFFFFFFFF)) {
-                soARP_LookupReq.write(ipDestAddr);
+                soMAr_NextHop.write(ipDestAddr);
             }
             else {
-                soARP_LookupReq.write(piMMIO_GatewayAddr);
+                soMAr_NextHop.write(piMMIO_GatewayAddr);
             }
             iae_chunkCount++;
             break;
@@ -364,22 +308,286 @@ void pIp4AddressExtractor(
     }
 }
 
+#ifndef __SYNTHESIS__
+  //-- The number of next-hop cache hits, misses and flushes of [MAr] (for the testbench only)
+  static unsigned int marNrHits    = 0;
+  static unsigned int marNrMisses  = 0;
+  static unsigned int marNrFlushes = 0;
+
+  /*****************************************************************************
+   * @brief Return the statistics of the next-hop MAC cache of [MAr].
+   *
+   * @param[out] nrHits     The number of packets whose next hop was cached.
+   * @param[out] nrMisses   The number of packets whose next hop was looked-up.
+   * @param[out] nrFlushes  The number of flushes upon an update of the ARP.
+   *****************************************************************************/
+  void getMacCacheStats(unsigned int &nrHits, unsigned int &nrMisses,
+                        unsigned int &nrFlushes) {
+      nrHits    = marNrHits;
+      nrMisses  = marNrMisses;
+      nrFlushes = marNrFlushes;
+  }
+#endif
+
+/*******************************************************************************
+ * MAC Address Resolver (MAr)
+ *
+ * @param[in]  siIAe_NextHop    The IPv4 address of the next hop from IpAddressExtractor (IAe).
+ * @param[in]  siMAi_PollReq    The re-lookup of a parked next hop from MacAddressInserter (MAi).
+ * @param[out] soMAi_Meta       The MAC address of the next hop (or poll result) to [MAi].
+ * @param[out] soARP_LookupReq  IPv4 address lookup request to [ARP].
+ * @param[in]  siARP_LookupRep  MAC address looked-up from [ARP].
+ *
+ * @details
+ *  This process retrieves the MAC address of the next hop of every outgoing
+ *  packet. The MAC addresses of the last IPTX_MAC_CACHE_ENTRIES next hops
+ *  are kept in a fully-associative cache, and the ARP is only looked up upon
+ *  a cache miss. The lookups are issued back-to-back without waiting for their
+ *  replies. Because the ARP replies in order, every packet, poll and probe in
+ *  flight gets a tag in an in-order queue, and the replies are matched to the
+ *  tag at the head of that queue. A packet that hit the cache is tagged with
+ *  its MAC address and is forwarded to [MAi] once all its elders have been.
+ *  Every reply of the ARP carries the epoch of its CAM. The cache is flushed
+ *  whenever that epoch changes (i.e. a binding was added or modified) and, if
+ *  the ARP was not looked up for IPTX_MAC_PROBE_CYCLES, the epoch is probed
+ *  with a lookup of the broadcast address which the ARP answers at once.
+ *******************************************************************************/
+void pMacAddressResolver(
+        stream<Ip4Addr>         &siIAe_NextHop,
+        stream<NextHopPoll>     &siMAi_PollReq,
+        stream<NextHopMeta>     &soMAi_Meta,
+        stream<Ip4Addr>         &soARP_LookupReq,
+        stream<ArpLkpReply>     &siARP_LookupRep)
+{
+    //-- DIRECTIVES FOR THIS PROCESS -------------------------------------------
+    #pragma HLS INLINE off
+    #pragma HLS PIPELINE II=1 enable_flush
+
+    const char *myName  = concat3(THIS_NAME, "/", "MAr");
+
+    enum TagKinds { TAG_CACHED=0, TAG_LOOKUP, TAG_POLL, TAG_PROBE };
+
+    //-- STATIC CONTROL VARIABLES (with RESET) ---------------------------------
+    static bool                 mar_cacheValid[IPTX_MAC_CACHE_SIZE];
+    #pragma HLS RESET           variable=mar_cacheValid
+    #pragma HLS ARRAY_PARTITION variable=mar_cacheValid complete dim=1
+    static int                  mar_cacheVictim=0;
+    #pragma HLS RESET           variable=mar_cacheVictim
+    static ArpEpoch             mar_epoch=0;
+    #pragma HLS RESET           variable=mar_epoch
+    static int                  mar_tagHead=0;  // The oldest tag in flight
+    #pragma HLS RESET           variable=mar_tagHead
+    static int                  mar_tagTail=0;
+    #pragma HLS RESET           variable=mar_tagTail
+    static int                  mar_tagCnt=0;   // The number of tags in flight
+    #pragma HLS RESET           variable=mar_tagCnt
+    static ap_uint<32>          mar_cycleCnt=0; // Free-running cycle counter
+    #pragma HLS RESET           variable=mar_cycleCnt
+    static ap_uint<32>          mar_lkpTime=0;  // Cycle of the last lookup
+    #pragma HLS RESET           variable=mar_lkpTime
+
+    //-- STATIC DATAFLOW VARIABLES ---------------------------------------------
+    static Ip4Addr      mar_cacheAddr[IPTX_MAC_CACHE_SIZE];
+    #pragma HLS ARRAY_PARTITION variable=mar_cacheAddr complete dim=1
+    static EthAddr      mar_cacheMac[IPTX_MAC_CACHE_SIZE];
+    #pragma HLS ARRAY_PARTITION variable=mar_cacheMac  complete dim=1
+    static ap_uint<2>   mar_tagKind[IPTX_MAR_TAGS];
+    #pragma HLS ARRAY_PARTITION variable=mar_tagKind   complete dim=1
+    static Ip4Addr      mar_tagAddr[IPTX_MAR_TAGS];
+    #pragma HLS ARRAY_PARTITION variable=mar_tagAddr   complete dim=1
+    static EthAddr      mar_tagMac[IPTX_MAR_TAGS];
+    #pragma HLS ARRAY_PARTITION variable=mar_tagMac    complete dim=1
+    static ap_uint<8>   mar_tagPark[IPTX_MAR_TAGS];
+    #pragma HLS ARRAY_PARTITION variable=mar_tagPark   complete dim=1
+
+    //-- DYNAMIC VARIABLES -----------------------------------------------------
+    bool        tagPop   = false;
+    bool        tagPush  = false;
+    bool        isCached = false;
+    bool        anyValid = false;
+    int         cacheIdx = mar_cacheVictim;
+    ap_uint<2>  tagKind  = mar_tagKind[mar_tagHead];
+    Ip4Addr     tagAddr  = mar_tagAddr[mar_tagHead];
+    Ip4Addr     nextHop;
+    NextHopPoll pollReq;
+    ArpLkpReply arpReply;
+
+    mar_cycleCnt++;
+
+    //-- Retire the oldest tag in flight ---------------------------------------
+    if ((mar_tagCnt > 0) and !soMAi_Meta.full()) {
+        if (tagKind == TAG_CACHED) {
+            soMAi_Meta.write(NextHopMeta(tagAddr, mar_tagMac[mar_tagHead], LKP_HIT));
+            tagPop = true;
+        }
+        else if (!siARP_LookupRep.empty()) {
+            siARP_LookupRep.read(arpReply);
+            tagPop = true;
+            if (arpReply.epoch != mar_epoch) {
+                // The CAM of the ARP was updated. Forget everything.
+                for (int i=0; i<IPTX_MAC_CACHE_SIZE; i++) {
+                  #pragma HLS UNROLL
+                    mar_cacheValid[i] = false;
+                }
+                mar_epoch = arpReply.epoch;
+                #ifndef __SYNTHESIS__
+                marNrFlushes++;
+                #endif
+                if (DEBUG_LEVEL & TRACE_MAR) {
+                    printInfo(myName, "Flushing the cache upon epoch #%d of the ARP.\n",
+                              arpReply.epoch.to_int());
+                }
+            }
+            else {
+                for (int i=0; i<IPTX_MAC_CACHE_SIZE; i++) {
+                  #pragma HLS UNROLL
+                    if (mar_cacheValid[i] and (mar_cacheAddr[i] == tagAddr)) {
+                        isCached = true;
+                        cacheIdx = i;
+                    }
+                }
+            }
+            if (IPTX_MAC_CACHE_ENTRIES and arpReply.hit and (tagKind != TAG_PROBE)) {
+                mar_cacheValid[cacheIdx] = true;
+                mar_cacheAddr[cacheIdx]  = tagAddr;
+                mar_cacheMac[cacheIdx]   = arpReply.macAddress;
+                if (not isCached) {
+                    // Replace the entries in a round-robin fashion
+                    mar_cacheVictim = (mar_cacheVictim == IPTX_MAC_CACHE_SIZE-1) ? 0 : mar_cacheVictim+1;
+                }
+            }
+            if (tagKind == TAG_LOOKUP) {
+                soMAi_Meta.write(NextHopMeta(tagAddr, arpReply.macAddress, arpReply.hit));
+            }
+            else if (tagKind == TAG_POLL) {
+                soMAi_Meta.write(NextHopMeta(mar_tagPark[mar_tagHead], arpReply.macAddress, arpReply.hit));
+            }
+        }
+        if (tagPop) {
+            mar_tagHead = (mar_tagHead == IPTX_MAR_TAGS-1) ? 0 : mar_tagHead+1;
+        }
+    }
+
+    //-- Tag a new probe, poll or packet ---------------------------------------
+    for (int i=0; i<IPTX_MAC_CACHE_SIZE; i++) {
+      #pragma HLS UNROLL
+        if (mar_cacheValid[i]) {
+            anyValid = true;
+        }
+    }
+    if ((mar_tagCnt < IPTX_MAR_TAGS) and !soARP_LookupReq.full()) {
+        if (anyValid and ((ap_uint<32>)(mar_cycleCnt - mar_lkpTime) >= IPTX_MAC_PROBE_CYCLES)) {
+            soARP_LookupReq.write(IP4_BROADCAST_ADDR);
+            mar_tagKind[mar_tagTail] = TAG_PROBE;
+            mar_tagAddr[mar_tagTail] = IP4_BROADCAST_ADDR;
+            mar_lkpTime = mar_cycleCnt;
+            tagPush = true;
+        }
+        else if (!siMAi_PollReq.empty()) {
+            siMAi_PollReq.read(pollReq);
+            soARP_LookupReq.write(pollReq.ip4Addr);
+            mar_tagKind[mar_tagTail] = TAG_POLL;
+            mar_tagAddr[mar_tagTail] = pollReq.ip4Addr;
+            mar_tagPark[mar_tagTail] = pollReq.parkIdx;
+            mar_lkpTime = mar_cycleCnt;
+            tagPush = true;
+        }
+        else if (!siIAe_NextHop.empty()) {
+            siIAe_NextHop.read(nextHop);
+            bool    isHit  = false;
+            EthAddr hitMac = 0;
+            for (int i=0; i<IPTX_MAC_CACHE_SIZE; i++) {
+              #pragma HLS UNROLL
+                if (mar_cacheValid[i] and (mar_cacheAddr[i] == nextHop)) {
+                    isHit  = true;
+                    hitMac = mar_cacheMac[i];
+                }
+            }
+            if (IPTX_MAC_CACHE_ENTRIES and isHit) {
+                mar_tagKind[mar_tagTail] = TAG_CACHED;
+                mar_tagMac[mar_tagTail]  = hitMac;
+                #ifndef __SYNTHESIS__
+                marNrHits++;
+                #endif
+            }
+            else {
+                soARP_LookupReq.write(nextHop);
+                mar_tagKind[mar_tagTail] = TAG_LOOKUP;
+                mar_lkpTime = mar_cycleCnt;
+                #ifndef __SYNTHESIS__
+                marNrMisses++;
+                #endif
+            }
+            mar_tagAddr[mar_tagTail] = nextHop;
+            tagPush = true;
+            if (DEBUG_LEVEL & TRACE_MAR) {
+                printIp4Addr(myName, (isHit ? "Cache=HIT  for next hop" : "Cache=MISS for next hop"), nextHop);
+            }
+        }
+        if (tagPush) {
+            mar_tagTail = (mar_tagTail == IPTX_MAR_TAGS-1) ? 0 : mar_tagTail+1;
+        }
+    }
+    if (tagPush and not tagPop) {
+        mar_tagCnt++;
+    }
+    else if (tagPop and not tagPush) {
+        mar_tagCnt--;
+    }
+}
+
+#ifndef __SYNTHESIS__
+  //-- The number of packets parked, released, expired and dropped by [MAi] (for the testbench only)
+  static unsigned int maiNrParked   = 0;
+  static unsigned int maiNrReleased = 0;
+  static unsigned int maiNrExpired  = 0;
+  static unsigned int maiNrDropped  = 0;
+
+  /*****************************************************************************
+   * @brief Return the statistics of the pending-packet buffer of [MAi].
+   *
+   * @param[out] nrParked    The number of packets parked upon an ARP miss.
+   * @param[out] nrReleased  The number of parked packets sent after resolution.
+   * @param[out] nrExpired   The number of parked packets dropped upon timeout.
+   * @param[out] nrDropped   The number of packets dropped for lack of space.
+   *****************************************************************************/
+  void getArpParkStats(unsigned int &nrParked, unsigned int &nrReleased,
+                       unsigned int &nrExpired, unsigned int &nrDropped) {
+      nrParked   = maiNrParked;
+      nrReleased = maiNrReleased;
+      nrExpired  = maiNrExpired;
+      nrDropped  = maiNrDropped;
+  }
+#endif
+
 /*******************************************************************************
  * MAC Address Inserter (MAi)
  *
  * @param[in]  piMMIO_MacAddress My Ethernet MAC address from [MMIO].
  * @param[in]  siIAe_Data        The data stream from IpAddressExtractor (IAe).
- * @param[out] siARP_LookupRsp   MAC address looked-up from [ARP].
- * @param[in]  soL2MUX_Data      The data stream to [L2MUX].
+ * @param[in]  siMAr_Meta        The MAC address of the next hop from MacAddressResolver (MAr).
+ * @param[out] soMAr_PollReq     The re-lookup of a parked next hop to [MAr].
+ * @param[out] soL2MUX_Data      The data stream to [L2MUX].
  *
  * @details
  *  This process prepends the appropriate Ethernet header to the outgoing IPv4
- *  packet.
+ *  packet, using the MAC address of its next hop provided by [MAr].
+ *  Upon an ARP miss, the packet is not dropped but parked in a pending-packet
+ *  buffer while the ARP fires an ARP-REQUEST. The buffer holds up to
+ *  IPTX_ARP_PARK_PKTS packets for each of IPTX_ARP_PARK_DSTS next hops. A
+ *  pending next hop is polled (i.e. looked-up again) every IPTX_ARP_POLL_CYCLES
+ *  and its packets are sent in order as soon as the binding returned by the
+ *  ARP-REPLY has been installed. The packets of a next hop that is not
+ *  resolved within IPTX_ARP_PARK_CYCLES are dropped. A new packet for a pending
+ *  next hop is parked behind its elders, even if it was resolved meanwhile, in
+ *  order to preserve the order of the packets. A packet is dropped when there
+ *  is no room left to park it.
  *******************************************************************************/
 void pMacAddressInserter(
         EthAddr                  piMMIO_MacAddress,
         stream<AxisIp4>         &siIAe_Data,
-        stream<ArpLkpReply>     &siARP_LookupRsp,
+        stream<NextHopMeta>     &siMAr_Meta,
+        stream<NextHopPoll>     &soMAr_PollReq,
         stream<AxisEth>         &soL2MUX_Data)
 {
     //-- DIRECTIVES FOR THIS PROCESS -------------------------------------------
@@ -388,52 +596,216 @@ void pMacAddressInserter(
 
     const char *myName  = concat3(THIS_NAME, "/", "MAi");
 
+    //-- STATIC ARRAYS ---------------------------------------------------------
+    static AxisIp4             PARK_BUFFER[IPTX_ARP_PARK_DSTS*IPTX_ARP_PARK_PKTS*IPTX_PARK_CHUNKS];
+    #pragma HLS RESOURCE   variable=PARK_BUFFER core=RAM_T2P_BRAM
+    #pragma HLS DATA_PACK  variable=PARK_BUFFER
+    #pragma HLS DEPENDENCE variable=PARK_BUFFER inter false
+
     //-- STATIC CONTROL VARIABLES (with RESET) ---------------------------------
-    static enum FsmStates {FSM_MAI_WAIT_LOOKUP=0, FSM_MAI_DROP, FSM_MAI_WRITE,
-                           FSM_MAI_WRITE_FIRST,   FSM_MAI_WRITE_LAST} \
-                               mai_fsmState=FSM_MAI_WAIT_LOOKUP;
+    static enum FsmStates {FSM_MAI_IDLE=0,      FSM_MAI_PARK,        FSM_MAI_DROP,
+                           FSM_MAI_REPLAY,      FSM_MAI_WRITE_FIRST, FSM_MAI_WRITE,
+                           FSM_MAI_WRITE_LAST} mai_fsmState=FSM_MAI_IDLE;
     #pragma HLS RESET variable=mai_fsmState
+    static bool                mai_parkValid[IPTX_ARP_PARK_DSTS];
+    #pragma HLS RESET          variable=mai_parkValid
+    #pragma HLS ARRAY_PARTITION variable=mai_parkValid complete dim=1
+    static bool                mai_parkPolled[IPTX_ARP_PARK_DSTS];  // A poll is in flight
+    #pragma HLS RESET          variable=mai_parkPolled
+    #pragma HLS ARRAY_PARTITION variable=mai_parkPolled complete dim=1
+    static bool                mai_replay=false;
+    #pragma HLS RESET variable=mai_replay
+    static int                 mai_pollIdx=0;
+    #pragma HLS RESET variable=mai_pollIdx
+    static ap_uint<32>         mai_cycleCnt=0;  // Free-running cycle counter
+    #pragma HLS RESET variable=mai_cycleCnt
 
     //-- STATIC DATAFLOW VARIABLES ---------------------------------------------
-    static AxisIp4  mai_prevChunk;
+    static AxisIp4      mai_prevChunk;
+    static Ip4Addr      mai_nextHop;
+    static EthAddr      mai_macDstAddr;
+    static int          mai_parkIdx;   // The next hop being parked, polled or released
+    static int          mai_pktIdx;    // The packet being released
+    static ap_uint<9>   mai_chunkIdx;  // The chunk being parked or released
+    static Ip4Addr      mai_parkAddr[IPTX_ARP_PARK_DSTS];
+    #pragma HLS ARRAY_PARTITION variable=mai_parkAddr  complete dim=1
+    static ap_uint<32>  mai_parkBirth[IPTX_ARP_PARK_DSTS];  // Cycle of the first miss
+    #pragma HLS ARRAY_PARTITION variable=mai_parkBirth complete dim=1
+    static ap_uint<32>  mai_parkPoll[IPTX_ARP_PARK_DSTS];   // Cycle of the last lookup
+    #pragma HLS ARRAY_PARTITION variable=mai_parkPoll  complete dim=1
+    static ap_uint<8>   mai_parkCnt[IPTX_ARP_PARK_DSTS];    // Number of packets parked
+    #pragma HLS ARRAY_PARTITION variable=mai_parkCnt   complete dim=1
 
     //-- DYNAMIC VARIABLES -----------------------------------------------------
     AxisEth     sendChunk;
     AxisIp4     currChunk;
-    ArpLkpReply arpResponse;
-    EthAddr     macDstAddr;
+    NextHopMeta nextHopMeta;
+    bool        endOfFrame = false;
+
+    mai_cycleCnt++;
 
     currChunk.setLE_TLast(0);
     switch (mai_fsmState) {
-    case FSM_MAI_WAIT_LOOKUP:
-        if (!siARP_LookupRsp.empty() and !soL2MUX_Data.full()) {
-            siARP_LookupRsp.read(arpResponse);
-            macDstAddr = arpResponse.macAddress;
-            if (arpResponse.hit) {
-                sendChunk.setEthDstAddr(macDstAddr);
-                sendChunk.setEthSrcAddrHi(piMMIO_MacAddress);
-                sendChunk.setLE_TKeep(0xff);
-                sendChunk.setLE_TLast(0);
-                soL2MUX_Data.write(sendChunk);
-                mai_fsmState = FSM_MAI_WRITE_FIRST;
+    case FSM_MAI_IDLE:
+        if (mai_parkValid[mai_pollIdx] and not mai_parkPolled[mai_pollIdx] and
+            ((ap_uint<32>)(mai_cycleCnt - mai_parkPoll[mai_pollIdx]) >= IPTX_ARP_POLL_CYCLES)) {
+            if ((ap_uint<32>)(mai_cycleCnt - mai_parkBirth[mai_pollIdx]) >= IPTX_ARP_PARK_CYCLES) {
+                // Give up with the resolution of this next hop
+                mai_parkValid[mai_pollIdx] = false;
+                #ifndef __SYNTHESIS__
+                maiNrExpired += mai_parkCnt[mai_pollIdx];
+                #endif
                 if (DEBUG_LEVEL & TRACE_MAI) {
-                    printInfo(myName, "FSM_MAI_WAIT_LOOKUP - Lookup=HIT - Received MAC = 0x%12.12lX\n",
-                              arpResponse.macAddress.to_ulong());
-                    printAxisRaw(myName, "Forwarding AxisChunk to [L2MUX]: ", sendChunk);
+                    printInfo(myName, "FSM_MAI_IDLE - Dropping %d pending packet(s) upon timeout.\n",
+                              mai_parkCnt[mai_pollIdx].to_int());
                 }
             }
-            else {  // Drop it all, wait for RT
-                mai_fsmState = FSM_MAI_DROP;
-                if (DEBUG_LEVEL & TRACE_MAI) {
-                    printInfo(myName, "FSM_MAI_WAIT_LOOKUP - Lookup=NO-HIT. \n");
+            else if (!soMAr_PollReq.full()) {
+                soMAr_PollReq.write(NextHopPoll(mai_parkAddr[mai_pollIdx], mai_pollIdx));
+                mai_parkPoll[mai_pollIdx]   = mai_cycleCnt;
+                mai_parkPolled[mai_pollIdx] = true;
+            }
+        }
+        else if (!siMAr_Meta.empty() and !soL2MUX_Data.full()) {
+            siMAr_Meta.read(nextHopMeta);
+            if (nextHopMeta.isPoll) {
+                mai_parkPolled[nextHopMeta.parkIdx] = false;
+                if (nextHopMeta.hit) {
+                    mai_parkIdx    = nextHopMeta.parkIdx;
+                    mai_macDstAddr = nextHopMeta.macAddr;
+                    mai_pktIdx     = 0;
+                    mai_fsmState   = FSM_MAI_REPLAY;
+                    if (DEBUG_LEVEL & TRACE_MAI) {
+                        printInfo(myName, "FSM_MAI_IDLE - Poll=HIT - Releasing %d pending packet(s).\n",
+                                  mai_parkCnt[nextHopMeta.parkIdx].to_int());
+                    }
+                }
+            }
+            else {
+                mai_nextHop = nextHopMeta.nextHop;
+                bool isPending = false;
+                bool isFree    = false;
+                for (int i=0; i<IPTX_ARP_PARK_DSTS; i++) {
+                  #pragma HLS UNROLL
+                    if (mai_parkValid[i] and (mai_parkAddr[i] == mai_nextHop)) {
+                        isPending   = true;
+                        mai_parkIdx = i;
+                    }
+                }
+                if (not isPending) {
+                    for (int i=0; i<IPTX_ARP_PARK_DSTS; i++) {
+                      #pragma HLS UNROLL
+                        if (not mai_parkValid[i] and not isFree) {
+                            isFree      = true;
+                            mai_parkIdx = i;
+                        }
+                    }
+                }
+                if (isPending) {
+                    // Park it behind its elders
+                    if (mai_parkCnt[mai_parkIdx] < IPTX_ARP_PARK_PKTS) {
+                        mai_chunkIdx = 0;
+                        mai_fsmState = FSM_MAI_PARK;
+                    }
+                    else {
+                        #ifndef __SYNTHESIS__
+                        maiNrDropped++;
+                        #endif
+                        mai_fsmState = FSM_MAI_DROP;
+                    }
+                }
+                else if (nextHopMeta.hit) {
+                    sendChunk.setEthDstAddr(nextHopMeta.macAddr);
+                    sendChunk.setEthSrcAddrHi(piMMIO_MacAddress);
+                    sendChunk.setLE_TKeep(0xff);
+                    sendChunk.setLE_TLast(0);
+                    soL2MUX_Data.write(sendChunk);
+                    mai_replay   = false;
+                    mai_fsmState = FSM_MAI_WRITE_FIRST;
+                    if (DEBUG_LEVEL & TRACE_MAI) {
+                        printInfo(myName, "FSM_MAI_IDLE - Lookup=HIT - Received MAC = 0x%12.12lX\n",
+                                  nextHopMeta.macAddr.to_ulong());
+                        printAxisRaw(myName, "Forwarding AxisChunk to [L2MUX]: ", sendChunk);
+                    }
+                }
+                else if (IPTX_ARP_PARK and isFree) {
+                    // Park it while the ARP resolves the next hop
+                    mai_parkValid[mai_parkIdx]  = true;
+                    mai_parkPolled[mai_parkIdx] = false;
+                    mai_parkAddr[mai_parkIdx]   = mai_nextHop;
+                    mai_parkBirth[mai_parkIdx]  = mai_cycleCnt;
+                    mai_parkPoll[mai_parkIdx]   = mai_cycleCnt;
+                    mai_parkCnt[mai_parkIdx]    = 0;
+                    mai_chunkIdx = 0;
+                    mai_fsmState = FSM_MAI_PARK;
+                    if (DEBUG_LEVEL & TRACE_MAI) {
+                        printInfo(myName, "FSM_MAI_IDLE - Lookup=NO-HIT. \n");
+                    }
+                }
+                else {
+                    #ifndef __SYNTHESIS__
+                    maiNrDropped++;
+                    #endif
+                    mai_fsmState = FSM_MAI_DROP;
+                }
+            }
+        }
+        mai_pollIdx = (mai_pollIdx == IPTX_ARP_PARK_DSTS-1) ? 0 : mai_pollIdx+1;
+        break;
+    case FSM_MAI_PARK:
+        if (DEBUG_LEVEL & TRACE_MAI) { printInfo(myName, "FSM_MAI_PARK - \n"); }
+        if (!siIAe_Data.empty()) {
+            siIAe_Data.read(currChunk);
+            if (mai_chunkIdx < IPTX_PARK_CHUNKS) {
+                PARK_BUFFER[(mai_parkIdx*IPTX_ARP_PARK_PKTS + mai_parkCnt[mai_parkIdx]) *
+                            IPTX_PARK_CHUNKS + mai_chunkIdx] = currChunk;
+            }
+            if (mai_chunkIdx <= IPTX_PARK_CHUNKS) {
+                // Saturates at IPTX_PARK_CHUNKS+1 when the packet does not fit
+                mai_chunkIdx++;
+            }
+            if (currChunk.getLE_TLast()) {
+                if (mai_chunkIdx <= IPTX_PARK_CHUNKS) {
+                    mai_parkCnt[mai_parkIdx]++;
+                    #ifndef __SYNTHESIS__
+                    maiNrParked++;
+                    #endif
+                }
+                else {
+                    if (mai_parkCnt[mai_parkIdx] == 0) {
+                        mai_parkValid[mai_parkIdx] = false;
+                    }
+                    #ifndef __SYNTHESIS__
+                    maiNrDropped++;
+                    #endif
                 }
+                mai_fsmState = FSM_MAI_IDLE;
             }
         }
         break;
+    case FSM_MAI_REPLAY:
+        if (!soL2MUX_Data.full()) {
+            sendChunk.setEthDstAddr(mai_macDstAddr);
+            sendChunk.setEthSrcAddrHi(piMMIO_MacAddress);
+            sendChunk.setLE_TKeep(0xff);
+            sendChunk.setLE_TLast(0);
+            soL2MUX_Data.write(sendChunk);
+            mai_replay   = true;
+            mai_chunkIdx = 0;
+            mai_fsmState = FSM_MAI_WRITE_FIRST;
+        }
+        break;
     case FSM_MAI_WRITE_FIRST:
         if (DEBUG_LEVEL & TRACE_MAI) { printInfo(myName, "FSM_MAI_WRITE_FIRST - \n"); }
-        if (!siIAe_Data.empty() and !soL2MUX_Data.full()) {
-            siIAe_Data.read(currChunk);
+        if ((mai_replay or !siIAe_Data.empty()) and !soL2MUX_Data.full()) {
+            if (mai_replay) {
+                currChunk = PARK_BUFFER[(mai_parkIdx*IPTX_ARP_PARK_PKTS + mai_pktIdx) *
+                                        IPTX_PARK_CHUNKS + mai_chunkIdx];
+                mai_chunkIdx++;
+            }
+            else {
+                siIAe_Data.read(currChunk);
+            }
             sendChunk.setEthSrcAddrLo(piMMIO_MacAddress);
             sendChunk.setEthTypeLen(0x0800);
             sendChunk.setIp4HdrLen(currChunk.getIp4HdrLen());
@@ -448,8 +820,15 @@ void pMacAddressInserter(
         break;
     case FSM_MAI_WRITE:
         if (DEBUG_LEVEL & TRACE_MAI) { printInfo(myName, "FSM_MAI_WRITE - \n"); }
-        if (!siIAe_Data.empty() and !soL2MUX_Data.full()) {
-            siIAe_Data.read(currChunk);
+        if ((mai_replay or !siIAe_Data.empty()) and !soL2MUX_Data.full()) {
+            if (mai_replay) {
+                currChunk = PARK_BUFFER[(mai_parkIdx*IPTX_ARP_PARK_PKTS + mai_pktIdx) *
+                                        IPTX_PARK_CHUNKS + mai_chunkIdx];
+                mai_chunkIdx++;
+            }
+            else {
+                siIAe_Data.read(currChunk);
+            }
             sendChunk.setLE_TData(mai_prevChunk.getLE_TData(63, 16), 47,  0);
             sendChunk.setLE_TData(    currChunk.getLE_TData(15,  0), 63, 48);
             sendChunk.setLE_TKeep(mai_prevChunk.getLE_TKeep( 7,  2),  5,  0);
@@ -467,7 +846,7 @@ void pMacAddressInserter(
             mai_prevChunk = currChunk;
             if (currChunk.getLE_TLast()) {
                 if (currChunk.getLE_TKeep()[2] == 0) {
-                    mai_fsmState = FSM_MAI_WAIT_LOOKUP;
+                    endOfFrame = true;
                 }
                 else {
                    mai_fsmState = FSM_MAI_WRITE_LAST;
@@ -490,7 +869,7 @@ void pMacAddressInserter(
             if (DEBUG_LEVEL & TRACE_MAI) {
                 printAxisRaw(myName, "Forwarding AxisChunk to [L2MUX]: ", sendChunk);
             }
-            mai_fsmState = FSM_MAI_WAIT_LOOKUP;
+            endOfFrame = true;
         }
         break;
     case FSM_MAI_DROP:
@@ -498,13 +877,32 @@ void pMacAddressInserter(
         if (!siIAe_Data.empty() and !soL2MUX_Data.full()) {
             siIAe_Data.read(currChunk);
             if (currChunk.getLE_TLast()) {
-                mai_fsmState = FSM_MAI_WAIT_LOOKUP;
+                mai_fsmState = FSM_MAI_IDLE;
             }
         }
         break;
 
     } // End-of: switch()
 
+    if (endOfFrame) {
+        if (not mai_replay) {
+            mai_fsmState = FSM_MAI_IDLE;
+        }
+        else if (mai_pktIdx+1 < mai_parkCnt[mai_parkIdx]) {
+            // Release the next packet of this next hop
+            mai_pktIdx++;
+            mai_fsmState = FSM_MAI_REPLAY;
+        }
+        else {
+            #ifndef __SYNTHESIS__
+            maiNrReleased += mai_parkCnt[mai_parkIdx];
+            #endif
+            mai_parkValid[mai_parkIdx] = false;
+            mai_replay   = false;
+            mai_fsmState = FSM_MAI_IDLE;
+        }
+    }
+
 } // End-of: pMacAddressInserter
 
 /*******************************************************************************
@@ -522,9 +920,11 @@ void pMacAddressInserter(
  *  the Internet Control Message Protocol (ICMP) engine or the UDP Offload
  *  Engine (UOE). It first computes the IP header checksum and inserts it into
  *  the IP packet. Next, it extracts the IP_DA from the incoming data stream and
- *  forwards it to the Address Resolution Protocol server (ARP) in order to
- *  look up the corresponding MAC address. Final, an Ethernet header is created
- *  and is prepended to the outgoing IPv4 packet.
+ *  retrieves the MAC address of the next hop from a local cache or from the
+ *  Address Resolution Protocol server (ARP) (see [MAr]). Final, an Ethernet
+ *  header is created and is prepended to the outgoing IPv4 packet. A packet
+ *  whose MAC address is not yet known is parked until the ARP has resolved it
+ *  (see [MAi]).
  *
  *******************************************************************************/
 void iptx(
@@ -559,8 +959,8 @@ void iptx(
 
     //-- Header Checksum Accumulator (HCa)
     static stream<AxisIp4>         ssHCaToICi_Data    ("ssHCaToICi_Data");
-    #pragma HLS STREAM    variable=ssHCaToICi_Data    depth=1024 // Must hold one IP header for checksum computation
-    #pragma HLS DATA_PACK variable=ssHCaToICi_Data               // [FIXME -We only need to store 20 to 24+ bytes]
+    #pragma HLS STREAM    variable=ssHCaToICi_Data    depth=16   // Must hold one IP header for checksum computation
+    #pragma HLS DATA_PACK variable=ssHCaToICi_Data
 
     static stream<Ip4HdrCsum>      ssHCaToICi_Csum    ("ssHCaToICi_Csum");
     #pragma HLS STREAM    variable=ssHCaToICi_Csum    depth=16
@@ -575,6 +975,19 @@ void iptx(
     #pragma HLS STREAM    variable=ssIAeToMAi_Data    depth=16
     #pragma HLS DATA_PACK variable=ssIAeToMAi_Data
 
+    static stream<Ip4Addr>         ssIAeToMAr_NextHop ("ssIAeToMAr_NextHop");
+    #pragma HLS STREAM    variable=ssIAeToMAr_NextHop depth=4
+
+    //-- MAC Address Inserter (MAi)
+    static stream<NextHopPoll>     ssMAiToMAr_PollReq ("ssMAiToMAr_PollReq");
+    #pragma HLS STREAM    variable=ssMAiToMAr_PollReq depth=2
+    #pragma HLS DATA_PACK variable=ssMAiToMAr_PollReq
+
+    //-- MAC Address Resolver (MAr)
+    static stream<NextHopMeta>     ssMArToMAi_Meta    ("ssMArToMAi_Meta");
+    #pragma HLS STREAM    variable=ssMArToMAi_Meta    depth=4
+    #pragma HLS DATA_PACK variable=ssMArToMAi_Meta
+
     //-- PROCESS FUNCTIONS -----------------------------------------------------
 
     pHeaderChecksumAccumulator(
@@ -592,12 +1005,20 @@ void iptx(
             piMMIO_GatewayAddr,
             ssICiToIAe_Data,
             ssIAeToMAi_Data,
-            soARP_LookupReq);
+            ssIAeToMAr_NextHop);
+
+    pMacAddressResolver(
+            ssIAeToMAr_NextHop,
+            ssMAiToMAr_PollReq,
+            ssMArToMAi_Meta,
+            soARP_LookupReq,
+            siARP_LookupRep);
 
     pMacAddressInserter(
             piMMIO_MacAddress,
             ssIAeToMAi_Data,
-            siARP_LookupRep,
+            ssMArToMAi_Meta,
+            ssMAiToMAr_PollReq,
             soL2MUX_Data);
 }
 
@@ -62,6 +62,51 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "../../AxisEth.hpp"
 #include "../../AxisIp4.hpp"
 
+/*******************************************************************************
+ * PENDING PACKETS
+ *  Packets waiting for their ARP resolution are parked in a buffer of the
+ *  MacAddressInserter (MAi) made of IPTX_ARP_PARK_DSTS x IPTX_ARP_PARK_PKTS
+ *  slots of IPTX_PARK_CHUNKS chunks each (see 'nts_config.hpp').
+ *******************************************************************************/
+static const int         IPTX_PARK_CHUNKS      = 256; // 2KB per slot (i.e. one MTU-sized packet)
+static const ap_uint<32> IPTX_ARP_POLL_CYCLES  = (IPTX_ARP_POLL_US/0.0064) + 1;
+static const ap_uint<32> IPTX_ARP_PARK_CYCLES  = (IPTX_ARP_PARK_MAX_US/0.0064) + 1;
+
+/*******************************************************************************
+ * NEXT-HOP MAC CACHE
+ *  The MacAddressResolver (MAr) caches the MAC addresses of the last
+ *  IPTX_MAC_CACHE_ENTRIES next hops and keeps a tag for each of the packets,
+ *  polls and probes it has in flight (see 'nts_config.hpp').
+ *******************************************************************************/
+static const int         IPTX_MAC_CACHE_SIZE   = (IPTX_MAC_CACHE_ENTRIES > 0) ? IPTX_MAC_CACHE_ENTRIES : 1;
+static const int         IPTX_MAR_TAGS         = 8;
+static const ap_uint<32> IPTX_MAC_PROBE_CYCLES = (IPTX_MAC_CACHE_PROBE_US/0.0064) + 1;
+
+//-- The re-lookup of a parked next hop (from MAi to MAr)
+class NextHopPoll {
+  public:
+    Ip4Addr     ip4Addr;
+    ap_uint<8>  parkIdx;
+    NextHopPoll() {}
+    NextHopPoll(Ip4Addr ip4Addr, ap_uint<8> parkIdx) :
+        ip4Addr(ip4Addr), parkIdx(parkIdx) {}
+};
+
+//-- The MAC address of the next hop of a packet, or the result of a poll
+class NextHopMeta {
+  public:
+    Ip4Addr     nextHop;
+    EthAddr     macAddr;
+    HitBool     hit;
+    bool        isPoll;
+    ap_uint<8>  parkIdx;
+    NextHopMeta() {}
+    NextHopMeta(Ip4Addr nextHop, EthAddr macAddr, HitBool hit) :
+        nextHop(nextHop), macAddr(macAddr), hit(hit), isPoll(false), parkIdx(0) {}
+    NextHopMeta(ap_uint<8> parkIdx, EthAddr macAddr, HitBool hit) :
+        nextHop(0), macAddr(macAddr), hit(hit), isPoll(true), parkIdx(parkIdx) {}
+};
+
 
 /*******************************************************************************
  *
@@ -124,6 +169,13 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #endif  // HLS_VERSION
 
+#ifndef __SYNTHESIS__
+  void getArpParkStats(unsigned int &nrParked, unsigned int &nrReleased,
+                       unsigned int &nrExpired, unsigned int &nrDropped);
+  void getMacCacheStats(unsigned int &nrHits, unsigned int &nrMisses,
+                        unsigned int &nrFlushes);
+#endif
+
 #endif
 
 /*! \} */
@@ -62,6 +62,11 @@ void stepSim() {
 /*******************************************************************************
  * @brief Emulate the behavior of the Address Resolution Process (ARP).
  *
+ * @details
+ *  Every address of our sub-network is resolved, except 'gDeadHostAddr'. The
+ *  default gateway is only resolved upon its second lookup. The lookups are
+ *  replied in order, 'gArpLkpLatency' cycles after they were received.
+ *
  * @param[in]  siIPTX_LookupReq ARP lookup request from [IPTX].
  * @param[out] soIPTX_LookupRep ARP lookup reply to [IPTX].
  * @param[in]  piMacAddress     The Ethernet MAC address of the FPGA.
@@ -80,19 +85,24 @@ void pEmulateArp(
     const char *myName  = concat3(THIS_NAME, "/", "ARP");
 
     static bool macAddrOfGatewayIsResolved = false;
+    static queue<pair<unsigned int, ArpLkpReply> > lookupsInFlight;
     Ip4Addr     ip4ToMacLkpReq;
 
     if (!siIPTX_LookupReq.empty()) {
         siIPTX_LookupReq.read(ip4ToMacLkpReq);
+        unsigned int dueCycle = gSimCycCnt + gArpLkpLatency;
         if (DEBUG_LEVEL & TRACE_ARP) {
             printIp4Addr(myName, "Received a lookup request from [IPTX] with key = ",
                          ip4ToMacLkpReq);
         }
-        if (ip4ToMacLkpReq == piGatewayAddr) {
+        if (ip4ToMacLkpReq == 0xFFFFFFFF) {
+            lookupsInFlight.push(make_pair(dueCycle, ArpLkpReply(0xFFFFFFFFFFFF, true)));
+        }
+        else if (ip4ToMacLkpReq == piGatewayAddr) {
             // The ARP replies with the MAC address of the default gateway.
             if (macAddrOfGatewayIsResolved) {
                 EthAddr  aComposedMacAddr = 0xFECA00000000 | piGatewayAddr;
-                soIPTX_LookupRep.write(ArpLkpReply(aComposedMacAddr, true));
+                lookupsInFlight.push(make_pair(dueCycle, ArpLkpReply(aComposedMacAddr, true)));
                 if (DEBUG_LEVEL & TRACE_ARP) {
                     printInfo(myName, "MAC lookup = HIT - Replying with MAC = 0x%12.12lX\n",
                               aComposedMacAddr.to_ulong());
@@ -103,15 +113,22 @@ void pEmulateArp(
                 // replies with a 'NO-HIT' while firing an ARP-Request in order
                 // to retrieve the MAC address of the default gateway.
                 EthAddr  aComposedMacAddr = 0xADDE00000000 | piGatewayAddr;
-                soIPTX_LookupRep.write(ArpLkpReply(aComposedMacAddr, false));
+                lookupsInFlight.push(make_pair(dueCycle, ArpLkpReply(aComposedMacAddr, false)));
                 printWarn(myName, "Result of MAC lookup = NO-HIT \n");
                 macAddrOfGatewayIsResolved = true;
             }
         }
+        else if (ip4ToMacLkpReq == gDeadHostAddr) {
+            // This host never replies to the ARP-REQUESTs
+            lookupsInFlight.push(make_pair(dueCycle, ArpLkpReply(0, false)));
+            if (DEBUG_LEVEL & TRACE_ARP) {
+                printInfo(myName, "MAC lookup = NO-HIT - The host is dead.\n");
+            }
+        }
         else if ((ip4ToMacLkpReq & piSubNetMask) == (piGatewayAddr & piSubNetMask)) {
             // The remote IPv4 address falls into our sub-network
             EthAddr  aComposedMacAddr = 0xFECA00000000 | ip4ToMacLkpReq;
-            soIPTX_LookupRep.write(ArpLkpReply(aComposedMacAddr, true));
+            lookupsInFlight.push(make_pair(dueCycle, ArpLkpReply(aComposedMacAddr, true)));
             if (DEBUG_LEVEL & TRACE_ARP) {
                 printInfo(myName, "MAC lookup = HIT - Replying with MAC = 0x%12.12lX\n",
                           aComposedMacAddr.to_ulong());
@@ -121,6 +138,11 @@ void pEmulateArp(
             printWarn(myName, "Result of MAC lookup = NO-HIT \n");
         }
     }
+
+    if (!lookupsInFlight.empty() and (lookupsInFlight.front().first <= gSimCycCnt)) {
+        soIPTX_LookupRep.write(lookupsInFlight.front().second);
+        lookupsInFlight.pop();
+    }
 }
 
 /*******************************************************************************
@@ -132,8 +154,14 @@ void pEmulateArp(
  * @param[in] myIp4Address     the IPv4 address of the FPGA.
  * @param[in] mySubNetMask     The sub-network-mask.
  * @param[in] myGatewayAddr    The default gateway address.
+ * @param[out] nrDeadHostPkts  The number of packets sent to 'gDeadHostAddr'.
  *
  * @return NTS_ OK if successful,  otherwise NTS_KO.
+ *
+ * @warning
+ *  A packet parked upon an ARP miss is expected to come out in the order of
+ *  the input file. This only holds if it is not followed by packets for other
+ *  destinations that overtake it while it is parked.
  *******************************************************************************/
 int createGoldenFile(
         string      inpDAT_FileName,
@@ -141,7 +169,8 @@ int createGoldenFile(
         EthAddr     myMacAddress,
         Ip4Addr     myIp4Address,
         Ip4Addr     mySubNetMask,
-        Ip4Addr     myGatewayAddr)
+        Ip4Addr     myGatewayAddr,
+        int        &nrDeadHostPkts)
 {
     const char *myName  = concat3(THIS_NAME, "/", "CGF");
 
@@ -155,6 +184,8 @@ int createGoldenFile(
     int         inpBytes=0,   outBytes=0;
     bool        macAddrOfGatewayIsResolved = false;
 
+    nrDeadHostPkts = 0;
+
     //-- STEP-1 : OPEN INPUT FILE AND ASSESS ITS EXTENSION
     ifsDAT.open(inpDAT_FileName.c_str());
     if (!ifsDAT) {
@@ -227,7 +258,12 @@ int createGoldenFile(
                 //-------------------------------
                 Ip4Addr ipDA = ipPacket.getIpDestinationAddress();
                 // Create MAC_DA from IP_DA (for testing purposes)
-                if ((ipDA & mySubNetMask) == (myGatewayAddr & mySubNetMask)) {
+                if (ipDA == gDeadHostAddr) {
+                    printWarn(myName, "Packet #%d is sent to a dead host and will be dropped.\n", inpPackets);
+                    nrDeadHostPkts++;
+                    continue;
+                }
+                else if ((ipDA & mySubNetMask) == (myGatewayAddr & mySubNetMask)) {
                     // The remote IPv4 address falls into our sub-network
                     EthAddr  macDaAddr = 0xFECA00000000 | ipDA;
                     ethGoldFrame.setMacDestinAddress(macDaAddr);
@@ -235,8 +271,9 @@ int createGoldenFile(
                 else {
                     // The remote IPv4 address falls out of our sub-network.
                     // The ARP is assumed to reply with the MAC address of the default gateway.
+                    EthAddr  aComposedMacAddr = 0xFECA00000000 | myGatewayAddr;
+                    ethGoldFrame.setMacDestinAddress(aComposedMacAddr);
                     if (macAddrOfGatewayIsResolved) {
-                        EthAddr  aComposedMacAddr = 0xFECA00000000 | myGatewayAddr;
                         if (DEBUG_LEVEL & TRACE_CGF) {
                             printInfo(myName, "Packet with remote IPv4 address to fall out of our sub-network.\n");
                             printInfo(myName, "\tThe IP address of this packet is binded with the MAC address of the default gateway.\n");
@@ -244,12 +281,15 @@ int createGoldenFile(
                     }
                     else {
                         printWarn(myName, "First packet with remote IPv4 address to fall out of our sub-network.\n");
-                        printIp4Addr(myName, "\tThis packet will be dropped. Remote", ipDA);
                         // For the very first occurrence of such an event, the ARP
                         // replies with a 'NO-HIT' while firing an ARP-Request in order to
                         // retrieve the MAC address of the default gateway for the nest time.
                         macAddrOfGatewayIsResolved = true;
-                        continue;
+                        if (not IPTX_ARP_PARK) {
+                            printIp4Addr(myName, "\tThis packet will be dropped. Remote", ipDA);
+                            continue;
+                        }
+                        printIp4Addr(myName, "\tThis packet will be parked until resolved. Remote", ipDA);
                     }
                 }
                 ethGoldFrame.setMacSourceAddress(myMacAddress);
@@ -374,12 +414,19 @@ int main(int argc, char* argv[]) {
     gFatalError   = false;
     gSimCycCnt    = 0;
     gMaxSimCycles = TB_STARTUP_DELAY + TB_MAX_SIM_CYCLES;
+    gDeadHostAddr = 0;
+    gArpLkpLatency = 0;
 
     //------------------------------------------------------
     //-- TESTBENCH LOCAL VARIABLES
     //------------------------------------------------------
     int         nrErr  = 0;
     int         tbRun  = 0;
+    int         nrDeadHostPkts = 0;
+    unsigned int minSimCycles  = 0;
+    unsigned int maxFrameCycles = 0;  // The maximum number of cycles between two frames
+    unsigned int firstFrameCycle = 0, lastFrameCycle = 0;
+    bool         isFrameStart = true;
     EthAddr     myMacAddress  = 0x60504030201;
     Ip4Addr     mySubNetMask  = 0xFFFF0000;   // 255.255.000.0
     Ip4Addr     myIp4Address  = 0x0A0CC807;   //  10.012.200.7
@@ -416,6 +463,20 @@ int main(int argc, char* argv[]) {
         myIp4Address = param;
         printIp4Addr(THIS_NAME, "The input test vector is setting the IP address of the FPGA to", myIp4Address);
     }
+    if (readTbParamFromFile("DeadHostAddr", string(argv[1]), param)) {
+        gDeadHostAddr = param;
+        printIp4Addr(THIS_NAME, "The input test vector is setting the IP address of a dead host to", gDeadHostAddr);
+    }
+    if (readTbParamFromFile("SimCycles", string(argv[1]), param)) {
+        minSimCycles = param;
+    }
+    if (readTbParamFromFile("ArpLkpLatency", string(argv[1]), param)) {
+        gArpLkpLatency = param;
+        printInfo(THIS_NAME, "The input test vector is setting the ARP lookup latency to %d cycles.\n", gArpLkpLatency);
+    }
+    if (readTbParamFromFile("MaxCyclesPerFrame", string(argv[1]), param)) {
+        maxFrameCycles = param;
+    }
 
     //------------------------------------------------------
     //-- CREATE DUT INPUT TRAFFIC AS STREAMS
@@ -460,7 +521,8 @@ int main(int argc, char* argv[]) {
     //-- CREATE OUTPUT GOLD TRAFFIC
     //------------------------------------------------------
     if (not createGoldenFile(string(argv[1]), ofsL2MUX_Gold_FileName,
-                             myMacAddress, myIp4Address, mySubNetMask, myGatewayAddr)) {
+                             myMacAddress, myIp4Address, mySubNetMask, myGatewayAddr,
+                             nrDeadHostPkts)) {
         printError(THIS_NAME, "Failed to create golden file. \n");
         nrErr++;
     }
@@ -475,6 +537,9 @@ int main(int argc, char* argv[]) {
     printf("\n\n");
 
     tbRun = (nrErr == 0) ? (nrL3MUX_IPTX_Chunks + TB_GRACE_TIME) : 0;
+    if (tbRun and (tbRun < minSimCycles)) {
+        tbRun = minSimCycles;
+    }
 
     while (tbRun) {
         //-- RUN DUT --------------------------------------
@@ -519,6 +584,13 @@ int main(int argc, char* argv[]) {
             else {
                 nrIPTX_L2MUX_Chunks++;
                 nrIPTX_L2MUX_Bytes  += axisEth.getLen();
+                if (isFrameStart) {
+                    if (nrIPTX_L2MUX_Frames == 0) {
+                        firstFrameCycle = gSimCycCnt;
+                    }
+                    lastFrameCycle = gSimCycCnt;
+                }
+                isFrameStart = axisEth.getLE_TLast();
                 if (axisEth.getLE_TLast()) {
                     nrIPTX_L2MUX_Frames++;
                 }
@@ -550,6 +622,45 @@ int main(int argc, char* argv[]) {
         nrErr += 1;
     }
 
+    //---------------------------------------------------------------
+    //-- ASSESS THE PENDING PACKETS
+    //--  Every parked packet must have been released or expired, and
+    //--  the packets sent to the dead host must have expired.
+    //---------------------------------------------------------------
+    unsigned int nrParked, nrReleased, nrExpired, nrDropped;
+    getArpParkStats(nrParked, nrReleased, nrExpired, nrDropped);
+    printInfo(THIS_NAME, "Pending packets: parked=%d, released=%d, expired=%d, dropped=%d.\n",
+              nrParked, nrReleased, nrExpired, nrDropped);
+    if (nrParked != (nrReleased + nrExpired)) {
+        printError(THIS_NAME, "%d parked packet(s) were neither released nor expired.\n",
+                   nrParked - nrReleased - nrExpired);
+        nrErr += 1;
+    }
+    if (IPTX_ARP_PARK and (nrExpired != (unsigned int)nrDeadHostPkts)) {
+        printError(THIS_NAME, "Expected %d packet(s) to expire but %d did.\n",
+                   nrDeadHostPkts, nrExpired);
+        nrErr += 1;
+    }
+
+    //---------------------------------------------------------------
+    //-- ASSESS THE THROUGHPUT
+    //--  The frames must come out back-to-back no matter the latency of
+    //--  the ARP, as long as their next hops are cached.
+    //---------------------------------------------------------------
+    unsigned int nrHits, nrMisses, nrFlushes;
+    getMacCacheStats(nrHits, nrMisses, nrFlushes);
+    printInfo(THIS_NAME, "Next-hop MAC cache: hits=%d, misses=%d, flushes=%d.\n",
+              nrHits, nrMisses, nrFlushes);
+    if (maxFrameCycles and (nrIPTX_L2MUX_Frames > 1)) {
+        float cyclesPerFrame = (float)(lastFrameCycle - firstFrameCycle) / (nrIPTX_L2MUX_Frames - 1);
+        printInfo(THIS_NAME, "Sent %d frames at %.2f cycles per frame.\n",
+                  nrIPTX_L2MUX_Frames, cyclesPerFrame);
+        if (cyclesPerFrame > maxFrameCycles) {
+            printError(THIS_NAME, "Expected at most %d cycles per frame.\n", maxFrameCycles);
+            nrErr += 1;
+        }
+    }
+
     //---------------------------------------------------------------
     //-- PRINT TESTBENCH STATUS
     //---------------------------------------------------------------
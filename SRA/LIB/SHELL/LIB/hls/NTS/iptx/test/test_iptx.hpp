@@ -30,6 +30,8 @@
 #ifndef _TEST_IPTX_H_
 #define _TEST_IPTX_H_
 
+#include <queue>
+
 #include "../src/iptx.hpp"
 #include "../../../NTS/nts_types.hpp"
 #include "../../../NTS/nts_utils.hpp"
@@ -54,6 +56,8 @@ bool            gTraceEvent;
 bool            gFatalError;
 unsigned int    gSimCycCnt;
 unsigned int    gMaxSimCycles;
+Ip4Addr         gDeadHostAddr;  // A host that never answers the ARP-REQUESTs
+unsigned int    gArpLkpLatency; // The number of cycles it takes the ARP to reply to a lookup
 
 #endif
 
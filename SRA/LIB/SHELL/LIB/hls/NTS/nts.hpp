@@ -210,6 +210,12 @@ typedef RepBool     TcpAppLsnRep;
 //---------------------------------------------------------
 //-- UDP APP - DATA
 //--  The data section of an UDP datagram over an AXI4S I/F.
+//--  On the Rx side, the 'Meta' and the 'DLen' of a datagram
+//--   are always delivered ahead of its data. If the UOE runs
+//--   in cut-through mode (see UOE_RX_CUT_THROUGH), a datagram
+//--   with a wrong checksum ends with a chunk that has 'tlast'
+//--   set and all its 'tkeep' bits cleared, and the data that
+//--   were received for that datagram must be discarded.
 //---------------------------------------------------------
 typedef AxisRaw     UdpAppData;
 
@@ -62,6 +62,78 @@ static const uint16_t MTU = 1500;
 //--------------------------------------------------------------------
 static const uint16_t MTU_ZYC2 = 1450;
 
+//--------------------------------------------------------------------
+//-- ARP - PENDING PACKETS OF THE IPTX (see 'iptx.cpp')
+//--  FYI: An IPv4 packet whose next-hop MAC address is not yet known
+//--   is parked in IPTX while the ARP resolves it, instead of being
+//--   dropped. Up to IPTX_ARP_PARK_PKTS packets are held for each of
+//--   IPTX_ARP_PARK_DSTS destinations. They are released as soon as a
+//--   re-lookup (every IPTX_ARP_POLL_US) hits, and are dropped if the
+//--   resolution takes longer than IPTX_ARP_PARK_MAX_US. Override with
+//--   '-DIPTX_ARP_PARK=0' to drop a packet upon an ARP miss.
+//--------------------------------------------------------------------
+#ifndef IPTX_ARP_PARK
+  #define             IPTX_ARP_PARK         1
+#endif
+#ifndef IPTX_ARP_PARK_DSTS
+  #define             IPTX_ARP_PARK_DSTS    4
+#endif
+#ifndef IPTX_ARP_PARK_PKTS
+  #define             IPTX_ARP_PARK_PKTS    2
+#endif
+#ifndef IPTX_ARP_POLL_US
+  #define             IPTX_ARP_POLL_US      1
+#endif
+#ifndef IPTX_ARP_PARK_MAX_US
+  #define             IPTX_ARP_PARK_MAX_US  1000
+#endif
+
+//--------------------------------------------------------------------
+//-- ARP - RETRANSMISSION OF THE ARP-REQUESTS (see 'arp.cpp')
+//--  FYI: An ARP-REQUEST is fired upon a lookup miss, but not more than
+//--   once every ARP_REQ_RETRY_US for the same IPv4 address, no matter
+//--   how often the IPTX looks it up while it is pending.
+//--------------------------------------------------------------------
+#ifndef ARP_REQ_RETRY_US
+  #define             ARP_REQ_RETRY_US      250
+#endif
+
+//--------------------------------------------------------------------
+//-- ARP - NEXT-HOP MAC CACHE OF THE IPTX (see 'iptx.cpp')
+//--  FYI: The IPTX keeps the last IPTX_MAC_CACHE_ENTRIES resolved next
+//--   hops and only looks up the ARP upon a cache miss. Up to
+//--   ARP_LKP_IN_FLIGHT lookups can be outstanding in the ARP. The cache
+//--   is flushed whenever the ARP reports that its CAM was updated, and
+//--   the IPTX probes the ARP for such updates every IPTX_MAC_CACHE_
+//--   PROBE_US. Override with '-DIPTX_MAC_CACHE_ENTRIES=0' to look up
+//--   every outgoing packet.
+//--------------------------------------------------------------------
+#ifndef IPTX_MAC_CACHE_ENTRIES
+  #define             IPTX_MAC_CACHE_ENTRIES    8
+#endif
+#ifndef IPTX_MAC_CACHE_PROBE_US
+  #define             IPTX_MAC_CACHE_PROBE_US   1
+#endif
+#ifndef ARP_LKP_IN_FLIGHT
+  #define             ARP_LKP_IN_FLIGHT         4
+#endif
+
+//--------------------------------------------------------------------
+//-- ARP - AGING OF THE BINDINGS (see 'arp.cpp')
+//--  FYI: A binding that was not confirmed by an incoming ARP packet
+//--   for ARP_REFRESH_S seconds is refreshed in the background with a
+//--   broadcast ARP-REQUEST, so that it keeps hitting the CAM while its
+//--   owner is alive. It is removed from the CAM when it was not
+//--   confirmed for ARP_ENTRY_TTL_S seconds. A gratuitous ARP updates a
+//--   binding immediately.
+//--------------------------------------------------------------------
+#ifndef ARP_ENTRY_TTL_S
+  #define             ARP_ENTRY_TTL_S          60
+#endif
+#ifndef ARP_REFRESH_S
+  #define             ARP_REFRESH_S            50
+#endif
+
 
 /*******************************************************************************
  * CONFIGURATION - TRANSPORT LAYER-4 - TCP
@@ -82,13 +154,64 @@ static const uint16_t ZYC2_MSS  = (MTU_ZYC2-92) & ~0x7; // 1358 & ~0x7 = 1352
 //------------------------------------------------------------------
 //-- TCP OFFLOAD ENGINE - CONFIGURATION PARAMETERS
 //------------------------------------------------------------------
-static const uint16_t TOE_MAX_SESSIONS    = 8; // The number of session you want to support (Max. is 10.000)
+//-- The number of sessions you want to support (Max. is 1GB/TOE_BUFFER_SIZE)
+//--  FYI: The tables of the TOE are indexed by the session ID and scale with
+//--   this number. The session IDs of the RTL-based CAM are 14-bit wide, which
+//--   limits this number to 16384. The 1GB of a buffer memory further limits it
+//--   to 4096 sessions with the default 256KB windows in DDR (see the check of
+//--   TOE_SESS_ADDR_BITS). Override with '-DTOE_NR_SESSIONS=<NUM>'.
+#ifndef TOE_NR_SESSIONS
+  #define             TOE_NR_SESSIONS       8
+#endif
+static const uint32_t TOE_MAX_SESSIONS    = TOE_NR_SESSIONS;
+
+//-- The memory holding the Rx and Tx buffers of the TOE (see 'onchip_buffer.hpp')
+//--  FYI: By default, the buffers are stored in DDR. An on-chip buffer pool in
+//--   BRAM or URAM removes the DDR round trip but it shrinks the buffer of every
+//--   session to 2^TOE_ONCHIP_WINDOW_BITS bytes. Override with
+//--   '-DTOE_BUFFER_MEMORY=TOE_BUFFER_BRAM' or 'TOE_BUFFER_URAM'.
+#define               TOE_BUFFER_DDR        0 // External DDR via the data movers of [MEM]
+#define               TOE_BUFFER_BRAM       1 // On-chip block RAM
+#define               TOE_BUFFER_URAM       2 // On-chip UltraRAM (UltraScale+ only)
+#ifndef TOE_BUFFER_MEMORY
+  #define             TOE_BUFFER_MEMORY     TOE_BUFFER_DDR
+#endif
+#ifndef TOE_ONCHIP_WINDOW_BITS
+  #define             TOE_ONCHIP_WINDOW_BITS 14 // 16KB per session and per direction
+#endif
+#ifndef TOE_DDR_WINDOW_BITS
+  #define             TOE_DDR_WINDOW_BITS   18 // 256KB per session and per direction
+#endif
+
+//-- The page-based allocation of the TCP buffers in DDR (see 'page_allocator.hpp')
+//--  FYI: The window of a session is mapped onto pages of 2^TOE_DDR_PAGE_BITS
+//--   bytes that are allocated on demand from a pool shared by all sessions.
+//--   An idle session holds a single page per direction, which allows for
+//--   multi-MB windows (e.g. '-DTOE_DDR_WINDOW_BITS=22'). The page size must
+//--   be larger than the largest memory access (64KB) and smaller than the
+//--   window. Override with '-DTOE_BUFFER_PAGING=0' to get fixed DDR slots.
+#ifndef TOE_BUFFER_PAGING
+  #define             TOE_BUFFER_PAGING     1
+#endif
+#ifndef TOE_DDR_PAGE_BITS
+  #define             TOE_DDR_PAGE_BITS     16 // 64KB
+#endif
+#define               TOE_PAGED_BUFFERS     ((TOE_BUFFER_MEMORY == TOE_BUFFER_DDR) && (TOE_BUFFER_PAGING))
+
+static const uint16_t TOE_WINDOW_BITS     = (TOE_BUFFER_MEMORY == TOE_BUFFER_DDR) ? TOE_DDR_WINDOW_BITS : TOE_ONCHIP_WINDOW_BITS;
+
+//-- A TCP buffer is accessed with memory commands that never cross a page
+//--  boundary. Without paging, a page spans the entire window of a session.
+static const uint16_t TOE_PAGE_BITS       = (TOE_PAGED_BUFFERS) ? TOE_DDR_PAGE_BITS : TOE_WINDOW_BITS;
+static const uint32_t TOE_PAGE_SIZE       = (1 << TOE_PAGE_BITS);
 
-static const uint16_t TOE_WINDOW_BITS     = 16;
+static const uint32_t TOE_BUFFER_SIZE     = (1 << TOE_WINDOW_BITS); // 262144
+static const uint32_t TOE_RX_BUFFER_SIZE  = TOE_BUFFER_SIZE; // 262144
+static const uint32_t TOE_TX_BUFFER_SIZE  = TOE_BUFFER_SIZE; // 262144
 
-static const uint32_t TOE_BUFFER_SIZE     = (1 << TOE_WINDOW_BITS); // 65536
-static const uint32_t TOE_RX_BUFFER_SIZE  = TOE_BUFFER_SIZE; // 65536
-static const uint32_t TOE_TX_BUFFER_SIZE  = TOE_BUFFER_SIZE; // 65536
+//-- The shift count advertised with the Window Scale option (RFC-7323)
+//--  FYI: The 16-bit window field must be able to cover a whole buffer.
+static const uint16_t TOE_WINDOW_SCALE    = (TOE_WINDOW_BITS > 16) ? (TOE_WINDOW_BITS - 16) : 0; // 2
 
 #define               TOE_MEMORY_SIZE       0x80000000 // 2GB
 #define               TOE_MEMORY_BASE       0x00000000 // Base address
@@ -100,8 +223,91 @@ static const uint64_t TOE_RX_MEMORY_BASE = (TOE_MEMORY_BASE);
 static const uint64_t TOE_TX_MEMORY_BASE = (TOE_MEMORY_SIZE+TOE_RX_MEMORY_SIZE); // 0x40000000 (Base+1GB)
 static const uint16_t TOE_RX_MEMORY_BITS  = log2ceil(TOE_RX_MEMORY_SIZE); // 1GB = 2^30
 static const uint16_t TOE_TX_MEMORY_BITS  = log2ceil(TOE_TX_MEMORY_SIZE); // 1GB = 2^30
+static const uint16_t TOE_SESS_ADDR_BITS  = 30 - TOE_WINDOW_BITS; // 1GB/256KB = 2^12 session buffers
 
-static const unsigned TOE_MAX_CONGESTION_WINDOW = (TOE_BUFFER_SIZE - 2048); // 0xF7FF
+//-- Every session must get a buffer of its own in the 1GB of a path. Otherwise,
+//--  the session IDs above 2^TOE_SESS_ADDR_BITS would alias onto the buffers of
+//--  the lower ones. This fails to compile when TOE_NR_SESSIONS is too large for
+//--  the window (e.g. use '-DTOE_DDR_WINDOW_BITS=16' for 16384 sessions).
+typedef char TOE_NR_SESSIONS_exceeds_buffer_memory[(TOE_MAX_SESSIONS <= (1u << TOE_SESS_ADDR_BITS)) ? 1 : -1];
+
+static const unsigned TOE_MAX_CONGESTION_WINDOW = (TOE_BUFFER_SIZE - 2048); // 0x3F7FF
+static const unsigned TOE_INIT_CONGESTION_WINDOW = (0x3908 < TOE_MAX_CONGESTION_WINDOW) ? 0x3908 : TOE_MAX_CONGESTION_WINDOW; // 10 x 1460 (RFC-6928)
+
+//-- The congestion control algorithm of the TOE (see 'congestion_control.hpp')
+//--  FYI: Override with '-DTOE_CC_ALGORITHM=TOE_CC_CUBIC' or 'TOE_CC_DCTCP'.
+#define               TOE_CC_RENO           0 // Reno with appropriate byte counting (RFC-5681, RFC-3465)
+#define               TOE_CC_CUBIC          1 // CUBIC (RFC-8312)
+#define               TOE_CC_DCTCP          2 // Data Center TCP (RFC-8257)
+#ifndef TOE_CC_ALGORITHM
+  #define             TOE_CC_ALGORITHM      TOE_CC_RENO
+#endif
+
+//-- ECN (RFC-3168) is negotiated only when the congestion control reacts to it
+#define               TOE_ECN               (TOE_CC_ALGORITHM == TOE_CC_DCTCP)
+
+//-- The lower bound of the retransmission timeout in microseconds (RFC-6298)
+//--  FYI: RFC-6298 recommends 1s, which is far too long for the RTTs of a
+//--   datacenter fabric. Override with '-DTOE_MIN_RTO_US=<NUM>'.
+//--  FYI: In C-simulation, the floor is set in timer ticks with
+//--   '-DTOE_SIM_MIN_RTO_TICKS=<NUM>' and the length of a second with
+//--   '-DTOE_SIM_TIME_1S_TICKS=<NUM>' (see 'toe.hpp').
+#ifndef TOE_MIN_RTO_US
+  #define             TOE_MIN_RTO_US        200
+#endif
+
+//-- The DDR bypass of the small APP messages (a.k.a. TCP_NODELAY)
+//--  FYI: When enabled, a message that fits into a single segment is also
+//--   streamed straight to the TxEngine and is sent without waiting for its
+//--   round trip to the Tx buffer in DDR. Override with '-DTOE_TCP_NODELAY=0'.
+#ifndef TOE_TCP_NODELAY
+  #define             TOE_TCP_NODELAY       1
+#endif
+
+//-- The size of the checksum cells of the Tx buffers (see 'tx_engine.cpp')
+//--  FYI: The TxAppInterface sums the APP data of every cell of 2^TOE_CSUM_CELL_BITS
+//--   bytes while it writes them into the Tx buffer, such that the TxEngine
+//--   only has to sum the partial cells at the edges of a segment. A smaller
+//--   cell shortens these edges, but the table of the cell sums costs 16 bits
+//--   per cell of every session (.i.e, 32Kb per 256KB of Tx buffer).
+#ifndef TOE_CSUM_CELL_BITS
+  #define             TOE_CSUM_CELL_BITS    7 // 128B
+#endif
+
+//-- The number of events that the EventEngine keeps in flight towards the TxEngine
+//--  FYI: A larger number keeps the TxEngine busy with back-to-back events,
+//--   but it also delays the ACK and the control events that get queued
+//--   behind them. Override with '-DTOE_EVE_IN_FLIGHT=1' to get one Tx event
+//--   at a time (see 'event_engine.cpp').
+#ifndef TOE_EVE_IN_FLIGHT
+  #define             TOE_EVE_IN_FLIGHT     4
+#endif
+
+//-- The delayed ACK policy of the AckDelayer (RFC-1122, RFC-5681)
+//--  FYI: An ACK is sent after every TOE_ACKD_SEGS full-sized segments or once
+//--   the oldest unacknowledged segment is TOE_ACKD_MAX_US microseconds old,
+//--   whichever comes first. Out-of-order and PSH segments are acknowledged
+//--   without delay (see 'ack_delay.cpp').
+#ifndef TOE_ACKD_SEGS
+  #define             TOE_ACKD_SEGS         2
+#endif
+#ifndef TOE_ACKD_MAX_US
+  #define             TOE_ACKD_MAX_US       64
+#endif
+
+//-- The SYN cookies of the RxEngine (RFC-4987)
+//--  FYI: When enabled, a SYN does not allocate any session. It is answered by
+//--   a stateless SYN_ACK whose ISN encodes the TCP options of the SYN and a
+//--   keyed hash. The session is only created once the final ACK returns a
+//--   valid cookie (see 'rx_engine.cpp'). The key is not part of the design;
+//--   it is seeded at runtime from the traffic received after reset. Override
+//--   with '-DTOE_SYN_COOKIES=0' to allocate a session upon every SYN.
+#ifndef TOE_SYN_COOKIES
+  #define             TOE_SYN_COOKIES       1
+#endif
+
+static const uint16_t TOE_OOO_BLOCKS      = 4; // The number of out-of-order intervals tracked per session (Max. is 15)
+static const uint16_t TOE_SACK_BLOCKS     = 4; // The number of SACK blocks sent and tracked per session (Max. is 4)
 
 /*******************************************************************************
  * CONFIGURATION - TRANSPORT LAYER-4 - UDP
@@ -110,6 +316,52 @@ static const unsigned TOE_MAX_CONGESTION_WINDOW = (TOE_BUFFER_SIZE - 2048); // 0
  * transport layer-4 of the NTS.
  *******************************************************************************/
 
+//--------------------------------------------------------------------
+//-- UDP - REASSEMBLY OF THE IPV4 FRAGMENTS (see 'uoe.cpp')
+//--  FYI: The IPRX forwards the fragments of the UDP datagrams to the
+//--   UOE which rebuilds them in UOE_REASM_CONTEXTS buffers of 64KB of
+//--   on-chip BRAM. A context that is not complete after
+//--   UOE_REASM_TIMEOUT_MS is freed, and a fragment is dropped when all
+//--   the contexts are busy (Max. is 16). Override with
+//--   '-DUOE_IP_REASM=0' to drop all the fragments in IPRX.
+//--------------------------------------------------------------------
+#ifndef UOE_IP_REASM
+  #define             UOE_IP_REASM          1
+#endif
+#ifndef UOE_REASM_CONTEXTS
+  #define             UOE_REASM_CONTEXTS    4
+#endif
+#ifndef UOE_REASM_TIMEOUT_MS
+  #define             UOE_REASM_TIMEOUT_MS  100
+#endif
+
+//--------------------------------------------------------------------
+//-- UDP - FRAGMENTATION OF THE OUTGOING DATAGRAMS (see 'uoe.cpp')
+//--  FYI: By default, the UOE splits a datagram of the application into
+//--   as many UDP datagrams of UDP_MDS bytes as needed. When enabled, it
+//--   is sent as a single UDP datagram of up to 64KB which is carried by
+//--   as many IPv4 fragments as needed. This adds a 64KB store-and-forward
+//--   buffer to the Tx path of the UOE. Override with '-DUOE_IP_FRAG=1'.
+//--------------------------------------------------------------------
+#ifndef UOE_IP_FRAG
+  #define             UOE_IP_FRAG           0
+#endif
+
+//--------------------------------------------------------------------
+//-- UDP - CUT-THROUGH RECEIVE PATH (see 'uoe.cpp')
+//--  FYI: By default, the UOE holds a received datagram until its UDP
+//--   checksum is verified. When enabled, the payload is forwarded to
+//--   the application as soon as the destination port is known. The
+//--   metadata and the length still come first, but a datagram with a
+//--   wrong checksum is aborted with a last chunk that has 'tlast' set
+//--   and all its 'tkeep' bits cleared. A role must then discard the
+//--   payload it received for that datagram. Override with
+//--   '-DUOE_RX_CUT_THROUGH=1'.
+//--------------------------------------------------------------------
+#ifndef UOE_RX_CUT_THROUGH
+  #define             UOE_RX_CUT_THROUGH    0
+#endif
+
 
 #endif
 
@@ -0,0 +1,183 @@
+/*
+ * Copyright 2016 -- 2021 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*******************************************************************************
+ * @file     : nts_csum.hpp
+ * @brief    : The one's complement checksum library of the Network Transport
+ *             Stack (NTS).
+ *
+ * System:   : cloudFPGA
+ * Component : Shell
+ * Language  : Vivado HLS
+ *
+ * @details
+ *  The Internet checksum (RFC-1071) is the one's complement of the one's
+ *  complement sum of the 16-bit words of a message. Because that sum is
+ *  commutative and associative, and because 2^16 = 1 (modulo 0xFFFF), the
+ *  carries of a one's complement sum do not need to be folded back after every
+ *  addition. The helpers below therefore accumulate the words of a chunk with
+ *  a balanced tree of plain adders and keep the carries in the upper bits of a
+ *  32-bit accumulator ('CsumAcc'). The carries are folded only once, when the
+ *  final 16-bit checksum is requested.
+ *  All the helpers are width-generic and work on any 'AxisRawT<W>' chunk.
+ *
+ * \ingroup NTS
+ * \addtogroup NTS
+ * \{
+ *******************************************************************************/
+
+#ifndef _NTS_CSUM_H_
+#define _NTS_CSUM_H_
+
+#include "AxisRaw.hpp"
+
+/*******************************************************************************
+ * CHECKSUM - TYPE DEFINITIONS
+ *******************************************************************************/
+typedef ap_uint<32> CsumAcc;  // A one's complement sum with deferred carries
+typedef ap_uint<16> Csum;     // A folded 16-bit one's complement sum
+
+/*******************************************************************************
+ * @brief Add two partial sums with an end-around carry at bit 32.
+ *
+ * @param[in] acc  A partial sum.
+ * @param[in] add  Another partial sum.
+ * @return the one's complement sum of the two partial sums.
+ *******************************************************************************/
+inline CsumAcc csumAdd(CsumAcc acc, CsumAcc add) {
+    #pragma HLS INLINE
+    ap_uint<33> sum   = acc + add;
+    CsumAcc     low   = sum.range(31, 0);
+    CsumAcc     carry = sum[32];
+    return low + carry;
+}
+
+/*******************************************************************************
+ * @brief Fold a partial sum into a 16-bit one's complement sum.
+ *
+ * @param[in] acc  The partial sum to fold.
+ *******************************************************************************/
+inline Csum csumFold(CsumAcc acc) {
+    #pragma HLS INLINE
+    ap_uint<16> lo  = acc.range(15,  0);
+    ap_uint<16> hi  = acc.range(31, 16);
+    ap_uint<17> sum = lo + hi;
+    lo  = sum.range(15, 0);
+    hi  = sum[16];
+    sum = lo + hi;
+    return sum.range(15, 0);
+}
+
+/*******************************************************************************
+ * @brief Return the Internet checksum (.i.e the complemented and folded sum)
+ *  of a partial sum.
+ *******************************************************************************/
+inline Csum csumFinalize(CsumAcc acc) {
+    #pragma HLS INLINE
+    Csum sum = csumFold(acc);
+    return ~sum;
+}
+
+/*******************************************************************************
+ * @brief Sum the 16-bit words of a chunk.
+ *
+ * @param[in] chunk  The chunk to sum. Its bytes with a cleared 'tkeep' bit are
+ *                    considered as zero.
+ * @return the partial sum of the chunk.
+ *
+ * @details
+ *  The W/16 Big-Endian words of the chunk are added with a balanced adder tree
+ *  of depth log2(W/16). The carries are kept in the upper bits of the sum.
+ *  The first byte of the chunk is the most significant byte of its first word,
+ *  which implies that every chunk but the last one of a message must hold an
+ *  even number of bytes.
+ *******************************************************************************/
+template<int W>
+CsumAcc csumChunk(AxisRawT<W> chunk) {
+    #pragma HLS INLINE
+    CsumAcc sums[W/16];
+    #pragma HLS ARRAY_PARTITION variable=sums complete dim=1
+
+    chunk.clearUnusedBytes();
+    for (int i=0; i<W/16; i++) {
+    #pragma HLS UNROLL
+        sums[i] = chunk.template getBeField<2>(2*i);
+    }
+    for (int n=W/32; n>0; n/=2) {
+    #pragma HLS UNROLL
+        for (int i=0; i<n; i++) {
+        #pragma HLS UNROLL
+            sums[i] = sums[2*i] + sums[2*i+1];
+        }
+    }
+    return sums[0];
+}
+
+/*******************************************************************************
+ * @brief Accumulate a chunk into a partial sum.
+ *
+ * @param[in] acc    The partial sum of the previous chunks.
+ * @param[in] chunk  The chunk to accumulate.
+ *******************************************************************************/
+template<int W>
+CsumAcc csumAccumulate(CsumAcc acc, AxisRawT<W> chunk) {
+    #pragma HLS INLINE
+    return csumAdd(acc, csumChunk<W>(chunk));
+}
+
+/*******************************************************************************
+ * @brief Incremental update of a checksum after the rewrite of a 16-bit word
+ *  (see RFC-1624, Eqn. 3):  HC' = ~(~HC + ~m + m')
+ *
+ * @param[in] oldCsum  The checksum before the rewrite (HC).
+ * @param[in] oldWord  The old value of the word (m).
+ * @param[in] newWord  The new value of the word (m').
+ * @return the new checksum (HC').
+ *******************************************************************************/
+inline Csum csumUpdate16(Csum oldCsum, ap_uint<16> oldWord, ap_uint<16> newWord) {
+    #pragma HLS INLINE
+    CsumAcc acc = Csum(~oldCsum);
+    acc += Csum(~oldWord);
+    acc += newWord;
+    return csumFinalize(acc);
+}
+
+/*******************************************************************************
+ * @brief Incremental update of a checksum after the rewrite of a 32-bit field
+ *  such as an IPv4 address or a TCP sequence number (see RFC-1624).
+ *
+ * @param[in] oldCsum   The checksum before the rewrite.
+ * @param[in] oldField  The old value of the field.
+ * @param[in] newField  The new value of the field.
+ * @return the new checksum.
+ *******************************************************************************/
+inline Csum csumUpdate32(Csum oldCsum, ap_uint<32> oldField, ap_uint<32> newField) {
+    #pragma HLS INLINE
+    Csum    oldHi = oldField.range(31, 16);
+    Csum    oldLo = oldField.range(15,  0);
+    Csum    newHi = newField.range(31, 16);
+    Csum    newLo = newField.range(15,  0);
+    CsumAcc acc   = Csum(~oldCsum);
+    acc += Csum(~oldHi);
+    acc += Csum(~oldLo);
+    acc += newHi;
+    acc += newLo;
+    return csumFinalize(acc);
+}
+
+#endif
+
+/*! \} */
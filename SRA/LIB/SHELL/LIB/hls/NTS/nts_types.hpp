@@ -345,14 +345,19 @@ typedef Ip4Addr ArpLkpRequest;
 
 //---------------------------------------------------------
 //-- ARPCAM - LOOKUP REPLY
+//--  The epoch is incremented by the ARP upon every update of
+//--  its CAM. It fills the spare bits of the reply (48+1+7).
 //---------------------------------------------------------
+typedef ap_uint<7> ArpEpoch;
+
 class ArpLkpReply {
   public:
     EthAddr     macAddress;
     HitBool     hit;
+    ArpEpoch    epoch;
     ArpLkpReply() {}
-    ArpLkpReply(EthAddr macAdd, HitBool hit) :
-        macAddress(macAdd), hit(hit) {}
+    ArpLkpReply(EthAddr macAdd, HitBool hit, ArpEpoch epoch=0) :
+        macAddress(macAdd), hit(hit), epoch(epoch) {}
 };
 
 
@@ -33,6 +33,7 @@
 
 #include "../MEM/mem.hpp"
 #include "../NTS/nts.hpp"
+#include "../NTS/nts_csum.hpp"
 
 using namespace std;
 
@@ -72,32 +72,45 @@ puts "####                                                     ####"
 puts "#############################################################"
 
 
+# Add the files of the current project
+#  FYI: 'cflags' passes compile-time options (see 'nts_config.hpp') to the
+#   design and to its testbench (e.g. "-DTOE_NR_SESSIONS=1024").
+#-------------------------------------------------
+proc addToeFiles { cflags } {
+    global srcDir testDir currDir projectName HLS_VERSION
+
+    add_files     ${srcDir}/${projectName}.cpp -cflags "-DHLS_VERSION=${HLS_VERSION} ${cflags}"
+    add_files     ${srcDir}/toe_utils.cpp -cflags "${cflags}"
+    add_files     ${currDir}/../../NTS/nts_utils.cpp -cflags "${cflags}"
+    #
+    add_files     ${srcDir}/ack_delay/src/ack_delay.cpp -cflags "${cflags}"
+    add_files     ${srcDir}/congestion_control/src/congestion_control.cpp -cflags "${cflags}"
+    add_files     ${srcDir}/event_engine/event_engine.cpp -cflags "${cflags}"
+    add_files     ${srcDir}/onchip_buffer/src/onchip_buffer.cpp -cflags "${cflags}"
+    add_files     ${srcDir}/page_allocator/src/page_allocator.cpp -cflags "${cflags}"
+    add_files     ${srcDir}/port_table/port_table.cpp -cflags "${cflags}"
+    add_files     ${srcDir}/rx_app_interface/rx_app_interface.cpp -cflags "${cflags}"
+    add_files     ${srcDir}/rx_engine/src/rx_engine.cpp -cflags "${cflags}"
+    add_files     ${srcDir}/rx_sar_table/rx_sar_table.cpp -cflags "${cflags}"
+    add_files     ${srcDir}/session_lookup_controller/session_lookup_controller.cpp -cflags "${cflags}"
+    add_files     ${srcDir}/state_table/state_table.cpp -cflags "${cflags}"
+    add_files     ${srcDir}/timers/timers.cpp -cflags "${cflags}"
+    add_files     ${srcDir}/tx_app_interface/tx_app_interface.cpp -cflags "${cflags}"
+    add_files     ${srcDir}/tx_engine/src/tx_engine.cpp -cflags "${cflags}"
+    add_files     ${srcDir}/tx_sar_table/tx_sar_table.cpp -cflags "${cflags}"
+
+    add_files -tb ${testDir}/test_${projectName}.cpp -cflags "-DHLS_VERSION=${HLS_VERSION} -fstack-check ${cflags}"
+    add_files -tb ${currDir}/../../NTS/SimNtsUtils.cpp -cflags "${cflags}"
+    add_files -tb ${currDir}/test/dummy_memory/dummy_memory.cpp -cflags "${cflags}"
+}
+
 # Open and Setup Project
 #-------------------------------------------------
 open_project  ${projectName}_prj
 
 # Add files
 #-------------------------------------------------
-add_files     ${srcDir}/${projectName}.cpp -cflags "-DHLS_VERSION=${HLS_VERSION}"
-add_files     ${srcDir}/toe_utils.cpp
-add_files     ${currDir}/../../NTS/nts_utils.cpp
-#
-add_files     ${srcDir}/ack_delay/src/ack_delay.cpp
-add_files     ${srcDir}/event_engine/event_engine.cpp
-add_files     ${srcDir}/port_table/port_table.cpp
-add_files     ${srcDir}/rx_app_interface/rx_app_interface.cpp
-add_files     ${srcDir}/rx_engine/src/rx_engine.cpp
-add_files     ${srcDir}/rx_sar_table/rx_sar_table.cpp
-add_files     ${srcDir}/session_lookup_controller/session_lookup_controller.cpp
-add_files     ${srcDir}/state_table/state_table.cpp
-add_files     ${srcDir}/timers/timers.cpp
-add_files     ${srcDir}/tx_app_interface/tx_app_interface.cpp
-add_files     ${srcDir}/tx_engine/src/tx_engine.cpp
-add_files     ${srcDir}/tx_sar_table/tx_sar_table.cpp
-
-add_files -tb ${testDir}/test_${projectName}.cpp -cflags "-DHLS_VERSION=${HLS_VERSION} -fstack-check"
-add_files -tb ${currDir}/../../NTS/SimNtsUtils.cpp
-add_files -tb ${currDir}/test/dummy_memory/dummy_memory.cpp
+addToeFiles ""
 
 # Set toplevel
 #-------------------------------------------------
@@ -188,12 +201,17 @@ if { $hlsCSim} {
     csim_design -argv "0 ../../../../test/testVectors/siIPRX_FivePkt.dat"
     csim_design -argv "0 ../../../../test/testVectors/siIPRX_Ramp64.dat"
     csim_design -argv "0 ../../../../test/testVectors/siIPRX_TwentyPkt.dat"
+    csim_design -argv "0 ../../../../test/testVectors/siIPRX_RxLatency.dat"
     csim_design -argv "0 ../../../../test/testVectors/siIPRX_ThousandPkt.dat"
     csim_design -argv "0 ../../../../test/testVectors/siIPRX_ThousandPkt2.dat"
     csim_design -argv "0 ../../../../test/testVectors/siIPRX_SynAckPkt.dat"
     csim_design -argv "0 ../../../../test/testVectors/siIPRX_TcpDuplicate.dat"
     csim_design -argv "0 ../../../../test/testVectors/siIPRX_TcpOutOfOrder1.dat"
     csim_design -argv "0 ../../../../test/testVectors/siIPRX_TcpOutOfOrder2.dat"
+    csim_design -argv "0 ../../../../test/testVectors/siIPRX_TcpOutOfOrder3.dat"
+    csim_design -argv "0 ../../../../test/testVectors/siIPRX_TcpOooGoodput.dat"
+    csim_design -argv "0 ../../../../test/testVectors/siIPRX_WrapStress.dat"
+    csim_design -argv "0 ../../../../test/testVectors/siIPRX_SynStorm.dat"
 
     csim_design -argv "1 ../../../../test/testVectors/siTAIF_OneSeg.dat"
     csim_design -argv "1 ../../../../test/testVectors/siTAIF_OneLongSeg.dat"
@@ -204,6 +222,10 @@ if { $hlsCSim} {
     csim_design -argv "1 ../../../../test/testVectors/siTAIF_8SegIn8Sess.dat"
     csim_design -argv "1 ../../../../test/testVectors/siTAIF_SixtyFourSeg.dat"
     csim_design -argv "1 ../../../../test/testVectors/siTAIF_Ramp.dat"
+    csim_design -argv "1 ../../../../test/testVectors/siTAIF_TxLatency.dat"
+    csim_design -argv "1 ../../../../test/testVectors/siTAIF_ElephantMice.dat"
+    csim_design -argv "1 ../../../../test/testVectors/siTAIF_ManySessTx.dat"
+    csim_design -argv "1 ../../../../test/testVectors/siTAIF_ConnStorm.dat"
    
     csim_design -argv "3 ../../../../test/testVectors/siIPRX_OneSynPkt.dat"
     csim_design -argv "3 ../../../../test/testVectors/siIPRX_OneSynMssPkt.dat"
@@ -217,6 +239,32 @@ if { $hlsCSim} {
     csim_design -argv "3 ../../../../test/testVectors/siIPRX_Ramp64.dat"
     csim_design -argv "3 ../../../../test/testVectors/siIPRX_TwentyPkt.dat"
 
+    # The 1K-session bench needs tables sized for 1024 sessions. Because the
+    #  'cflags' belong to a project, it runs in a project of its own.
+    close_project
+    open_project  ${projectName}_1k_prj
+    addToeFiles   "-DTOE_NR_SESSIONS=1024"
+    set_top       ${projectName}_top
+    open_solution ${solutionName}
+    set_part      ${xilPartName}
+    create_clock -period 6.4 -name default
+    csim_design -setup -clean -compiler gcc
+    csim_design -argv "1 ../../../../test/testVectors/siTAIF_ThousandSessTx.dat"
+    close_project
+
+    # The long fat pipe bench needs MB-sized windows and an RTO above its 1ms RTT.
+    open_project  ${projectName}_lfp_prj
+    addToeFiles   "-DTOE_DDR_WINDOW_BITS=22 -DTOE_SIM_TIME_1S_TICKS=62500"
+    set_top       ${projectName}_top
+    open_solution ${solutionName}
+    set_part      ${xilPartName}
+    create_clock -period 6.4 -name default
+    csim_design -setup -clean -compiler gcc
+    csim_design -argv "0 ../../../../test/testVectors/siIPRX_TcpLongFatPipe.dat"
+    close_project
+    open_project  ${projectName}_prj
+    open_solution ${solutionName}
+
     puts "#############################################################"
     puts "####                                                     ####"
     puts "####          SUCCESSFUL END OF C SIMULATION             ####"
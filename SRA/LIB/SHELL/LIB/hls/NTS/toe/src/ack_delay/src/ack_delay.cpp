@@ -75,6 +75,24 @@ using namespace hls;
 #define DEBUG_LEVEL (TRACE_OFF)
 
 
+#ifndef __SYNTHESIS__
+  //-- The number of ACK events received and sent (for the testbench only)
+  static unsigned int akdNrAcksRcvd = 0;
+  static unsigned int akdNrAcksSent = 0;
+
+  /*****************************************************************************
+   * @brief Return the number of ACK events received from [EVe] and the number
+   *         of ACK events forwarded to [TXe] by the ACK Delayer.
+   *
+   * @param[out] nrAcksRcvd  The number of ACK_EVENTs received from [EVe].
+   * @param[out] nrAcksSent  The number of ACK_EVENTs forwarded to [TXe].
+   *****************************************************************************/
+  void getAckDelayStats(unsigned int &nrAcksRcvd, unsigned int &nrAcksSent) {
+      nrAcksRcvd = akdNrAcksRcvd;
+      nrAcksSent = akdNrAcksSent;
+  }
+#endif
+
 /*******************************************************************************
  * @brief ACK Delayer (AKd)
  *
@@ -84,13 +102,25 @@ using namespace hls;
  * @param[out] soTXe_Event      Event to Tx Engine (TXe).
  *
  * @details
- *  This process manages the transmission delay of the ACKs. Upon reception
- *   of an ACK, the counter associated to the corresponding session is
- *   initialized to (64us/MAX_SESSIONS). Next, this counter is decremented
- *   every (MAX_SESSIONS) until it reaches zero. At that time, a request to
- *   generate an ACK for that session is forwarded to the TxEngine (Txe).
- *  If the pace of incoming segments increases, the rate of returned ACKs is
- *   also increased.
+ *  This process implements the delayed ACK of RFC-1122 and RFC-5681. The
+ *   ACK_EVENTs of a session are coalesced into a single pending ACK which is
+ *   forwarded to the TxEngine (TXe) as soon as one of the following holds:
+ *    - TOE_ACKD_SEGS full-sized segments were received since the last ACK.
+ *      A segment is full-sized if it is at least as long as the largest
+ *      segment received so far from the peer (i.e. an estimate of its MSS).
+ *    - The oldest unacknowledged segment is 'ACKD_MAX_CYCLES' old. This
+ *      deadline is set against a free-running cycle counter and is therefore
+ *      independent of the load of the process.
+ *  Any other event forwarded to [TXe] carries an up-to-date ACK and clears
+ *   the pending ACK of its session. This includes the ACK_NODELAY_EVENTs that
+ *   [RXe] issues upon out-of-order data and PSH segments.
+ *  The deadlines are scanned at the rate of one session per cycle, whether an
+ *   event is received or not. The scan works on a copy of the timers in
+ *   TIMER_TABLE and never writes back into it. Instead, it records in
+ *   FIRED_TABLE the deadline of the last ACK it fired for a session. An ACK
+ *   event that finds its session past the deadline sends the ACK at once.
+ *  After a reset, the tables are cleared at the rate of one session per cycle
+ *   before the first event is processed.
  *******************************************************************************/
 void ack_delay(
         stream<ExtendedEvent>   &siEVe_Event,
@@ -107,173 +137,194 @@ void ack_delay(
     static AckEntry                 ACK_TABLE[TOE_MAX_SESSIONS];
     #pragma HLS RESOURCE   variable=ACK_TABLE core=RAM_T2P_BRAM
     #pragma HLS DEPENDENCE variable=ACK_TABLE inter false
+    static AckTimer                 TIMER_TABLE[TOE_MAX_SESSIONS];
+    #pragma HLS RESOURCE   variable=TIMER_TABLE core=RAM_T2P_BRAM
+    #pragma HLS DEPENDENCE variable=TIMER_TABLE inter false
+    static AckTime                  FIRED_TABLE[TOE_MAX_SESSIONS];
+    #pragma HLS RESOURCE   variable=FIRED_TABLE core=RAM_T2P_BRAM
+    #pragma HLS DEPENDENCE variable=FIRED_TABLE inter false
 
     //-- STATIC CONTROL VARIABLES (with RESET) ---------------------------------
     // [TODO - The type of 'akd_Ptr' could be configured as a functions of 'MAX_SESSIONS']
     // [ E.g. - static const int NR_BITS = ceil(log10(MAX_SESSIONS)/log10(2));
     static SessionId           akd_Ptr;
     #pragma HLS RESET variable=akd_Ptr
+    static AckTime             akd_Now;  // Free-running cycle counter
+    #pragma HLS RESET variable=akd_Now
+    static bool                akd_inInit=true;
+    #pragma HLS RESET variable=akd_inInit
+    static bool                akd_wrValid=false;
+    #pragma HLS RESET variable=akd_wrValid
+
+    //-- STATIC DATAFLOW VARIABLES ---------------------------------------------
+    static SessionId           akd_wrSessId;  // The session written in the previous cycle
+    static AckEntry            akd_wrEntry;   // The entry written in the previous cycle
 
     //-- DYNAMIC VARIABLES -----------------------------------------------------
     ExtendedEvent ev;
+    AckEntry      entry;
+    AckTimer      timer;
+    AckTime       fired;
+    rstEvent      resetEvent;
+    SynCookieEvent cookieEvent;
+    bool          overdue;
+    bool          wrEntry = false;  // Single write site of ACK_TABLE and TIMER_TABLE
+    SessionId     wrSessId;
+    bool          wrFired = false;  // Single write site of FIRED_TABLE
+    SessionId     firedSessId;
+    bool          sendTx  = false;  // Single write site of 'soTXe_Event'
+    ExtendedEvent txEvent;
 
-    if (!siEVe_Event.empty()) {
+    akd_Now++;
 
-        // Read incoming event and inform [EVe] that the FiFo stream was read
-        siEVe_Event.read(ev);
-        assessSize(myName, soEVe_RxEventSig, "soEVe_RxEventSig", cDepth_AKdToEVe_Event);
-        soEVe_RxEventSig.write(1);
+    if (akd_inInit) {
+        // Clear the tables of one session per cycle after a reset
+        entry    = AckEntry();
+        wrEntry  = true;
+        wrSessId = akd_Ptr;
+        wrFired  = true;
+        firedSessId = akd_Ptr;
+        fired    = 0;
+        akd_Ptr++;
+        if (akd_Ptr == TOE_MAX_SESSIONS) {
+            akd_Ptr    = 0;
+            akd_inInit = false;
+        }
+    }
+    else {
+        if (!siEVe_Event.empty()) {
 
-        if (ev.type == ACK_EVENT) {
-            /*************************
-            switch (ACK_TABLE[ev.sessionID].count) {
-            case 0: // There is no delayed ACK pending --> Schedule a new one
-                ACK_TABLE[ev.sessionID] = AckEntry(ACKD_64us, 1);
-                break;
-            case 1: // Received a second ACK  --> Decrease the delay
-                if (ACK_TABLE[ev.sessionID].delay > ACKD_32us) {
-                    ACK_TABLE[ev.sessionID].delay = ACKD_32us;
-                }
-                ACK_TABLE[ev.sessionID].count++;
-                break;
-            case 2: // Received a third ACK   --> Decrease the delay
-                if (ACK_TABLE[ev.sessionID].delay > ACKD_16us) {
-                    ACK_TABLE[ev.sessionID].delay = ACKD_16us;
-                }
-                ACK_TABLE[ev.sessionID].count++;
-                break;
-            case 3: // Received a fourth ACK  --> Decrease the delay
-                if (ACK_TABLE[ev.sessionID].delay > ACKD_8us) {
-                    ACK_TABLE[ev.sessionID].delay = ACKD_8us;
+            // Read incoming event and inform [EVe] that the FiFo stream was read
+            siEVe_Event.read(ev);
+            assessSize(myName, soEVe_RxEventSig, "soEVe_RxEventSig", cDepth_AKdToEVe_Event);
+            soEVe_RxEventSig.write(1);
+            if (akd_wrValid and (akd_wrSessId == ev.sessionID)) {
+                // Bypass the BRAM that is still being written
+                entry = akd_wrEntry;
+            }
+            else {
+                entry = ACK_TABLE[ev.sessionID];
+            }
+            overdue = entry.armed and ((ap_int<32>)(akd_Now - entry.deadline) >= 0);
+
+            if (ev.type == ACK_EVENT) {
+                #ifndef __SYNTHESIS__
+                akdNrAcksRcvd++;
+                #endif
+                if (ev.length > entry.rcvMss) {
+                    entry.rcvMss = ev.length;
                 }
-                ACK_TABLE[ev.sessionID].count++;
-                break;
-            case 4: // Received a fifth ACK   --> Decrease the delay
-                if (ACK_TABLE[ev.sessionID].delay > ACKD_4us) {
-                    ACK_TABLE[ev.sessionID].delay = ACKD_4us;
+                if ((ev.length != 0) and (ev.length == entry.rcvMss)) {
+                    entry.count++;
                 }
-                ACK_TABLE[ev.sessionID].count++;
-                break;
-            case 5: // Received a sixth ACK   --> Decrease the delay
-                if (ACK_TABLE[ev.sessionID].delay > ACKD_2us) {
-                    ACK_TABLE[ev.sessionID].delay = ACKD_2us;
+                if ((entry.count >= TOE_ACKD_SEGS) or overdue) {
+                    // Received enough full-sized segments or the pending ACK is due --> ACK now
+                    txEvent = Event(ACK_EVENT, ev.sessionID);
+                    sendTx  = true;
+                    entry.armed = false;
+                    entry.count = 0;
                 }
-                ACK_TABLE[ev.sessionID].count++;
-                break;
-            case 6: // Received a seventh ACK --> Decrease the delay
-                if (ACK_TABLE[ev.sessionID].delay > ACKD_1us) {
-                    ACK_TABLE[ev.sessionID].delay = ACKD_1us;
+                else if (!entry.armed) {
+                    // There is no delayed ACK pending --> Schedule a new one
+                    entry.armed    = true;
+                    entry.deadline = akd_Now + ACKD_MAX_CYCLES;
                 }
-                ACK_TABLE[ev.sessionID].count++;
-                break;
-            default: // Received a eight+ ACK --> Set delay to ONE
-                ACK_TABLE[ev.sessionID].delay = 1;
-                ACK_TABLE[ev.sessionID].count = 8;
-                break;
-            } // End of: switch
-            ***************************/
-
-            if (ACK_TABLE[ev.sessionID].delay == 0) {
-            	// There is no delayed ACK pending --> Schedule a new one
-                ACK_TABLE[ev.sessionID] = AckEntry(ACKD_64us, 1);
-            }
-            else if (ACK_TABLE[ev.sessionID].count == 1) {
-            	// Received a second ACK  --> Decrease the delay
-                if (ACK_TABLE[ev.sessionID].delay > ACKD_32us) {
-                    ACK_TABLE[ev.sessionID].delay = ACKD_32us;
+                // Debug trace
+                if (DEBUG_LEVEL & TRACE_AKD) {
+                    printInfo(myName, "S%d - Received \'%s\' (Len=%4d) - Setting ACK_TABLE[%d]={A=%d,C=%2.2d,MSS=%4d}\n",
+                              ev.sessionID.to_int(), getEventName(ev.type), ev.length.to_uint(),
+                              ev.sessionID.to_uint(), entry.armed,
+                              entry.count.to_uint(), entry.rcvMss.to_uint());
                 }
-                ACK_TABLE[ev.sessionID].count++;
             }
-            else if (ACK_TABLE[ev.sessionID].count == 2) {
-            	// Received a third ACK   --> Decrease the delay
-                if (ACK_TABLE[ev.sessionID].delay > ACKD_16us) {
-                    ACK_TABLE[ev.sessionID].delay = ACKD_16us;
+            else {
+                // Received any other event --> Clear the pending ACK
+                entry.armed = false;
+                entry.count = 0;
+                if ((ev.type == SYN_EVENT) or (ev.type == SYN_ACK_EVENT) or (ev.type == SYN_COOKIE_EVENT)) {
+                    // A new connection starts --> Forget the MSS of the former one
+                    entry.rcvMss = 0;
                 }
-                ACK_TABLE[ev.sessionID].count++;
-            }
-            else if (ACK_TABLE[ev.sessionID].count == 3) {
-            	// Received a fourth ACK  --> Decrease the delay
-                if (ACK_TABLE[ev.sessionID].delay > ACKD_8us) {
-                    ACK_TABLE[ev.sessionID].delay = ACKD_8us;
+                // Forward event to TxEngine
+                txEvent = ev;
+                sendTx  = true;
+                // Debug trace
+                if (DEBUG_LEVEL & TRACE_AKD) {
+                    printInfo(myName, "S%d - Received '%s' - Clearing ACK_TABLE[%d]\n",
+                                      ev.sessionID.to_int(), getEventName(ev.type),
+                                      ev.sessionID.to_uint());
                 }
-                ACK_TABLE[ev.sessionID].count++;
             }
-            else if (ACK_TABLE[ev.sessionID].count == 4) {
-            	// Received a fifth ACK   --> Decrease the delay
-                if (ACK_TABLE[ev.sessionID].delay > ACKD_4us) {
-                    ACK_TABLE[ev.sessionID].delay = ACKD_4us;
-                }
-                ACK_TABLE[ev.sessionID].count++;
+            // A stateless RST or SYN_ACK does not belong to any session
+            resetEvent  = ev;
+            cookieEvent = ev;
+            if (not ((ev.type == RST_EVENT)        and !resetEvent.hasSessionID()) and
+                not ((ev.type == SYN_COOKIE_EVENT) and !cookieEvent.hasSessionID())) {
+                wrEntry  = true;
+                wrSessId = ev.sessionID;
             }
-            else if (ACK_TABLE[ev.sessionID].count == 5) {
-            	// Received a sixth ACK   --> Decrease the delay
-                if (ACK_TABLE[ev.sessionID].delay > ACKD_2us) {
-                    ACK_TABLE[ev.sessionID].delay = ACKD_2us;
+        }
+
+        //-- Scan the deadlines (one session per cycle)
+        if (wrEntry and (wrSessId == akd_Ptr)) {
+            timer = AckTimer(entry.armed, entry.deadline);
+        }
+        else if (akd_wrValid and (akd_wrSessId == akd_Ptr)) {
+            // Bypass the BRAM that is still being written
+            timer = AckTimer(akd_wrEntry.armed, akd_wrEntry.deadline);
+        }
+        else {
+            timer = TIMER_TABLE[akd_Ptr];
+        }
+        fired = FIRED_TABLE[akd_Ptr];
+        if (timer.armed and ((ap_int<32>)(akd_Now - timer.deadline) >= 0) and (fired != timer.deadline)) {
+            if (!sendTx and !soTXe_Event.full()) {
+                txEvent = Event(ACK_EVENT, akd_Ptr);
+                sendTx  = true;
+                fired   = timer.deadline;
+                wrFired = true;
+                firedSessId = akd_Ptr;
+                if (DEBUG_LEVEL & TRACE_AKD) {
+                    printInfo(myName, "S%d - It's ACK Time - Requesting [TXe] to generate an new ACK\n",
+                              akd_Ptr.to_int());
                 }
-                ACK_TABLE[ev.sessionID].count++;
-            }
-            else if (ACK_TABLE[ev.sessionID].count == 6) {
-            	// Received a seventh ACK --> Decrease the delay
-                if (ACK_TABLE[ev.sessionID].delay > ACKD_1us) {
-                    ACK_TABLE[ev.sessionID].delay = ACKD_1us;
+                akd_Ptr++;
+                if (akd_Ptr == TOE_MAX_SESSIONS) {
+                    akd_Ptr = 0;
                 }
-                ACK_TABLE[ev.sessionID].count++;
-            }
-            else if (ACK_TABLE[ev.sessionID].count == 7) {
-            	// Received a eight+ ACK --> Set delay to ONE
-                ACK_TABLE[ev.sessionID].delay = 1;
-                ACK_TABLE[ev.sessionID].count = 8;
-            }
-            // Debug trace
-            if (DEBUG_LEVEL & TRACE_AKD) {
-                printInfo(myName, "S%d - Received \'%s\' - Setting  ACK_TABLE[%d]={D=%4.4d,C=%2.2d}\n",
-                          ev.sessionID.to_int(), getEventName(ev.type),
-                          ev.sessionID.to_uint(),
-                          ACK_TABLE[ev.sessionID].delay.to_uint(),
-                          ACK_TABLE[ev.sessionID].count.to_uint());
             }
+            // Otherwise, the scan waits on this session until [TXe] can take the ACK
         }
         else {
-            // Received any other event --> Reset current entry
-            ACK_TABLE[ev.sessionID] = AckEntry(0, 0);
-            // Forward event to TxEngine
-            assessSize(myName, soTXe_Event, "soTXe_Event", cDepth_AKdToTXe_Event);
-            soTXe_Event.write(ev);
-            // Tell the EventEngine that we just forwarded an none-ACK event to TXe
-            assessSize(myName, soEVe_TxEventSig, "soEVe_TxEventSig", cDepth_AKdToEVe_Event);
-            soEVe_TxEventSig.write(1);
-            // Debug trace
-            if (DEBUG_LEVEL & TRACE_AKD) {
-                printInfo(myName, "S%d - Received '%s' - Clearing ACK_TABLE[%d]={D=%4.4d,C=%2.2d}\n",
-                                  ev.sessionID.to_int(), getEventName(ev.type),
-                                  ev.sessionID.to_uint(),
-                                  ACK_TABLE[ev.sessionID].delay.to_uint(),
-                                  ACK_TABLE[ev.sessionID].count.to_uint());
+            akd_Ptr++;
+            if (akd_Ptr == TOE_MAX_SESSIONS) {
+                akd_Ptr = 0;
             }
         }
     }
-    else {
-        if (ACK_TABLE[akd_Ptr].delay > 0 and !soTXe_Event.full()) {
-            if (ACK_TABLE[akd_Ptr].delay == 1) {
-                soTXe_Event.write(Event(ACK_EVENT, akd_Ptr));
-                // Tell the EventEngine that we just forwarded an event to TXe
-                assessSize(myName, soEVe_TxEventSig, "soEVe_TxEventSig", cDepth_AKdToEVe_Event);
-                soEVe_TxEventSig.write(1);
-                // Do not clear the received ACK counter here. It will anyhow be
-                //  cleared whenever a new event comes in. Until then, it gives
-                //  us a good indication of its usage in the trace.
-                 if (DEBUG_LEVEL & TRACE_AKD) {
-                    printInfo(myName, "S%d - It's ACK Time (count=%d) - Requesting [TXe] to generate an new ACK\n",
-                              akd_Ptr.to_int(), ACK_TABLE[akd_Ptr].count.to_uint());
-                }
-            }
-            ACK_TABLE[akd_Ptr].delay -= 1;
-        }
-        akd_Ptr++;
-        if (akd_Ptr == TOE_MAX_SESSIONS) {
-            akd_Ptr = 0;
+
+    if (sendTx) {
+        assessSize(myName, soTXe_Event, "soTXe_Event", cDepth_AKdToTXe_Event);
+        soTXe_Event.write(txEvent);
+        // Tell the EventEngine that we just forwarded an event to TXe
+        assessSize(myName, soEVe_TxEventSig, "soEVe_TxEventSig", cDepth_AKdToEVe_Event);
+        soEVe_TxEventSig.write(1);
+        #ifndef __SYNTHESIS__
+        if (txEvent.type == ACK_EVENT) {
+            akdNrAcksSent++;
         }
+        #endif
+    }
+    if (wrFired) {
+        FIRED_TABLE[firedSessId] = fired;
+    }
+    if (wrEntry) {
+        ACK_TABLE[wrSessId]   = entry;
+        TIMER_TABLE[wrSessId] = AckTimer(entry.armed, entry.deadline);
     }
+    akd_wrValid  = wrEntry;
+    akd_wrSessId = wrSessId;
+    akd_wrEntry  = entry;
 }
 
 
@@ -62,24 +62,38 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 using namespace hls;
 
 /*******************************************************************************
- * ACK Table (RSt)
+ * ACK Table (AKd)
  *  Structure to manage the transmission rate of the ACKs.
  *
- * [TODO - The type of 'AckEntry.delay' can be configured as a functions of 'TIME_XXX' and 'MAX_SESSIONS']
- *   [ E.g. - TIME_64us  = ( 64.000/0.0064/32) + 1 =  313 = 0x139 ( 9-bits)
- *   [ E.g. - TIME_64us  = ( 64.000/0.0064/ 8) + 1 = 1251 = 0x4E3 (11-bits)
- *   [ E.g. - TIME_128us = (128.000/0.0064/32) + 1 =  626 = 0x271 (10-bits)
+ *  An entry holds the delayed ACK of a session (if any), the number of
+ *   full-sized segments received since the last ACK and an estimate of the
+ *   MSS used by the peer (i.e. the largest segment received so far).
  *******************************************************************************/
+typedef ap_uint<32> AckTime;   // A time stamp in clock cycles
+
 class AckEntry {
   public:
-    ap_uint<12> delay;  // Keeps track of the elapsed time
-    ap_uint<4>  count;  // Counts the number of received ACKs
+    FlagBool    armed;     // A delayed ACK is pending
+    AckTime     deadline;  // The time at which the pending ACK must be sent
+    ap_uint<4>  count;     // Counts the full-sized segments received since the last ACK
+    TcpSegLen   rcvMss;    // The largest segment received from the peer
 
     AckEntry() :
-        delay(0), count(0) {}
-    AckEntry(ap_uint<12> delay, ap_uint<4> count) :
-        delay(delay), count(count) {}
+        armed(false), deadline(0), count(0), rcvMss(0) {}
+    AckEntry(FlagBool armed, AckTime deadline, ap_uint<4> count, TcpSegLen rcvMss) :
+        armed(armed), deadline(deadline), count(count), rcvMss(rcvMss) {}
+};
+
+//-- The delayed ACK timer of a session, as seen by the scan of the deadlines
+class AckTimer {
+  public:
+    FlagBool    armed;     // A delayed ACK is pending
+    AckTime     deadline;  // The time at which the pending ACK must be sent
 
+    AckTimer() :
+        armed(false), deadline(0) {}
+    AckTimer(FlagBool armed, AckTime deadline) :
+        armed(armed), deadline(deadline) {}
 };
 
 /*******************************************************************************
@@ -96,6 +110,10 @@ void ack_delay(
         stream<ExtendedEvent>   &soTXe_Event
 );
 
+#ifndef __SYNTHESIS__
+  void getAckDelayStats(unsigned int &nrAcksRcvd, unsigned int &nrAcksSent);
+#endif
+
 #endif
 
 /*! \} */
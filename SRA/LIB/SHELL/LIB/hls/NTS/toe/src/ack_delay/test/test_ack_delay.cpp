@@ -82,6 +82,10 @@ int main(int argc, char* argv[])
     int          nrInpAck = 0;
     int          nrOutSyn = 0;
     int          nrOutAck = 0;
+    int          nrInpBulk = 0;
+    int          nrOutBulk = 0;
+    int          rpcInpLoop = 0;
+    int          rpcOutLoop = 0;
 
     //------------------------------------------------------
     //-- DUT STREAM INTERFACES and RELATED VARIABLEs
@@ -94,6 +98,8 @@ int main(int argc, char* argv[])
     stream<SigBit>        ssAKdToEVe_TxEventSig;
 
     SessionId      sessId = TOE_MAX_SESSIONS-1;
+    SessionId      bulkId = 1;  // Session receiving full-sized segments
+    SessionId      rpcId  = 2;  // Session receiving a single small segment
     ExtendedEvent  outEvent;
 
 
@@ -102,7 +108,7 @@ int main(int argc, char* argv[])
     printInfo(THIS_NAME, "## TESTBENCH 'test_iprx' STARTS HERE                                      ##\n");
     printInfo(THIS_NAME, "############################################################################\n");
 
-    int tbRun = 1000;
+    int tbRun = 1000 + 2*ACKD_MAX_CYCLES;
     int loop  = 0;
 
     while (tbRun) {
@@ -136,6 +142,25 @@ int main(int argc, char* argv[])
                 nrInpAck++;
             }
         }
+        else if (loop >= 400 and loop < 600) {
+            // Create a bulk of 10 full-sized segments every 20th loop
+            if (loop % 20 == 0) {
+                ssEVeToAKd_Event.write(Event(ACK_EVENT, bulkId, 0, 1024));
+                nrInpAck++;
+                nrInpBulk++;
+            }
+        }
+        else if (loop == 1000) {
+            // Create a single small segment
+            ssEVeToAKd_Event.write(Event(ACK_EVENT, rpcId, 0, 64));
+            nrInpAck++;
+            rpcInpLoop = loop;
+        }
+        else if (loop > 1000 and loop < (1000 + (int)ACKD_MAX_CYCLES)) {
+            // Keep the DUT busy with one event per cycle while the small segment waits
+            ssEVeToAKd_Event.write(Event(ACK_EVENT, sessId));
+            nrInpAck++;
+        }
         loop++;
 
         //------------------------------------------------------
@@ -158,6 +183,12 @@ int main(int argc, char* argv[])
             ssAKdToTXe_Event.read(outEvent);
             if (outEvent.type == ACK_EVENT) {
                 nrOutAck++;
+                if (outEvent.sessionID == bulkId) {
+                    nrOutBulk++;
+                }
+                else if (outEvent.sessionID == rpcId) {
+                    rpcOutLoop = loop;
+                }
             }
             else if (outEvent.type == SYN_EVENT) {
                 nrOutSyn++;
@@ -180,6 +211,12 @@ int main(int argc, char* argv[])
     printInfo(THIS_NAME, "Number of forwarded SYNs   : %5d \n", nrOutSyn);
     printInfo(THIS_NAME, "Number of received  ACKs   : %5d \n", nrInpAck);
     printInfo(THIS_NAME, "Number of forwarded ACKs   : %5d \n", nrOutAck);
+    unsigned int nrAcksRcvd, nrAcksSent;
+    getAckDelayStats(nrAcksRcvd, nrAcksSent);
+    printInfo(THIS_NAME, "ACK events coalesced by DUT: %5d \n", nrAcksRcvd - nrAcksSent);
+    printInfo(THIS_NAME, "Number of bulk segments    : %5d \n", nrInpBulk);
+    printInfo(THIS_NAME, "Number of bulk ACKs        : %5d \n", nrOutBulk);
+    printInfo(THIS_NAME, "Delay of the small segment : %5d cycles\n", rpcOutLoop - rpcInpLoop);
     printInfo(THIS_NAME, "Number of Rx event signals : %5d \n", rxEventSig);
     printInfo(THIS_NAME, "Number of Tx event signals : %5d \n", txEventSig);
 
@@ -194,6 +231,16 @@ int main(int argc, char* argv[])
         nrErr++;
     if ((nrOutSyn + nrOutAck) != txEventSig)
         nrErr++;
+    if (nrOutBulk != (nrInpBulk / TOE_ACKD_SEGS)) {
+        printError(THIS_NAME, "Expected one ACK every %d full-sized segments.\n", TOE_ACKD_SEGS);
+        nrErr++;
+    }
+    if ((rpcOutLoop == 0) or
+        ((rpcOutLoop - rpcInpLoop) < (int)ACKD_MAX_CYCLES) or
+        ((rpcOutLoop - rpcInpLoop) > (int)(ACKD_MAX_CYCLES + 2*TOE_MAX_SESSIONS))) {
+        printError(THIS_NAME, "The ACK of the small segment was not delayed by %d cycles.\n", ACKD_MAX_CYCLES.to_uint());
+        nrErr++;
+    }
 
     if (nrErr) {
         printError(THIS_NAME, "###########################################################\n");
@@ -0,0 +1,445 @@
+/*
+ * Copyright 2016 -- 2021 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*******************************************************************************
+ * @file       : congestion_control.cpp
+ * @brief      : Congestion Control (CCo) of the TCP Offload Engine (TOE)
+ *
+ * System:     : cloudFPGA
+ * Component   : Shell, Network Transport Stack (NTS)
+ * Language    : Vivado HLS
+ *
+ * \ingroup NTS
+ * \addtogroup NTS_TOE
+ * \{
+ *******************************************************************************/
+
+#include "congestion_control.hpp"
+
+using namespace hls;
+
+/************************************************
+ * HELPERS FOR THE DEBUGGING TRACES
+ *  .e.g: DEBUG_LEVEL = (TRACE_CCO)
+ ************************************************/
+#ifndef __SYNTHESIS__
+  extern bool gTraceEvent;
+#endif
+
+#define THIS_NAME "TOE/CCo"
+
+#define TRACE_OFF  0x0000
+#define TRACE_CCO 1 <<  1
+#define TRACE_ALL  0xFFFF
+
+#define DEBUG_LEVEL (TRACE_OFF)
+
+//-- A window which is one bit wider than a 'LocalWinSize'
+typedef ap_uint<TOE_WINDOW_BITS+1>  CcWideWin;
+
+
+/*******************************************************************************
+ * @brief Returns the integer cube root of a value (.i.e floor(cbrt(x))).
+ *
+ * @param[in] x  The value to take the cube root of.
+ *
+ * @details
+ *  The root is computed one bit at a time, starting from the MSB. The loop
+ *   is fully unrolled and does not prevent the caller from being pipelined.
+ *******************************************************************************/
+CcCubeRt cubeRoot(ap_uint<TOE_WINDOW_BITS+CC_CUBIC_C_SHIFT> x)
+{
+    #pragma HLS INLINE
+
+    CcCubeRt root = 0;
+    for (int b=7; b>=0; --b) {
+    #pragma HLS UNROLL
+        CcCubeRt    trial = root | (1 << b);
+        ap_uint<24> cube  = trial * trial * trial;
+        if (cube <= x) {
+            root = trial;
+        }
+    }
+    return root;
+}
+
+/*******************************************************************************
+ * @brief Clamps a congestion window to its maximum value.
+ *******************************************************************************/
+LocalWinSize clampWindow(ap_uint<TOE_WINDOW_BITS+8> win)
+{
+    #pragma HLS INLINE
+    return (win > TOE_MAX_CONGESTION_WINDOW) ? (LocalWinSize)TOE_MAX_CONGESTION_WINDOW :
+                                               (LocalWinSize)win;
+}
+
+/*******************************************************************************
+ * @brief Initializes the congestion state of a new connection.
+ *
+ * @param[out] entry  The congestion state to initialize.
+ *******************************************************************************/
+void ccInit(CcEntry &entry)
+{
+    #pragma HLS INLINE
+
+    entry.cwnd       = TOE_INIT_CONGESTION_WINDOW;
+    entry.ssthresh   = TOE_BUFFER_SIZE-1;
+    entry.bytesAcked = 0;
+    entry.wMax       = 0;
+    entry.epoch      = 0;
+    entry.k          = 0;
+    entry.epochValid = false;
+    entry.alpha      = CC_DCTCP_ALPHA_ONE;  // RFC-8257 (Sect. 3.3)
+    entry.winAcked   = 0;
+    entry.winMarked  = 0;
+}
+
+/*******************************************************************************
+ * @brief Computes the slow start threshold after a loss.
+ *
+ * @param[in]     algo       The congestion control algorithm.
+ * @param[in/out] entry      The congestion state of the session.
+ * @param[in]     cwndAtLoss The congestion window at the time of the loss.
+ *
+ * @return the new slow start threshold.
+ *
+ * @details
+ *  Reno and DCTCP halve the window. CUBIC reduces it by 'beta' and records
+ *   the window at which the loss occurred as the plateau of the next epoch.
+ *   If the window did not grow back to its previous plateau, the plateau is
+ *   further reduced to release bandwidth to the new flows (fast convergence).
+ *******************************************************************************/
+LocalWinSize ccOnLoss(int algo, CcEntry &entry, LocalWinSize cwndAtLoss)
+{
+    #pragma HLS INLINE
+
+    ap_uint<TOE_WINDOW_BITS+8> scaled;
+    LocalWinSize               threshold;
+
+    if (algo == TOE_CC_CUBIC) {
+        if (cwndAtLoss < entry.wMax) {
+            scaled     = cwndAtLoss * CC_CUBIC_FAST_CONV;
+            entry.wMax = scaled >> 8;
+        }
+        else {
+            entry.wMax = cwndAtLoss;
+        }
+        scaled    = cwndAtLoss * CC_CUBIC_BETA;
+        threshold = scaled >> 8;
+        entry.epochValid = false;
+    }
+    else {
+        threshold = cwndAtLoss >> 1;
+    }
+    if (threshold < 2*ZYC2_MSS) {
+        threshold = 2*ZYC2_MSS;
+    }
+    entry.bytesAcked = 0;
+    return threshold;
+}
+
+/*******************************************************************************
+ * @brief Increases the congestion window the Reno way.
+ *
+ * @param[in/out] entry      The congestion state of the session.
+ * @param[in]     ackedBytes The number of bytes newly acknowledged.
+ *
+ * @details
+ *  In slow start, the window grows by min(ackedBytes, MSS) per ACK. In
+ *   congestion avoidance, it grows by one MSS each time a full window of
+ *   bytes has been acknowledged. This byte counting (RFC-3465) replaces the
+ *   (MSS x MSS)/cwnd increment of RFC-5681 and does not require a divider.
+ *******************************************************************************/
+void ccRenoIncrease(CcEntry &entry, TcpWinSize ackedBytes)
+{
+    #pragma HLS INLINE
+
+    CcWideWin newCwnd = entry.cwnd;
+
+    if (entry.cwnd < entry.ssthresh) {
+        newCwnd += (ackedBytes < ZYC2_MSS) ? (TcpWinSize)ackedBytes : (TcpWinSize)ZYC2_MSS;
+    }
+    else {
+        entry.bytesAcked += ackedBytes;
+        if (entry.bytesAcked >= entry.cwnd) {
+            entry.bytesAcked -= entry.cwnd;
+            newCwnd += ZYC2_MSS;
+        }
+    }
+    entry.cwnd = clampWindow(newCwnd);
+}
+
+/*******************************************************************************
+ * @brief Increases the congestion window the CUBIC way.
+ *
+ * @param[in/out] entry      The congestion state of the session.
+ * @param[in]     ackedBytes The number of bytes newly acknowledged.
+ * @param[in]     now        The current time in ticks.
+ *
+ * @details
+ *  The first ACK of an avoidance epoch computes the period 'K' needed to grow
+ *   back to 'wMax'. Next, each time a full window of bytes was acknowledged
+ *   (.i.e about once per RTT), the window is set to the target W(t) of the
+ *   cubic function (RFC-8312). The target is limited to 1.5 x cwnd, and the
+ *   window never grows slower than with Reno (TCP-friendly region).
+ *******************************************************************************/
+void ccCubicIncrease(CcEntry &entry, TcpWinSize ackedBytes, CcTime now)
+{
+    #pragma HLS INLINE
+
+    ap_uint<TOE_WINDOW_BITS+CC_CUBIC_C_SHIFT> diff;
+    ap_uint<TOE_WINDOW_BITS+8>                target;
+    ap_uint<TOE_WINDOW_BITS+8>                maxTarget;
+    ap_uint<TOE_WINDOW_BITS+8>                minTarget;
+    ap_uint<24>                               delta;
+    CcTime                                    elapsed;
+    CcTime                                    offs;
+    CcCubeRt                                  offs8;
+    bool                                      convex;
+
+    if (entry.cwnd < entry.ssthresh) {
+        ccRenoIncrease(entry, ackedBytes);
+    }
+    else {
+        if (not entry.epochValid) {
+            entry.epoch      = now;
+            entry.epochValid = true;
+            entry.bytesAcked = 0;
+            if (entry.cwnd < entry.wMax) {
+                diff    = entry.wMax - entry.cwnd;
+                diff    = diff << CC_CUBIC_C_SHIFT;
+                entry.k = cubeRoot(diff);
+            }
+            else {
+                entry.k    = 0;
+                entry.wMax = entry.cwnd;
+            }
+        }
+        entry.bytesAcked += ackedBytes;
+        if (entry.bytesAcked >= entry.cwnd) {
+            entry.bytesAcked -= entry.cwnd;
+            elapsed = now - entry.epoch;
+            convex  = (elapsed >= entry.k);
+            offs    = (convex) ? (CcTime)(elapsed - entry.k) : (CcTime)(entry.k - elapsed);
+            offs8   = (offs > 255) ? (CcCubeRt)255 : (CcCubeRt)offs;
+            delta   = (offs8 * offs8 * offs8) >> CC_CUBIC_C_SHIFT;
+            if (convex) {
+                target = entry.wMax + delta;
+            }
+            else {
+                target = (delta < entry.wMax) ? (ap_uint<TOE_WINDOW_BITS+8>)(entry.wMax - delta) : (ap_uint<TOE_WINDOW_BITS+8>)0;
+            }
+            maxTarget = entry.cwnd + (entry.cwnd >> 1);
+            minTarget = entry.cwnd + ZYC2_MSS;
+            if (target > maxTarget) {
+                target = maxTarget;
+            }
+            if (target < minTarget) {
+                target = minTarget;
+            }
+            entry.cwnd = clampWindow(target);
+        }
+    }
+}
+
+/*******************************************************************************
+ * @brief Updates the congestion window the DCTCP way.
+ *
+ * @param[in/out] entry      The congestion state of the session.
+ * @param[in]     ackedBytes The number of bytes newly acknowledged.
+ * @param[in]     ece        The ECN-Echo flag of the ACK.
+ *
+ * @return true if the window was reduced.
+ *
+ * @details
+ *  The bytes acknowledged with and without ECE are counted over observation
+ *   windows of about one RTT (.i.e one congestion window of bytes). At the
+ *   end of a window, 'alpha' is updated with the fraction F of marked bytes
+ *   as alpha = (1-g) x alpha + g x F, and, if any byte was marked, the window
+ *   is reduced to cwnd x (1 - alpha/2) (RFC-8257). Otherwise, the window
+ *   grows like Reno.
+ *  FYI - The fraction F is the only division of this process. It is taken
+ *   once per observation window and is implemented as a pipelined divider.
+ *******************************************************************************/
+bool ccDctcpUpdate(CcEntry &entry, TcpWinSize ackedBytes, TcpCtrlBit ece)
+{
+    #pragma HLS INLINE
+
+    ap_uint<TOE_WINDOW_BITS+1+CC_DCTCP_ALPHA_BITS> marked;
+    ap_uint<TOE_WINDOW_BITS+1+CC_DCTCP_ALPHA_BITS> cut;
+    CcAlpha                                        fraction;
+    LocalWinSize                                   newCwnd;
+    bool                                           reduced = false;
+
+    entry.winAcked += ackedBytes;
+    if (ece) {
+        entry.winMarked += ackedBytes;
+    }
+    if (entry.winAcked >= entry.cwnd) {
+        marked      = entry.winMarked;
+        fraction    = (marked << CC_DCTCP_ALPHA_BITS) / entry.winAcked;
+        entry.alpha = entry.alpha - (entry.alpha >> CC_DCTCP_G_SHIFT) + (fraction >> CC_DCTCP_G_SHIFT);
+        if (entry.winMarked != 0) {
+            cut     = entry.cwnd * entry.alpha;
+            newCwnd = entry.cwnd - (cut >> (CC_DCTCP_ALPHA_BITS+1));
+            if (newCwnd < 2*ZYC2_MSS) {
+                newCwnd = 2*ZYC2_MSS;
+            }
+            entry.cwnd       = newCwnd;
+            entry.ssthresh   = newCwnd;
+            entry.bytesAcked = 0;
+            reduced = true;
+        }
+        entry.winAcked  = 0;
+        entry.winMarked = 0;
+    }
+    if (not reduced) {
+        ccRenoIncrease(entry, ackedBytes);
+    }
+    return reduced;
+}
+
+/*******************************************************************************
+ * @brief Applies a congestion event to the state of a session.
+ *
+ * @param[in]     algo        The congestion control algorithm (TOE_CC_xxx).
+ * @param[in/out] entry       The congestion state of the session.
+ * @param[in]     event       The congestion event.
+ * @param[in]     ackedBytes  The number of bytes newly acknowledged.
+ * @param[in]     ece         The ECN-Echo flag of the ACK.
+ * @param[in]     rto         A retransmission timeout occurred since the last update.
+ * @param[in]     tstCwnd     The congestion window currently held by [TSt].
+ * @param[in]     tstSsthresh The slow start threshold currently held by [TSt].
+ * @param[in]     now         The current time in ticks.
+ *
+ * @return true if the window was reduced upon an ECN-Echo (.i.e CWR is due).
+ *
+ * @details
+ *  The algorithm is passed as a parameter so that the testbench can compare
+ *   the three of them. The process itself always calls this function with
+ *   the constant TOE_CC_ALGORITHM, which prunes the other algorithms.
+ *  Upon a retransmission timeout, the window and the Reno threshold computed
+ *   by [TXe] (.i.e FlightSize/2) are adopted.
+ *******************************************************************************/
+bool ccUpdate(
+        int             algo,
+        CcEntry        &entry,
+        CcEvent         event,
+        TcpWinSize      ackedBytes,
+        TcpCtrlBit      ece,
+        bool            rto,
+        LocalWinSize    tstCwnd,
+        LocalWinSize    tstSsthresh,
+        CcTime          now)
+{
+    #pragma HLS INLINE
+
+    LocalWinSize threshold;
+    bool         cwr = false;
+
+    if (event == CC_INIT) {
+        ccInit(entry);
+    }
+    else {
+        if (rto) {
+            //-- A retransmission timeout reset the window held by [TSt]
+            threshold      = ccOnLoss(algo, entry, entry.cwnd);
+            entry.ssthresh = (algo == TOE_CC_CUBIC) ? threshold : tstSsthresh;
+            entry.cwnd     = tstCwnd;
+        }
+        if (event == CC_DUP_ACK) {
+            //-- A third duplicate ACK signals a lost segment
+            entry.ssthresh = ccOnLoss(algo, entry, entry.cwnd);
+            entry.cwnd     = entry.ssthresh;
+        }
+        else if (event == CC_NEW_ACK) {
+            if (algo == TOE_CC_CUBIC) {
+                ccCubicIncrease(entry, ackedBytes, now);
+            }
+            else if (algo == TOE_CC_DCTCP) {
+                cwr = ccDctcpUpdate(entry, ackedBytes, ece);
+            }
+            else {
+                ccRenoIncrease(entry, ackedBytes);
+            }
+        }
+    }
+    return cwr;
+}
+
+/*******************************************************************************
+ * @brief Congestion Control (CCo)
+ *
+ * @param[in]  siRXe_TxSarQry  Tx SAR query from RxEngine (RXe).
+ * @param[out] soTSt_TxSarQry  Tx SAR query to Tx SAR Table (TSt).
+ *
+ * @details
+ *  This process sits on the query path from [RXe] to [TSt]. Read queries and
+ *   write queries without a congestion event nor a timeout are forwarded as
+ *   is. For the other write queries, the congestion state of the session is
+ *   updated with the algorithm selected by TOE_CC_ALGORITHM, and the resulting
+ *   window is written into the query before it is forwarded to [TSt]. When
+ *   the window was reduced upon an ECN-Echo, the query also requests [TSt] to
+ *   have the next new data segment sent with CWR.
+ *  All the queries go through the same FIFO in order to preserve the order
+ *   between the writes and the reads issued by [RXe].
+ *******************************************************************************/
+void congestion_control(
+        stream<RXeTxSarQuery>      &siRXe_TxSarQry,
+        stream<RXeTxSarQuery>      &soTSt_TxSarQry)
+{
+    //-- DIRECTIVES FOR THIS PROCESS -------------------------------------------
+    #pragma HLS PIPELINE II=1 enable_flush
+
+    const char *myName = THIS_NAME;
+
+    //-- STATIC ARRAYS ---------------------------------------------------------
+    static CcEntry                  CC_TABLE[TOE_MAX_SESSIONS];
+    #pragma HLS DEPENDENCE variable=CC_TABLE inter false
+    #pragma HLS RESOURCE   variable=CC_TABLE core=RAM_2P
+    #pragma HLS DATA_PACK  variable=CC_TABLE
+
+    //-- STATIC CONTROL VARIABLES (with RESET) ---------------------------------
+    static ap_uint<CC_TICK_BITS+16> cco_cycleCnt=0;
+    #pragma HLS RESET      variable=cco_cycleCnt
+
+    //-- DYNAMIC VARIABLES -----------------------------------------------------
+    RXeTxSarQuery  txSarQry;
+    CcEntry        ccEntry;
+
+    cco_cycleCnt++;
+
+    if (!siRXe_TxSarQry.empty()) {
+        siRXe_TxSarQry.read(txSarQry);
+        if ((txSarQry.write == QUERY_WR) and ((txSarQry.ccEvent != CC_NONE) or txSarQry.rto)) {
+            ccEntry = CC_TABLE[txSarQry.sessionID];
+            txSarQry.cwr = ccUpdate(TOE_CC_ALGORITHM, ccEntry, txSarQry.ccEvent,
+                                    txSarQry.ackedBytes, txSarQry.ece, txSarQry.rto,
+                                    txSarQry.cong_window, txSarQry.slowstart_threshold,
+                                    cco_cycleCnt(CC_TICK_BITS+15, CC_TICK_BITS));
+            CC_TABLE[txSarQry.sessionID] = ccEntry;
+            if (DEBUG_LEVEL & TRACE_CCO) {
+                printInfo(myName, "Session #%d - Event=%d - CongWindow=%d (was %d) - SsThresh=%d.\n",
+                          txSarQry.sessionID.to_int(), txSarQry.ccEvent, ccEntry.cwnd.to_uint(),
+                          txSarQry.cong_window.to_uint(), ccEntry.ssthresh.to_uint());
+            }
+            txSarQry.cong_window = ccEntry.cwnd;
+        }
+        soTSt_TxSarQry.write(txSarQry);
+    }
+}
+
+/*! \} */
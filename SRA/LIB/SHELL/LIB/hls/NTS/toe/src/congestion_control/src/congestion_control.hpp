@@ -0,0 +1,120 @@
+/*
+ * Copyright 2016 -- 2021 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*******************************************************************************
+ * @file       : congestion_control.hpp
+ * @brief      : Congestion Control (CCo) of the TCP Offload Engine (TOE)
+ *
+ * System:     : cloudFPGA
+ * Component   : Shell, Network Transport Stack (NTS)
+ * Language    : Vivado HLS
+ *
+ * \ingroup NTS
+ * \addtogroup NTS_TOE
+ * \{
+ *******************************************************************************/
+
+#ifndef _TOE_CCO_H_
+#define _TOE_CCO_H_
+
+#include "../../../../../NTS/nts_utils.hpp"
+#include "../../../../../NTS/toe/src/toe.hpp"
+
+using namespace hls;
+
+/*******************************************************************************
+ * CONGESTION CONTROL - PARAMETERS
+ *
+ *  The time used by CUBIC is counted in ticks of 2^CC_TICK_BITS clock cycles
+ *   (.i.e ~26us @ 156.25MHz). The cubic function is expressed in bytes and
+ *   ticks as:  W(t) = Wmax + ((t - K)^3 >> CC_CUBIC_C_SHIFT).
+ *  The multiplicative factors are fixed-point fractions of 256, and the
+ *   DCTCP 'alpha' is a fixed-point fraction of 2^CC_DCTCP_ALPHA_BITS.
+ *******************************************************************************/
+static const unsigned CC_TICK_BITS        = 12;
+static const unsigned CC_CUBIC_C_SHIFT    =  2;   // C = 1/4 byte per tick^3
+static const unsigned CC_CUBIC_BETA       = 179;  // 0.7 x 256 (RFC-8312)
+static const unsigned CC_CUBIC_BETA_DEC   =  77;  // 0.3 x 256 (.i.e 1-beta)
+static const unsigned CC_CUBIC_FAST_CONV  = 218;  // 0.85 x 256 (.i.e (1+beta)/2)
+static const unsigned CC_DCTCP_ALPHA_BITS = 10;
+static const unsigned CC_DCTCP_ALPHA_ONE  = (1 << CC_DCTCP_ALPHA_BITS);
+static const unsigned CC_DCTCP_G_SHIFT    =  4;   // g = 1/16 (RFC-8257)
+
+typedef ap_uint<16>                       CcTime;   // A time in ticks
+typedef ap_uint<8>                        CcCubeRt; // A cube root of a window difference
+typedef ap_uint<CC_DCTCP_ALPHA_BITS+1>    CcAlpha;  // A DCTCP 'alpha' in [0..1]
+
+/*******************************************************************************
+ * Congestion Control Table (CCo)
+ *  Structure to maintain the congestion state of a session. The congestion
+ *  window and the slow start threshold are mirrored into the Tx SAR table
+ *  (TSt), but only the CCo knows the algorithm specific state.
+ *  FYI - A retransmission timeout is processed by [TXe] which resets the
+ *   window held by [TSt]. The CCo is told about such a timeout by the 'rto'
+ *   flag of the next write query of [RXe] (see tx_sar_table.hpp).
+ *******************************************************************************/
+class CcEntry {
+  public:
+    LocalWinSize    cwnd;        // Congestion window as last written into [TSt]
+    LocalWinSize    ssthresh;    // Slow start threshold
+    ap_uint<TOE_WINDOW_BITS+1>
+                    bytesAcked;  // Bytes ACK'ed since last increase (RFC-3465)
+    //-- CUBIC
+    LocalWinSize    wMax;        // Window size before the last reduction
+    CcTime          epoch;       // Start of the current avoidance epoch
+    CcCubeRt        k;           // Time period to grow back to 'wMax'
+    bool            epochValid;  // An avoidance epoch was started
+    //-- DCTCP
+    CcAlpha         alpha;       // Estimate of the fraction of marked bytes
+    ap_uint<TOE_WINDOW_BITS+1>
+                    winAcked;    // Bytes ACK'ed in the current observation window
+    ap_uint<TOE_WINDOW_BITS+1>
+                    winMarked;   // Bytes ACK'ed with ECE in this window
+    CcEntry() {}
+};
+
+/*******************************************************************************
+ * CONGESTION CONTROL - PROTOTYPE DEFINITIONS
+ *******************************************************************************/
+void ccInit(
+        CcEntry        &entry);
+
+bool ccUpdate(
+        int             algo,
+        CcEntry        &entry,
+        CcEvent         event,
+        TcpWinSize      ackedBytes,
+        TcpCtrlBit      ece,
+        bool            rto,
+        LocalWinSize    tstCwnd,
+        LocalWinSize    tstSsthresh,
+        CcTime          now);
+
+/*******************************************************************************
+ *
+ * @brief ENTITY - Congestion Control (CCo)
+ *
+ *******************************************************************************/
+void congestion_control(
+        //-- Rx Engine Interface
+        stream<RXeTxSarQuery>      &siRXe_TxSarQry,
+        //-- Tx SAR Table Interface
+        stream<RXeTxSarQuery>      &soTSt_TxSarQry
+);
+
+#endif
+
+/*! \} */
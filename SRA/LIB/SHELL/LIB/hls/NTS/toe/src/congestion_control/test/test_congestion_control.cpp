@@ -0,0 +1,380 @@
+/*
+ * Copyright 2016 -- 2021 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*******************************************************************************
+ * @file       : test_congestion_control.cpp
+ * @brief      : Testbench for the Congestion Control (CCo) function of TOE.
+ *
+ * System:     : cloudFPGA
+ * Component   : Shell, Network Transport Stack, TCP Offload Engine (TOE)
+ * Language    : Vivado HLS
+ *
+ * \ingroup NTS_TOE
+ * \addtogroup NTS_TOE_TEST
+ * \{
+ *******************************************************************************/
+
+#include "test_congestion_control.hpp"
+
+using namespace hls;
+using namespace std;
+
+//---------------------------------------------------------
+// HELPERS FOR THE DEBUGGING TRACES
+//  .e.g: DEBUG_LEVEL = (TRACE_CWND)
+//---------------------------------------------------------
+#define THIS_NAME "TB"
+
+#define TRACE_OFF    0x0000
+#define TRACE_CWND   1 << 1
+#define TRACE_ALL    0xFFFF
+#define DEBUG_LEVEL (TRACE_OFF)
+
+/*******************************************************************************
+ * @brief Increment the simulation counter
+ *******************************************************************************/
+void stepSim() {
+    gSimCycCnt++;
+    if (gTraceEvent) {
+        printInfo(THIS_NAME, "-- [@%4.4d] -----------------------------\n", gSimCycCnt);
+        gTraceEvent = false;
+    }
+}
+
+/*******************************************************************************
+ * @brief Returns true if a round is listed in a vector of rounds.
+ *******************************************************************************/
+bool isListed(vector<unsigned int> &rounds, unsigned int round) {
+    for (unsigned int i=0; i<rounds.size(); i++) {
+        if (rounds[i] == round) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*******************************************************************************
+ * @brief Returns the name of a congestion control algorithm.
+ *******************************************************************************/
+const char *getAlgoName(int algo) {
+    switch (algo) {
+    case TOE_CC_CUBIC: return "cubic";
+    case TOE_CC_DCTCP: return "dctcp";
+    default:           return "reno";
+    }
+}
+
+/*******************************************************************************
+ * @brief Reads a congestion trace from a test vector file.
+ *
+ * @param[in]  inpFileName The name of the test vector file.
+ * @param[out] trace       The trace to fill in.
+ *
+ * @return true if the file was successfully parsed.
+ *
+ * @details
+ *  A global parameter, a testbench command or a comment line must start with
+ *   a single character (G|>|#) followed by a space character.
+ *  Examples:
+ *    G PARAM Rounds   <NUM>             --> Number of RTT rounds to play.
+ *    G PARAM RttTicks <NUM>             --> Duration of a round in CCo ticks.
+ *    > LOSS <ROUND>                     --> A segment is lost in round <ROUND>.
+ *    > RTO  <ROUND>                     --> A retransmission timeout fires in round <ROUND>.
+ *    > ECN  <FROM> <TO> <QUEUE_BYTES>   --> Bytes beyond <QUEUE_BYTES> are CE marked.
+ *******************************************************************************/
+bool readTrace(const char *inpFileName, CcTrace &trace) {
+    const char *myName = concat3(THIS_NAME, "/", "readTrace");
+
+    ifstream        inpFileStream;
+    string          strLine;
+    vector<string>  stringVector;
+
+    inpFileStream.open(inpFileName);
+    if (!inpFileStream) {
+        printError(myName, "Cannot open the file: \'%s\'.\n", inpFileName);
+        return false;
+    }
+    while (getline(inpFileStream, strLine)) {
+        stringVector = myTokenizer(strLine, ' ');
+        if (stringVector.empty() or (stringVector[0] == "") or (stringVector[0] == "#")) {
+            continue;
+        }
+        else if ((stringVector[0] == "G") and (stringVector.size() >= 4) and (stringVector[1] == "PARAM")) {
+            if (stringVector[2] == "Rounds") {
+                gNrRounds = atoi(stringVector[3].c_str());
+            }
+            else if (stringVector[2] == "RttTicks") {
+                gRttTicks = atoi(stringVector[3].c_str());
+            }
+        }
+        else if ((stringVector[0] == ">") and (stringVector.size() >= 3)) {
+            if (stringVector[1] == "LOSS") {
+                trace.lossRounds.push_back(atoi(stringVector[2].c_str()));
+            }
+            else if (stringVector[1] == "RTO") {
+                trace.rtoRounds.push_back(atoi(stringVector[2].c_str()));
+            }
+            else if ((stringVector[1] == "ECN") and (stringVector.size() >= 5)) {
+                trace.ecnFrom.push_back(atoi(stringVector[2].c_str()));
+                trace.ecnTo.push_back(atoi(stringVector[3].c_str()));
+                trace.ecnQueue.push_back(atoi(stringVector[4].c_str()));
+            }
+        }
+        else {
+            printError(myName, "Cannot parse the line: \'%s\'.\n", strLine.c_str());
+            inpFileStream.close();
+            return false;
+        }
+    }
+    inpFileStream.close();
+    return true;
+}
+
+/*******************************************************************************
+ * @brief Plays a congestion trace back with one algorithm.
+ *
+ * @param[in] algo        The congestion control algorithm (TOE_CC_xxx).
+ * @param[in] trace       The congestion trace to play.
+ * @param[in] outFileName The name of the output file (gnuplot format).
+ *
+ * @return the number of detected errors.
+ *
+ * @details
+ *  Each round sends one congestion window worth of full-sized segments and
+ *   receives one ACK per segment. The ACKs are spread over the duration of
+ *   the round, and the window held by [TSt] is emulated the same way as the
+ *   window written back by the CCo process.
+ *  The evolution of the window is written into the output file with one line
+ *   per round as '<round> <cwnd> <ssthresh> <alpha>', and is plotted in ASCII.
+ *******************************************************************************/
+int playTrace(int algo, CcTrace &trace, const char *outFileName) {
+    char myName[40];
+    sprintf(myName, "%s/%s", THIS_NAME, getAlgoName(algo));
+
+    int             nrErr = 0;
+    ofstream        outFileStream;
+    CcEntry         entry;
+    LocalWinSize    tstCwnd;
+    LocalWinSize    tstSsthresh;
+    LocalWinSize    cwndBefore;
+    LocalWinSize    expected;
+    unsigned int    nrAcks;
+    bool            ece;
+    bool            rtoPending = false;  // A timeout was not yet checked
+    bool            rtoSignal  = false;  // A timeout was not yet reported to the CCo
+    LocalWinSize    ssthreshRto;
+
+    outFileStream.open(outFileName);
+    if (!outFileStream) {
+        printError(myName, "Cannot open the file: \'%s\'.\n", outFileName);
+        return 1;
+    }
+    outFileStream << "# Round  CongWindow  SsThresh  Alpha (" << getAlgoName(algo) << ")" << endl;
+
+    //-- Connection setup
+    ccUpdate(algo, entry, CC_INIT, 0, 0, false, 0, 0, 0);
+    tstCwnd     = entry.cwnd;
+    tstSsthresh = entry.ssthresh;
+
+    for (unsigned int round=0; round<gNrRounds; round++) {
+        CcTime now = round * gRttTicks;
+
+        //-- Retransmission timeout: [TXe] resets the window held by [TSt]
+        if (isListed(trace.rtoRounds, round)) {
+            tstSsthresh = ((entry.cwnd >> 1) < 2*ZYC2_MSS) ? (LocalWinSize)(2*ZYC2_MSS) :
+                                                             (LocalWinSize)(entry.cwnd >> 1);
+            tstCwnd     = TOE_INIT_CONGESTION_WINDOW;
+            rtoPending  = true;
+            rtoSignal   = true;
+            if (algo == TOE_CC_CUBIC) {
+                ssthreshRto = (entry.cwnd * CC_CUBIC_BETA) >> 8;
+                if (ssthreshRto < 2*ZYC2_MSS) {
+                    ssthreshRto = 2*ZYC2_MSS;
+                }
+            }
+            else {
+                ssthreshRto = tstSsthresh;
+            }
+            gTraceEvent = true;
+            printInfo(myName, "Round #%3d - RTO  - CongWindow=%6d\n", round, entry.cwnd.to_uint());
+        }
+
+        //-- Fast retransmit: [RXe] received a third duplicate ACK
+        if (isListed(trace.lossRounds, round)) {
+            cwndBefore = entry.cwnd;
+            ccUpdate(algo, entry, CC_DUP_ACK, 0, 0, rtoSignal, tstCwnd, tstSsthresh, now);
+            rtoSignal = false;
+            tstCwnd  = entry.cwnd;
+            if (algo == TOE_CC_CUBIC) {
+                expected = (cwndBefore * CC_CUBIC_BETA) >> 8;
+            }
+            else {
+                expected = cwndBefore >> 1;
+            }
+            if (expected < 2*ZYC2_MSS) {
+                expected = 2*ZYC2_MSS;
+            }
+            gTraceEvent = true;
+            printInfo(myName, "Round #%3d - LOSS - CongWindow=%6d -> %6d\n", round,
+                      cwndBefore.to_uint(), entry.cwnd.to_uint());
+            if (entry.cwnd != expected) {
+                printError(myName, "Wrong window after a loss (expected=%d).\n", expected.to_uint());
+                nrErr++;
+            }
+        }
+
+        //-- Send one window and receive its ACKs
+        nrAcks = entry.cwnd / ZYC2_MSS;
+        if (nrAcks == 0) {
+            nrAcks = 1;
+        }
+        for (unsigned int ack=0; ack<nrAcks; ack++) {
+            ece = false;
+            for (unsigned int i=0; i<trace.ecnFrom.size(); i++) {
+                if ((round >= trace.ecnFrom[i]) and (round <= trace.ecnTo[i]) and
+                    ((ack+1)*ZYC2_MSS > trace.ecnQueue[i])) {
+                    ece = true;
+                }
+            }
+            cwndBefore = entry.cwnd;
+            ccUpdate(algo, entry, CC_NEW_ACK, ZYC2_MSS, ece, rtoSignal, tstCwnd, tstSsthresh,
+                     now + (ack * gRttTicks) / nrAcks);
+            rtoSignal = false;
+            tstCwnd = entry.cwnd;
+            stepSim();
+            if (rtoPending) {
+                rtoPending = false;
+                if ((entry.cwnd < TOE_INIT_CONGESTION_WINDOW) or
+                    (entry.cwnd > TOE_INIT_CONGESTION_WINDOW + ZYC2_MSS)) {
+                    printError(myName, "Wrong window after a timeout (cwnd=%d).\n", entry.cwnd.to_uint());
+                    nrErr++;
+                }
+                //  Also catches a timeout which fires while the window is the initial one
+                if (entry.ssthresh != ssthreshRto) {
+                    printError(myName, "Wrong threshold after a timeout (ssthresh=%d, expected=%d).\n",
+                               entry.ssthresh.to_uint(), ssthreshRto.to_uint());
+                    nrErr++;
+                }
+            }
+            else if ((algo != TOE_CC_DCTCP) and (entry.cwnd < cwndBefore)) {
+                printError(myName, "The window decreased on a new ACK (%d -> %d).\n",
+                           cwndBefore.to_uint(), entry.cwnd.to_uint());
+                nrErr++;
+            }
+            if (entry.cwnd > TOE_MAX_CONGESTION_WINDOW) {
+                printError(myName, "The window exceeds its maximum (cwnd=%d).\n", entry.cwnd.to_uint());
+                nrErr++;
+            }
+            if (entry.cwnd < 2*ZYC2_MSS) {
+                printError(myName, "The window is less than 2 x MSS (cwnd=%d).\n", entry.cwnd.to_uint());
+                nrErr++;
+            }
+        }
+
+        outFileStream << round << " " << entry.cwnd.to_uint() << " "
+                      << entry.ssthresh.to_uint() << " " << entry.alpha.to_uint() << endl;
+
+        //-- ASCII plot (one line every 4 rounds)
+        if ((round % 4) == 0) {
+            string bar((entry.cwnd.to_uint() * TB_PLOT_WIDTH) / TOE_MAX_CONGESTION_WINDOW, '*');
+            printf("[%5s] %3d |%-*s| %6d\n", getAlgoName(algo), round, TB_PLOT_WIDTH,
+                   bar.c_str(), entry.cwnd.to_uint());
+        }
+    }
+    outFileStream.close();
+
+    if (algo == TOE_CC_DCTCP) {
+        if (!trace.ecnFrom.empty()) {
+            if ((entry.alpha == 0) or (entry.alpha >= CC_DCTCP_ALPHA_ONE)) {
+                printError(myName, "Alpha did not converge (alpha=%d).\n", entry.alpha.to_uint());
+                nrErr++;
+            }
+        }
+        printInfo(myName, "Final alpha = %d/%d\n", entry.alpha.to_uint(), CC_DCTCP_ALPHA_ONE);
+    }
+    printInfo(myName, "Final window = %d bytes (%s)\n", entry.cwnd.to_uint(), outFileName);
+    return nrErr;
+}
+
+/*******************************************************************************
+ * @brief Main function.
+ *
+ * @param[in] argv[1]  The congestion trace to play (.e.g 'ccLoss.dat').
+ *
+ * @details
+ *  The trace is played back once per algorithm, and the evolution of the
+ *   window is written into 'simOutFiles/cwnd_<algo>.dat'.
+ *  Plot example (gnuplot):
+ *   plot 'cwnd_reno.dat' u 1:2 w l, 'cwnd_cubic.dat' u 1:2 w l, 'cwnd_dctcp.dat' u 1:2 w l
+ *******************************************************************************/
+int main(int argc, char* argv[])
+{
+    //------------------------------------------------------
+    //-- TESTBENCH GLOBAL VARIABLES
+    //------------------------------------------------------
+    gTraceEvent   = false;
+    gFatalError   = false;
+    gSimCycCnt    = 0;
+
+    //------------------------------------------------------
+    //-- TESTBENCH LOCAL VARIABLES
+    //------------------------------------------------------
+    int          nrErr = 0;     // Tb error counter.
+    CcTrace      trace;
+    const int    algos[3]   = { TOE_CC_RENO, TOE_CC_CUBIC, TOE_CC_DCTCP };
+    const char  *ofNames[3] = { "../../../../test/simOutFiles/cwnd_reno.dat",
+                                "../../../../test/simOutFiles/cwnd_cubic.dat",
+                                "../../../../test/simOutFiles/cwnd_dctcp.dat" };
+
+    printInfo(THIS_NAME, "############################################################################\n");
+    printInfo(THIS_NAME, "## TESTBENCH 'test_congestion_control' STARTS HERE                        ##\n");
+    printInfo(THIS_NAME, "############################################################################\n");
+
+    if (argc < 2) {
+        printFatal(THIS_NAME, "Expected a minimum of 1 parameter with the following synopsis:\n \t<TraceFile>\n");
+    }
+    printInfo(THIS_NAME, "This run executes with trace file : %s.\n", argv[1]);
+    if (not readTrace(argv[1], trace)) {
+        printFatal(THIS_NAME, "Cannot read the trace file. \n");
+    }
+    printInfo(THIS_NAME, "Playing %d rounds of %d ticks (%d losses, %d timeouts, %d ECN periods).\n",
+              gNrRounds, gRttTicks, (int)trace.lossRounds.size(), (int)trace.rtoRounds.size(),
+              (int)trace.ecnFrom.size());
+
+    for (int i=0; i<3; i++) {
+        nrErr += playTrace(algos[i], trace, ofNames[i]);
+    }
+
+    //---------------------------------------------------------------
+    //-- PRINT OVERALL TESTBENCH STATUS
+    //---------------------------------------------------------------
+    if (nrErr) {
+        printError(THIS_NAME, "###########################################################\n");
+        printError(THIS_NAME, "#### TEST BENCH FAILED : TOTAL NUMBER OF ERROR(S) = %2d ####\n", nrErr);
+        printError(THIS_NAME, "###########################################################\n\n");
+
+        printInfo(THIS_NAME, "FYI - You may want to check for \'ERROR\' and/or \'WARNING\' alarms in the LOG file...\n\n");
+    }
+    else {
+        printInfo(THIS_NAME, "#############################################################\n");
+        printInfo(THIS_NAME, "####               SUCCESSFUL END OF TEST                ####\n");
+        printInfo(THIS_NAME, "#############################################################\n");
+    }
+
+    return nrErr;
+}
+
+/*! \} */
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2016 -- 2021 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*****************************************************************************
+ * @file     : test_congestion_control.hpp
+ * @brief    : Testbench for the Congestion Control (CCo) function of TOE.
+ *
+ * System:     : cloudFPGA
+ * Component   : Shell, Network Transport Stack, TCP Offload Engine (TOE)
+ * Language    : Vivado HLS
+ *
+ * \ingroup NTS_TOE
+ * \addtogroup NTS_TOE_TEST
+ * \{
+ *****************************************************************************/
+
+#ifndef _TEST_CONGESTION_CONTROL_H_
+#define _TEST_CONGESTION_CONTROL_H_
+
+#include <fstream>
+#include <vector>
+
+#include "../src/congestion_control.hpp"
+#include "../../../../../NTS/SimNtsUtils.hpp"
+
+//---------------------------------------------------------
+//-- TESTBENCH GLOBAL DEFINES
+//---------------------------------------------------------
+#define TB_DEFAULT_ROUNDS     200  // Default number of RTT rounds to play
+#define TB_DEFAULT_RTT_TICKS    2  // Default RTT in CCo ticks (.i.e ~52us)
+#define TB_PLOT_WIDTH          64  // Width of the ASCII plot of the window
+
+//---------------------------------------------------------
+//-- TESTBENCH GLOBAL VARIABLES
+//--  These variables might be updated/overwritten by the
+//--  content of a test-vector file.
+//---------------------------------------------------------
+bool            gTraceEvent   = false;
+bool            gFatalError   = false;
+unsigned int    gSimCycCnt    = 0;
+unsigned int    gNrRounds     = TB_DEFAULT_ROUNDS;
+unsigned int    gRttTicks     = TB_DEFAULT_RTT_TICKS;
+
+/*******************************************************************************
+ * A congestion trace as played back by the testbench.
+ *  A LOSS is signaled by a third duplicate ACK at the beginning of a round.
+ *  A RTO is signaled by a reset of the window held by [TSt].
+ *  During an ECN period, the bytes sent beyond 'queueBytes' in a round are
+ *   marked as if they had built a queue in the switch.
+ *******************************************************************************/
+class CcTrace {
+  public:
+    std::vector<unsigned int> lossRounds;
+    std::vector<unsigned int> rtoRounds;
+    std::vector<unsigned int> ecnFrom;
+    std::vector<unsigned int> ecnTo;
+    std::vector<unsigned int> ecnQueue;
+};
+
+#endif
+
+/*! \} */
@@ -75,8 +75,47 @@ using namespace hls;
 #define DEBUG_LEVEL (TRACE_OFF)
 
 
+#ifndef __SYNTHESIS__
+  //-- The number of dispatched and coalesced events (for the testbench only)
+  static unsigned int eveNrDispatched = 0;
+  static unsigned int eveNrCoalesced  = 0;
+
+  /*****************************************************************************
+   * @brief Return the number of events dispatched to [AKd] and the number of
+   *         redundant events that were coalesced by the Event Engine.
+   *
+   * @param[out] nrDispatched  The number of events forwarded to [AKd].
+   * @param[out] nrCoalesced   The number of events dropped by the coalescing.
+   *****************************************************************************/
+  void getEventEngineStats(unsigned int &nrDispatched, unsigned int &nrCoalesced) {
+      nrDispatched = eveNrDispatched;
+      nrCoalesced  = eveNrCoalesced;
+  }
+#endif
+
+/*******************************************************************************
+ * @brief Returns the queue of the Event Engine that an event belongs to.
+ *
+ * @param[in]  evType  The type of the event.
+ *******************************************************************************/
+EveQueueId getEventQueue(EventType evType) {
+    #pragma HLS INLINE
+    switch (evType) {
+    case TX_EVENT:
+    case TX_BYPASS_EVENT:
+        return EVE_TX_QUEUE;
+    case RT_EVENT:
+        return EVE_RT_QUEUE;
+    case ACK_EVENT:
+    case ACK_NODELAY_EVENT:
+        return EVE_ACK_QUEUE;
+    default:
+        return EVE_CTL_QUEUE;
+    }
+}
+
 /*******************************************************************************
- * @brief The Event Engine (EVe) arbitrates the incoming events and forwards
+ * @brief The Event Engine (EVe) schedules the incoming events and forwards
  *         them to the Tx Engine (TXe) via the ACK Delayer (AKd).
  *
  * @param[in]  siTAi_Event      Event from TxApplicationInterface (TAi).
@@ -86,6 +125,27 @@ using namespace hls;
  * @param[in]  siAKd_RxEventSig The AckDelayer just received an event.
  * @param[in]  siAKd_TxEventSig The AckDelayer just forwarded an event.
  * @param[in]  siTXe_RxEventSig The TxEngine (TXe) just received an event.
+ *
+ * @details
+ *  The incoming events are sorted into one queue per class of event (see
+ *   EVE_XXX_QUEUE) and one event is dispatched per cycle. The control, the ACK
+ *   and the retransmission queues are served by strict priority, but a waiting
+ *   TX event never gets overtaken by more than EVE_TX_MAX_SKIP events.
+ *  A TX event is coalesced (i.e. dropped) if another TX event is still queued
+ *   for the same session. This is safe because [TXe] always sends the data up
+ *   to the latest 'app' pointer of a session when it processes such an event.
+ *   The slot of the last TX event queued for a session is kept in the BRAM
+ *   table TX_SLOT_TABLE. That event is still pending if its slot lies between
+ *   the read and the write pointers of the TX queue and if the slot still
+ *   holds a TX event of the same session (see 'eve_txSlotSess').
+ *   The TX_BYPASS events are never coalesced because each of them matches a
+ *   message streamed by [TAi] to [TXe]. The ACK events are coalesced by [AKd]
+ *   which counts the segments they stand for.
+ *  The number of events in flight towards [TXe] is tracked with the signals
+ *   received from [AKd] and [TXe]. The retransmission and the TX events are
+ *   held back once TOE_EVE_IN_FLIGHT events are in flight, such that [TXe]
+ *   always has an event ready while a control or an ACK event never waits
+ *   behind more than TOE_EVE_IN_FLIGHT events.
  *******************************************************************************/
 void event_engine(
         stream<Event>           &siTAi_Event,
@@ -101,6 +161,14 @@ void event_engine(
 
     const char *myName  = THIS_NAME;
 
+    //-- STATIC ARRAYS ---------------------------------------------------------
+    static ExtendedEvent         EVENT_QUEUE[EVE_NR_QUEUES][EVE_QUEUE_DEPTH];
+    #pragma HLS ARRAY_PARTITION variable=EVENT_QUEUE complete dim=1
+    #pragma HLS DEPENDENCE      variable=EVENT_QUEUE inter false
+    static EveQueueSlot          TX_SLOT_TABLE[TOE_MAX_SESSIONS];
+    #pragma HLS RESOURCE        variable=TX_SLOT_TABLE core=RAM_T2P_BRAM
+    #pragma HLS DEPENDENCE      variable=TX_SLOT_TABLE inter false
+
     //-- STATIC CONTROL VARIABLES (with RESET) ---------------------------------
     //---- Warning: the following counters depend on the FiFo depth between EVe and AKd
     static ap_uint<8>            eve_eve2akd_WrCnt; // #events forwarded by [EVe] to   [AKd]
@@ -111,52 +179,198 @@ void event_engine(
     #pragma HLS RESET variable = eve_akd2txe_WrCnt
     static ap_uint<8>            eve_akd2txe_RdCnt; // #events received  by [TXe] from [Akd]
     #pragma HLS RESET variable = eve_akd2txe_RdCnt
+    static EveQueuePtr           eve_wrPtr[EVE_NR_QUEUES];
+    #pragma HLS ARRAY_PARTITION variable=eve_wrPtr complete
+    #pragma HLS RESET           variable=eve_wrPtr
+    static EveQueuePtr           eve_rdPtr[EVE_NR_QUEUES];
+    #pragma HLS ARRAY_PARTITION variable=eve_rdPtr complete
+    #pragma HLS RESET           variable=eve_rdPtr
+    static ap_uint<3>            eve_txSkipCnt;      // #events dispatched ahead of a waiting TX event
+    #pragma HLS RESET variable = eve_txSkipCnt
+    static bool                  eve_rxeEvValid=false;
+    #pragma HLS RESET variable = eve_rxeEvValid
+    static bool                  eve_timEvValid=false;
+    #pragma HLS RESET variable = eve_timEvValid
+    static bool                  eve_taiEvValid=false;
+    #pragma HLS RESET variable = eve_taiEvValid
+    static bool                  eve_qWrValid=false;  // An event was queued in the previous cycle
+    #pragma HLS RESET variable = eve_qWrValid
+    static bool                  eve_txWrValid=false; // A TX slot was recorded in the previous cycle
+    #pragma HLS RESET variable = eve_txWrValid
+
+    //-- STATIC DATAFLOW VARIABLES ---------------------------------------------
+    static ExtendedEvent         eve_rxeEv;  // The next event from [RXe]
+    static ExtendedEvent         eve_timEv;  // The next event from [TIm]
+    static ExtendedEvent         eve_taiEv;  // The next event from [TAi]
+    static SessionId             eve_txSlotSess[EVE_QUEUE_DEPTH];  // The session of the TX event in slot #n
+    #pragma HLS ARRAY_PARTITION variable=eve_txSlotSess complete
+    static bool                  eve_txSlotIsTx[EVE_QUEUE_DEPTH];  // Slot #n holds a TX_EVENT (not a TX_BYPASS)
+    #pragma HLS ARRAY_PARTITION variable=eve_txSlotIsTx complete
+    static EveQueueId            eve_qWrQid;    // The queue written in the previous cycle
+    static EveQueueSlot          eve_qWrSlot;   // The slot  written in the previous cycle
+    static ExtendedEvent         eve_qWrEv;     // The event written in the previous cycle
+    static SessionId             eve_txWrSess;  // The session of the TX slot recorded in the previous cycle
+    static EveQueueSlot          eve_txWrSlot;  // The TX slot recorded in the previous cycle
 
     //-- DYNAMIC VARIABLES -----------------------------------------------------
     ExtendedEvent ev;
+    EveQueueId    qid;
+    bool          isEmpty[EVE_NR_QUEUES];
+    bool          isFull[EVE_NR_QUEUES];
+    bool          doEnqueue;
+    bool          qWrValid  = false;
+    bool          txWrValid = false;
+    EveQueueSlot  slot;
+    EveQueueSlot  txSlot;
+
+    for (int q=0; q<EVE_NR_QUEUES; ++q) {
+    #pragma HLS UNROLL
+        isEmpty[q] = (eve_wrPtr[q] == eve_rdPtr[q]);
+        isFull[q]  = (eve_wrPtr[q](EVE_QUEUE_BITS-1, 0) == eve_rdPtr[q](EVE_QUEUE_BITS-1, 0)) and !isEmpty[q];
+    }
 
     //------------------------------------------
-    // Handle input from [RxEngine]
+    // Dispatch the next event to [AckDelayer]
     //------------------------------------------
-    if (!siRXe_Event.empty() and !soAKd_Event.full()) {
-        siRXe_Event.read(ev);
+    ap_uint<8> inFlight = (ap_uint<8>)(eve_eve2akd_WrCnt - eve_eve2akd_RdCnt) +
+                          (ap_uint<8>)(eve_akd2txe_WrCnt - eve_akd2txe_RdCnt);
+    bool txeHasRoom = (inFlight < TOE_EVE_IN_FLIGHT);
+    bool doDispatch = true;
+    if (!isEmpty[EVE_TX_QUEUE] and txeHasRoom and (eve_txSkipCnt >= EVE_TX_MAX_SKIP)) {
+        qid = EVE_TX_QUEUE;
+    }
+    else if (!isEmpty[EVE_CTL_QUEUE]) {
+        qid = EVE_CTL_QUEUE;
+    }
+    else if (!isEmpty[EVE_ACK_QUEUE]) {
+        qid = EVE_ACK_QUEUE;
+    }
+    else if (!isEmpty[EVE_RT_QUEUE] and txeHasRoom) {
+        qid = EVE_RT_QUEUE;
+    }
+    else if (!isEmpty[EVE_TX_QUEUE] and txeHasRoom) {
+        qid = EVE_TX_QUEUE;
+    }
+    else {
+        doDispatch = false;
+    }
+    if (doDispatch and !soAKd_Event.full()) {
+        slot = eve_rdPtr[qid](EVE_QUEUE_BITS-1, 0);
+        if (eve_qWrValid and (eve_qWrQid == qid) and (eve_qWrSlot == slot)) {
+            // Bypass the slot that is still being written
+            ev = eve_qWrEv;
+        }
+        else {
+            ev = EVENT_QUEUE[qid][slot];
+        }
+        eve_rdPtr[qid]++;
+        assessSize(myName, soAKd_Event, "soAKd_Event", cDepth_EVeToAKd_Event);
         soAKd_Event.write(ev);
+        eve_eve2akd_WrCnt++;
+        if (qid == EVE_TX_QUEUE) {
+            eve_txSkipCnt = 0;
+        }
+        else if (!isEmpty[EVE_TX_QUEUE] and (eve_txSkipCnt < EVE_TX_MAX_SKIP)) {
+            eve_txSkipCnt++;
+        }
+        #ifndef __SYNTHESIS__
+        eveNrDispatched++;
+        #endif
         if (DEBUG_LEVEL & TRACE_EVE) {
-            printInfo(myName, "S%d - Received '%s' from [RXe] (WrCnt=%3d|RdCnt=%3d).\n",
-                      ev.sessionID.to_int(), getEventName(ev.type), eve_eve2akd_WrCnt.to_uint(), eve_eve2akd_RdCnt.to_uint());
+            printInfo(myName, "S%d - Dispatching '%s' from queue #%d (InFlight=%3d).\n",
+                      ev.sessionID.to_int(), getEventName(ev.type), qid.to_int(), inFlight.to_uint());
         }
-        eve_eve2akd_WrCnt++;
     }
-    else if (eve_eve2akd_WrCnt == eve_eve2akd_RdCnt and
-             eve_akd2txe_WrCnt == eve_akd2txe_RdCnt) {
-        //------------------------------------------
-        // Handle input from [Timers]
-        //   RetransmitTimer and ProbeTimer events have priority
-        //------------------------------------------
-        if (!siTIm_Event.empty()) {
-            siTIm_Event.read(ev);
-            soAKd_Event.write(ev);
+
+    //------------------------------------------
+    // Enqueue one event (RXe > TIm > TAi)
+    //------------------------------------------
+    doEnqueue = true;
+    if (eve_rxeEvValid and !isFull[getEventQueue(eve_rxeEv.type)]) {
+        ev = eve_rxeEv;
+        eve_rxeEvValid = false;
+    }
+    else if (eve_timEvValid and !isFull[getEventQueue(eve_timEv.type)]) {
+        ev = eve_timEv;
+        eve_timEvValid = false;
+    }
+    else if (eve_taiEvValid and !isFull[getEventQueue(eve_taiEv.type)]) {
+        ev = eve_taiEv;
+        eve_taiEvValid = false;
+    }
+    else {
+        doEnqueue = false;
+    }
+    if (doEnqueue) {
+        bool txPending = false;
+        if (ev.type == TX_EVENT) {
+            if (eve_txWrValid and (eve_txWrSess == ev.sessionID)) {
+                // Bypass the BRAM that is still being written
+                txSlot = eve_txWrSlot;
+            }
+            else {
+                txSlot = TX_SLOT_TABLE[ev.sessionID];
+            }
+            EveQueuePtr txDepth = eve_wrPtr[EVE_TX_QUEUE] - eve_rdPtr[EVE_TX_QUEUE];
+            EveQueuePtr txAge   = (EveQueueSlot)(txSlot - eve_rdPtr[EVE_TX_QUEUE](EVE_QUEUE_BITS-1, 0));
+            txPending = (txAge < txDepth) and eve_txSlotIsTx[txSlot] and
+                        (eve_txSlotSess[txSlot] == ev.sessionID);
+        }
+        if (txPending) {
+            //-- A TX event is still queued for this session
+            #ifndef __SYNTHESIS__
+            eveNrCoalesced++;
+            #endif
             if (DEBUG_LEVEL & TRACE_EVE) {
-                printInfo(myName, "S%d - Received '%s' from [TIm] (WrCnt=%3d|RdCnt=%3d).\n",
-                        ev.sessionID.to_int(), getEventName(ev.type), eve_eve2akd_WrCnt.to_uint(), eve_eve2akd_RdCnt.to_uint());
+                printInfo(myName, "S%d - Coalescing '%s'.\n",
+                          ev.sessionID.to_int(), getEventName(ev.type));
             }
-            eve_eve2akd_WrCnt++;
         }
-        //--------------------------------------------
-        // Handle input from [TcpApplicationInterface]
-        //--------------------------------------------
-        else if (!siTAi_Event.empty()) {
-            siTAi_Event.read(ev);
-            assessSize(myName, soAKd_Event, "soAKd_Event", cDepth_EVeToAKd_Event);
-            soAKd_Event.write(ev);
+        else {
+            qid  = getEventQueue(ev.type);
+            slot = eve_wrPtr[qid](EVE_QUEUE_BITS-1, 0);
+            EVENT_QUEUE[qid][slot] = ev;
+            eve_wrPtr[qid]++;
+            qWrValid   = true;
+            eve_qWrQid = qid;
+            eve_qWrSlot = slot;
+            eve_qWrEv   = ev;
+            if (qid == EVE_TX_QUEUE) {
+                eve_txSlotSess[slot] = ev.sessionID;
+                eve_txSlotIsTx[slot] = (ev.type == TX_EVENT);
+            }
+            if (ev.type == TX_EVENT) {
+                TX_SLOT_TABLE[ev.sessionID] = slot;
+                txWrValid    = true;
+                eve_txWrSess = ev.sessionID;
+                eve_txWrSlot = slot;
+            }
             if (DEBUG_LEVEL & TRACE_EVE) {
-                printInfo(myName, "S%d - Received '%s' from [TAi] (WrCnt=%3d|RdCnt=%3d).\n",
-                        ev.sessionID.to_int(), getEventName(ev.type), eve_eve2akd_WrCnt.to_uint(), eve_eve2akd_RdCnt.to_uint());
+                printInfo(myName, "S%d - Queuing '%s' into queue #%d.\n",
+                          ev.sessionID.to_int(), getEventName(ev.type), qid.to_int());
             }
-            eve_eve2akd_WrCnt++;
         }
     }
 
+    eve_qWrValid  = qWrValid;
+    eve_txWrValid = txWrValid;
+
+    //------------------------------------------
+    // Fetch the next event of every source
+    //------------------------------------------
+    if (!eve_rxeEvValid and !siRXe_Event.empty()) {
+        siRXe_Event.read(eve_rxeEv);
+        eve_rxeEvValid = true;
+    }
+    if (!eve_timEvValid and !siTIm_Event.empty()) {
+        eve_timEv = ExtendedEvent(siTIm_Event.read());
+        eve_timEvValid = true;
+    }
+    if (!eve_taiEvValid and !siTAi_Event.empty()) {
+        eve_taiEv = ExtendedEvent(siTAi_Event.read());
+        eve_taiEvValid = true;
+    }
+
     //------------------------------------------
     // Handle inputs from [AckDelayer]
     //------------------------------------------
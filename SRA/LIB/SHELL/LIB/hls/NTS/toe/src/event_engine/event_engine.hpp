@@ -62,6 +62,27 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 using namespace hls;
 
+/*******************************************************************************
+ * EVENT ENGINE - PARAMETERS
+ *
+ *  The incoming events are sorted into one queue per class of event. The
+ *   queues are listed in decreasing order of priority.
+ *******************************************************************************/
+#define EVE_NR_QUEUES    4
+#define EVE_CTL_QUEUE    0  // SYN, SYN_ACK, FIN and RST events
+#define EVE_ACK_QUEUE    1  // ACK and ACK_NODELAY events
+#define EVE_RT_QUEUE     2  // Retransmission events
+#define EVE_TX_QUEUE     3  // TX and TX_BYPASS events
+
+#define EVE_TX_MAX_SKIP  4  // Max. number of events dispatched ahead of a waiting TX event
+
+static const int EVE_QUEUE_BITS  = 4;
+static const int EVE_QUEUE_DEPTH = (1 << EVE_QUEUE_BITS); // 16 events per queue
+
+typedef ap_uint<2>                EveQueueId;
+typedef ap_uint<EVE_QUEUE_BITS+1> EveQueuePtr;  // One extra bit to tell a full queue from an empty one
+typedef ap_uint<EVE_QUEUE_BITS>   EveQueueSlot; // A slot of a queue
+
 
 /*******************************************************************************
  *
@@ -83,6 +104,10 @@ void event_engine(
         stream<SigBit>          &siTXe_RxEventSig
 );
 
+#ifndef __SYNTHESIS__
+  void getEventEngineStats(unsigned int &nrDispatched, unsigned int &nrCoalesced);
+#endif
+
 #endif
 
 /*! \} */
@@ -0,0 +1,257 @@
+/*
+ * Copyright 2016 -- 2021 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*******************************************************************************
+ * @file       : onchip_buffer.cpp
+ * @brief      : On-Chip Buffer (OCb) of the TCP Offload Engine (TOE)
+ *
+ * System:     : cloudFPGA
+ * Component   : Shell, Network Transport Stack (NTS)
+ * Language    : Vivado HLS
+ *
+ * \ingroup NTS
+ * \addtogroup NTS_TOE
+ * \{
+ *******************************************************************************/
+
+#include "onchip_buffer.hpp"
+
+using namespace hls;
+
+/************************************************
+ * HELPERS FOR THE DEBUGGING TRACES
+ *  .e.g: DEBUG_LEVEL = (TRACE_WR | TRACE_RD)
+ ************************************************/
+#ifndef __SYNTHESIS__
+  extern bool gTraceEvent;
+#endif
+
+#define THIS_NAME "TOE/OCb"
+
+#define TRACE_OFF  0x0000
+#define TRACE_WR  1 <<  1
+#define TRACE_RD  1 <<  2
+#define TRACE_ALL  0xFFFF
+
+#define DEBUG_LEVEL (TRACE_OFF)
+
+
+/*******************************************************************************
+ * @brief Buffer Memory (Bme) of one path.
+ *
+ * @param[in]  siWrCmd   Memory write command (one per buffer write).
+ * @param[in]  siWrData  The data chunks to write.
+ * @param[out] soWrSts   Memory write status (one per write command).
+ * @param[in]  siRdCmd   Memory read command (one per buffer read).
+ * @param[out] soRdData  The data chunks read from the buffer.
+ *
+ * @details
+ *  This process implements the subset of the data mover protocol (c.f PG022)
+ *   that is used by the TOE, on top of an on-chip buffer pool. A write command
+ *   is followed by 'btt' bytes of left-aligned chunks and is acknowledged with
+ *   a status as soon as its last chunk is written. A read command returns
+ *   'btt' bytes of left-aligned chunks, the last of which has its 'tlast' set.
+ *  The write and the read sides run concurrently, one chunk per cycle each.
+ *   This is safe because the TOE never reads a buffer area before the status
+ *   of its write was received.
+ *  The template parameter is only used to get one buffer pool per path.
+ *******************************************************************************/
+template<int PATH>
+void pBufferMemory(
+        stream<DmCmd>       &siWrCmd,
+        stream<AxisApp>     &siWrData,
+        stream<DmSts>       &soWrSts,
+        stream<DmCmd>       &siRdCmd,
+        stream<AxisApp>     &soRdData)
+{
+    //-- DIRECTIVES FOR THIS PROCESS -------------------------------------------
+    #pragma HLS INLINE off
+    #pragma HLS PIPELINE II=1 enable_flush
+
+    const char *myName = (PATH == OCB_RX_PATH) ? concat3(THIS_NAME, "/", "RxBme") :
+                                                 concat3(THIS_NAME, "/", "TxBme");
+
+    //-- STATIC ARRAYS ---------------------------------------------------------
+    static OcbByte                  BUFFER[8][OCB_LANE_DEPTH];
+    #pragma HLS ARRAY_PARTITION variable=BUFFER complete dim=1
+    #if (TOE_BUFFER_MEMORY == TOE_BUFFER_URAM)
+    #pragma HLS RESOURCE        variable=BUFFER core=RAM_S2P_URAM
+    #else
+    #pragma HLS RESOURCE        variable=BUFFER core=RAM_S2P_BRAM
+    #endif
+    #pragma HLS DEPENDENCE      variable=BUFFER inter false
+
+    //-- STATIC CONTROL VARIABLES (with RESET) ---------------------------------
+    static enum WrFsmState { BME_WR_IDLE=0, BME_WR_DATA } \
+                               bme_wrFsmState=BME_WR_IDLE;
+    #pragma HLS RESET variable=bme_wrFsmState
+    static enum RdFsmState { BME_RD_IDLE=0, BME_RD_DATA } \
+                               bme_rdFsmState=BME_RD_IDLE;
+    #pragma HLS RESET variable=bme_rdFsmState
+
+    //-- STATIC DATAFLOW VARIABLES ---------------------------------------------
+    static OcbAdr       bme_wrAdr;
+    static ap_uint<23>  bme_wrCnt;  // The number of bytes left to write
+    static OcbAdr       bme_rdAdr;
+    static ap_uint<23>  bme_rdCnt;  // The number of bytes left to read
+
+    //-- DYNAMIC VARIABLES -----------------------------------------------------
+    DmCmd               memCmd;
+    DmSts               memSts;
+
+    //-----------------------------------------------------
+    //-- WRITE SIDE
+    //-----------------------------------------------------
+    switch (bme_wrFsmState) {
+    case BME_WR_IDLE:
+        if (!siWrCmd.empty()) {
+            siWrCmd.read(memCmd);
+            bme_wrAdr = memCmd.saddr(OCB_ADDR_BITS-1, 0);
+            bme_wrCnt = memCmd.btt;
+            bme_wrFsmState = BME_WR_DATA;
+            if (DEBUG_LEVEL & TRACE_WR) {
+                printInfo(myName, "Write command (addr=0x%8.8x, btt=%d).\n",
+                          memCmd.saddr(31, 0).to_uint(), memCmd.btt.to_uint());
+            }
+        }
+        break;
+    case BME_WR_DATA:
+        if (!siWrData.empty() and !soWrSts.full()) {
+            AxisApp wrChunk = siWrData.read();
+            for (int lane=0; lane<8; ++lane) {
+            #pragma HLS UNROLL
+                ap_uint<3> byteNum = lane - bme_wrAdr(2, 0);
+                OcbAdr     byteAdr = bme_wrAdr + byteNum;
+                if (wrChunk.getLE_TKeep()[byteNum]) {
+                    BUFFER[lane][byteAdr(OCB_ADDR_BITS-1, 3)] = wrChunk.getLE_TData(8*byteNum+7, 8*byteNum);
+                }
+            }
+            ap_uint<4> wrLen = wrChunk.getLen();
+            bme_wrAdr += wrLen;
+            if (wrChunk.getTLast() or (bme_wrCnt <= wrLen)) {
+                memSts.tag    = 0;
+                memSts.interr = 0;
+                memSts.decerr = 0;
+                memSts.slverr = 0;
+                memSts.okay   = (bme_wrCnt == wrLen) ? 1 : 0;
+                soWrSts.write(memSts);
+                bme_wrFsmState = BME_WR_IDLE;
+            }
+            bme_wrCnt -= wrLen;
+        }
+        break;
+    }
+
+    //-----------------------------------------------------
+    //-- READ SIDE
+    //-----------------------------------------------------
+    switch (bme_rdFsmState) {
+    case BME_RD_IDLE:
+        if (!siRdCmd.empty()) {
+            siRdCmd.read(memCmd);
+            bme_rdAdr = memCmd.saddr(OCB_ADDR_BITS-1, 0);
+            bme_rdCnt = memCmd.btt;
+            bme_rdFsmState = BME_RD_DATA;
+            if (DEBUG_LEVEL & TRACE_RD) {
+                printInfo(myName, "Read command (addr=0x%8.8x, btt=%d).\n",
+                          memCmd.saddr(31, 0).to_uint(), memCmd.btt.to_uint());
+            }
+        }
+        break;
+    case BME_RD_DATA:
+        if (!soRdData.full()) {
+            AxisApp rdChunk(0, 0, 0);
+            for (int lane=0; lane<8; ++lane) {
+            #pragma HLS UNROLL
+                ap_uint<3> byteNum = lane - bme_rdAdr(2, 0);
+                OcbAdr     byteAdr = bme_rdAdr + byteNum;
+                rdChunk.setLE_TData(BUFFER[lane][byteAdr(OCB_ADDR_BITS-1, 3)], 8*byteNum+7, 8*byteNum);
+            }
+            if (bme_rdCnt > 8) {
+                rdChunk.setLE_TKeep(0xFF);
+                rdChunk.setLE_TLast(0);
+                bme_rdAdr += 8;
+                bme_rdCnt -= 8;
+            }
+            else {
+                rdChunk.setLE_TKeep(lenToLE_tKeep(bme_rdCnt(3, 0)));
+                rdChunk.setTLast(TLAST);
+                bme_rdFsmState = BME_RD_IDLE;
+            }
+            soRdData.write(rdChunk);
+            if (DEBUG_LEVEL & TRACE_RD) { printAxisRaw(myName, "soRdData =", rdChunk); }
+        }
+        break;
+    }
+}
+
+/*******************************************************************************
+ * @brief The on-chip buffer (OCb) of the TCP Offload Engine (TOE)
+ *
+ * @param[in]  siRXe_WrCmd  Rx memory write command from RxEngine (RXe).
+ * @param[in]  siRXe_Data   Rx memory data from [RXe].
+ * @param[out] soRXe_WrSts  Rx memory write status to [RXe].
+ * @param[in]  siRAi_RdCmd  Rx memory read command from RxAppInterface (RAi).
+ * @param[out] soRAi_Data   Rx memory data to [RAi].
+ * @param[in]  siTAi_WrCmd  Tx memory write command from TxAppInterface (TAi).
+ * @param[in]  siTAi_Data   Tx memory data from [TAi].
+ * @param[out] soTAi_WrSts  Tx memory write status to [TAi].
+ * @param[in]  siTXe_RdCmd  Tx memory read command from TxEngine (TXe).
+ * @param[out] soTXe_Data   Tx memory data to [TXe].
+ *
+ * @details
+ *  This entity replaces the external DDR memory and its data movers when the
+ *   TOE is built with 'TOE_BUFFER_MEMORY' set to 'TOE_BUFFER_BRAM' or to
+ *   'TOE_BUFFER_URAM'. It serves the Rx and the Tx buffers of the TOE with the
+ *   same command/status protocol as [MEM], but without the latency of the DDR.
+ *   The price to pay is a window of 2^TOE_ONCHIP_WINDOW_BITS bytes per session.
+ *******************************************************************************/
+void onchip_buffer(
+        //-- Rx Path
+        stream<DmCmd>           &siRXe_WrCmd,
+        stream<AxisApp>         &siRXe_Data,
+        stream<DmSts>           &soRXe_WrSts,
+        stream<DmCmd>           &siRAi_RdCmd,
+        stream<AxisApp>         &soRAi_Data,
+        //-- Tx Path
+        stream<DmCmd>           &siTAi_WrCmd,
+        stream<AxisApp>         &siTAi_Data,
+        stream<DmSts>           &soTAi_WrSts,
+        stream<DmCmd>           &siTXe_RdCmd,
+        stream<AxisApp>         &soTXe_Data)
+{
+    //-- DIRECTIVES FOR THE INTERFACES ----------------------------------------
+    #pragma HLS DATAFLOW
+    #pragma HLS INTERFACE ap_ctrl_none port=return
+
+    //-- Rx Buffer Memory (RxBme) ------------------------------------------
+    pBufferMemory<OCB_RX_PATH>(
+            siRXe_WrCmd,
+            siRXe_Data,
+            soRXe_WrSts,
+            siRAi_RdCmd,
+            soRAi_Data);
+
+    //-- Tx Buffer Memory (TxBme) ------------------------------------------
+    pBufferMemory<OCB_TX_PATH>(
+            siTAi_WrCmd,
+            siTAi_Data,
+            soTAi_WrSts,
+            siTXe_RdCmd,
+            soTXe_Data);
+}
+
+/*! \} */
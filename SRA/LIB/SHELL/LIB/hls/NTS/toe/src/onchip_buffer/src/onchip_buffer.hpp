@@ -0,0 +1,79 @@
+/*
+ * Copyright 2016 -- 2021 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*******************************************************************************
+ * @file       : onchip_buffer.hpp
+ * @brief      : On-Chip Buffer (OCb) of the TCP Offload Engine (TOE)
+ *
+ * System:     : cloudFPGA
+ * Component   : Shell, Network Transport Stack (NTS)
+ * Language    : Vivado HLS
+ *
+ * \ingroup NTS
+ * \addtogroup NTS_TOE
+ * \{
+ *******************************************************************************/
+
+#ifndef _TOE_OCB_H_
+#define _TOE_OCB_H_
+
+#include "../../../../../NTS/nts_utils.hpp"
+#include "../../../../../NTS/toe/src/toe.hpp"
+
+using namespace hls;
+
+/*******************************************************************************
+ * ON-CHIP BUFFER - PARAMETERS
+ *
+ *  The buffer pool of a path holds one buffer of 2^TOE_WINDOW_BITS bytes per
+ *   session. It is addressed with the same byte addresses as the DDR, .i.e
+ *   {SessionId, TcpBufAdr}, and it is split into 8 byte-wide lanes such that
+ *   the 8 bytes of a chunk always fall into 8 distinct lanes, whatever the
+ *   alignment of the chunk.
+ *******************************************************************************/
+static const int OCB_ADDR_BITS  = TOE_WINDOW_BITS + TOE_SESS_IDX_BITS;
+static const int OCB_ROW_BITS   = OCB_ADDR_BITS - 3;
+static const int OCB_LANE_DEPTH = (1 << OCB_ROW_BITS);
+
+#define OCB_RX_PATH  0
+#define OCB_TX_PATH  1
+
+typedef ap_uint<OCB_ADDR_BITS>  OcbAdr;   // A byte address in the buffer pool
+typedef ap_uint<OCB_ROW_BITS>   OcbRow;   // A row address in a byte lane
+typedef ap_uint<8>              OcbByte;  // A byte of a lane
+
+/*******************************************************************************
+ *
+ * @brief ENTITY - On-Chip Buffer (OCb)
+ *
+ *******************************************************************************/
+void onchip_buffer(
+        //-- Rx Path
+        stream<DmCmd>           &siRXe_WrCmd,
+        stream<AxisApp>         &siRXe_Data,
+        stream<DmSts>           &soRXe_WrSts,
+        stream<DmCmd>           &siRAi_RdCmd,
+        stream<AxisApp>         &soRAi_Data,
+        //-- Tx Path
+        stream<DmCmd>           &siTAi_WrCmd,
+        stream<AxisApp>         &siTAi_Data,
+        stream<DmSts>           &soTAi_WrSts,
+        stream<DmCmd>           &siTXe_RdCmd,
+        stream<AxisApp>         &soTXe_Data);
+
+#endif
+
+/*! \} */
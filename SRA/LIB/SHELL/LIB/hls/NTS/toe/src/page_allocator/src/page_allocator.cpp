@@ -0,0 +1,546 @@
+/*
+ * Copyright 2016 -- 2021 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*******************************************************************************
+ * @file       : page_allocator.cpp
+ * @brief      : Page Allocator (PAl) of the TCP Offload Engine (TOE)
+ *
+ * System:     : cloudFPGA
+ * Component   : Shell, Network Transport Stack (NTS)
+ * Language    : Vivado HLS
+ *
+ * \ingroup NTS
+ * \addtogroup NTS_TOE
+ * \{
+ *******************************************************************************/
+
+#include "page_allocator.hpp"
+
+using namespace hls;
+
+/************************************************
+ * HELPERS FOR THE DEBUGGING TRACES
+ *  .e.g: DEBUG_LEVEL = (TRACE_PTA | TRACE_PPM)
+ ************************************************/
+#ifndef __SYNTHESIS__
+  extern bool gTraceEvent;
+#endif
+
+#define THIS_NAME "TOE/PAl"
+
+#define TRACE_OFF  0x0000
+#define TRACE_PTA 1 <<  1
+#define TRACE_PPM 1 <<  2
+#define TRACE_RRM 1 <<  3
+#define TRACE_ALL  0xFFFF
+
+#define DEBUG_LEVEL (TRACE_OFF)
+
+#ifndef __SYNTHESIS__
+  //-- The number of pages in use per path (for the testbench only)
+  static unsigned int palPagesInUse[2]     = { 0, 0 };
+  static unsigned int palPeakPagesInUse[2] = { 0, 0 };
+
+  /*****************************************************************************
+   * @brief Return the current and the peak number of pages in use on a path.
+   *
+   * @param[in]  path            PAL_RX_PATH or PAL_TX_PATH.
+   * @param[out] pagesInUse      The number of pages currently mapped.
+   * @param[out] peakPagesInUse  The largest number of pages mapped so far.
+   *****************************************************************************/
+  void getPageAllocatorStats(int path, unsigned int &pagesInUse, unsigned int &peakPagesInUse) {
+      pagesInUse     = palPagesInUse[path];
+      peakPagesInUse = palPeakPagesInUse[path];
+  }
+#endif
+
+
+/*******************************************************************************
+ * @brief Return the index of the page table entry that maps a virtual address.
+ *
+ * @param[in]  memCmd  A memory command with a virtual address {SessionId, TcpBufAdr}.
+ *******************************************************************************/
+PageIdx getPageIdx(DmCmd memCmd)
+{
+    #pragma HLS INLINE
+    TcpBufAdr bufAdr = memCmd.saddr(TOE_WINDOW_BITS-1, 0);
+    VirPage   virPage = bufAdr >> TOE_PAGE_BITS;
+    PageIdx   pageIdx;
+    pageIdx(PAL_VPAGE_BITS-1, 0) = virPage;
+    pageIdx(TOE_SESS_IDX_BITS+PAL_VPAGE_BITS-1, PAL_VPAGE_BITS) =
+            memCmd.saddr(TOE_WINDOW_BITS+TOE_SESS_IDX_BITS-1, TOE_WINDOW_BITS);
+    return pageIdx;
+}
+
+/*******************************************************************************
+ * @brief Translate a memory command from a virtual to a physical address.
+ *
+ * @param[in]  memCmd   A memory command with a virtual address.
+ * @param[in]  phyPage  The physical page that maps the virtual page of 'memCmd'.
+ *******************************************************************************/
+DmCmd toPhyCmd(DmCmd memCmd, PhyPage phyPage)
+{
+    #pragma HLS INLINE
+    DmCmd phyCmd = memCmd;
+    phyCmd.saddr(29, TOE_PAGE_BITS) = phyPage;
+    return phyCmd;
+}
+
+/*******************************************************************************
+ * @brief Page Pool Manager (Ppm)
+ *
+ * @param[in]  siPta_FreePage  The physical page to recycle from PageTable (Pta).
+ * @param[out] soPta_FreeList  The free list of physical pages to [Pta].
+ *
+ * @details
+ *  Implements the free list of physical pages as a FiFo stream. A page only
+ *   enters the free list once no read of its data is pending anymore (see
+ *   'pRxReadMonitor' for the Rx path).
+ *  The template parameter is only used to get one free list per path.
+ *******************************************************************************/
+template<int PATH>
+void pPagePoolManager(
+        stream<PhyPage>     &siPta_FreePage,
+        stream<PhyPage>     &soPta_FreeList)
+{
+    //-- DIRECTIVES FOR THIS PROCESS -------------------------------------------
+    #pragma HLS PIPELINE II=1 enable_flush
+    #pragma HLS INLINE off
+
+    //-- STATIC CONTROL VARIABLES (with RESET) ---------------------------------
+    static ap_uint<PAL_PPAGE_BITS+1> ppm_counter=0;
+    #pragma HLS reset       variable=ppm_counter
+
+    if (ppm_counter < (1 << PAL_PPAGE_BITS)) {
+        // Initialize the free list after a reset
+        soPta_FreeList.write(ppm_counter(PAL_PPAGE_BITS-1, 0));
+        ppm_counter++;
+    }
+    else if (!siPta_FreePage.empty()) {
+        // Recycle the incoming page
+        PhyPage phyPage;
+        siPta_FreePage.read(phyPage);
+        soPta_FreeList.write(phyPage);
+    }
+}
+
+/*******************************************************************************
+ * @brief Page Table (Pta)
+ *
+ * @param[in]  siWrCmd         Virtual memory write command from the buffer writer.
+ * @param[out] soWrCmd         Physical memory write command to [MEM].
+ * @param[in]  siRdCmd         Virtual memory read command from the buffer reader.
+ * @param[out] soRdCmd         Physical memory read command to [MEM].
+ * @param[in]  siRelease       Release of the pages of a session from TxAppInterface (TAi).
+ * @param[in]  siPpm_FreeList  The free list of physical pages from PagePoolManager (Ppm).
+ * @param[out] soPpm_FreePage  The physical page to recycle to [Ppm] (or to [Rrm] on the Rx path).
+ * @param[out] soRXe_PoolLow   Signals that the pool of pages is running low to RxEngine (RXe).
+ *
+ * @details
+ *  This process maps the virtual pages of the sessions onto physical pages.
+ *   A page is allocated from the free list upon the first write into it, and
+ *   it is unmapped once the reader of the buffer is done with it. On the Rx
+ *   path, every byte is read exactly once and in order. Therefore, an Rx page
+ *   is unmapped by the read command that ends at the end of it, but it is only
+ *   recycled by the RxReadMonitor (Rrm) once the data of that read came back
+ *   from [MEM]. On the Tx path, a page may be read again for a retransmission
+ *   and it is only released upon a request from [TAi] once the peer
+ *   acknowledged it.
+ *  On the Rx path, [RXe] is told when fewer than PAL_RX_RESERVE pages are left
+ *   such that it drops the incoming segments (and lets the peers retransmit
+ *   them) instead of issuing writes that cannot be mapped. The reserve covers
+ *   the writes that are already in flight and the pages held by [Rrm]. A write
+ *   command to an unmapped page is only held back if the free list still runs
+ *   empty, while the read commands and the releases keep being served.
+ *  The memory clients never issue a command that crosses a page boundary.
+ *   The data and status streams of [MEM] do not go through this process.
+ *******************************************************************************/
+template<int PATH>
+void pPageTable(
+        stream<DmCmd>        &siWrCmd,
+        stream<DmCmd>        &soWrCmd,
+        stream<DmCmd>        &siRdCmd,
+        stream<DmCmd>        &soRdCmd,
+        stream<PageRelease>  &siRelease,
+        stream<PhyPage>      &siPpm_FreeList,
+        stream<PhyPage>      &soPpm_FreePage,
+        stream<SigBit>       &soRXe_PoolLow)
+{
+    //-- DIRECTIVES FOR THIS PROCESS -------------------------------------------
+    #pragma HLS INLINE off
+    #pragma HLS PIPELINE II=1 enable_flush
+
+    const char *myName = (PATH == PAL_RX_PATH) ? concat3(THIS_NAME, "/", "RxPta") :
+                                                 concat3(THIS_NAME, "/", "TxPta");
+
+    //-- STATIC ARRAYS ---------------------------------------------------------
+    static PageTableEntry           PAGE_TABLE[PAL_TABLE_SIZE];
+    #pragma HLS RESOURCE   variable=PAGE_TABLE core=RAM_T2P_BRAM
+    #pragma HLS DEPENDENCE variable=PAGE_TABLE inter false
+    #pragma HLS reset      variable=PAGE_TABLE
+
+    //-- STATIC CONTROL VARIABLES (with RESET) ---------------------------------
+    static enum FsmState { PTA_IDLE=0, PTA_RELEASE } \
+                               pta_fsmState=PTA_IDLE;
+    #pragma HLS RESET variable=pta_fsmState
+    static bool                pta_wrPending=false;
+    #pragma HLS RESET variable=pta_wrPending
+    static PageIdx             pta_lastIdx=0;   // The entry updated last
+    #pragma HLS RESET variable=pta_lastIdx
+    static PageTableEntry      pta_lastEntry(false, 0);
+    #pragma HLS RESET variable=pta_lastEntry
+    static ap_uint<PAL_PPAGE_BITS+1> pta_pagesInUse=0;
+    #pragma HLS RESET variable=pta_pagesInUse
+    static bool                pta_poolLow=false;
+    #pragma HLS RESET variable=pta_poolLow
+
+    //-- STATIC DATAFLOW VARIABLES ---------------------------------------------
+    static DmCmd               pta_wrCmd;      // A write command waiting for a page
+    static PageIdx             pta_wrIdx;
+    static SessionId           pta_relSessId;
+    static VirPage             pta_relPage;    // The next page to release
+    static ap_uint<PAL_VPAGE_BITS+1> pta_relCnt; // The number of pages left to release
+
+    //-- DYNAMIC VARIABLES -----------------------------------------------------
+    DmCmd                      memCmd;
+    PageRelease                release;
+    SessionId                  sessId;
+    PageIdx                    pageIdx;
+    PageTableEntry             entry;
+    PhyPage                    phyPage;
+
+    switch (pta_fsmState) {
+    case PTA_IDLE:
+        if (!siRelease.empty()) {
+            siRelease.read(release);
+            VirPage fromPage = release.from >> TOE_PAGE_BITS;
+            VirPage toPage   = release.to   >> TOE_PAGE_BITS;
+            if (release.all) {
+                //-- Release the pages left over by the previous user of this session ID
+                pta_relSessId = release.sessionID;
+                pta_relPage   = 0;
+                pta_relCnt    = PAL_VPAGES;
+                pta_fsmState  = PTA_RELEASE;
+            }
+            else if (toPage != fromPage) {
+                //-- Release the pages spanning [from, to)
+                pta_relSessId = release.sessionID;
+                pta_relPage   = fromPage;
+                pta_relCnt    = (VirPage)(toPage - fromPage);
+                pta_fsmState  = PTA_RELEASE;
+            }
+        }
+        else if (pta_wrPending and !siPpm_FreeList.empty() and !soWrCmd.full()) {
+            //-- Map a free page onto the page of the pending write command
+            siPpm_FreeList.read(phyPage);
+            entry = PageTableEntry(true, phyPage);
+            PAGE_TABLE[pta_wrIdx] = entry;
+            pta_lastIdx   = pta_wrIdx;
+            pta_lastEntry = entry;
+            soWrCmd.write(toPhyCmd(pta_wrCmd, phyPage));
+            pta_wrPending = false;
+            pta_pagesInUse++;
+            #ifndef __SYNTHESIS__
+            palPagesInUse[PATH]++;
+            if (palPagesInUse[PATH] > palPeakPagesInUse[PATH]) {
+                palPeakPagesInUse[PATH] = palPagesInUse[PATH];
+            }
+            #endif
+            if (DEBUG_LEVEL & TRACE_PTA) {
+                printInfo(myName, "Mapping physical page #%d onto page table entry #%d.\n",
+                          phyPage.to_uint(), pta_wrIdx.to_uint());
+            }
+        }
+        else if (!pta_wrPending and !siWrCmd.empty() and !soWrCmd.full()) {
+            siWrCmd.read(memCmd);
+            pageIdx = getPageIdx(memCmd);
+            entry = (pageIdx == pta_lastIdx) ? pta_lastEntry : PAGE_TABLE[pageIdx];
+            if (entry.valid) {
+                soWrCmd.write(toPhyCmd(memCmd, entry.page));
+            }
+            else {
+                //-- The page must first be allocated
+                pta_wrCmd     = memCmd;
+                pta_wrIdx     = pageIdx;
+                pta_wrPending = true;
+                if (siPpm_FreeList.empty()) {
+                    printWarn(myName, "The pool of pages is exhausted. Holding back the write command.\n");
+                }
+            }
+        }
+        else if (!siRdCmd.empty() and !soRdCmd.full()) {
+            siRdCmd.read(memCmd);
+            pageIdx = getPageIdx(memCmd);
+            entry = (pageIdx == pta_lastIdx) ? pta_lastEntry : PAGE_TABLE[pageIdx];
+            if (!entry.valid) {
+                printError(myName, "Reading from the unmapped page table entry #%d.\n", pageIdx.to_uint());
+            }
+            soRdCmd.write(toPhyCmd(memCmd, entry.page));
+            if ((PATH == PAL_RX_PATH) and entry.valid and
+                ((memCmd.saddr(TOE_PAGE_BITS-1, 0) + memCmd.btt) == TOE_PAGE_SIZE)) {
+                //-- This Rx page was entirely read. Unmap it but leave its
+                //--  recycling to [Rrm] which waits for the end of the read.
+                entry = PageTableEntry(false, 0);
+                PAGE_TABLE[pageIdx] = entry;
+                pta_lastIdx   = pageIdx;
+                pta_lastEntry = entry;
+                pta_pagesInUse--;
+                #ifndef __SYNTHESIS__
+                palPagesInUse[PATH]--;
+                #endif
+            }
+        }
+        break;
+    case PTA_RELEASE:
+        if (!soPpm_FreePage.full()) {
+            sessId  = pta_relSessId;
+            pageIdx(PAL_VPAGE_BITS-1, 0) = pta_relPage;
+            pageIdx(TOE_SESS_IDX_BITS+PAL_VPAGE_BITS-1, PAL_VPAGE_BITS) = sessId(TOE_SESS_IDX_BITS-1, 0);
+            entry = (pageIdx == pta_lastIdx) ? pta_lastEntry : PAGE_TABLE[pageIdx];
+            if (entry.valid) {
+                soPpm_FreePage.write(entry.page);
+                entry = PageTableEntry(false, 0);
+                PAGE_TABLE[pageIdx] = entry;
+                pta_lastIdx   = pageIdx;
+                pta_lastEntry = entry;
+                pta_pagesInUse--;
+                #ifndef __SYNTHESIS__
+                palPagesInUse[PATH]--;
+                #endif
+                if (DEBUG_LEVEL & TRACE_PTA) {
+                    printInfo(myName, "Releasing page table entry #%d.\n", pageIdx.to_uint());
+                }
+            }
+            if (pta_relCnt == 1) {
+                pta_fsmState = PTA_IDLE;
+            }
+            pta_relPage++;
+            pta_relCnt--;
+        }
+        break;
+    }
+
+    //-- Signal any change of the state of the Rx pool to [RXe]
+    bool poolLow = (pta_pagesInUse >= (PAL_NR_PAGES - PAL_RX_RESERVE));
+    if ((PATH == PAL_RX_PATH) and (poolLow != pta_poolLow) and !soRXe_PoolLow.full()) {
+        soRXe_PoolLow.write(poolLow);
+        pta_poolLow = poolLow;
+        if (poolLow) {
+            printWarn(myName, "The pool of pages is running low. Dropping the Rx segments.\n");
+        }
+    }
+}
+
+/*******************************************************************************
+ * @brief Rx Read Monitor (Rrm)
+ *
+ * @param[in]  siPta_RdCmd     Physical Rx memory read command from PageTable (Pta).
+ * @param[out] soMEM_RdCmd     Physical Rx memory read command to [MEM].
+ * @param[in]  siMEM_Data      Rx memory data from [MEM].
+ * @param[out] soRAi_Data      Rx memory data to RxAppInterface (RAi).
+ * @param[in]  siPta_FreePage  The physical page unmapped by [Pta].
+ * @param[out] soPpm_FreePage  The physical page to recycle to PagePoolManager (Ppm).
+ *
+ * @details
+ *  An Rx page is unmapped by [Pta] as soon as the read command that ends on it
+ *   is issued, but its data may still be in the pipeline of the data mover.
+ *   Therefore, this process keeps track of the pending read commands and it
+ *   only returns such a page to the free list once the last chunk of its read
+ *   (.i.e, the chunk with TLAST set) came back from [MEM].
+ *  The pages released by [Pta] upon the reopening of a session are forwarded
+ *   as is.
+ *******************************************************************************/
+void pRxReadMonitor(
+        stream<DmCmd>        &siPta_RdCmd,
+        stream<DmCmd>        &soMEM_RdCmd,
+        stream<AxisApp>      &siMEM_Data,
+        stream<AxisApp>      &soRAi_Data,
+        stream<PhyPage>      &siPta_FreePage,
+        stream<PhyPage>      &soPpm_FreePage)
+{
+    //-- DIRECTIVES FOR THIS PROCESS -------------------------------------------
+    #pragma HLS INLINE off
+    #pragma HLS PIPELINE II=1 enable_flush
+
+    const char *myName = concat3(THIS_NAME, "/", "Rrm");
+
+    //-- STATIC ARRAYS ---------------------------------------------------------
+    static PhyPage                  PENDING_PAGE[PAL_RRM_DEPTH];
+    #pragma HLS ARRAY_PARTITION variable=PENDING_PAGE complete dim=1
+    static FlagBool                 PENDING_FREE[PAL_RRM_DEPTH];
+    #pragma HLS ARRAY_PARTITION variable=PENDING_FREE complete dim=1
+
+    //-- STATIC CONTROL VARIABLES (with RESET) ---------------------------------
+    static ap_uint<PAL_RRM_BITS+1>  rrm_wrPtr=0;
+    #pragma HLS RESET variable=rrm_wrPtr
+    static ap_uint<PAL_RRM_BITS+1>  rrm_rdPtr=0;
+    #pragma HLS RESET variable=rrm_rdPtr
+
+    //-- DYNAMIC VARIABLES -----------------------------------------------------
+    DmCmd                      memCmd;
+    AxisApp                    memChunk;
+    PhyPage                    phyPage;
+    bool                       freed = false;
+
+    //-- Forward the data and retire the read command that ends with this chunk
+    if (!siMEM_Data.empty() and !soRAi_Data.full() and !soPpm_FreePage.full()) {
+        siMEM_Data.read(memChunk);
+        soRAi_Data.write(memChunk);
+        if (memChunk.getTLast()) {
+            ap_uint<PAL_RRM_BITS> rdIdx = rrm_rdPtr(PAL_RRM_BITS-1, 0);
+            if (PENDING_FREE[rdIdx]) {
+                soPpm_FreePage.write(PENDING_PAGE[rdIdx]);
+                freed = true;
+                if (DEBUG_LEVEL & TRACE_RRM) {
+                    printInfo(myName, "Recycling physical page #%d.\n", PENDING_PAGE[rdIdx].to_uint());
+                }
+            }
+            rrm_rdPtr++;
+        }
+    }
+
+    //-- Forward the read commands as long as a pending slot is left
+    if (!siPta_RdCmd.empty() and !soMEM_RdCmd.full() and
+        ((ap_uint<PAL_RRM_BITS+1>)(rrm_wrPtr - rrm_rdPtr) < PAL_RRM_DEPTH)) {
+        siPta_RdCmd.read(memCmd);
+        soMEM_RdCmd.write(memCmd);
+        ap_uint<PAL_RRM_BITS> wrIdx = rrm_wrPtr(PAL_RRM_BITS-1, 0);
+        PENDING_PAGE[wrIdx] = memCmd.saddr(29, TOE_PAGE_BITS);
+        PENDING_FREE[wrIdx] = ((memCmd.saddr(TOE_PAGE_BITS-1, 0) + memCmd.btt) == TOE_PAGE_SIZE);
+        rrm_wrPtr++;
+    }
+
+    //-- Recycle the pages released by [Pta]
+    if (!freed and !siPta_FreePage.empty() and !soPpm_FreePage.full()) {
+        siPta_FreePage.read(phyPage);
+        soPpm_FreePage.write(phyPage);
+    }
+}
+
+/*******************************************************************************
+ * @brief The page allocator (PAl) of the TCP Offload Engine (TOE)
+ *
+ * @param[in]  siRXe_WrCmd      Virtual Rx memory write command from RxEngine (RXe).
+ * @param[out] soMEM_RxP_WrCmd  Physical Rx memory write command to [MEM].
+ * @param[in]  siRAi_RdCmd      Virtual Rx memory read command from RxAppInterface (RAi).
+ * @param[out] soMEM_RxP_RdCmd  Physical Rx memory read command to [MEM].
+ * @param[in]  siMEM_RxP_Data   Rx memory data from [MEM].
+ * @param[out] soRAi_RxP_Data   Rx memory data to [RAi].
+ * @param[in]  siTAi_RxRelease  Release of all the Rx pages of a session from TxAppInterface (TAi).
+ * @param[out] soRXe_PoolLow    Signals that the Rx pool of pages is running low to [RXe].
+ * @param[in]  siTAi_WrCmd      Virtual Tx memory write command from [TAi].
+ * @param[out] soMEM_TxP_WrCmd  Physical Tx memory write command to [MEM].
+ * @param[in]  siTXe_RdCmd      Virtual Tx memory read command from TxEngine (TXe).
+ * @param[out] soMEM_TxP_RdCmd  Physical Tx memory read command to [MEM].
+ * @param[in]  siTAi_TxRelease  Release of the Tx pages of a session from [TAi].
+ *
+ * @details
+ *  This entity replaces the fixed buffer slot of every session with buffer
+ *   pages that are allocated on demand from a pool shared by all sessions
+ *   (see 'TOE_BUFFER_PAGING'). It sits on the command streams of the data
+ *   movers and translates the virtual addresses of the memory clients into
+ *   physical DDR addresses. An Rx page is released once its data was read back
+ *   from [MEM] for [APP], and a Tx page is released once it was acknowledged by
+ *   the peer. The Rx data therefore goes through this entity. When a
+ *   session is (re)opened, [TAi] also releases the pages left over by the
+ *   previous session with the same ID.
+ *******************************************************************************/
+void page_allocator(
+        //-- Rx Path
+        stream<DmCmd>           &siRXe_WrCmd,
+        stream<DmCmd>           &soMEM_RxP_WrCmd,
+        stream<DmCmd>           &siRAi_RdCmd,
+        stream<DmCmd>           &soMEM_RxP_RdCmd,
+        stream<AxisApp>         &siMEM_RxP_Data,
+        stream<AxisApp>         &soRAi_RxP_Data,
+        stream<PageRelease>     &siTAi_RxRelease,
+        stream<SigBit>          &soRXe_PoolLow,
+        //-- Tx Path
+        stream<DmCmd>           &siTAi_WrCmd,
+        stream<DmCmd>           &soMEM_TxP_WrCmd,
+        stream<DmCmd>           &siTXe_RdCmd,
+        stream<DmCmd>           &soMEM_TxP_RdCmd,
+        stream<PageRelease>     &siTAi_TxRelease)
+{
+    //-- DIRECTIVES FOR THE INTERFACES ----------------------------------------
+    #pragma HLS DATAFLOW
+    #pragma HLS INTERFACE ap_ctrl_none port=return
+
+    //--------------------------------------------------------------------------
+    //-- LOCAL STREAMS (Sorted by the name of the modules which generate them)
+    //--------------------------------------------------------------------------
+
+    //-- Page Pool Managers (RxPpm, TxPpm) -------------------------------------
+    static stream<PhyPage>            ssRxPpmToRxPta_FreeList   ("ssRxPpmToRxPta_FreeList");
+    #pragma HLS stream       variable=ssRxPpmToRxPta_FreeList   depth=PAL_NR_PAGES
+    static stream<PhyPage>            ssTxPpmToTxPta_FreeList   ("ssTxPpmToTxPta_FreeList");
+    #pragma HLS stream       variable=ssTxPpmToTxPta_FreeList   depth=PAL_NR_PAGES
+
+    //-- Page Tables (RxPta, TxPta) --------------------------------------------
+    static stream<DmCmd>              ssRxPtaToRrm_RdCmd        ("ssRxPtaToRrm_RdCmd");
+    #pragma HLS stream       variable=ssRxPtaToRrm_RdCmd        depth=2
+    #pragma HLS DATA_PACK    variable=ssRxPtaToRrm_RdCmd
+    static stream<PhyPage>            ssRxPtaToRrm_FreePage     ("ssRxPtaToRrm_FreePage");
+    #pragma HLS stream       variable=ssRxPtaToRrm_FreePage     depth=2
+    static stream<PhyPage>            ssTxPtaToTxPpm_FreePage   ("ssTxPtaToTxPpm_FreePage");
+    #pragma HLS stream       variable=ssTxPtaToTxPpm_FreePage   depth=2
+    static stream<SigBit>             ssTxPtaToNul_PoolLow      ("ssTxPtaToNul_PoolLow");  // Unused
+    #pragma HLS stream       variable=ssTxPtaToNul_PoolLow      depth=2
+
+    //-- Rx Read Monitor (Rrm) -------------------------------------------------
+    static stream<PhyPage>            ssRrmToRxPpm_FreePage     ("ssRrmToRxPpm_FreePage");
+    #pragma HLS stream       variable=ssRrmToRxPpm_FreePage     depth=2
+
+    //-- Rx Path ---------------------------------------------------------------
+    pPagePoolManager<PAL_RX_PATH>(
+            ssRrmToRxPpm_FreePage,
+            ssRxPpmToRxPta_FreeList);
+
+    pPageTable<PAL_RX_PATH>(
+            siRXe_WrCmd,
+            soMEM_RxP_WrCmd,
+            siRAi_RdCmd,
+            ssRxPtaToRrm_RdCmd,
+            siTAi_RxRelease,
+            ssRxPpmToRxPta_FreeList,
+            ssRxPtaToRrm_FreePage,
+            soRXe_PoolLow);
+
+    pRxReadMonitor(
+            ssRxPtaToRrm_RdCmd,
+            soMEM_RxP_RdCmd,
+            siMEM_RxP_Data,
+            soRAi_RxP_Data,
+            ssRxPtaToRrm_FreePage,
+            ssRrmToRxPpm_FreePage);
+
+    //-- Tx Path ---------------------------------------------------------------
+    pPagePoolManager<PAL_TX_PATH>(
+            ssTxPtaToTxPpm_FreePage,
+            ssTxPpmToTxPta_FreeList);
+
+    pPageTable<PAL_TX_PATH>(
+            siTAi_WrCmd,
+            soMEM_TxP_WrCmd,
+            siTXe_RdCmd,
+            soMEM_TxP_RdCmd,
+            siTAi_TxRelease,
+            ssTxPpmToTxPta_FreeList,
+            ssTxPtaToTxPpm_FreePage,
+            ssTxPtaToNul_PoolLow);
+}
+
+/*! \} */
@@ -0,0 +1,104 @@
+/*
+ * Copyright 2016 -- 2021 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*******************************************************************************
+ * @file       : page_allocator.hpp
+ * @brief      : Page Allocator (PAl) of the TCP Offload Engine (TOE)
+ *
+ * System:     : cloudFPGA
+ * Component   : Shell, Network Transport Stack (NTS)
+ * Language    : Vivado HLS
+ *
+ * \ingroup NTS
+ * \addtogroup NTS_TOE
+ * \{
+ *******************************************************************************/
+
+#ifndef _TOE_PAL_H_
+#define _TOE_PAL_H_
+
+#include "../../../../../NTS/nts_utils.hpp"
+#include "../../../../../NTS/toe/src/toe.hpp"
+
+using namespace hls;
+
+/*******************************************************************************
+ * PAGE ALLOCATOR - PARAMETERS
+ *
+ *  The memory clients of the TOE keep addressing the Rx and Tx buffers with
+ *   virtual addresses made of {SessionId, TcpBufAdr}. The window of a session
+ *   is divided into PAL_VPAGES virtual pages of 2^TOE_PAGE_BITS bytes, each of
+ *   which is mapped onto one of the PAL_NR_PAGES physical pages of the 1GB
+ *   memory region of a path.
+ *******************************************************************************/
+static const int PAL_VPAGE_BITS = (TOE_WINDOW_BITS > TOE_PAGE_BITS) ? (TOE_WINDOW_BITS - TOE_PAGE_BITS) : 1;
+static const int PAL_VPAGES     = (1 << PAL_VPAGE_BITS);
+static const int PAL_PPAGE_BITS = 30 - TOE_PAGE_BITS;
+static const int PAL_TABLE_SIZE = TOE_MAX_SESSIONS * PAL_VPAGES;
+
+#define PAL_NR_PAGES  (1 << (30 - TOE_DDR_PAGE_BITS))  // 16384 pages of 64KB
+
+#define PAL_RX_RESERVE  64  // Rx pages kept free for the writes in flight
+#define PAL_RRM_BITS     4
+#define PAL_RRM_DEPTH   (1 << PAL_RRM_BITS)  // Pending Rx reads tracked by [Rrm]
+#define PAL_RX_PATH  0
+#define PAL_TX_PATH  1
+
+typedef ap_uint<PAL_VPAGE_BITS>                   VirPage;  // A virtual page of a session window
+typedef ap_uint<PAL_PPAGE_BITS>                   PhyPage;  // A physical page of a memory region
+typedef ap_uint<TOE_SESS_IDX_BITS+PAL_VPAGE_BITS> PageIdx;  // An index into the page table
+
+//=========================================================
+//== PAl / An entry of the page table
+//=========================================================
+class PageTableEntry {
+  public:
+    FlagBool    valid;
+    PhyPage     page;
+    PageTableEntry() {}
+    PageTableEntry(FlagBool valid, PhyPage page) :
+        valid(valid), page(page) {}
+};
+
+/*******************************************************************************
+ *
+ * @brief ENTITY - Page Allocator (PAl)
+ *
+ *******************************************************************************/
+void page_allocator(
+        //-- Rx Path
+        stream<DmCmd>           &siRXe_WrCmd,
+        stream<DmCmd>           &soMEM_RxP_WrCmd,
+        stream<DmCmd>           &siRAi_RdCmd,
+        stream<DmCmd>           &soMEM_RxP_RdCmd,
+        stream<AxisApp>         &siMEM_RxP_Data,
+        stream<AxisApp>         &soRAi_RxP_Data,
+        stream<PageRelease>     &siTAi_RxRelease,
+        stream<SigBit>          &soRXe_PoolLow,
+        //-- Tx Path
+        stream<DmCmd>           &siTAi_WrCmd,
+        stream<DmCmd>           &soMEM_TxP_WrCmd,
+        stream<DmCmd>           &siTXe_RdCmd,
+        stream<DmCmd>           &soMEM_TxP_RdCmd,
+        stream<PageRelease>     &siTAi_TxRelease);
+
+#ifndef __SYNTHESIS__
+  void getPageAllocatorStats(int path, unsigned int &pagesInUse, unsigned int &peakPagesInUse);
+#endif
+
+#endif
+
+/*! \} */
@@ -218,16 +218,20 @@ void pListeningPortTable(
  *
  * @details
  *  This process keeps track of the opened source ports used in by active
- *   connections. It consists of a  table containing a free list of ephemeral
+ *   connections. It consists of a  table containing the state of the ephemeral
  *   ports (also referred as dynamic ports) that the TOE uses as local source
- *   ports when it opens new active connections.
+ *   ports when it opens new active connections, and of a free list of these
+ *   ports.
  *  A dynamic source port is implicitly assigned in the range (32,768 to 65,535)
  *   and there is no way (or reason) to explicitly specify such a port number.
  *  This table is accessed by one local [Irr] and 2 remote [SLc][TAi] processes.
  *
- * @Warning
- *  The initial design point assumed a maximum of 10K sessions, which is much
- *  less than the possible 32K active ports.
+ *  A free port is allocated in a single cycle, regardless of the number of
+ *   ports in use. The ports that were never allocated since the last reset are
+ *   handed out first and in increasing order by a counter. The released ports
+ *   are then recycled in the order of their release by a FIFO, which maximizes
+ *   the time before a port is re-used. Because every port above that counter
+ *   is known to be free, the tables do not need to be cleared upon reset.
  *******************************************************************************/
 void pFreePortTable(
         StsBool              &poRdy_Ready,
@@ -248,81 +252,73 @@ void pFreePortTable(
     static PortRange                ACTIVE_PORT_TABLE[0x8000];
     #pragma HLS RESOURCE   variable=ACTIVE_PORT_TABLE core=RAM_T2P_BRAM
     #pragma HLS DEPENDENCE variable=ACTIVE_PORT_TABLE inter false
+    static TcpDynPort               FREE_PORT_FIFO[0x8000];
+    #pragma HLS RESOURCE   variable=FREE_PORT_FIFO core=RAM_T2P_BRAM
+    #pragma HLS DEPENDENCE variable=FREE_PORT_FIFO inter false
 
     //-- STATIC CONTROL VARIABLES (with RESET) ---------------------------------
-    static bool                     fpt_isFPtInit=false;
-    #pragma HLS reset      variable=fpt_isFPtInit
-    static bool                     fpt_searching=false;
-    #pragma HLS reset      variable=fpt_searching
-    static bool                     fpt_eval=false;
-    #pragma HLS reset      variable=fpt_eval
-    static TcpDynPort               fpt_dynPortNum=0x7FFF;
-    #pragma HLS reset      variable=fpt_dynPortNum
-
-    //-- STATIC DATAFLOW VARIABLES ---------------------------------------------
-    static bool          portState = ACT_USED_PORT;
-    #pragma HLS DEPENDENCE variable=portState inter false
-
-    // The table is a free list that must be initialized upon reset
-    if (!fpt_isFPtInit) {
-        ACTIVE_PORT_TABLE[fpt_dynPortNum] = ACT_FREE_PORT;
-        fpt_dynPortNum -= 1;
-        if (fpt_dynPortNum == 0) {
-            fpt_isFPtInit = true;
-            if (DEBUG_LEVEL & TRACE_FPT) {
-                printInfo(myName, "Done with initialization of ACTIVE_PORT_TABLE.\n");
-            }
+    static ap_uint<16>              fpt_freshCnt=0;  // #ports allocated since reset
+    #pragma HLS reset      variable=fpt_freshCnt
+    static ap_uint<16>              fpt_fifoWrPtr=0;
+    #pragma HLS reset      variable=fpt_fifoWrPtr
+    static ap_uint<16>              fpt_fifoRdPtr=0;
+    #pragma HLS reset      variable=fpt_fifoRdPtr
+
+    //-- DYNAMIC VARIABLES -----------------------------------------------------
+    bool         fifoEmpty = (fpt_fifoWrPtr == fpt_fifoRdPtr);
+    bool         hasFreePort = (fpt_freshCnt < 0x8000) or !fifoEmpty;
+    TcpDynPort   dynPortNum;
+
+    if (!siIrr_GetPortStateCmd.empty()) {
+        // Warning: Cannot add "and !soOrm_GetPortStateRsp.full()" here because
+        //  it increases the task interval from 1 to 2!
+        TcpDynPort portNum = siIrr_GetPortStateCmd.read();
+        if (portNum < fpt_freshCnt) {
+            soOrm_GetPortStateRsp.write(ACTIVE_PORT_TABLE[portNum]);
         }
-    }
-    else {
-        if (fpt_searching) {
-            portState = ACTIVE_PORT_TABLE[fpt_dynPortNum];
-            fpt_searching = false;
-            fpt_eval      = true;
+        else {
+            soOrm_GetPortStateRsp.write(ACT_FREE_PORT);
         }
-        else if (fpt_eval) {
-            if (portState == ACT_FREE_PORT) {
-                // Found a free entry port in the table
-                if (!soTAi_GetFreePortRep.full()) {
-                    // Stop evaluating. Set port number to USED and forward to [TAi]
-                    fpt_eval = false;
-                    ACTIVE_PORT_TABLE[fpt_dynPortNum] = ACT_USED_PORT;
-                    // Add 0x8000 before sending back
-                    soTAi_GetFreePortRep.write(0x8000 + fpt_dynPortNum);
-                }
-            }
-            else {
-                // Continue searching
-            	fpt_searching = true;
-            }
-            fpt_dynPortNum++;
+    }
+    else if (!siTAi_GetFreePortReq.empty() and hasFreePort and !soTAi_GetFreePortRep.full()) {
+        siTAi_GetFreePortReq.read();
+        if (fpt_freshCnt < 0x8000) {
+            // Hand out a port that was never allocated since the last reset
+            dynPortNum = fpt_freshCnt(14, 0);
+            fpt_freshCnt++;
         }
-        else if (!siIrr_GetPortStateCmd.empty()) {
-            // Warning: Cannot add "and !soOrm_GetPortStateRsp.full()" here because
-            //  it increases the task interval from 1 to 2!
-            TcpDynPort portNum = siIrr_GetPortStateCmd.read();
-            soOrm_GetPortStateRsp.write(ACTIVE_PORT_TABLE[portNum]);
+        else {
+            // Recycle the port that was released first
+            dynPortNum = FREE_PORT_FIFO[fpt_fifoRdPtr(14, 0)];
+            fpt_fifoRdPtr++;
         }
-        else if (!siTAi_GetFreePortReq.empty()) {
-            siTAi_GetFreePortReq.read();
-            fpt_searching = true;
+        ACTIVE_PORT_TABLE[dynPortNum] = ACT_USED_PORT;
+        // Add 0x8000 before sending back
+        soTAi_GetFreePortRep.write(0x8000 + dynPortNum);
+        if (DEBUG_LEVEL & TRACE_FPT) {
+            printInfo(myName, "Allocating port #%d to [TAi].\n", 0x8000 + dynPortNum.to_uint());
         }
-        else if (!siSLc_CloseActPortCmd.empty()) {
-            TcpPort tcpPort = siSLc_CloseActPortCmd.read();
-            if (tcpPort.bit(15) == 1) {
-                // Assess that port number >= 0x8000
-                ACTIVE_PORT_TABLE[tcpPort.range(14, 0)] = ACT_FREE_PORT;
-            }
-          #ifndef __SYNTHESIS__
-            else {
-                printError(myName, "SLc is not allowed to release a static port.\n");
-                exit(1);
+    }
+    else if (!siSLc_CloseActPortCmd.empty()) {
+        TcpPort tcpPort = siSLc_CloseActPortCmd.read();
+        if (tcpPort.bit(15) == 1) {
+            // Assess that port number >= 0x8000
+            dynPortNum = tcpPort.range(14, 0);
+            if ((dynPortNum < fpt_freshCnt) and (ACTIVE_PORT_TABLE[dynPortNum] == ACT_USED_PORT)) {
+                ACTIVE_PORT_TABLE[dynPortNum] = ACT_FREE_PORT;
+                FREE_PORT_FIFO[fpt_fifoWrPtr(14, 0)] = dynPortNum;
+                fpt_fifoWrPtr++;
             }
-          #endif
         }
+      #ifndef __SYNTHESIS__
+        else {
+            printError(myName, "SLc is not allowed to release a static port.\n");
+            exit(1);
+        }
+      #endif
     }
     // ALWAYS
-    poRdy_Ready = fpt_isFPtInit;
+    poRdy_Ready = true;
 }
 
 /*******************************************************************************
@@ -237,8 +237,8 @@ void pRxAppStream(
             }
             // Generate a memory buffer read command
             RxMemPtr memSegAddr = TOE_RX_MEMORY_BASE;
-            memSegAddr(29, 16) = rxSarRep.sessionID(13, 0);
-            memSegAddr(15,  0) = rxSarRep.appd;
+            memSegAddr(29, TOE_WINDOW_BITS) = rxSarRep.sessionID(TOE_SESS_ADDR_BITS-1, 0);
+            memSegAddr(TOE_WINDOW_BITS-1, 0) = rxSarRep.appd;
             soMrd_MemRdCmd.write(DmCmd(memSegAddr, ras_readLength));
             // Update the APP read pointer
             soRSt_RxSarQry.write(RAiRxSarQuery(rxSarRep.sessionID, rxSarRep.appd+ras_readLength));
@@ -266,8 +266,9 @@ void pRxAppStream(
  * @details
  *  This process takes the memory read command assembled by RxAppStream (Ras)
  *   an forwards it to the memory sub-system (MEM). While doing so, it checks if
- *   the TCP Rx memory buffer wraps around and accordingly generates two memory
- *   read commands out of the initial command received from [Ras].
+ *   the TCP Rx memory buffer wraps around or if the access crosses a buffer
+ *   page (see 'TOE_BUFFER_PAGING') and accordingly generates two memory read
+ *   commands out of the initial command received from [Ras].
  *  Because the AppSegmetStitcher (Ass) process needs to be aware of this split,
  *   a signal is sent to [Ass] telling whether a data segment was broken in two
  *   Rx memory buffers or is provided as a single buffer.
@@ -298,9 +299,10 @@ void pRxMemoryReader(
         if (!siRas_MemRdCmd.empty() and !soAss_SplitSeg.full() and !soMEM_RxpRdCmd.full() ) {
             siRas_MemRdCmd.read(mrd_memRdCmd);
 
-            if ((mrd_memRdCmd.saddr.range(TOE_WINDOW_BITS-1, 0) + mrd_memRdCmd.btt) > TOE_RX_BUFFER_SIZE) {
+            if (crossesPage(mrd_memRdCmd.saddr(TOE_WINDOW_BITS-1, 0), mrd_memRdCmd.btt)) {
                 // This segment was broken in two memory accesses because TCP Rx memory buffer wrapped around
-                mrd_firstAccLen = TOE_RX_BUFFER_SIZE - mrd_memRdCmd.saddr;
+                // or because the segment crosses a page boundary
+                mrd_firstAccLen = TOE_PAGE_SIZE - mrd_memRdCmd.saddr(TOE_PAGE_BITS-1, 0);
                 mrd_fsmState = MRD_2ND_ACCESS;
 
                 soMEM_RxpRdCmd.write(DmCmd(mrd_memRdCmd.saddr, mrd_firstAccLen));
@@ -326,8 +328,8 @@ void pRxMemoryReader(
         break;
     case MRD_2ND_ACCESS:
         if (!soMEM_RxpRdCmd.full()) {
-            // Update the command to account for the Rx buffer wrap around
-            mrd_memRdCmd.saddr(TOE_WINDOW_BITS-1, 0) = 0;
+            // Update the command to account for the Rx buffer wrap around or the next page
+            mrd_memRdCmd.saddr(TOE_WINDOW_BITS-1, 0) = getNextPageAdr(mrd_memRdCmd.saddr(TOE_WINDOW_BITS-1, 0));
             soMEM_RxpRdCmd.write(DmCmd(mrd_memRdCmd.saddr, mrd_memRdCmd.btt - mrd_firstAccLen));
 
             mrd_fsmState = MRD_1ST_ACCESS;
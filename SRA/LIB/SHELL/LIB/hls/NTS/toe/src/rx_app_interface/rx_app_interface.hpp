@@ -58,6 +58,7 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "../../../../NTS/nts_utils.hpp"
 #include "../../../../NTS/toe/src/toe.hpp"
+#include "../../../../NTS/toe/src/toe_utils.hpp"
 
 using namespace hls;
 
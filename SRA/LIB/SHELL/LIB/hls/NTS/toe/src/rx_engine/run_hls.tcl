@@ -88,7 +88,10 @@ add_files     ${currDir}/../../../../NTS/SimNtsUtils.cpp
 add_files -tb ${currDir}/../../../toe/src/toe.cpp -cflags "-DHLS_VERSION=${HLS_VERSION} -fstack-check"
 add_files -tb ${currDir}/../../../toe/src/toe_utils.cpp
 add_files -tb ${currDir}/../../../toe/src/ack_delay/src/ack_delay.cpp
+add_files -tb ${currDir}/../../../toe/src/congestion_control/src/congestion_control.cpp
 add_files -tb ${currDir}/../../../toe/src/event_engine/event_engine.cpp
+add_files -tb ${currDir}/../../../toe/src/onchip_buffer/src/onchip_buffer.cpp
+add_files -tb ${currDir}/../../../toe/src/page_allocator/src/page_allocator.cpp
 add_files -tb ${currDir}/../../../toe/src/port_table/port_table.cpp
 add_files -tb ${currDir}/../../../toe/src/rx_app_interface/rx_app_interface.cpp
 add_files -tb ${currDir}/../../../toe/src/rx_sar_table/rx_sar_table.cpp
@@ -197,6 +200,7 @@ if { $hlsCSim} {
     csim_design -argv "0 ../../../../../../test/testVectors/siIPRX_TcpDuplicate.dat"
     csim_design -argv "0 ../../../../../../test/testVectors/siIPRX_TcpOutOfOrder1.dat"
     csim_design -argv "0 ../../../../../../test/testVectors/siIPRX_TcpOutOfOrder2.dat"
+    csim_design -argv "0 ../../../../../../test/testVectors/siIPRX_TcpOutOfOrder3.dat"
 
     csim_design -argv "3 ../../../../../../test/testVectors/siIPRX_OneSynPkt.dat"
     csim_design -argv "3 ../../../../../../test/testVectors/siIPRX_OneSynMssPkt.dat"
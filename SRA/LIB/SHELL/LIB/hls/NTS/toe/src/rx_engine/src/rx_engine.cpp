@@ -89,6 +89,7 @@ using namespace hls;
  * @param[in]  siIPRX_Data     IP4 packet stream from IpRxHandler (IPRX).
  * @param[out] soIph_Data      A custom-made pseudo packet to InsertPseudoHeader (Iph).
  * @param[out] soIph_TcpSegLen The length of the incoming TCP segment to [Iph].
+ * @param[out] soCsa_IpCe      The CE mark of the incoming IP packet to CheckSumAccumulator (Csa).
  *
  * @details
  *   This process receives the incoming IPv4 data stream from IpRxHandler (IPRX).
@@ -145,7 +146,8 @@ using namespace hls;
 void pTcpLengthExtractor(
         stream<AxisIp4>      &siIPRX_Data,
         stream<AxisRaw>      &soIph_Data,
-        stream<TcpSegLen>    &soIph_TcpSegLen)
+        stream<TcpSegLen>    &soIph_TcpSegLen,
+        stream<FlagBool>     &soCsa_IpCe)
 {
     //-- DIRECTIVES FOR THIS PROCESS -------------------------------------------
     #pragma HLS PIPELINE II=1 enable_flush
@@ -179,6 +181,8 @@ void pTcpLengthExtractor(
             // Compute length of IPv4 data (.i.e. the TCP segment length)
             tle_ipDataLen  = tle_ip4TotLen - (tle_ip4HdrLen * 4);
             tle_ip4HdrLen -= 2; // We just processed 8 bytes
+            // Forward the ECN codepoint of the IP header (RFC-3168)
+            soCsa_IpCe.write(currChunk.getIp4ToS()(1, 0) == IP4_ECN_CE);
             tle_chunkCount++;
             break;
         case CHUNK_1:
@@ -403,14 +407,106 @@ void pInsertPseudoHeader(
     }
 }
 
+/*******************************************************************************
+ * @brief Parse the TCP option bytes of a pseudo TCP chunk.
+ *
+ * @param[in]     chunk    The current chunk of the pseudo TCP segment.
+ * @param[in]     nrBytes  The number of option bytes in this chunk (4 or 8).
+ * @param[in/out] optState The state of the option parser.
+ * @param[in/out] optKind  The kind of the option being parsed.
+ * @param[in/out] optRem   The number of data bytes left in the current option.
+ * @param[in/out] optIdx   The index of the next data byte in the current option.
+ * @param[in/out] optWord  The last four data bytes of the current option.
+ * @param[out]    meta     The metadata to update with the parsed options.
+ *
+ * @details
+ *  The options are parsed one byte at a time, which allows them to be placed at
+ *   any offset and to span over several chunks. Only the SACK-Permitted, the
+ *   SACK and the Window Scale options are extracted. All the other options are
+ *   skipped.
+ *******************************************************************************/
+void parseTcpOptions(
+        AxisPsd4        &chunk,
+        ap_uint<4>       nrBytes,
+        OptParserState  &optState,
+        TcpOptKind      &optKind,
+        TcpOptLen       &optRem,
+        TcpOptLen       &optIdx,
+        ap_uint<32>     &optWord,
+        RXeMeta         &meta)
+{
+    #pragma HLS INLINE
+
+    for (int b=0; b<8; ++b) {
+    #pragma HLS UNROLL
+        if (b < nrBytes) {
+            ap_uint<8> byte = chunk.getLE_TData(b*8+7, b*8);
+            switch (optState) {
+            case OPT_KIND:
+                if (byte == TCP_OPT_KIND_EOL) {
+                    optState = OPT_END;
+                }
+                else if (byte != TCP_OPT_KIND_NOP) {
+                    optKind  = byte;
+                    optState = OPT_LEN;
+                }
+                break;
+            case OPT_LEN:
+                if (byte <= 2) {
+                    // Option without data (a length < 2 is malformed)
+                    if (optKind == TCP_OPT_KIND_SACK) {
+                        meta.sackOk = true;
+                    }
+                    optState = (byte < 2) ? OPT_END : OPT_KIND;
+                }
+                else {
+                    optRem   = byte - 2;
+                    optIdx   = 0;
+                    optState = OPT_DATA;
+                }
+                break;
+            case OPT_DATA:
+                optWord = (optWord(23, 0), byte);
+                optIdx++;
+                optRem--;
+                if ((optKind == TCP_OPT_KIND_WSS) and (optIdx == 1)) {
+                    // A shift count greater than 14 must be treated as 14 (RFC-7323)
+                    meta.winScaleOk = true;
+                    meta.winScale   = (byte > 14) ? (TcpWinScale)14 : (TcpWinScale)byte;
+                }
+                if ((optKind == TCP_OPT_KIND_SBLK) and (optIdx(1, 0) == 0)) {
+                    // Every SACK block is a 32-bit left edge followed by a 32-bit right edge
+                    ap_uint<5> blk = (optIdx - 1) >> 3;
+                    if (blk < TOE_SACK_BLOCKS) {
+                        if (optIdx[2] == 1) {
+                            meta.sackBlk[blk].left  = optWord;
+                        }
+                        else {
+                            meta.sackBlk[blk].right = optWord;
+                            meta.sackCnt = blk + 1;
+                        }
+                    }
+                }
+                if (optRem == 0) {
+                    optState = OPT_KIND;
+                }
+                break;
+            default: // OPT_END
+                break;
+            }
+        }
+    }
+}
+
 /*******************************************************************************
  * @brief TCP checksum accumulator (Csa)
  *
  * @param[in]  siIph_PseudoPkt A pseudo TCP packet from InsertPseudoHeader (Iph).
+ * @param[in]  siTle_IpCe      The CE mark of the IP packet from TcpLengthExtractor (Tle).
  * @param[out] soTid_Data      TCP data stream to TcpInvalidDropper (Tid).
  * @param[out] soTid_DataVal   TCP data valid to [Tid].
- * @param[out] soMdh_Meta      TCP metadata to MetaDataHandler (Mdh).
- * @param[out] soMdh_SockPair  TCP socket pair to [Mdh].
+ * @param[out] soSch_Meta      TCP metadata to SynCookieHasher (Sch).
+ * @param[out] soSch_SockPair  TCP socket pair to [Sch].
  * @param[out] soPRt_GetState  Req state of the TCP DestPort to PortTable (PRt).
  *
  * @details
@@ -418,7 +514,7 @@ void pInsertPseudoHeader(
  *   and forwards it to the TcpInvalidDropper (Tid) together with a valid bit
  *   indicating the result of the checksum validation.
  *  It also extracts the socket pair information and some metadata information
- *   from the TCP segment and forwards them to the MetaDataHandler (Mdh).
+ *   from the TCP segment and forwards them to the SynCookieHasher (Sch).
  *  Next, the TCP destination port number is extracted and forwarded to the
  *   PortTable (PRt) process to check if the port is open.
  *
@@ -443,10 +539,11 @@ void pInsertPseudoHeader(
  *******************************************************************************/
 void pCheckSumAccumulator(
         stream<AxisPsd4>          &siIph_PseudoPkt,
+        stream<FlagBool>          &siTle_IpCe,
         stream<AxisApp>           &soTid_Data,
         stream<ValBit>            &soTid_DataVal,
-        stream<RXeMeta>           &soMdh_Meta,
-        stream<SocketPair>        &soMdh_SockPair,
+        stream<RXeMeta>           &soSch_Meta,
+        stream<SocketPair>        &soSch_SockPair,
         stream<TcpPort>           &soPRt_GetState)
 {
     //-- DIRECTIVES FOR THIS PROCESS -------------------------------------------
@@ -462,12 +559,8 @@ void pCheckSumAccumulator(
     #pragma HLS RESET  variable=csa_doCSumVerif
     static bool                 csa_residue=false;
     #pragma HLS RESET  variable=csa_residue
-    static ap_uint<3>           csa_cc_state=0;
-    #pragma HLS RESET  variable=csa_cc_state
-    static ap_uint<17>          csa_tcp_sums[4]={0, 0, 0, 0};
-    #pragma HLS RESET  variable=csa_tcp_sums
-    #pragma HLS ARRAY_PARTITION \
-                       variable=csa_tcp_sums complete dim=1
+    static CsumAcc              csa_csumAcc=0;
+    #pragma HLS RESET  variable=csa_csumAcc
 
     //-- STATIC DATAFLOW VARIABLES ---------------------------------------------
     static TcpDataOff       csa_dataOffset;
@@ -478,6 +571,11 @@ void pCheckSumAccumulator(
     static TcpChecksum      csa_tcpCSum;
     static ap_uint<32>      csa_half_tdata;
     static ap_uint<4>       csa_half_tkeep;
+    static OptParserState   csa_optState;
+    static TcpOptKind       csa_optKind;
+    static TcpOptLen        csa_optRem;
+    static TcpOptLen        csa_optIdx;
+    static ap_uint<32>      csa_optWord;
 
     //-- DYNAMIC VARIABLES -----------------------------------------------------
     AxisPsd4                currChunk(0,0,0);
@@ -492,6 +590,8 @@ void pCheckSumAccumulator(
             // Get IP-SA & IP-DA
             csa_socketPair.src.addr = currChunk.getPsd4SrcAddr();
             csa_socketPair.dst.addr = currChunk.getPsd4DstAddr();
+            // Get the CE mark (always written by [Tle] ahead of this chunk)
+            csa_meta.ce = siTle_IpCe.read();
             sendChunk.setTLast(currChunk.getTLast());
             csa_chunkCount++;
             break;
@@ -519,34 +619,39 @@ void pCheckSumAccumulator(
             // Get Control Bits
             //  [ 8] == FIN | [ 9] == SYN | [10] == RST
             //  [11] == PSH | [12] == ACK | [13] == URG
+            //  [14] == ECE | [15] == CWR
             csa_meta.ack = currChunk.getTcpCtrlAck();
             csa_meta.rst = currChunk.getTcpCtrlRst();
             csa_meta.syn = currChunk.getTcpCtrlSyn();
             csa_meta.fin = currChunk.getTcpCtrlFin();
+            csa_meta.psh = currChunk.getTcpCtrlPsh();
+            csa_meta.ece = currChunk.getTcpCtrlEce();
+            csa_meta.cwr = currChunk.getTcpCtrlCwr();
             // Get Window Size
             csa_meta.winSize = currChunk.getTcpWindow();
             // Get the checksum of the pseudo-header (only for debug purposes)
             csa_tcpCSum  = currChunk.getTcpChecksum();
+            // Reset the TCP option parser
+            csa_meta.sackOk  = false;
+            csa_meta.sackCnt = 0;
+            csa_meta.winScaleOk = false;
+            csa_meta.winScale   = 0;
+            csa_optState     = OPT_KIND;
             sendChunk.setTLast(currChunk.getTLast());
             csa_chunkCount++;
             break;
         default:
             if (csa_dataOffset >= 6) {
                 // Handle TCP options.
-                //  Warning: At this point, we only support one TCP option and
-                //   we further assume that this option is always 32-bit aligned.
-                //  [TODO] Must add support for Window Scaling and unaligned options.
-                TcpOptKind optionKind = currChunk.getTcpOptKind();
-                if (optionKind == TCP_OPT_KIND_MSS) {
-                    // Extract the MSS value
-                    TcpOptMss theirMSS = currChunk.getTcpOptMss();
-                    if (DEBUG_LEVEL & TRACE_CSA) {
-                        printInfo(myName, "TCP segment includes 4 option bytes (OptKind=2, OptLen=4, MSS=%d)\n",
-                                  theirMSS.to_uint());
-                    }
-                }
-                else {
-                    printWarn(myName, "The TCP option %d is not yet supported and will be dropped.\n", optionKind.to_uchar());
+                //  The options are not required to be 32-bit aligned and may
+                //  span over several chunks. Only SACK and WSopt are extracted.
+                parseTcpOptions(currChunk, (csa_dataOffset == 6) ? 4 : 8,
+                                csa_optState, csa_optKind, csa_optRem, csa_optIdx,
+                                csa_optWord, csa_meta);
+                if (DEBUG_LEVEL & TRACE_CSA) {
+                    printInfo(myName, "TCP segment includes option bytes (SackOk=%d, SackCnt=%d, WinScale=%d).\n",
+                              csa_meta.sackOk ? 1 : 0, csa_meta.sackCnt.to_uint(),
+                              csa_meta.winScaleOk ? csa_meta.winScale.to_int() : -1);
                 }
                 if (csa_dataOffset == 6) {
                     csa_dataOffset -= 1;
@@ -580,22 +685,7 @@ void pCheckSumAccumulator(
         } // End of: switch
 
         // Accumulate TCP checksum
-        for (int i = 0; i < 4; i++) {
-            #pragma HLS UNROLL
-            TcpCsum temp;
-            if (currChunk.getLE_TKeep(i*2+1, i*2) == 0x3) {
-                temp( 7, 0) = currChunk.getLE_TData(i*16+15, i*16+8);
-                temp(15, 8) = currChunk.getLE_TData(i*16+ 7, i*16);
-                csa_tcp_sums[i] += temp;
-                csa_tcp_sums[i] = (csa_tcp_sums[i] + (csa_tcp_sums[i] >> 16)) & 0xFFFF;
-            }
-            else if (currChunk.getLE_TKeep()[i*2] == 0x1) {
-                temp( 7, 0) = 0;
-                temp(15, 8) = currChunk.getLE_TData(i*16+7, i*16);
-                csa_tcp_sums[i] += temp;
-                csa_tcp_sums[i] = (csa_tcp_sums[i] + (csa_tcp_sums[i] >> 16)) & 0xFFFF;
-            }
-        }
+        csa_csumAcc = csumAccumulate<ARW>(csa_csumAcc, currChunk);
 
         // Handle last chunk
         if(currChunk.getTLast()) {
@@ -617,65 +707,35 @@ void pCheckSumAccumulator(
         csa_residue = false;
     }
     else if (csa_doCSumVerif) {
-        switch (csa_cc_state) {
-            case 0:
-                csa_tcp_sums[0] = (csa_tcp_sums[0] + (csa_tcp_sums[0] >> 16)) & 0xFFFF;
-                csa_tcp_sums[1] = (csa_tcp_sums[1] + (csa_tcp_sums[1] >> 16)) & 0xFFFF;
-                csa_tcp_sums[2] = (csa_tcp_sums[2] + (csa_tcp_sums[2] >> 16)) & 0xFFFF;
-                csa_tcp_sums[3] = (csa_tcp_sums[3] + (csa_tcp_sums[3] >> 16)) & 0xFFFF;
-                csa_cc_state++;
-                break;
-            case 1:
-                csa_tcp_sums[0] += csa_tcp_sums[2];
-                csa_tcp_sums[1] += csa_tcp_sums[3];
-                csa_tcp_sums[0] = (csa_tcp_sums[0] + (csa_tcp_sums[0] >> 16)) & 0xFFFF;
-                csa_tcp_sums[1] = (csa_tcp_sums[1] + (csa_tcp_sums[1] >> 16)) & 0xFFFF;
-                csa_cc_state++;
-                break;
-            case 2:
-                csa_tcp_sums[0] += csa_tcp_sums[1];
-                csa_tcp_sums[0] = (csa_tcp_sums[0] + (csa_tcp_sums[0] >> 16)) & 0xFFFF;
-                csa_cc_state++;
-                break;
-            case 3:
-                csa_tcp_sums[0] = ~csa_tcp_sums[0];
-                csa_cc_state++;
-                break;
-            case 4:
-                if (csa_tcp_sums[0](15, 0) == 0) {
-                    // The checksum is correct. TCP segment is valid.
-                    // Forward to metadata to MetaDataHandler
-                    soMdh_Meta.write(csa_meta);
-                    soMdh_SockPair.write(csa_socketPair);
-                    if (csa_meta.length != 0) {
-                        // Forward valid checksum info to TcpInvalidDropper
-                        soTid_DataVal.write(OK);
-                        if (DEBUG_LEVEL & TRACE_CSA) {
-                            printInfo(myName, "Received end-of-packet. Checksum is correct.\n");
-                        }
-                    }
-                    // Request state of TCP_DP
-                    soPRt_GetState.write(csa_tcpDstPort);
-                }
-                else {
-                    printWarn(myName, "RECEIVED BAD CHECKSUM (0x%4.4X - Delta= 0x%4.4X).\n",
-                                csa_tcpCSum.to_uint(), (~csa_tcp_sums[0](15, 0).to_uint() & 0xFFFF));
-                    if(csa_meta.length != 0) {
-                        // Packet has some TCP payload
-                        soTid_DataVal.write(KO);
-                    }
-                    if (DEBUG_LEVEL & TRACE_CSA) {
-                        printSockPair(myName, csa_socketPair);
-                    }
+        TcpCsum csum = csumFinalize(csa_csumAcc);
+        if (csum == 0) {
+            // The checksum is correct. TCP segment is valid.
+            // Forward to metadata to SynCookieHasher
+            soSch_Meta.write(csa_meta);
+            soSch_SockPair.write(csa_socketPair);
+            if (csa_meta.length != 0) {
+                // Forward valid checksum info to TcpInvalidDropper
+                soTid_DataVal.write(OK);
+                if (DEBUG_LEVEL & TRACE_CSA) {
+                    printInfo(myName, "Received end-of-packet. Checksum is correct.\n");
                 }
-                csa_doCSumVerif = false;
-                csa_tcp_sums[0] = 0;
-                csa_tcp_sums[1] = 0;
-                csa_tcp_sums[2] = 0;
-                csa_tcp_sums[3] = 0;
-                csa_cc_state = 0;
-                break;
-        } // End of: switch
+            }
+            // Request state of TCP_DP
+            soPRt_GetState.write(csa_tcpDstPort);
+        }
+        else {
+            printWarn(myName, "RECEIVED BAD CHECKSUM (0x%4.4X - Delta= 0x%4.4X).\n",
+                        csa_tcpCSum.to_uint(), (~csum).to_uint() & 0xFFFF);
+            if(csa_meta.length != 0) {
+                // Packet has some TCP payload
+                soTid_DataVal.write(KO);
+            }
+            if (DEBUG_LEVEL & TRACE_CSA) {
+                printSockPair(myName, csa_socketPair);
+            }
+        }
+        csa_doCSumVerif = false;
+        csa_csumAcc = 0;
     }
 } // End of: pCheckSumAccumulator
 
@@ -851,10 +911,18 @@ void pTcpSegmentDropper(
  *   the memory sub-system (MEM).
  *  The Rx buffer memory is organized and managed as a circular buffer, and it
  *   may happen that the received segment does not fit into remain memory buffer
- *   space because the memory pointer needs to wrap around. In such a case, the
- *   incoming segment is broken down and written into physical DRAM as two
- *   memory buffers, and the follow-on RxAppNotifier (Ran) process is notified
- *   about this splitted segment
+ *   space because the memory pointer needs to wrap around or because it crosses
+ *   a buffer page (see 'TOE_BUFFER_PAGING'). In such a case, the incoming
+ *   segment is broken down and written into physical DRAM as two memory
+ *   buffers, and the follow-on RxAppNotifier (Ran) process is notified about
+ *   this splitted segment
+ *  The command side and the data side of this process are decoupled. A command
+ *   from [Fsm] is turned into one or two data mover commands (.i.e a scatter
+ *   list of up to two buffers) in the very same cycle as the first data chunk
+ *   of its segment is forwarded, and the command of the 2nd buffer is issued
+ *   while the 1st buffer is being streamed. The data side re-aligns the 2nd
+ *   buffer on the fly, such that a segment is written at one chunk per cycle
+ *   whether it is split or not.
  *******************************************************************************/
 void pRxMemoryWriter(
         stream<AxisApp>     &siTsd_Data,
@@ -871,62 +939,78 @@ void pRxMemoryWriter(
 
     //-- STATIC CONTROL VARIABLES (with RESET) ---------------------------------
     static enum FsmStates { MWR_IDLE=0,
-                            MWR_FWD_ALIGNED, MWR_SPLIT_1ST_CMD,
-                            MWR_FWD_1ST_BUF, MWR_FWD_2ND_BUF, MWR_RESIDUE } \
+                            MWR_FWD_ALIGNED, MWR_FWD_1ST_BUF,
+                            MWR_FWD_2ND_BUF, MWR_RESIDUE } \
                                 mwr_fsmState=MWR_IDLE;
     #pragma HLS RESET  variable=mwr_fsmState
-    static ap_uint<3>           mwr_residueLen=0;
-    #pragma HLS RESET  variable=mwr_residueLen
-    static bool                 mwr_accessBreakdown=false;
-    #pragma HLS RESET  variable=mwr_accessBreakdown
+    static bool                 mwr_2ndCmdPending=false;
+    #pragma HLS RESET  variable=mwr_2ndCmdPending
 
     //-- STATIC DATAFLOW VARIABLES ---------------------------------------------
     static DmCmd       mwr_memWrCmd;
+    static DmCmd       mwr_2ndMemWrCmd;  // The command of the 2nd buffer of a split segment
     static AxisApp     mwr_currChunk;
     static RxBufPtr    mwr_firstAccLen;
     static TcpSegLen   mwr_nrBytesToWr;
     static ap_uint<4>  mwr_splitOffset;
     static uint16_t    mwr_debugCounter=3; // To align with # in the DAT file
 
-    switch (mwr_fsmState) {
-    case MWR_IDLE:
-        if (!siFsm_MemWrCmd.empty() and !soRan_SplitSeg.full() and !soMEM_WrCmd.full()) {
-            siFsm_MemWrCmd.read(mwr_memWrCmd);
-            if ((mwr_memWrCmd.saddr.range(TOE_WINDOW_BITS-1, 0) + mwr_memWrCmd.btt) > TOE_RX_BUFFER_SIZE) {
-                //-- Break this segment in two memory accesses because TCP Rx memory buffer wraps around
-                soRan_SplitSeg.write(true);
-
-                if (DEBUG_LEVEL & TRACE_MWR) {
-                    printInfo(myName, "TCP Rx memory buffer wraps around: This segment will be broken in two memory buffers.\n");
-                }
-                mwr_fsmState = MWR_SPLIT_1ST_CMD;
-            }
-            else {
-                //-- Don't split and issue the write command
-                soRan_SplitSeg.write(false);
-                soMEM_WrCmd.write(mwr_memWrCmd);
-
-                if (DEBUG_LEVEL & TRACE_MWR) {
-                    printInfo(myName, "Issuing memory write command #%d - SADDR=0x%9.9x - BTT=%d\n",
-                              mwr_debugCounter, mwr_memWrCmd.saddr.to_uint(), mwr_memWrCmd.btt.to_uint());
-                    mwr_debugCounter++;
-                }
-                mwr_fsmState = MWR_FWD_ALIGNED;
+    //-----------------------------------------------------
+    //-- COMMAND SIDE
+    //-----------------------------------------------------
+    if (mwr_2ndCmdPending) {
+        //-- Issue the command of the 2nd buffer while the 1st one is streamed
+        if (!soMEM_WrCmd.full()) {
+            soMEM_WrCmd.write(mwr_2ndMemWrCmd);
+            mwr_2ndCmdPending = false;
+            if (DEBUG_LEVEL & TRACE_MWR) {
+                printInfo(myName, "Issuing 2nd memory write command #%d - SADDR=0x%9.9x - BTT=%d\n",
+                          mwr_debugCounter, mwr_2ndMemWrCmd.saddr.to_uint(), mwr_2ndMemWrCmd.btt.to_uint());
+                mwr_debugCounter++;
             }
         }
-        break;
-    case MWR_SPLIT_1ST_CMD:
-        if (!soMEM_WrCmd.full()) {
-            mwr_firstAccLen   = TOE_RX_BUFFER_SIZE - mwr_memWrCmd.saddr;
-            mwr_nrBytesToWr   = mwr_firstAccLen;
+    }
+    else if ((mwr_fsmState == MWR_IDLE) and
+             !siFsm_MemWrCmd.empty() and !soRan_SplitSeg.full() and !soMEM_WrCmd.full()) {
+        siFsm_MemWrCmd.read(mwr_memWrCmd);
+        if (crossesPage(mwr_memWrCmd.saddr(TOE_WINDOW_BITS-1, 0), mwr_memWrCmd.btt)) {
+            //-- Break this segment in two memory accesses because TCP Rx memory buffer wraps around
+            //-- or because the segment crosses a page boundary
+            soRan_SplitSeg.write(true);
+            mwr_firstAccLen = TOE_PAGE_SIZE - mwr_memWrCmd.saddr(TOE_PAGE_BITS-1, 0);
+            mwr_nrBytesToWr = mwr_firstAccLen;
             soMEM_WrCmd.write(DmCmd(mwr_memWrCmd.saddr, mwr_firstAccLen));
-
+            //-- Prepare the command of the 2nd buffer
+            mwr_2ndMemWrCmd = mwr_memWrCmd;
+            mwr_2ndMemWrCmd.saddr(TOE_WINDOW_BITS-1, 0) = getNextPageAdr(mwr_memWrCmd.saddr(TOE_WINDOW_BITS-1, 0));
+            mwr_2ndMemWrCmd.btt = mwr_memWrCmd.btt - mwr_firstAccLen;
+            mwr_2ndCmdPending = true;
             if (DEBUG_LEVEL & TRACE_MWR) {
+                printInfo(myName, "TCP Rx memory buffer wraps around: This segment will be broken in two memory buffers.\n");
                 printInfo(myName, "Issuing 1st memory write command #%d - SADDR=0x%9.9x - BTT=%d\n",
                     mwr_debugCounter, mwr_memWrCmd.saddr.to_uint(), mwr_firstAccLen.to_uint());
             }
             mwr_fsmState = MWR_FWD_1ST_BUF;
         }
+        else {
+            //-- Don't split and issue the write command
+            soRan_SplitSeg.write(false);
+            soMEM_WrCmd.write(mwr_memWrCmd);
+            if (DEBUG_LEVEL & TRACE_MWR) {
+                printInfo(myName, "Issuing memory write command #%d - SADDR=0x%9.9x - BTT=%d\n",
+                          mwr_debugCounter, mwr_memWrCmd.saddr.to_uint(), mwr_memWrCmd.btt.to_uint());
+                mwr_debugCounter++;
+            }
+            mwr_fsmState = MWR_FWD_ALIGNED;
+        }
+    }
+
+    //-----------------------------------------------------
+    //-- DATA SIDE
+    //-----------------------------------------------------
+    switch (mwr_fsmState) {
+    case MWR_IDLE:
+        //-- Wait for the command side to start a new segment
         break;
     case MWR_FWD_ALIGNED:
         if (!siTsd_Data.empty() and !soMEM_WrData.full()) {
@@ -949,48 +1033,24 @@ void pRxMemoryWriter(
             if (mwr_nrBytesToWr > (ARW/8)) {
                 mwr_nrBytesToWr -= (ARW/8);
             }
-            else if (!soMEM_WrCmd.full()) {
-                if (mwr_nrBytesToWr == (ARW/8)) {
-                    //-- End of 1st segment and begin of 2nd segment are aligned
-                    memChunk.setLE_TLast(TLAST);
-
-                    //-- Prepare and issue 2nd command
-                    mwr_memWrCmd.saddr(TOE_WINDOW_BITS-1, 0) = 0;
-                    mwr_memWrCmd.btt -= mwr_firstAccLen;
-                    soMEM_WrCmd.write(mwr_memWrCmd);
-
-                    if (DEBUG_LEVEL & TRACE_MWR) {
-                        printInfo(myName, "Issuing 2nd memory write command #%d - SADDR=0x%9.9x - BTT=%d\n",
-                                  mwr_debugCounter, mwr_memWrCmd.saddr.to_uint(), mwr_memWrCmd.btt.to_uint());
-                        mwr_debugCounter++;
-                    }
-                    mwr_fsmState = MWR_FWD_ALIGNED;
+            else if (mwr_nrBytesToWr == (ARW/8)) {
+                //-- End of 1st segment and begin of 2nd segment are aligned
+                memChunk.setLE_TLast(TLAST);
+                mwr_fsmState = MWR_FWD_ALIGNED;
+            }
+            else {
+                //-- End of 1st segment and begin of 2nd segment not aligned
+                memChunk.setLE_TLast(TLAST);
+                memChunk.setLE_TKeep(lenToLE_tKeep(mwr_nrBytesToWr));
+                #ifndef __SYNTHESIS__
+                memChunk.setLE_TData(0, (ARW-1), ((int)mwr_nrBytesToWr*8));
+                #endif
+                mwr_splitOffset = (ARW/8) - mwr_nrBytesToWr;
+                if (mwr_currChunk.getLE_TLast()) {
+                    mwr_fsmState = MWR_RESIDUE;
                 }
                 else {
-                    //-- End of 1st segment and begin of 2nd segment not aligned
-                    memChunk.setLE_TLast(TLAST);
-                    memChunk.setLE_TKeep(lenToLE_tKeep(mwr_nrBytesToWr));
-                    #ifndef __SYNTHESIS__
-                    memChunk.setLE_TData(0, (ARW-1), ((int)mwr_nrBytesToWr*8));
-                    #endif
-
-                    //-- Prepare and issue 2nd command
-                    mwr_memWrCmd.saddr(TOE_WINDOW_BITS-1, 0) = 0;
-                    mwr_memWrCmd.btt -= mwr_firstAccLen;
-                    soMEM_WrCmd.write(mwr_memWrCmd);
-
-                    if (DEBUG_LEVEL & TRACE_MWR) {
-                        printInfo(myName, "Issuing 2nd memory write command #%d - SADDR=0x%9.9x - BTT=%d\n",
-                                  mwr_debugCounter, mwr_memWrCmd.saddr.to_uint(), mwr_memWrCmd.btt.to_uint());
-                        mwr_debugCounter++;
-                    }
-                    mwr_splitOffset = (ARW/8) - mwr_nrBytesToWr;
-                    if (mwr_currChunk.getLE_TLast()) {
-                        mwr_fsmState = MWR_RESIDUE;
-                    }
-                    else {
-                        mwr_fsmState = MWR_FWD_2ND_BUF;
-                    }
+                    mwr_fsmState = MWR_FWD_2ND_BUF;
                 }
             }
 
@@ -1170,11 +1230,229 @@ void pRxAppNotifier(
     }
 }
 
+#ifndef __SYNTHESIS__
+  //-- The number of SYN cookies sent, accepted and rejected (for the testbench only)
+  static unsigned int rxeNrCookiesSent     = 0;
+  static unsigned int rxeNrCookiesAccepted = 0;
+  static unsigned int rxeNrCookiesRejected = 0;
+
+  /*****************************************************************************
+   * @brief Return the SYN cookie statistics of the MetaDataHandler.
+   *
+   * @param[out] nrSent      The number of SYN_ACKs sent with a SYN cookie.
+   * @param[out] nrAccepted  The number of ACKs that opened a session.
+   * @param[out] nrRejected  The number of ACKs with an invalid or stale cookie.
+   *****************************************************************************/
+  void getSynCookieStats(unsigned int &nrSent, unsigned int &nrAccepted,
+                         unsigned int &nrRejected) {
+      nrSent     = rxeNrCookiesSent;
+      nrAccepted = rxeNrCookiesAccepted;
+      nrRejected = rxeNrCookiesRejected;
+  }
+#endif
+
 /*******************************************************************************
- * @brief MetaData Handler (Mdh)
+ * @brief Run one SipRound over the state of a SipHash.
+ *
+ * @param[in/out] v0,v1,v2,v3 The four state words of the hash.
+ *******************************************************************************/
+void sipRound(
+        ap_uint<64>     &v0,
+        ap_uint<64>     &v1,
+        ap_uint<64>     &v2,
+        ap_uint<64>     &v3)
+{
+    #pragma HLS INLINE
+
+    v0 += v1; v1 = (v1(50, 0), v1(63, 51)); v1 ^= v0; v0 = (v0(31, 0), v0(63, 32));
+    v2 += v3; v3 = (v3(47, 0), v3(63, 48)); v3 ^= v2;
+    v0 += v3; v3 = (v3(42, 0), v3(63, 43)); v3 ^= v0;
+    v2 += v1; v1 = (v1(46, 0), v1(63, 47)); v1 ^= v2; v2 = (v2(31, 0), v2(63, 32));
+}
+
+/*******************************************************************************
+ * @brief Compute the SipHash-2-4 of a message of three 64-bit words.
+ *
+ * @param[in] key  The 128-bit secret key.
+ * @param[in] msg  The three words of the message.
+ *
+ * @return the 64-bit hash value.
+ *
+ * @details
+ *  The message words are taken as they are (i.e. the byte order of the
+ *   reference implementation is not applied), followed by the standard
+ *   length block of a 24-byte message. All the rounds are unrolled such that
+ *   the hash can be pipelined at II=1.
+ *******************************************************************************/
+ap_uint<64> sipHash24(
+        SynCookieKey     key,
+        ap_uint<64>      msg[3])
+{
+    #pragma HLS INLINE
+
+    ap_uint<64> k0 = key( 63,  0);
+    ap_uint<64> k1 = key(127, 64);
+    ap_uint<64> v0 = k0 ^ ap_uint<64>("736f6d6570736575", 16);
+    ap_uint<64> v1 = k1 ^ ap_uint<64>("646f72616e646f6d", 16);
+    ap_uint<64> v2 = k0 ^ ap_uint<64>("6c7967656e657261", 16);
+    ap_uint<64> v3 = k1 ^ ap_uint<64>("7465646279746573", 16);
+
+    for (int i=0; i<4; ++i) {
+    #pragma HLS UNROLL
+        ap_uint<64> m = (i < 3) ? msg[i] : (ap_uint<64>)(ap_uint<64>(24) << 56);
+        v3 ^= m;
+        sipRound(v0, v1, v2, v3);
+        sipRound(v0, v1, v2, v3);
+        v0 ^= m;
+    }
+    v2 ^= 0xFF;
+    for (int i=0; i<4; ++i) {
+    #pragma HLS UNROLL
+        sipRound(v0, v1, v2, v3);
+    }
+    return v0 ^ v1 ^ v2 ^ v3;
+}
+
+/*******************************************************************************
+ * @brief Compute the keyed hash of a SYN cookie.
+ *
+ * @param[in] sockPair The socket pair of the incoming segment.
+ * @param[in] peerIsn  The initial sequence number of the peer.
+ * @param[in] epoch    The time slot of the cookie (all the bits of it).
+ * @param[in] opts     The TCP options encoded in the cookie.
+ * @param[in] key      The secret key of the time slot.
+ *
+ * @return the 24 least significant bits of the cookie.
+ *******************************************************************************/
+ap_uint<24> synCookieHash(
+        SocketPair      &sockPair,
+        TcpSeqNum        peerIsn,
+        SynCookieEpoch   epoch,
+        ap_uint<5>       opts,
+        SynCookieKey     key)
+{
+    #pragma HLS INLINE
+
+    ap_uint<64> msg[3];
+    #pragma HLS ARRAY_PARTITION variable=msg complete dim=1
+    msg[0] = (sockPair.src.addr, sockPair.dst.addr);
+    msg[1] = (sockPair.src.port, sockPair.dst.port, peerIsn);
+    msg[2] = (ap_uint<27>(0), opts, epoch);
+    return sipHash24(key, msg)(23, 0);
+}
+
+/*******************************************************************************
+ * @brief SYN Cookie Hasher (Sch)
  *
  * @param[in]  siCsa_Meta       TCP metadata from CheckSumAccumulator (Csa).
  * @param[in]  siCsa_SockPair   TCP socket pair from [Csa].
+ * @param[in]  piMMIO_CookieKey The secret key of the SYN cookies from [MMIO].
+ * @param[out] soMdh_Meta       TCP metadata to MetaDataHandler (Mdh).
+ * @param[out] soMdh_SockPair   TCP socket pair to [Mdh].
+ * @param[out] soMdh_Cookie     The SYN cookie of the segment to [Mdh].
+ *
+ * @details
+ *  This process forwards the metadata and the socket pair of every segment to
+ *   the MetaDataHandler (Mdh), together with the SYN cookie of that segment.
+ *   For a SYN, this is the cookie to send as the initial sequence number of
+ *   the SYN_ACK. For any other segment, this is the verdict on the cookie that
+ *   its acknowledgment number returns. Both use the same SipHash-2-4 instance,
+ *   which is kept out of the FSM of [Mdh] to be pipelined at II=1.
+ *  The cookie is formatted as follows:
+ *   [31:29] the time slot, [28] the SACK-Permitted option, [27:24] the window
+ *   scale shift count of the peer (0xF if no Window Scale option) and [23:0]
+ *   the hash of the socket pair, the peer ISN, the slot and the options.
+ *  The hash is keyed with the key of the slot in which the cookie is issued.
+ *   A new key is loaded from [MMIO] at the start of every slot, and the key of
+ *   the previous slot is kept such that a cookie remains valid during its own
+ *   slot and the next one. The slot of an ACK is therefore recovered from the
+ *   3 slot bits of its cookie, and the key is selected by the parity of that
+ *   slot. The full slot count is hashed as well, such that a cookie cannot be
+ *   replayed when the 3 slot bits wrap around, even with a constant key.
+ *  FYI - The TOE uses one MSS for all its sessions. The option bits of the
+ *   cookie are therefore spent on SACK and window scaling, not on an MSS.
+ *******************************************************************************/
+void pSynCookieHasher(
+        stream<RXeMeta>             &siCsa_Meta,
+        stream<SocketPair>          &siCsa_SockPair,
+        SynCookieKey                 piMMIO_CookieKey,
+        stream<RXeMeta>             &soMdh_Meta,
+        stream<SocketPair>          &soMdh_SockPair,
+        stream<RXeCookie>           &soMdh_Cookie)
+{
+    //-- DIRECTIVES FOR THIS PROCESS -------------------------------------------
+    #pragma HLS PIPELINE II=1 enable_flush
+    #pragma HLS INLINE off
+
+    //-- STATIC CONTROL VARIABLES (with RESET) ---------------------------------
+    static ap_uint<SYN_COOKIE_SLOT_BITS> sch_cycleCnt=0;
+    #pragma HLS reset           variable=sch_cycleCnt
+    static SynCookieEpoch                sch_epoch=0;
+    #pragma HLS reset           variable=sch_epoch
+    static bool                          sch_keysLoaded=false;
+    #pragma HLS reset           variable=sch_keysLoaded
+
+    //-- STATIC DATAFLOW VARIABLES ---------------------------------------------
+    static SynCookieKey                  sch_keys[2];
+    #pragma HLS ARRAY_PARTITION variable=sch_keys complete dim=1
+
+    //-- DYNAMIC VARIABLES -----------------------------------------------------
+    RXeMeta                     meta;
+    SocketPair                  sockPair;
+    SynCookieEpoch              now = sch_epoch;
+
+    if (!siCsa_Meta.empty() and !siCsa_SockPair.empty() and
+        !soMdh_Meta.full() and !soMdh_SockPair.full() and !soMdh_Cookie.full()) {
+        siCsa_Meta.read(meta);
+        siCsa_SockPair.read(sockPair);
+        RXeCookie      rxeCookie(0, false);
+        if (TOE_SYN_COOKIES) {
+            TcpSeqNum      cookie  = meta.ackNumb - 1;
+            TcpSeqNum      peerIsn = meta.seqNumb - 1;
+            SynCookieSlot  age     = now(2, 0) - cookie(31, 29);
+            ap_uint<5>     opts    = cookie(28, 24);
+            if (meta.syn) {
+                // Issue a new cookie in the current slot
+                peerIsn  = meta.seqNumb;
+                opts[4]    = meta.sackOk;
+                opts(3, 0) = (meta.winScaleOk) ? meta.winScale : (TcpWinScale)0xF;
+                age      = 0;
+            }
+            SynCookieEpoch epoch = now - age;
+            ap_uint<24>    hash  = synCookieHash(sockPair, peerIsn, epoch, opts, sch_keys[epoch[0]]);
+            if (meta.syn) {
+                rxeCookie.cookie = (now(2, 0), opts, hash);
+            }
+            else {
+                rxeCookie.cookie = cookie;
+                rxeCookie.valid  = (age <= 1) and (cookie(23, 0) == hash);
+            }
+        }
+        soMdh_Meta.write(meta);
+        soMdh_SockPair.write(sockPair);
+        soMdh_Cookie.write(rxeCookie);
+    }
+
+    //-- Rekey at the start of every slot
+    if (!sch_keysLoaded) {
+        sch_keys[0] = piMMIO_CookieKey;
+        sch_keys[1] = piMMIO_CookieKey;
+        sch_keysLoaded = true;
+    }
+    else if (sch_cycleCnt == ~ap_uint<SYN_COOKIE_SLOT_BITS>(0)) {
+        SynCookieEpoch next = now + 1;
+        sch_keys[next[0]] = piMMIO_CookieKey;
+        sch_epoch = next;
+    }
+    sch_cycleCnt++;
+}
+
+/*******************************************************************************
+ * @brief MetaData Handler (Mdh)
+ *
+ * @param[in]  siSch_Meta       TCP metadata from SynCookieHasher (Sch).
+ * @param[in]  siSch_SockPair   TCP socket pair from [Sch].
+ * @param[in]  siSch_Cookie     The SYN cookie of the segment from [Sch].
  * @param[out] soSLc_SessLkpReq Session lookup request to Session Lookup Controller (SLc).
  * @param[in]  siSLc_SessLkpRep Session Lookup reply from [SLc].
  * @param[in]  siPRt_PortSts    Port state (opened/closed) from PortTable (PRt).
@@ -1186,17 +1464,24 @@ void pRxAppNotifier(
  * @details
  *  This process waits until it gets a response from the PortTable (PRt).
  *   It then loads the metadata and socket pair generated by the Checksum-
- *   Accumulator (Csa) process and evaluates them. Next, if the destination
+ *   Accumulator (Csa) process and forwarded by the SynCookieHasher (Sch),
+ *   and evaluates them. Next, if the destination
  *   port is opened, it requests the SessionLookupController (SLc) to perform
  *   a session lookup and waits for its reply. If a session is opened for this
  *   socket pair, a new metadata structure is generated and is forwarded to the
  *   FiniteStateMachine (FSm) of the RxEngine (RXe).
  *  If the target destination port is not opened, the process creates an event
  *   requesting a 'RST+ACK' TCP segment to be sent back to the initiating host.
+ *  When TOE_SYN_COOKIES is enabled, a SYN does not create any session. Instead,
+ *   a SYN_ACK is requested with a SYN cookie as initial sequence number. The
+ *   session is only created when the ACK of that SYN_ACK returns a valid cookie.
+ *   The SYN is then rebuilt from the cookie and forwarded to [Fsm] ahead of the
+ *   ACK itself. The cookies are issued and checked by [Sch].
  *******************************************************************************/
 void pMetaDataHandler(
-        stream<RXeMeta>             &siCsa_Meta,
-        stream<SocketPair>          &siCsa_SockPair,
+        stream<RXeMeta>             &siSch_Meta,
+        stream<SocketPair>          &siSch_SockPair,
+        stream<RXeCookie>           &siSch_Cookie,
         stream<SessionLookupQuery>  &soSLc_SessLkpReq,
         stream<SessionLookupReply>  &siSLc_SessLkpRep,
         stream<StsBit>              &siPRt_PortSts,
@@ -1213,15 +1498,19 @@ void pMetaDataHandler(
 
     //-- STATIC CONTROL VARIABLES (with RESET) ---------------------------------
     static enum FsmStates { MDH_META=0, \
-                            MDH_LOOKUP } mdh_fsmState;
+                            MDH_LOOKUP, \
+                            MDH_COOKIE_LOOKUP, \
+                            MDH_COOKIE_ACK } mdh_fsmState;
     #pragma HLS RESET           variable=mdh_fsmState
     static ap_uint<8 >                   mdh_SessDropCounter=0;
     #pragma HLS reset           variable=mdh_SessDropCounter
 
     //-- STATIC DATAFLOW VARIABLES ---------------------------------------------
     static RXeMeta              mdh_meta;
+    static RXeCookie            mdh_cookie;
     static SessionLookupReply   mdh_sessLookupReply;
     static Ip4Address           mdh_ip4SrcAddr;
+    static Ip4Address           mdh_ip4DstAddr;
     static TcpPort              mdh_tcpSrcPort;
     static TcpPort              mdh_tcpDstPort;
 
@@ -1234,11 +1523,13 @@ void pMetaDataHandler(
         // Wait until we get a reply from the PortTable (PRt)
         if (!siPRt_PortSts.empty()) {
             //  Read metadata and socket pair
-            if (!siCsa_Meta.empty() && !siCsa_SockPair.empty()) {
+            if (!siSch_Meta.empty() && !siSch_SockPair.empty() && !siSch_Cookie.empty()) {
                 siPRt_PortSts.read(dstPortStatus);
-                siCsa_Meta.read(mdh_meta);
-                siCsa_SockPair.read(socketPair);
+                siSch_Meta.read(mdh_meta);
+                siSch_SockPair.read(socketPair);
+                siSch_Cookie.read(mdh_cookie);
                 mdh_ip4SrcAddr = socketPair.src.addr;
+                mdh_ip4DstAddr = socketPair.dst.addr;
                 mdh_tcpSrcPort = socketPair.src.port;
                 mdh_tcpDstPort = socketPair.dst.port;
                 if (dstPortStatus == STS_CLOSED) {
@@ -1278,10 +1569,14 @@ void pMetaDataHandler(
                                   mdh_tcpDstPort.to_uint(), mdh_tcpDstPort.to_uint());
                     }
                     // Query a session lookup. Only allow creation of a new entry when SYN or SYN_ACK
+                    //  (with SYN cookies, a SYN is answered without creating any entry)
                     LE_SocketPair  leSocketPair(LE_SockAddr(byteSwap32(socketPair.src.addr),byteSwap16(socketPair.src.port)),
                                                 LE_SockAddr(byteSwap32(socketPair.dst.addr),byteSwap16(socketPair.dst.port)));
-                    soSLc_SessLkpReq.write(SessionLookupQuery(leSocketPair,
-                                          (mdh_meta.syn && !mdh_meta.rst && !mdh_meta.fin))); // [FIXME - Endianess
+                    bool allowCreation = (mdh_meta.syn && !mdh_meta.rst && !mdh_meta.fin);
+                    if (TOE_SYN_COOKIES) {
+                        allowCreation = allowCreation && mdh_meta.ack;
+                    }
+                    soSLc_SessLkpReq.write(SessionLookupQuery(leSocketPair, allowCreation)); // [FIXME - Endianess
                     if (DEBUG_LEVEL & TRACE_MDH) {
                         printInfo(myName, "Request the SLc to lookup the following session:\n");
                         printSockPair(myName, socketPair);
@@ -1304,20 +1599,107 @@ void pMetaDataHandler(
                 if (DEBUG_LEVEL & TRACE_MDH)
                     printInfo(myName, "Successful session lookup. \n");
             }
+            else if (TOE_SYN_COOKIES and mdh_meta.syn and !mdh_meta.ack and !mdh_meta.rst and !mdh_meta.fin) {
+                // Reply with a stateless 'SYN+ACK' carrying a SYN cookie
+                LE_SocketPair  switchedTuple; // [FIXME]
+                switchedTuple.src.addr = byteSwap32(mdh_ip4DstAddr);
+                switchedTuple.dst.addr = byteSwap32(mdh_ip4SrcAddr);
+                switchedTuple.src.port = byteSwap16(mdh_tcpDstPort);
+                switchedTuple.dst.port = byteSwap16(mdh_tcpSrcPort);
+                soEVe_Event.write(SynCookieEvent(switchedTuple, mdh_cookie.cookie, mdh_meta.seqNumb+1,
+                                                 mdh_meta.sackOk, mdh_meta.winScaleOk));
+                #ifndef __SYNTHESIS__
+                rxeNrCookiesSent++;
+                #endif
+                if (DEBUG_LEVEL & TRACE_MDH)
+                    printInfo(myName, "Replying to SYN with SYN cookie 0x%8.8X.\n", mdh_cookie.cookie.to_uint());
+            }
+            else if (TOE_SYN_COOKIES and mdh_meta.ack and !mdh_meta.syn and !mdh_meta.rst and !mdh_meta.fin) {
+                if (mdh_cookie.valid) {
+                    // The ACK returns one of our cookies. Create the session now.
+                    LE_SocketPair  leSocketPair(LE_SockAddr(byteSwap32(mdh_ip4SrcAddr), byteSwap16(mdh_tcpSrcPort)),
+                                                LE_SockAddr(byteSwap32(mdh_ip4DstAddr), byteSwap16(mdh_tcpDstPort)));
+                    soSLc_SessLkpReq.write(SessionLookupQuery(leSocketPair, true));
+                    mdh_fsmState = MDH_COOKIE_LOOKUP;
+                    if (DEBUG_LEVEL & TRACE_MDH)
+                        printInfo(myName, "Accepting SYN cookie 0x%8.8X.\n", mdh_cookie.cookie.to_uint());
+                }
+                else {
+                    #ifndef __SYNTHESIS__
+                    rxeNrCookiesRejected++;
+                    #endif
+                    if (DEBUG_LEVEL & TRACE_MDH)
+                        printWarn(myName, "Session lookup failed and SYN cookie is not valid! \n");
+                }
+            }
             else {
                 // [TODO - Port is Open, but we have no sessionID for it]
                 if (DEBUG_LEVEL & TRACE_MDH)
                     printWarn(myName, "Session lookup failed! \n");
             }
-            if (mdh_meta.length != 0) {
-                soTsd_DropCmd.write(!mdh_sessLookupReply.hit);
-                if (!mdh_sessLookupReply.hit) {
+            if (mdh_fsmState != MDH_COOKIE_LOOKUP) {
+                // Otherwise, the drop command is deferred until the session is created
+                if (mdh_meta.length != 0) {
+                    soTsd_DropCmd.write(!mdh_sessLookupReply.hit);
+                    if (!mdh_sessLookupReply.hit) {
+                        mdh_SessDropCounter++;
+                    }
+                }
+                mdh_fsmState = MDH_META;
+            }
+        }
+        break;
+    case MDH_COOKIE_LOOKUP:
+        // Wait until [SLc] created the session of a valid SYN cookie
+        if (!siSLc_SessLkpRep.empty()) {
+            siSLc_SessLkpRep.read(mdh_sessLookupReply);
+            if (mdh_sessLookupReply.hit) {
+                // Rebuild the SYN from the cookie and forward it to [Fsm]
+                TcpSeqNum cookie  = mdh_cookie.cookie;
+                RXeMeta   synMeta = mdh_meta;
+                synMeta.seqNumb    = mdh_meta.seqNumb - 1;
+                synMeta.length     = 0;
+                synMeta.ack        = 0;
+                synMeta.syn        = 1;
+                synMeta.psh        = 0;
+                synMeta.ece        = 0;  // No ECN with a SYN cookie
+                synMeta.cwr        = 0;
+                synMeta.sackOk     = cookie[28];
+                synMeta.sackCnt    = 0;
+                synMeta.winScaleOk = (cookie(27, 24) != 0xF);
+                synMeta.winScale   = cookie(27, 24);
+                RXeFsmMeta fsmMeta(mdh_sessLookupReply.sessionID,
+                                   mdh_ip4SrcAddr,  mdh_tcpSrcPort,
+                                   mdh_tcpDstPort,  synMeta);
+                fsmMeta.cookie = true;
+                soFsm_Meta.write(fsmMeta);
+                #ifndef __SYNTHESIS__
+                rxeNrCookiesAccepted++;
+                #endif
+                mdh_fsmState = MDH_COOKIE_ACK;
+            }
+            else {
+                // No session ID left
+                if (DEBUG_LEVEL & TRACE_MDH)
+                    printWarn(myName, "Cannot create the session of a valid SYN cookie! \n");
+                if (mdh_meta.length != 0) {
+                    soTsd_DropCmd.write(CMD_DROP);
                     mdh_SessDropCounter++;
                 }
+                mdh_fsmState = MDH_META;
             }
-            mdh_fsmState = MDH_META;
         }
         break;
+    case MDH_COOKIE_ACK:
+        // Forward the ACK that follows the rebuilt SYN
+        soFsm_Meta.write(RXeFsmMeta(mdh_sessLookupReply.sessionID,
+                                    mdh_ip4SrcAddr,  mdh_tcpSrcPort,
+                                    mdh_tcpDstPort,  mdh_meta));
+        if (mdh_meta.length != 0) {
+            soTsd_DropCmd.write(CMD_KEEP);
+        }
+        mdh_fsmState = MDH_META;
+        break;
     } // End of: switch
 
     //-- ALWAYS
@@ -1329,6 +1711,118 @@ void pMetaDataHandler(
     }
 } // End of: pMetaDataHandler
 
+/*******************************************************************************
+ * @brief Insert a received segment into the out-of-order blocks of a session.
+ *
+ * @param[in]  rxSar      The current Rx SAR entry of the session.
+ * @param[in]  segSeq     The sequence number of the segment.
+ * @param[in]  segLen     The length of the segment.
+ * @param[out] newRcvd    The updated 'rcvd' pointer.
+ * @param[out] newOooHead The updated head of the highest received byte.
+ * @param[out] newOooCnt  The updated number of out-of-order blocks.
+ * @param[out] newOooBlk  The updated out-of-order blocks.
+ *
+ * @return the status of the insertion. The outputs are only valid when the
+ *   segment is not dropped (.i.e, OOO_IN_ORDER or OOO_STORED).
+ *
+ * @details
+ *  The segment is merged with every block it overlaps or touches. If the
+ *   resulting block starts at 'rcvd', it is consumed and 'rcvd' advances to
+ *   its head. Otherwise, it is inserted in sequence order among the remaining
+ *   blocks, provided that a free block is left. All the comparisons are done
+ *   on offsets relative to 'rcvd' to be immune to sequence number wrap-around.
+ *******************************************************************************/
+OooInsertSts rxOooInsert(
+        RxSarReply     &rxSar,
+        RxSeqNum        segSeq,
+        TcpSegLen       segLen,
+        RxSeqNum       &newRcvd,
+        RxSeqNum       &newOooHead,
+        RxOooCnt       &newOooCnt,
+        RxOooBlock      newOooBlk[TOE_OOO_BLOCKS])
+{
+    #pragma HLS INLINE
+    #pragma HLS ARRAY_PARTITION variable=newOooBlk complete dim=1
+
+    ap_uint<32>  blkTail[TOE_OOO_BLOCKS];
+    #pragma HLS ARRAY_PARTITION variable=blkTail complete dim=1
+    ap_uint<32>  blkHead[TOE_OOO_BLOCKS];
+    #pragma HLS ARRAY_PARTITION variable=blkHead complete dim=1
+    bool         blkOvl[TOE_OOO_BLOCKS];
+    #pragma HLS ARRAY_PARTITION variable=blkOvl  complete dim=1
+    bool         blkKeep[TOE_OOO_BLOCKS];
+    #pragma HLS ARRAY_PARTITION variable=blkKeep complete dim=1
+
+    //-- Offsets relative to 'rcvd'
+    ap_uint<32> segTail = segSeq - rxSar.rcvd;
+    ap_uint<32> segHead = segTail + segLen;
+    ap_uint<32> room    = (RxBufPtr)((rxSar.appd - (RxBufPtr)rxSar.rcvd(TOE_WINDOW_BITS-1, 0)) - 1);
+    //  FYI - A gap filling segment may release all the blocks at once, but the
+    //   length of a notification to [APP] remains limited to 16 bits.
+    if (room > 0xFFFF) {
+        room = 0xFFFF;
+    }
+
+    if (segTail[31] == 1) {
+        return OOO_DROP_OLD;
+    }
+    if (segHead >= room) {
+        return OOO_DROP_NO_SPACE;
+    }
+
+    //-- Merge the segment with all the blocks it overlaps or touches
+    ap_uint<32> mrgTail = segTail;
+    ap_uint<32> mrgHead = segHead;
+    ap_uint<32> maxHead = 0;
+    RxOooCnt    nrKeep   = 0;
+    RxOooCnt    nrBefore = 0;
+    for (int i=0; i<TOE_OOO_BLOCKS; ++i) {
+    #pragma HLS UNROLL
+        bool valid = (i < rxSar.oooCnt);
+        blkTail[i] = rxSar.oooBlk[i].tail - rxSar.rcvd;
+        blkHead[i] = rxSar.oooBlk[i].head - rxSar.rcvd;
+        blkOvl[i]  = valid and (blkTail[i] <= segHead) and (segTail <= blkHead[i]);
+        blkKeep[i] = valid and !blkOvl[i];
+        if (blkOvl[i]) {
+            if (blkTail[i] < mrgTail) { mrgTail = blkTail[i]; }
+            if (blkHead[i] > mrgHead) { mrgHead = blkHead[i]; }
+        }
+        if (blkKeep[i]) {
+            nrKeep++;
+            if (blkHead[i] < segTail) { nrBefore++; }
+            if (blkHead[i] > maxHead) { maxHead = blkHead[i]; }
+        }
+    }
+
+    bool toRcvd = (mrgTail == 0);
+    if (!toRcvd and (nrKeep == TOE_OOO_BLOCKS)) {
+        return OOO_DROP_NO_BLOCK;
+    }
+
+    //-- Compact the kept blocks around the merged one
+    RxOooCnt pos = 0;
+    for (int i=0; i<TOE_OOO_BLOCKS; ++i) {
+    #pragma HLS UNROLL
+        if (blkKeep[i]) {
+            if (!toRcvd and (pos >= nrBefore)) {
+                newOooBlk[pos+1] = rxSar.oooBlk[i];
+            }
+            else {
+                newOooBlk[pos] = rxSar.oooBlk[i];
+            }
+            pos++;
+        }
+    }
+    if (!toRcvd) {
+        newOooBlk[nrBefore] = RxOooBlock(rxSar.rcvd + mrgTail, rxSar.rcvd + mrgHead);
+    }
+
+    newRcvd    = toRcvd ? RxSeqNum(rxSar.rcvd + mrgHead) : rxSar.rcvd;
+    newOooCnt  = toRcvd ? nrKeep : RxOooCnt(nrKeep + 1);
+    newOooHead = rxSar.rcvd + ((mrgHead > maxHead) ? mrgHead : maxHead);
+    return toRcvd ? OOO_IN_ORDER : OOO_STORED;
+}
+
 /*******************************************************************************
  * @brief Finite State machine (Fsm)
  *
@@ -1347,6 +1841,7 @@ void pMetaDataHandler(
  * @param[out] soTsd_DropCmd     Drop command to TcpSegmentDropper (Tsd).
  * @param[out] soMwr_WrCmd       Memory write command to MemoryWriter (Mwr).
  * @param[out] soRan_RxNotif     Rx data notification to RxAppNotifier (Ran).
+ * @param[in]  siPAl_PoolLow     The Rx pool of pages is running low from PageAllocator (PAl).
  * @param[out] soMMIO_OooDropCnt The value of the out-of-order drop counter.
  *
  * @details
@@ -1354,6 +1849,17 @@ void pMetaDataHandler(
  *   contains all the logic that updates the metadata and keeps track of the
  *   events related to the reception of segments and their handshaking. This is
  *   the key central part of the Rx engine.
+ *  When the TCP buffers are paged and [PAl] runs short of Rx pages, the data
+ *   segments are dropped as if the Rx buffer was full. The peer retransmits
+ *   them upon the duplicate ACK, while the Rx path keeps running.
+ *  ECN (RFC-3168) is negotiated when TOE_ECN is set. A SYN with ECE and CWR or
+ *   a SYN-ACK with ECE only enables it for the session. Next, the CE mark of
+ *   every data segment is stored in [RSt] and echoed with ECE by [TXe]. A
+ *   change of the CE state is acknowledged without delay, such that the peer
+ *   can count the marked bytes (RFC-8257). The incoming ECE flags are ignored
+ *   when ECN was not negotiated.
+ *  A retransmission timeout reported by [TSt] is forwarded to the Congestion
+ *   Control (CCo) with the next write query to [TSt].
  *****************************************************************************/
 void pFiniteStateMachine(
         stream<RXeFsmMeta>          &siMdh_FsmMeta,
@@ -1371,6 +1877,7 @@ void pFiniteStateMachine(
         stream<CmdBit>              &soTsd_DropCmd,
         stream<DmCmd>               &soMwr_WrCmd,
         stream<TcpAppNotif>         &soRan_RxNotif,
+        stream<SigBit>              &siPAl_PoolLow,
         stream<ap_uint<8> >         &soMMIO_OooDropCnt,
         stream<RxBufPtr>            &soDBG_RxFreeSpace,
         stream<ap_uint<32> >        &soDBG_TcpIpRxByteCnt,
@@ -1396,6 +1903,8 @@ void pFiniteStateMachine(
     #pragma HLS RESET   variable=fsm_rxByteCounter
     static ap_uint<8 >           fsm_oooDebugState=0;
     #pragma HLS RESET   variable=fsm_oooDebugState
+    static SigBit                fsm_poolLow=0;
+    #pragma HLS RESET   variable=fsm_poolLow
 
     //-- STATIC DATAFLOW VARIABLES ---------------------------------------------
     static RXeFsmMeta   fsm_Meta;
@@ -1408,6 +1917,10 @@ void pFiniteStateMachine(
 
     fsm_oooDebugState = 0;
 
+    if (TOE_PAGED_BUFFERS and !siPAl_PoolLow.empty()) {
+        siPAl_PoolLow.read(fsm_poolLow);
+    }
+
     switch(fsm_fsmState) {
     case FSM_LOAD:
         if (!siMdh_FsmMeta.empty()) {
@@ -1455,11 +1968,12 @@ void pFiniteStateMachine(
                               \t\t Meta.seqNum  =0x%8.8x \n \
                               \t\t RxSar.appd   =0x%8.8x \n \
                               \t\t RxSar.oooHead=0x%8.8x \n \
-                              \t\t RxSar.oooTail=0x%8.8x \n \
+                              \t\t RxSar.oooCnt =  %8d \n \
                               \t\t FreeSpace    =  %8d\n",
                               fsm_Meta.meta.seqNumb.to_uint(),
+                              rxSar.appd.to_uint(),
                               rxSar.oooHead.to_uint(),
-                              rxSar.oooTail.to_uint(),
+                              rxSar.oooCnt.to_uint(),
                               fsm_freeSpace.to_uint());
                 }
 
@@ -1475,45 +1989,53 @@ void pFiniteStateMachine(
                      (tcpState == FIN_WAIT_1)  || (tcpState == CLOSING)      ||
                      (tcpState == LAST_ACK) ) {
                     // Check if new ACK arrived
+                    CcEvent ccEvent = CC_NONE;
                     if ( (fsm_Meta.meta.ackNumb == txSar.prevAckd) and
                          (txSar.prevAckd != txSar.prevUnak) ) {
                         // Not new ACK; increase counter but only if it does not contain data
                         if (fsm_Meta.meta.length == 0) {
                             txSar.count++;
+                            if ((txSar.count == 3) and !txSar.fastRetransmitted) {
+                                ccEvent = CC_DUP_ACK;
+                            }
                         }
                     }
                     else {
                         // Notify probeTimer about new ACK
                         soTIm_ClearProbeTimer.write(fsm_Meta.sessionId);
-                        // Check for SlowStart & Increase Congestion Window
-                        if (txSar.cong_window <= (txSar.slowstart_threshold-ZYC2_MSS)) {
-                            txSar.cong_window += ZYC2_MSS;
-                        }
-                        else if (txSar.cong_window <= TOE_MAX_CONGESTION_WINDOW) { // 0xF7FF
-                            txSar.cong_window += 365; //TODO replace by approx. of (MSS x MSS) / cong_window
-                        }
+                        // The congestion window is increased by [CCo]
+                        ccEvent = CC_NEW_ACK;
                         txSar.count = 0;
                         txSar.fastRetransmitted = false;
                     }
                     // Update TxSarTable (only if count or retransmit)
                     if ( (  (fsm_Meta.meta.ackNumb >= txSar.prevAckd) and (fsm_Meta.meta.ackNumb <= txSar.prevUnak)) or
                           (((fsm_Meta.meta.ackNumb >= txSar.prevAckd) or  (fsm_Meta.meta.ackNumb <= txSar.prevUnak)) and (txSar.prevUnak < txSar.prevAckd))) {
-                        soTSt_TxSarQry.write((RXeTxSarQuery(fsm_Meta.sessionId,
-                                                            fsm_Meta.meta.ackNumb,
-                                                            fsm_Meta.meta.winSize,
-                                                            txSar.cong_window,
-                                                            txSar.count,
-                                                          ((txSar.count == 3) || txSar.fastRetransmitted))));
+                        RXeTxSarQuery txSarQry(fsm_Meta.sessionId,
+                                               fsm_Meta.meta.ackNumb,
+                                               scaleUpWindow(fsm_Meta.meta.winSize, rxSar.sndWinScale),
+                                               txSar.cong_window,
+                                               txSar.count,
+                                             ((txSar.count == 3) || txSar.fastRetransmitted),
+                                               fsm_Meta.meta.sackCnt,
+                                               fsm_Meta.meta.sackBlk);
+                        txSarQry.ccEvent    = ccEvent;
+                        txSarQry.ackedBytes = fsm_Meta.meta.ackNumb - txSar.prevAckd;
+                        txSarQry.ece        = fsm_Meta.meta.ece and rxSar.ecnOk;
+                        txSarQry.rto        = txSar.rtoPending;
+                        txSarQry.slowstart_threshold = txSar.slowstart_threshold;
+                        soTSt_TxSarQry.write(txSarQry);
                     }
 
                     // If packet contains payload
                     //  We must handle Out-Of-Order delivered segments
+                    bool delayAck = false;
                     if (fsm_Meta.meta.length != 0) {
 
                         // Build a DDR memory address for this segment
-                        //  FYI - The TCP Rx buffers use up to 1GB (16Kx64KB).
+                        //  FYI - The TCP Rx buffers use up to 1GB (4Kx256KB).
                         RxMemPtr memSegAddr = TOE_RX_MEMORY_BASE;
-                        memSegAddr(29, TOE_WINDOW_BITS) = fsm_Meta.sessionId(13, 0);
+                        memSegAddr(29, TOE_WINDOW_BITS) = fsm_Meta.sessionId(TOE_SESS_ADDR_BITS-1, 0);
                         memSegAddr(TOE_WINDOW_BITS-1, 0) = fsm_Meta.meta.seqNumb.range(TOE_WINDOW_BITS-1, 0);
 
                         // Increment the Rx byte counter
@@ -1521,37 +2043,50 @@ void pFiniteStateMachine(
 
                         RxSeqNum    newRcvd    = 0;
                         RxSeqNum    newOooHead = 0;
-                        RxSeqNum    newOooTail = 0;
-
-                        //-- DEFAULT : No OOO and Rx segment is in expected sequence order
-                        if (!rxSar.ooo and (fsm_Meta.meta.seqNumb == rxSar.rcvd) and
-                                           (fsm_freeSpace > fsm_Meta.meta.length)) {
-                            if (DEBUG_LEVEL & TRACE_FSM) { printInfo(myName, "OOO-DEFAULT : Rx segment is in-order.\n"); }
-                            // Generate new received pointer
-                            newRcvd = fsm_Meta.meta.seqNumb + fsm_Meta.meta.length;
-                            // Update RxSar pointers
-                            soRSt_RxSarQry.write(RXeRxSarQuery(fsm_Meta.sessionId, newRcvd, QUERY_WR));
+                        RxOooCnt    newOooCnt  = 0;
+                        RxOooBlock  newOooBlk[TOE_OOO_BLOCKS];
+                        #pragma HLS ARRAY_PARTITION variable=newOooBlk complete dim=1
+
+                        RXeRxSarQuery rxSarQry;
+                        FlagBool      ceMark = rxSar.ecnOk and fsm_Meta.meta.ce;
+
+                        OooInsertSts oooSts = rxOooInsert(rxSar, fsm_Meta.meta.seqNumb, fsm_Meta.meta.length,
+                                                          newRcvd, newOooHead, newOooCnt, newOooBlk);
+                        if (fsm_poolLow and ((oooSts == OOO_IN_ORDER) or (oooSts == OOO_STORED))) {
+                            //-- No page left to store this segment
+                            oooSts = OOO_DROP_NO_SPACE;
+                        }
+
+                        //-- IN-ORDER : Rx segment advances 'rcvd' (possibly filling a gap)
+                        if (oooSts == OOO_IN_ORDER) {
+                            if (DEBUG_LEVEL & TRACE_FSM) { printInfo(myName, "OOO-IN-ORDER: Rx segment advances 'rcvd' by %d bytes.\n", (newRcvd - rxSar.rcvd).to_uint()); }
+                            // Update RxSar pointers, out-of-order blocks and CE state
+                            rxSarQry = RXeRxSarQuery(fsm_Meta.sessionId, newRcvd, newOooHead, newOooCnt, newOooBlk, QUERY_WR);
+                            rxSarQry.ce = ceMark;
+                            soRSt_RxSarQry.write(rxSarQry);
                             // Send memory write command
                             assessSize(myName, soMwr_WrCmd, "soMwr_WrCmd", cDepth_FsmToMwr_WrCmd);
                             soMwr_WrCmd.write(DmCmd(memSegAddr, fsm_Meta.meta.length));
                             // Send Rx data notify to [APP]
-                            soRan_RxNotif.write(TcpAppNotif(fsm_Meta.sessionId,  fsm_Meta.meta.length,
+                            soRan_RxNotif.write(TcpAppNotif(fsm_Meta.sessionId, (newRcvd - rxSar.rcvd),
                                                             fsm_Meta.ip4SrcAddr, fsm_Meta.tcpSrcPort,
                                                             fsm_Meta.tcpDstPort));
                             // Send keep command
                             soTsd_DropCmd.write(CMD_KEEP);
-                            fsm_oooDebugState = 2;
+                            // Delay the ACK only if there was and there is no out-of-order data
+                            //  and if the CE state did not change (RFC-8257)
+                            delayAck = (rxSar.oooCnt == 0) and (newOooCnt == 0) and (ceMark == rxSar.ceEcho);
+                            fsm_oooDebugState = (rxSar.oooCnt == 0) ? 2 : 6;
                         }
-                        //-- START   : No OOO but Rx segment arrived out-of-order
-                        else if (!rxSar.ooo and (fsm_Meta.meta.seqNumb > rxSar.rcvd) and
-                                                (fsm_freeSpace > (fsm_Meta.meta.seqNumb+fsm_Meta.meta.length-rxSar.oooHead)(TOE_WINDOW_BITS-1, 0))) {
-                            if (DEBUG_LEVEL & TRACE_FSM) { printInfo(myName, "OOO-START   : Rx segment is out-of-order.\n"); }
-                            // Generate new oooHead and oooTail pointers
-                            newOooHead = fsm_Meta.meta.seqNumb + fsm_Meta.meta.length;
-                            newOooTail = fsm_Meta.meta.seqNumb;
-                            // Update RxSar pointers
-                            soRSt_RxSarQry.write(RXeRxSarQuery(fsm_Meta.sessionId, rxSar.rcvd, FLAG_OOO, newOooHead, newOooTail, QUERY_WR));
+                        //-- STORED   : Rx segment lands in a hole beyond 'rcvd'
+                        else if (oooSts == OOO_STORED) {
+                            if (DEBUG_LEVEL & TRACE_FSM) { printInfo(myName, "OOO-STORED  : Rx segment is out-of-order (%d blocks).\n", newOooCnt.to_uint()); }
+                            // Update RxSar out-of-order blocks and CE state
+                            rxSarQry = RXeRxSarQuery(fsm_Meta.sessionId, rxSar.rcvd, newOooHead, newOooCnt, newOooBlk, QUERY_WR);
+                            rxSarQry.ce = ceMark;
+                            soRSt_RxSarQry.write(rxSarQry);
                             // Send memory write command
+                            assessSize(myName, soMwr_WrCmd, "soMwr_WrCmd", cDepth_FsmToMwr_WrCmd);
                             soMwr_WrCmd.write(DmCmd(memSegAddr, fsm_Meta.meta.length));
                             // Prevent [Ran] to send Rx data notify to [APP] by setting LENGTH=0 !!!
                             soRan_RxNotif.write(TcpAppNotif(fsm_Meta.sessionId,  0,
@@ -1561,81 +2096,22 @@ void pFiniteStateMachine(
                             soTsd_DropCmd.write(CMD_KEEP);
                             fsm_oooDebugState = 3;
                         }
-                        //-- CONTINUE: OOO exists and Rx segment is in-order with respect to 'oooHead' pointer
-                        else if (rxSar.ooo and (fsm_Meta.meta.seqNumb == rxSar.oooHead) and
-                                               (fsm_freeSpace > fsm_Meta.meta.length)) {
-                            if (DEBUG_LEVEL & TRACE_FSM) { printInfo(myName, "OOO-CONTINUE: Rx segment is in-order with respect to 'oooHead'.\n"); }
-                            // Generate new oooHead pointer
-                            newOooHead = fsm_Meta.meta.seqNumb + fsm_Meta.meta.length;
-                            // Update RxSar pointers
-                            soRSt_RxSarQry.write(RXeRxSarQuery(fsm_Meta.sessionId, rxSar.rcvd, FLAG_OOO, newOooHead, rxSar.oooTail, QUERY_WR));
-                            // Send memory write command
-                            soMwr_WrCmd.write(DmCmd(memSegAddr, fsm_Meta.meta.length));
-                            // Prevent [Ran] to send Rx data notify to [APP] by setting LENGTH=0 !!!
-                            soRan_RxNotif.write(TcpAppNotif(fsm_Meta.sessionId,  0,
-                                                            fsm_Meta.ip4SrcAddr, fsm_Meta.tcpSrcPort,
-                                                            fsm_Meta.tcpDstPort));
-                            // Send keep command
-                            soTsd_DropCmd.write(CMD_KEEP);
-                            fsm_oooDebugState = 4;
-                        }
-                        //-- CONTINUE: OOO exists, Rx segment is in-order with respect to 'rcvd' pointer but it does not fill the gap
-                        else if (rxSar.ooo and (fsm_Meta.meta.seqNumb == rxSar.rcvd) and
-                                               ((fsm_Meta.meta.seqNumb + fsm_Meta.meta.length) < rxSar.oooTail)) {
-                            if (DEBUG_LEVEL & TRACE_FSM) { printInfo(myName, "OOO-CONTINUE: Rx segment is in-order with respect to 'rcvd' but it does not fill the gap.\n"); }
-                            // Generate new received pointer
-                            newRcvd = fsm_Meta.meta.seqNumb + fsm_Meta.meta.length;
-                            // Update RxSar pointers
-                            soRSt_RxSarQry.write(RXeRxSarQuery(fsm_Meta.sessionId, newRcvd, FLAG_OOO, rxSar.oooHead, rxSar.oooTail, QUERY_WR));
-                            // Send memory write command
-                            soMwr_WrCmd.write(DmCmd(memSegAddr, fsm_Meta.meta.length));
-                            // Send Rx data notify to [APP]
-                            soRan_RxNotif.write(TcpAppNotif(fsm_Meta.sessionId, fsm_Meta.meta.length,
-                                                            fsm_Meta.ip4SrcAddr, fsm_Meta.tcpSrcPort,
-                                                            fsm_Meta.tcpDstPort));
-                            // Send keep command
-                            soTsd_DropCmd.write(CMD_KEEP);
-                            fsm_oooDebugState = 5;
-                        }
-                        //-- END       : OOO exists, Rx segment is in-order with respect to 'rcvd' pointer and it fills the gap
-                        else if (rxSar.ooo and (fsm_Meta.meta.seqNumb == rxSar.rcvd) and
-                                               ((fsm_Meta.meta.seqNumb + fsm_Meta.meta.length) == rxSar.oooTail)) {
-                            if (DEBUG_LEVEL & TRACE_FSM) { printInfo(myName, "OOO-END     : Rx segment is in-order with respect to 'rcvd' and it fills the gap.\n"); }
-                            // Generate new received pointer
-                            newRcvd = rxSar.oooHead;
-                            // Update RxSar pointers
-                            soRSt_RxSarQry.write(RXeRxSarQuery(fsm_Meta.sessionId, newRcvd, FLAG_INO, rxSar.oooHead, rxSar.oooTail, QUERY_WR));
-                            // Send memory write command
-                            soMwr_WrCmd.write(DmCmd(memSegAddr, fsm_Meta.meta.length));
-                            // Send Rx data notify to [APP]
-                            soRan_RxNotif.write(TcpAppNotif(fsm_Meta.sessionId, (rxSar.oooHead - rxSar.rcvd),
-                                                            fsm_Meta.ip4SrcAddr, fsm_Meta.tcpSrcPort,
-                                                            fsm_Meta.tcpDstPort));
-                            // Send keep command
-                            soTsd_DropCmd.write(CMD_KEEP);
-                            fsm_oooDebugState = 6;
-                        }
-                        //-- OOO-DROP  : Always drop segment in all other cases
+                        //-- OOO-DROP  : Drop segment in all other cases
                         else {
                             soTsd_DropCmd.write(CMD_DROP);
                             fsm_oooDropCounter++;
                             fsm_oooDebugState = 10;
-                            if ( (fsm_Meta.meta.seqNumb < rxSar.rcvd)) {
+                            if (oooSts == OOO_DROP_OLD) {
                                 printInfo(myName, "OOO-Dropping Rx segment (Frame is a retransmission because of a lost or delayed ACK). \n");
                                 fsm_oooDebugState = 11;
                             }
-                            else if ( (!rxSar.ooo and (fsm_Meta.meta.seqNumb == rxSar.rcvd) and (fsm_freeSpace <  fsm_Meta.meta.length)) or
-                                      (!rxSar.ooo and (fsm_Meta.meta.seqNumb >  rxSar.rcvd) and (fsm_freeSpace > (fsm_Meta.meta.seqNumb+fsm_Meta.meta.length-rxSar.rcvd)(TOE_WINDOW_BITS-1, 0))) ) {
+                            else if (oooSts == OOO_DROP_NO_SPACE) {
                                 printInfo(myName, "OOO-Dropping Rx segment (Not enough space left in the Rx ring buffer).\n");
                                 fsm_oooDebugState = 12;
                             }
-                            else if (fsm_Meta.meta.seqNumb+fsm_Meta.meta.length == rxSar.rcvd) {
-                                printInfo(myName, "OOO-Dropping Rx segment (Segment is a duplicate).\n");
-                                fsm_oooDebugState = 13;
-                            }
                             else {
-                                printFatal(myName, "OOO-Dropping Rx segment (Reason is unknown).\n");
-                                fsm_oooDebugState = 14;
+                                printInfo(myName, "OOO-Dropping Rx segment (No out-of-order block left).\n");
+                                fsm_oooDebugState = 13;
                             }
                         }
                     }
@@ -1649,13 +2125,13 @@ void pFiniteStateMachine(
 #else
                     if (fsm_Meta.meta.length != 0) {
 #endif
-                        if (!rxSar.ooo and (fsm_Meta.meta.seqNumb == rxSar.rcvd) and
-                                           (fsm_freeSpace > fsm_Meta.meta.length)) {
+                        if (delayAck and !fsm_Meta.meta.psh) {
                             // No OOO and Rx segment is in expected sequence order
-                            soEVe_Event.write(Event(ACK_EVENT, fsm_Meta.sessionId));
+                            //  (the length lets [AKd] count the full-sized segments)
+                            soEVe_Event.write(Event(ACK_EVENT, fsm_Meta.sessionId, 0, fsm_Meta.meta.length));
                         }
                         else {
-                            // TCP retransmission frame
+                            // Out-of-order, gap filling, retransmitted or PSH segment
                             soEVe_Event.write(Event(ACK_NODELAY_EVENT, fsm_Meta.sessionId));
                             fsm_oooDebugState += 100;
                         }
@@ -1706,16 +2182,34 @@ void pFiniteStateMachine(
                 siSTt_StateRep.read(tcpState);
                 siRSt_RxSarRep.read(rxSar);
                 if (tcpState == CLOSED or tcpState == SYN_SENT) {
-                    // Initialize RxSar with received SeqNum
+                    // Initialize RxSar with received SeqNum, SACK-Permitted and Window Scale options
+                    //  An ECN-setup SYN carries both ECE and CWR (RFC-3168)
                     soRSt_RxSarQry.write(RXeRxSarQuery(fsm_Meta.sessionId, fsm_Meta.meta.seqNumb+1,
-                                                       QUERY_WR, QUERY_INIT));
+                                                       QUERY_WR, QUERY_INIT, fsm_Meta.meta.sackOk,
+                                                       fsm_Meta.meta.winScaleOk,
+                                                       fsm_Meta.meta.winScaleOk ? fsm_Meta.meta.winScale : (TcpWinScale)0,
+                                                       TOE_ECN and fsm_Meta.meta.ece and fsm_Meta.meta.cwr));
                     // Initialize TxSar with received WindowSize
                     //  All other parameters are zero or false; they will be initialized by [TXe]
-                    soTSt_TxSarQry.write((RXeTxSarQuery(fsm_Meta.sessionId, 0, fsm_Meta.meta.winSize,
-                                                        0, 0, false)));
-                    // Post a SYN_ACK event request
-                    soEVe_Event.write(Event(SYN_ACK_EVENT, fsm_Meta.sessionId));
-                    if (DEBUG_LEVEL & TRACE_FSM) printInfo(myName, "Requesting [TXe] to send a [SYN,ACK] for SessId %d.\n", fsm_Meta.sessionId.to_uint());
+                    //  The congestion state is initialized by [CCo]
+                    RXeTxSarQuery txSarQry(fsm_Meta.sessionId, 0, fsm_Meta.meta.winSize, 0, 0, false);
+                    txSarQry.ccEvent = CC_INIT;
+                    if (fsm_Meta.cookie) {
+                        // The [SYN,ACK] was already sent with a SYN cookie. Initialize
+                        //  the TxSar with it, ahead of the queries of the ACK itself.
+                        txSarQry.ackd = fsm_Meta.meta.ackNumb;
+                        txSarQry.init = true;
+                    }
+                    soTSt_TxSarQry.write(txSarQry);
+                    if (fsm_Meta.cookie) {
+                        // Tell [TXe] that this socket pair now has a session
+                        soEVe_Event.write(SynCookieEvent(fsm_Meta.sessionId));
+                    }
+                    else {
+                        // Post a SYN_ACK event request
+                        soEVe_Event.write(Event(SYN_ACK_EVENT, fsm_Meta.sessionId));
+                        if (DEBUG_LEVEL & TRACE_FSM) printInfo(myName, "Requesting [TXe] to send a [SYN,ACK] for SessId %d.\n", fsm_Meta.sessionId.to_uint());
+                    }
                     // Change TcpState to SYN_RECEIVED
                     soSTt_StateQry.write(StateQuery(fsm_Meta.sessionId, SYN_RECEIVED, QUERY_WR));
                 }
@@ -1754,14 +2248,21 @@ void pFiniteStateMachine(
                 TimerCmd timerCmd = (fsm_Meta.meta.ackNumb == txSar.prevUnak) ? STOP_TIMER : LOAD_TIMER;
                 soTIm_ReTxTimerCmd.write(RXeReTransTimerCmd(fsm_Meta.sessionId, timerCmd));
                 if ( (tcpState == SYN_SENT) and (fsm_Meta.meta.ackNumb == txSar.prevUnak) ) { // && !mh_lup.created)
-                    // Initialize RxSar with received SeqNum
+                    // Initialize RxSar with received SeqNum, SACK-Permitted and Window Scale options
+                    //  An ECN-setup SYN-ACK carries ECE but not CWR (RFC-3168)
                     soRSt_RxSarQry.write(RXeRxSarQuery(fsm_Meta.sessionId, fsm_Meta.meta.seqNumb+1,
-                                                       QUERY_WR, QUERY_INIT));
+                                                       QUERY_WR, QUERY_INIT, fsm_Meta.meta.sackOk,
+                                                       fsm_Meta.meta.winScaleOk,
+                                                       fsm_Meta.meta.winScaleOk ? fsm_Meta.meta.winScale : (TcpWinScale)0,
+                                                       TOE_ECN and fsm_Meta.meta.ece and !fsm_Meta.meta.cwr));
                     // Update TxSar with received AckNum and WindowSize
-                    soTSt_TxSarQry.write(RXeTxSarQuery(fsm_Meta.sessionId,
-                                                       fsm_Meta.meta.ackNumb,
-                                                       fsm_Meta.meta.winSize,
-                                                       txSar.cong_window, 0, false)); // [TODO - maybe include count check]
+                    //  The congestion state is initialized by [CCo]
+                    RXeTxSarQuery txSarQry(fsm_Meta.sessionId,
+                                           fsm_Meta.meta.ackNumb,
+                                           fsm_Meta.meta.winSize,
+                                           txSar.cong_window, 0, false); // [TODO - maybe include count check]
+                    txSarQry.ccEvent = CC_INIT;
+                    soTSt_TxSarQry.write(txSarQry);
                     // Set ACK event
                     soEVe_Event.write(Event(ACK_NODELAY_EVENT, fsm_Meta.sessionId));
                     soSTt_StateQry.write(StateQuery(fsm_Meta.sessionId, ESTABLISHED, QUERY_WR));
@@ -1795,20 +2296,23 @@ void pFiniteStateMachine(
                 // Check state and if FIN in order, Current out of order FINs are not accepted
                 if ( (tcpState == ESTABLISHED or  tcpState == FIN_WAIT_1 or tcpState == FIN_WAIT_2) and (rxSar.rcvd == fsm_Meta.meta.seqNumb) ) {
                     soTSt_TxSarQry.write((RXeTxSarQuery(fsm_Meta.sessionId,
-                                          fsm_Meta.meta.ackNumb, fsm_Meta.meta.winSize,
+                                          fsm_Meta.meta.ackNumb,
+                                          scaleUpWindow(fsm_Meta.meta.winSize, rxSar.sndWinScale),
                                           txSar.cong_window, txSar.count,
                                           ~QUERY_FAST_RETRANSMIT))); //TODO include count check
                     // +1 for phantom byte, there might be data too
-                    soRSt_RxSarQry.write(RXeRxSarQuery(fsm_Meta.sessionId, fsm_Meta.meta.seqNumb+fsm_Meta.meta.length+1,
-                                         QUERY_WR)); // diff to ACK
+                    RXeRxSarQuery rxSarQry(fsm_Meta.sessionId, fsm_Meta.meta.seqNumb+fsm_Meta.meta.length+1,
+                                           QUERY_WR); // diff to ACK
+                    rxSarQry.ce = rxSar.ecnOk and fsm_Meta.meta.ce;
+                    soRSt_RxSarQry.write(rxSarQry);
                     // Clear the probe timer
                     soTIm_ClearProbeTimer.write(fsm_Meta.sessionId);
                     // Check if there is payload
                     if (fsm_Meta.meta.length != 0) {
                         // Build a DDR memory address for this segment
                         RxMemPtr memSegAddr = TOE_RX_MEMORY_BASE;
-                        memSegAddr(29, 16) = fsm_Meta.sessionId(13, 0);
-                        memSegAddr(15,  0) = fsm_Meta.meta.seqNumb(15, 0);
+                        memSegAddr(29, TOE_WINDOW_BITS) = fsm_Meta.sessionId(TOE_SESS_ADDR_BITS-1, 0);
+                        memSegAddr(TOE_WINDOW_BITS-1, 0) = fsm_Meta.meta.seqNumb(TOE_WINDOW_BITS-1, 0);
 #if !(RX_DDR_BYPASS)
                         soMwr_WrCmd.write(DmCmd(memSegAddr, fsm_Meta.meta.length));
 #endif
@@ -1980,6 +2484,7 @@ void pEventMultiplexer(
  * @param[out] soEVe_SetEvent      Event forward to EventEngine (EVe).
  * @param[out] soTAi_SessOpnSts    Open status of the session to TxAppInterface (TAi).
  * @param[out] soRAi_RxNotif       Rx data notification to RxAppInterface (RAi).
+ * @param[in]  siPAl_PoolLow       The Rx pool of pages is running low from PageAllocator (PAl).
  * @param[out] soMEM_WrCmd         Memory write command to MemorySubSystem (MEM).
  * @param[out] soMEM_WrData        Memory data write stream to [MEM].
  * @param[in]  siMEM_WrSts         Memory write status from [MEM].
@@ -1987,6 +2492,7 @@ void pEventMultiplexer(
  * @param[out] soMMIO_CrcDropCnt   The value of the CRC drop counter.
  * @param[out] soMMIO_SessDropCnt  The value of the session drop counter.
  * @param[out] soMMIO_OooDropCnt   The value of the out-of-order drop counter.
+ * @param[in]  piMMIO_CookieKey    The secret key of the SYN cookies from [MMIO].
  *
  * @details
  *  The RxEngine (RXe) processes the TCP/IP packets received from the IpRxHandler
@@ -2025,6 +2531,8 @@ void rx_engine(
         stream<SessState>               &soTAi_SessOpnSts,
         //-- Rx Application Interface
         stream<TcpAppNotif>             &soRAi_RxNotif,
+        //-- Page Allocator Interface
+        stream<SigBit>                  &siPAl_PoolLow,
         //-- MEM / Rx Write Path Interface
         stream<DmCmd>                   &soMEM_WrCmd,
         stream<AxisApp>                 &soMEM_WrData,
@@ -2034,6 +2542,7 @@ void rx_engine(
         stream<ap_uint<8> >             &soMMIO_CrcDropCnt,
         stream<ap_uint<8> >             &soMMIO_SessDropCnt,
         stream<ap_uint<8> >             &soMMIO_OooDropCnt,
+        SynCookieKey                     piMMIO_CookieKey,
         //-- DEBUG Interfaces
         stream<RxBufPtr>                &soDBG_RxFreeSpace,
         stream<ap_uint<32> >            &soDBG_TcpIpRxByteCnt,
@@ -2055,6 +2564,9 @@ void rx_engine(
     static stream<TcpSegLen>        ssTleToIph_TcpSegLen    ("ssTleToIph_TcpSegLen");
     #pragma HLS stream     variable=ssTleToIph_TcpSegLen    depth=2
 
+    static stream<FlagBool>         ssTleToCsa_IpCe         ("ssTleToCsa_IpCe");
+    #pragma HLS stream     variable=ssTleToCsa_IpCe         depth=8
+
     //-- Insert Pseudo Header (Iph) -------------------------------------------
     static stream<AxisPsd4>         ssIphToCsa_PseudoPkt    ("ssIphToCsa_PseudoPkt");
     #pragma    HLS stream  variable=ssIphToCsa_PseudoPkt    depth=8
@@ -2068,13 +2580,26 @@ void rx_engine(
     static stream<ValBit>           ssCsaToTid_DataValid    ("ssCsaToTid_DataValid");
     #pragma HLS stream     variable=ssCsaToTid_DataValid    depth=2
 
-    static stream<RXeMeta>          ssCsaToMdh_Meta         ("ssCsaToMdh_Meta");
-    #pragma HLS stream     variable=ssCsaToMdh_Meta         depth=2
-    #pragma HLS DATA_PACK  variable=ssCsaToMdh_Meta
+    static stream<RXeMeta>          ssCsaToSch_Meta         ("ssCsaToSch_Meta");
+    #pragma HLS stream     variable=ssCsaToSch_Meta         depth=2
+    #pragma HLS DATA_PACK  variable=ssCsaToSch_Meta
+
+    static stream<SocketPair>       ssCsaToSch_SockPair     ("ssCsaToSch_SockPair");
+    #pragma HLS stream     variable=ssCsaToSch_SockPair     depth=2
+    #pragma HLS DATA_PACK  variable=ssCsaToSch_SockPair
+
+    //-- SYN Cookie Hasher (Sch) ----------------------------------------------
+    static stream<RXeMeta>          ssSchToMdh_Meta         ("ssSchToMdh_Meta");
+    #pragma HLS stream     variable=ssSchToMdh_Meta         depth=2
+    #pragma HLS DATA_PACK  variable=ssSchToMdh_Meta
 
-    static stream<SocketPair>       ssCsaToMdh_SockPair     ("ssCsaToMdh_SockPair");
-    #pragma HLS stream     variable=ssCsaToMdh_SockPair     depth=2
-    #pragma HLS DATA_PACK  variable=ssCsaToMdh_SockPair
+    static stream<SocketPair>       ssSchToMdh_SockPair     ("ssSchToMdh_SockPair");
+    #pragma HLS stream     variable=ssSchToMdh_SockPair     depth=2
+    #pragma HLS DATA_PACK  variable=ssSchToMdh_SockPair
+
+    static stream<RXeCookie>        ssSchToMdh_Cookie       ("ssSchToMdh_Cookie");
+    #pragma HLS stream     variable=ssSchToMdh_Cookie       depth=2
+    #pragma HLS DATA_PACK  variable=ssSchToMdh_Cookie
 
     //-- Tcp Invalid dropper (Tid) --------------------------------------------
     static stream<AxisApp>          ssTidToTsd_Data         ("ssTidToTsd_Data");
@@ -2125,7 +2650,8 @@ void rx_engine(
     pTcpLengthExtractor(
             siIPRX_Data,
             ssTleToIph_Data,
-            ssTleToIph_TcpSegLen);
+            ssTleToIph_TcpSegLen,
+            ssTleToCsa_IpCe);
 
 
     pInsertPseudoHeader(
@@ -2135,10 +2661,11 @@ void rx_engine(
 
     pCheckSumAccumulator(
             ssIphToCsa_PseudoPkt,
+            ssTleToCsa_IpCe,
             ssCsaToTid_Data,
             ssCsaToTid_DataValid,
-            ssCsaToMdh_Meta,
-            ssCsaToMdh_SockPair,
+            ssCsaToSch_Meta,
+            ssCsaToSch_SockPair,
             soPRt_PortStateReq);
 
     pTcpInvalidDropper(
@@ -2147,9 +2674,18 @@ void rx_engine(
             ssTidToTsd_Data,
             soMMIO_CrcDropCnt);
 
+    pSynCookieHasher(
+            ssCsaToSch_Meta,
+            ssCsaToSch_SockPair,
+            piMMIO_CookieKey,
+            ssSchToMdh_Meta,
+            ssSchToMdh_SockPair,
+            ssSchToMdh_Cookie);
+
     pMetaDataHandler(
-            ssCsaToMdh_Meta,
-            ssCsaToMdh_SockPair,
+            ssSchToMdh_Meta,
+            ssSchToMdh_SockPair,
+            ssSchToMdh_Cookie,
             soSLc_SessLkReq,
             siSLc_SessLkRep,
             siPRt_PortStateRep,
@@ -2174,6 +2710,7 @@ void rx_engine(
             ssFsmToTsd_DropCmd,
             ssFsmToMwr_WrCmd,
             ssFsmToRan_Notif,
+            siPAl_PoolLow,
             soMMIO_OooDropCnt,
             soDBG_RxFreeSpace,
             soDBG_TcpIpRxByteCnt,
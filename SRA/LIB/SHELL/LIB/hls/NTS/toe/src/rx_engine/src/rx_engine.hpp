@@ -60,6 +60,7 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "../../../../../NTS/nts_utils.hpp"
 #include "../../../../../NTS/SimNtsUtils.hpp"
 #include "../../../../../NTS/toe/src/toe.hpp"
+#include "../../../../../NTS/toe/src/toe_utils.hpp"
 #include "../../../../../NTS/AxisIp4.hpp"
 #include "../../../../../NTS/AxisTcp.hpp"
 #include "../../../../../NTS/AxisPsd4.hpp"
@@ -79,9 +80,35 @@ class RXeMeta {
     TcpCtrlBit  rst;
     TcpCtrlBit  syn;
     TcpCtrlBit  fin;
+    TcpCtrlBit  psh;        // Push (acknowledged without delay)
+    TcpCtrlBit  ece;        // ECN-Echo (RFC-3168)
+    TcpCtrlBit  cwr;        // Congestion Window Reduced (RFC-3168)
+    FlagBool    ce;         // The IP packet was marked with Congestion Experienced
+    FlagBool    sackOk;     // The SACK-Permitted option is present
+    SackCnt     sackCnt;    // Number of SACK blocks in the SACK option
+    SackBlock   sackBlk[TOE_SACK_BLOCKS];
+    FlagBool    winScaleOk; // The Window Scale option is present
+    TcpWinScale winScale;   // The shift count of the Window Scale option
     RXeMeta() {}
 };
 
+/********************************************
+ * RXe - SYN Cookie Interface
+ ********************************************/
+class RXeCookie {
+  public:
+    TcpSeqNum   cookie;     // The cookie issued to a SYN (or returned by an ACK)
+    FlagBool    valid;      // The ACK returns a valid cookie
+    RXeCookie() {}
+    RXeCookie(TcpSeqNum cookie, FlagBool valid) :
+              cookie(cookie), valid(valid) {}
+};
+
+/********************************************
+ * RXe - TCP Option Parser State
+ ********************************************/
+enum OptParserState { OPT_KIND=0, OPT_LEN, OPT_DATA, OPT_END };
+
 /********************************************
  * RXe - FsmMetaData Interface
  ********************************************/
@@ -92,11 +119,68 @@ class RXeFsmMeta {
     TcpSrcPort          tcpSrcPort;
     TcpDstPort          tcpDstPort;
     RXeMeta             meta;
-    RXeFsmMeta() {}
+    FlagBool            cookie;  // The SYN was rebuilt from a SYN cookie
+    RXeFsmMeta() : cookie(false) {}
     RXeFsmMeta(SessionId sessId,  Ip4SrcAddr ipSA,  TcpSrcPort tcpSP,  TcpDstPort tcpDP,  RXeMeta rxeMeta) :
-               sessionId(sessId), ip4SrcAddr(ipSA), tcpSrcPort(tcpSP), tcpDstPort(tcpDP),    meta(rxeMeta) {}
+               sessionId(sessId), ip4SrcAddr(ipSA), tcpSrcPort(tcpSP), tcpDstPort(tcpDP),    meta(rxeMeta),
+               cookie(false) {}
 };
 
+/********************************************
+ * RXe - Out-Of-Order Insertion Status
+ ********************************************/
+enum OooInsertSts { OOO_IN_ORDER=0,     // Segment advanced 'rcvd'
+                    OOO_STORED,         // Segment was stored out-of-order
+                    OOO_DROP_OLD,       // Segment starts before 'rcvd'
+                    OOO_DROP_NO_SPACE,  // Segment ends beyond the Rx buffer
+                    OOO_DROP_NO_BLOCK   // No out-of-order block left
+                  };
+
+OooInsertSts rxOooInsert(
+        RxSarReply     &rxSar,
+        RxSeqNum        segSeq,
+        TcpSegLen       segLen,
+        RxSeqNum       &newRcvd,
+        RxSeqNum       &newOooHead,
+        RxOooCnt       &newOooCnt,
+        RxOooBlock      newOooBlk[TOE_OOO_BLOCKS]);
+
+/********************************************
+ * RXe - Memory Writer (also used by the TB)
+ ********************************************/
+void pRxMemoryWriter(
+        stream<AxisApp>     &siTsd_Data,
+        stream<DmCmd>       &siFsm_MemWrCmd,
+        stream<DmCmd>       &soMEM_WrCmd,
+        stream<AxisApp>     &soMEM_WrData,
+        stream<FlagBool>    &soRan_SplitSeg);
+
+/********************************************
+ * RXe - SYN Cookie Hasher (also used by the TB)
+ ********************************************/
+void pSynCookieHasher(
+        stream<RXeMeta>             &siCsa_Meta,
+        stream<SocketPair>          &siCsa_SockPair,
+        SynCookieKey                 piMMIO_CookieKey,
+        stream<RXeMeta>             &soMdh_Meta,
+        stream<SocketPair>          &soMdh_SockPair,
+        stream<RXeCookie>           &soMdh_Cookie);
+
+/********************************************
+ * RXe - MetaData Handler (also used by the TB)
+ ********************************************/
+void pMetaDataHandler(
+        stream<RXeMeta>             &siSch_Meta,
+        stream<SocketPair>          &siSch_SockPair,
+        stream<RXeCookie>           &siSch_Cookie,
+        stream<SessionLookupQuery>  &soSLc_SessLkpReq,
+        stream<SessionLookupReply>  &siSLc_SessLkpRep,
+        stream<StsBit>              &siPRt_PortSts,
+        stream<ExtendedEvent>       &soEVe_Event,
+        stream<CmdBit>              &soTsd_DropCmd,
+        stream<RXeFsmMeta>          &soFsm_Meta,
+        stream<ap_uint<8> >         &soMMIO_SessDropCnt);
+
 /*******************************************************************************
  * CONSTANTS FOR THE INTERNAL STREAM DEPTHS
  *******************************************************************************/
@@ -143,6 +227,8 @@ void rx_engine(
         stream<SessState>               &soTAi_SessOpnSts,
         //-- Rx Application Interface
         stream<TcpAppNotif>             &soRAi_RxNotif,
+        //-- Page Allocator Interface
+        stream<SigBit>                  &siPAl_PoolLow,
         //-- MEM / Rx Write Path Interface
         stream<DmCmd>                   &soMEM_WrCmd,
         stream<AxisApp>                 &soMEM_WrData,
@@ -152,12 +238,18 @@ void rx_engine(
         stream<ap_uint<8> >             &soMMIO_CrcDropCnt,
         stream<ap_uint<8> >             &soMMIO_SessDropCnt,
         stream<ap_uint<8> >             &soMMIO_OooDropCnt,
+        SynCookieKey                     piMMIO_CookieKey,
         //-- DEBUG Interfaces
         stream<RxBufPtr>                &soDBG_RxFreeSpace,
         stream<ap_uint<32> >            &soDBG_TcpIpRxByteCnt,
         stream<ap_uint<8> >             &soDBG_oooDebug
 );
 
+#ifndef __SYNTHESIS__
+  void getSynCookieStats(unsigned int &nrSent, unsigned int &nrAccepted,
+                         unsigned int &nrRejected);
+#endif
+
 #endif
 
 /*! \} */
@@ -73,6 +73,29 @@ using namespace hls;
 
 #define DEBUG_LEVEL (TRACE_OFF)
 
+/*******************************************************************************
+ * @brief Build a reply from an entry of the Rx SAR table.
+ *
+ * @param[in]  entry  A reference to the entry of the table.
+ *
+ * @return the reply.
+ *******************************************************************************/
+RxSarReply buildRxSarReply(RxSarEntry &entry)
+{
+    #pragma HLS INLINE
+
+    RxSarReply reply(entry.appd, entry.rcvd, entry.oooHead, entry.oooCnt, entry.sackOk);
+    reply.winScaleOk  = entry.winScaleOk;
+    reply.sndWinScale = entry.sndWinScale;
+    reply.ecnOk       = entry.ecnOk;
+    reply.ceEcho      = entry.ceEcho;
+    for (int i=0; i<TOE_OOO_BLOCKS; ++i) {
+    #pragma HLS UNROLL
+        reply.oooBlk[i] = entry.oooBlk[i];
+    }
+    return reply;
+}
+
 /*******************************************************************************
  * @brief Rx SAR Table (RSt)
  *
@@ -92,12 +115,8 @@ using namespace hls;
  *   - 'appd' holds a pointer to the next byte ready to be read (.i.e, consumed)
  *            by the application layer.
  *
- *            appd        rcvd           oooTail             oooHead
- *             |           |               |                   |
- *            \|/         \|/             \|/                 \|/
- *     --+---+---+---+---+---+---+---+---+---+---+---+---+---+---+---+---+--
- *       |269|270|271|272|273|274|275|276|277|278|279|280|281|282|283|284|
- *     --+---+---+---+---+---+---+---+---+---+---+---+---+---+---+---+---+--
+ *  On top of these, up to TOE_OOO_BLOCKS blocks of out-of-order bytes are
+ *   stored per session (see RxSarEntry).
  *
  *  This process is concurrently accessed by the RxEngine (RXe), the TxEngine
  *   (TXe) and the RxApplicationInterface (RAi), but TXe access is read-only.
@@ -118,6 +137,7 @@ void rx_sar_table(
     //-- STATIC ARRAYS ---------------------------------------------------------
     static RxSarEntry               RX_SAR_TABLE[TOE_MAX_SESSIONS];
     #pragma HLS RESOURCE   variable=RX_SAR_TABLE core=RAM_2P
+    #pragma HLS DATA_PACK  variable=RX_SAR_TABLE
     #pragma HLS DEPENDENCE variable=RX_SAR_TABLE inter false
 
     if(!siTXe_RxSarReq.empty()) {
@@ -126,11 +146,7 @@ void rx_sar_table(
         // [TXe] - Read only access
         //---------------------------------------
         siTXe_RxSarReq.read(sessId);
-        soTxe_RxSarRep.write(RxSarReply(RX_SAR_TABLE[sessId].appd,
-                                        RX_SAR_TABLE[sessId].rcvd,
-                                        RX_SAR_TABLE[sessId].ooo,
-                                        RX_SAR_TABLE[sessId].oooHead,
-                                        RX_SAR_TABLE[sessId].oooTail));
+        soTxe_RxSarRep.write(buildRxSarReply(RX_SAR_TABLE[sessId]));
         if (DEBUG_LEVEL & TRACE_RST) {
             RxBufPtr free_space = ((RX_SAR_TABLE[sessId].appd -
                           (RxBufPtr)RX_SAR_TABLE[sessId].oooHead(TOE_WINDOW_BITS-1, 0)) - 1);
@@ -173,16 +189,18 @@ void rx_sar_table(
             RX_SAR_TABLE[rxeQry.sessionID].rcvd = rxeQry.rcvd;
             if (rxeQry.init) {
                 RX_SAR_TABLE[rxeQry.sessionID].appd    = rxeQry.rcvd;
+                RX_SAR_TABLE[rxeQry.sessionID].sackOk  = rxeQry.sackOk;
+                RX_SAR_TABLE[rxeQry.sessionID].winScaleOk  = rxeQry.winScaleOk;
+                RX_SAR_TABLE[rxeQry.sessionID].sndWinScale = rxeQry.sndWinScale;
+                RX_SAR_TABLE[rxeQry.sessionID].ecnOk   = rxeQry.ecnOk;
             }
-            if (rxeQry.ooo) {
-                RX_SAR_TABLE[rxeQry.sessionID].ooo     = true;
-                RX_SAR_TABLE[rxeQry.sessionID].oooHead = rxeQry.oooHead;
-                RX_SAR_TABLE[rxeQry.sessionID].oooTail = rxeQry.oooTail;
-            }
-            else {
-                RX_SAR_TABLE[rxeQry.sessionID].ooo     = false;
-                RX_SAR_TABLE[rxeQry.sessionID].oooHead = rxeQry.rcvd;
-                RX_SAR_TABLE[rxeQry.sessionID].oooTail = rxeQry.rcvd;
+            //  The CE state always reflects the latest data segment (cleared upon init)
+            RX_SAR_TABLE[rxeQry.sessionID].ceEcho  = rxeQry.ce;
+            RX_SAR_TABLE[rxeQry.sessionID].oooHead = rxeQry.oooHead;
+            RX_SAR_TABLE[rxeQry.sessionID].oooCnt  = rxeQry.oooCnt;
+            for (int i=0; i<TOE_OOO_BLOCKS; ++i) {
+            #pragma HLS UNROLL
+                RX_SAR_TABLE[rxeQry.sessionID].oooBlk[i] = rxeQry.oooBlk[i];
             }
             if (DEBUG_LEVEL & TRACE_RST) {
                 RxBufPtr free_space = ((RX_SAR_TABLE[rxeQry.sessionID].appd -
@@ -193,11 +211,7 @@ void rx_sar_table(
         }
         else {
             // Read access from [RXe]
-            soRXe_RxSarRep.write(RxSarReply(RX_SAR_TABLE[rxeQry.sessionID].appd,
-                                            RX_SAR_TABLE[rxeQry.sessionID].rcvd,
-                                            RX_SAR_TABLE[rxeQry.sessionID].ooo,
-                                            RX_SAR_TABLE[rxeQry.sessionID].oooHead,
-                                            RX_SAR_TABLE[rxeQry.sessionID].oooTail));
+            soRXe_RxSarRep.write(buildRxSarReply(RX_SAR_TABLE[rxeQry.sessionID]));
             if (DEBUG_LEVEL & TRACE_RST) {
                 RxBufPtr free_space = ((RX_SAR_TABLE[rxeQry.sessionID].appd -
                               (RxBufPtr)RX_SAR_TABLE[rxeQry.sessionID].oooHead(TOE_WINDOW_BITS-1, 0)) - 1);
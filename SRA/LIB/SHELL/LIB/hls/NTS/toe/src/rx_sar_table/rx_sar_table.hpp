@@ -63,7 +63,7 @@ using namespace hls;
 /*******************************************************************************
  * Rx SAR Table (RSt)
  *  Structure to manage the received data stream in the TCP Rx buffer memory.
- *  Every session is allocated with a static Rx buffer of 64KB to store the
+ *  Every session is allocated with a static Rx buffer of 256KB to store the
  *  stream of bytes received from the network layer, until the application layer
  *  consumes (.i.e read) them out. The Rx buffer is managed as a circular buffer
  *  with an insertion and an extraction pointer.
@@ -71,22 +71,38 @@ using namespace hls;
  *            byte from the network layer,
  *   - 'appd' holds a pointer to the next byte ready to be read (.i.e, consumed)
  *            by the application layer.
+ *  Up to TOE_OOO_BLOCKS blocks of out-of-order bytes are tracked beyond 'rcvd'.
+ *   The blocks are sorted by increasing sequence numbers and never overlap nor
+ *   touch each other, and 'oooHead' holds the head of the last block (or
+ *   'rcvd' when there is no out-of-order block).
  *
- *               appd        rcvd           oooTail             oooHead
- *                |           |               |                   |
- *               \|/         \|/             \|/                 \|/
+ *               appd        rcvd   oooBlk[0]       oooBlk[1]  oooHead
+ *                |           |     tail  head      tail  head    |
+ *               \|/         \|/     \|/   \|/       \|/   \|/    \|/
  *        --+---+---+---+---+---+---+---+---+---+---+---+---+---+---+---+---+--
  *          |269|270|271|272|273|274|275|276|277|278|279|280|281|282|283|284|
  *        --+---+---+---+---+---+---+---+---+---+---+---+---+---+---+---+---+--
  *
+ *  When the remote peer permits SACK, these blocks are also advertised as SACK
+ *   blocks by the TxEngine.
+ *  When window scaling was negotiated (RFC-7323), the window advertised by the
+ *   remote peer is left-shifted by 'sndWinScale', while our own window is
+ *   right-shifted by TOE_WINDOW_SCALE.
+ *  When ECN was negotiated (RFC-3168), 'ceEcho' tells if the last data segment
+ *   was CE marked. It is echoed with ECE on every ACK sent by the TxEngine.
  *******************************************************************************/
 class RxSarEntry {
   public:
     RxBufPtr    appd;    // Bytes READ (.i.e consumed) by the application
     RxSeqNum    rcvd;    // Bytes RCV'ed and ACK'ed (same as Receive Next)
-    FlagBool    ooo;     // A flag indicator for out-of-order segments
     RxSeqNum    oooHead; // Head of the out-of-order received bytes
-    RxSeqNum    oooTail; // Tail of the out-of-order received bytes
+    RxOooCnt    oooCnt;  // Number of valid out-of-order blocks
+    RxOooBlock  oooBlk[TOE_OOO_BLOCKS]; // The out-of-order blocks
+    FlagBool    sackOk;  // The remote peer permits SACK (set upon SYN)
+    FlagBool    winScaleOk;  // Window scaling was negotiated (set upon SYN)
+    TcpWinScale sndWinScale; // The window scale shift count of the remote peer
+    FlagBool    ecnOk;   // ECN was negotiated (set upon SYN)
+    FlagBool    ceEcho;  // The last data segment was CE marked
     RxSarEntry() {}
 };
 
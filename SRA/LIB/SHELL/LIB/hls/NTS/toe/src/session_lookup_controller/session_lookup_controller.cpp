@@ -84,7 +84,15 @@ using namespace hls;
  * @param[out] soLrh_FreeList The free list of session IDs to LookupReplyHandler (Lrh).
  *
  * @details
- *  Implements the free list of session IDs as a FiFo stream.
+ *  Implements the free list of session IDs as a stack of recycled IDs backed
+ *   by a counter of the IDs that were never allocated since the last reset.
+ *   The fresh IDs are handed out first and in increasing order, which allows
+ *   the [ReverseLookupTable] to tell a valid entry from a stale one without
+ *   clearing its tables. After a reset, the process is therefore ready after
+ *   a single cycle, regardless of the number of sessions.
+ *  FYI - The ID pushed in the previous cycle is forwarded from a register,
+ *   because the BRAM of the stack cannot return it yet when it gets popped
+ *   right away.
  *******************************************************************************/
 void pSessionIdManager(
         stream<RtlSessId>    &siUrs_FreeId,
@@ -96,21 +104,53 @@ void pSessionIdManager(
 
     const char *myName  = concat3(THIS_NAME, "/", "Sim");
 
+    //-- STATIC ARRAYS ---------------------------------------------------------
+    static RtlSessId           FREE_ID_STACK[TOE_MAX_SESSIONS];
+    #pragma HLS RESOURCE  variable=FREE_ID_STACK core=RAM_T2P_BRAM
+    #pragma HLS DEPENDENCE variable=FREE_ID_STACK inter false
+
     //-- STATIC CONTROL VARIABLES (with RESET) ---------------------------------
-    static RtlSessId           sim_counter=0;
-    #pragma HLS reset variable=sim_counter
+    static ap_uint<TOE_SESS_IDX_BITS+1> sim_freshCnt=0;  // #IDs allocated since reset
+    #pragma HLS reset variable=sim_freshCnt
+    static ap_uint<TOE_SESS_IDX_BITS+1> sim_stackPtr=0;  // #IDs in the stack of recycled IDs
+    #pragma HLS reset variable=sim_stackPtr
+    static bool                         sim_pushed=false;  // An ID was pushed in the previous cycle
+    #pragma HLS reset variable=sim_pushed
 
-    if (sim_counter < TOE_MAX_SESSIONS) {
-        // Initialize the free list after a reset
-        soLrh_FreeList.write(sim_counter);
-        sim_counter++;
-    }
-    else if (!siUrs_FreeId.empty()) {
-        // Recycle the incoming session ID
+    //-- STATIC DATAFLOW VARIABLES ---------------------------------------------
+    static RtlSessId                    sim_pushedId;      // The ID pushed in the previous cycle
+
+    //-- DYNAMIC VARIABLES -----------------------------------------------------
+    bool                                pushed = false;
+
+    if (!siUrs_FreeId.empty()) {
+        // Push the incoming session ID onto the stack of recycled IDs
         RtlSessId rtlSessId;
         siUrs_FreeId.read(rtlSessId);
-        soLrh_FreeList.write(rtlSessId);
+        FREE_ID_STACK[sim_stackPtr] = rtlSessId;
+        sim_stackPtr++;
+        sim_pushedId = rtlSessId;
+        pushed = true;
     }
+    else if (!soLrh_FreeList.full()) {
+        if (sim_freshCnt < TOE_MAX_SESSIONS) {
+            // Hand out an ID that was never allocated since the last reset
+            soLrh_FreeList.write(sim_freshCnt);
+            sim_freshCnt++;
+        }
+        else if (sim_stackPtr > 0) {
+            // Recycle the most recently released session ID
+            sim_stackPtr--;
+            if (sim_pushed) {
+                // Bypass the BRAM that is still being written
+                soLrh_FreeList.write(sim_pushedId);
+            }
+            else {
+                soLrh_FreeList.write(FREE_ID_STACK[sim_stackPtr]);
+            }
+        }
+    }
+    sim_pushed = pushed;
 }
 
 /*******************************************************************************
@@ -330,6 +370,13 @@ void pUpdateReplyHandler(
  *   address indexed by the 'SessionId' of that 4-tuple. This table is used
  *   to retrieve the 4-tuple information corresponding to a SessionId upon
  *   request from [TXe].
+ *  The valid flag is stored along with the 4-tuple such that an entry is read
+ *   in a single access. The table is not cleared upon reset. Instead, an entry
+ *   is only considered valid if its session ID was inserted since the last
+ *   reset, which is the case for every ID below the high-water mark of the
+ *   inserted IDs because the [SessionIdManager] hands out the fresh IDs in
+ *   increasing order.
+ *  A reverse lookup from [TXe] is served in the same cycle as an insertion.
  *******************************************************************************/
 void pReverseLookupTable(
         stream<SLcReverseLkp>   &siLrh_ReverseLkpRsp,
@@ -346,55 +393,43 @@ void pReverseLookupTable(
     const char *myName  = concat3(THIS_NAME, "/", "Rlt");
 
     //-- STATIC ARRAYS --------------------------------------------------------
-    static SLcFourTuple             REVERSE_LOOKUP_TABLE[TOE_MAX_SESSIONS];
+    static SLcReverseEntry          REVERSE_LOOKUP_TABLE[TOE_MAX_SESSIONS];
     #pragma HLS RESOURCE   variable=REVERSE_LOOKUP_TABLE core=RAM_T2P_BRAM
     #pragma HLS DEPENDENCE variable=REVERSE_LOOKUP_TABLE inter false
-    static ValBool                  TUPLE_VALID_TABLE[TOE_MAX_SESSIONS];
-    #pragma HLS DEPENDENCE variable=TUPLE_VALID_TABLE inter false
 
     //-- STATIC CONTROL VARIABLES (with RESET) --------------------------------
-    static bool                rlt_isInit=false;
-    #pragma HLS reset variable=rlt_isInit
-    static RtlSessId           rlt_counter=0;
-    #pragma HLS reset variable=rlt_counter
-
-    if (!rlt_isInit) {
-        // The two tables must be cleared upon reset
-        TUPLE_VALID_TABLE[rlt_counter] = false;
-        if (rlt_counter < TOE_MAX_SESSIONS) {
-            rlt_counter++;
-        }
-        else {
-            rlt_isInit = true;
+    static ap_uint<TOE_SESS_IDX_BITS+1> rlt_highWater=0;  // All IDs below were inserted since reset
+    #pragma HLS reset variable=rlt_highWater
+
+    //-- DYNAMIC VARIABLES ----------------------------------------------------
+    bool isReleasing = false;
+
+    if (!siLrh_ReverseLkpRsp.empty()) {
+        // Update the TABLE
+        SLcReverseLkp insert = siLrh_ReverseLkpRsp.read();
+        REVERSE_LOOKUP_TABLE[insert.key] = SLcReverseEntry(insert.value, true);
+        if (insert.key >= rlt_highWater) {
+            rlt_highWater = insert.key + 1;
         }
     }
-    else {
-        // Normal operation
-        if (!siLrh_ReverseLkpRsp.empty()) {
-             // Update the two TABLEs
-            SLcReverseLkp insert = siLrh_ReverseLkpRsp.read();
-            REVERSE_LOOKUP_TABLE[insert.key] = insert.value;
-            TUPLE_VALID_TABLE[insert.key]    = true;
-        }
-        else if (!siSTt_SessReleaseCmd.empty()) {
-            // Release a session
-            SessionId sessionId = siSTt_SessReleaseCmd.read();
-            SLcFourTuple releaseTuple = REVERSE_LOOKUP_TABLE[sessionId];
-            if (TUPLE_VALID_TABLE[sessionId]) { // if valid
-                soPRt_ClosePortCmd.write(releaseTuple.myPort);
-                soUrs_SessDeleteReq.write(CamSessionUpdateRequest(releaseTuple, sessionId, DELETE, FROM_RXe));
-            }
-            TUPLE_VALID_TABLE[sessionId] = false;
-        }
-        else if (!siTXe_ReverseLkpReq.empty()) {
-            // Return 4-tuple corresponding to a given session Id
-            SessionId sessionId = siTXe_ReverseLkpReq.read();
-            soTXe_ReverseLkpRep.write(fourTuple(
-                    REVERSE_LOOKUP_TABLE[sessionId].myIp,
-                    REVERSE_LOOKUP_TABLE[sessionId].theirIp,
-                    REVERSE_LOOKUP_TABLE[sessionId].myPort,
-                    REVERSE_LOOKUP_TABLE[sessionId].theirPort));
+    else if (!siSTt_SessReleaseCmd.empty()) {
+        // Release a session
+        SessionId sessionId = siSTt_SessReleaseCmd.read();
+        SLcReverseEntry releaseEntry = REVERSE_LOOKUP_TABLE[sessionId];
+        if (releaseEntry.valid and (sessionId < rlt_highWater)) {
+            soPRt_ClosePortCmd.write(releaseEntry.tuple.myPort);
+            soUrs_SessDeleteReq.write(CamSessionUpdateRequest(releaseEntry.tuple, sessionId, DELETE, FROM_RXe));
         }
+        REVERSE_LOOKUP_TABLE[sessionId].valid = false;
+        isReleasing = true;
+    }
+    if (!isReleasing and !siTXe_ReverseLkpReq.empty()) {
+        // Return 4-tuple corresponding to a given session Id
+        SessionId sessionId = siTXe_ReverseLkpReq.read();
+        SLcFourTuple tuple = REVERSE_LOOKUP_TABLE[sessionId].tuple;
+        soTXe_ReverseLkpRep.write(fourTuple(
+                tuple.myIp,   tuple.theirIp,
+                tuple.myPort, tuple.theirPort));
     }
 }
 
@@ -453,7 +488,7 @@ void session_lookup_controller(
 
     // Session Id Manager (Sim) ------------------------------------------------
     static stream<RtlSessId>               ssSimToLrh_FreeList      ("ssSimToLrh_FreeList");
-    #pragma HLS stream            variable=ssSimToLrh_FreeList      depth=16384  // 0x4000 [FIXME - Can we replace 16384 with MAX_SESSIONS]
+    #pragma HLS stream            variable=ssSimToLrh_FreeList      depth=4
 
     // Lookup Reply Handler (Lrh) ----------------------------------------------
     static stream<RtlSessId>               ssUrsToSim_FreeId        ("ssUrsToSim_FreeId");
@@ -96,6 +96,18 @@ class SLcReverseLkp
         key(key), value(value) {}
 };
 
+//=========================================================
+//== SLc - An entry of the Reverse Lookup Table
+//=========================================================
+class SLcReverseEntry
+{
+  public:
+    SLcFourTuple        tuple;
+    ValBool             valid;
+    SLcReverseEntry() {}
+    SLcReverseEntry(SLcFourTuple tuple, ValBool valid) :
+        tuple(tuple), valid(valid) {}
+};
 
 /*******************************************************************************
  *
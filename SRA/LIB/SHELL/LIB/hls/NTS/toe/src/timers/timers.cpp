@@ -102,11 +102,243 @@ template<typename T> void pStreamMux(
         so.write(si2.read());
 }
 
+/*******************************************************************************
+ * @brief Returns the index of the wheel slot that must hold a deadline.
+ *
+ * @param[in]  deadline  The absolute expiration time of the timer (in ticks).
+ * @param[in]  now       The current time of the wheel (in ticks).
+ *
+ * @details
+ *  The level is selected by the most significant bits in which the deadline
+ *   and the current time differ. A deadline is hence always cascaded down to
+ *   a finer level before it expires.
+ *******************************************************************************/
+TimerHeadIdx tiwGetHeadIdx(
+        TimerTicks   deadline,
+        TimerTicks   now)
+{
+    #pragma HLS INLINE
+
+    if (deadline(TIW_TIME_BITS-1, TIW_L0_BITS).to_uint() == now(TIW_TIME_BITS-1, TIW_L0_BITS).to_uint()) {
+        return TimerHeadIdx(deadline(TIW_L0_BITS-1, 0).to_uint());
+    }
+    else if (deadline(TIW_TIME_BITS-1, TIW_L0_BITS+TIW_L1_BITS).to_uint() ==
+                  now(TIW_TIME_BITS-1, TIW_L0_BITS+TIW_L1_BITS).to_uint()) {
+        return TimerHeadIdx(TIW_L0_SIZE + deadline(TIW_L0_BITS+TIW_L1_BITS-1, TIW_L0_BITS).to_uint());
+    }
+    else {
+        return TimerHeadIdx(TIW_L0_SIZE + TIW_L1_SIZE + deadline(TIW_TIME_BITS-1, TIW_L0_BITS+TIW_L1_BITS).to_uint());
+    }
+}
+
+/*******************************************************************************
+ * @brief Timing Wheel (Tiw) process
+ *
+ * @param[in]  siTmr_Cmd  Arm/disarm command from the owning timer process.
+ * @param[out] soTmr_Exp  Expired session to the owning timer process.
+ *
+ * @details
+ *  This process implements a 3-level hierarchical timing wheel. A free-running
+ *   tick counter advances every TOE_TIMER_TICK_CYCLES clock cycles and the
+ *   wheel catches up with it one tick at a time. On every tick, the level-2
+ *   and level-1 slots that become current are cascaded down into the finer
+ *   levels, and the sessions held by the current level-0 slot are expired.
+ *  Every operation (arm, disarm, cascade or expire one session) takes a fixed
+ *   number of cycles. The cost of the timers is therefore independent of the
+ *   number of sessions, and a timer fires within one tick of its deadline as
+ *   long as the wheel keeps up with the tick counter.
+ *  The template parameter 'ID' gives every instance of the wheel its own set of
+ *   static tables.
+ *******************************************************************************/
+template<int ID> void pTimerWheel(
+        stream<TimerWheelCmd>   &siTmr_Cmd,
+        stream<TimerWheelExp>   &soTmr_Exp)
+{
+    //-- DIRECTIVES FOR THIS PROCESS -------------------------------------------
+    #pragma HLS PIPELINE II=1 enable_flush
+    #pragma HLS INLINE off
+
+    //-- STATIC ARRAYS ---------------------------------------------------------
+    static TimerLink                TIW_HEADS[TIW_NR_HEADS];
+    #pragma HLS RESOURCE   variable=TIW_HEADS core=RAM_T2P_BRAM
+    #pragma HLS RESET      variable=TIW_HEADS
+    static TimerLink                TIW_NEXT[TOE_MAX_SESSIONS];
+    #pragma HLS RESOURCE   variable=TIW_NEXT core=RAM_T2P_BRAM
+    static TimerLink                TIW_PREV[TOE_MAX_SESSIONS];
+    #pragma HLS RESOURCE   variable=TIW_PREV core=RAM_T2P_BRAM
+    static TimerWheelMeta           TIW_META[TOE_MAX_SESSIONS];
+    #pragma HLS RESOURCE   variable=TIW_META core=RAM_T2P_BRAM
+    #pragma HLS DATA_PACK  variable=TIW_META
+    #pragma HLS RESET      variable=TIW_META
+
+    //-- STATIC CONTROL VARIABLES (with RESET) ---------------------------------
+    static enum FsmStates { TIW_IDLE=0, TIW_WALK, TIW_UNLINK, TIW_PLACE } \
+                               tiw_fsmState=TIW_IDLE, tiw_retState=TIW_IDLE;
+    #pragma HLS RESET variable=tiw_fsmState
+    #pragma HLS RESET variable=tiw_retState
+    static ap_uint<32>         tiw_cycCnt=0;
+    #pragma HLS RESET variable=tiw_cycCnt
+    static TimerTicks          tiw_tickCnt=0;
+    #pragma HLS RESET variable=tiw_tickCnt
+    static TimerTicks          tiw_wheelTime=0;
+    #pragma HLS RESET variable=tiw_wheelTime
+
+    //-- STATIC DATAFLOW VARIABLES ---------------------------------------------
+    static TimerWheelCmd       tiw_cmd;
+    static SessionId           tiw_nodeId;
+    static TimerWheelMeta      tiw_nodeMeta;
+    static TimerLink           tiw_nodePrev;
+    static TimerLink           tiw_nodeNext;
+    static ap_uint<2>          tiw_walkLevel;
+    static TimerHeadIdx        tiw_walkHeadIdx;
+
+    //-- DYNAMIC VARIABLES -----------------------------------------------------
+    TimerTicks                 delay;
+    TimerLink                  head;
+
+    //-- Free-running tick counter
+    if (tiw_cycCnt == TOE_TIMER_TICK_CYCLES-1) {
+        tiw_cycCnt = 0;
+        tiw_tickCnt++;
+    }
+    else {
+        tiw_cycCnt++;
+    }
+
+    if (((tiw_fsmState == TIW_IDLE) or (tiw_fsmState == TIW_WALK)) and !siTmr_Cmd.empty()) {
+        //---------------------------------------------------------------------
+        // Commands take precedence over the walk of the current slot
+        //---------------------------------------------------------------------
+        siTmr_Cmd.read(tiw_cmd);
+        tiw_retState = tiw_fsmState;
+        tiw_nodeId   = tiw_cmd.sessionID;
+        tiw_nodeMeta = TIW_META[tiw_cmd.sessionID];
+        tiw_nodePrev = TIW_PREV[tiw_cmd.sessionID];
+        tiw_nodeNext = TIW_NEXT[tiw_cmd.sessionID];
+        if (tiw_nodeMeta.linked) {
+            tiw_fsmState = TIW_UNLINK;
+        }
+        else if (tiw_cmd.arm) {
+            delay = (tiw_cmd.delay == 0) ? TimerTicks(1) : tiw_cmd.delay;
+            if (delay > TIW_MAX_DELAY) {
+                delay = TIW_MAX_DELAY;
+            }
+            tiw_nodeMeta.deadline = tiw_wheelTime + delay;
+            tiw_nodeMeta.stamp    = tiw_cmd.stamp;
+            tiw_fsmState = TIW_PLACE;
+        }
+        // Else, disarming a timer which is not armed is a no-op
+    }
+    else {
+        switch (tiw_fsmState) {
+        case TIW_IDLE:
+            if (tiw_wheelTime != tiw_tickCnt) {
+                //-- Advance the wheel by one tick and select the coarsest
+                //-- level which becomes current at this tick
+                tiw_wheelTime++;
+                if (tiw_wheelTime(TIW_L0_BITS+TIW_L1_BITS-1, 0) == 0) {
+                    tiw_walkLevel   = 2;
+                    tiw_walkHeadIdx = TIW_L0_SIZE + TIW_L1_SIZE + tiw_wheelTime(TIW_TIME_BITS-1, TIW_L0_BITS+TIW_L1_BITS).to_uint();
+                }
+                else if (tiw_wheelTime(TIW_L0_BITS-1, 0) == 0) {
+                    tiw_walkLevel   = 1;
+                    tiw_walkHeadIdx = TIW_L0_SIZE + tiw_wheelTime(TIW_L0_BITS+TIW_L1_BITS-1, TIW_L0_BITS).to_uint();
+                }
+                else {
+                    tiw_walkLevel   = 0;
+                    tiw_walkHeadIdx = tiw_wheelTime(TIW_L0_BITS-1, 0).to_uint();
+                }
+                tiw_fsmState = TIW_WALK;
+            }
+            break;
+        case TIW_WALK:
+            head = TIW_HEADS[tiw_walkHeadIdx];
+            if (head == 0) {
+                //-- This slot is empty. Move down to the next level.
+                if (tiw_walkLevel == 2) {
+                    tiw_walkLevel   = 1;
+                    tiw_walkHeadIdx = TIW_L0_SIZE + tiw_wheelTime(TIW_L0_BITS+TIW_L1_BITS-1, TIW_L0_BITS).to_uint();
+                }
+                else if (tiw_walkLevel == 1) {
+                    tiw_walkLevel   = 0;
+                    tiw_walkHeadIdx = tiw_wheelTime(TIW_L0_BITS-1, 0).to_uint();
+                }
+                else {
+                    tiw_fsmState = TIW_IDLE;
+                }
+            }
+            else if ((tiw_walkLevel != 0) or !soTmr_Exp.full()) {
+                //-- Pop the head of the slot
+                tiw_nodeId   = head - 1;
+                tiw_nodeMeta = TIW_META[tiw_nodeId];
+                tiw_nodeNext = TIW_NEXT[tiw_nodeId];
+                TIW_HEADS[tiw_walkHeadIdx] = tiw_nodeNext;
+                if (tiw_nodeNext != 0) {
+                    TIW_PREV[tiw_nodeNext-1] = 0;
+                }
+                if (tiw_walkLevel == 0) {
+                    //-- The deadline of every session of a level-0 slot is now
+                    tiw_nodeMeta.linked = false;
+                    TIW_META[tiw_nodeId] = tiw_nodeMeta;
+                    soTmr_Exp.write(TimerWheelExp(tiw_nodeId, tiw_nodeMeta.stamp));
+                }
+                else {
+                    //-- Cascade this session down into a finer level
+                    tiw_retState = TIW_WALK;
+                    tiw_fsmState = TIW_PLACE;
+                }
+            }
+            break;
+        case TIW_UNLINK:
+            if (tiw_nodePrev == 0) {
+                TIW_HEADS[tiw_nodeMeta.head] = tiw_nodeNext;
+            }
+            else {
+                TIW_NEXT[tiw_nodePrev-1] = tiw_nodeNext;
+            }
+            if (tiw_nodeNext != 0) {
+                TIW_PREV[tiw_nodeNext-1] = tiw_nodePrev;
+            }
+            tiw_nodeMeta.linked = false;
+            if (tiw_cmd.arm) {
+                delay = (tiw_cmd.delay == 0) ? TimerTicks(1) : tiw_cmd.delay;
+                if (delay > TIW_MAX_DELAY) {
+                    delay = TIW_MAX_DELAY;
+                }
+                tiw_nodeMeta.deadline = tiw_wheelTime + delay;
+                tiw_nodeMeta.stamp    = tiw_cmd.stamp;
+                tiw_fsmState = TIW_PLACE;
+            }
+            else {
+                TIW_META[tiw_nodeId] = tiw_nodeMeta;
+                tiw_fsmState = tiw_retState;
+            }
+            break;
+        case TIW_PLACE:
+            //-- Push the session at the head of the slot of its deadline
+            tiw_nodeMeta.head   = tiwGetHeadIdx(tiw_nodeMeta.deadline, tiw_wheelTime);
+            tiw_nodeMeta.linked = true;
+            head = TIW_HEADS[tiw_nodeMeta.head];
+            TIW_NEXT[tiw_nodeId] = head;
+            TIW_PREV[tiw_nodeId] = 0;
+            if (head != 0) {
+                TIW_PREV[head-1] = tiw_nodeId + 1;
+            }
+            TIW_HEADS[tiw_nodeMeta.head] = tiw_nodeId + 1;
+            TIW_META[tiw_nodeId] = tiw_nodeMeta;
+            tiw_fsmState = tiw_retState;
+            break;
+        }
+    }
+}
+
 /*******************************************************************************
  * @brief ReTransmit Timer (Rtt) process
  *
  * @param[in]  siRXe_ReTxTimerCmd   Retransmit timer command from RxEngine (RXe).
  * @param[in]  siTXe_ReTxTimerCmd   Retransmit timer command from TxEngine (TXe).
+ * @param[out] soTiw_Cmd            Timer command to TimingWheel (Tiw).
+ * @param[in]  siTiw_Exp            Timer expiration from [Tiw].
  * @param[out] soEmx_Event          Event to EventMultiplexer (Emx).
  * @param[out] soSmx_SessCloseCmd   Close command to StateTableMux (Smx).
  * @param[out] soTAi_Notif          Notification to TxApplicationInterface (TAi).
@@ -118,23 +350,29 @@ template<typename T> void pStreamMux(
  *   and for retransmitting them. Instead of managing a retransmission timer per
  *   segment, the current implementation only keeps track of a single timer per
  *   session. Such a session timer is managed as follows:
- *    [START] The retransmit timer of a session is re-started with an initial
+ *    [START] The retransmit timer of a session is re-started with the current
  *     retransmission timeout value (RTO) whenever the timer is not active and a
- *     new segment is transmitted by [TXe]. The RTO value is set between 3 and
- *     24 seconds, depending on how often the session already timed-out in the
- *     recent past.
+ *     new segment is transmitted by [TXe]. The RTO is estimated by the Tx SAR
+ *     table (RFC-6298) and is forwarded by [TXe] along with its command. It is
+ *     doubled every time the session already timed-out in the recent past
+ *     (.i.e exponential backoff), up to TIME_MAX_RTO.
  *    [STOP] The retransmit timer of a session is stopped and deactivated
  *     whenever an ACK is received by [RXe] and its received AckNum equals to
  *     the previously transmitted bytes but not yet acknowledged.
- *    [LOAD] Otherwise, the retransmit timer of a session is loaded with a RTO
- *     value of 1 second.
+ *    [LOAD] Otherwise, the retransmit timer of a session is re-loaded with the
+ *     latest RTO received from [TXe].
  *    [TIMEOUT] Upon a time-out, an event is fired to [TXe].
  *  If a session times-out more than 4 times in a row, it is aborted. A release
  *   command is sent to the StateTable (STt) and the application is notified.
+ *  The timers themselves are kept by a timing wheel [Tiw]. This process only
+ *   keeps the state of the sessions and discards the expirations which were
+ *   overtaken by a more recent command (see 'stamp').
  *******************************************************************************/
 void pRetransmitTimer(
         stream<RXeReTransTimerCmd>       &siRXe_ReTxTimerCmd,
         stream<TXeReTransTimerCmd>       &siTXe_ReTxTimerCmd,
+        stream<TimerWheelCmd>            &soTiw_Cmd,
+        stream<TimerWheelExp>            &siTiw_Exp,
         stream<Event>                    &soEmx_Event,
         stream<SessionId>                &soSmx_SessCloseCmd,
         stream<SessState>                &soTAi_Notif,
@@ -152,159 +390,103 @@ void pRetransmitTimer(
     #pragma HLS DEPENDENCE variable=RETRANSMIT_TIMER_TABLE inter false
     #pragma HLS RESET      variable=RETRANSMIT_TIMER_TABLE
 
-    //-- STATIC CONTROL VARIABLES (with RESET) ---------------------------------
-    static bool                rtt_waitForWrite=false;
-    #pragma HLS RESET variable=rtt_waitForWrite
-    static SessionId           rtt_prevPosition=0;
-    #pragma HLS RESET variable=rtt_prevPosition
-    static SessionId           rtt_position=0;
-    #pragma HLS RESET variable=rtt_position
-
-    //-- STATIC DATAFLOW VARIABLES --------------------------------------------
-    static RXeReTransTimerCmd  rtt_rxeCmd;
-
     //-- DYNAMIC VARIABLES ----------------------------------------------------
     ReTxTimerEntry     currEntry;
+    RXeReTransTimerCmd rxeCmd;
     TXeReTransTimerCmd txeCmd;
-    ValBool            txeCmdVal;
-    SessionId          currID;
-
-    if (rtt_waitForWrite and (rtt_rxeCmd.sessionID != rtt_prevPosition)) {
-        //-------------------------------------------------------------
-        // Handle previously read command from [RXe] (i.e. RELOAD|STOP)
-        //-------------------------------------------------------------
-        if (rtt_rxeCmd.command == LOAD_TIMER) {
-            RETRANSMIT_TIMER_TABLE[rtt_rxeCmd.sessionID].time = TIME_1s;
+    TimerWheelExp      tiwExp;
+    ap_uint<32>        rto;
+
+    if (!siRXe_ReTxTimerCmd.empty()) {
+        //------------------------------------------------
+        // Handle command from [RXe] (i.e. RELOAD|STOP)
+        //   INFO: Rx path has priority over Tx path
+        //------------------------------------------------
+        siRXe_ReTxTimerCmd.read(rxeCmd);
+        currEntry = RETRANSMIT_TIMER_TABLE[rxeCmd.sessionID];
+        if (rxeCmd.command == LOAD_TIMER) {
+            if (currEntry.active) {
+                currEntry.stamp++;
+                soTiw_Cmd.write(TimerWheelCmd(rxeCmd.sessionID, currEntry.rto, currEntry.stamp));
+            }
             if (DEBUG_LEVEL & TRACE_RTT) {
-                 printInfo(myName, "Session #%d - Reloading RTO timer (value=%d i.e. %d clock cycles).\n",
-                           rtt_rxeCmd.sessionID.to_int(), RETRANSMIT_TIMER_TABLE[rtt_rxeCmd.sessionID].time.to_uint(),
-                                       TOE_MAX_SESSIONS * RETRANSMIT_TIMER_TABLE[rtt_rxeCmd.sessionID].time.to_uint());
-             }
+                printInfo(myName, "Session #%d - Reloading RTO timer (value=%d ticks).\n",
+                          rxeCmd.sessionID.to_int(), currEntry.rto.to_uint());
+            }
         }
         else {  //-- STOP the timer
-            RETRANSMIT_TIMER_TABLE[rtt_rxeCmd.sessionID].time   = 0;
-            RETRANSMIT_TIMER_TABLE[rtt_rxeCmd.sessionID].active = false;
+            if (currEntry.active) {
+                soTiw_Cmd.write(TimerWheelCmd(rxeCmd.sessionID));
+            }
+            currEntry.active = false;
             if (DEBUG_LEVEL & TRACE_RTT) {
-                 printInfo(myName, "Session #%d - Stopping  RTO timer.\n",
-                           rtt_rxeCmd.sessionID.to_int());
-             }
+                printInfo(myName, "Session #%d - Stopping  RTO timer.\n",
+                          rxeCmd.sessionID.to_int());
+            }
         }
-        RETRANSMIT_TIMER_TABLE[rtt_rxeCmd.sessionID].retries = 0;
-        rtt_waitForWrite = false;
+        currEntry.retries = 0;
+        RETRANSMIT_TIMER_TABLE[rxeCmd.sessionID] = currEntry;
     }
-    else if (!siRXe_ReTxTimerCmd.empty() and !rtt_waitForWrite) {
+    else if (!siTXe_ReTxTimerCmd.empty()) {
         //------------------------------------------------
-        // Read input command from [RXe]
-        //   INFO: Rx path has priority over Tx path
+        // Handle command from [TXe]
         //------------------------------------------------
-        siRXe_ReTxTimerCmd.read(rtt_rxeCmd);
-        rtt_waitForWrite = true;
-    }
-    else {
-        if (!siTXe_ReTxTimerCmd.empty()) {
-            //------------------------------------------------
-            // Read input command from [TXe]
-            //------------------------------------------------
-            txeCmd    = siTXe_ReTxTimerCmd.read();
-            txeCmdVal = true;
-            currID    = txeCmd.sessionID;
-            if ( (txeCmd.sessionID-3 <  rtt_position) and
-                 (rtt_position <= txeCmd.sessionID) ) {
-                rtt_position += 5;  // [FIXME - Why is this?]
-            }
-        }
-        else {
-            txeCmdVal = false;
-            currID = rtt_position;
-            // Increment position to be used in next loop
-            rtt_position++;
-            if (rtt_position >= TOE_MAX_SESSIONS) {
-                rtt_position = 0;
+        siTXe_ReTxTimerCmd.read(txeCmd);
+        currEntry = RETRANSMIT_TIMER_TABLE[txeCmd.sessionID];
+        currEntry.type = txeCmd.type;
+        currEntry.rto  = txeCmd.rto;
+        if (not currEntry.active) {
+            rto = backoffRto(txeCmd.rto, currEntry.retries);
+            currEntry.active = true;
+            currEntry.stamp++;
+            soTiw_Cmd.write(TimerWheelCmd(txeCmd.sessionID, rto, currEntry.stamp));
+            if (DEBUG_LEVEL & TRACE_RTT) {
+                printInfo(myName, "Session #%d - Starting  RTO timer (value=%d ticks).\n",
+                          txeCmd.sessionID.to_int(), rto.to_uint());
             }
         }
-
-        // Get current entry from table
-        currEntry = RETRANSMIT_TIMER_TABLE[currID];
-
-        if (txeCmdVal) {
-            // There is a pending set command from [TXe]. Go and process it.
-            currEntry.type = txeCmd.type;
-            if (not currEntry.active) {
-                switch(currEntry.retries) {
-                case 0:
-                    currEntry.time = TIME_3s;
-                    break;
-                case 1:
-                    currEntry.time = TIME_6s;
-                    break;
-                case 2:
-                    currEntry.time = TIME_12s;
-                    break;
-                default:
-                    currEntry.time = TIME_30s;
-                    break;
-                }
-                currEntry.active = true;
-                if (DEBUG_LEVEL & TRACE_RTT) {
-                    printInfo(myName, "Session #%d - Starting  RTO timer (value=%d i.e. %d clock cycles).\n",
-                              currID.to_int(), currEntry.time.to_uint(),
-                                               currEntry.time.to_uint()*TOE_MAX_SESSIONS);
-                }
+        RETRANSMIT_TIMER_TABLE[txeCmd.sessionID] = currEntry;
+    }
+    else if (!siTiw_Exp.empty() and !soEmx_Event.full()) {
+        //------------------------------------------------
+        // Handle a timer expiration from [Tiw]
+        //  We need to check if we can generate another event, otherwise we
+        //  might end up in a Deadlock since the [TXe] will not be able to set
+        //  new retransmit timers.
+        //------------------------------------------------
+        siTiw_Exp.read(tiwExp);
+        currEntry = RETRANSMIT_TIMER_TABLE[tiwExp.sessionID];
+        if (currEntry.active and (currEntry.stamp == tiwExp.stamp)) {
+            currEntry.active = false;
+            if (currEntry.retries < 4) {
+                currEntry.retries++;
+                //-- Send timeout event to [TXe]
+                soEmx_Event.write(Event((EventType)currEntry.type,
+                                  tiwExp.sessionID,
+                                  currEntry.retries));
+                printWarn(myName, "Session #%d - RTO Timeout (retries=%d).\n",
+                          tiwExp.sessionID.to_int(), currEntry.retries.to_uint());
             }
             else {
-                if (DEBUG_LEVEL & TRACE_RTT) {
-                    printInfo(myName, "Session #%d - Current   RTO timer (value=%d i.e. %d clock cycles).\n",
-                              currID.to_int(), currEntry.time.to_uint(),
-                                               currEntry.time.to_uint()*TOE_MAX_SESSIONS);
-                }
-            }
-        }
-        else {
-            // No [TXe] command. Manage RETRANSMIT_TIMER_TABLE entries
-            if (currEntry.active) {
-                if (currEntry.time > 0) {
-                    currEntry.time--;
-                }
-                // We need to check if we can generate another event, otherwise we might
-                // end up in a Deadlock since the [TXe] will not be able to set new
-                // retransmit timers.
-                else if (!soEmx_Event.full()) {
-                    currEntry.time   = 0;
-                    currEntry.active = false;
-                    if (currEntry.retries < 4) {
-                        currEntry.retries++;
-                        //-- Send timeout event to [TXe]
-                        soEmx_Event.write(Event((EventType)currEntry.type,
-                                          currID,
-                                          currEntry.retries));
-                        printWarn(myName, "Session #%d - RTO Timeout (retries=%d).\n",
-                                  currID.to_int(), currEntry.retries.to_uint());
+                currEntry.retries = 0;
+                soSmx_SessCloseCmd.write(tiwExp.sessionID);
+                if (currEntry.type == SYN_EVENT) {
+                    soTAi_Notif.write(SessState(tiwExp.sessionID, CLOSED));
+                    if (DEBUG_LEVEL & TRACE_RTT) {
+                        printWarn(myName, "Notifying [TAi] - Failed to open session %d (event=\'%s\').\n",
+                                  tiwExp.sessionID.to_int(), getEventName(currEntry.type));
                     }
-                    else {
-                        currEntry.retries = 0;
-                        soSmx_SessCloseCmd.write(currID);
-                        if (currEntry.type == SYN_EVENT) {
-                            soTAi_Notif.write(SessState(currID, CLOSED));
-                            if (DEBUG_LEVEL & TRACE_RTT) {
-                                printWarn(myName, "Notifying [TAi] - Failed to open session %d (event=\'%s\').\n",
-                                          currID.to_int(), getEventName(currEntry.type));
-                            }
-                        }
-                        else {
-                            soRAi_Notif.write(TcpAppNotif(currID, CLOSED));
-                            if (DEBUG_LEVEL & TRACE_RTT) {
-                                printWarn(myName, "Notifying [RAi] - Session %d timeout (event=\'%s\').\n",
-                                          currID.to_int(), getEventName(currEntry.type));
-                            }
-                        }
+                }
+                else {
+                    soRAi_Notif.write(TcpAppNotif(tiwExp.sessionID, CLOSED));
+                    if (DEBUG_LEVEL & TRACE_RTT) {
+                        printWarn(myName, "Notifying [RAi] - Session %d timeout (event=\'%s\').\n",
+                                  tiwExp.sessionID.to_int(), getEventName(currEntry.type));
                     }
                 }
             }
-        } // End of: txeCmdVal
-
-        // Write the entry back into the table
-        RETRANSMIT_TIMER_TABLE[currID] = currEntry;
-        rtt_prevPosition = currID;
+            RETRANSMIT_TIMER_TABLE[tiwExp.sessionID] = currEntry;
+        }
     }
 }
 
@@ -313,6 +495,8 @@ void pRetransmitTimer(
  *
  * @param[in]  siRXe_ClrProbeTimer Clear probe timer command from RxEngine (RXe).
  * @param[in]  siTXe_SetProbeTimer Set probe timer from TxEngine (TXe).
+ * @param[out] soTiw_Cmd           Timer command to TimingWheel (Tiw).
+ * @param[in]  siTiw_Exp           Timer expiration from [Tiw].
  * @param[out] soEmx_Event         Event to EventMultiplexer (Emx).
  *
  * @details
@@ -325,9 +509,11 @@ void pRetransmitTimer(
  *
  *******************************************************************************/
 void pProbeTimer(
-        stream<SessionId>    &siRXe_ClrProbeTimer,
-        stream<SessionId>    &siTXe_SetProbeTimer,
-        stream<Event>        &soEmx_Event)
+        stream<SessionId>      &siRXe_ClrProbeTimer,
+        stream<SessionId>      &siTXe_SetProbeTimer,
+        stream<TimerWheelCmd>  &soTiw_Cmd,
+        stream<TimerWheelExp>  &siTiw_Exp,
+        stream<Event>          &soEmx_Event)
 {
     //-- DIRECTIVES FOR THIS PROCESS -------------------------------------------
     #pragma HLS INLINE off
@@ -342,74 +528,46 @@ void pProbeTimer(
     #pragma HLS DEPENDENCE variable=PROBE_TIMER_TABLE inter false
     #pragma HLS RESET      variable=PROBE_TIMER_TABLE
 
-    //-- STATIC CONTROL VARIABLES (with RESET) ---------------------------------
-    static bool                pbt_WaitForWrite=false;
-    #pragma HLS RESET variable=pbt_WaitForWrite
-    static SessionId           pbt_currSessId=0;
-    #pragma HLS RESET variable=pbt_currSessId
-    static SessionId           pbt_updtSessId=0;
-    #pragma HLS RESET variable=pbt_updtSessId
-    static SessionId           pbt_prevSessId=0;
-    #pragma HLS RESET variable=pbt_prevSessId
+    //****************************************************************
+    //** [FIXME - Disabling the KeepAlive process for the time being]
+    //****************************************************************
+    const bool cKeepAliveEnabled = false;
 
     //-- DYNAMIC VARIABLES -----------------------------------------------------
-    bool      fastResume = false;
-
-    if (pbt_WaitForWrite) {
-        //-- Update the table
-        if (pbt_updtSessId != pbt_prevSessId) {
-            PROBE_TIMER_TABLE[pbt_updtSessId].time = TIME_10s;
-            //****************************************************************
-            //** [FIXME - Disabling the KeepAlive process for the time being]
-            //****************************************************************
-            PROBE_TIMER_TABLE[pbt_updtSessId].active = false;
-            pbt_WaitForWrite = false;
-        }
-        pbt_prevSessId--;
-    }
-    else if (!siTXe_SetProbeTimer.empty()) {
-        //-- Read the Session-Id to set
-        siTXe_SetProbeTimer.read(pbt_updtSessId);
-        pbt_WaitForWrite = true;
-    }
-    else { // if (!soEmx_Event.full()) this leads to II=2
-        SessionId sessIdToProcess;
+    ProbeTimerEntry currEntry;
+    SessionId       sessId;
+    TimerWheelExp   tiwExp;
 
-        if (!siRXe_ClrProbeTimer.empty()) {
-            //-- Read the Session-Id to clear
-            sessIdToProcess = siRXe_ClrProbeTimer.read();
-            fastResume = true;
+    if (!siTXe_SetProbeTimer.empty()) {
+        //-- Read the Session-Id to set
+        siTXe_SetProbeTimer.read(sessId);
+        currEntry = PROBE_TIMER_TABLE[sessId];
+        if (cKeepAliveEnabled) {
+            currEntry.active = true;
+            currEntry.stamp++;
+            soTiw_Cmd.write(TimerWheelCmd(sessId, TIME_10s, currEntry.stamp));
+            PROBE_TIMER_TABLE[sessId] = currEntry;
         }
-        else {
-            sessIdToProcess = pbt_currSessId;
-            pbt_currSessId++;
-            if (pbt_currSessId == TOE_MAX_SESSIONS) {
-                pbt_currSessId = 0;
-            }
+    }
+    else if (!siRXe_ClrProbeTimer.empty()) {
+        //-- Clear (de-activate) the keepalive process for the current session-ID
+        siRXe_ClrProbeTimer.read(sessId);
+        currEntry = PROBE_TIMER_TABLE[sessId];
+        if (currEntry.active) {
+            currEntry.active = false;
+            soTiw_Cmd.write(TimerWheelCmd(sessId));
+            PROBE_TIMER_TABLE[sessId] = currEntry;
         }
-
-        if (PROBE_TIMER_TABLE[sessIdToProcess].active) {
-            if (fastResume) {
-                //-- Clear (de-activate) the keepalive process for the current session-ID
-                PROBE_TIMER_TABLE[sessIdToProcess].time = 0;
-                PROBE_TIMER_TABLE[sessIdToProcess].active = false;
-                fastResume = false;
-            }
-            else if (PROBE_TIMER_TABLE[sessIdToProcess].time == 0 and !soEmx_Event.full()) {
-                //-- Request to send a keepalive probe
-                PROBE_TIMER_TABLE[sessIdToProcess].time = 0;
-                PROBE_TIMER_TABLE[sessIdToProcess].active = false;
-                #if !(TCP_NODELAY)
-                    soEmx_Event.write(Event(TX_EVENT, sessIdToProcess));
-                #else
-                    soEmx_Event.write(Event(RT_EVENT, sessIdToProcess));
-                #endif
-            }
-            else {
-                PROBE_TIMER_TABLE[sessIdToProcess].time -= 1;
-            }
+    }
+    else if (!siTiw_Exp.empty() and !soEmx_Event.full()) {
+        //-- Request to send a keepalive probe
+        siTiw_Exp.read(tiwExp);
+        currEntry = PROBE_TIMER_TABLE[tiwExp.sessionID];
+        if (currEntry.active and (currEntry.stamp == tiwExp.stamp)) {
+            currEntry.active = false;
+            PROBE_TIMER_TABLE[tiwExp.sessionID] = currEntry;
+            soEmx_Event.write(Event(TX_EVENT, tiwExp.sessionID));
         }
-        pbt_prevSessId = sessIdToProcess;
     }
 }
 
@@ -417,6 +575,8 @@ void pProbeTimer(
  * @brief Close Timer (Clt) process
  *
  * @param[in]  siRXe_CloseTimer    The session-id that is closing from [RXe].
+ * @param[out] soTiw_Cmd           Timer command to TimingWheel (Tiw).
+ * @param[in]  siTiw_Exp           Timer expiration from [Tiw].
  * @param[out] soSmx_SessCloseCmd  Close command to StateTableMux (Smx).
  *
  * @details
@@ -424,8 +584,10 @@ void pProbeTimer(
  *   is kept in the 'TIME-WAIT' state for an additional 60s before it gets closed.
  ******************************************************************************/
 void pCloseTimer(
-        stream<SessionId>    &siRXe_CloseTimer,
-        stream<SessionId>    &soSmx_SessCloseCmd)
+        stream<SessionId>      &siRXe_CloseTimer,
+        stream<TimerWheelCmd>  &soTiw_Cmd,
+        stream<TimerWheelExp>  &siTiw_Exp,
+        stream<SessionId>      &soSmx_SessCloseCmd)
 {
     //-- DIRECTIVES FOR THIS PROCESS -------------------------------------------
     #pragma HLS PIPELINE II=1 enable_flush
@@ -438,50 +600,27 @@ void pCloseTimer(
     #pragma HLS DEPENDENCE variable=CLOSE_TIMER_TABLE inter false
     #pragma HLS RESET      variable=CLOSE_TIMER_TABLE
 
-    //-- STATIC CONTROL VARIABLES (with RESET) ---------------------------------
-    static bool                clt_waitForWrite=false;
-    #pragma HLS RESET variable=clt_waitForWrite
-    static SessionId           clt_currSessId=0;
-    #pragma HLS RESET variable=clt_currSessId
-    static SessionId           clt_prevSessId=0;
-    #pragma HLS RESET variable=clt_prevSessId
+    //-- DYNAMIC VARIABLES -----------------------------------------------------
+    CloseTimerEntry currEntry;
+    SessionId       sessId;
+    TimerWheelExp   tiwExp;
 
-    //-- STATIC DATAFLOW VARIABLES ---------------------------------------------
-    static SessionId           clt_sessIdToSet;
-
-    if (clt_waitForWrite) {
-        //-- Update the table
-        if (clt_sessIdToSet != clt_prevSessId) {
-            CLOSE_TIMER_TABLE[clt_sessIdToSet].time = TIME_60s;
-            CLOSE_TIMER_TABLE[clt_sessIdToSet].active = true;
-            clt_waitForWrite = false;
-        }
-        clt_prevSessId--;
-    }
-    else if (!siRXe_CloseTimer.empty()) {
+    if (!siRXe_CloseTimer.empty()) {
         //-- Read the Session-Id to set
-        siRXe_CloseTimer.read(clt_sessIdToSet);
-        clt_waitForWrite = true;
+        siRXe_CloseTimer.read(sessId);
+        currEntry = CLOSE_TIMER_TABLE[sessId];
+        currEntry.active = true;
+        currEntry.stamp++;
+        soTiw_Cmd.write(TimerWheelCmd(sessId, TIME_60s, currEntry.stamp));
+        CLOSE_TIMER_TABLE[sessId] = currEntry;
     }
-    else {
-        clt_prevSessId = clt_currSessId;
-        // Check if timer is 0, otherwise decrement
-        if (CLOSE_TIMER_TABLE[clt_currSessId].active) {
-            if (CLOSE_TIMER_TABLE[clt_currSessId].time > 0) {
-                CLOSE_TIMER_TABLE[clt_currSessId].time -= 1;
-            }
-            else {
-                CLOSE_TIMER_TABLE[clt_currSessId].time = 0;
-                CLOSE_TIMER_TABLE[clt_currSessId].active = false;
-                soSmx_SessCloseCmd.write(clt_currSessId);
-            }
-        }
-
-        if (clt_currSessId == TOE_MAX_SESSIONS) {
-            clt_currSessId = 0;
-        }
-        else {
-            clt_currSessId++;
+    else if (!siTiw_Exp.empty()) {
+        siTiw_Exp.read(tiwExp);
+        currEntry = CLOSE_TIMER_TABLE[tiwExp.sessionID];
+        if (currEntry.active and (currEntry.stamp == tiwExp.stamp)) {
+            currEntry.active = false;
+            CLOSE_TIMER_TABLE[tiwExp.sessionID] = currEntry;
+            soSmx_SessCloseCmd.write(tiwExp.sessionID);
         }
     }
 }
@@ -533,6 +672,30 @@ void timers(
     #pragma HLS stream    variable=ssPbtToEmx_Event          depth=2
     #pragma HLS DATA_PACK variable=ssPbtToEmx_Event
 
+    static stream<TimerWheelCmd>   ssRttToTiw_Cmd            ("ssRttToTiw_Cmd");
+    #pragma HLS stream    variable=ssRttToTiw_Cmd            depth=4
+    #pragma HLS DATA_PACK variable=ssRttToTiw_Cmd
+
+    static stream<TimerWheelCmd>   ssPbtToTiw_Cmd            ("ssPbtToTiw_Cmd");
+    #pragma HLS stream    variable=ssPbtToTiw_Cmd            depth=4
+    #pragma HLS DATA_PACK variable=ssPbtToTiw_Cmd
+
+    static stream<TimerWheelCmd>   ssCltToTiw_Cmd            ("ssCltToTiw_Cmd");
+    #pragma HLS stream    variable=ssCltToTiw_Cmd            depth=4
+    #pragma HLS DATA_PACK variable=ssCltToTiw_Cmd
+
+    static stream<TimerWheelExp>   ssTiwToRtt_Exp            ("ssTiwToRtt_Exp");
+    #pragma HLS stream    variable=ssTiwToRtt_Exp            depth=4
+    #pragma HLS DATA_PACK variable=ssTiwToRtt_Exp
+
+    static stream<TimerWheelExp>   ssTiwToPbt_Exp            ("ssTiwToPbt_Exp");
+    #pragma HLS stream    variable=ssTiwToPbt_Exp            depth=4
+    #pragma HLS DATA_PACK variable=ssTiwToPbt_Exp
+
+    static stream<TimerWheelExp>   ssTiwToClt_Exp            ("ssTiwToClt_Exp");
+    #pragma HLS stream    variable=ssTiwToClt_Exp            depth=4
+    #pragma HLS DATA_PACK variable=ssTiwToClt_Exp
+
     // Event Mux (Emx) based on template stream Mux
     //  Notice order --> RetransmitTimer comes before ProbeTimer
     pStreamMux(
@@ -544,21 +707,40 @@ void timers(
     pRetransmitTimer(
         siRXe_ReTxTimerCmd,
         siTXe_ReTxTimerCmd,
+        ssRttToTiw_Cmd,
+        ssTiwToRtt_Exp,
         ssRttToEmx_Event,
         ssRttToSmx_SessCloseCmd,
         soTAi_Notif,
         soRAi_Notif);
 
+    pTimerWheel<0>(
+        ssRttToTiw_Cmd,
+        ssTiwToRtt_Exp);
+
     // Probe Timer (Pbt)
     pProbeTimer(
         siRXe_ClrProbeTimer,
         siTXe_SetProbeTimer,
+        ssPbtToTiw_Cmd,
+        ssTiwToPbt_Exp,
         ssPbtToEmx_Event);
 
+    pTimerWheel<1>(
+        ssPbtToTiw_Cmd,
+        ssTiwToPbt_Exp);
+
+    // Close Timer (Clt)
     pCloseTimer(
         siRXe_CloseTimer,
+        ssCltToTiw_Cmd,
+        ssTiwToClt_Exp,
         ssClsToSmx_SessCloseCmd);
 
+    pTimerWheel<2>(
+        ssCltToTiw_Cmd,
+        ssTiwToClt_Exp);
+
     // State table release Mux (Smx) based on template stream Mux
     pStreamMux(
         ssClsToSmx_SessCloseCmd,
@@ -66,14 +66,86 @@ using namespace hls;
 enum StateEntry {DISABLED_ENTRY = false,
                  ACTIVE_ENTRY   = true};
 
+/*******************************************************************************
+ * TIMING WHEEL (Tiw)
+ *  A hierarchical timing wheel made of three levels of slots. Level-0 slots are
+ *  one tick wide, level-1 slots are TIW_L0_SIZE ticks wide and level-2 slots are
+ *  TIW_L0_SIZE*TIW_L1_SIZE ticks wide. Each slot holds a doubly-linked list of
+ *  the sessions that expire within that slot.
+ *******************************************************************************/
+#define TIW_L0_BITS     10
+#define TIW_L1_BITS      8
+#define TIW_L2_BITS      9
+#define TIW_TIME_BITS   (TIW_L0_BITS + TIW_L1_BITS + TIW_L2_BITS)
+
+#define TIW_L0_SIZE     (1 << TIW_L0_BITS)
+#define TIW_L1_SIZE     (1 << TIW_L1_BITS)
+#define TIW_L2_SIZE     (1 << TIW_L2_BITS)
+#define TIW_NR_HEADS    (TIW_L0_SIZE + TIW_L1_SIZE + TIW_L2_SIZE)
+
+typedef ap_uint<TIW_TIME_BITS>              TimerTicks;
+typedef ap_uint<11>                         TimerHeadIdx;  // log2(TIW_NR_HEADS)
+typedef ap_uint<cSHL_TOE_SESS_ID_WIDTH+1>   TimerLink;     // 0=NIL, SessionId+1 otherwise
+typedef ap_uint<2>                          TimerStamp;
+
+//-- The longest delay that a wheel can hold without aliasing its level-2 slot
+static const TimerTicks TIW_MAX_DELAY = (1 << TIW_TIME_BITS) - (1 << (TIW_L0_BITS + TIW_L1_BITS)) - 1;
+
+/********************************************
+ * Tiw - Timing Wheel Command
+ *  Arms (or re-arms) the timer of a session
+ *  with a delay, or disarms it.
+ ********************************************/
+class TimerWheelCmd
+{
+  public:
+    SessionId       sessionID;
+    TimerTicks      delay;
+    TimerStamp      stamp;
+    bool            arm;
+    TimerWheelCmd() {}
+    TimerWheelCmd(SessionId id) :
+        sessionID(id), delay(0), stamp(0), arm(false) {}
+    TimerWheelCmd(SessionId id, TimerTicks delay, TimerStamp stamp) :
+        sessionID(id), delay(delay), stamp(stamp), arm(true) {}
+};
+
+/********************************************
+ * Tiw - Timing Wheel Expiration
+ *  The stamp is the one of the arming command
+ *  and is used to discard stale expirations.
+ ********************************************/
+class TimerWheelExp
+{
+  public:
+    SessionId       sessionID;
+    TimerStamp      stamp;
+    TimerWheelExp() {}
+    TimerWheelExp(SessionId id, TimerStamp stamp) :
+        sessionID(id), stamp(stamp) {}
+};
+
+/********************************************
+ * Tiw - Timing Wheel Node Meta-data
+ ********************************************/
+class TimerWheelMeta
+{
+  public:
+    TimerTicks      deadline;
+    TimerHeadIdx    head;
+    TimerStamp      stamp;
+    bool            linked;
+    TimerWheelMeta() {}
+};
+
 /********************************************
  * Cls - Close Timer Entry
  ********************************************/
 class CloseTimerEntry
 {
   public:
-    ap_uint<32> time;
-    bool        active;
+    TimerStamp      stamp;
+    bool            active;
     CloseTimerEntry() {}
 };
 
@@ -83,7 +155,7 @@ class CloseTimerEntry
 class ProbeTimerEntry
 {
   public:
-    ap_uint<32>     time;
+    TimerStamp      stamp;
     bool            active;
     ProbeTimerEntry() {}
 };
@@ -94,10 +166,11 @@ class ProbeTimerEntry
 class ReTxTimerEntry
 {
   public:
-    ap_uint<32>     time;
+    TimerStamp      stamp;
     ap_uint<3>      retries;
     bool            active;
     EventType       type;
+    RtoTicks        rto;        // Latest RTO estimate received from [TXe]
     ReTxTimerEntry() {}
 };
 
@@ -62,11 +62,14 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "./timers/timers.hpp"
 #include "./event_engine/event_engine.hpp"
 #include "./ack_delay/src/ack_delay.hpp"
+#include "./congestion_control/src/congestion_control.hpp"
 #include "./port_table/port_table.hpp"
 #include "./rx_app_interface/rx_app_interface.hpp"
 #include "./tx_app_interface/tx_app_interface.hpp"
 #include "./rx_engine/src/rx_engine.hpp"
 #include "./tx_engine/src/tx_engine.hpp"
+#include "./onchip_buffer/src/onchip_buffer.hpp"
+#include "./page_allocator/src/page_allocator.hpp"
 
 /************************************************
  * INTERFACE SYNTHESIS DIRECTIVES
@@ -174,6 +177,7 @@ void pTbSimCount(
  *
  * -- MMIO Interfaces
  * @param[in]  piMMIO_IpAddr     IP4 Address from [MMIO].
+ * @param[in]  piMMIO_CookieKey  The secret key of the SYN cookies from [MMIO].
  * @param[out] soMMIO_RxMemWrErr Reports a Rx memory write error.
  * @param[out] soMMIO_NotifDrop  The value of the notification drop counter.
  * @param[out] soMMIO_MetaDrop   The value of the metadata drop counter.
@@ -227,6 +231,11 @@ void pTbSimCount(
  * -- DEBUG / Session Statistics Interfaces
  * @param[out] soDBG_SssRelCnt   Session release count to DEBUG.
  * @param[out] soDBG_SssRegCnt   Session register count to DEBUG.
+ *
+ * @details
+ *  When the TOE is built with an on-chip buffer (see 'TOE_BUFFER_MEMORY'), the
+ *   memory commands and data are served by the On-Chip Buffer (OCb) and the
+ *   MEM interfaces are left idle.
  *******************************************************************************/
 void toe(
 
@@ -234,6 +243,7 @@ void toe(
         //-- MMIO Interfaces
         //------------------------------------------------------
         Ip4Addr                              piMMIO_IpAddr,
+        SynCookieKey                         piMMIO_CookieKey,
         stream<StsBit>                      &soMMIO_RxMemWrErr,
         stream<ap_uint<8> >                 &soMMIO_NotifDropCnt,
         stream<ap_uint<8> >                 &soMMIO_MetaDropCnt,
@@ -354,6 +364,13 @@ void toe(
     static stream<SigBit>             ssAKdToEVe_TxEventSig      ("ssAKdToEVe_TxEventSig");
     #pragma HLS stream       variable=ssAKdToEVe_TxEventSig      depth=cDepth_AKdToEVe_Event
 
+    //-------------------------------------------------------------------------
+    //-- Congestion Control (CCo)
+    //-------------------------------------------------------------------------
+    static stream<RXeTxSarQuery>      ssCCoToTSt_TxSarQry        ("ssCCoToTSt_TxSarQry");
+    #pragma HLS stream       variable=ssCCoToTSt_TxSarQry        depth=cDepth_CCoToTSt_Qry
+    #pragma HLS DATA_PACK    variable=ssCCoToTSt_TxSarQry
+
     //-------------------------------------------------------------------------
     //-- Event Engine (EVe)
     //-------------------------------------------------------------------------
@@ -401,9 +418,9 @@ void toe(
     #pragma HLS stream       variable=ssRXeToRSt_RxSarQry        depth=cDepth_RXeToRSt_Qry
     #pragma HLS DATA_PACK    variable=ssRXeToRSt_RxSarQry
 
-    static stream<RXeTxSarQuery>      ssRXeToTSt_TxSarQry        ("ssRXeToTSt_TxSarQry");
-    #pragma HLS stream       variable=ssRXeToTSt_TxSarQry        depth=cDepth_RXeToTSt_Qry
-    #pragma HLS DATA_PACK    variable=ssRXeToTSt_TxSarQry
+    static stream<RXeTxSarQuery>      ssRXeToCCo_TxSarQry        ("ssRXeToCCo_TxSarQry");
+    #pragma HLS stream       variable=ssRXeToCCo_TxSarQry        depth=cDepth_RXeToCCo_Qry
+    #pragma HLS DATA_PACK    variable=ssRXeToCCo_TxSarQry
 
     static stream<RXeReTransTimerCmd> ssRXeToTIm_ReTxTimerCmd    ("ssRXeToTIm_ReTxTimerCmd");
     #pragma HLS stream       variable=ssRXeToTIm_ReTxTimerCmd    depth=2
@@ -491,6 +508,25 @@ void toe(
     #pragma HLS stream       variable=ssTAiToTSt_PushCmd         depth=cDepth_TAiToTSt_Cmd
     #pragma HLS DATA_PACK    variable=ssTAiToTSt_PushCmd
 
+    static stream<AxisApp>            ssTAiToTXe_Data            ("ssTAiToTXe_Data");
+    #pragma HLS stream       variable=ssTAiToTXe_Data            depth=cDepth_TAiToTXe_Data
+    #pragma HLS DATA_PACK    variable=ssTAiToTXe_Data
+
+    static stream<TxCellCsum>         ssTAiToTXe_CellCsum        ("ssTAiToTXe_CellCsum");
+    #pragma HLS stream       variable=ssTAiToTXe_CellCsum        depth=cDepth_TAiToTXe_Cell
+    #pragma HLS DATA_PACK    variable=ssTAiToTXe_CellCsum
+
+    static stream<Csum>               ssTAiToTXe_BypassCsum      ("ssTAiToTXe_BypassCsum");
+    #pragma HLS stream       variable=ssTAiToTXe_BypassCsum      depth=cDepth_TAiToTXe_Csum
+
+    static stream<PageRelease>        ssTAiToPAl_RxRelease       ("ssTAiToPAl_RxRelease");
+    #pragma HLS stream       variable=ssTAiToPAl_RxRelease       depth=4
+    #pragma HLS DATA_PACK    variable=ssTAiToPAl_RxRelease
+
+    static stream<PageRelease>        ssTAiToPAl_TxRelease       ("ssTAiToPAl_TxRelease");
+    #pragma HLS stream       variable=ssTAiToPAl_TxRelease       depth=16
+    #pragma HLS DATA_PACK    variable=ssTAiToPAl_TxRelease
+
     static stream<StateQuery>         ssTAiToSTt_AcceptStateQry  ("ssTAiToSTt_AcceptStateQry");
     #pragma HLS stream       variable=ssTAiToSTt_AcceptStateQry  depth=2
     #pragma HLS DATA_PACK    variable=ssTAiToSTt_AcceptStateQry
@@ -554,6 +590,82 @@ void toe(
     #pragma HLS stream       variable=ssTStToTAi_PushCmd         depth=cDepth_TStToTAi_Cmd
     #pragma HLS DATA_PACK    variable=ssTStToTAi_PushCmd
 
+    //-------------------------------------------------------------------------
+    //-- Page Allocator (PAl)
+    //-------------------------------------------------------------------------
+    static stream<SigBit>             ssPAlToRXe_PoolLow         ("ssPAlToRXe_PoolLow");
+    #pragma HLS stream       variable=ssPAlToRXe_PoolLow         depth=2
+
+    #if TOE_PAGED_BUFFERS
+    static stream<AxisApp>            ssPAlToRAi_Data            ("ssPAlToRAi_Data");
+    #pragma HLS stream       variable=ssPAlToRAi_Data            depth=4
+    #pragma HLS DATA_PACK    variable=ssPAlToRAi_Data
+
+    //-------------------------------------------------------------------------
+    //-- Page Allocator (PAl) and its Memory Clients (RXe, RAi, TAi, TXe)
+    //-------------------------------------------------------------------------
+    static stream<DmCmd>              ssRXeToPAl_WrCmd           ("ssRXeToPAl_WrCmd");
+    #pragma HLS stream       variable=ssRXeToPAl_WrCmd           depth=4
+    #pragma HLS DATA_PACK    variable=ssRXeToPAl_WrCmd
+
+    static stream<DmCmd>              ssRAiToPAl_RdCmd           ("ssRAiToPAl_RdCmd");
+    #pragma HLS stream       variable=ssRAiToPAl_RdCmd           depth=4
+    #pragma HLS DATA_PACK    variable=ssRAiToPAl_RdCmd
+
+    static stream<DmCmd>              ssTAiToPAl_WrCmd           ("ssTAiToPAl_WrCmd");
+    #pragma HLS stream       variable=ssTAiToPAl_WrCmd           depth=4
+    #pragma HLS DATA_PACK    variable=ssTAiToPAl_WrCmd
+
+    static stream<DmCmd>              ssTXeToPAl_RdCmd           ("ssTXeToPAl_RdCmd");
+    #pragma HLS stream       variable=ssTXeToPAl_RdCmd           depth=4
+    #pragma HLS DATA_PACK    variable=ssTXeToPAl_RdCmd
+    #endif
+
+    #if (TOE_BUFFER_MEMORY != TOE_BUFFER_DDR)
+    //-------------------------------------------------------------------------
+    //-- On-Chip Buffer (OCb) and its Memory Clients (RXe, RAi, TAi, TXe)
+    //-------------------------------------------------------------------------
+    static stream<DmCmd>              ssRXeToOCb_WrCmd           ("ssRXeToOCb_WrCmd");
+    #pragma HLS stream       variable=ssRXeToOCb_WrCmd           depth=4
+    #pragma HLS DATA_PACK    variable=ssRXeToOCb_WrCmd
+
+    static stream<AxisApp>            ssRXeToOCb_Data            ("ssRXeToOCb_Data");
+    #pragma HLS stream       variable=ssRXeToOCb_Data            depth=16
+    #pragma HLS DATA_PACK    variable=ssRXeToOCb_Data
+
+    static stream<DmSts>              ssOCbToRXe_WrSts           ("ssOCbToRXe_WrSts");
+    #pragma HLS stream       variable=ssOCbToRXe_WrSts           depth=4
+    #pragma HLS DATA_PACK    variable=ssOCbToRXe_WrSts
+
+    static stream<DmCmd>              ssRAiToOCb_RdCmd           ("ssRAiToOCb_RdCmd");
+    #pragma HLS stream       variable=ssRAiToOCb_RdCmd           depth=4
+    #pragma HLS DATA_PACK    variable=ssRAiToOCb_RdCmd
+
+    static stream<AxisApp>            ssOCbToRAi_Data            ("ssOCbToRAi_Data");
+    #pragma HLS stream       variable=ssOCbToRAi_Data            depth=16
+    #pragma HLS DATA_PACK    variable=ssOCbToRAi_Data
+
+    static stream<DmCmd>              ssTAiToOCb_WrCmd           ("ssTAiToOCb_WrCmd");
+    #pragma HLS stream       variable=ssTAiToOCb_WrCmd           depth=4
+    #pragma HLS DATA_PACK    variable=ssTAiToOCb_WrCmd
+
+    static stream<AxisApp>            ssTAiToOCb_Data            ("ssTAiToOCb_Data");
+    #pragma HLS stream       variable=ssTAiToOCb_Data            depth=16
+    #pragma HLS DATA_PACK    variable=ssTAiToOCb_Data
+
+    static stream<DmSts>              ssOCbToTAi_WrSts           ("ssOCbToTAi_WrSts");
+    #pragma HLS stream       variable=ssOCbToTAi_WrSts           depth=4
+    #pragma HLS DATA_PACK    variable=ssOCbToTAi_WrSts
+
+    static stream<DmCmd>              ssTXeToOCb_RdCmd           ("ssTXeToOCb_RdCmd");
+    #pragma HLS stream       variable=ssTXeToOCb_RdCmd           depth=4
+    #pragma HLS DATA_PACK    variable=ssTXeToOCb_RdCmd
+
+    static stream<AxisApp>            ssOCbToTXe_Data            ("ssOCbToTXe_Data");
+    #pragma HLS stream       variable=ssOCbToTXe_Data            depth=16
+    #pragma HLS DATA_PACK    variable=ssOCbToTXe_Data
+    #endif
+
     /**********************************************************************
      * PROCESS FUNCTIONS: TCP STATE-KEEPING DATA STRUCTURES
      **********************************************************************/
@@ -597,13 +709,18 @@ void toe(
 
     //-- TX SAR Table (TSt) ------------------------------------------------
     tx_sar_table(
-            ssRXeToTSt_TxSarQry,
+            ssCCoToTSt_TxSarQry,
             ssTStToRXe_TxSarRep,
             ssTXeToTSt_TxSarQry,
             ssTStToTXe_TxSarRep,
             ssTAiToTSt_PushCmd,
             ssTStToTAi_PushCmd);
 
+    //-- Congestion Control (CCo) -----------------------------------------
+    congestion_control(
+            ssRXeToCCo_TxSarQry,
+            ssCCoToTSt_TxSarQry);
+
     //-- Port Table (PRt) --------------------------------------------------
     port_table(
             sPRtToRdy_Ready,
@@ -660,7 +777,7 @@ void toe(
             ssPRtToRXe_PortStateRep,
             ssRXeToRSt_RxSarQry,
             ssRStToRXe_RxSarRep,
-            ssRXeToTSt_TxSarQry,
+            ssRXeToCCo_TxSarQry,
             ssTStToRXe_TxSarRep,
             ssRXeToTIm_ReTxTimerCmd,
             ssRXeToTIm_ClrProbeTimer,
@@ -668,13 +785,25 @@ void toe(
             ssRXeToEVe_Event,
             ssRXeToTAi_SessOpnSts,
             ssRXeToRAi_Notif,
+            ssPAlToRXe_PoolLow,
+          #if TOE_PAGED_BUFFERS
+            ssRXeToPAl_WrCmd,
+            soMEM_RxP_Data,
+            siMEM_RxP_WrSts,
+          #elif (TOE_BUFFER_MEMORY == TOE_BUFFER_DDR)
             soMEM_RxP_WrCmd,
             soMEM_RxP_Data,
             siMEM_RxP_WrSts,
+          #else
+            ssRXeToOCb_WrCmd,
+            ssRXeToOCb_Data,
+            ssOCbToRXe_WrSts,
+          #endif
             soMMIO_RxMemWrErr,
             soMMIO_CrcDropCnt,
             soMMIO_SessDropCnt,
             soMMIO_OooDropCnt,
+            piMMIO_CookieKey,
             soDBG_RxFreeSpace,
             soDBG_TcpIpRxByteCnt,
             soDBG_OooDebug);
@@ -687,8 +816,19 @@ void toe(
             ssRStToTXe_RxSarRep,
             ssTXeToTSt_TxSarQry,
             ssTStToTXe_TxSarRep,
+          #if TOE_PAGED_BUFFERS
+            ssTXeToPAl_RdCmd,
+            siMEM_TxP_Data,
+          #elif (TOE_BUFFER_MEMORY == TOE_BUFFER_DDR)
             soMEM_TxP_RdCmd,
             siMEM_TxP_Data,
+          #else
+            ssTXeToOCb_RdCmd,
+            ssOCbToTXe_Data,
+          #endif
+            ssTAiToTXe_Data,
+            ssTAiToTXe_CellCsum,
+            ssTAiToTXe_BypassCsum,
             ssTXeToTIm_SetReTxTimer,
             ssTXeToTIm_SetProbeTimer,
             ssTXeToSLc_ReverseLkpReq,
@@ -714,8 +854,16 @@ void toe(
              ssTImToRAi_Notif,
              ssRAiToRSt_RxSarQry,
              ssRStToRAi_RxSarRep,
+           #if TOE_PAGED_BUFFERS
+             ssRAiToPAl_RdCmd,
+             ssPAlToRAi_Data,
+           #elif (TOE_BUFFER_MEMORY == TOE_BUFFER_DDR)
              soMEM_RxP_RdCmd,
              siMEM_RxP_Data,
+           #else
+             ssRAiToOCb_RdCmd,
+             ssOCbToRAi_Data,
+           #endif
              soMMIO_NotifDropCnt,
              soMMIO_MetaDropCnt,
              soMMIO_DataDropCnt);
@@ -728,9 +876,22 @@ void toe(
             siTAIF_Data,
             siTAIF_SndReq,
             soTAIF_SndRep,
+          #if TOE_PAGED_BUFFERS
+            ssTAiToPAl_WrCmd,
+            soMEM_TxP_Data,
+            siMEM_TxP_WrSts,
+          #elif (TOE_BUFFER_MEMORY == TOE_BUFFER_DDR)
             soMEM_TxP_WrCmd,
             soMEM_TxP_Data,
             siMEM_TxP_WrSts,
+          #else
+            ssTAiToOCb_WrCmd,
+            ssTAiToOCb_Data,
+            ssOCbToTAi_WrSts,
+          #endif
+            ssTAiToTXe_Data,
+            ssTAiToTXe_CellCsum,
+            ssTAiToTXe_BypassCsum,
             ssTAiToSTt_SessStateReq,
             ssSTtToTAi_SessStateRep,
             ssTAiToSTt_AcceptStateQry,   // [FIXME- ReEname ConnectStateQry]
@@ -744,8 +905,51 @@ void toe(
             ssRXeToTAi_SessOpnSts,
             ssTAiToEVe_Event,
             ssTImToTAi_Notif,
+            ssTAiToPAl_RxRelease,
+            ssTAiToPAl_TxRelease,
             piMMIO_IpAddr);
 
+    #if TOE_PAGED_BUFFERS
+    /**********************************************************************
+     * PROCESS FUNCTIONS: PAGE ALLOCATOR
+     **********************************************************************/
+
+    //-- Page Allocator (PAl) ---------------------------------------------
+    page_allocator(
+            ssRXeToPAl_WrCmd,
+            soMEM_RxP_WrCmd,
+            ssRAiToPAl_RdCmd,
+            soMEM_RxP_RdCmd,
+            siMEM_RxP_Data,
+            ssPAlToRAi_Data,
+            ssTAiToPAl_RxRelease,
+            ssPAlToRXe_PoolLow,
+            ssTAiToPAl_WrCmd,
+            soMEM_TxP_WrCmd,
+            ssTXeToPAl_RdCmd,
+            soMEM_TxP_RdCmd,
+            ssTAiToPAl_TxRelease);
+    #endif
+
+    #if (TOE_BUFFER_MEMORY != TOE_BUFFER_DDR)
+    /**********************************************************************
+     * PROCESS FUNCTIONS: ON-CHIP BUFFER
+     **********************************************************************/
+
+    //-- On-Chip Buffer (OCb) ---------------------------------------------
+    onchip_buffer(
+            ssRXeToOCb_WrCmd,
+            ssRXeToOCb_Data,
+            ssOCbToRXe_WrSts,
+            ssRAiToOCb_RdCmd,
+            ssOCbToRAi_Data,
+            ssTAiToOCb_WrCmd,
+            ssTAiToOCb_Data,
+            ssOCbToTAi_WrSts,
+            ssTXeToOCb_RdCmd,
+            ssOCbToTXe_Data);
+    #endif
+
     /**********************************************************************
      * PROCESS FUNCTIONS: CONTROL AND DEBUG INTERFACES
      **********************************************************************/
@@ -767,6 +971,7 @@ void toe(
  * @brief  Top of TCP Offload Engine (TOE)
  *
  * @param[in]  piMMIO_IpAddr     IP4 Address from [MMIO].
+ * @param[in]  piMMIO_CookieKey  The secret key of the SYN cookies from [MMIO].
  * @param[out] soMMIO_RxMemWrErr Reports a Rx memory write error.
  * @param[out] soMMIO_NotifDrop  The value of the notification drop counter.
  * @param[out] soMMIO_MetaDrop   The value of the metadata drop counter.
@@ -815,6 +1020,7 @@ void toe(
         //-- MMIO Interfaces
         //------------------------------------------------------
         Ip4Addr                              piMMIO_IpAddr,
+        SynCookieKey                         piMMIO_CookieKey,
         stream<StsBit>                      &soMMIO_RxMemWrErr,
         stream<ap_uint<8> >                 &soMMIO_NotifDropCnt,
         stream<ap_uint<8> >                 &soMMIO_MetaDropCnt,
@@ -910,6 +1116,7 @@ void toe(
     /*********************************************************************/
     //-- MMIO Interfaces
     #pragma HLS INTERFACE ap_stable          port=piMMIO_IpAddr
+    #pragma HLS INTERFACE ap_stable          port=piMMIO_CookieKey
     #pragma HLS RESOURCE core=AXI4Stream variable=soMMIO_RxMemWrErr   metadata="-bus_bundle soMMIO_RxMemWrErr"
     #pragma HLS RESOURCE core=AXI4Stream variable=soMMIO_NotifDropCnt metadata="-bus_bundle soMMIO_NotifDropCnt"
     #pragma HLS RESOURCE core=AXI4Stream variable=soMMIO_MetaDropCnt  metadata="-bus_bundle soMMIO_MetaDropCnt"
@@ -990,6 +1197,7 @@ void toe(
     toe(
         //-- MMIO Interfaces
         piMMIO_IpAddr,
+        piMMIO_CookieKey,
         soMMIO_RxMemWrErr,
         soMMIO_NotifDropCnt,
         soMMIO_MetaDropCnt,
@@ -1058,6 +1266,7 @@ void toe(
         //-- MMIO Interfaces
         //------------------------------------------------------
         Ip4Addr                              piMMIO_IpAddr,
+        SynCookieKey                         piMMIO_CookieKey,
         stream<StsBit>                      &soMMIO_RxMemWrErr,
         stream<ap_uint<8> >                 &soMMIO_NotifDropCnt,
         stream<ap_uint<8> >                 &soMMIO_MetaDropCnt,
@@ -1149,6 +1358,7 @@ void toe(
 
     //-- MMIO Interfaces
     #pragma HLS INTERFACE ap_stable          port=piMMIO_IpAddr       name=piMMIO_IpAddr
+    #pragma HLS INTERFACE ap_stable          port=piMMIO_CookieKey    name=piMMIO_CookieKey
     #pragma HLS INTERFACE axis register both port=soMMIO_RxMemWrErr   name=soMMIO_RxMemWrErr
     #pragma HLS INTERFACE axis register both port=soMMIO_NotifDropCnt name=soMMIO_NotifDropCnt
     #pragma HLS INTERFACE axis register both port=soMMIO_MetaDropCnt  name=soMMIO_MetaDropCnt
@@ -1236,6 +1446,7 @@ void toe(
     toe(
         //-- MMIO Interfaces
         piMMIO_IpAddr,
+        piMMIO_CookieKey,
         soMMIO_RxMemWrErr,
         soMMIO_NotifDropCnt,
         soMMIO_MetaDropCnt,
@@ -92,6 +92,15 @@ static const TcpSegLen MY_MSS = (MTU - IP4_HEADER_LEN - TCP_HEADER_LEN) & ~0x7;
 //--  FYI: This MSS is advertised by the remote host during the 3-may handshake.
 static const TcpSegLen THEIR_MSS = ZYC2_MSS; // 1352
 
+//-- The number of bits needed to index a table with one entry per session
+static const int TOE_SESS_IDX_BITS = (TOE_MAX_SESSIONS > 8192) ? 14 : (TOE_MAX_SESSIONS > 4096) ? 13 :
+                                     (TOE_MAX_SESSIONS > 2048) ? 12 : (TOE_MAX_SESSIONS > 1024) ? 11 :
+                                     (TOE_MAX_SESSIONS >  512) ? 10 : (TOE_MAX_SESSIONS >  256) ?  9 :
+                                     (TOE_MAX_SESSIONS >  128) ?  8 : (TOE_MAX_SESSIONS >   64) ?  7 :
+                                     (TOE_MAX_SESSIONS >   32) ?  6 : (TOE_MAX_SESSIONS >   16) ?  5 :
+                                     (TOE_MAX_SESSIONS >    8) ?  4 : (TOE_MAX_SESSIONS >    4) ?  3 :
+                                     (TOE_MAX_SESSIONS >    2) ?  2 : 1;
+
 
 /*******************************************************************************
  * DEFINITIONS
@@ -107,13 +116,27 @@ extern uint32_t      packetCounter;  // [FIXME] Remove
 extern uint32_t      idleCycCnt;     // [FIXME] Remove
 extern unsigned int  gSimCycCnt;     // [FIXME] Remove
 
+//-- TIMER TICKS
+//--  The retransmit, probe and close timers are implemented with a timing wheel
+//--  which advances by one tick every 'TOE_TIMER_TICK_CYCLES' clock cycles. The
+//--  TIME_* constants below are therefore expressed in ticks, whereas the ACKD_*
+//--  constants are expressed in scans of the former ACK delay table and the
+//--  'ACKD_MAX_CYCLES' constant in clock cycles.
 #ifndef __SYNTHESIS__
   // HowTo - You should adjust the value of 'TIME_1s' such that the testbench
   //   works with your longest segment. In other words, if 'TIME_1s' is too short
   //   and/or your segment is too long, you may experience retransmission events
   //   (RT) which will break the test. You may want to use 'siIPRX_OneSeg.dat' or
   //   'siIPRX_TwoSeg.dat' to tune this parameter.
-  static const ap_uint<32> TIME_1s        =   250;
+  //  Override with '-DTOE_SIM_TIME_1S_TICKS=<NUM>' when the testbench emulates
+  //   round trips that are longer than the default retransmission timeout.
+  #ifndef TOE_SIM_TIME_1S_TICKS
+    #define TOE_SIM_TIME_1S_TICKS  250
+  #endif
+  static const ap_uint<32> TIME_1s        = TOE_SIM_TIME_1S_TICKS;
+
+  // One tick per table scan of the former timers (keeps the testbench timing)
+  static const ap_uint<32> TOE_TIMER_TICK_CYCLES = TOE_MAX_SESSIONS;
 
   static const ap_uint<32> TIME_1us       = (((ap_uint<32>)(TIME_1s/1000000) > 1) ? (ap_uint<32>)(TIME_1s/1000000) : (ap_uint<32>)1);
   static const ap_uint<32> TIME_64us      = (((ap_uint<32>)(TIME_1s/  15625) > 1) ? (ap_uint<32>)(TIME_1s/  15625) : (ap_uint<32>)1);
@@ -129,6 +152,8 @@ extern unsigned int  gSimCycCnt;     // [FIXME] Remove
   static const ap_uint<32> ACKD_32us      = ( 32.0/0.0064/TOE_MAX_SESSIONS/10) + 1;
   static const ap_uint<32> ACKD_64us      = ( 64.0/0.0064/TOE_MAX_SESSIONS/10) + 1;
 
+  static const ap_uint<32> ACKD_MAX_CYCLES = (TOE_ACKD_MAX_US/0.0064/10) + 1;
+
   static const ap_uint<32> TIME_1ms       = (((ap_uint<32>)(TIME_1s/1000) > 1) ? (ap_uint<32>)(TIME_1s/1000) : (ap_uint<32>)1);
   static const ap_uint<32> TIME_5ms       = (((ap_uint<32>)(TIME_1s/ 200) > 1) ? (ap_uint<32>)(TIME_1s/ 200) : (ap_uint<32>)1);
   static const ap_uint<32> TIME_25ms      = (((ap_uint<32>)(TIME_1s/  40) > 1) ? (ap_uint<32>)(TIME_1s/  40) : (ap_uint<32>)1);
@@ -147,6 +172,13 @@ extern unsigned int  gSimCycCnt;     // [FIXME] Remove
   static const ap_uint<32> TIME_30s       = ( 30*TIME_1s);
   static const ap_uint<32> TIME_60s       = ( 60*TIME_1s);
   static const ap_uint<32> TIME_120s      = (120*TIME_1s);
+
+  // The RTO floor is expressed in ticks because a tick is much longer than 1us.
+  //  It defaults to one second. Override with '-DTOE_SIM_MIN_RTO_TICKS=<NUM>'.
+  #ifndef TOE_SIM_MIN_RTO_TICKS
+    #define TOE_SIM_MIN_RTO_TICKS  TIME_1s
+  #endif
+  static const ap_uint<32> TIME_MIN_RTO   = TOE_SIM_MIN_RTO_TICKS;
 #else
   static const ap_uint<32> ACKD_1us       = (  1.0/0.0064/TOE_MAX_SESSIONS) + 1;
   static const ap_uint<32> ACKD_2us       = (  2.0/0.0064/TOE_MAX_SESSIONS) + 1;
@@ -155,31 +187,61 @@ extern unsigned int  gSimCycCnt;     // [FIXME] Remove
   static const ap_uint<32> ACKD_16us      = ( 16.0/0.0064/TOE_MAX_SESSIONS) + 1;
   static const ap_uint<32> ACKD_32us      = ( 32.0/0.0064/TOE_MAX_SESSIONS) + 1;
   static const ap_uint<32> ACKD_64us      = ( 64.0/0.0064/TOE_MAX_SESSIONS) + 1;
-  static const ap_uint<32> TIME_128us     = (128.0/0.0064/TOE_MAX_SESSIONS) + 1;
-  static const ap_uint<32> TIME_256us     = (256.0/0.0064/TOE_MAX_SESSIONS) + 1;
-  static const ap_uint<32> TIME_512us     = (512.0/0.0064/TOE_MAX_SESSIONS) + 1;
-
-  static const ap_uint<32> TIME_1ms       = (  1.0/0.0000064/TOE_MAX_SESSIONS) + 1;
-  static const ap_uint<32> TIME_5ms       = (  5.0/0.0000064/TOE_MAX_SESSIONS) + 1;
-  static const ap_uint<32> TIME_25ms      = ( 25.0/0.0000064/TOE_MAX_SESSIONS) + 1;
-  static const ap_uint<32> TIME_50ms      = ( 50.0/0.0000064/TOE_MAX_SESSIONS) + 1;
-  static const ap_uint<32> TIME_100ms     = (100.0/0.0000064/TOE_MAX_SESSIONS) + 1;
-  static const ap_uint<32> TIME_250ms     = (250.0/0.0000064/TOE_MAX_SESSIONS) + 1;
-
-  static const ap_uint<32> TIME_1s        = (  1.0/0.0000000064/TOE_MAX_SESSIONS) + 1;
-  static const ap_uint<32> TIME_3s        = (  3.0/0.0000000064/TOE_MAX_SESSIONS) + 1;
-  static const ap_uint<32> TIME_5s        = (  5.0/0.0000000064/TOE_MAX_SESSIONS) + 1;
-  static const ap_uint<32> TIME_6s        = (  6.0/0.0000000064/TOE_MAX_SESSIONS) + 1;
-  static const ap_uint<32> TIME_7s        = (  7.0/0.0000000064/TOE_MAX_SESSIONS) + 1;
-  static const ap_uint<32> TIME_10s       = ( 10.0/0.0000000064/TOE_MAX_SESSIONS) + 1;
-  static const ap_uint<32> TIME_12s       = ( 12.0/0.0000000064/TOE_MAX_SESSIONS) + 1;
-  static const ap_uint<32> TIME_15s       = ( 15.0/0.0000000064/TOE_MAX_SESSIONS) + 1;
-  static const ap_uint<32> TIME_20s       = ( 20.0/0.0000000064/TOE_MAX_SESSIONS) + 1;
-  static const ap_uint<32> TIME_30s       = ( 30.0/0.0000000064/TOE_MAX_SESSIONS) + 1;
-  static const ap_uint<32> TIME_60s       = ( 60.0/0.0000000064/TOE_MAX_SESSIONS) + 1;
-  static const ap_uint<32> TIME_120s      = (120.0/0.0000000064/TOE_MAX_SESSIONS) + 1;
+
+  static const ap_uint<32> ACKD_MAX_CYCLES = (TOE_ACKD_MAX_US/0.0064) + 1;
+
+  // One tick ~ 1us @ 156.25MHz (i.e. 156 x 6.4ns)
+  static const ap_uint<32> TOE_TIMER_TICK_CYCLES = 156;
+
+  static const ap_uint<32> TIME_128us     =       128;
+  static const ap_uint<32> TIME_256us     =       256;
+  static const ap_uint<32> TIME_512us     =       512;
+
+  static const ap_uint<32> TIME_1ms       =      1000;
+  static const ap_uint<32> TIME_5ms       =      5000;
+  static const ap_uint<32> TIME_25ms      =     25000;
+  static const ap_uint<32> TIME_50ms      =     50000;
+  static const ap_uint<32> TIME_100ms     =    100000;
+  static const ap_uint<32> TIME_250ms     =    250000;
+
+  static const ap_uint<32> TIME_1s        =   1000000;
+  static const ap_uint<32> TIME_3s        = (  3*TIME_1s);
+  static const ap_uint<32> TIME_5s        = (  5*TIME_1s);
+  static const ap_uint<32> TIME_6s        = (  6*TIME_1s);
+  static const ap_uint<32> TIME_7s        = (  7*TIME_1s);
+  static const ap_uint<32> TIME_10s       = ( 10*TIME_1s);
+  static const ap_uint<32> TIME_12s       = ( 12*TIME_1s);
+  static const ap_uint<32> TIME_15s       = ( 15*TIME_1s);
+  static const ap_uint<32> TIME_20s       = ( 20*TIME_1s);
+  static const ap_uint<32> TIME_30s       = ( 30*TIME_1s);
+  static const ap_uint<32> TIME_60s       = ( 60*TIME_1s);
+  static const ap_uint<32> TIME_120s      = (120*TIME_1s);
+
+  static const ap_uint<32> TIME_MIN_RTO   = TOE_MIN_RTO_US;
 #endif
 
+//-- RETRANSMISSION TIMEOUT (RFC-6298)
+//--  The RTT estimates and the RTO of a session are expressed in timer ticks.
+static const ap_uint<32> TIME_INIT_RTO    = TIME_1s;
+static const ap_uint<32> TIME_MAX_RTO     = TIME_60s;
+
+typedef ap_uint<24> RttTicks;  // An RTT sample (up to ~16s)
+typedef ap_uint<27> RtoTicks;  // A retransmission timeout (up to ~134s)
+
+//-- SYN COOKIES
+//--  The time slot of a SYN cookie advances every 2^SYN_COOKIE_SLOT_BITS clock
+//--  cycles. A cookie is accepted during its own slot and the next one.
+//--  The secret key is reloaded from [MMIO] at the start of every slot and the
+//--  key of the previous slot is kept for the cookies issued during that slot.
+#ifndef __SYNTHESIS__
+  static const int SYN_COOKIE_SLOT_BITS   = 16;  // Lets the testbench age the cookies out
+#else
+  static const int SYN_COOKIE_SLOT_BITS   = 29;  // 2^29 x 6.4ns = 3.4s
+#endif
+typedef ap_uint<3>   SynCookieSlot;   // The slot bits carried by a cookie
+typedef ap_uint<32>  SynCookieEpoch;  // The number of slots since reset
+typedef ap_uint<128> SynCookieKey;    // The SipHash-2-4 key of the cookies (from MMIO)
+
 
 /*******************************************************************************
  * GLOBAL DEFINES and GENERIC TYPES
@@ -206,19 +268,24 @@ typedef ap_uint<cSHL_TOE_CLS_REQ_WIDTH> ClsReq;
 const int cDepth_AKdToEVe_Event =   8;
 const int cDepth_AKdToTXe_Event =  16;
 
+const int cDepth_CCoToTSt_Qry   =   4;
+
 const int cDepth_EVeToAKd_Event =   8;
 
 const int cDepth_RAiToRSt_Qry   =   4;
 
 const int cDepth_RXeToEVe_Event =  64;
 const int cDepth_RXeToRSt_Qry   =   4;
-const int cDepth_RXeToTSt_Qry   =   4;
+const int cDepth_RXeToCCo_Qry   =   4;
 
 const int cDepth_STtToRXe_Rep   =   2;
 const int cDepth_STtToTAi_Rep   =   2;
 
 const int cDepth_TAiToEVe_Event =   8;
 const int cDepth_TAiToTSt_Cmd   =   4;
+const int cDepth_TAiToTXe_Data  = 256;  // Must hold the chunks of at least one MSS
+const int cDepth_TAiToTXe_Cell  =   8;
+const int cDepth_TAiToTXe_Csum  =   8;
 
 const int cDepth_TStToRXe_Rep   =   2;
 const int cDepth_TStToTAi_Cmd   =   4;
@@ -270,8 +337,23 @@ typedef ap_uint< 1> tLast;
 //---------------------------------------------------------
 //-- TOE - EVENT TYPES
 //---------------------------------------------------------
+//--  FYI: A 'TX_BYPASS_EVENT' announces an APP message which is also
+//--   streamed straight from [TAi] to [TXe] (see TOE_TCP_NODELAY).
+//--   A 'SYN_COOKIE_EVENT' relates to a SYN_ACK sent with a SYN cookie
+//--   (see TOE_SYN_COOKIES and 'SynCookieEvent').
 enum EventType { TX_EVENT=0,    RT_EVENT,  ACK_EVENT, SYN_EVENT, \
-                 SYN_ACK_EVENT, FIN_EVENT, RST_EVENT, ACK_NODELAY_EVENT };
+                 SYN_ACK_EVENT, FIN_EVENT, RST_EVENT, ACK_NODELAY_EVENT, \
+                 TX_BYPASS_EVENT, SYN_COOKIE_EVENT };
+
+//---------------------------------------------------------
+//-- TOE - CONGESTION CONTROL EVENT TYPES
+//--  Forwarded by [RXe] to the Congestion Control (CCo).
+//---------------------------------------------------------
+enum CcEvent { CC_NONE=0,   // No update of the congestion window
+               CC_INIT,     // A connection is being opened
+               CC_NEW_ACK,  // An ACK acknowledged new data
+               CC_DUP_ACK   // The third duplicate ACK was received
+             };
 
 //---------------------------------------------------------
 //-- TOE - SESSION STATE
@@ -289,14 +371,55 @@ typedef ap_uint<15> TcpDynPort;  // TCP Dynamic Port [0x8000..0xFFFF]
 //---------------------------------------------------------
 typedef TcpSeqNum   RxSeqNum;     // A sequence number received from the network layer
 typedef TcpAckNum   TxAckNum;     // An acknowledge number transmitted to the network layer
-typedef TcpWindow   RemotWinSize; // A remote window size
-typedef TcpWindow   LocalWinSize; // A local  window size
+typedef ap_uint<TOE_WINDOW_BITS> TcpWinSize; // A window size once scaled (RFC-7323)
+typedef TcpWinSize  RemotWinSize; // A remote window size
+typedef TcpWinSize  LocalWinSize; // A local  window size
+typedef ap_uint<4>  TcpWinScale;  // A window scale shift count [0..14]
 
 typedef ap_uint<32>              RxMemPtr;  // A pointer to RxMemBuff ( 4GB)  [FIXME <33>]
 typedef ap_uint<32>              TxMemPtr;  // A pointer to TxMemBuff ( 4GB)  [FIXME <33>]
-typedef ap_uint<TOE_WINDOW_BITS> TcpBufAdr; // A TCP buffer address   (64KB)
-typedef TcpBufAdr                RxBufPtr;  // A pointer to RxSessBuf (64KB)
-typedef TcpBufAdr                TxBufPtr;  // A pointer to TxSessBuf (64KB)
+typedef ap_uint<TOE_WINDOW_BITS> TcpBufAdr; // A TCP buffer address   (256KB)
+typedef TcpBufAdr                RxBufPtr;  // A pointer to RxSessBuf (256KB)
+typedef TcpBufAdr                TxBufPtr;  // A pointer to TxSessBuf (256KB)
+
+//-- The checksum cells of a Tx buffer (see TOE_CSUM_CELL_BITS)
+static const uint32_t TOE_CSUM_CELL_SIZE  = (1 << TOE_CSUM_CELL_BITS);                   // 128B
+static const uint32_t TOE_CSUM_CELLS      = (1 << (TOE_WINDOW_BITS-TOE_CSUM_CELL_BITS)); // 2048 per session
+typedef ap_uint<TOE_WINDOW_BITS-TOE_CSUM_CELL_BITS> TxCellIdx; // The index of a cell in a TxSessBuf
+
+//-- The head and the tail reads of a payload must leave whole chunks between them (see [Mdl])
+typedef char TOE_CSUM_CELL_BITS_is_out_of_range[((TOE_CSUM_CELL_BITS >= 4) and
+                                                 (TOE_CSUM_CELL_BITS < TOE_WINDOW_BITS)) ? 1 : -1];
+
+typedef ap_uint<4>               RxOooCnt;  // A number of out-of-order blocks (see TOE_OOO_BLOCKS)
+
+//---------------------------------------------------------
+//-- TOE - An Out-Of-Order Block of received bytes
+//--  The block spans the sequence numbers [tail, head).
+//---------------------------------------------------------
+class RxOooBlock {
+  public:
+    RxSeqNum    tail;    // First byte of the block
+    RxSeqNum    head;    // Next byte after the block
+    RxOooBlock() {}
+    RxOooBlock(RxSeqNum tail, RxSeqNum head) :
+        tail(tail), head(head) {}
+};
+
+//---------------------------------------------------------
+//-- TOE - A Selective Acknowledgment Block (RFC-2018)
+//--  The block spans the sequence numbers [left, right).
+//---------------------------------------------------------
+typedef ap_uint<3>               SackCnt;   // A number of SACK blocks (see TOE_SACK_BLOCKS)
+
+class SackBlock {
+  public:
+    TcpSeqNum   left;    // First byte of the block
+    TcpSeqNum   right;   // Next byte after the block
+    SackBlock() {}
+    SackBlock(TcpSeqNum left, TcpSeqNum right) :
+        left(left), right(right) {}
+};
 
 //---------------------------------------------------------
 //--  SOCKET ADDRESS (alias ipTuple)
@@ -369,12 +492,19 @@ class RxSarReply {
   public:
     RxBufPtr    appd;
     RxSeqNum    rcvd;    // Last received SeqNum
-    RxSeqNum    oooHead;
-    RxSeqNum    oooTail;
-    FlagBool    ooo;
+    RxSeqNum    oooHead; // Next byte after the highest received byte
+    RxOooCnt    oooCnt;  // Number of valid out-of-order blocks
+    RxOooBlock  oooBlk[TOE_OOO_BLOCKS]; // Sorted by increasing SeqNum
+    FlagBool    sackOk;  // The remote peer permits SACK
+    FlagBool    winScaleOk;  // Window scaling was negotiated
+    TcpWinScale sndWinScale; // The window scale shift count of the remote peer
+    FlagBool    ecnOk;   // ECN was negotiated (RFC-3168)
+    FlagBool    ceEcho;  // The last data segment was CE marked (echoed with ECE)
     RxSarReply() {}
-    RxSarReply(RxBufPtr appd, RxSeqNum rcvd, StsBool ooo, RxSeqNum oooHead, RxSeqNum oooTail) :
-        appd(appd), rcvd(rcvd), ooo(ooo), oooHead(oooHead), oooTail(oooTail) {}
+    RxSarReply(RxBufPtr appd, RxSeqNum rcvd, RxSeqNum oooHead, RxOooCnt oooCnt) :
+        appd(appd), rcvd(rcvd), oooHead(oooHead), oooCnt(oooCnt), sackOk(false), winScaleOk(false), sndWinScale(0), ecnOk(false), ceEcho(false) {}
+    RxSarReply(RxBufPtr appd, RxSeqNum rcvd, RxSeqNum oooHead, RxOooCnt oooCnt, FlagBool sackOk) :
+        appd(appd), rcvd(rcvd), oooHead(oooHead), oooCnt(oooCnt), sackOk(sackOk), winScaleOk(false), sndWinScale(0), ecnOk(false), ceEcho(false) {}
 };
 
 //=========================================================
@@ -385,27 +515,38 @@ class RXeRxSarQuery {
     SessionId   sessionID;
     RxSeqNum    rcvd;      // Last received SeqNum
     RxSeqNum    oooHead;
-    RxSeqNum    oooTail;
-    FlagBool    ooo;
+    RxOooCnt    oooCnt;
+    RxOooBlock  oooBlk[TOE_OOO_BLOCKS];
+    FlagBool    sackOk;      // Only used by the init query
+    FlagBool    winScaleOk;  // Only used by the init query
+    TcpWinScale sndWinScale; // Only used by the init query
+    FlagBool    ecnOk;       // Only used by the init query
+    FlagBool    ce;          // The data segment was CE marked (not used by the init query)
     RdWrBit     write;
     CmdBit      init;
     RXeRxSarQuery() :
-        ooo(false) {}
+        oooCnt(0), sackOk(false), winScaleOk(false), sndWinScale(0), ecnOk(false), ce(false) {}
     // Read queries
     RXeRxSarQuery(SessionId id) :
-        sessionID(id), rcvd(0),    ooo(false), oooHead(0), oooTail(0), write(QUERY_RD), init(0) {}
+        sessionID(id), rcvd(0),    oooHead(0), oooCnt(0), ce(false), write(QUERY_RD), init(0) {}
     RXeRxSarQuery(SessionId id, RdWrBit wrBit) :
-        sessionID(id), rcvd(0),    ooo(FLAG_INO), oooHead(0), oooTail(0), write(QUERY_RD), init(0) {}
+        sessionID(id), rcvd(0),    oooHead(0), oooCnt(0), ce(false), write(QUERY_RD), init(0) {}
     // Write query - When in order processing
     RXeRxSarQuery(SessionId id, RxSeqNum rcvd, RdWrBit wrBit) :
-        sessionID(id), rcvd(rcvd), ooo(FLAG_INO), oooHead(0), oooTail(0), write(QUERY_WR), init(0) {}
+        sessionID(id), rcvd(rcvd), oooHead(rcvd), oooCnt(0), ce(false), write(QUERY_WR), init(0) {}
     // Init query
     RXeRxSarQuery(SessionId id, RxSeqNum rcvd, RdWrBit wrBit, CmdBit iniBit) :
-        sessionID(id), rcvd(rcvd), ooo(FLAG_INO), oooHead(0), oooTail(0), write(QUERY_WR), init(CMD_INIT) {}
+        sessionID(id), rcvd(rcvd), oooHead(rcvd), oooCnt(0), sackOk(false), winScaleOk(false), sndWinScale(0), ecnOk(false), ce(false), write(QUERY_WR), init(CMD_INIT) {}
+    RXeRxSarQuery(SessionId id, RxSeqNum rcvd, RdWrBit wrBit, CmdBit iniBit, FlagBool sackOk, FlagBool winScaleOk, TcpWinScale sndWinScale, FlagBool ecnOk) :
+        sessionID(id), rcvd(rcvd), oooHead(rcvd), oooCnt(0), sackOk(sackOk), winScaleOk(winScaleOk), sndWinScale(sndWinScale), ecnOk(ecnOk), ce(false), write(QUERY_WR), init(CMD_INIT) {}
     // Write query - When in out-of-order processing
-    RXeRxSarQuery(SessionId id, RxSeqNum rcvd, FlagBool ooo, RxSeqNum oooHead, RxSeqNum oooTail, RdWrBit wrBit) :
-        sessionID(id), rcvd(rcvd), ooo(ooo), oooHead(oooHead), oooTail(oooTail), write(QUERY_WR), init(0) {}
-
+    RXeRxSarQuery(SessionId id, RxSeqNum rcvd, RxSeqNum oooHead, RxOooCnt oooCnt, RxOooBlock oooBlk[TOE_OOO_BLOCKS], RdWrBit wrBit) :
+        sessionID(id), rcvd(rcvd), oooHead(oooHead), oooCnt(oooCnt), ce(false), write(QUERY_WR), init(0) {
+        for (int i=0; i<TOE_OOO_BLOCKS; ++i) {
+        #pragma HLS UNROLL
+            this->oooBlk[i] = oooBlk[i];
+        }
+    }
 };
 
 //=========================================================
@@ -450,16 +591,34 @@ class RXeTxSarQuery {
     LocalWinSize    cong_window;  // Local receiver's buffer size  (my)
     ap_uint<2>      count;
     CmdBool         fastRetransmitted;
+    SackCnt         sackCnt;      // Number of SACK blocks received with this ACK
+    SackBlock       sackBlk[TOE_SACK_BLOCKS];
     RdWrBit         write;
+    CmdBit          init;         // Opens a session whose SYN_ACK was sent with a SYN cookie
+    //-- Congestion control information (consumed by [CCo])
+    CcEvent         ccEvent;      // The event to apply to 'cong_window'
+    TcpWinSize      ackedBytes;   // Number of bytes newly acknowledged by this ACK
+    TcpCtrlBit      ece;          // The ECN-Echo flag of this ACK
+    FlagBool        rto;          // A retransmission timeout occurred since the previous write
+    LocalWinSize    slowstart_threshold; // As currently held by [TSt]
+    FlagBool        cwr;          // Set by [CCo] when the window was reduced upon an ECN-Echo
 
     RXeTxSarQuery () :
-        fastRetransmitted(false) {}
+        fastRetransmitted(false), sackCnt(0), init(0), ccEvent(CC_NONE), ackedBytes(0), ece(0), rto(false), cwr(false) {}
     // Read Query
     RXeTxSarQuery(SessionId id, RdWrBit wrBit) :
-        sessionID(id), fastRetransmitted(false), write(QUERY_RD) {}
+        sessionID(id), fastRetransmitted(false), sackCnt(0), write(QUERY_RD), init(0), ccEvent(CC_NONE), ackedBytes(0), ece(0), rto(false), cwr(false) {}
     // Write Query
     RXeTxSarQuery(SessionId id, TxAckNum ackd, RemotWinSize recv_win, LocalWinSize cong_win, ap_uint<2> count, CmdBool fastRetransmitted) :
-        sessionID(id), ackd(ackd), recv_window(recv_win), cong_window(cong_win), count(count), fastRetransmitted(fastRetransmitted), write(QUERY_WR) {}
+        sessionID(id), ackd(ackd), recv_window(recv_win), cong_window(cong_win), count(count), fastRetransmitted(fastRetransmitted), sackCnt(0), write(QUERY_WR), init(0), ccEvent(CC_NONE), ackedBytes(0), ece(0), rto(false), cwr(false) {}
+    // Write Query - With the SACK blocks of the incoming ACK
+    RXeTxSarQuery(SessionId id, TxAckNum ackd, RemotWinSize recv_win, LocalWinSize cong_win, ap_uint<2> count, CmdBool fastRetransmitted, SackCnt sackCnt, SackBlock sackBlk[TOE_SACK_BLOCKS]) :
+        sessionID(id), ackd(ackd), recv_window(recv_win), cong_window(cong_win), count(count), fastRetransmitted(fastRetransmitted), sackCnt(sackCnt), write(QUERY_WR), init(0), ccEvent(CC_NONE), ackedBytes(0), ece(0), rto(false), cwr(false) {
+        for (int i=0; i<TOE_SACK_BLOCKS; ++i) {
+        #pragma HLS UNROLL
+            this->sackBlk[i] = sackBlk[i];
+        }
+    }
 };
 
 //=========================================================
@@ -469,13 +628,14 @@ class RXeTxSarReply {
   public:
     TxAckNum        prevAckd;  // Bytes TX'ed and ACK'ed
     TxAckNum        prevUnak;  // Bytes TX'ed but not ACK'ed
-    TcpWindow       cong_window;
-    TcpWindow       slowstart_threshold;
+    LocalWinSize    cong_window;
+    LocalWinSize    slowstart_threshold;
     ap_uint<2>      count;
     CmdBool         fastRetransmitted;
+    FlagBool        rtoPending; // A retransmission timeout was not yet reported to [CCo]
     RXeTxSarReply() {}
-    RXeTxSarReply(TxAckNum ackd, TxAckNum unak, TcpWindow cong_win, TcpWindow sstresh, ap_uint<2> count, CmdBool fastRetransmitted) :
-        prevAckd(ackd), prevUnak(unak), cong_window(cong_win), slowstart_threshold(sstresh), count(count), fastRetransmitted(fastRetransmitted) {}
+    RXeTxSarReply(TxAckNum ackd, TxAckNum unak, LocalWinSize cong_win, LocalWinSize sstresh, ap_uint<2> count, CmdBool fastRetransmitted) :
+        prevAckd(ackd), prevUnak(unak), cong_window(cong_win), slowstart_threshold(sstresh), count(count), fastRetransmitted(fastRetransmitted), rtoPending(false) {}
 };
 
 //=========================================================
@@ -490,21 +650,22 @@ class TXeTxSarQuery {
     bool            finReady;
     bool            finSent;
     bool            isRtQuery;
+    bool            cwrSent;    // A segment was sent with CWR since the previous read
 
     TXeTxSarQuery() :
-        finReady(false), finSent(false), isRtQuery(false) {}
+        finReady(false), finSent(false), isRtQuery(false), cwrSent(false) {}
     // Read Query
     TXeTxSarQuery(SessionId id, RdWrBit wrBit) :
-        sessionID(id), write(QUERY_RD), finReady(false), finSent(false), isRtQuery(false) {}
+        sessionID(id), write(QUERY_RD), finReady(false), finSent(false), isRtQuery(false), cwrSent(false) {}
     // Write Queries
     TXeTxSarQuery(SessionId id, TxAckNum not_ackd, RdWrBit write) :
-        sessionID(id), not_ackd(not_ackd), write(QUERY_WR), init(0), finReady(false), finSent(false), isRtQuery(false) {}
+        sessionID(id), not_ackd(not_ackd), write(QUERY_WR), init(0), finReady(false), finSent(false), isRtQuery(false), cwrSent(false) {}
     TXeTxSarQuery(SessionId id, TxAckNum not_ackd, RdWrBit write, CmdBit init) :
-        sessionID(id), not_ackd(not_ackd), write(QUERY_WR), init(init), finReady(false), finSent(false), isRtQuery(false) {}
+        sessionID(id), not_ackd(not_ackd), write(QUERY_WR), init(init), finReady(false), finSent(false), isRtQuery(false), cwrSent(false) {}
     TXeTxSarQuery(SessionId id, TxAckNum not_ackd, RdWrBit write, CmdBit init, bool finReady, bool finSent) :
-        sessionID(id), not_ackd(not_ackd), write(QUERY_WR), init(init), finReady(finReady), finSent(finSent), isRtQuery(false) {}
+        sessionID(id), not_ackd(not_ackd), write(QUERY_WR), init(init), finReady(finReady), finSent(finSent), isRtQuery(false), cwrSent(false) {}
     TXeTxSarQuery(SessionId id, TxAckNum not_ackd, RdWrBit write, CmdBit init, bool finReady, bool finSent, bool isRt) :
-        sessionID(id), not_ackd(not_ackd), write(QUERY_WR), init(init), finReady(finReady), finSent(finSent), isRtQuery(isRt) {}
+        sessionID(id), not_ackd(not_ackd), write(QUERY_WR), init(init), finReady(finReady), finSent(finSent), isRtQuery(isRt), cwrSent(false) {}
 };
 
 //=========================================================
@@ -514,13 +675,17 @@ class TXeTxSarReply {
   public:
     TxAckNum        ackd;       // TX'ed and ACK'ed
     TxAckNum        not_ackd;   // TX'ed but not ACK'ed
-    TcpWindow       min_window; // Min(cong_window, recv_window)
+    TcpWinSize      min_window; // Min(cong_window, recv_window)
     TxBufPtr        app;        // Written by APP
     bool            finReady;
     bool            finSent;
+    SackCnt         sackCnt;    // Number of valid blocks in the SACK scoreboard
+    SackBlock       sackBlk[TOE_SACK_BLOCKS];
+    RtoTicks        rto;        // Retransmission timeout (RFC-6298)
+    bool            cwrPending; // The window was reduced upon an ECN-Echo and CWR was not sent yet
     TXeTxSarReply() {}
-    TXeTxSarReply(ap_uint<32> ack, ap_uint<32> nack, ap_uint<16> min_window, ap_uint<16> app, bool finReady, bool finSent) :
-        ackd(ack), not_ackd(nack), min_window(min_window), app(app), finReady(finReady), finSent(finSent) {}
+    TXeTxSarReply(ap_uint<32> ack, ap_uint<32> nack, TcpWinSize min_window, TxBufPtr app, bool finReady, bool finSent) :
+        ackd(ack), not_ackd(nack), min_window(min_window), app(app), finReady(finReady), finSent(finSent), sackCnt(0), rto(TIME_INIT_RTO), cwrPending(false) {}
 };
 
 //=========================================================
@@ -557,23 +722,26 @@ class TAiTxSarPush {
 class TStTxSarPush {
   public:
     SessionId       sessionID;
-    ap_uint<16>     ackd;
-#if (TCP_NODELAY)
-    ap_uint<16> min_window;
-#endif
+    TxBufPtr        ackd;
     CmdBit          init;
     TStTxSarPush() {}
-#if !(TCP_NODELAY)
-    TStTxSarPush(SessionId id, ap_uint<16> ackd) :
+    TStTxSarPush(SessionId id, TxBufPtr ackd) :
         sessionID(id), ackd(ackd), init(0) {}
-    TStTxSarPush(SessionId id, ap_uint<16> ackd, CmdBit init) :
+    TStTxSarPush(SessionId id, TxBufPtr ackd, CmdBit init) :
         sessionID(id), ackd(ackd), init(init) {}
-#else
-    TStTxSarPush(SessionId id, ap_uint<16> ackd, ap_uint<16> min_window) :
-        sessionID(id), ackd(ackd), min_window(min_window), init(0) {}
-    TStTxSarPush(SessionId id, ap_uint<16> ackd, ap_uint<16> min_window, CmdBit init) :
-        sessionID(id), ackd(ackd), min_window(min_window), init(init) {}
-#endif
+};
+
+//=========================================================
+//== TXe / The Sum of a Checksum Cell from TAi
+//=========================================================
+class TxCellCsum {
+  public:
+    SessionId       sessId;
+    TxCellIdx       cellIdx;
+    Csum            csum;     // The folded sum of the 2^TOE_CSUM_CELL_BITS bytes of the cell
+    TxCellCsum() {}
+    TxCellCsum(SessionId sessId, TxCellIdx cellIdx, Csum csum) :
+        sessId(sessId), cellIdx(cellIdx), csum(csum) {}
 };
 
 /*******************************************************************************
@@ -591,7 +759,7 @@ class TxAppTableQuery {
     TxAppTableQuery() {}
     TxAppTableQuery(SessionId id) :
         sessId(id), mempt(0), write(false) {}
-    TxAppTableQuery(SessionId id, ap_uint<16> pt) :
+    TxAppTableQuery(SessionId id, TxBufPtr pt) :
         sessId(id), mempt(pt), write(true) {}
 };
 
@@ -601,19 +769,11 @@ class TxAppTableQuery {
 class TxAppTableReply {
   public:
     SessionId   sessId;
-    ap_uint<16> ackd;
+    TxBufPtr    ackd;
     TxBufPtr    mempt;
-    #if (TCP_NODELAY)
-      ap_uint<16> min_window;
-    #endif
     TxAppTableReply() {}
-    #if !(TCP_NODELAY)
-      TxAppTableReply(SessionId id, ap_uint<16> ackd, TxBufPtr pt) :
-           sessId(id), ackd(ackd), mempt(pt) {}
-    #else
-      TxAppTableReply(SessionId id, ap_uint<16> ackd, TxBufPtr pt, ap_uint<16> min_window) :
-          sessionID(id), ackd(ackd), mempt(pt), min_window(min_window) {}
-    #endif
+    TxAppTableReply(SessionId id, TxBufPtr ackd, TxBufPtr pt) :
+         sessId(id), ackd(ackd), mempt(pt) {}
 };
 
 /*******************************************************************************
@@ -643,11 +803,14 @@ class TXeReTransTimerCmd {
   public:
     SessionId   sessionID;
     EventType   type;
+    RtoTicks    rto;      // The current RTO estimate of the session
     TXeReTransTimerCmd() {}
     TXeReTransTimerCmd(SessionId id) :
-        sessionID(id), type(RT_EVENT) {}
+        sessionID(id), type(RT_EVENT), rto(TIME_INIT_RTO) {}
     TXeReTransTimerCmd(SessionId id, EventType type) :
-        sessionID(id), type(type) {}
+        sessionID(id), type(type), rto(TIME_INIT_RTO) {}
+    TXeReTransTimerCmd(SessionId id, EventType type, RtoTicks rto) :
+        sessionID(id), type(type), rto(rto) {}
 };
 
 /*******************************************************************************
@@ -670,9 +833,9 @@ class Event
         type(type), sessionID(id), address(0), length(0), rt_count(0) {}
     Event(EventType type, SessionId id, ap_uint<3> rt_count) :
         type(type), sessionID(id), address(0), length(0), rt_count(rt_count) {}
-    Event(EventType type, SessionId id, ap_uint<16> addr, ap_uint<16> len) :
+    Event(EventType type, SessionId id, TcpBufAdr addr, TcpSegLen len) :
         type(type), sessionID(id), address(addr), length(len), rt_count(0) {}
-    Event(EventType type, SessionId id, ap_uint<16> addr, ap_uint<16> len, ap_uint<3> rt_count) :
+    Event(EventType type, SessionId id, TcpBufAdr addr, TcpSegLen len, ap_uint<3> rt_count) :
         type(type), sessionID(id), address(addr), length(len), rt_count(rt_count) {}
 };
 
@@ -683,6 +846,8 @@ class ExtendedEvent : public Event
 {
   public:
     LE_SocketPair  tuple;    // [FIXME - Rename and change type]
+    TcpSeqNum      seqNumb;  // Only used by a stateless SYN_ACK
+    TcpAckNum      ackNumb;  // Only used by a stateless SYN_ACK
     ExtendedEvent() {}
     ExtendedEvent(const Event& ev) :
         Event(ev.type, ev.sessionID, ev.address, ev.length, ev.rt_count) {}
@@ -715,6 +880,42 @@ struct rstEvent : public Event  // [FIXME - Class naming convention]
     }
 };
 
+//=========================================================
+//== EVe / SynCookieEvent
+//==  Without a session ID, this event requests [TXe] to send
+//==  a stateless SYN_ACK to the socket pair of the event. Its
+//==  SEQ number is the SYN cookie computed by [RXe]. With a
+//==  session ID, it tells that the final ACK of such a SYN_ACK
+//==  has just opened this session.
+//=========================================================
+class SynCookieEvent : public ExtendedEvent
+{
+  public:
+    SynCookieEvent() {}
+    SynCookieEvent(const ExtendedEvent& ev) :
+        ExtendedEvent(ev) {}
+    // Stateless SYN_ACK
+    SynCookieEvent(LE_SocketPair tuple, TcpSeqNum cookie, TcpAckNum ackNumb, FlagBool sackOk, FlagBool winScaleOk) :
+        ExtendedEvent(Event(SYN_COOKIE_EVENT, 0), tuple) {
+        this->seqNumb = cookie;
+        this->ackNumb = ackNumb;
+        rt_count[1] = sackOk;
+        rt_count[2] = winScaleOk;
+    }
+    // The session opened by a SYN cookie
+    SynCookieEvent(SessionId id) :
+        ExtendedEvent(Event(SYN_COOKIE_EVENT, id, 1)) {}
+    bool hasSessionID() {
+        return (rt_count[0] == 1);
+    }
+    bool sackOk() {
+        return (rt_count[1] == 1);
+    }
+    bool winScaleOk() {
+        return (rt_count[2] == 1);
+    }
+};
+
 
 /*******************************************************************************
  * DDR MEMORY SUB-SYSTEM INTERFACES
@@ -727,6 +928,25 @@ struct rstEvent : public Event  // [FIXME - Class naming convention]
 #define RXMEMBUF    65536   // 64KB = 2^16
 #define TXMEMBUF    65536   // 64KB = 2^16
 
+//=========================================================
+//== PAl / Release of the pages of a TCP buffer
+//==  FYI: The pages spanning the buffer addresses [from,to)
+//==   of a session, or all of its pages, are returned to the
+//==   Page Allocator (PAl).
+//=========================================================
+class PageRelease {
+  public:
+    SessionId       sessionID;
+    TcpBufAdr       from;  // The first byte that is no longer needed
+    TcpBufAdr       to;    // The first byte that is still needed
+    FlagBool        all;   // Release all the pages of the session
+    PageRelease() {}
+    PageRelease(SessionId id) :
+        sessionID(id), from(0), to(0), all(true) {}
+    PageRelease(SessionId id, TcpBufAdr from, TcpBufAdr to) :
+        sessionID(id), from(from), to(to), all(false) {}
+};
+
 //=========================================================
 //== MUX / A 2-to-1 Stream multiplexer.
 //=========================================================
@@ -747,6 +967,7 @@ template<typename T> void pStreamMux(
         //-- MMIO Interfaces
         //------------------------------------------------------
         Ip4Addr                                  piMMIO_IpAddr,
+        SynCookieKey                             piMMIO_CookieKey,
         stream<StsBit>                          &soMMIO_RxMemWrErr,
         stream<ap_uint<8> >                     &soMMIO_NotifDropCnt,
         stream<ap_uint<8> >                     &soMMIO_MetaDropCnt,
@@ -852,6 +1073,7 @@ template<typename T> void pStreamMux(
         //-- MMIO Interfaces
         //------------------------------------------------------
         Ip4Addr                                  piMMIO_IpAddr,
+        SynCookieKey                             piMMIO_CookieKey,
         stream<StsBit>                          &soMMIO_RxMemWrErr,
         stream<ap_uint<8> >                     &soMMIO_NotifDropCnt,
         stream<ap_uint<8> >                     &soMMIO_MetaDropCnt,
@@ -58,6 +58,10 @@ const char *getEventName(EventType evType) {
         return "";
     case ACK_NODELAY_EVENT:
         return "ACK_NODELAY";
+    case TX_BYPASS_EVENT:
+        return "TX_BYPASS";
+    case SYN_COOKIE_EVENT:
+        return "SYN_COOKIE";
     default:
         return "ERROR: UNKNOWN EVENT!";
     }
@@ -92,4 +96,105 @@ void printFourTuple(const char *callerName, int src, FourTuple fourTuple) {
     printSockPair(callerName, socketPair);
 }
 
+/*******************************************************************************
+ * WINDOW SCALING HELPERS (RFC-7323)
+ *******************************************************************************/
+
+/*******************************************************************************
+ * @brief Converts a local window size into the 16-bit window field of a TCP
+ *  segment.
+ *
+ * @param[in] winSize     The window size to advertise (in bytes).
+ * @param[in] winScaleOk  Window scaling was negotiated with the remote peer.
+ * @returns the value of the window field.
+ *
+ * @details
+ *  The window is right-shifted by TOE_WINDOW_SCALE when window scaling is in
+ *   use, or is clamped to 64KB otherwise.
+ *******************************************************************************/
+TcpWindow scaleDownWindow(TcpWinSize winSize, FlagBool winScaleOk) {
+    #pragma HLS INLINE
+    TcpWinSize scaledWin = winSize >> TOE_WINDOW_SCALE;
+    if (winScaleOk) {
+        return scaledWin(15, 0);
+    }
+    else if (winSize > 0xFFFF) {
+        return 0xFFFF;
+    }
+    else {
+        return winSize(15, 0);
+    }
+}
+
+/*******************************************************************************
+ * @brief Converts the 16-bit window field of a TCP segment into a window size.
+ *
+ * @param[in] winField  The window field of the received segment.
+ * @param[in] winScale  The shift count of the remote peer (0 if not in use).
+ * @returns the window size in bytes, clamped to the size of a Tx buffer.
+ *******************************************************************************/
+TcpWinSize scaleUpWindow(TcpWindow winField, TcpWinScale winScale) {
+    #pragma HLS INLINE
+    ap_uint<16+14> winSize = ((ap_uint<16+14>)winField) << winScale;
+    if (winSize > (TOE_TX_BUFFER_SIZE-1)) {
+        return (TOE_TX_BUFFER_SIZE-1);
+    }
+    else {
+        return winSize(TOE_WINDOW_BITS-1, 0);
+    }
+}
+
+/*******************************************************************************
+ * @brief Tells if a memory access to a TCP buffer crosses a page boundary.
+ *
+ * @param[in] bufAdr  The buffer address of the first byte to access.
+ * @param[in] len     The number of bytes to access.
+ *
+ * @details
+ *  Without paging (see 'TOE_BUFFER_PAGING'), a page spans the entire buffer
+ *   and this tells if the access wraps around the buffer.
+ *******************************************************************************/
+bool crossesPage(TcpBufAdr bufAdr, TcpDatLen len) {
+    #pragma HLS INLINE
+    ap_uint<TOE_PAGE_BITS> pageOffset = bufAdr(TOE_PAGE_BITS-1, 0);
+    return ((pageOffset + len) > TOE_PAGE_SIZE);
+}
+
+/*******************************************************************************
+ * @brief Returns the buffer address of the first byte of the next page.
+ *
+ * @param[in] bufAdr  A buffer address.
+ *
+ * @details
+ *  The address wraps around at the end of the buffer. Without paging, this is
+ *   therefore always the address 0 of the buffer.
+ *******************************************************************************/
+TcpBufAdr getNextPageAdr(TcpBufAdr bufAdr) {
+    #pragma HLS INLINE
+    TcpBufAdr pageMask = (TOE_PAGE_SIZE-1);
+    return (TcpBufAdr)(bufAdr | pageMask) + 1;
+}
+
+/*******************************************************************************
+ * RETRANSMISSION TIMEOUT HELPERS (RFC-6298)
+ *******************************************************************************/
+
+/*******************************************************************************
+ * @brief Applies the exponential backoff to a retransmission timeout.
+ *
+ * @param[in] rto      The current RTO estimate of the session (in ticks).
+ * @param[in] retries  The number of timeouts of the session in a row.
+ * @returns the RTO doubled 'retries' times, bounded by TIME_MAX_RTO.
+ *******************************************************************************/
+RtoTicks backoffRto(RtoTicks rto, ap_uint<3> retries) {
+    #pragma HLS INLINE
+    ap_uint<27+7> backoff = ((ap_uint<27+7>)rto) << retries;
+    if (backoff > TIME_MAX_RTO) {
+        return TIME_MAX_RTO;
+    }
+    else {
+        return backoff(26, 0);
+    }
+}
+
 /*! \} */
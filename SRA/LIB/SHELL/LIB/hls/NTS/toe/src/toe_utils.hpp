@@ -38,6 +38,23 @@
 const char *getEventName(EventType ev);
 void        printFourTuple(const char *callerName, int src, FourTuple fourTuple);
 
+/*******************************************************************************
+ * WINDOW SCALING HELPERS - PROTOTYPE DEFINITIONS
+ *******************************************************************************/
+TcpWindow   scaleDownWindow(TcpWinSize winSize, FlagBool winScaleOk);
+TcpWinSize  scaleUpWindow(TcpWindow winField, TcpWinScale winScale);
+
+/*******************************************************************************
+ * BUFFER PAGING HELPERS - PROTOTYPE DEFINITIONS
+ *******************************************************************************/
+bool        crossesPage(TcpBufAdr bufAdr, TcpDatLen len);
+TcpBufAdr   getNextPageAdr(TcpBufAdr bufAdr);
+
+/*******************************************************************************
+ * RETRANSMISSION TIMEOUT HELPERS - PROTOTYPE DEFINITIONS
+ *******************************************************************************/
+RtoTicks    backoffRto(RtoTicks rto, ap_uint<3> retries);
+
 #endif
 
 /*! \} */
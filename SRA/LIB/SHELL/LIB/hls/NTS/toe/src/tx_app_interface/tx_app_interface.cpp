@@ -279,6 +279,12 @@ void pTxAppConnect(
  *   'TX_EVENT', the process will wait for one (or possibly two) memory status
  *   from [MEM] and will forward a command to update the 'TxApplicationPointer'
  *   of the [TSt].
+ *  A 'TX_BYPASS_EVENT' announces a message which is also streamed straight to
+ *   [TXe]. Such an event is forwarded to [EVe] right away, such that [TXe] can
+ *   send the message while it is being written into DDR. Once the memory write
+ *   status is received, the 'TxApplicationPointer' is updated and a regular
+ *   'TX_EVENT' is forwarded to [EVe]. This second event sends the message out
+ *   of the DDR buffer if [TXe] could not send it upon the bypass event.
  *  Whatever the received event, it is always forwarded to [EVe].
  *******************************************************************************/
 void pTxAppStatusHandler(
@@ -308,6 +314,11 @@ void pTxAppStatusHandler(
             if (ev.type == TX_EVENT) {
                 tash_fsmState = TASH_RD_MEM_STATUS_1;
             }
+            else if (ev.type == TX_BYPASS_EVENT) {
+                // Do not wait for the DDR write round trip
+                soEVe_Event.write(ev);
+                tash_fsmState = TASH_RD_MEM_STATUS_1;
+            }
             else {
                 soEVe_Event.write(ev);
             }
@@ -322,15 +333,15 @@ void pTxAppStatusHandler(
             DmSts status = siMEM_TxP_WrSts.read();
             if (status.okay) {
                 ap_uint<TOE_WINDOW_BITS+1> txAppPtr = ev.address + ev.length;
-                if (txAppPtr[TOE_WINDOW_BITS] == 1) {
-                    // The TCP buffer wrapped around
+                if (txAppPtr > TOE_TX_BUFFER_SIZE) {
+                    // The TCP buffer wrapped around (see [Mwr])
                     tash_fsmState = TASH_RD_MEM_STATUS_2;
                 }
                 else {
                     // Update the 'txAppPtr' of the TX_SAR_TABLE
                     soTSt_PushCmd.write(TAiTxSarPush(ev.sessionID, txAppPtr.range(TOE_WINDOW_BITS-1, 0)));
                     // Forward event to [EVe] which will signal [TXe]
-                    soEVe_Event.write(ev);
+                    soEVe_Event.write(Event(TX_EVENT, ev.sessionID, ev.address, ev.length));
                     if (DEBUG_LEVEL & TRACE_TASH) {
                         printInfo(myName, "Received TXMEM write status = %d.\n", status.okay.to_int());
                     }
@@ -347,7 +358,7 @@ void pTxAppStatusHandler(
                 // Update the 'txAppPtr' of the TX_SAR_TABLE
                 soTSt_PushCmd.write(TAiTxSarPush(ev.sessionID, txAppPtr));
                 // Forward event to [EVe] which will signal [TXe]
-                soEVe_Event.write(ev);
+                soEVe_Event.write(Event(TX_EVENT, ev.sessionID, ev.address, ev.length));
                 if (DEBUG_LEVEL & TRACE_TASH) {
                     printInfo(myName, "Received TXMEM write status = %d (this was a split access).\n", status.okay.to_int());
                 }
@@ -364,15 +375,23 @@ void pTxAppStatusHandler(
  * @param[in]  siTSt_PushCmd    Push command from TxSarTable (TSt).
  * @param[in]  siTas_AccessQry  Access query from TxAppStream (Tas).
  * @param[out] soTAs_AccessRep  Access reply to [Tas].
+ * @param[out] soPAl_RxRelease  Release of Rx buffer pages to PageAllocator (PAl).
+ * @param[out] soPAl_TxRelease  Release of Tx buffer pages to [PAl].
  *
  * @details
  *  This table keeps tack of the Tx ACK numbers and Tx memory pointers.
+ *  When the TCP buffers are paged (see 'TOE_PAGED_BUFFERS'), the Tx pages that
+ *   were acknowledged by the peer are returned to [PAl]. When a session is
+ *   initialized, the Rx and Tx pages left over by the previous session with
+ *   the same ID are returned to [PAl] as well.
  *
  *******************************************************************************/
 void pTxAppTable(
         stream<TStTxSarPush>      &siTSt_PushCmd,
         stream<TxAppTableQuery>   &siTas_AccessQry,
-        stream<TxAppTableReply>   &siTas_AccessRep)
+        stream<TxAppTableReply>   &siTas_AccessRep,
+        stream<PageRelease>       &soPAl_RxRelease,
+        stream<PageRelease>       &soPAl_TxRelease)
 {
     //-- DIRECTIVES FOR THIS PROCESS -------------------------------------------
     #pragma HLS PIPELINE II=1 enable_flush
@@ -389,15 +408,24 @@ void pTxAppTable(
     TStTxSarPush      ackPush;
     TxAppTableQuery   txAppUpdate;
 
-    if (!siTSt_PushCmd.empty()) {
+    if (!siTSt_PushCmd.empty() and !soPAl_RxRelease.full() and !soPAl_TxRelease.full()) {
         siTSt_PushCmd.read(ackPush);
         if (ackPush.init) {
             // At init this is actually not_ackd
             TX_APP_TABLE[ackPush.sessionID].ackd = ackPush.ackd-1;
             TX_APP_TABLE[ackPush.sessionID].mempt = ackPush.ackd;
+            if (TOE_PAGED_BUFFERS) {
+                soPAl_RxRelease.write(PageRelease(ackPush.sessionID));
+                soPAl_TxRelease.write(PageRelease(ackPush.sessionID));
+            }
         }
         else {
+            TxBufPtr prevAckd = TX_APP_TABLE[ackPush.sessionID].ackd;
             TX_APP_TABLE[ackPush.sessionID].ackd = ackPush.ackd;
+            if (TOE_PAGED_BUFFERS and
+               ((ackPush.ackd >> TOE_PAGE_BITS) != (prevAckd >> TOE_PAGE_BITS))) {
+                soPAl_TxRelease.write(PageRelease(ackPush.sessionID, prevAckd, ackPush.ackd));
+            }
         }
     }
     else if (!siTas_AccessQry.empty()) {
@@ -443,6 +471,10 @@ void pTxAppTable(
  *      the transmission.
  *   3) It the connection is not established, the application will be noticed it
  *      should act accordingly (e.g. by first opening the connection).
+ *  When TOE_TCP_NODELAY is enabled, a message that fits into a single segment
+ *   and does not wrap around the Tx buffer is flagged for the DDR bypass. Its
+ *   data are then also streamed to [TXe] by [Mwr], and its event is issued as
+ *   a 'TX_BYPASS_EVENT' (see [Tash]).
  *
  * @warning
  *  The outgoing stream 'soTAIF_SndRep is operated in non-blocking mode to avoid
@@ -451,7 +483,6 @@ void pTxAppTable(
  *   application process must provision enough buffering to store the reply
  *   returned by this process upon a request to send.
  *
- *  [TODO: Implement TCP_NODELAY]
  *******************************************************************************/
 void pStreamMetaLoader(
         stream<TcpAppSndReq>        &siTAIF_SndReq,
@@ -501,16 +532,13 @@ void pStreamMetaLoader(
         if (!siTat_AccessRep.empty() and !siSTt_SessStateRep.empty()) {
             siSTt_SessStateRep.read(sessState);
             siTat_AccessRep.read(txAppTableReply);
-            TcpDatLen maxWriteLength = (txAppTableReply.ackd - txAppTableReply.mempt) - 1;
-            /*** [TODO - TCP_NODELAY] ******************
-            #if (TCP_NODELAY)
-                ap_uint<16> usedLength = ((ap_uint<16>) writeSar.mempt - writeSar.ackd);
-                ap_uint<16> usableWindow = 0;
-                if (writeSar.min_window > usedLength) {
-                    usableWindow = writeSar.min_window - usedLength;
-                }
-            #endif
-            *******************************************/
+            // The free space of the Tx buffer may exceed the largest APP request
+            TxBufPtr  freeSpace = ((TxBufPtr)txAppTableReply.ackd - txAppTableReply.mempt) - 1;
+            TcpDatLen maxWriteLength = (freeSpace > 0xFFFF) ? (TcpDatLen)0xFFFF : (TcpDatLen)freeSpace;
+            // Only the single-segment messages that are written with a single memory access can bypass DDR
+            FlagBool  isBypass = (TOE_TCP_NODELAY != 0) and (mdl_appSndReq.length != 0) and
+                                 (mdl_appSndReq.length <= (ZYC2_MSS-TCP_HEADER_LEN)) and
+                                 (not crossesPage(txAppTableReply.mempt, mdl_appSndReq.length));
             if (!soTAIF_SndRep.full()) {
                 if (sessState != ESTABLISHED) {
                     // Notify APP about the none-established connection
@@ -526,12 +554,13 @@ void pStreamMetaLoader(
                 }
                 else { //-- Session is ESTABLISHED and data-length <= maxWriteLength
                     // Forward the metadata to the SegmentMemoryWriter (Mwr)
-                    soMwr_AppMeta.write(AppMemMeta(mdl_appSndReq.sessId, txAppTableReply.mempt, mdl_appSndReq.length));
+                    soMwr_AppMeta.write(AppMemMeta(mdl_appSndReq.sessId, txAppTableReply.mempt, mdl_appSndReq.length, isBypass));
                     // Notify APP about acceptance of the transmission
                     soTAIF_SndRep.write(TcpAppSndRep(mdl_appSndReq.sessId, mdl_appSndReq.length, maxWriteLength, NO_ERROR));
                     // Notify [TXe] about new data to be sent via an event to [EVe]
                     assessSize(myName, soEmx_Event, "soEmx_Event", 2);  // [FIXME-Use constant for the length]
-                    soEmx_Event.write(Event(TX_EVENT, mdl_appSndReq.sessId, txAppTableReply.mempt, mdl_appSndReq.length));
+                    soEmx_Event.write(Event((isBypass) ? TX_BYPASS_EVENT : TX_EVENT,
+                                            mdl_appSndReq.sessId, txAppTableReply.mempt, mdl_appSndReq.length));
                     // Update the 'txMemPtr' in TxAppTable
                     soTat_AccessReq.write(TxAppTableQuery(mdl_appSndReq.sessId, txAppTableReply.mempt + mdl_appSndReq.length));
                 }
@@ -553,6 +582,9 @@ void pStreamMetaLoader(
  * @param[in]  siSml_AppMeta APP memory metadata from StreamMetaLoader (Sml).
  * @param[out] soMEM_WrCmd   Tx memory write command to [MEM].
  * @param[out] soMEM_WrData  Tx memory write data to [MEM].
+ * @param[out] soTXe_Data    APP data bypassing the DDR to TxEngine (TXe).
+ * @param[out] soTXe_CellCsum   Sum of a checksum cell of the Tx buffer to [TXe].
+ * @param[out] soTXe_BypassCsum Sum of a message bypassing the DDR to [TXe].
  *
  * @details
  *  This process writes the incoming APP data into the external DRAM upon a
@@ -560,14 +592,37 @@ void pStreamMetaLoader(
  *  The Tx buffer memory is organized and managed as a circular buffer in the
  *   DRAM and it may happen that the APP data to be transmitted does not fit
  *   into the remaining memory buffer space because the memory pointer needs to
- *   wrap around. In such a case, the incoming APP data is broken down and is
- *   written into the physical DRAM as two memory buffers.
+ *   wrap around or because it crosses a buffer page (see 'TOE_BUFFER_PAGING').
+ *   In such a case, the incoming APP data is broken down and is written into
+ *   the physical DRAM as two memory buffers.
+ *  The data of a message flagged for the DDR bypass are duplicated into
+ *   'soTXe_Data' while they are written into memory. Such a message never
+ *   wraps around (see [Sml]).
+ *  The command side and the data side of this process are decoupled. The
+ *   metadata from [Sml] are turned into one or two data mover commands (.i.e a
+ *   scatter list of up to two buffers) in the very same cycle as the first data
+ *   chunk of the message is forwarded, and the command of the 2nd buffer is
+ *   issued while the 1st buffer is being streamed. The data side re-aligns the
+ *   2nd buffer on the fly, such that a message is written at one chunk per
+ *   cycle whether it is split or not.
+ *  The checksum side sums the APP data on the fly. Once the last byte of a
+ *   checksum cell (see TOE_CSUM_CELL_BITS) is written, the sum of that cell is
+ *   forwarded to [TXe], which then only sums the partial cells at the edges of
+ *   a segment spanning this cell. A cell is usually filled by several
+ *   messages and the partial sum of the cell being filled is kept per session
+ *   in PARTIAL_CELL_SUM. The bytes are weighted by the parity of their buffer
+ *   address, such that the sum of a cell does not depend on the alignment of
+ *   the messages. The sum of a message flagged for the DDR bypass is forwarded
+ *   to [TXe] along with its last chunk.
  *******************************************************************************/
 void pTxMemoryWriter(
         stream<TcpAppData>  &siTAIF_Data,
         stream<AppMemMeta>  &siSml_AppMeta,
         stream<DmCmd>       &soMEM_WrCmd,
-        stream<AxisApp>     &soMEM_WrData)
+        stream<AxisApp>     &soMEM_WrData,
+        stream<AxisApp>     &soTXe_Data,
+        stream<TxCellCsum>  &soTXe_CellCsum,
+        stream<Csum>        &soTXe_BypassCsum)
 {
     //-- DIRECTIVES FOR THIS PROCESS -------------------------------------------
     #pragma HLS INLINE off
@@ -575,117 +630,159 @@ void pTxMemoryWriter(
 
     const char *myName  = concat3(THIS_NAME, "/", "Mwr");
 
+    //-- STATIC ARRAYS ---------------------------------------------------------
+    static Csum                  PARTIAL_CELL_SUM[TOE_MAX_SESSIONS];
+    #pragma HLS DEPENDENCE variable=PARTIAL_CELL_SUM inter false
+
     //-- STATIC CONTROL VARIABLES (with RESET) ---------------------------------
     static enum FsmStates { MWR_IDLE=0,
-                            MWR_FWD_ALIGNED, MWR_SPLIT_1ST_CMD,
-                            MWR_FWD_1ST_BUF, MWR_FWD_2ND_BUF, MWR_RESIDUE } \
+                            MWR_FWD_ALIGNED, MWR_FWD_1ST_BUF,
+                            MWR_FWD_2ND_BUF, MWR_RESIDUE } \
                                  mwr_fsmState=MWR_IDLE;
     #pragma HLS RESET variable = mwr_fsmState
+    static bool                  mwr_2ndCmdPending=false;
+    #pragma HLS RESET variable = mwr_2ndCmdPending
+    static bool                  mwr_lastSumValid=false;
+    #pragma HLS RESET variable = mwr_lastSumValid
 
     //-- STATIC DATAFLOW VARIABLES ---------------------------------------------
     static AppMemMeta    mwr_appMemMeta;
     static DmCmd         mwr_memWrCmd;
+    static DmCmd         mwr_2ndMemWrCmd;  // The command of the 2nd buffer of a split message
     static AxisApp       mwr_currChunk;
     static TxBufPtr      mwr_firstAccLen;
     static TcpDatLen     mwr_nrBytesToWr;
     static ap_uint<4>    mwr_splitOffset;
     static uint16_t      mwr_debugCounter=1;
+    static CsumAcc       mwr_cellAcc;      // The partial sum of the current cell
+    static ap_uint<TOE_CSUM_CELL_BITS+1> mwr_cellRem;  // The bytes left to fill the current cell
+    static TxCellIdx     mwr_cellIdx;
+    static CsumAcc       mwr_msgAcc;       // The sum of the current message
+    static SessionId     mwr_lastSumSessId;  // The last entry written into PARTIAL_CELL_SUM
+    static Csum          mwr_lastSum;
 
     //-- DYNAMIC VARIABLES -----------------------------------------------------
-    static uint8_t       lengthBuffer;
-    static ap_uint<3>    accessResidue;
+    AxisApp              appChunk;
+    bool                 isAppChunk = false;
+    bool                 csumReady  = !soTXe_CellCsum.full() and !soTXe_BypassCsum.full();
 
-    switch (mwr_fsmState) {
-    case MWR_IDLE:
-        if (!siSml_AppMeta.empty() and !soMEM_WrCmd.full()) {
-            siSml_AppMeta.read(mwr_appMemMeta);
-            //-- Build a memory address for this segment
-            TxMemPtr memSegAddr = TOE_TX_MEMORY_BASE; // 0x40000000
-            memSegAddr(29, 16) = mwr_appMemMeta.sessId(13, 0);
-            memSegAddr(15,  0) = mwr_appMemMeta.addr;
-            // Build a data mover command for this segment
-            mwr_memWrCmd = DmCmd(memSegAddr, mwr_appMemMeta.len);
-            if ((mwr_memWrCmd.saddr(TOE_WINDOW_BITS-1, 0) + mwr_memWrCmd.btt) > TOE_TX_BUFFER_SIZE) {
-                // This segment must be broken in two memory accesses because TCP Tx memory buffer wraps around
-                if (DEBUG_LEVEL & TRACE_MWR) {
-                    printInfo(myName, "TCP Tx memory buffer wraps around: This segment must be broken in two memory accesses.\n");
-                }
-                mwr_fsmState = MWR_SPLIT_1ST_CMD;
-            }
-            else {
-                soMEM_WrCmd.write(mwr_memWrCmd);
-                mwr_firstAccLen = mwr_memWrCmd.btt;
-                mwr_nrBytesToWr = mwr_firstAccLen;
-                mwr_fsmState = MWR_FWD_ALIGNED;
-                if (DEBUG_LEVEL & TRACE_MWR) {
-                    printInfo(myName, "Issuing memory write command #%d - SADDR=0x%9.9x - BTT=%d\n",
-                              mwr_debugCounter, mwr_memWrCmd.saddr.to_uint(), mwr_memWrCmd.btt.to_uint());
-                    mwr_debugCounter++;
-                }
+    //-----------------------------------------------------
+    //-- COMMAND SIDE
+    //-----------------------------------------------------
+    if (mwr_2ndCmdPending) {
+        //-- Issue the command of the 2nd buffer while the 1st one is streamed
+        if (!soMEM_WrCmd.full()) {
+            soMEM_WrCmd.write(mwr_2ndMemWrCmd);
+            mwr_2ndCmdPending = false;
+            if (DEBUG_LEVEL & TRACE_MWR) {
+                printInfo(myName, "Issuing 2nd memory write command #%d - SADDR=0x%9.9x - BTT=%d\n",
+                          mwr_debugCounter, mwr_2ndMemWrCmd.saddr.to_uint(), mwr_2ndMemWrCmd.btt.to_uint());
+                mwr_debugCounter++;
             }
         }
-        break;
-    case MWR_SPLIT_1ST_CMD:
-        if (!soMEM_WrCmd.full()) {
-            mwr_firstAccLen   = TOE_TX_BUFFER_SIZE - mwr_memWrCmd.saddr;
-            mwr_nrBytesToWr   = mwr_firstAccLen;
+    }
+    else if ((mwr_fsmState == MWR_IDLE) and !siSml_AppMeta.empty() and !soMEM_WrCmd.full()) {
+        siSml_AppMeta.read(mwr_appMemMeta);
+        //-- Build a memory address for this segment
+        TxMemPtr memSegAddr = TOE_TX_MEMORY_BASE; // 0x40000000
+        memSegAddr(29, TOE_WINDOW_BITS) = mwr_appMemMeta.sessId(TOE_SESS_ADDR_BITS-1, 0);
+        memSegAddr(TOE_WINDOW_BITS-1, 0) = mwr_appMemMeta.addr;
+        // Resume the sum of the cell which this message starts to fill
+        TxBufPtr cellOffset = mwr_appMemMeta.addr(TOE_CSUM_CELL_BITS-1, 0);
+        mwr_cellRem = TOE_CSUM_CELL_SIZE - cellOffset;
+        mwr_cellIdx = mwr_appMemMeta.addr(TOE_WINDOW_BITS-1, TOE_CSUM_CELL_BITS);
+        if (cellOffset == 0) {
+            mwr_cellAcc = 0;
+        }
+        else if (mwr_lastSumValid and (mwr_lastSumSessId == mwr_appMemMeta.sessId)) {
+            mwr_cellAcc = mwr_lastSum;
+        }
+        else {
+            mwr_cellAcc = PARTIAL_CELL_SUM[mwr_appMemMeta.sessId];
+        }
+        mwr_msgAcc = 0;
+        // Build a data mover command for this segment
+        mwr_memWrCmd = DmCmd(memSegAddr, mwr_appMemMeta.len);
+        if (crossesPage(mwr_memWrCmd.saddr(TOE_WINDOW_BITS-1, 0), mwr_memWrCmd.btt)) {
+            // This segment must be broken in two memory accesses because TCP Tx memory buffer wraps around
+            // or because the segment crosses a page boundary
+            mwr_firstAccLen = TOE_PAGE_SIZE - mwr_memWrCmd.saddr(TOE_PAGE_BITS-1, 0);
+            mwr_nrBytesToWr = mwr_firstAccLen;
             soMEM_WrCmd.write(DmCmd(mwr_memWrCmd.saddr, mwr_firstAccLen));
+            // Prepare the command of the 2nd buffer
+            mwr_2ndMemWrCmd = mwr_memWrCmd;
+            mwr_2ndMemWrCmd.saddr(TOE_WINDOW_BITS-1, 0) = getNextPageAdr(mwr_memWrCmd.saddr(TOE_WINDOW_BITS-1, 0));
+            mwr_2ndMemWrCmd.btt = mwr_memWrCmd.btt - mwr_firstAccLen;
+            mwr_2ndCmdPending = true;
             if (DEBUG_LEVEL & TRACE_MWR) {
+                printInfo(myName, "TCP Tx memory buffer wraps around: This segment must be broken in two memory accesses.\n");
                 printInfo(myName, "Issuing 1st memory write command #%d - SADDR=0x%9.9x - BTT=%d\n",
                     mwr_debugCounter, mwr_memWrCmd.saddr.to_uint(), mwr_firstAccLen.to_uint());
             }
             mwr_fsmState = MWR_FWD_1ST_BUF;
         }
+        else {
+            soMEM_WrCmd.write(mwr_memWrCmd);
+            mwr_firstAccLen = mwr_memWrCmd.btt;
+            mwr_nrBytesToWr = mwr_firstAccLen;
+            if (DEBUG_LEVEL & TRACE_MWR) {
+                printInfo(myName, "Issuing memory write command #%d - SADDR=0x%9.9x - BTT=%d\n",
+                          mwr_debugCounter, mwr_memWrCmd.saddr.to_uint(), mwr_memWrCmd.btt.to_uint());
+                mwr_debugCounter++;
+            }
+            mwr_fsmState = MWR_FWD_ALIGNED;
+        }
+    }
+
+    //-----------------------------------------------------
+    //-- DATA SIDE
+    //-----------------------------------------------------
+    switch (mwr_fsmState) {
+    case MWR_IDLE:
+        //-- Wait for the command side to start a new message
         break;
     case MWR_FWD_ALIGNED:
-        if (!siTAIF_Data.empty() and !soMEM_WrData.full()) {
+        if (!siTAIF_Data.empty() and !soMEM_WrData.full() and csumReady and
+            (!mwr_appMemMeta.bypass or !soTXe_Data.full())) {
             //-- Default streaming state used to forward APP data or splitted
             //-- buffers that are aligned with to the Axis raw width.
             AxisApp memChunk = siTAIF_Data.read();
+            appChunk   = memChunk;
+            isAppChunk = true;
             soMEM_WrData.write(memChunk);
+            if (mwr_appMemMeta.bypass) {
+                soTXe_Data.write(memChunk);
+            }
             if (memChunk.getTLast()) {
                  mwr_fsmState = MWR_IDLE;
             }
          }
         break;
     case MWR_FWD_1ST_BUF:
-        if (!siTAIF_Data.empty() and !soMEM_WrData.full()) {
+        if (!siTAIF_Data.empty() and !soMEM_WrData.full() and csumReady) {
             //-- Create 1st splitted data buffer and stream it to memory
             siTAIF_Data.read(mwr_currChunk);
+            appChunk   = mwr_currChunk;
+            isAppChunk = true;
             AxisApp memChunk = mwr_currChunk;
             if (mwr_nrBytesToWr > (ARW/8)) {
                 mwr_nrBytesToWr -= (ARW/8);
             }
-            else if (!soMEM_WrCmd.full()) {
-                if (mwr_nrBytesToWr == (ARW/8)) {
-                    memChunk.setLE_TLast(TLAST);
-
-                    mwr_memWrCmd.saddr(TOE_WINDOW_BITS-1, 0) = 0;
-                    mwr_memWrCmd.btt -= mwr_firstAccLen;
-                    soMEM_WrCmd.write(mwr_memWrCmd);
-                    if (DEBUG_LEVEL & TRACE_MWR) {
-                        printInfo(myName, "Issuing 2nd memory write command #%d - SADDR=0x%9.9x - BTT=%d\n",
-                                  mwr_debugCounter, mwr_memWrCmd.saddr.to_uint(), mwr_memWrCmd.btt.to_uint());
-                        mwr_debugCounter++;
-                    }
-                    mwr_fsmState = MWR_FWD_ALIGNED;
+            else if (mwr_nrBytesToWr == (ARW/8)) {
+                memChunk.setLE_TLast(TLAST);
+                mwr_fsmState = MWR_FWD_ALIGNED;
+            }
+            else {
+                memChunk.setLE_TLast(TLAST);
+                memChunk.setLE_TKeep(lenToLE_tKeep(mwr_nrBytesToWr));
+                #ifndef __SYNTHESIS__
+                memChunk.setLE_TData(0, (ARW-1), ((int)mwr_nrBytesToWr*8));
+                #endif
+                mwr_splitOffset = (ARW/8) - mwr_nrBytesToWr;
+                if (mwr_currChunk.getLE_TLast()) {
+                    mwr_fsmState = MWR_RESIDUE;
                 }
                 else {
-                    memChunk.setLE_TLast(TLAST);
-                    memChunk.setLE_TKeep(lenToLE_tKeep(mwr_nrBytesToWr));
-                    #ifndef __SYNTHESIS__
-                    memChunk.setLE_TData(0, (ARW-1), ((int)mwr_nrBytesToWr*8));
-                    #endif
-
-                    mwr_memWrCmd.saddr(TOE_WINDOW_BITS-1, 0) = 0;
-                    mwr_memWrCmd.btt -= mwr_firstAccLen;
-                    soMEM_WrCmd.write(mwr_memWrCmd);
-                    if (DEBUG_LEVEL & TRACE_MWR) {
-                        printInfo(myName, "Issuing 2nd memory write command #%d - SADDR=0x%9.9x - BTT=%d\n",
-                                  mwr_debugCounter, mwr_memWrCmd.saddr.to_uint(), mwr_memWrCmd.btt.to_uint());
-                        mwr_debugCounter++;
-                    }
-                    mwr_splitOffset = (ARW/8) - mwr_nrBytesToWr;
                     mwr_fsmState = MWR_FWD_2ND_BUF;
                 }
             }
@@ -694,10 +791,12 @@ void pTxMemoryWriter(
         }
         break;
     case MWR_FWD_2ND_BUF:
-        if (!siTAIF_Data.empty() and !soMEM_WrData.full()) {
+        if (!siTAIF_Data.empty() and !soMEM_WrData.full() and csumReady) {
             //-- Alternate streaming state used to re-align a splitted second buffer
             AxisApp prevChunk = mwr_currChunk;
             mwr_currChunk = siTAIF_Data.read();
+            appChunk   = mwr_currChunk;
+            isAppChunk = true;
 
             AxisApp joinedChunk(0,0,0);  // [FIXME-Create a join method in AxisRaw]
             // Set lower-part of the joined chunk with the last bytes of the previous chunk
@@ -750,6 +849,50 @@ void pTxMemoryWriter(
         }
         break;
     } // End-of switch
+
+    //-----------------------------------------------------
+    //-- CHECKSUM SIDE
+    //-----------------------------------------------------
+    if (isAppChunk) {
+        ap_uint<4> chunkLen  = appChunk.getLen();
+        bool       endOfCell = (chunkLen >= mwr_cellRem);
+        // Split the chunk at the end of the current cell
+        LE_tKeep   headKeep  = (endOfCell) ? lenToLE_tKeep(mwr_cellRem(3, 0)) : (LE_tKeep)0xFF;
+        CsumAcc    headSum   = csumChunk<ARW>(AxisApp(appChunk.getLE_TData(), appChunk.getLE_TKeep() &  headKeep, 0));
+        CsumAcc    tailSum   = csumChunk<ARW>(AxisApp(appChunk.getLE_TData(), appChunk.getLE_TKeep() & ~headKeep, 0));
+        if (mwr_appMemMeta.addr[0] == 1) {
+            // The first byte of every chunk sits at an odd buffer address
+            headSum = byteSwap16(csumFold(headSum));
+            tailSum = byteSwap16(csumFold(tailSum));
+        }
+        CsumAcc cellAcc = csumAdd(mwr_cellAcc, headSum);
+        if (endOfCell) {
+            soTXe_CellCsum.write(TxCellCsum(mwr_appMemMeta.sessId, mwr_cellIdx, csumFold(cellAcc)));
+            if (DEBUG_LEVEL & TRACE_MWR) {
+                printInfo(myName, "Sum of cell #%d of session #%d = 0x%4.4X\n", mwr_cellIdx.to_uint(),
+                          mwr_appMemMeta.sessId.to_uint(), csumFold(cellAcc).to_uint());
+            }
+            cellAcc = tailSum;
+            mwr_cellIdx++;
+            mwr_cellRem = TOE_CSUM_CELL_SIZE - (chunkLen - mwr_cellRem);
+        }
+        else {
+            mwr_cellRem -= chunkLen;
+        }
+        mwr_cellAcc = cellAcc;
+        CsumAcc msgAcc = csumAccumulate<ARW>(mwr_msgAcc, appChunk);
+        mwr_msgAcc = msgAcc;
+        if (appChunk.getTLast()) {
+            // Keep the partial sum of the cell for the next message of this session
+            PARTIAL_CELL_SUM[mwr_appMemMeta.sessId] = csumFold(cellAcc);
+            mwr_lastSumSessId = mwr_appMemMeta.sessId;
+            mwr_lastSum       = csumFold(cellAcc);
+            mwr_lastSumValid  = true;
+            if (mwr_appMemMeta.bypass) {
+                soTXe_BypassCsum.write(csumFold(msgAcc));
+            }
+        }
+    }
 }
 
 /*******************************************************************************
@@ -764,6 +907,9 @@ void pTxMemoryWriter(
  * @param[out] soMEM_TxP_WrCmd       Tx memory write command to MEM.
  * @param[out] soMEM_TxP_Data        Tx memory data to MEM.
  * @param[in]  siMEM_TxP_WrSts       Tx memory write status from MEM.
+ * @param[out] soTXe_Data            APP data bypassing the DDR to TxEngine (TXe).
+ * @param[out] soTXe_CellCsum        Sum of a checksum cell of the Tx buffer to [TXe].
+ * @param[out] soTXe_BypassCsum      Sum of a message bypassing the DDR to [TXe].
  * @param[out] soSTt_SessStateReq    Session sate request to StateTable (STt).
  * @param[in]  siSTt_SessStateRep    Session state reply from [STt].
  * @param[out] soSTt_AcceptStateQry  Session state query to [STt].
@@ -777,6 +923,8 @@ void pTxMemoryWriter(
  * @param[in]  siRXe_ActSessState    TCP state of active session from [RXe].
  * @param[out] soEVe_Event           Event to EventEngine (EVe).
  * @param[in]  siTIm_Notif           Notification from Timers (TIm).
+ * @param[out] soPAl_RxRelease       Release of Rx buffer pages to PageAllocator (PAl).
+ * @param[out] soPAl_TxRelease       Release of Tx buffer pages to [PAl].
  * @param[in]  piMMIO_IpAddr         IPv4 address from [MMIO].
  *
  * @details
@@ -801,6 +949,10 @@ void tx_app_interface(
         stream<DmCmd>                  &soMEM_TxP_WrCmd,
         stream<AxisApp>                &soMEM_TxP_Data,
         stream<DmSts>                  &siMEM_TxP_WrSts,
+        //-- Tx Engine / DDR Bypass Interface
+        stream<AxisApp>                &soTXe_Data,
+        stream<TxCellCsum>             &soTXe_CellCsum,
+        stream<Csum>                   &soTXe_BypassCsum,
         //-- State Table Interfaces
         stream<SessionId>              &soSTt_SessStateReq,
         stream<TcpState>               &siSTt_SessStateRep,
@@ -821,6 +973,9 @@ void tx_app_interface(
         stream<Event>                  &soEVe_Event,
         //-- Timers Interface
         stream<SessState>              &siTIm_Notif,
+        //-- Page Allocator Interfaces
+        stream<PageRelease>            &soPAl_RxRelease,
+        stream<PageRelease>            &soPAl_TxRelease,
         //-- MMIO / IPv4 Address
         Ip4Addr                         piMMIO_IpAddr)
 {
@@ -891,7 +1046,10 @@ void tx_app_interface(
             siTAIF_Data,
             ssSmlToMwr_AppMeta,
             soMEM_TxP_WrCmd,
-            soMEM_TxP_Data);
+            soMEM_TxP_Data,
+            soTXe_Data,
+            soTXe_CellCsum,
+            soTXe_BypassCsum);
 
     // Tx Application Connect (Tac)
     pTxAppConnect(
@@ -913,7 +1071,9 @@ void tx_app_interface(
     pTxAppTable(
             siTSt_PushCmd,
             ssSmlToTat_AccessQry,
-            ssTatToSml_AccessRep);
+            ssTatToSml_AccessRep,
+            soPAl_RxRelease,
+            soPAl_TxRelease);
 }
 
 /*! \} */
@@ -95,7 +95,7 @@ class TxAppTableEntry {
     TcpAckNum       ackd;
     TxBufPtr        mempt;
     TxAppTableEntry() {}
-    TxAppTableEntry(TcpAckNum ackd, ap_uint<16> mempt) :
+    TxAppTableEntry(TcpAckNum ackd, TxBufPtr mempt) :
         ackd(ackd), mempt(mempt) {}
 };
 
@@ -107,9 +107,12 @@ class AppMemMeta {
     TcpSessId    sessId;
     TcpBufAdr    addr;
     TcpDatLen    len;
+    FlagBool     bypass;  // The data are also streamed to [TXe]
     AppMemMeta() {}
     AppMemMeta(TcpSessId sessId, TcpBufAdr addr, TcpDatLen len) :
-        sessId(sessId), addr(addr), len(len) {}
+        sessId(sessId), addr(addr), len(len), bypass(false) {}
+    AppMemMeta(TcpSessId sessId, TcpBufAdr addr, TcpDatLen len, FlagBool bypass) :
+        sessId(sessId), addr(addr), len(len), bypass(bypass) {}
 };
 
 /*******************************************************************************
@@ -130,6 +133,10 @@ void tx_app_interface(
         stream<DmCmd>                  &soMEM_TxP_WrCmd,
         stream<AxisApp>                &soMEM_TxP_Data,
         stream<DmSts>                  &siMEM_TxP_WrSts,
+        //-- Tx Engine / DDR Bypass Interface
+        stream<AxisApp>                &soTXe_Data,
+        stream<TxCellCsum>             &soTXe_CellCsum,
+        stream<Csum>                   &soTXe_BypassCsum,
         //-- State Table Interfaces
         stream<SessionId>              &soSTt_SessStateReq,
         stream<TcpState>               &siSTt_SessStateRep,
@@ -150,6 +157,9 @@ void tx_app_interface(
         stream<Event>                  &soEVe_Event,
         //-- Timers Interface
         stream<SessState>              &siTIm_Notif,
+        //-- Page Allocator Interfaces
+        stream<PageRelease>            &soPAl_RxRelease,
+        stream<PageRelease>            &soPAl_TxRelease,
         //-- MMIO / IPv4 Address
         LE_Ip4Addr                      piMMIO_IpAddr  // [FIXME]
 );
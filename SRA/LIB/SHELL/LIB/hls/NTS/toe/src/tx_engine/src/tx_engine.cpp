@@ -75,14 +75,153 @@ using namespace hls;
 #define TRACE_PHC 1 << 4
 #define TRACE_MRD 1 << 5
 #define TRACE_TSS 1 << 6
-#define TRACE_SCA 1 << 7
 #define TRACE_TCA 1 << 8
 #define TRACE_IPS 1 << 9
+#define TRACE_BDF 1 << 10
 #define TRACE_ALL 0xFFFF
 
 #define DEBUG_LEVEL (TRACE_OFF)
 
 
+#ifndef __SYNTHESIS__
+  //-- The number of data segments and of the reverse lookups (for the testbench only)
+  static unsigned int txeNrDataSegs   = 0;
+  static unsigned int txeNrRevLookups = 0;
+
+  /*****************************************************************************
+   * @brief Return the number of data segments sent by the Tx Engine and the
+   *         number of reverse lookups that it issued to [SLc].
+   *
+   * @param[out] nrDataSegs    The number of segments sent upon TX and RT events.
+   * @param[out] nrRevLookups  The number of reverse lookups issued for any segment.
+   *****************************************************************************/
+  void getTxEngineStats(unsigned int &nrDataSegs, unsigned int &nrRevLookups) {
+      nrDataSegs   = txeNrDataSegs;
+      nrRevLookups = txeNrRevLookups;
+  }
+#endif
+
+/*******************************************************************************
+ * @brief Request the socket pair of a session from the Socket Pair Splitter.
+ *
+ * @param[in]  sessId              The session ID.
+ * @param[in]  isCached            The socket pair of the session is cached by [Sps].
+ * @param[out] soSLc_ReverseLkpReq Reverse lookup request to Session Lookup Controller (SLc).
+ * @param[out] soSps_IsLookup      Tells the Socket Pair Splitter (Sps) where the socket pair comes from.
+ *
+ * @return true if a reverse lookup was issued to [SLc].
+ *******************************************************************************/
+bool requestSocketPair(
+        SessionId                sessId,
+        FlagBool                 isCached,
+        stream<SessionId>       &soSLc_ReverseLkpReq,
+        stream<SpsCmd>          &soSps_IsLookup)
+{
+    #pragma HLS INLINE
+
+    if (isCached) {
+        soSps_IsLookup.write(SpsCmd(SPS_CACHED, sessId));
+        return false;
+    }
+    else {
+        soSps_IsLookup.write(SpsCmd(SPS_LOOKUP, sessId));
+        soSLc_ReverseLkpReq.write(sessId);
+        #ifndef __SYNTHESIS__
+        txeNrRevLookups++;
+        #endif
+        return true;
+    }
+}
+
+/*******************************************************************************
+ * @brief Sets up the memory reads and the checksum of a payload read from DDR.
+ *
+ * @param[in]  memSegAddr  The memory address of the first byte of the payload.
+ * @param[in]  len         The length of the payload.
+ * @param[in]  sessId      The session ID of the payload.
+ * @param[in]  isChained   The previous payload ended with a tail read at the
+ *                          address of this payload.
+ * @param[out] tcaCmd      The command of the TcpChecksumAccumulator (Tca).
+ * @param[out] rdCmds      The memory read commands, in their order of issue.
+ * @return the number of memory read commands.
+ *
+ * @details
+ *  A payload which spans at least one whole checksum cell (see TOE_CSUM_CELL_BITS)
+ *   gets the sums of its whole cells from [Tca], and only the bytes in front of
+ *   the first cell (the head) and after the last cell (the tail) remain to be
+ *   summed. Therefore, the payload is read as up to three pieces: the head, the
+ *   tail and then the body in between. The head and the tail are rounded to
+ *   whole chunks towards the body, such that the three pieces are joined back
+ *   without any re-alignment. [Tca] sums and holds the head and the tail until
+ *   the checksum is known, while the body streams through. Every byte is read
+ *   once from DDR.
+ *  The head is not read when the previous payload ended with a tail in the same
+ *   cell, because [Tca] derives its sum from the sum of that cell minus the sum
+ *   of that tail (RFC-1624). This is the case of the segments of a burst.
+ *  A payload which does not span a whole cell is read at once and is stored
+ *   by [Tca] until it is summed. Such a payload is shorter than two cells.
+ *******************************************************************************/
+PayRdCnt setPayloadReads(
+        TxMemPtr    memSegAddr,
+        TcpDatLen   len,
+        SessionId   sessId,
+        bool        isChained,
+        TcaCmd     &tcaCmd,
+        DmCmd       rdCmds[3])
+{
+    #pragma HLS INLINE
+
+    TxBufPtr  bufAdr  = memSegAddr(TOE_WINDOW_BITS-1, 0);
+    TxBufPtr  endAdr  = bufAdr + len;
+    TxBufPtr  cellAdr;
+    TxCellOff headOff = bufAdr(TOE_CSUM_CELL_BITS-1, 0);
+    TcpDatLen headLen = (headOff == 0) ? (TcpDatLen)0 : (TcpDatLen)(TOE_CSUM_CELL_SIZE - headOff);
+    TcpDatLen tailLen = endAdr(TOE_CSUM_CELL_BITS-1, 0);
+    TxMemPtr  pieceAdr = memSegAddr;
+    PayRdCnt  nrRdCmds = 0;
+
+    tcaCmd.sessId   = sessId;
+    tcaCmd.isOddAdr = bufAdr[0];
+    if ((headLen + tailLen + TOE_CSUM_CELL_SIZE) <= len) {
+        //-- The payload spans at least one whole cell
+        TcpDatLen headRdLen  = (headLen + 7) & ~0x7;
+        TcpDatLen tailRdOff  = (len - tailLen) & ~0x7;
+        TcpDatLen bodyRdOff  = 0;
+        TcpDatLen bodyEndOff = (tailLen != 0) ? tailRdOff : len;
+        isChained = isChained and (headLen != 0);
+        tcaCmd.src      = PAY_SRC_CELLS;
+        cellAdr = (isChained) ? (TxBufPtr)bufAdr : (TxBufPtr)(bufAdr + headLen);
+        tcaCmd.cellIdx  = cellAdr(TOE_WINDOW_BITS-1, TOE_CSUM_CELL_BITS);
+        tcaCmd.nrCells  = ((len - headLen - tailLen) >> TOE_CSUM_CELL_BITS) + isChained;
+        tcaCmd.headLen  = (isChained) ? (TcpDatLen)0 : headLen;
+        tcaCmd.tailSkip = (len - tailLen) - tailRdOff;
+        tcaCmd.hasTail  = (tailLen != 0);
+        tcaCmd.isChained = isChained;
+        if ((headLen != 0) and !isChained) {
+            rdCmds[nrRdCmds++] = DmCmd(memSegAddr, headRdLen);
+            bodyRdOff = headRdLen;
+        }
+        if (tailLen != 0) {
+            pieceAdr(TOE_WINDOW_BITS-1, 0) = bufAdr + tailRdOff;
+            rdCmds[nrRdCmds++] = DmCmd(pieceAdr, len - tailRdOff);
+        }
+        pieceAdr(TOE_WINDOW_BITS-1, 0) = bufAdr + bodyRdOff;
+        rdCmds[nrRdCmds++] = DmCmd(pieceAdr, bodyEndOff - bodyRdOff);
+    }
+    else {
+        //-- The payload is shorter than two cells
+        tcaCmd.src      = PAY_SRC_STORE;
+        tcaCmd.cellIdx  = 0;
+        tcaCmd.nrCells  = 0;
+        tcaCmd.headLen  = 0;
+        tcaCmd.tailSkip = 0;
+        tcaCmd.hasTail  = false;
+        tcaCmd.isChained = false;
+        rdCmds[nrRdCmds++] = DmCmd(memSegAddr, len);
+    }
+    return nrRdCmds;
+}
+
 /*******************************************************************************
  * @brief Meta Data Loader (Mdl)
  *
@@ -93,12 +232,15 @@ using namespace hls;
  * @param[in]  siTSt_TxSarRep,     TxSar reply from [TSt].
  * @param[out] soTIm_ReTxTimerCmd  Send retransmit timer command to Timers (TIm).
  * @param[out] soTIm_SetProbeTimer Set a probe timer to [TIm].
- * @param[out] soIhc_TcpDatLen     TCP data length to Ip Header Constructor (Ihc).
+ * @param[out] soIhc_Meta          IPv4 header metadata to Ip Header Constructor (Ihc).
  * @param[out] soPhc_TxeMeta       Tx Engine metadata to Pseudo Header Constructor (Phc).
  * @param[out] soMrd_BufferRdCmd   Buffer read command to Memory Reader (Mrd).
  * @param[out] soSLc_ReverseLkpReq Reverse lookup request to Session Lookup Controller (SLc).
- * @param[out] soSps_IsLookup      Tells the Socket Pair Splitter (Sps) that a reverse lookup is to be expected.
- * @param[out] soTODO_IsDdrBypass  [TODO]
+ * @param[out] soSps_IsLookup      Tells the Socket Pair Splitter (Sps) where the socket pair comes from.
+ * @param[out] soTss_PayRdCnt      Tells the Tcp Segment Stitcher (Tss) how many memory reads make the payload of a segment.
+ * @param[out] soTca_CsumCmd       Tells the Tcp Checksum Accumulator (Tca) where the payload checksum comes from.
+ * @param[out] soBdf_KeepData      Tells the Bypass Data Filter (Bdf) to keep or drop the data of a bypass event.
+ * @param[out] soBdf_KeepCsum      Tells the [Bdf] to keep or drop the checksum of a bypass event.
  * @param[out] soSps_RstSockPair   Tells the [Sps] about the socket pair to reset.
  * @param[out] soEVe_RxEventSig    Signals the reception of an event to EventEngine (EVe).
  *
@@ -112,6 +254,49 @@ using namespace hls;
  *  (RXe) and it does not have to be loaded from the SLc. The 'isLookUpFifo'
  *  indicates this special cases.
  * Depending on the Event Type the retransmit or/and probe Timer is set.
+ * The SACK option (RFC-2018) is offered on every SYN and echoed on a SYN-ACK.
+ *  Once permitted, pure ACKs report the out-of-order blocks of the Rx SAR
+ *  table, and a retransmission skips the blocks SACKed by the peer.
+ * Similarly, the Window Scale option (RFC-7323) is offered on every SYN and
+ *  echoed on a SYN-ACK. Once negotiated, the advertised window is right-shifted
+ *  by TOE_WINDOW_SCALE.
+ * When TOE_ECN is enabled, ECN (RFC-3168) is requested by setting ECE and CWR
+ *  on every SYN, and accepted by setting ECE on the SYN-ACK. Once negotiated,
+ *  the new data segments are sent as ECN-capable (ECT) while the ACKs, the
+ *  retransmissions and the control segments are not. The ECE flag is set as
+ *  long as [RXe] reports a pending CE echo, and the CWR flag is set on the
+ *  first new data segment sent after the congestion window was reduced upon
+ *  an ECN-Echo. A stateless SYN-ACK never accepts ECN.
+ * A 'TX_BYPASS_EVENT' carries a message which is streamed by the TxAppInterface
+ *  (TAi) into the Bypass Data Filter (Bdf) while it is still being written into
+ *  DDR. If all the older data of the session were sent and if the message fits
+ *  into the usable window, the message is sent right away as a single segment
+ *  and [Tss] takes its payload from [Bdf] instead of [MEM]. Otherwise, the
+ *  bypass copy is dropped and the message will be sent out of the DDR buffer
+ *  upon the 'TX_EVENT' which [TAi] issues once the memory write completed.
+ * A 'TX_EVENT' is processed as a segmentation offload (TSO): the data up to the
+ *  'app' pointer are sent as a burst of back-to-back MSS segments, one per cycle.
+ *  The SAR tables are read once per burst and the sequence number of every next
+ *  segment is derived from the previous one. The socket pair is fetched and
+ *  the retransmission timer is armed upon the first segment only, while [Sps]
+ *  reuses the socket pair of the previous segment for the next ones.
+ * The payload of a segment read from DDR is read as up to three pieces, such
+ *  that its checksum is built from the sums of the checksum cells of the Tx
+ *  buffer and from the partial sums of its head and tail (see 'setPayloadReads()').
+ *  The first read command is issued along with the segment and the others upon
+ *  the next cycles.
+ * The socket pair of a session is cached by [Sps] after its first reverse
+ *  lookup, such that the steady-state traffic of a session does not access
+ *  [SLc] anymore. The SYN, SYN_ACK and RST segments always look the socket
+ *  pair up because they start (or end) the life of a session ID. Therefore,
+ *  the cache does not need to be cleared upon reset.
+ * A 'SYN_COOKIE_EVENT' without session ID requests a stateless SYN_ACK. Its
+ *  sequence number is the SYN cookie of the event, and its socket pair is
+ *  passed to [Sps] like the one of a stateless RST. No SAR table is read nor
+ *  written and no timer is set (the peer retransmits its SYN). A
+ *  'SYN_COOKIE_EVENT' with a session ID tells that such a SYN_ACK was ACKed
+ *  and opened a session. Nothing is sent, but the socket pair cached for the
+ *  former owner of that session ID is forgotten.
  *
  *******************************************************************************/
 void pMetaDataLoader(
@@ -122,14 +307,15 @@ void pMetaDataLoader(
         stream<TXeTxSarReply>           &siTSt_TxSarRep,
         stream<TXeReTransTimerCmd>      &soTIm_ReTxTimerCmd,
         stream<SessionId>               &soTIm_SetProbeTimer,
-        stream<TcpDatLen>               &soIhc_TcpDatLen,
+        stream<IhcMeta>                 &soIhc_Meta,
         stream<TXeMeta>                 &soPhc_TxeMeta,
         stream<DmCmd>                   &soMrd_BufferRdCmd,
         stream<SessionId>               &soSLc_ReverseLkpReq,
-        stream<StsBool>                 &soSps_IsLookup,
-#if (TCP_NODELAY)
-        stream<bool>                    &soTODO_IsDdrBypass,
-#endif
+        stream<SpsCmd>                  &soSps_IsLookup,
+        stream<PayRdCnt>                &soTss_PayRdCnt,
+        stream<TcaCmd>                  &soTca_CsumCmd,
+        stream<FlagBool>                &soBdf_KeepData,
+        stream<FlagBool>                &soBdf_KeepCsum,
         stream<LE_SocketPair>           &soSps_RstSockPair,
         stream<SigBit>                  &soEVe_RxEventSig)
 {
@@ -139,14 +325,19 @@ void pMetaDataLoader(
 
     const char *myName  = concat3(THIS_NAME, "/", "Mdl");
 
+    //-- STATIC ARRAYS ---------------------------------------------------------
+    static FlagBool              SOCK_PAIR_CACHED[TOE_MAX_SESSIONS];  // The socket pair is cached by [Sps]
+
     //-- STATIC CONTROL VARIABLES (with RESET) ---------------------------------
-    static enum FsmStates { MDL_WAIT_EVENT=0, MDL_PROCESS_EVENT } \
+    static enum FsmStates { MDL_WAIT_EVENT=0, MDL_PROCESS_EVENT, MDL_NEXT_RD_CMD } \
                                  mdl_fsmState=MDL_WAIT_EVENT;
     #pragma HLS RESET   variable=mdl_fsmState
     static FlagBool              mdl_sarLoaded=false;
     #pragma HLS RESET   variable=mdl_sarLoaded
-    static ap_uint<2>            mdl_segmentCount=0;  // [FIXME - Too small for re-transmit?]
+    static TsoSegCnt             mdl_segmentCount=0;  // The segments sent upon the current event
     #pragma HLS RESET   variable=mdl_segmentCount
+    static FlagBool              mdl_tailValid=false; // The last payload read from DDR ended with a tail read
+    #pragma HLS RESET   variable=mdl_tailValid
 
     //-- STATIC DATAFLOW VARIABLES ---------------------------------------------
     static ExtendedEvent  mdl_curEvent;
@@ -154,13 +345,34 @@ void pMetaDataLoader(
     static TXeTxSarReply  mdl_txSar;
     static ap_uint<32>    mdl_randomValue = 100000; // [FIXME - Add a random Initial Sequence Number in EMIF]
     static TXeMeta        mdl_txeMeta;
+    static FlagBool       mdl_pairCached;
+    static FlagBool       mdl_cwrSent;  // A segment of the current event was sent with CWR
+    static DmCmd          mdl_rdCmds[2];  // The pending read commands of the current payload
+    #pragma HLS ARRAY_PARTITION variable=mdl_rdCmds complete dim=1
+    static PayRdCnt       mdl_nrRdCmds;   // The number of pending read commands
+    static FlagBool       mdl_resumeEvent;  // Resume the current event after the pending read commands
+    static SessionId      mdl_tailSessId;   // The session of the last tail read
+    static TxBufPtr       mdl_tailEndAdr;   // The end address of the last tail read
 
     //-- DYNAMIC VARIABLES -----------------------------------------------------
-    TcpWindow             winSize;
-    TcpWindow             usableWindow;
-    TcpDatLen             currDatLen;
-    ap_uint<16>           slowstart_threshold;
+    TcpWinSize            winSize;
+    TcpWinSize            usableWindow;
+    TxBufPtr              currDatLen;
+    FlagBool              isBypass;
+    TcaCmd                tcaCmd;
+    DmCmd                 rdCmds[3];
+    PayRdCnt              nrRdCmds;
+    bool                  isChained;
+    LocalWinSize          slowstart_threshold;
     rstEvent              resetEvent;
+    SynCookieEvent        cookieEvent;
+    bool                  sackSkip;
+    TxAckNum              sackRight;
+    ap_uint<32>           sackHole;
+    FlagBool              isFirstSeg = (mdl_segmentCount == 0);
+    bool                  isLookup = false;
+    bool                  isForget = false;
+    bool                  wrTxSar = false;
 
     switch (mdl_fsmState) {
     case MDL_WAIT_EVENT:
@@ -171,6 +383,14 @@ void pMetaDataLoader(
                           getEventName(mdl_curEvent.type), mdl_curEvent.sessionID.to_uint());
             }
             mdl_sarLoaded = false;
+            mdl_pairCached = ((mdl_curEvent.type == SYN_EVENT) or (mdl_curEvent.type == SYN_ACK_EVENT) or
+                              (mdl_curEvent.type == RST_EVENT)) ? false : SOCK_PAIR_CACHED[mdl_curEvent.sessionID];
+            mdl_txeMeta.sackOk  = false;
+            mdl_txeMeta.sackCnt = 0;
+            mdl_txeMeta.winScaleOk = false;
+            mdl_txeMeta.ece = 0;
+            mdl_txeMeta.cwr = 0;
+            mdl_cwrSent = false;
             assessSize(myName, soEVe_RxEventSig, "soEVe_RxEventSig", 2); // [FIXME-Use constant for the length]
             soEVe_RxEventSig.write(1);
 
@@ -178,6 +398,7 @@ void pMetaDataLoader(
             switch(mdl_curEvent.type) {
             case RT_EVENT:
             case TX_EVENT:
+            case TX_BYPASS_EVENT:
             case SYN_ACK_EVENT:
             case FIN_EVENT:
             case ACK_EVENT:
@@ -210,57 +431,17 @@ void pMetaDataLoader(
         }
         mdl_segmentCount = 0;
         break;
+    case MDL_NEXT_RD_CMD:
+        //-- Issue the pending read commands of the current payload
+        soMrd_BufferRdCmd.write(mdl_rdCmds[0]);
+        mdl_rdCmds[0] = mdl_rdCmds[1];
+        mdl_nrRdCmds--;
+        if (mdl_nrRdCmds == 0) {
+            mdl_fsmState = (mdl_resumeEvent) ? MDL_PROCESS_EVENT : MDL_WAIT_EVENT;
+        }
+        break;
     case MDL_PROCESS_EVENT:
         switch(mdl_curEvent.type) {
-        // When Nagle's algorithm disabled; Can bypass DDR
-#if (TCP_NODELAY)
-        case TX:
-            if (DEBUG_LEVEL & TRACE_MDL)
-                printInfo(myName, "Got TX event.\n");
-            if ((!rxSar2txEng_rsp.empty() && !txSar2txEng_upd_rsp.empty()) || ml_sarLoaded) {
-                if (!ml_sarLoaded) {
-                    rxSar2txEng_rsp.read(rxSar);
-                    txSar2txEng_upd_rsp.read(mdl_txSar);
-                }
-
-                // Compute our space, Advertise at least a quarter/half, otherwise 0
-                winSize = (rxSar.appd - ((ap_uint<16>)rxSar.recvd)) - 1; // This works even for wrap around
-                meta.ackNumb = rxSar.recvd;
-                meta.seqNumb = mdl_txSar.not_ackd;
-                meta.window_size = winSize;
-                meta.ack = 1; // ACK is always set when established
-                meta.rst = 0;
-                meta.syn = 0;
-                meta.fin = 0;
-
-                //TODO this is hack, makes sure that probeTimer is never set.
-                if (0x7FFF < ml_curEvent.length) {
-                    txEng2timer_setProbeTimer.write(ml_curEvent.sessionID);
-                }
-
-                meta.length = ml_curEvent.length;
-
-                // TODO some checking
-                mdl_txSar.not_ackd += ml_curEvent.length;
-
-                txEng2txSar_upd_req.write(txTxSarQuery(ml_curEvent.sessionID, mdl_txSar.not_ackd, 1));
-                ml_FsmState = 0;
-
-                // Send a packet only if there is data or we want to send an empty probing message
-                if (meta.length != 0) { // || ml_curEvent.retransmit) //TODO retransmit boolean currently not set, should be removed
-                    txEng_ipMetaFifoOut.write(meta.length);
-                    txEng_tcpMetaFifoOut.write(meta);
-                    txEng_isLookUpFifoOut.write(true);
-                    txEng_isDDRbypass.write(true);
-                    txEng2sLookup_rev_req.write(ml_curEvent.sessionID);
-
-                    // Only set RT timer if we actually send sth, TODO only set if we change state and sent sth
-                    txEng2timer_setRetransmitTimer.write(txRetransmitTimerSet(ml_curEvent.sessionID));
-                } //TODO if probe send msg length 1
-                ml_sarLoaded = true;
-            }
-            break;
-#else
         case TX_EVENT:
             if (DEBUG_LEVEL & TRACE_MDL) {
                 printInfo(myName, "Entering the 'TX' processing.\n");
@@ -276,13 +457,20 @@ void pMetaDataLoader(
                 winSize = ((mdl_rxSar.appd - (RxBufPtr)mdl_rxSar.oooHead(TOE_WINDOW_BITS-1, 0)) - 1);
                 mdl_txeMeta.ackNumb = mdl_rxSar.rcvd;
                 mdl_txeMeta.seqNumb = mdl_txSar.not_ackd;
-                mdl_txeMeta.winSize = winSize;
+                mdl_txeMeta.winSize = scaleDownWindow(winSize, mdl_rxSar.winScaleOk);
                 mdl_txeMeta.ack = 1; // ACK is always set when ESTABISHED
                 mdl_txeMeta.rst = 0;
                 mdl_txeMeta.syn = 0;
                 mdl_txeMeta.fin = 0;
+                mdl_txeMeta.ece = mdl_rxSar.ecnOk and mdl_rxSar.ceEcho;
+                mdl_txeMeta.cwr = 0;
                 mdl_txeMeta.length = 0;
                 currDatLen = (mdl_txSar.app - ((TxBufPtr)mdl_txSar.not_ackd));
+                if ((TxBufPtr)(mdl_txSar.app - (TxBufPtr)mdl_txSar.ackd) <
+                    (TxBufPtr)((TxBufPtr)mdl_txSar.not_ackd - (TxBufPtr)mdl_txSar.ackd)) {
+                    // A bypassed message was sent before its 'app' pointer was pushed by [TAi]
+                    currDatLen = 0;
+                }
 
                 TxBufPtr usedLength = ((TxBufPtr)mdl_txSar.not_ackd - mdl_txSar.ackd);
                 if (mdl_txSar.min_window > usedLength) {
@@ -294,10 +482,10 @@ void pMetaDataLoader(
                 }
 
                 // Construct address before modifying mdl_txSar.not_ackd
-                //  FYI - The TCP Tx buffers use up to 1GB (16Kx64KB). They are located at base@+1GB
+                //  FYI - The TCP Tx buffers use up to 1GB (4Kx256KB). They are located at base@+1GB
                 TxMemPtr memSegAddr = TOE_TX_MEMORY_BASE;
-                memSegAddr(29, 16) = mdl_curEvent.sessionID(13, 0);
-                memSegAddr(15,  0) = mdl_txSar.not_ackd(15, 0);
+                memSegAddr(29, TOE_WINDOW_BITS) = mdl_curEvent.sessionID(TOE_SESS_ADDR_BITS-1, 0);
+                memSegAddr(TOE_WINDOW_BITS-1, 0) = mdl_txSar.not_ackd(TOE_WINDOW_BITS-1, 0);
 
                 // Check if length is bigger than Usable Window or MSS
                 if (currDatLen <= usableWindow) {
@@ -319,8 +507,7 @@ void pMetaDataLoader(
                             mdl_fsmState = MDL_WAIT_EVENT;
                         }
                         // Write back 'txSar.not_ackd' pointer
-                        soTSt_TxSarQry.write(TXeTxSarQuery(mdl_curEvent.sessionID,
-                                                           mdl_txSar.not_ackd, QUERY_WR));
+                        wrTxSar = true;
                     }
                 }
                 else {
@@ -339,29 +526,113 @@ void pMetaDataLoader(
                         //OBSO }
                         //OBSO // Set probe Timer to try again later
                         //OBSO soTIm_SetProbeTimer.write(mdl_curEvent.sessionID);
-                        soTSt_TxSarQry.write(TXeTxSarQuery(mdl_curEvent.sessionID,
-                                                           mdl_txSar.not_ackd, QUERY_WR));
+                        wrTxSar = true;
                         mdl_fsmState = MDL_WAIT_EVENT;
                     }
                 }
 
                 if (mdl_txeMeta.length != 0) {
-                    soMrd_BufferRdCmd.write(DmCmd(memSegAddr, mdl_txeMeta.length));
+                    // Signal the window reduction with the first new data segment
+                    mdl_txeMeta.cwr = mdl_txSar.cwrPending;
+                    mdl_cwrSent = mdl_cwrSent or mdl_txSar.cwrPending;
+                    mdl_txSar.cwrPending = false;
+                }
+                if (wrTxSar) {
+                    TXeTxSarQuery txSarQry(mdl_curEvent.sessionID, mdl_txSar.not_ackd, QUERY_WR);
+                    txSarQry.cwrSent = mdl_cwrSent;
+                    soTSt_TxSarQry.write(txSarQry);
                 }
                 // Send a packet only if there is data or we want to send an empty probing message
                 if (mdl_txeMeta.length != 0) { // || mdl_curEvent.retransmit) //TODO retransmit boolean currently not set, should be removed
-                    soIhc_TcpDatLen.write(mdl_txeMeta.length);
+                    soIhc_Meta.write(IhcMeta(mdl_txeMeta.length, mdl_rxSar.ecnOk));
                     soPhc_TxeMeta.write(mdl_txeMeta);
-                    soSps_IsLookup.write(true);
-                    soSLc_ReverseLkpReq.write(mdl_curEvent.sessionID);
-                    // Only set RT timer if we actually send sth,
-                    // [TODO - Only set if we change state and sent sth]
-                    soTIm_ReTxTimerCmd.write(TXeReTransTimerCmd(mdl_curEvent.sessionID));
+                    isChained = mdl_tailValid and (mdl_tailSessId == mdl_curEvent.sessionID) and
+                                (mdl_tailEndAdr == memSegAddr(TOE_WINDOW_BITS-1, 0));
+                    nrRdCmds  = setPayloadReads(memSegAddr, mdl_txeMeta.length, mdl_curEvent.sessionID,
+                                                isChained, tcaCmd, rdCmds);
+                    soMrd_BufferRdCmd.write(rdCmds[0]);
+                    soTss_PayRdCnt.write(nrRdCmds);
+                    soTca_CsumCmd.write(tcaCmd);
+                    mdl_tailValid  = (tcaCmd.src == PAY_SRC_CELLS) and tcaCmd.hasTail;
+                    mdl_tailSessId = mdl_curEvent.sessionID;
+                    mdl_tailEndAdr = memSegAddr(TOE_WINDOW_BITS-1, 0) + mdl_txeMeta.length;
+                    if (nrRdCmds > 1) {
+                        mdl_rdCmds[0] = rdCmds[1];
+                        mdl_rdCmds[1] = rdCmds[2];
+                        mdl_nrRdCmds  = nrRdCmds - 1;
+                        mdl_resumeEvent = (mdl_fsmState == MDL_PROCESS_EVENT);
+                        mdl_fsmState = MDL_NEXT_RD_CMD;
+                    }
+                    if (isFirstSeg) {
+                        isLookup = requestSocketPair(mdl_curEvent.sessionID, mdl_pairCached,
+                                                     soSLc_ReverseLkpReq, soSps_IsLookup);
+                        // Only set RT timer if we actually send sth,
+                        // [TODO - Only set if we change state and sent sth]
+                        soTIm_ReTxTimerCmd.write(TXeReTransTimerCmd(mdl_curEvent.sessionID, RT_EVENT, mdl_txSar.rto));
+                    }
+                    else {
+                        soSps_IsLookup.write(SpsCmd(SPS_REUSE));
+                    }
+                    mdl_segmentCount++;
+                    #ifndef __SYNTHESIS__
+                    txeNrDataSegs++;
+                    #endif
                 } // [TODO - if probe send msg length 1]
                 mdl_sarLoaded = true;
             }
             break;
-#endif
+        case TX_BYPASS_EVENT:
+            if (DEBUG_LEVEL & TRACE_MDL) {
+                printInfo(myName, "Entering the 'TX_BYPASS' processing.\n");
+            }
+            if (!siRSt_RxSarRep.empty() and !siTSt_TxSarRep.empty()) {
+                siRSt_RxSarRep.read(mdl_rxSar);
+                siTSt_TxSarRep.read(mdl_txSar);
+                TxBufPtr usedLength = ((TxBufPtr)mdl_txSar.not_ackd - mdl_txSar.ackd);
+                if (mdl_txSar.min_window > usedLength) {
+                    usableWindow = mdl_txSar.min_window - usedLength;
+                }
+                else {
+                    usableWindow = 0;
+                }
+                // Bypass the DDR only if this message is next in line and can go out at once
+                isBypass = (((TxBufPtr)mdl_txSar.not_ackd == mdl_curEvent.address) and
+                            (mdl_curEvent.length <= usableWindow) and !mdl_txSar.finReady);
+                soBdf_KeepData.write(isBypass);
+                soBdf_KeepCsum.write(isBypass);
+                if (isBypass) {
+                    winSize = ((mdl_rxSar.appd - (RxBufPtr)mdl_rxSar.oooHead(TOE_WINDOW_BITS-1, 0)) - 1);
+                    mdl_txeMeta.ackNumb = mdl_rxSar.rcvd;
+                    mdl_txeMeta.seqNumb = mdl_txSar.not_ackd;
+                    mdl_txeMeta.winSize = scaleDownWindow(winSize, mdl_rxSar.winScaleOk);
+                    mdl_txeMeta.ack = 1; // ACK is always set when ESTABISHED
+                    mdl_txeMeta.rst = 0;
+                    mdl_txeMeta.syn = 0;
+                    mdl_txeMeta.fin = 0;
+                    mdl_txeMeta.ece = mdl_rxSar.ecnOk and mdl_rxSar.ceEcho;
+                    mdl_txeMeta.cwr = mdl_txSar.cwrPending;
+                    mdl_txeMeta.length = mdl_curEvent.length;
+                    // Write back 'txSar.not_ackd' pointer
+                    mdl_txSar.not_ackd += mdl_curEvent.length;
+                    TXeTxSarQuery txSarQry(mdl_curEvent.sessionID, mdl_txSar.not_ackd, QUERY_WR);
+                    txSarQry.cwrSent = mdl_txSar.cwrPending;
+                    soTSt_TxSarQry.write(txSarQry);
+                    soIhc_Meta.write(IhcMeta(mdl_txeMeta.length, mdl_rxSar.ecnOk));
+                    soPhc_TxeMeta.write(mdl_txeMeta);
+                    isLookup = requestSocketPair(mdl_curEvent.sessionID, mdl_pairCached,
+                                                 soSLc_ReverseLkpReq, soSps_IsLookup);
+                    soTss_PayRdCnt.write(0);
+                    soTca_CsumCmd.write(TcaCmd(PAY_SRC_BYPASS));
+                    mdl_tailValid = false;
+                    soTIm_ReTxTimerCmd.write(TXeReTransTimerCmd(mdl_curEvent.sessionID, RT_EVENT, mdl_txSar.rto));
+                }
+                else if (DEBUG_LEVEL & TRACE_MDL) {
+                    printInfo(myName, "Session #%d cannot bypass the DDR. Message will be sent upon next 'TX' event.\n",
+                              mdl_curEvent.sessionID.to_uint());
+                }
+                mdl_fsmState = MDL_WAIT_EVENT;
+            }
+            break;
         case RT_EVENT:
             if (DEBUG_LEVEL & TRACE_MDL) { printInfo(myName, "Entering the 'RT' processing.\n"); }
             if ((!siRSt_RxSarRep.empty() && !siTSt_TxSarRep.empty()) || mdl_sarLoaded) {
@@ -376,18 +647,6 @@ void pMetaDataLoader(
                     currDatLen = ((TxBufPtr) mdl_txSar.not_ackd - mdl_txSar.ackd);
                 else // FIN already sent
                     currDatLen = ((TxBufPtr) mdl_txSar.not_ackd - mdl_txSar.ackd)-1;
-                mdl_txeMeta.ackNumb = mdl_rxSar.rcvd;
-                mdl_txeMeta.seqNumb = mdl_txSar.ackd;
-                mdl_txeMeta.winSize = winSize;
-                mdl_txeMeta.ack = 1; // ACK is always set when session is established
-                mdl_txeMeta.rst = 0;
-                mdl_txeMeta.syn = 0;
-                mdl_txeMeta.fin = 0;
-                // Construct address before modifying 'mdl_txSar.ackd'
-                TxMemPtr memSegAddr;  // 0x40000000
-                memSegAddr(31, 30) = 0x01;
-                memSegAddr(29, 16) = mdl_curEvent.sessionID(13, 0);
-                memSegAddr(15,  0) = mdl_txSar.ackd(15, 0); // mdl_curEvent.address;
                 // Decrease Slow Start Threshold, only on first RT from retransmitTimer
                 if (!mdl_sarLoaded and (mdl_curEvent.rt_count == 1)) {
                     if (currDatLen > (4*ZYC2_MSS)) { // max(FlightSize/2, 2*MSS) RFC:5681
@@ -398,20 +657,68 @@ void pMetaDataLoader(
                     }
                     soTSt_TxSarQry.write(TXeTxSarRtQuery(mdl_curEvent.sessionID, slowstart_threshold));
                 }
+                mdl_sarLoaded = true;
+
+                // Look up the SACK scoreboard (RFC-2018). If 'txSar.ackd' falls
+                //  into a SACKed block, skip that block and send nothing during
+                //  this cycle. Otherwise, find the distance to the next SACKed
+                //  block so that the retransmitted segment stops in front of it.
+                sackSkip  = false;
+                sackRight = 0;
+                sackHole  = 0xFFFFFFFF;
+                for (int i=0; i<TOE_SACK_BLOCKS; ++i) {
+                #pragma HLS UNROLL
+                    if (i < mdl_txSar.sackCnt) {
+                        ap_uint<32> leftOff  = mdl_txSar.sackBlk[i].left  - mdl_txSar.ackd;
+                        ap_uint<32> rightOff = mdl_txSar.sackBlk[i].right - mdl_txSar.ackd;
+                        if (((leftOff[31] == 1) or (leftOff == 0)) and
+                            ((rightOff[31] == 0) and (rightOff != 0) and (rightOff <= currDatLen))) {
+                            sackSkip  = true;
+                            sackRight = mdl_txSar.sackBlk[i].right;
+                        }
+                        else if ((leftOff[31] == 0) and (leftOff != 0) and (leftOff < sackHole)) {
+                            sackHole  = leftOff;
+                        }
+                    }
+                }
+                if (sackSkip) {
+                    mdl_txSar.ackd = sackRight;
+                    break;
+                }
+
+                mdl_txeMeta.ackNumb = mdl_rxSar.rcvd;
+                mdl_txeMeta.seqNumb = mdl_txSar.ackd;
+                mdl_txeMeta.winSize = scaleDownWindow(winSize, mdl_rxSar.winScaleOk);
+                mdl_txeMeta.ack = 1; // ACK is always set when session is established
+                mdl_txeMeta.rst = 0;
+                mdl_txeMeta.syn = 0;
+                mdl_txeMeta.fin = 0;
+                mdl_txeMeta.ece = mdl_rxSar.ecnOk and mdl_rxSar.ceEcho;
+                // Construct address before modifying 'mdl_txSar.ackd'
+                TxMemPtr memSegAddr;  // 0x40000000
+                memSegAddr(31, 30) = 0x01;
+                memSegAddr(29, TOE_WINDOW_BITS) = mdl_curEvent.sessionID(TOE_SESS_ADDR_BITS-1, 0);
+                memSegAddr(TOE_WINDOW_BITS-1, 0) = mdl_txSar.ackd(TOE_WINDOW_BITS-1, 0); // mdl_curEvent.address;
                 // Since we are retransmitting from 'txSar.ackd' to 'txSar.not_ackd',
                 // this data is already inside the usableWindow => No check is required
-                // Only check if length is bigger than MSS
-                if (currDatLen+TCP_HEADER_LEN > ZYC2_MSS) {
+                // Only check if length is bigger than MSS or than the next hole
+                if ((currDatLen+TCP_HEADER_LEN > ZYC2_MSS) or (sackHole < currDatLen)) {
                     // We stay in this state and sent immediately another packet
-                    mdl_txeMeta.length = ZYC2_MSS-TCP_HEADER_LEN;
-                    mdl_txSar.ackd    += ZYC2_MSS-TCP_HEADER_LEN;
-                    // [TODO - replace with dynamic count, remove this]
-                    if (mdl_segmentCount == 3) {
+                    if (currDatLen+TCP_HEADER_LEN > ZYC2_MSS) {
+                        mdl_txeMeta.length = ZYC2_MSS-TCP_HEADER_LEN;
+                    }
+                    else {
+                        mdl_txeMeta.length = currDatLen;
+                    }
+                    if (sackHole < mdl_txeMeta.length) {
+                        mdl_txeMeta.length = sackHole;
+                    }
+                    mdl_txSar.ackd += mdl_txeMeta.length;
+                    if (mdl_segmentCount == TXE_RT_MAX_SEGS-1) {
                         // Should set a probe or sth??
                         //txEng2txSar_upd_req.write(txTxSarQuery(ml_curEvent.sessionID, mdl_txSar.not_ackd, 1));
                         mdl_fsmState = MDL_WAIT_EVENT;
                     }
-                    mdl_segmentCount++;
                 }
                 else {
                     mdl_txeMeta.length = currDatLen;
@@ -425,18 +732,40 @@ void pMetaDataLoader(
 
                 // Only send a packet if there is data
                 if (mdl_txeMeta.length != 0) {
-                    soMrd_BufferRdCmd.write(DmCmd(memSegAddr, mdl_txeMeta.length));
-                    soIhc_TcpDatLen.write(mdl_txeMeta.length);
+                    // FYI - A retransmission is never sent as ECN-capable (RFC-3168)
+                    soIhc_Meta.write(IhcMeta(mdl_txeMeta.length));
                     soPhc_TxeMeta.write(mdl_txeMeta);
-                    soSps_IsLookup.write(true);
-#if (TCP_NODELAY)
-                    soTODO_isDDRbypass.write(false);
-#endif
-                    soSLc_ReverseLkpReq.write(mdl_curEvent.sessionID);
-                    // Only set RT timer if we actually send sth
-                    soTIm_ReTxTimerCmd.write(TXeReTransTimerCmd(mdl_curEvent.sessionID));
+                    isChained = mdl_tailValid and (mdl_tailSessId == mdl_curEvent.sessionID) and
+                                (mdl_tailEndAdr == memSegAddr(TOE_WINDOW_BITS-1, 0));
+                    nrRdCmds  = setPayloadReads(memSegAddr, mdl_txeMeta.length, mdl_curEvent.sessionID,
+                                                isChained, tcaCmd, rdCmds);
+                    soMrd_BufferRdCmd.write(rdCmds[0]);
+                    soTss_PayRdCnt.write(nrRdCmds);
+                    soTca_CsumCmd.write(tcaCmd);
+                    mdl_tailValid  = (tcaCmd.src == PAY_SRC_CELLS) and tcaCmd.hasTail;
+                    mdl_tailSessId = mdl_curEvent.sessionID;
+                    mdl_tailEndAdr = memSegAddr(TOE_WINDOW_BITS-1, 0) + mdl_txeMeta.length;
+                    if (nrRdCmds > 1) {
+                        mdl_rdCmds[0] = rdCmds[1];
+                        mdl_rdCmds[1] = rdCmds[2];
+                        mdl_nrRdCmds  = nrRdCmds - 1;
+                        mdl_resumeEvent = (mdl_fsmState == MDL_PROCESS_EVENT);
+                        mdl_fsmState = MDL_NEXT_RD_CMD;
+                    }
+                    if (isFirstSeg) {
+                        isLookup = requestSocketPair(mdl_curEvent.sessionID, mdl_pairCached,
+                                                     soSLc_ReverseLkpReq, soSps_IsLookup);
+                        // Only set RT timer if we actually send sth
+                        soTIm_ReTxTimerCmd.write(TXeReTransTimerCmd(mdl_curEvent.sessionID, RT_EVENT, mdl_txSar.rto));
+                    }
+                    else {
+                        soSps_IsLookup.write(SpsCmd(SPS_REUSE));
+                    }
+                    mdl_segmentCount++;
+                    #ifndef __SYNTHESIS__
+                    txeNrDataSegs++;
+                    #endif
                 }
-                mdl_sarLoaded = true;
             }
             break;
         case ACK_EVENT:
@@ -450,16 +779,31 @@ void pMetaDataLoader(
                 winSize = ((mdl_rxSar.appd - (RxBufPtr)mdl_rxSar.oooHead(TOE_WINDOW_BITS-1, 0)) - 1);
                 mdl_txeMeta.ackNumb = mdl_rxSar.rcvd;
                 mdl_txeMeta.seqNumb = mdl_txSar.not_ackd; //Always send SEQ
-                mdl_txeMeta.winSize = winSize;
+                mdl_txeMeta.winSize = scaleDownWindow(winSize, mdl_rxSar.winScaleOk);
                 mdl_txeMeta.length  = 0;
                 mdl_txeMeta.ack = 1;
                 mdl_txeMeta.rst = 0;
                 mdl_txeMeta.syn = 0;
                 mdl_txeMeta.fin = 0;
-                soIhc_TcpDatLen.write(mdl_txeMeta.length);
+                mdl_txeMeta.ece = mdl_rxSar.ecnOk and mdl_rxSar.ceEcho;
+                // Report the out-of-order blocks as SACK blocks (RFC-2018)
+                //  FYI - The option is padded to a multiple of 8 bytes (i.e. 8*(n+1))
+                if (mdl_rxSar.sackOk and (mdl_rxSar.oooCnt != 0)) {
+                    mdl_txeMeta.sackCnt = (mdl_rxSar.oooCnt > TOE_SACK_BLOCKS) ?
+                                          (SackCnt)TOE_SACK_BLOCKS : (SackCnt)mdl_rxSar.oooCnt;
+                    for (int i=0; i<TOE_SACK_BLOCKS; ++i) {
+                    #pragma HLS UNROLL
+                        if (i < TOE_OOO_BLOCKS) {
+                            mdl_txeMeta.sackBlk[i] = SackBlock(mdl_rxSar.oooBlk[i].tail,
+                                                               mdl_rxSar.oooBlk[i].head);
+                        }
+                    }
+                    mdl_txeMeta.length = 8*(mdl_txeMeta.sackCnt+1);
+                }
+                soIhc_Meta.write(IhcMeta(mdl_txeMeta.length));
                 soPhc_TxeMeta.write(mdl_txeMeta);
-                soSps_IsLookup.write(true);
-                soSLc_ReverseLkpReq.write(mdl_curEvent.sessionID);
+                isLookup = requestSocketPair(mdl_curEvent.sessionID, mdl_pairCached,
+                                             soSLc_ReverseLkpReq, soSps_IsLookup);
                 mdl_fsmState = MDL_WAIT_EVENT;
             }
             break;
@@ -479,16 +823,21 @@ void pMetaDataLoader(
                 }
                 mdl_txeMeta.ackNumb = 0;
                 //mdl_txeMeta.seqNumb = mdl_txSar.not_ackd;
-                mdl_txeMeta.winSize = 0xFFFF;
-                mdl_txeMeta.length = 4; // FYI - MSS adds 4 option bytes
+                mdl_txeMeta.winSize = (TOE_RX_BUFFER_SIZE > 0xFFFF) ? 0xFFFF : (TOE_RX_BUFFER_SIZE-1); // A SYN window is never scaled
+                mdl_txeMeta.length = 12; // FYI - MSS, SACK-Permitted and Window Scale add 12 option bytes
+                mdl_txeMeta.sackOk = true;
+                mdl_txeMeta.winScaleOk = true;
                 mdl_txeMeta.ack = 0;
                 mdl_txeMeta.rst = 0;
                 mdl_txeMeta.syn = 1;
                 mdl_txeMeta.fin = 0;
-                soIhc_TcpDatLen.write(mdl_txeMeta.length);
+                // ECN-setup SYN (RFC-3168)
+                mdl_txeMeta.ece = TOE_ECN;
+                mdl_txeMeta.cwr = TOE_ECN;
+                soIhc_Meta.write(IhcMeta(mdl_txeMeta.length));
                 soPhc_TxeMeta.write(mdl_txeMeta);
-                soSps_IsLookup.write(true);
-                soSLc_ReverseLkpReq.write(mdl_curEvent.sessionID);
+                isLookup = requestSocketPair(mdl_curEvent.sessionID, mdl_pairCached,
+                                             soSLc_ReverseLkpReq, soSps_IsLookup);
                 // Set retransmission timer
                 soTIm_ReTxTimerCmd.write(TXeReTransTimerCmd(mdl_curEvent.sessionID, SYN_EVENT));
                 mdl_fsmState = MDL_WAIT_EVENT;
@@ -503,11 +852,16 @@ void pMetaDataLoader(
                 // Construct SYN_ACK message
                 mdl_txeMeta.ackNumb = mdl_rxSar.rcvd;
                 mdl_txeMeta.winSize = MY_MSS * 12;
-                mdl_txeMeta.length  = 4; // FYI - MSS adds 4 option bytes
+                mdl_txeMeta.sackOk  = mdl_rxSar.sackOk;
+                mdl_txeMeta.winScaleOk = mdl_rxSar.winScaleOk;
+                // FYI - MSS adds 4 option bytes, SACK-Permitted and Window Scale 4 more each
+                mdl_txeMeta.length  = 4 + ((mdl_rxSar.sackOk) ? 4 : 0) + ((mdl_rxSar.winScaleOk) ? 4 : 0);
                 mdl_txeMeta.ack     = 1;
                 mdl_txeMeta.rst     = 0;
                 mdl_txeMeta.syn     = 1;
                 mdl_txeMeta.fin     = 0;
+                // ECN-setup SYN-ACK, only if the SYN was an ECN-setup SYN (RFC-3168)
+                mdl_txeMeta.ece     = mdl_rxSar.ecnOk;
                 if (mdl_curEvent.rt_count != 0) {
                     mdl_txeMeta.seqNumb = mdl_txSar.ackd;
                 }
@@ -519,10 +873,10 @@ void pMetaDataLoader(
                     soTSt_TxSarQry.write(TXeTxSarQuery(mdl_curEvent.sessionID,
                                          mdl_txSar.not_ackd+1, QUERY_WR, QUERY_INIT));
                 }
-                soIhc_TcpDatLen.write(mdl_txeMeta.length);
+                soIhc_Meta.write(IhcMeta(mdl_txeMeta.length));
                 soPhc_TxeMeta.write(mdl_txeMeta);
-                soSps_IsLookup.write(true);
-                soSLc_ReverseLkpReq.write(mdl_curEvent.sessionID);
+                isLookup = requestSocketPair(mdl_curEvent.sessionID, mdl_pairCached,
+                                             soSLc_ReverseLkpReq, soSps_IsLookup);
                 // Set retransmission timer
                 soTIm_ReTxTimerCmd.write(TXeReTransTimerCmd(mdl_curEvent.sessionID, SYN_ACK_EVENT));
                 mdl_fsmState = MDL_WAIT_EVENT;
@@ -540,12 +894,14 @@ void pMetaDataLoader(
                 winSize = ((mdl_rxSar.appd - (RxBufPtr)mdl_rxSar.oooHead(TOE_WINDOW_BITS-1, 0)) - 1);
                 mdl_txeMeta.ackNumb = mdl_rxSar.rcvd;
                 //meta.seqNumb = mdl_txSar.not_ackd;
-                mdl_txeMeta.winSize = winSize;
+                mdl_txeMeta.winSize = scaleDownWindow(winSize, mdl_rxSar.winScaleOk);
                 mdl_txeMeta.length = 0;
                 mdl_txeMeta.ack = 1; // has to be set for FIN message as well
                 mdl_txeMeta.rst = 0;
                 mdl_txeMeta.syn = 0;
                 mdl_txeMeta.fin = 1;
+                mdl_txeMeta.ece = mdl_rxSar.ecnOk and mdl_rxSar.ceEcho;
+                mdl_txeMeta.cwr = 0;
 
                 // Check if retransmission, in case of RT, we have to reuse 'not_ackd' number
                 if (mdl_curEvent.rt_count != 0)
@@ -554,7 +910,7 @@ void pMetaDataLoader(
                     mdl_txeMeta.seqNumb = mdl_txSar.not_ackd;
                     // Check if all data is sent, otherwise we have to delay FIN message
                     // Set FIN flag, such that probeTimer is informed
-                    if (mdl_txSar.app == mdl_txSar.not_ackd(15, 0))
+                    if (mdl_txSar.app == mdl_txSar.not_ackd(TOE_WINDOW_BITS-1, 0))
                         soTSt_TxSarQry.write(TXeTxSarQuery(mdl_curEvent.sessionID, mdl_txSar.not_ackd+1,
                                              QUERY_WR, ~QUERY_INIT, true, true));
                     else
@@ -563,13 +919,13 @@ void pMetaDataLoader(
                 }
 
                 // Check if there is a FIN to be sent // [TODO - maybe restrict this]
-                if (mdl_txeMeta.seqNumb(15, 0) == mdl_txSar.app) {
-                    soIhc_TcpDatLen.write(mdl_txeMeta.length);
+                if (mdl_txeMeta.seqNumb(TOE_WINDOW_BITS-1, 0) == mdl_txSar.app) {
+                    soIhc_Meta.write(IhcMeta(mdl_txeMeta.length));
                     soPhc_TxeMeta.write(mdl_txeMeta);
-                    soSps_IsLookup.write(true);
-                    soSLc_ReverseLkpReq.write(mdl_curEvent.sessionID);
+                    isLookup = requestSocketPair(mdl_curEvent.sessionID, mdl_pairCached,
+                                                 soSLc_ReverseLkpReq, soSps_IsLookup);
                     // Set retransmission timer
-                    soTIm_ReTxTimerCmd.write(TXeReTransTimerCmd(mdl_curEvent.sessionID));
+                    soTIm_ReTxTimerCmd.write(TXeReTransTimerCmd(mdl_curEvent.sessionID, RT_EVENT, mdl_txSar.rto));
                 }
                 mdl_fsmState = MDL_WAIT_EVENT;
             }
@@ -579,23 +935,55 @@ void pMetaDataLoader(
             // Assumption RST length == 0
             resetEvent = mdl_curEvent;
             if (!resetEvent.hasSessionID()) {
-                soIhc_TcpDatLen.write(0);
+                soIhc_Meta.write(IhcMeta(0));
                 soPhc_TxeMeta.write(TXeMeta(0, resetEvent.getAckNumb(), 1, 1, 0, 0));
-                soSps_IsLookup.write(false);
+                soSps_IsLookup.write(SpsCmd(SPS_RST_PAIR));
                 soSps_RstSockPair.write(mdl_curEvent.tuple);
                 mdl_fsmState = MDL_WAIT_EVENT;
             }
             else if (!siTSt_TxSarRep.empty()) {
                 siTSt_TxSarRep.read(mdl_txSar);
-                soIhc_TcpDatLen.write(0);
-                soSps_IsLookup.write(true);
-                soSLc_ReverseLkpReq.write(resetEvent.sessionID); //there is no sessionID??
+                soIhc_Meta.write(IhcMeta(0));
+                isLookup = requestSocketPair(resetEvent.sessionID, mdl_pairCached,
+                                             soSLc_ReverseLkpReq, soSps_IsLookup);
                 soPhc_TxeMeta.write(TXeMeta(mdl_txSar.not_ackd, resetEvent.getAckNumb(), 1, 1, 0, 0));
 
                 mdl_fsmState = MDL_WAIT_EVENT;
             }
             break;
+        case SYN_COOKIE_EVENT:
+            if (DEBUG_LEVEL & TRACE_MDL) { printInfo(myName, "Entering the 'SYN_COOKIE' processing.\n"); }
+            cookieEvent = mdl_curEvent;
+            if (!cookieEvent.hasSessionID()) {
+                // Construct a stateless SYN_ACK message
+                mdl_txeMeta.seqNumb = cookieEvent.seqNumb;
+                mdl_txeMeta.ackNumb = cookieEvent.ackNumb;
+                mdl_txeMeta.winSize = MY_MSS * 12;
+                mdl_txeMeta.sackOk  = cookieEvent.sackOk();
+                mdl_txeMeta.winScaleOk = cookieEvent.winScaleOk();
+                // FYI - MSS adds 4 option bytes, SACK-Permitted and Window Scale 4 more each
+                mdl_txeMeta.length  = 4 + ((cookieEvent.sackOk()) ? 4 : 0) + ((cookieEvent.winScaleOk()) ? 4 : 0);
+                mdl_txeMeta.ack     = 1;
+                mdl_txeMeta.rst     = 0;
+                mdl_txeMeta.syn     = 1;
+                mdl_txeMeta.fin     = 0;
+                soIhc_Meta.write(IhcMeta(mdl_txeMeta.length));
+                soPhc_TxeMeta.write(mdl_txeMeta);
+                soSps_IsLookup.write(SpsCmd(SPS_RST_PAIR));
+                soSps_RstSockPair.write(mdl_curEvent.tuple);
+            }
+            else {
+                // The session ID may still have the socket pair of its former owner
+                isForget = true;
+            }
+            mdl_fsmState = MDL_WAIT_EVENT;
+            break;
         } // End of: switch(mdl_curEvent.type)
+        if (isLookup or isForget) {
+            // The socket pair of this session is now (or no longer) cached by [Sps]
+            SOCK_PAIR_CACHED[mdl_curEvent.sessionID] = isLookup;
+            mdl_pairCached = isLookup;
+        }
         if (DEBUG_LEVEL & TRACE_MDL) {
             printInfo(myName, "Event : [%s]\n", getEventName(mdl_curEvent.type));
             printInfo(myName, "\t ackNumb = %lu\n", mdl_txeMeta.ackNumb.to_ulong());
@@ -613,18 +1001,22 @@ void pMetaDataLoader(
  *
  * @param[in]  siSLc_ReverseLkpRsp Reverse lookup response from SessionLookupController (SLc).
  * @param[in]  siMdl_RstSockPair   The socket pair to reset from MetaDataLoader (Mdh).
- * @param[in]  siMdl_IsLookup      Status from [Mdl] indicating that a reverse lookup is to be expected.
+ * @param[in]  siMdl_IsLookup      Command from [Mdl] telling where the socket pair comes from.
  * @param[out] soIhc_IpAddrPair    IP_SA and IP_DA to IpHeaderConstructor (Ihc).
  * @param[out] soPhc_SocketPair    The socket pair to PseudoHeaderConstructor (Phc).
  *
  * @details
  *  This process forwards the incoming socket-pair from the CAM or the RxEngine
  *   to both the IpHeaderConstructor (Ihc) and the PseudoHeaderConstructor (Phc).
+ *  The socket pair returned by a reverse lookup is cached in SOCK_PAIR_TABLE,
+ *   such that the next events of the same session are forwarded without any
+ *   lookup. The socket pair of the previous segment is also kept in a register
+ *   for the next segments of a TSO burst.
  *******************************************************************************/
 void pSocketPairSplitter(
         stream<fourTuple>       &siSLc_ReverseLkpRsp,
         stream<LE_SocketPair>   &siMdl_RstSockPair,    // [FIXME]
-        stream<StsBool>         &siMdl_IsLookup,
+        stream<SpsCmd>          &siMdl_IsLookup,
         stream<IpAddrPair>      &soIhc_IpAddrPair,
         stream<SocketPair>      &soPhc_SocketPair)
 {
@@ -634,24 +1026,43 @@ void pSocketPairSplitter(
 
     const char *myName  = concat3(THIS_NAME, "/", "Sps");
 
+    //-- STATIC ARRAYS ---------------------------------------------------------
+    static SocketPair          SOCK_PAIR_TABLE[TOE_MAX_SESSIONS];
+    #pragma HLS RESOURCE   variable=SOCK_PAIR_TABLE core=RAM_T2P_BRAM
+
     //-- STATIC CONTROL VARIABLES (with RESET) --------------------------------
     static bool                sps_getMeta=false;
     #pragma HLS RESET variable=sps_getMeta
 
     //-- STATIC DATAFLOW VARIABLES --------------------------------------------
-    static StsBool             sps_isLookUp;
+    static SpsCmd              sps_cmd;
+    static SocketPair          sps_sockPair;  // The socket pair of the previous segment
 
     //-- DYNAMIC VARIABLES ----------------------------------------------------
     fourTuple      tuple;
 
     if (not sps_getMeta) {
         if (!siMdl_IsLookup.empty()) {
-            siMdl_IsLookup.read(sps_isLookUp);
-            sps_getMeta = true;
+            siMdl_IsLookup.read(sps_cmd);
+            if ((sps_cmd.op == SPS_REUSE) or (sps_cmd.op == SPS_CACHED)) {
+                // Next segment of a TSO burst or next event of a known session
+                if (sps_cmd.op == SPS_CACHED) {
+                    sps_sockPair = SOCK_PAIR_TABLE[sps_cmd.sessId];
+                }
+                if (DEBUG_LEVEL & TRACE_SPS) {
+                   printInfo(myName, "Reusing the following socket-pair: \n");
+                   printSockPair(myName, sps_sockPair);
+                }
+                soIhc_IpAddrPair.write(IpAddrPair(sps_sockPair.src.addr, sps_sockPair.dst.addr));
+                soPhc_SocketPair.write(sps_sockPair);
+            }
+            else {
+                sps_getMeta = true;
+            }
         }
     }
     else {
-        if (!siSLc_ReverseLkpRsp.empty() && sps_isLookUp) {
+        if (!siSLc_ReverseLkpRsp.empty() && (sps_cmd.op == SPS_LOOKUP)) {
             siSLc_ReverseLkpRsp.read(tuple);
             SocketPair socketPair(SockAddr(byteSwap32(tuple.srcIp),
                                            byteSwap16(tuple.srcPort)),
@@ -663,9 +1074,11 @@ void pSocketPairSplitter(
             }
             soIhc_IpAddrPair.write(IpAddrPair(socketPair.src.addr, socketPair.dst.addr));
             soPhc_SocketPair.write(socketPair);
+            SOCK_PAIR_TABLE[sps_cmd.sessId] = socketPair;
+            sps_sockPair = socketPair;
             sps_getMeta = false;
         }
-        else if(!siMdl_RstSockPair.empty() && !sps_isLookUp) {
+        else if(!siMdl_RstSockPair.empty() && (sps_cmd.op == SPS_RST_PAIR)) {
             LE_SocketPair  leSocketPair;
             siMdl_RstSockPair.read(leSocketPair);
             SocketPair     socketPair = SocketPair(SockAddr(byteSwap32(leSocketPair.src.addr),
@@ -686,12 +1099,13 @@ void pSocketPairSplitter(
 /*******************************************************************************
  * @brief IPv4 Header Constructor (Ihc)
  *
- * @param[in]  siMdl_TcpDatLen   TCP data length from Meta Data Loader (Mdl).
+ * @param[in]  siMdl_Meta        IPv4 header metadata from Meta Data Loader (Mdl).
  * @param[in]  siSps_Ip4AddrPair The IP_SA and IP_DA from Socket Pair Splitter (Sps).
  * @param[out] soIps_IpHeader    IP4 header stream to Ip Packet Stitcher (Ips).
  *
  * @details
  *  Constructs an IPv4 header and forwards it to the IP Packet Stitcher (Ips).
+ *  The ECN field is set to ECT(0) if [Mdl] sends the segment as ECN-capable.
 
  * @Warning
  *  The IP header is formatted for transmission to the Ethernet MAC. Remember
@@ -708,7 +1122,7 @@ void pSocketPairSplitter(
  *
  *******************************************************************************/
 void pIpHeaderConstructor(
-        stream<TcpDatLen>       &siMdl_TcpDatLen,
+        stream<IhcMeta>         &siMdl_Meta,
         stream<IpAddrPair>      &siSps_IpAddrPair,
         stream<AxisIp4>         &soIPs_IpHeader)
 {
@@ -728,16 +1142,16 @@ void pIpHeaderConstructor(
     //-- DYNAMIC VARIABLES -----------------------------------------------------
     AxisIp4                    currIpHdrChunk;
     Ip4TotalLen                ip4TotLen = 0;
-    TcpDatLen                  tcpDatLen;
+    IhcMeta                    ihcMeta;
 
     switch(ihc_chunkCounter) {
     case CHUNK_0:
-        if (!siMdl_TcpDatLen.empty()) {
-            siMdl_TcpDatLen.read(tcpDatLen);
+        if (!siMdl_Meta.empty()) {
+            siMdl_Meta.read(ihcMeta);
             currIpHdrChunk.setIp4Version(4);
             currIpHdrChunk.setIp4HdrLen(5);
-            currIpHdrChunk.setIp4ToS(0);
-            ip4TotLen = IP4_HEADER_LEN + TCP_HEADER_LEN + tcpDatLen;
+            currIpHdrChunk.setIp4ToS((ihcMeta.ect) ? IP4_ECN_ECT0 : IP4_ECN_NOT_ECT);
+            ip4TotLen = IP4_HEADER_LEN + TCP_HEADER_LEN + ihcMeta.length;
             currIpHdrChunk.setIp4TotalLen(ip4TotLen);
             currIpHdrChunk.setIp4Ident(0);
             currIpHdrChunk.setIp4Flags(0);
@@ -814,6 +1228,10 @@ void pIpHeaderConstructor(
  *  |    Data 3     |    Data 2     |    Data 1     |    Data 0     |      Opt-Data (.i.e MSS)      |   Opt-Length  |   Opt-Kind    |
  *  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
  *
+ *  A SYN may also carry a SACK-Permitted and a Window Scale option after the
+ *   MSS option, while a pure ACK may carry a SACK option. The latter is padded with
+ *   NOPs to a multiple of 8 bytes, such that the payload remains aligned.
+ *
  *******************************************************************************/
 void pPseudoHeaderConstructor(
         stream<TXeMeta>             &siMdl_TxeMeta,
@@ -833,10 +1251,13 @@ void pPseudoHeaderConstructor(
     //-- STATIC DATAFLOW VARIABLES ---------------------------------------------
     static TXeMeta             phc_meta;
     static SocketPair          phc_socketPair;
+    static SackCnt             phc_optIdx;  // Index of the current option chunk
 
     //-- DYNAMIC VARIABLES -----------------------------------------------------
     AxisPsd4                   currChunk(0, 0xFF, 0);
     TcpSegLen                  pseudoHdrLen = 0;
+    ap_uint<32>                wsOptWord;
+    bool                       isLastOptChunk;
 
     switch(phc_chunkCount) {
     case CHUNK_0:
@@ -879,15 +1300,25 @@ void pPseudoHeaderConstructor(
         // Build and forward  [ UrgPtr | CSum | Win | Flags | DataOffset & Res & NS ]
         currChunk.setTcpCtrlNs(0);
         currChunk.setTcpResBits(0);
-        currChunk.setTcpDataOff(5 + (int)phc_meta.syn); // 5x32bits (+ 1x32bits for MSS)
+        if (phc_meta.syn) {
+            // 5x32bits + 1x32bits for MSS (+ 1x32bits for SACK-Permitted) (+ 1x32bits for Window Scale)
+            currChunk.setTcpDataOff(5 + 1 + ((phc_meta.sackOk) ? 1 : 0) + ((phc_meta.winScaleOk) ? 1 : 0));
+        }
+        else if (phc_meta.sackCnt != 0) {
+            // 5x32bits + 2x32bits per SACK block + 2x32bits for the option header and padding
+            currChunk.setTcpDataOff(5 + 2*(phc_meta.sackCnt+1));
+        }
+        else {
+            currChunk.setTcpDataOff(5);
+        }
         currChunk.setTcpCtrlFin(phc_meta.fin);
         currChunk.setTcpCtrlSyn(phc_meta.syn);
         currChunk.setTcpCtrlRst(phc_meta.rst);
         currChunk.setTcpCtrlPsh(0);
         currChunk.setTcpCtrlAck(phc_meta.ack);
         currChunk.setTcpCtrlUrg(0);
-        currChunk.setTcpCtrlEce(0);
-        currChunk.setTcpCtrlCwr(0);
+        currChunk.setTcpCtrlEce(phc_meta.ece);
+        currChunk.setTcpCtrlCwr(phc_meta.cwr);
         currChunk.setTcpWindow(phc_meta.winSize);
         currChunk.setTcpChecksum(0);
         currChunk.setTcpUrgPtr(0);
@@ -895,25 +1326,86 @@ void pPseudoHeaderConstructor(
         assessSize(myName, soTss_PseudoHdr, "soTss_PseudoHdr", 32); // [FIXME-Use constant for the length]
         soTss_PseudoHdr.write(currChunk);
         if (DEBUG_LEVEL & TRACE_PHC) { printAxisRaw(myName, "soTss_PseudoHdr =", currChunk); }
-        if (!phc_meta.syn) {
-            phc_chunkCount = 0;
+        if (phc_meta.syn) {
+            phc_optIdx     = 0;
+            phc_chunkCount = CHUNK_4;
+        }
+        else if (phc_meta.sackCnt != 0) {
+            phc_optIdx    = 0;
+            phc_chunkCount = CHUNK_5;
         }
         else {
-            phc_chunkCount++;
+            phc_chunkCount = 0;
         }
         break;
     case CHUNK_4:
-        // Only used for SYN and MSS negotiation
-        // Build and forward [ Data 3:0 | Opt-Data | Opt-Length | Opt-Kind ]
-        currChunk.setTcpOptKind(0x02);  // Option Kind = Maximum Segment Size
-        currChunk.setTcpOptLen(0x04);   // Option length = 4 bytes
-        currChunk.setTcpOptMss(MY_MSS); // Our Maximum Segment Size (1456)
-        currChunk.setLE_TKeep(0x0F);
-        currChunk.setLE_TLast(TLAST);
+        // Only used for SYN and the negotiation of MSS, SACK-Permitted and Window Scale
+        //  Window Scale = [ Shift | Opt-Length | Opt-Kind | NOP ]
+        wsOptWord = (((ap_uint<32>)TOE_WINDOW_SCALE) << 24) | (0x03 << 16) | (TCP_OPT_KIND_WSS << 8) | 0x01;
+        if (phc_optIdx == 0) {
+            // Build and forward [ Data 3:0 | Opt-Data | Opt-Length | Opt-Kind ]
+            currChunk.setTcpOptKind(0x02);  // Option Kind = Maximum Segment Size
+            currChunk.setTcpOptLen(0x04);   // Option length = 4 bytes
+            currChunk.setTcpOptMss(MY_MSS); // Our Maximum Segment Size (1456)
+            if (phc_meta.sackOk) {
+                // Append [ SACK-Permitted | NOP | NOP ]
+                currChunk.setLE_TData(0x02040101, 63, 32);
+                currChunk.setLE_TKeep(0xFF);
+            }
+            else if (phc_meta.winScaleOk) {
+                // Append [ Window Scale ]
+                currChunk.setLE_TData(wsOptWord, 63, 32);
+                currChunk.setLE_TKeep(0xFF);
+            }
+            else {
+                currChunk.setLE_TKeep(0x0F);
+            }
+            isLastOptChunk = not (phc_meta.sackOk and phc_meta.winScaleOk);
+        }
+        else {
+            // Build and forward [ Data 3:0 | Window Scale ]
+            currChunk.setLE_TData(wsOptWord, 31, 0);
+            currChunk.setLE_TKeep(0x0F);
+            isLastOptChunk = true;
+        }
+        currChunk.setLE_TLast(isLastOptChunk);
+        assessSize(myName, soTss_PseudoHdr, "soTss_PseudoHdr", 32); // [FIXME-Use constant for the length]
+        soTss_PseudoHdr.write(currChunk);
+        if (DEBUG_LEVEL & TRACE_PHC) { printAxisRaw(myName, "soTss_PseudoHdr =", currChunk); }
+        if (isLastOptChunk) {
+            phc_chunkCount = 0;
+        }
+        else {
+            phc_optIdx++;
+        }
+        break;
+    case CHUNK_5:
+        // Only used for ACKs carrying SACK blocks (RFC-2018)
+        //  Chunk #0 = [ Left-Edge #0 | Length | Kind | NOP | NOP ]
+        //  Chunk #k = [ Left-Edge #k | Right-Edge #(k-1) ] (or [ NOP x4 | Right-Edge #(n-1) ] if k==n)
+        if (phc_optIdx == 0) {
+            currChunk.setLE_TData((ap_uint<32>)((((ap_uint<32>)(2+8*phc_meta.sackCnt)) << 24) |
+                                                (TCP_OPT_KIND_SBLK << 16) | 0x0101), 31, 0);
+        }
+        else {
+            currChunk.setLE_TData(byteSwap32(phc_meta.sackBlk[phc_optIdx-1].right), 31, 0);
+        }
+        if (phc_optIdx < phc_meta.sackCnt) {
+            currChunk.setLE_TData(byteSwap32(phc_meta.sackBlk[phc_optIdx].left), 63, 32);
+        }
+        else {
+            currChunk.setLE_TData(0x01010101, 63, 32);
+        }
+        currChunk.setLE_TLast(phc_optIdx == phc_meta.sackCnt);
         assessSize(myName, soTss_PseudoHdr, "soTss_PseudoHdr", 32); // [FIXME-Use constant for the length]
         soTss_PseudoHdr.write(currChunk);
         if (DEBUG_LEVEL & TRACE_PHC) { printAxisRaw(myName, "soTss_PseudoHdr =", currChunk); }
-        phc_chunkCount = 0;
+        if (phc_optIdx == phc_meta.sackCnt) {
+            phc_chunkCount = 0;
+        }
+        else {
+            phc_optIdx++;
+        }
         break;
     } // End of: switch
 
@@ -924,24 +1416,29 @@ void pPseudoHeaderConstructor(
  *
  * @param[in]  siPhc_PseudoHdr   Incoming chunk from PseudoHeaderConstructor (Phc).
  * @param[in]  siMEM_TxP_Data    TCP data payload from DRAM Memory (MEM).
- * @param[out] soSca_PseudoPkt   Pseudo TCP/IP packet to SubChecksumAccumulator (Sca).
+ * @param[in]  siMdl_PayRdCnt    The number of memory reads which make the payload
+ *                                of the current segment (0 when it bypasses the DDR).
+ * @param[in]  siBdf_Data        TCP data payload bypassing the DDR from [Bdf].
+ * @param[out] soTca_PseudoPkt   Pseudo TCP/IP packet to TcpChecksumAccumulator (Tca).
  * @param[in]  siMrd_SplitSegSts Indicates that the current segment has been
  *                                splitted and stored in 2 memory buffers.
  * @details
  *  Reads in the TCP pseudo header stream from PseudoHeaderConstructor (Phc) and
- *   appends the corresponding payload stream retrieved from the memory.
+ *   appends the corresponding payload stream retrieved from the memory or, if
+ *   the segment bypasses the DDR, from [Bdf].
  *  Note that a TCP segment might have been splitted and stored as two memory
  *   segment units. This typically happens when the address of the physical
  *   memory buffer ring wraps around.
+ *  The payload of a segment might also be read as several pieces (see
+ *   'setPayloadReads()'). Each piece ends with its own TLAST and the pieces
+ *   are put back in order by the TcpChecksumAccumulator (Tca).
  *******************************************************************************/
 void pTcpSegStitcher(
         stream<AxisPsd4>        &siPhc_PseudoHdr,
         stream<AxisApp>         &siMEM_TxP_Data,
-        #if (TCP_NODELAY)
-        stream<bool>            &txEng_isDDRbypass,
-        stream<axiWord>         &txApp2txEng_data_stream,
-        #endif
-        stream<AxisPsd4>        &soSca_PseudoPkt,
+        stream<PayRdCnt>        &siMdl_PayRdCnt,
+        stream<AxisApp>         &siBdf_Data,
+        stream<AxisPsd4>        &soTca_PseudoPkt,
         stream<FlagBool>        &siMrd_SplitSegFlag)
 {
     //-- DIRECTIVES FOR THIS PROCESS -------------------------------------------
@@ -951,9 +1448,9 @@ void pTcpSegStitcher(
     const char *myName  = concat3(THIS_NAME, "/", "Tss");
 
     //-- STATIC CONTROL VARIABLES (with RESET) ---------------------------------
-    static enum FsmState { TSS_PSD_HDR=0,    TSS_PSD_OPT,     TSS_DATA,
-                           TSS_FWD_1ST_BUF,  TSS_FWD_2ND_BUF,
-                           TSS_JOIN_2ND_BUF, TSS_RESIDUE } \
+    static enum FsmState { TSS_PSD_HDR=0,    TSS_PSD_OPT,     TSS_DATA_SRC,
+                           TSS_DATA,         TSS_FWD_1ST_BUF, TSS_FWD_2ND_BUF,
+                           TSS_JOIN_2ND_BUF, TSS_RESIDUE,     TSS_FWD_BYPASS } \
                                tss_fsmState=TSS_PSD_HDR;
     #pragma HLS RESET variable=tss_fsmState
     static ap_uint<3>          tss_psdHdrChunkCount = 0;
@@ -963,24 +1460,22 @@ void pTcpSegStitcher(
     static AxisApp      tss_prevChunk;
     static ap_uint<4>   tss_memRdOffset;
     static FlagBool     tss_mustJoin;
-
-    //-- DYNAMIC VARIABLES -----------------------------------------------------
-    bool                isShortCutData = false;
+    static PayRdCnt     tss_nrRdsLeft;  // The memory reads left for the current segment
 
     switch (tss_fsmState) {
     case TSS_PSD_HDR:
         //-- Read and forward the first 4 chunks from [Phc]
-        if (!siPhc_PseudoHdr.empty() and !soSca_PseudoPkt.full()) {
+        if (!siPhc_PseudoHdr.empty() and !soTca_PseudoPkt.full()) {
             AxisPsd4 currHdrChunk = siPhc_PseudoHdr.read();
-            soSca_PseudoPkt.write(currHdrChunk);
+            soTca_PseudoPkt.write(currHdrChunk);
 
-            if (DEBUG_LEVEL & TRACE_TSS) { printAxisRaw(myName, "soSca_PseudoPkt =", currHdrChunk); }
+            if (DEBUG_LEVEL & TRACE_TSS) { printAxisRaw(myName, "soTca_PseudoPkt =", currHdrChunk); }
             if (tss_psdHdrChunkCount == 3) {
-                if (currHdrChunk.getTcpCtrlSyn()) {
-                    tss_fsmState = TSS_PSD_OPT;  // Segment is a SYN, handle MSS
+                if (currHdrChunk.getTcpCtrlSyn() or (currHdrChunk.getTcpDataOff() > 5)) {
+                    tss_fsmState = TSS_PSD_OPT;  // Segment is a SYN or carries SACK blocks
                 }
                 else {
-                    tss_fsmState = TSS_DATA;
+                    tss_fsmState = TSS_DATA_SRC;
                 }
                 tss_psdHdrChunkCount = 0;
             }
@@ -994,35 +1489,60 @@ void pTcpSegStitcher(
         }
         break;
     case TSS_PSD_OPT:
-        //-- Read fifth chunk from [Phc] because segment includes a TCP option (.i.e, MSS)
-        if (!siPhc_PseudoHdr.empty() and !soSca_PseudoPkt.full()) {
+        //-- Read the option chunks from [Phc] (.i.e, MSS, SACK-Permitted, SACK)
+        if (!siPhc_PseudoHdr.empty() and !soTca_PseudoPkt.full()) {
             AxisPsd4 currHdrChunk = siPhc_PseudoHdr.read();
-            soSca_PseudoPkt.write(currHdrChunk);
+            soTca_PseudoPkt.write(currHdrChunk);
 
-            if (DEBUG_LEVEL & TRACE_TSS) { printAxisRaw(myName, "soSca_PseudoPkt =", currHdrChunk); }
-            if (not currHdrChunk.getTLast()) {
-                printFatal(myName, "Pseudo Header is malformed...\n");
+            if (DEBUG_LEVEL & TRACE_TSS) { printAxisRaw(myName, "soTca_PseudoPkt =", currHdrChunk); }
+            if (currHdrChunk.getTLast()) {
+                tss_fsmState = TSS_PSD_HDR;
+            }
+        }
+        break;
+    case TSS_DATA_SRC:
+        //-- Select the source of the payload (.i.e, DDR memory or DDR bypass)
+        if (!siMdl_PayRdCnt.empty()) {
+            siMdl_PayRdCnt.read(tss_nrRdsLeft);
+            if (tss_nrRdsLeft == 0) {
+                tss_fsmState = TSS_FWD_BYPASS;
+            }
+            else {
+                tss_fsmState = TSS_DATA;
+            }
+        }
+        break;
+    case TSS_FWD_BYPASS:
+        //-- Forward all the data chunks which bypassed the DDR
+        if (!siBdf_Data.empty() and !soTca_PseudoPkt.full()) {
+            AxisApp currAppChunk = siBdf_Data.read();
+            soTca_PseudoPkt.write((AxisPsd4)currAppChunk);
+            if (DEBUG_LEVEL & TRACE_TSS) { printAxisRaw(myName, "soTca_PseudoPkt =", currAppChunk); }
+            if (currAppChunk.getTLast()) {
+                tss_fsmState = TSS_PSD_HDR;
             }
-            tss_fsmState = TSS_PSD_HDR;
         }
         break;
     case TSS_DATA:
          //-- Handle the very 1st data chunk from the 1st memory buffer
-         if (!siMEM_TxP_Data.empty() and !siMrd_SplitSegFlag.empty() and !soSca_PseudoPkt.full()) {
+         if (!siMEM_TxP_Data.empty() and !siMrd_SplitSegFlag.empty() and !soTca_PseudoPkt.full()) {
              siMrd_SplitSegFlag.read(tss_mustJoin);
              AxisApp currAppChunk = siMEM_TxP_Data.read();
              if (currAppChunk.getTLast()) {
                  // We are done with the 1st memory buffer
                  if (tss_mustJoin == false) {
                      // The TCP segment was not splitted.
-                     // We are done with this segment. Go back to 'TSS_PSD_HDR'.
-                     soSca_PseudoPkt.write((AxisPsd4)currAppChunk);
-                     tss_fsmState = TSS_PSD_HDR;
-                     if (DEBUG_LEVEL & TRACE_TSS) { printAxisRaw(myName, "soSca_PseudoPkt =", currAppChunk); }
+                     // We are done with this segment (or with one of its pieces).
+                     soTca_PseudoPkt.write((AxisPsd4)currAppChunk);
+                     tss_fsmState = (tss_nrRdsLeft == 1) ? TSS_PSD_HDR : TSS_DATA;
+                     tss_nrRdsLeft--;
+                     if (DEBUG_LEVEL & TRACE_TSS) { printAxisRaw(myName, "soTca_PseudoPkt =", currAppChunk); }
                  }
                  else {
                      // The TCP segment was splitted in two parts
                      tss_memRdOffset = currAppChunk.getLen();
+                     // Always clear the last bit of the last chunk of 1st part
+                     currAppChunk.setTLast(0);
                      if (tss_memRdOffset != 8) {
                          // The last chunk of the 1st memory buffer is not fully populated.
                          // Don't output anything here. Save the current chunk and goto 'TSS_JOIN_2ND'.
@@ -1034,32 +1554,33 @@ void pTcpSegStitcher(
                          // The last chunk of the 1st memory buffer is populated with
                          // 8 valid bytes and is therefore also aligned.
                          // Forward this chunk and goto 'TSS_FWD_2ND_BUF'.
-                         soSca_PseudoPkt.write((AxisPsd4)currAppChunk);
-                         if (DEBUG_LEVEL & TRACE_TSS) { printAxisRaw(myName, "soSca_PseudoPkt =", currAppChunk); }
+                         soTca_PseudoPkt.write((AxisPsd4)currAppChunk);
+                         if (DEBUG_LEVEL & TRACE_TSS) { printAxisRaw(myName, "soTca_PseudoPkt =", currAppChunk); }
                          tss_fsmState = TSS_FWD_2ND_BUF;
                      }
                  }
              }
              else {
                 // The 1st memory buffer contains more than one chunk
-                soSca_PseudoPkt.write((AxisPsd4)currAppChunk);
-                if (DEBUG_LEVEL & TRACE_TSS) { printAxisRaw(myName, "soSca_PseudoPkt =", currAppChunk); }
+                soTca_PseudoPkt.write((AxisPsd4)currAppChunk);
+                if (DEBUG_LEVEL & TRACE_TSS) { printAxisRaw(myName, "soTca_PseudoPkt =", currAppChunk); }
                 tss_fsmState = TSS_FWD_1ST_BUF;
              }
          }
          break;
     case TSS_FWD_1ST_BUF:
         //-- Forward all the data chunks of the 1st memory buffer
-        if (!siMEM_TxP_Data.empty() and !soSca_PseudoPkt.full()) {
+        if (!siMEM_TxP_Data.empty() and !soTca_PseudoPkt.full()) {
             AxisApp currAppChunk = siMEM_TxP_Data.read();
             if (currAppChunk.getTLast()) {
                 // We are done with the 1st memory buffer
                 if (tss_mustJoin == false) {
                     // The TCP segment was not splitted.
-                    // We are done with this segment. Go back to 'TSS_PSD_HDR'.
-                    soSca_PseudoPkt.write((AxisPsd4)currAppChunk);
-                    tss_fsmState = TSS_PSD_HDR;
-                    if (DEBUG_LEVEL & TRACE_TSS) { printAxisRaw(myName, "soSca_PseudoPkt =", currAppChunk); }
+                    // We are done with this segment (or with one of its pieces).
+                    soTca_PseudoPkt.write((AxisPsd4)currAppChunk);
+                    tss_fsmState = (tss_nrRdsLeft == 1) ? TSS_PSD_HDR : TSS_DATA;
+                    tss_nrRdsLeft--;
+                    if (DEBUG_LEVEL & TRACE_TSS) { printAxisRaw(myName, "soTca_PseudoPkt =", currAppChunk); }
                 }
                 else {
                     // The TCP segment was splitted in two parts
@@ -1077,29 +1598,30 @@ void pTcpSegStitcher(
                         // The last chunk of the 1st memory buffer is populated with
                         // 8 valid bytes and is therefore also aligned.
                         // Forward this chunk and goto 'TSS_FWD_2ND_BUF'.
-                        soSca_PseudoPkt.write((AxisPsd4)currAppChunk);
-                        if (DEBUG_LEVEL & TRACE_TSS) { printAxisRaw(myName, "soSca_PseudoPkt =", currAppChunk); }
+                        soTca_PseudoPkt.write((AxisPsd4)currAppChunk);
+                        if (DEBUG_LEVEL & TRACE_TSS) { printAxisRaw(myName, "soTca_PseudoPkt =", currAppChunk); }
                         tss_fsmState = TSS_FWD_2ND_BUF;
                     }
                 }
             }
             else {
                 // Remain in this state and continue streaming the 1st memory buffer
-                soSca_PseudoPkt.write((AxisPsd4)currAppChunk);
-                if (DEBUG_LEVEL & TRACE_TSS) { printAxisRaw(myName, "soSca_PseudoPkt =", currAppChunk); }
+                soTca_PseudoPkt.write((AxisPsd4)currAppChunk);
+                if (DEBUG_LEVEL & TRACE_TSS) { printAxisRaw(myName, "soTca_PseudoPkt =", currAppChunk); }
              }
         }
         break;
     case TSS_FWD_2ND_BUF:
         //-- Forward all the data chunks of the 2nd memory buffer
-        if (!siMEM_TxP_Data.empty() and !soSca_PseudoPkt.full()) {
+        if (!siMEM_TxP_Data.empty() and !soTca_PseudoPkt.full()) {
             AxisApp currAppChunk = siMEM_TxP_Data.read();
 
-            soSca_PseudoPkt.write((AxisPsd4)currAppChunk);
-            if (DEBUG_LEVEL & TRACE_TSS) { printAxisRaw(myName, "soSca_PseudoPkt =", currAppChunk); }
+            soTca_PseudoPkt.write((AxisPsd4)currAppChunk);
+            if (DEBUG_LEVEL & TRACE_TSS) { printAxisRaw(myName, "soTca_PseudoPkt =", currAppChunk); }
             if (currAppChunk.getTLast()) {
                 // We are done with the 2nd memory buffer
-                tss_fsmState = TSS_PSD_HDR;
+                tss_fsmState = (tss_nrRdsLeft == 1) ? TSS_PSD_HDR : TSS_DATA;
+                tss_nrRdsLeft--;
             }
         }
         break;
@@ -1109,7 +1631,7 @@ void pTcpSegStitcher(
         //-- The re-alignment occurs between the previously read chunk stored
         //-- in 'tss_prevChunk' and the latest chunk stored in 'currAppChunk',
         //-- and 'tss_memRdOffset' specifies the number of valid bytes in 'tss_prevChunk'.
-        if (!siMEM_TxP_Data.empty() and !soSca_PseudoPkt.full()) {
+        if (!siMEM_TxP_Data.empty() and !soTca_PseudoPkt.full()) {
             AxisApp currAppChunk = siMEM_TxP_Data.read();
 
             AxisApp joinedChunk(0,0,0);  // [FIXME-Create a join method in AxisRaw]
@@ -1127,7 +1649,8 @@ void pTcpSegStitcher(
                 // The entire current chunk fits into the remainder of the previous chunk.
                 // We are done with this 2nd memory buffer.
                 joinedChunk.setLE_TLast(TLAST);
-                tss_fsmState = TSS_PSD_HDR;
+                tss_fsmState = (tss_nrRdsLeft == 1) ? TSS_PSD_HDR : TSS_DATA;
+                tss_nrRdsLeft--;
             }
             else if (currAppChunk.getLE_TLast()) {
                 // This cannot be the last chunk because it doesn't fit into the
@@ -1136,8 +1659,8 @@ void pTcpSegStitcher(
                 tss_fsmState = TSS_RESIDUE;
             }
 
-            soSca_PseudoPkt.write(joinedChunk);
-            if (DEBUG_LEVEL & TRACE_TSS) { printAxisRaw(myName, "soSca_PseudoPkt =", joinedChunk); }
+            soTca_PseudoPkt.write(joinedChunk);
+            if (DEBUG_LEVEL & TRACE_TSS) { printAxisRaw(myName, "soTca_PseudoPkt =", joinedChunk); }
 
             // Move remainder of current chunk to previous chunk
             tss_prevChunk.setLE_TData(currAppChunk.getLE_TData(64-1, 64-(int)tss_memRdOffset*8),
@@ -1148,174 +1671,335 @@ void pTcpSegStitcher(
         break;
     case TSS_RESIDUE:
         //-- Output the very last unaligned chunk
-        if (!soSca_PseudoPkt.full()) {
+        if (!soTca_PseudoPkt.full()) {
             AxisPsd4 lastChunk = AxisPsd4(0, 0, TLAST);
             lastChunk.setLE_TData(tss_prevChunk.getLE_TData(((int)tss_memRdOffset*8)-1, 0),
                                                             ((int)tss_memRdOffset*8)-1, 0);
             lastChunk.setLE_TKeep(tss_prevChunk.getLE_TKeep((int)tss_memRdOffset-1, 0),
                                                             (int)tss_memRdOffset-1, 0);
 
-            soSca_PseudoPkt.write(lastChunk);
-            if (DEBUG_LEVEL & TRACE_TSS) { printAxisRaw(myName, "soSca_PseudoPkt =", lastChunk); }
-            tss_fsmState = TSS_PSD_HDR;
+            soTca_PseudoPkt.write(lastChunk);
+            if (DEBUG_LEVEL & TRACE_TSS) { printAxisRaw(myName, "soTca_PseudoPkt =", lastChunk); }
+            tss_fsmState = (tss_nrRdsLeft == 1) ? TSS_PSD_HDR : TSS_DATA;
+            tss_nrRdsLeft--;
         }
         break;
-
-    #if (TCP_NODELAY)
-    case 6:
-        if (!txApp2txEng_data_stream.empty() && !soSca_PseudoPkt.full()) {
-            txApp2txEng_data_stream.read(currWord);
-            soSca_PseudoPkt.write(currWord);
-            if (currWord.last) {
-            	tps_state = 0;
-            }
-        }
-        break;
-    #endif
-    #if (TCP_NODELAY)
-    case 7:
-        if (!txEng_isDDRbypass.empty()) {
-            txEng_isDDRbypass.read(isShortCutData);
-            if (isShortCutData) {
-                tss_fsmState = 6;
-            }
-            else {
-                TSS_1ST_BUF;
-            }
-        }
-        break;
-    #endif
     } // End of: switch
 
 } // End of: pTcpSegStitcher
 
 /*******************************************************************************
- * @brief Sub-Checksum Accumulator (Sca)
+ * @brief TCP Checksum Accumulator (Tca)
  *
- * @param[in]  siTss_PseudoPkt Incoming data stream from Tc pSegment Stitcher (Tss).
+ * @param[in]  siTss_PseudoPkt Incoming data stream from Tcp Segment Stitcher (Tss).
+ * @param[in]  siMdl_CsumCmd   Source of the payload checksum from MetaDataLoader (Mdl).
+ * @param[in]  siTAi_CellCsum  Sum of a checksum cell of the Tx buffer from TxAppInterface (TAi).
+ * @param[in]  siBdf_Csum      Sum of a message bypassing the DDR from BypassDataFilter (Bdf).
  * @param[out] soIps_PseudoPkt Outgoing data stream to IP Packet Stitcher (Ips).
- * @param[out] soTca_4SubCsums Four sub-checksums to Tcp Checksum Accumulator (Tca).
+ * @param[out] soIps_TcpCsum   The computed checksum to IP Packet Stitcher (Ips).
  *
  * @details
  *  This process takes a TCP pseudo packet as input from the TcpSegmentStitcher
- *   (Tss) and forwards it to the IpPacketStitcher (Ips) while accumulating 4
- *    sub-checksums on the fly. When the the end-of-packet is detected, these 4
- *    sub-checksums are forwarded to the TcpChecksumAccumulator (Tca) for final
- *    checksum computation.
+ *   (Tss) and forwards it to the IpPacketStitcher (Ips) while accumulating the
+ *   TCP checksum on the fly. The checksum is forwarded to [Ips] before the
+ *   payload of the segment, such that [Ips] never has to wait for the end of a
+ *   segment and the stream towards [Ips] only holds the TCP header.
+ *  The sum of the header is completed with the sum of the payload, which comes
+ *   from one of three sources (see 'PaySrc'):
+ *   1) The sums of the checksum cells spanned by the payload, which [TAi]
+ *      computed while it wrote them into the Tx buffer, plus the sums of the
+ *      head and the tail pieces which [Mdl] had read ahead of the body (see
+ *      'setPayloadReads()'). The cell sums are kept in CELL_CSUM which costs 16
+ *      bits per cell (.i.e, 256Kb for 8 sessions of 256KB with 128B cells).
+ *      They are looked up one per cycle while the head and the tail are being
+ *      summed. These two pieces are held in TCA_BUF and are put back in front
+ *      of and after the body, which streams through. A chained head is not read
+ *      at all. Its sum is the sum of its cell minus the sum of the tail of the
+ *      previous payload (RFC-1624), which is kept in 'tca_prevTailSum'.
+ *   2) The sum of a message which bypassed the DDR, as computed by [TAi].
+ *   3) The sum of a payload shorter than two cells, which is held in TCA_BUF
+ *      until it is summed (.i.e, store-and-forward).
+ *  The cell sums are weighted by the parity of the buffer address of their
+ *   bytes (see [TAi]). Therefore, they are byte-swapped when the payload starts
+ *   at an odd address, and so is the sum of a tail before it is kept.
+ *  A cell sum is consumed only once the updates from [TAi] have been drained,
+ *   because [TAi] issues the sum of a cell before the memory write of that cell
+ *   completes, and therefore before the event that sends it.
  *******************************************************************************/
-void pSubChecksumAccumulators(
+void pTcpChecksumAccumulator(
         stream<AxisPsd4>    &siTss_PseudoPkt,
+        stream<TcaCmd>      &siMdl_CsumCmd,
+        stream<TxCellCsum>  &siTAi_CellCsum,
+        stream<Csum>        &siBdf_Csum,
         stream<AxisPsd4>    &soIps_PseudoPkt,
-        stream<SubCSums>    &soTca_4SubCsums)
+        stream<TcpChecksum> &soIps_TcpCsum)
 {
     //-- DIRECTIVES FOR THIS PROCESS -------------------------------------------
     #pragma HLS INLINE off
     #pragma HLS PIPELINE II=1 enable_flush
 
+    const char *myName  = concat3(THIS_NAME, "/", "Tca");
+
+    //-- STATIC ARRAYS ---------------------------------------------------------
+    static Csum                CELL_CSUM[TOE_MAX_SESSIONS*TOE_CSUM_CELLS];
+    #pragma HLS RESOURCE   variable=CELL_CSUM core=RAM_T2P_BRAM
+    #pragma HLS DEPENDENCE variable=CELL_CSUM inter false
+    //-- The head and the tail of a payload, or a payload shorter than two cells
+    static AxisPsd4            TCA_BUF[2*(TOE_CSUM_CELL_SIZE/8)+2];
+    #pragma HLS RESOURCE   variable=TCA_BUF core=RAM_T2P_BRAM
+    #pragma HLS DEPENDENCE variable=TCA_BUF inter false
+
     //-- STATIC CONTROL VARIABLES (with RESET) ---------------------------------
-    static bool                sca_doForwardChunk=false;
-    #pragma HLS RESET variable=sca_doForwardChunk
-    static ap_uint<17>         sca_4CSums[4]={0, 0, 0, 0};
-    #pragma HLS RESET variable=sca_4CSums
-    #pragma HLS ARRAY_PARTITION \
-                      variable=sca_4CSums complete dim=1
+    static enum FsmState { TCA_HDR=0,       TCA_PAY_SRC,     TCA_BYPASS_CSUM,
+                           TCA_HEAD,        TCA_TAIL,        TCA_STORE,
+                           TCA_CSUM,        TCA_FWD_BUF,     TCA_FWD_PAYLOAD } \
+                               tca_fsmState=TCA_HDR;
+    #pragma HLS RESET variable=tca_fsmState
+    static ap_uint<3>          tca_chunkCount=0;
+    #pragma HLS RESET variable=tca_chunkCount
+    static CsumAcc             tca_csumAcc=0;
+    #pragma HLS RESET variable=tca_csumAcc
+    static TxCellCnt           tca_nrCells=0;  // The cell sums left to look up
+    #pragma HLS RESET variable=tca_nrCells
+
+    //-- STATIC DATAFLOW VARIABLES ---------------------------------------------
+    static TcaCmd              tca_csumCmd;
+    static TxCellIdx           tca_cellIdx;
+    static CsumAcc             tca_cellAcc;     // The sum of the cells (.i.e, by buffer address)
+    static CsumAcc             tca_tailAcc;     // The sum of the tail (.i.e, by payload offset)
+    static Csum                tca_prevTailSum; // The sum of the last tail (.i.e, by buffer address)
+    static TxCellOff           tca_headLeft;    // The bytes of the head left to sum
+    static FlagBool            tca_isFirstChunk;
+    static ap_uint<TOE_CSUM_CELL_BITS-1> tca_bufWrIdx;
+    static ap_uint<TOE_CSUM_CELL_BITS-1> tca_bufRdIdx;
+    static ap_uint<TOE_CSUM_CELL_BITS-1> tca_bufEndIdx;
+    static ap_uint<TOE_CSUM_CELL_BITS-1> tca_headEndIdx;
 
     //-- DYNAMIC VARIABLES -----------------------------------------------------
     AxisPsd4 currPktChunk;
+    bool     isCellUpdate = !siTAi_CellCsum.empty();
+
+    //-----------------------------------------------------
+    //-- CELL UPDATE SIDE
+    //-----------------------------------------------------
+    if (isCellUpdate) {
+        TxCellCsum cellCsum = siTAi_CellCsum.read();
+        CELL_CSUM[cellCsum.sessId*TOE_CSUM_CELLS + cellCsum.cellIdx] = cellCsum.csum;
+    }
 
-    if (!siTss_PseudoPkt.empty()) {
-        siTss_PseudoPkt.read(currPktChunk);
-        if (sca_doForwardChunk) {
-            // We do not forward the first chunk of the pseudo-header
-            //  [FIXME] Consider forwarding all chunks and drop the 1st in the next process.
-            soIps_PseudoPkt.write(currPktChunk);
+    //-----------------------------------------------------
+    //-- CELL LOOKUP SIDE
+    //-----------------------------------------------------
+    if ((tca_nrCells != 0) and !isCellUpdate) {
+        Csum cellCsum = CELL_CSUM[tca_csumCmd.sessId*TOE_CSUM_CELLS + tca_cellIdx];
+        tca_cellAcc = csumAdd(tca_cellAcc, cellCsum);
+        tca_cellIdx++;
+        tca_nrCells--;
+    }
+
+    //-----------------------------------------------------
+    //-- SEGMENT SIDE
+    //-----------------------------------------------------
+    switch (tca_fsmState) {
+    case TCA_HDR:
+        //-- Sum and forward the chunks of the header (but the 1st one)
+        if (!siTss_PseudoPkt.empty()) {
+            siTss_PseudoPkt.read(currPktChunk);
+            if (tca_chunkCount != 0) {
+                // We do not forward the first chunk of the pseudo-header
+                soIps_PseudoPkt.write(currPktChunk);
+            }
+            CsumAcc csumAcc = csumAccumulate<ARW>(tca_csumAcc, currPktChunk);
+            if (currPktChunk.getTLast()) {
+                // This segment has no payload
+                TcpChecksum tcpCsum = csumFinalize(csumAcc);
+                if (DEBUG_LEVEL & TRACE_TCA) {
+                    printInfo(myName, "Checksum =0x%4.4X\n", tcpCsum.to_uint());
+                }
+                soIps_TcpCsum.write(tcpCsum);
+                tca_csumAcc = 0;
+                tca_chunkCount = 0;
+            }
+            else {
+                tca_csumAcc = csumAcc;
+                if ((tca_chunkCount == 3) and !currPktChunk.getTcpCtrlSyn() and
+                    (currPktChunk.getTcpDataOff() == 5)) {
+                    // A payload without any option follows (see [Tss])
+                    tca_fsmState = TCA_PAY_SRC;
+                    tca_chunkCount = 0;
+                }
+                else if (tca_chunkCount != 7) {
+                    tca_chunkCount++;
+                }
+            }
         }
-        for (int i = 0; i < 4; i++) {
-          #pragma HLS UNROLL
-            TcpCsum temp;
-            if (currPktChunk.getLE_TKeep(i*2+1, i*2) == 0x3) {
-                temp( 7, 0) = currPktChunk.getLE_TData(i*16+15, i*16+8);
-                temp(15, 8) = currPktChunk.getLE_TData(i*16+ 7, i*16);
-                sca_4CSums[i] += temp;
-                sca_4CSums[i] = (sca_4CSums[i] + (sca_4CSums[i] >> 16)) & 0xFFFF;
+        break;
+    case TCA_PAY_SRC:
+        //-- Select the source of the payload checksum
+        if (!siMdl_CsumCmd.empty()) {
+            siMdl_CsumCmd.read(tca_csumCmd);
+            tca_cellIdx      = tca_csumCmd.cellIdx;
+            tca_nrCells      = tca_csumCmd.nrCells;
+            tca_cellAcc      = (tca_csumCmd.isChained) ? (CsumAcc)(Csum)~tca_prevTailSum : (CsumAcc)0;
+            tca_tailAcc      = 0;
+            tca_headLeft     = tca_csumCmd.headLen;
+            tca_isFirstChunk = true;
+            tca_bufWrIdx     = 0;
+            switch (tca_csumCmd.src) {
+            case PAY_SRC_CELLS:
+                if (tca_csumCmd.headLen != 0) {
+                    tca_fsmState = TCA_HEAD;
+                }
+                else if (tca_csumCmd.hasTail) {
+                    tca_fsmState = TCA_TAIL;
+                }
+                else {
+                    tca_fsmState = TCA_CSUM;
+                }
+                break;
+            case PAY_SRC_BYPASS:
+                tca_fsmState = TCA_BYPASS_CSUM;
+                break;
+            default:
+                tca_fsmState = TCA_STORE;
+                break;
             }
-            else if (currPktChunk.getLE_TKeep()[i*2] == 0x1) {
-                temp( 7, 0) = 0;
-                temp(15, 8) = currPktChunk.getLE_TData(i*16+7, i*16);
-                sca_4CSums[i] += temp;
-                sca_4CSums[i] = (sca_4CSums[i] + (sca_4CSums[i] >> 16)) & 0xFFFF;
+        }
+        break;
+    case TCA_BYPASS_CSUM:
+        //-- Complete the checksum with the sum of a message bypassing the DDR
+        if (!siBdf_Csum.empty()) {
+            TcpChecksum tcpCsum = csumFinalize(csumAdd(tca_csumAcc, siBdf_Csum.read()));
+            if (DEBUG_LEVEL & TRACE_TCA) {
+                printInfo(myName, "Checksum =0x%4.4X (DDR bypass)\n", tcpCsum.to_uint());
             }
+            soIps_TcpCsum.write(tcpCsum);
+            tca_csumAcc = 0;
+            tca_fsmState = TCA_FWD_PAYLOAD;
         }
-
-        sca_doForwardChunk = true;
-
-        if(currPktChunk.getTLast()) {
-            soTca_4SubCsums.write(sca_4CSums);
-            sca_doForwardChunk = false;
-            sca_4CSums[0] = 0;
-            sca_4CSums[1] = 0;
-            sca_4CSums[2] = 0;
-            sca_4CSums[3] = 0;
+        break;
+    case TCA_HEAD:
+        //-- Sum the bytes in front of the first cell and hold the head piece
+        if (!siTss_PseudoPkt.empty()) {
+            siTss_PseudoPkt.read(currPktChunk);
+            LE_tKeep headKeep = (tca_headLeft >= 8) ? (LE_tKeep)0xFF : lenToLE_tKeep(tca_headLeft(3, 0));
+            tca_csumAcc  = csumAccumulate<ARW>(tca_csumAcc,
+                              AxisPsd4(currPktChunk.getLE_TData(), currPktChunk.getLE_TKeep() & headKeep, 0));
+            tca_headLeft = (tca_headLeft >= 8) ? (TxCellOff)(tca_headLeft - 8) : (TxCellOff)0;
+            TCA_BUF[tca_bufWrIdx++] = AxisPsd4(currPktChunk.getLE_TData(), currPktChunk.getLE_TKeep(), 0);
+            if (currPktChunk.getTLast()) {
+                tca_headEndIdx = tca_bufWrIdx;
+                tca_fsmState = (tca_csumCmd.hasTail) ? TCA_TAIL : TCA_CSUM;
+            }
         }
-    }
-} // End-of: Sca
-
-/*******************************************************************************
- * @brief TCP Checksum Accumulator (Tca)
- *
- * @param[in]  siSca_FourSubCsums The 4 sub-csums from the Sub-Checksum Accumulator (Sca).
- * @param[out] soIps_TcpCsum      The computed checksum to IP Packet Stitcher (Ips).
- *
- * @details
- *  Computes the final TCP checksum from the 4 accumulated sub-checksums and
- *   forwards the results to the  IP Packet Stitcher (Ips).
- *
- *******************************************************************************/
-void pTcpChecksumAccumulator(
-        stream<SubCSums>       &siSca_FourSubCsums,
-        stream<TcpChecksum>    &soIps_TcpCsum)
-{
-    //-- DIRECTIVES FOR THIS PROCESS -------------------------------------------
-    #pragma HLS INLINE off
-    #pragma HLS PIPELINE II=1 enable_flush
-
-    const char *myName  = concat3(THIS_NAME, "/", "Tca");
-
-    if (!siSca_FourSubCsums.empty()) {
-        SubCSums tca_4CSums = siSca_FourSubCsums.read();
-
-        tca_4CSums.sum0 += tca_4CSums.sum2;
-        tca_4CSums.sum1 += tca_4CSums.sum3;
-        tca_4CSums.sum0 = (tca_4CSums.sum0 + (tca_4CSums.sum0 >> 16)) & 0xFFFF;
-        tca_4CSums.sum1 = (tca_4CSums.sum1 + (tca_4CSums.sum1 >> 16)) & 0xFFFF;
-        tca_4CSums.sum0 += tca_4CSums.sum1;
-        tca_4CSums.sum0 = (tca_4CSums.sum0 + (tca_4CSums.sum0 >> 16)) & 0xFFFF;
-        tca_4CSums.sum0 = ~tca_4CSums.sum0;
-
-        if (DEBUG_LEVEL & TRACE_TCA) {
-            printInfo(myName, "Checksum =0x%4.4X\n", tca_4CSums.sum0.to_uint());
+        break;
+    case TCA_TAIL:
+        //-- Sum the bytes after the last cell and hold the tail piece
+        if (!siTss_PseudoPkt.empty()) {
+            siTss_PseudoPkt.read(currPktChunk);
+            LE_tKeep tailKeep = (tca_isFirstChunk) ? (LE_tKeep)~lenToLE_tKeep(tca_csumCmd.tailSkip) : (LE_tKeep)0xFF;
+            tca_tailAcc = csumAccumulate<ARW>(tca_tailAcc,
+                             AxisPsd4(currPktChunk.getLE_TData(), currPktChunk.getLE_TKeep() & tailKeep, 0));
+            tca_isFirstChunk = false;
+            TCA_BUF[tca_bufWrIdx++] = currPktChunk;
+            if (currPktChunk.getTLast()) {
+                tca_fsmState = TCA_CSUM;
+            }
         }
-        soIps_TcpCsum.write(tca_4CSums.sum0);
-    }
-}
+        break;
+    case TCA_STORE:
+        //-- Sum and hold a payload shorter than two cells
+        if (!siTss_PseudoPkt.empty()) {
+            siTss_PseudoPkt.read(currPktChunk);
+            tca_csumAcc = csumAccumulate<ARW>(tca_csumAcc, currPktChunk);
+            TCA_BUF[tca_bufWrIdx++] = currPktChunk;
+            if (currPktChunk.getTLast()) {
+                tca_fsmState = TCA_CSUM;
+            }
+        }
+        break;
+    case TCA_CSUM:
+        //-- Complete the checksum once all the cell sums were looked up
+        if (tca_nrCells == 0) {
+            Csum cellCsum = csumFold(tca_cellAcc);
+            Csum tailCsum = csumFold(tca_tailAcc);
+            if (tca_csumCmd.isOddAdr) {
+                // The bytes at an even buffer address sit at an odd payload offset
+                cellCsum = byteSwap16(cellCsum);
+                tailCsum = byteSwap16(tailCsum);
+            }
+            TcpChecksum tcpCsum = csumFinalize(csumAdd(csumAdd(tca_csumAcc, tca_tailAcc), cellCsum));
+            if (DEBUG_LEVEL & TRACE_TCA) {
+                printInfo(myName, "Checksum =0x%4.4X (%d cells of session #%d)\n", tcpCsum.to_uint(),
+                          tca_csumCmd.nrCells.to_uint(), tca_csumCmd.sessId.to_uint());
+            }
+            soIps_TcpCsum.write(tcpCsum);
+            if (tca_csumCmd.hasTail) {
+                tca_prevTailSum = tailCsum;
+            }
+            tca_csumAcc   = 0;
+            tca_bufRdIdx  = 0;
+            if (tca_csumCmd.src == PAY_SRC_STORE) {
+                tca_bufEndIdx = tca_bufWrIdx;
+                tca_fsmState  = TCA_FWD_BUF;
+            }
+            else if (tca_csumCmd.headLen != 0) {
+                tca_bufEndIdx = tca_headEndIdx;
+                tca_fsmState  = TCA_FWD_BUF;
+            }
+            else {
+                tca_fsmState  = TCA_FWD_PAYLOAD;
+            }
+        }
+        break;
+    case TCA_FWD_BUF:
+        //-- Forward a held piece (.i.e, the head, the tail or a short payload)
+        currPktChunk = TCA_BUF[tca_bufRdIdx];
+        soIps_PseudoPkt.write(currPktChunk);
+        tca_bufRdIdx++;
+        if (tca_bufRdIdx == tca_bufEndIdx) {
+            // The tail and a short payload end with TLAST, but the head does not
+            tca_fsmState = (currPktChunk.getTLast()) ? TCA_HDR : TCA_FWD_PAYLOAD;
+        }
+        break;
+    case TCA_FWD_PAYLOAD:
+        //-- Forward the payload (.i.e, the body or a message bypassing the DDR)
+        if (!siTss_PseudoPkt.empty()) {
+            siTss_PseudoPkt.read(currPktChunk);
+            if (currPktChunk.getTLast()) {
+                if ((tca_csumCmd.src == PAY_SRC_CELLS) and tca_csumCmd.hasTail) {
+                    // The tail follows the body
+                    currPktChunk.setTLast(0);
+                    tca_bufEndIdx = tca_bufWrIdx;
+                    tca_fsmState  = TCA_FWD_BUF;
+                }
+                else {
+                    tca_fsmState  = TCA_HDR;
+                }
+            }
+            soIps_PseudoPkt.write(currPktChunk);
+        }
+        break;
+    } // End of: switch
+} // End-of: Tca
 
 /*******************************************************************************
  * @brief IPv4 Packet Stitcher (Ips)
  *
  * @param[in]  siIhc_IpHeader  IP4 header stream from IP Header Constructor (Ihc).
- * @param[in]  siSca_PseudoPkt TCP pseudo packet stream from Sub Checksum Accumulator (Sca).
+ * @param[in]  siTca_PseudoPkt TCP pseudo packet stream from TCP Checksum Accumulator (Tca).
  * @param[in]  siTca_TcpCsum   TCP checksum from TCP Checksum Accumulator (Tca).
  * @param[out] soIPTX_Data     Packet stream to IPv4 Tx Handler (IPTX).
  *
  * @details
  *  Assembles an IPv4 packet from the incoming IP header stream and the TCP
- *   pseudo data packet stream from Sub Checksum Accumulator (Sca).
+ *   pseudo data packet stream from TCP Checksum Accumulator (Tca).
  *  This process also inserts the IPv4 header checksum and the TCP checksum.
  *  This is the actual IPv4 packet being streamed out by the TCP Offload Engine.
  *******************************************************************************/
 void pIpPktStitcher(
         stream<AxisIp4>         &siIhc_IpHeader,
-        stream<AxisPsd4>        &siSca_PseudoPkt,
+        stream<AxisPsd4>        &siTca_PseudoPkt,
         stream<TcpChecksum>     &siTca_TcpCsum,
         stream<AxisIp4>         &soIPTX_Data)
 {
@@ -1348,9 +2032,9 @@ void pIpPktStitcher(
         break;
     case CHUNK_2:
         // Start concatenating IPv4 header and TCP segment
-        if (!siIhc_IpHeader.empty() && !siSca_PseudoPkt.empty() and !soIPTX_Data.full()) {
+        if (!siIhc_IpHeader.empty() && !siTca_PseudoPkt.empty() and !soIPTX_Data.full()) {
             siIhc_IpHeader.read(ip4HdrChunk);
-            siSca_PseudoPkt.read(tcpPsdChunk);
+            siTca_PseudoPkt.read(tcpPsdChunk);
             currChunk.setIp4DstAddr(ip4HdrChunk.getIp4DstAddr());
             currChunk.setTcpSrcPort(tcpPsdChunk.getTcpSrcPort());
             currChunk.setTcpDstPort(tcpPsdChunk.getTcpDstPort());
@@ -1360,8 +2044,8 @@ void pIpPktStitcher(
         }
         break;
     case CHUNK_3:
-        if (!siSca_PseudoPkt.empty() and !soIPTX_Data.full()) {
-            siSca_PseudoPkt.read(tcpPsdChunk);
+        if (!siTca_PseudoPkt.empty() and !soIPTX_Data.full()) {
+            siTca_PseudoPkt.read(tcpPsdChunk);
             currChunk.setTcpSeqNum(tcpPsdChunk.getTcpSeqNum());
             currChunk.setTcpAckNum(tcpPsdChunk.getTcpAckNum());
             soIPTX_Data.write(currChunk);
@@ -1370,8 +2054,8 @@ void pIpPktStitcher(
         }
         break;
     case CHUNK_4:
-        if (!siSca_PseudoPkt.empty() and !siTca_TcpCsum.empty() and !soIPTX_Data.full()) {
-            siSca_PseudoPkt.read(tcpPsdChunk);
+        if (!siTca_PseudoPkt.empty() and !siTca_TcpCsum.empty() and !soIPTX_Data.full()) {
+            siTca_PseudoPkt.read(tcpPsdChunk);
             siTca_TcpCsum.read(tcpCsum);
             // Get CtrlBits & Window & TCP UrgPtr & Checksum
             currChunk = tcpPsdChunk;
@@ -1387,8 +2071,8 @@ void pIpPktStitcher(
         }
         break;
     default:
-        if (!siSca_PseudoPkt.empty() and !soIPTX_Data.full()) {
-            siSca_PseudoPkt.read(tcpPsdChunk);  // TCP Data
+        if (!siTca_PseudoPkt.empty() and !soIPTX_Data.full()) {
+            siTca_PseudoPkt.read(tcpPsdChunk);  // TCP Data
             currChunk = tcpPsdChunk;
             soIPTX_Data.write(currChunk);
             if (DEBUG_LEVEL & TRACE_IPS) { printAxisRaw(myName, "soIPTX_Data =", currChunk); }
@@ -1412,8 +2096,9 @@ void pIpPktStitcher(
  *  This process receives a read command from the MetaDataLoader (Mdl) and
  *  forwards it to the AXI4 Data Mover. The incoming memory read command might
  *  end-up being split in two memory accesses if the address of the data buffer
- *  to read from wraps in the external memory. Such a split memory access is
- *  flagged by the signal 'soTss_SplitMemAcc'.
+ *  to read from wraps in the external memory or crosses a buffer page (see
+ *  'TOE_BUFFER_PAGING'). Such a split memory access is flagged by the signal
+ *  'soTss_SplitMemAcc'.
  *
  *******************************************************************************/
 void pTxMemoryReader(
@@ -1442,9 +2127,10 @@ void pTxMemoryReader(
         if (!siMdl_BufferRdCmd.empty() and !soTss_SplitMemAcc.full() and !soMEM_TxpRdCmd.full()) {
             siMdl_BufferRdCmd.read(mrd_memRdCmd);
 
-            if ((mrd_memRdCmd.saddr(TOE_WINDOW_BITS-1, 0) + mrd_memRdCmd.btt) > TOE_TX_BUFFER_SIZE) {
+            if (crossesPage(mrd_memRdCmd.saddr(TOE_WINDOW_BITS-1, 0), mrd_memRdCmd.btt)) {
                 // This segment was broken in two memory accesses because TCP Tx memory buffer wrapped around
-                mrd_firstAccLen = TOE_TX_BUFFER_SIZE - mrd_memRdCmd.saddr;
+                // or because the segment crosses a page boundary
+                mrd_firstAccLen = TOE_PAGE_SIZE - mrd_memRdCmd.saddr(TOE_PAGE_BITS-1, 0);
                 mrd_fsmState = MRD_2ND_ACCESS;
 
                 soMEM_TxpRdCmd.write(DmCmd(mrd_memRdCmd.saddr, mrd_firstAccLen));
@@ -1471,8 +2157,8 @@ void pTxMemoryReader(
         break;
     case MRD_2ND_ACCESS:
         if (!soMEM_TxpRdCmd.full()) {
-            // Update the command to account for the Tx buffer wrap around
-            mrd_memRdCmd.saddr(TOE_WINDOW_BITS-1, 0) = 0;
+            // Update the command to account for the Tx buffer wrap around or the next page
+            mrd_memRdCmd.saddr(TOE_WINDOW_BITS-1, 0) = getNextPageAdr(mrd_memRdCmd.saddr(TOE_WINDOW_BITS-1, 0));
             soMEM_TxpRdCmd.write(DmCmd(mrd_memRdCmd.saddr, mrd_memRdCmd.btt - mrd_firstAccLen));
             mrd_fsmState = MRD_1ST_ACCESS;
 
@@ -1487,6 +2173,87 @@ void pTxMemoryReader(
     }
 }
 
+/*******************************************************************************
+ * @brief Bypass Data Filter (Bdf)
+ *
+ * @param[in]  siTAi_Data      APP data bypassing the DDR from TxAppInterface (TAi).
+ * @param[in]  siMdl_KeepData  Keep or drop the data of a message from MetaDataLoader (Mdl).
+ * @param[out] soTss_Data      TCP data payload to TcpSegmentStitcher (Tss).
+ * @param[in]  siTAi_Csum      Sum of a message bypassing the DDR from [TAi].
+ * @param[in]  siMdl_KeepCsum  Keep or drop the sum of a message from [Mdl].
+ * @param[out] soTca_Csum      Sum of a message sent right away to TcpChecksumAccumulator (Tca).
+ *
+ * @details
+ *  The data of every message flagged for the DDR bypass by [TAi] are streamed
+ *   into this process while they are being written into DDR. For each of these
+ *   messages, [Mdl] tells if it was sent right away, in which case the data are
+ *   forwarded to [Tss], or if it will be read back from DDR later on, in which
+ *   case the data are dropped. The dropping occurs here rather than in [Tss]
+ *   to prevent the bypass stream from backpressuring the memory writer of [TAi].
+ *  The sum of every such message is filtered the same way by a side of its own,
+ *   because [Tca] needs the sum of a message before its first data chunk while
+ *   [TAi] issues it along with the last one.
+ *******************************************************************************/
+void pBypassDataFilter(
+        stream<AxisApp>     &siTAi_Data,
+        stream<FlagBool>    &siMdl_KeepData,
+        stream<AxisApp>     &soTss_Data,
+        stream<Csum>        &siTAi_Csum,
+        stream<FlagBool>    &siMdl_KeepCsum,
+        stream<Csum>        &soTca_Csum)
+{
+    //-- DIRECTIVES FOR THIS PROCESS -------------------------------------------
+    #pragma HLS INLINE off
+    #pragma HLS PIPELINE II=1 enable_flush
+
+    const char *myName  = concat3(THIS_NAME, "/", "Bdf");
+
+    //-- STATIC CONTROL VARIABLES (with RESET) ---------------------------------
+    static enum FsmState { BDF_IDLE=0, BDF_STREAM } \
+                               bdf_fsmState=BDF_IDLE;
+    #pragma HLS RESET variable=bdf_fsmState
+
+    //-- STATIC DATAFLOW VARIABLES ---------------------------------------------
+    static FlagBool     bdf_keepData;
+
+    //-----------------------------------------------------
+    //-- CHECKSUM SIDE
+    //-----------------------------------------------------
+    if (!siMdl_KeepCsum.empty() and !siTAi_Csum.empty() and !soTca_Csum.full()) {
+        FlagBool keepCsum = siMdl_KeepCsum.read();
+        Csum     msgCsum  = siTAi_Csum.read();
+        if (keepCsum) {
+            soTca_Csum.write(msgCsum);
+        }
+    }
+
+    //-----------------------------------------------------
+    //-- DATA SIDE
+    //-----------------------------------------------------
+    switch (bdf_fsmState) {
+    case BDF_IDLE:
+        if (!siMdl_KeepData.empty()) {
+            siMdl_KeepData.read(bdf_keepData);
+            bdf_fsmState = BDF_STREAM;
+        }
+        break;
+    case BDF_STREAM:
+        if (!siTAi_Data.empty() and (!bdf_keepData or !soTss_Data.full())) {
+            AxisApp currChunk = siTAi_Data.read();
+            if (bdf_keepData) {
+                soTss_Data.write(currChunk);
+            }
+            if (DEBUG_LEVEL & TRACE_BDF) {
+                printAxisRaw(myName, (bdf_keepData) ? "soTss_Data =" : "Dropping  =", currChunk);
+            }
+            if (currChunk.getTLast()) {
+                bdf_fsmState = BDF_IDLE;
+            }
+        }
+        break;
+    }
+}
+
 /*******************************************************************************
  * @brief Transmit Engine (TXe)
  *
@@ -1498,6 +2265,9 @@ void pTxMemoryReader(
  * @param[in]  siTSt_TxSarRep      TxSar reply from [TSt].
  * @param[out] soMEM_Txp_RdCmd     Memory read command to the DRAM Memory (MEM).
  * @param[in]  siMEM_TxP_Data      Data payload from the DRAM Memory (MEM).
+ * @param[in]  siTAi_Data          Data payload bypassing the DRAM from TxAppInterface (TAi).
+ * @param[in]  siTAi_CellCsum      Sum of a checksum cell of the Tx buffer from [TAi].
+ * @param[in]  siTAi_BypassCsum    Sum of a message bypassing the DRAM from [TAi].
  * @param[out] soTIm_ReTxTimerCmd  Send retransmit timer command to [Timers].
  * @param[out] soTIm_SetProbeTimer Set probe timer to Timers (TIm).
  * @param[out] soSLc_ReverseLkpReq Reverse lookup request to Session Lookup Controller (SLc).
@@ -1512,6 +2282,12 @@ void pTxMemoryReader(
  *   packet contains any payload, the data are retrieved from the DDR4 memory
  *   and are put as a TCP segment into the IPv4 packet. The complete packet is
  *   then streamed out over the IPv4 Tx interface of the TOE (.i.e, soIPTX).
+ *  A small message of the application may also bypass the DDR4 memory. Its
+ *   data are then taken from [TAi] while they are still being written into the
+ *   memory (see TOE_TCP_NODELAY).
+ *  The TCP checksum is inserted without storing a segment, because it is known
+ *   before the payload is streamed (see [Tca]). Only a payload shorter than two
+ *   checksum cells is stored while it is summed.
  *
  *******************************************************************************/
 void tx_engine(
@@ -1527,6 +2303,10 @@ void tx_engine(
         //-- MEM / Tx Read Path Interface
         stream<DmCmd>                   &soMEM_Txp_RdCmd,
         stream<AxisApp>                 &siMEM_TxP_Data,
+        //-- Tx Application Interface / DDR Bypass
+        stream<AxisApp>                 &siTAi_Data,
+        stream<TxCellCsum>              &siTAi_CellCsum,
+        stream<Csum>                    &siTAi_BypassCsum,
         //-- Timers Interface
         stream<TXeReTransTimerCmd>      &soTIm_ReTxTimerCmd,
         stream<SessionId>               &soTIm_SetProbeTimer,
@@ -1547,15 +2327,30 @@ void tx_engine(
     //--------------------------------------------------------------------------
     //-- Meta Data Loader (Mdl)
     //--------------------------------------------------------------------------
-    static stream<TcpDatLen>            ssMdlToIhc_TcpDatLen    ("ssMdlToIhc_TcpDatLen");
-    #pragma HLS stream         variable=ssMdlToIhc_TcpDatLen    depth=16
+    static stream<IhcMeta>              ssMdlToIhc_Meta         ("ssMdlToIhc_Meta");
+    #pragma HLS stream         variable=ssMdlToIhc_Meta         depth=16
+    #pragma HLS DATA_PACK      variable=ssMdlToIhc_Meta
 
     static stream<TXeMeta>              ssMdlToPhc_TxeMeta      ("ssMdlToPhc_TxeMeta");
     #pragma HLS stream         variable=ssMdlToPhc_TxeMeta      depth=16
     #pragma HLS DATA_PACK      variable=ssMdlToPhc_TxeMeta
 
-    static stream<bool>                 ssMdlToSpS_IsLookup     ("ssMdlToSpS_IsLookup");
+    static stream<SpsCmd>               ssMdlToSpS_IsLookup     ("ssMdlToSpS_IsLookup");
     #pragma HLS stream         variable=ssMdlToSpS_IsLookup     depth=4
+    #pragma HLS DATA_PACK      variable=ssMdlToSpS_IsLookup
+
+    static stream<PayRdCnt>             ssMdlToTss_PayRdCnt     ("ssMdlToTss_PayRdCnt");
+    #pragma HLS stream         variable=ssMdlToTss_PayRdCnt     depth=32
+
+    static stream<TcaCmd>               ssMdlToTca_CsumCmd      ("ssMdlToTca_CsumCmd");
+    #pragma HLS stream         variable=ssMdlToTca_CsumCmd      depth=32
+    #pragma HLS DATA_PACK      variable=ssMdlToTca_CsumCmd
+
+    static stream<FlagBool>             ssMdlToBdf_KeepData     ("ssMdlToBdf_KeepData");
+    #pragma HLS stream         variable=ssMdlToBdf_KeepData     depth=4
+
+    static stream<FlagBool>             ssMdlToBdf_KeepCsum     ("ssMdlToBdf_KeepCsum");
+    #pragma HLS stream         variable=ssMdlToBdf_KeepCsum     depth=4
 
     static stream<DmCmd>                ssMdlToMrd_BufferRdCmd  ("ssMdlToMrd_BufferRdCmd");
     #pragma HLS stream         variable=ssMdlToMrd_BufferRdCmd  depth=32
@@ -1593,9 +2388,9 @@ void tx_engine(
     //-------------------------------------------------------------------------
     //-- TCP Segment Stitcher (Tss)
     //-------------------------------------------------------------------------
-    static stream<AxisPsd4>             ssTssToSca_PseudoPkt    ("ssTssToSca_PseudoPkt");
-    #pragma HLS stream         variable=ssTssToSca_PseudoPkt    depth=16
-    #pragma HLS DATA_PACK      variable=ssTssToSca_PseudoPkt
+    static stream<AxisPsd4>             ssTssToTca_PseudoPkt    ("ssTssToTca_PseudoPkt");
+    #pragma HLS stream         variable=ssTssToTca_PseudoPkt    depth=16
+    #pragma HLS DATA_PACK      variable=ssTssToTca_PseudoPkt
 
     //-------------------------------------------------------------------------
     //-- TCP Checksum Accumulator (Tca)
@@ -1603,16 +2398,9 @@ void tx_engine(
     static stream<TcpChecksum>          ssTcaToIps_TcpCsum      ("ssTcaToIps_TcpCsum");
     #pragma HLS stream         variable=ssTcaToIps_TcpCsum      depth=4
 
-    //-------------------------------------------------------------------------
-    //-- Sub-Checksum Accumulator (Sca)
-    //-------------------------------------------------------------------------
-    static stream<AxisPsd4>             ssScaToIps_PseudoPkt    ("ssScaToIps_PseudoPkt");
-    #pragma HLS stream         variable=ssScaToIps_PseudoPkt    depth=256  // WARNING: Critical; has to keep complete packet for checksum computation
-    #pragma HLS DATA_PACK      variable=ssScaToIps_PseudoPkt
-
-    static stream<SubCSums>             ssScaToTca_FourSubCsums ("ssScaToTca_FourSubCsums");
-    #pragma HLS stream         variable=ssScaToTca_FourSubCsums depth=2
-    #pragma HLS DATA_PACK      variable=ssScaToTca_FourSubCsums
+    static stream<AxisPsd4>             ssTcaToIps_PseudoPkt    ("ssTcaToIps_PseudoPkt");
+    #pragma HLS stream         variable=ssTcaToIps_PseudoPkt    depth=16  // Must hold the TCP header and its options
+    #pragma HLS DATA_PACK      variable=ssTcaToIps_PseudoPkt
 
     //------------------------------------------------------------------------
     //-- Memory Reader (Mrd)
@@ -1620,6 +2408,16 @@ void tx_engine(
     static stream<FlagBool>             ssMrdToTss_SplitMemAcc  ("ssMrdToTss_SplitMemAcc");
     #pragma HLS stream         variable=ssMrdToTss_SplitMemAcc  depth=32
 
+    //------------------------------------------------------------------------
+    //-- Bypass Data Filter (Bdf)
+    //------------------------------------------------------------------------
+    static stream<AxisApp>              ssBdfToTss_Data         ("ssBdfToTss_Data");
+    #pragma HLS stream         variable=ssBdfToTss_Data         depth=16
+    #pragma HLS DATA_PACK      variable=ssBdfToTss_Data
+
+    static stream<Csum>                 ssBdfToTca_Csum         ("ssBdfToTca_Csum");
+    #pragma HLS stream         variable=ssBdfToTca_Csum         depth=4
+
     //-------------------------------------------------------------------------
     //-- PROCESS FUNCTIONS
     //-------------------------------------------------------------------------
@@ -1632,11 +2430,15 @@ void tx_engine(
             siTSt_TxSarRep,
             soTIm_ReTxTimerCmd,
             soTIm_SetProbeTimer,
-            ssMdlToIhc_TcpDatLen,
+            ssMdlToIhc_Meta,
             ssMdlToPhc_TxeMeta,
             ssMdlToMrd_BufferRdCmd,
             soSLc_ReverseLkpReq,
             ssMdlToSpS_IsLookup,
+            ssMdlToTss_PayRdCnt,
+            ssMdlToTca_CsumCmd,
+            ssMdlToBdf_KeepData,
+            ssMdlToBdf_KeepCsum,
             ssMdlToSps_RstSockPair,
             soEVe_RxEventSig);
     
@@ -1645,6 +2447,14 @@ void tx_engine(
             soMEM_Txp_RdCmd,
             ssMrdToTss_SplitMemAcc);
 
+    pBypassDataFilter(
+            siTAi_Data,
+            ssMdlToBdf_KeepData,
+            ssBdfToTss_Data,
+            siTAi_BypassCsum,
+            ssMdlToBdf_KeepCsum,
+            ssBdfToTca_Csum);
+
     pSocketPairSplitter(
             siSLc_ReverseLkpRep,
             ssMdlToSps_RstSockPair,
@@ -1653,13 +2463,13 @@ void tx_engine(
             ssSpsToPhc_SockPair);
 
     pIpHeaderConstructor(
-            ssMdlToIhc_TcpDatLen,
+            ssMdlToIhc_Meta,
             ssSpsToIhc_IpAddrPair,
             ssIhcToIps_IpHeader);
 
     pIpPktStitcher(
             ssIhcToIps_IpHeader,
-            ssScaToIps_PseudoPkt,
+            ssTcaToIps_PseudoPkt,
             ssTcaToIps_TcpCsum,
             soIPTX_Data);
 
@@ -1671,16 +2481,17 @@ void tx_engine(
     pTcpSegStitcher(
             ssPhcToTss_PseudoHdr,
             siMEM_TxP_Data,
-            ssTssToSca_PseudoPkt,
+            ssMdlToTss_PayRdCnt,
+            ssBdfToTss_Data,
+            ssTssToTca_PseudoPkt,
             ssMrdToTss_SplitMemAcc);
 
-    pSubChecksumAccumulators(
-            ssTssToSca_PseudoPkt,
-            ssScaToIps_PseudoPkt,
-            ssScaToTca_FourSubCsums);
-
     pTcpChecksumAccumulator(
-            ssScaToTca_FourSubCsums,
+            ssTssToTca_PseudoPkt,
+            ssMdlToTca_CsumCmd,
+            siTAi_CellCsum,
+            ssBdfToTca_Csum,
+            ssTcaToIps_PseudoPkt,
             ssTcaToIps_TcpCsum);
 
 }
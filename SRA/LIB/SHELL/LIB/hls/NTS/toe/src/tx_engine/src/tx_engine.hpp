@@ -80,32 +80,112 @@ class TXeMeta {
     ap_uint<1>  rst;
     ap_uint<1>  syn;
     ap_uint<1>  fin;
+    FlagBool    sackOk;   // Append a SACK-Permitted option to a SYN
+    SackCnt     sackCnt;  // Append a SACK option with this number of blocks
+    SackBlock   sackBlk[TOE_SACK_BLOCKS];
+    FlagBool    winScaleOk; // Append a Window Scale option to a SYN
+    ap_uint<1>  ece;      // ECN-Echo (or ECN-setup on a SYN) flag (RFC-3168)
+    ap_uint<1>  cwr;      // Congestion Window Reduced (or ECN-setup on a SYN) flag
     TXeMeta() {}
     TXeMeta(ap_uint<1> ack, ap_uint<1> rst, ap_uint<1> syn, ap_uint<1> fin)
-        : seqNumb(0), ackNumb(0), winSize(0), length(0), ack(ack), rst(rst), syn(syn), fin(fin) {}
+        : seqNumb(0), ackNumb(0), winSize(0), length(0), ack(ack), rst(rst), syn(syn), fin(fin), sackOk(false), sackCnt(0), winScaleOk(false), ece(0), cwr(0) {}
     TXeMeta(TcpSeqNum seqNumb, TcpAckNum ackNumb, ap_uint<1> ack, ap_uint<1> rst, ap_uint<1> syn, ap_uint<1> fin)
-        : seqNumb(seqNumb), ackNumb(ackNumb), winSize(0), length(0), ack(ack), rst(rst), syn(syn), fin(fin) {}
+        : seqNumb(seqNumb), ackNumb(ackNumb), winSize(0), length(0), ack(ack), rst(rst), syn(syn), fin(fin), sackOk(false), sackCnt(0), winScaleOk(false), ece(0), cwr(0) {}
     TXeMeta(TcpSeqNum seqNumb, TcpAckNum ackNumb, TcpWindow winSize, ap_uint<1> ack, ap_uint<1> rst, ap_uint<1> syn, ap_uint<1> fin)
-        : seqNumb(seqNumb), ackNumb(ackNumb), winSize(winSize), length(0), ack(ack), rst(rst), syn(syn), fin(fin) {}
+        : seqNumb(seqNumb), ackNumb(ackNumb), winSize(winSize), length(0), ack(ack), rst(rst), syn(syn), fin(fin), sackOk(false), sackCnt(0), winScaleOk(false), ece(0), cwr(0) {}
 };
 
 
 /********************************************
- * TXe - A set of 4 TCP Sub-Checksums
+ * TXe - Segmentation Offload (TSO)
+ *  A TX event is sent as a burst of back-to-back
+ *  MSS segments. Only the first segment of a burst
+ *  fetches the socket pair of the session and arms
+ *  the retransmission timer.
  ********************************************/
-struct SubCSums
-{
-    ap_uint<17>     sum0;
-    ap_uint<17>     sum1;
-    ap_uint<17>     sum2;
-    ap_uint<17>     sum3;
-    SubCSums() {}
-    SubCSums(ap_uint<17> sums[4]) :
-        sum0(sums[0]), sum1(sums[1]), sum2(sums[2]), sum3(sums[3]) {}
-    SubCSums(ap_uint<17> s0, ap_uint<17> s1, ap_uint<17> s2, ap_uint<17> s3) :
-        sum0(s0), sum1(s1), sum2(s2), sum3(s3) {}
+#define TXE_RT_MAX_SEGS  4  // Max. number of segments retransmitted per RT event
+
+typedef ap_uint<16> TsoSegCnt;  // A number of segments in a burst
+
+/********************************************
+ * TXe - Socket Pair Cache
+ *  The socket pair of a session is looked up in
+ *  [SLc] upon its SYN, SYN_ACK or RST segment and
+ *  upon its first segment after a reset. It is then
+ *  kept by [Sps] and the next events of the session
+ *  do not access [SLc] anymore.
+ ********************************************/
+enum SpsOp { SPS_RST_PAIR=0,    // Use the socket pair of a RST or SYN cookie event
+             SPS_LOOKUP,        // Use the socket pair returned by [SLc] and cache it
+             SPS_CACHED,        // Use the socket pair cached for the session
+             SPS_REUSE          // Use the socket pair of the previous segment
+           };
+
+//-- The command of the Socket Pair Splitter (Sps)
+class SpsCmd {
+  public:
+    SpsOp       op;
+    SessionId   sessId;
+    SpsCmd() {}
+    SpsCmd(SpsOp op) :
+        op(op), sessId(0) {}
+    SpsCmd(SpsOp op, SessionId sessId) :
+        op(op), sessId(sessId) {}
 };
 
+/********************************************
+ * TXe - Source of the Payload Checksum
+ *  The TCP checksum is forwarded ahead of the
+ *  payload of a segment. It is built from the
+ *  sums of the checksum cells spanned by the
+ *  payload and from the partial sums of its
+ *  unaligned head and tail, from the sum of the
+ *  message when it bypasses the DDR, and from
+ *  the payload itself when it is too short to
+ *  span a whole cell.
+ ********************************************/
+enum PaySrc { PAY_SRC_CELLS=0,  // The sums of the cells plus the head and the tail
+              PAY_SRC_BYPASS,   // A message bypassing the DDR
+              PAY_SRC_STORE     // A short payload stored and summed by [Tca]
+            };
+
+typedef ap_uint<2>  PayRdCnt;   // The number of memory reads of a payload (0 when bypassing the DDR)
+typedef ap_uint<TOE_CSUM_CELL_BITS>   TxCellOff;  // A byte offset within a cell
+typedef ap_uint<TOE_WINDOW_BITS-TOE_CSUM_CELL_BITS+1> TxCellCnt;  // A number of cells
+
+//-- The command of the TCP Checksum Accumulator (Tca)
+class TcaCmd {
+  public:
+    PaySrc      src;
+    SessionId   sessId;
+    TxCellIdx   cellIdx;    // The first cell to sum
+    TxCellCnt   nrCells;    // The number of cells to sum
+    TxCellOff   headLen;    // The bytes to sum in the head read (0 when it is not read)
+    ap_uint<3>  tailSkip;   // The bytes to skip in the tail read
+    FlagBool    hasTail;    // The payload ends with a tail read
+    FlagBool    isChained;  // The head is the 1st cell minus the tail of the previous segment
+    FlagBool    isOddAdr;   // The payload starts at an odd buffer address
+    TcaCmd() {}
+    TcaCmd(PaySrc src) :
+        src(src), sessId(0), cellIdx(0), nrCells(0), headLen(0), tailSkip(0),
+        hasTail(false), isChained(false), isOddAdr(false) {}
+};
+
+/********************************************
+ * TXe - IPv4 Header Metadata
+ *  The TCP data length of a segment and whether
+ *  it is sent as ECN-capable (ECT) or not.
+ ********************************************/
+class IhcMeta {
+  public:
+    TcpDatLen   length;
+    FlagBool    ect;
+    IhcMeta() {}
+    IhcMeta(TcpDatLen length) :
+        length(length), ect(false) {}
+    IhcMeta(TcpDatLen length, FlagBool ect) :
+        length(length), ect(ect) {}
+};
 
 /********************************************
  * TXe - Pair of {Src,Dst} IPv4 Addresses
@@ -119,6 +199,39 @@ class IpAddrPair {
         src(src), dst(dst) {}
 };
 
+/********************************************
+ * TXe - MetaData Loader (also used by the TB)
+ ********************************************/
+void pMetaDataLoader(
+        stream<ExtendedEvent>           &siAKd_Event,
+        stream<SessionId>               &soRSt_RxSarReq,
+        stream<RxSarReply>              &siRSt_RxSarRep,
+        stream<TXeTxSarQuery>           &soTSt_TxSarQry,
+        stream<TXeTxSarReply>           &siTSt_TxSarRep,
+        stream<TXeReTransTimerCmd>      &soTIm_ReTxTimerCmd,
+        stream<SessionId>               &soTIm_SetProbeTimer,
+        stream<IhcMeta>                 &soIhc_Meta,
+        stream<TXeMeta>                 &soPhc_TxeMeta,
+        stream<DmCmd>                   &soMrd_BufferRdCmd,
+        stream<SessionId>               &soSLc_ReverseLkpReq,
+        stream<SpsCmd>                  &soSps_IsLookup,
+        stream<PayRdCnt>                &soTss_PayRdCnt,
+        stream<TcaCmd>                  &soTca_CsumCmd,
+        stream<FlagBool>                &soBdf_KeepData,
+        stream<FlagBool>                &soBdf_KeepCsum,
+        stream<LE_SocketPair>           &soSps_RstSockPair,
+        stream<SigBit>                  &soEVe_RxEventSig);
+
+/********************************************
+ * TXe - Socket Pair Splitter (also used by the TB)
+ ********************************************/
+void pSocketPairSplitter(
+        stream<fourTuple>               &siSLc_ReverseLkpRsp,
+        stream<LE_SocketPair>           &siMdl_RstSockPair,
+        stream<SpsCmd>                  &siMdl_IsLookup,
+        stream<IpAddrPair>              &soIhc_IpAddrPair,
+        stream<SocketPair>              &soPhc_SocketPair);
+
 /*******************************************************************************
  *
  * @brief ENTITY - Tx Engine (TXe)
@@ -137,6 +250,10 @@ void tx_engine(
         //-- MEM / Tx Read Path Interface
         stream<DmCmd>                   &soMEM_Txp_RdCmd,
         stream<AxisApp>                 &siMEM_TxP_Data,
+        //-- Tx Application Interface / DDR Bypass
+        stream<AxisApp>                 &siTAi_Data,
+        stream<TxCellCsum>              &siTAi_CellCsum,
+        stream<Csum>                    &siTAi_BypassCsum,
         //-- Timers Interface
         stream<TXeReTransTimerCmd>      &soTIm_ReTxTimerEvent,
         stream<ap_uint<16> >            &soTIm_SetProbeTimer,
@@ -147,6 +264,10 @@ void tx_engine(
         stream<AxisIp4>                 &soIPTX_Data
 );
 
+#ifndef __SYNTHESIS__
+  void getTxEngineStats(unsigned int &nrDataSegs, unsigned int &nrRevLookups);
+#endif
+
 #endif
 
 /*! \} */
@@ -2387,6 +2387,7 @@ void pTAIF(
  * @brief A wrapper for the Toplevel of the TCP Offload Engine (TOE).
  *
  * @param[in]  piMMIO_IpAddr     IP4 Address from [MMIO].
+ * @param[in]  piMMIO_CookieKey  The secret key of the SYN cookies from [MMIO].
  * @param[out] soMMIO_RxMemWrErr Reports a Rx memory write error.
  * @param[out] soMMIO_NotifDrop  The value of the notification drop counter.
  * @param[out] soMMIO_MetaDrop   The value of the metadata drop counter.
@@ -2437,6 +2438,7 @@ void pTAIF(
   void toe_top_wrap(
         //-- MMIO Interfaces
         Ip4Addr                                  piMMIO_IpAddr,
+        SynCookieKey                             piMMIO_CookieKey,
         stream<StsBit>                          &soMMIO_RxMemWrErr,
         stream<ap_uint<8> >                     &soMMIO_NotifDropCnt,
         stream<ap_uint<8> >                     &soMMIO_MetaDropCnt,
@@ -2512,6 +2514,7 @@ void pTAIF(
     toe_top(
       //-- MMIO Interfaces
       piMMIO_IpAddr,
+      piMMIO_CookieKey,
       soMMIO_RxMemWrErr,
       soMMIO_NotifDropCnt,
       soMMIO_MetaDropCnt,
@@ -2867,6 +2870,7 @@ int main(int argc, char *argv[]) {
         #endif
             //-- MMIO Interfaces
             gFpgaIp4Addr,
+            gCookieKey,
             ssTOE_MMIO_RxMemWrErr,
             ssTOE_MMIO_NotifDropCnt,
             ssTOE_MMIO_MetaDropCnt,
@@ -127,6 +127,7 @@ TcpPort         gFpgaLsnPort  = DEFAULT_FPGA_LSN_PORT;  // TCP  listen port
 TcpPort         gFpgaSndPort  = TOE_FIRST_EPHEMERAL_PORT_NUM; // TCP source port
 Ip4Addr         gHostIp4Addr  = DEFAULT_HOST_IP4_ADDR;  // IPv4 address (in NETWORK BYTE ORDER)
 TcpPort         gHostLsnPort  = DEFAULT_HOST_LSN_PORT;  // TCP  listen port
+SynCookieKey    gCookieKey("0F0E0D0C0B0A09080706050403020100", 16);  // SipHash key of the SYN cookies
 bool            gSortTaifGold = false;                  // Do not sort soTAIF.gold file
 
 bool            gTest_RcvdIp4Packet  = true; // Check the received IPv4 packet
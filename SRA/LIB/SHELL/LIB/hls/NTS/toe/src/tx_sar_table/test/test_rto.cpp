@@ -0,0 +1,209 @@
+/*
+ * Copyright 2016 -- 2021 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*******************************************************************************
+ * @file       : test_rto.cpp
+ * @brief      : Testbench for the retransmission timeout (RTO) estimator of the
+ *               Tx SAR Table (TSt).
+ *
+ * System:     : cloudFPGA
+ * Component   : Shell, Network Transport Stack, TCP Offload Engine (TOE)
+ * Language    : Vivado HLS
+ *
+ * \ingroup NTS_TOE
+ * \addtogroup NTS_TOE_TEST
+ * \{
+ *******************************************************************************/
+
+#include "../tx_sar_table.hpp"
+#include "../../toe_utils.hpp"
+#include "../../../../../NTS/SimNtsUtils.hpp"
+
+using namespace hls;
+using namespace std;
+
+//---------------------------------------------------------
+// HELPERS FOR THE DEBUGGING TRACES
+//---------------------------------------------------------
+#define THIS_NAME "TB"
+
+//---------------------------------------------------------
+//-- TESTBENCH GLOBAL VARIABLES
+//---------------------------------------------------------
+bool            gTraceEvent   = false;
+bool            gFatalError   = false;
+unsigned int    gSimCycCnt    = 0;
+
+/*******************************************************************************
+ * An RTT sample and the estimates expected after it was fed to 'updateRto()'.
+ *  'srtt' and 'rttvar' are given with the scaling of the Tx SAR entry (.i.e
+ *  x8 and x4), while 'rto' is the unbounded value of SRTT + 4*RTTVAR.
+ *******************************************************************************/
+struct RttStep {
+    unsigned int sample;
+    unsigned int srtt;
+    unsigned int rttvar;
+    unsigned int rto;
+};
+
+//-- A first measurement followed by a rising, a falling and two steady samples
+//--  FYI: In real numbers, RFC-6298 gives SRTT = 1000, 1050, 993.75, 994.53,
+//--   995.21 and RTTVAR = 500, 475, 468.75, 353.12, 266.21. The fixed-point
+//--   estimates truncate the fractions of a tick.
+const RttStep cRttSteps[] = {
+    // sample   srtt(x8) rttvar(x4)   rto
+    {   1000,     8000,     2000,    3000 },
+    {   1400,     8400,     1900,    2950 },
+    {    600,     7950,     1875,    2868 },
+    {   1000,     7957,     1414,    2408 },
+    {   1000,     7963,     1067,    2062 },
+};
+
+/*******************************************************************************
+ * @brief Returns an RTO bounded by TIME_MIN_RTO and TIME_MAX_RTO.
+ *******************************************************************************/
+unsigned int boundRto(unsigned int rto) {
+    if (rto < TIME_MIN_RTO) {
+        return TIME_MIN_RTO.to_uint();
+    }
+    if (rto > TIME_MAX_RTO) {
+        return TIME_MAX_RTO.to_uint();
+    }
+    return rto;
+}
+
+/*******************************************************************************
+ * @brief Returns a Tx SAR entry without any RTT measurement yet.
+ *******************************************************************************/
+TxSarEntry newEntry() {
+    TxSarEntry entry;
+    entry.srtt   = 0;
+    entry.rttvar = 0;
+    entry.rto    = TIME_INIT_RTO;
+    return entry;
+}
+
+/*******************************************************************************
+ * @brief Feeds a single sample to a fresh entry and checks the resulting RTO.
+ *
+ * @param[in] testName  The name of the test.
+ * @param[in] sample    The RTT sample (in ticks).
+ * @param[in] expRto    The expected RTO (in ticks).
+ * @return the number of errors.
+ *******************************************************************************/
+int checkFirstSample(const char *testName, unsigned int sample, unsigned int expRto) {
+    TxSarEntry entry = newEntry();
+    updateRto(entry, sample);
+    if (entry.rto != expRto) {
+        printError(THIS_NAME, "[%s] sample=%d - Expected RTO=%d but got %d.\n",
+                   testName, sample, expRto, entry.rto.to_uint());
+        return 1;
+    }
+    printInfo(THIS_NAME, "[%s] sample=%d -> RTO=%d.\n", testName, sample, entry.rto.to_uint());
+    return 0;
+}
+
+/*******************************************************************************
+ * @brief Main function.
+ *******************************************************************************/
+int main(int argc, char* argv[])
+{
+    //------------------------------------------------------
+    //-- TESTBENCH LOCAL VARIABLES
+    //------------------------------------------------------
+    int          nrErr = 0;     // Tb error counter.
+    TxSarEntry   entry;
+
+    printInfo(THIS_NAME, "############################################################################\n");
+    printInfo(THIS_NAME, "## TESTBENCH 'test_rto' STARTS HERE                                       ##\n");
+    printInfo(THIS_NAME, "############################################################################\n");
+    printInfo(THIS_NAME, "TIME_MIN_RTO=%d, TIME_MAX_RTO=%d (in ticks).\n",
+              TIME_MIN_RTO.to_uint(), TIME_MAX_RTO.to_uint());
+
+    //------------------------------------------------------
+    //-- STEP-1: ESTIMATOR
+    //--  The samples are long enough for the RTO to stay
+    //--  above the floor unless it was set larger.
+    //------------------------------------------------------
+    entry = newEntry();
+    for (unsigned int i=0; i<sizeof(cRttSteps)/sizeof(RttStep); i++) {
+        const RttStep &step = cRttSteps[i];
+        updateRto(entry, step.sample);
+        if ((entry.srtt != step.srtt) or (entry.rttvar != step.rttvar) or
+            (entry.rto  != boundRto(step.rto))) {
+            printError(THIS_NAME, "[ESTIMATOR] step=%d sample=%d - Expected SRTT/RTTVAR/RTO=%d/%d/%d but got %d/%d/%d.\n",
+                       i, step.sample, step.srtt, step.rttvar, boundRto(step.rto),
+                       entry.srtt.to_uint(), entry.rttvar.to_uint(), entry.rto.to_uint());
+            nrErr++;
+        }
+        else {
+            printInfo(THIS_NAME, "[ESTIMATOR] step=%d sample=%d -> SRTT=%d/8 RTTVAR=%d/4 RTO=%d.\n",
+                      i, step.sample, entry.srtt.to_uint(), entry.rttvar.to_uint(), entry.rto.to_uint());
+        }
+    }
+
+    //------------------------------------------------------
+    //-- STEP-2: FLOOR, CEILING AND CLOCK GRANULARITY
+    //------------------------------------------------------
+    // A short RTT is raised to the floor (10 + 4*5 = 30)
+    nrErr += checkFirstSample("FLOOR",   10, boundRto(30));
+    // A long RTT is capped at the ceiling (SRTT + 4*RTTVAR = 3*TIME_MAX_RTO)
+    nrErr += checkFirstSample("CEILING", TIME_MAX_RTO.to_uint(), TIME_MAX_RTO.to_uint());
+    // A null sample counts as one tick (1 + 4*0.5 = 3)
+    nrErr += checkFirstSample("ZERO",    0, boundRto(3));
+
+    //------------------------------------------------------
+    //-- STEP-3: EXPONENTIAL BACKOFF
+    //------------------------------------------------------
+    for (unsigned int retries=0; retries<8; retries++) {
+        unsigned int baseRto = boundRto(3000);
+        unsigned long long expRto = ((unsigned long long)baseRto) << retries;
+        if (expRto > TIME_MAX_RTO) {
+            expRto = TIME_MAX_RTO.to_uint();
+        }
+        RtoTicks rto = backoffRto(baseRto, retries);
+        if (rto != expRto) {
+            printError(THIS_NAME, "[BACKOFF] retries=%d - Expected RTO=%lld but got %d.\n",
+                       retries, expRto, rto.to_uint());
+            nrErr++;
+        }
+        // The largest RTO must not overflow when it is backed off
+        rto = backoffRto(TIME_MAX_RTO, retries);
+        if (rto != TIME_MAX_RTO) {
+            printError(THIS_NAME, "[BACKOFF] retries=%d - Expected RTO=%d but got %d.\n",
+                       retries, TIME_MAX_RTO.to_uint(), rto.to_uint());
+            nrErr++;
+        }
+    }
+
+    //---------------------------------------------------------------
+    //-- PRINT OVERALL TESTBENCH STATUS
+    //---------------------------------------------------------------
+    if (nrErr) {
+        printError(THIS_NAME, "###########################################################\n");
+        printError(THIS_NAME, "#### TEST BENCH FAILED : TOTAL NUMBER OF ERROR(S) = %2d ####\n", nrErr);
+        printError(THIS_NAME, "###########################################################\n\n");
+    }
+    else {
+        printInfo(THIS_NAME, "#############################################################\n");
+        printInfo(THIS_NAME, "####               SUCCESSFUL END OF TEST                ####\n");
+        printInfo(THIS_NAME, "#############################################################\n");
+    }
+
+    return nrErr;
+}
+
+/*! \} */
@@ -73,11 +73,59 @@ using namespace hls;
 #define DEBUG_LEVEL (TRACE_OFF)
 
 
+/*******************************************************************************
+ * @brief Updates the RTT estimates and the RTO of a session with a new sample.
+ *
+ * @param[in/out] entry   The Tx SAR entry of the session.
+ * @param[in]     sample  The measured round-trip time (in ticks).
+ *
+ * @details
+ *  This implements the estimator of RFC-6298 with the fixed-point scaling of
+ *   Jacobson (.i.e 'srtt' is kept x8 and 'rttvar' x4). The gains (1/8 and 1/4)
+ *   are then applied with shifts and the update does not require any divider.
+ *   The clock granularity G is one tick and the RTO is bounded by TIME_MIN_RTO
+ *   and TIME_MAX_RTO.
+ *******************************************************************************/
+void updateRto(TxSarEntry &entry, RttTicks sample)
+{
+    #pragma HLS INLINE
+
+    ap_int<28>  err;
+    ap_uint<28> rto;
+
+    if (sample == 0) {
+        sample = 1;
+    }
+    if (entry.srtt == 0) {
+        //-- First measurement (RFC-6298 - Sect. 2.2)
+        entry.srtt   = ((ap_uint<27>)sample) << 3;
+        entry.rttvar = ((ap_uint<26>)sample) << 1;
+    }
+    else {
+        //-- Subsequent measurement (RFC-6298 - Sect. 2.3)
+        err = (ap_int<28>)sample - (ap_int<28>)(entry.srtt >> 3);
+        entry.srtt = entry.srtt + err;
+        if (err < 0) {
+            err = -err;
+        }
+        entry.rttvar = entry.rttvar + err - (entry.rttvar >> 2);
+    }
+    rto = (entry.srtt >> 3) + ((entry.rttvar != 0) ? (ap_uint<26>)entry.rttvar : (ap_uint<26>)1);
+    if (rto < TIME_MIN_RTO) {
+        rto = TIME_MIN_RTO;
+    }
+    else if (rto > TIME_MAX_RTO) {
+        rto = TIME_MAX_RTO;
+    }
+    entry.rto = rto;
+}
+
+
 /*******************************************************************************
  * @brief Tx Sar Table (TSt). Stores the data structures for managing the
  *         TCP Tx buffer and Tx sliding window.
  *
- * @param[in]  siRXe_TxSarQry  Query from RxEngine (RXe).
+ * @param[in]  siRXe_TxSarQry  Query from RxEngine (RXe), via the Congestion Control (CCo).
  * @param[out] soRXe_TxSarRep  Reply to [RXe].
  * @param[in]  siTXe_TxSarQry  Tx SAR query from TxEngine (TXe).
  * @param[out] soTXe_TxSarRep  Tx SAR reply to [TXe].
@@ -87,6 +135,27 @@ using namespace hls;
  * @details
  *  This process is accessed by the RxEngine (RXe), the TxEngine (TXe) and the
  *   TxAppInterface (TAi).
+ *  The congestion window written by [RXe] is computed by the Congestion
+ *   Control (CCo). A retransmission timeout reported by [TXe] resets the
+ *   window, sets the slow start threshold and raises 'rtoPending'. The next
+ *   read reply to [RXe] carries this flag, and [RXe] forwards it to [CCo]
+ *   with its next write query. Until then, the windows written by [RXe] were
+ *   computed before the timeout and are ignored.
+ *  Upon an ECN-Echo, [CCo] reduces the window and raises 'cwrPending'. The
+ *   flag is cleared once [TXe] reports that it sent a segment with CWR.
+ *  The SACK scoreboard is overwritten by every ACK coming from [RXe]. If the
+ *   remote peer reneges on some SACKed data, it stops reporting it, and the
+ *   scoreboard is cleared by its next ACK.
+ *  The round-trip time is measured on one segment at a time. The measurement
+ *   starts when [TXe] advances 'unak' and ends with the first ACK from [RXe]
+ *   that covers it. Following Karn's algorithm, a measurement is abandoned
+ *   when a retransmission occurs (.i.e RT query from [TXe] or fast retransmit
+ *   signaled by [RXe]). The time is given by a free-running tick counter that
+ *   advances every TOE_TIMER_TICK_CYCLES clock cycles, like the one of the
+ *   timers.
+ *  A session opened by a SYN cookie is initialized by an init query from
+ *   [RXe] instead of [TXe], because its SYN_ACK was sent without any state.
+ *   Such a SYN_ACK is not timed.
  *******************************************************************************/
 void tx_sar_table(
         stream<RXeTxSarQuery>      &siRXe_TxSarQry,
@@ -105,6 +174,22 @@ void tx_sar_table(
     static TxSarEntry               TX_SAR_TABLE[TOE_MAX_SESSIONS];
     #pragma HLS DEPENDENCE variable=TX_SAR_TABLE inter false
     #pragma HLS RESOURCE   variable=TX_SAR_TABLE core=RAM_2P
+    #pragma HLS DATA_PACK  variable=TX_SAR_TABLE
+
+    //-- STATIC CONTROL VARIABLES (with RESET) ---------------------------------
+    static ap_uint<32>         tst_cycCnt=0;
+    #pragma HLS RESET variable=tst_cycCnt
+    static RttTicks            tst_tickCnt=0;
+    #pragma HLS RESET variable=tst_tickCnt
+
+    //-- Free-running tick counter
+    if (tst_cycCnt == TOE_TIMER_TICK_CYCLES-1) {
+        tst_cycCnt = 0;
+        tst_tickCnt++;
+    }
+    else {
+        tst_cycCnt++;
+    }
 
     if (!siTXe_TxSarQry.empty()) {
         TXeTxSarQuery sTXeQry;
@@ -115,12 +200,28 @@ void tx_sar_table(
         if (sTXeQry.write) {
             //-- TXe Write Query
             if (not sTXeQry.isRtQuery) {
+                TxSarEntry txSarEntry = TX_SAR_TABLE[sTXeQry.sessionID];
+                if (sTXeQry.init or
+                   (not txSarEntry.rttValid and (sTXeQry.not_ackd != txSarEntry.unak))) {
+                    //-- Start timing this segment (or the SYN of a new session)
+                    TX_SAR_TABLE[sTXeQry.sessionID].rttSeq   = sTXeQry.not_ackd;
+                    TX_SAR_TABLE[sTXeQry.sessionID].rttStamp = tst_tickCnt;
+                    TX_SAR_TABLE[sTXeQry.sessionID].rttValid = true;
+                }
                 TX_SAR_TABLE[sTXeQry.sessionID].unak = sTXeQry.not_ackd;
+                if (sTXeQry.cwrSent or sTXeQry.init) {
+                    TX_SAR_TABLE[sTXeQry.sessionID].cwrPending = false;
+                }
                 if (sTXeQry.init) {
                     TX_SAR_TABLE[sTXeQry.sessionID].appw        = sTXeQry.not_ackd;
                     TX_SAR_TABLE[sTXeQry.sessionID].ackd        = sTXeQry.not_ackd-1;
-                    TX_SAR_TABLE[sTXeQry.sessionID].cong_window = 0x3908; // 10 x 1460(MSS)
-                    TX_SAR_TABLE[sTXeQry.sessionID].slowstart_threshold = 0xFFFF;
+                    TX_SAR_TABLE[sTXeQry.sessionID].cong_window = TOE_INIT_CONGESTION_WINDOW;
+                    TX_SAR_TABLE[sTXeQry.sessionID].slowstart_threshold = TOE_BUFFER_SIZE-1;
+                    TX_SAR_TABLE[sTXeQry.sessionID].sackCnt     = 0;
+                    TX_SAR_TABLE[sTXeQry.sessionID].srtt        = 0;
+                    TX_SAR_TABLE[sTXeQry.sessionID].rttvar      = 0;
+                    TX_SAR_TABLE[sTXeQry.sessionID].rto         = TIME_INIT_RTO;
+                    TX_SAR_TABLE[sTXeQry.sessionID].rtoPending  = false;
                     // Avoid initializing 'finReady' and 'finSent' at two different
                     // places because it will translate into II=2 and DRC message:
                     // 'Unable to schedule store operation on array due to limited memory ports'.
@@ -140,7 +241,10 @@ void tx_sar_table(
                 //-- TXe Write RtQuery
                 TXeTxSarRtQuery sTXeRtQry = sTXeQry;
                 TX_SAR_TABLE[sTXeQry.sessionID].slowstart_threshold = sTXeRtQry.getThreshold();
-                TX_SAR_TABLE[sTXeQry.sessionID].cong_window = 0x3908; // 10 x 1460(MSS) TODO is this correct or less, eg. 1/2 * MSS
+                TX_SAR_TABLE[sTXeQry.sessionID].cong_window = TOE_INIT_CONGESTION_WINDOW; // TODO is this correct or less, eg. 1/2 * MSS
+                TX_SAR_TABLE[sTXeQry.sessionID].rtoPending  = true;
+                //  Karn's algorithm - Do not time a retransmitted segment
+                TX_SAR_TABLE[sTXeQry.sessionID].rttValid    = false;
                 if (DEBUG_LEVEL & TRACE_TST) {
                     printInfo(myName, "Received a Retry-Write query from TXe for session #%d.\n",
                             sTXeQry.sessionID.to_int());
@@ -151,19 +255,27 @@ void tx_sar_table(
             //-- TXe Read Query
             TxSarEntry txSarEntry = TX_SAR_TABLE[sTXeQry.sessionID];
 
-            TcpWindow   minWindow;
+            TcpWinSize  minWindow;
             if (txSarEntry.cong_window < txSarEntry.recv_window) {
                 minWindow = txSarEntry.cong_window;
             }
             else {
                 minWindow = TX_SAR_TABLE[sTXeQry.sessionID].recv_window;
             }
-            soTXe_TxSarRep.write(TXeTxSarReply(TX_SAR_TABLE[sTXeQry.sessionID].ackd,
-                                               TX_SAR_TABLE[sTXeQry.sessionID].unak,
-                                               minWindow,
-                                               TX_SAR_TABLE[sTXeQry.sessionID].appw,
-                                               TX_SAR_TABLE[sTXeQry.sessionID].finReady,
-                                               TX_SAR_TABLE[sTXeQry.sessionID].finSent));
+            TXeTxSarReply txSarReply(TX_SAR_TABLE[sTXeQry.sessionID].ackd,
+                                     TX_SAR_TABLE[sTXeQry.sessionID].unak,
+                                     minWindow,
+                                     TX_SAR_TABLE[sTXeQry.sessionID].appw,
+                                     TX_SAR_TABLE[sTXeQry.sessionID].finReady,
+                                     TX_SAR_TABLE[sTXeQry.sessionID].finSent);
+            txSarReply.sackCnt = txSarEntry.sackCnt;
+            txSarReply.rto     = txSarEntry.rto;
+            txSarReply.cwrPending = txSarEntry.cwrPending;
+            for (int i=0; i<TOE_SACK_BLOCKS; ++i) {
+            #pragma HLS UNROLL
+                txSarReply.sackBlk[i] = txSarEntry.sackBlk[i];
+            }
+            soTXe_TxSarRep.write(txSarReply);
         }
     }
     else if (!siTAi_PushCmd.empty()) {
@@ -182,22 +294,71 @@ void tx_sar_table(
         //---------------------------------------
         siRXe_TxSarQry.read(sRXeQry);
         if (sRXeQry.write == QUERY_WR) {
-            TX_SAR_TABLE[sRXeQry.sessionID].ackd        = sRXeQry.ackd;
+            TxSarEntry txSarEntry = TX_SAR_TABLE[sRXeQry.sessionID];
+            if (sRXeQry.init) {
+                //-- The SYN_ACK was sent with a SYN cookie and [TXe] did not
+                //--  initialize this session. 'ackd' is the ISN+1 of [TXe].
+                TX_SAR_TABLE[sRXeQry.sessionID].unak        = sRXeQry.ackd;
+                TX_SAR_TABLE[sRXeQry.sessionID].appw        = sRXeQry.ackd;
+                TX_SAR_TABLE[sRXeQry.sessionID].slowstart_threshold = TOE_BUFFER_SIZE-1;
+                TX_SAR_TABLE[sRXeQry.sessionID].srtt        = 0;
+                TX_SAR_TABLE[sRXeQry.sessionID].rttvar      = 0;
+                TX_SAR_TABLE[sRXeQry.sessionID].rto         = TIME_INIT_RTO;
+                TX_SAR_TABLE[sRXeQry.sessionID].rttValid    = false;
+                TX_SAR_TABLE[sRXeQry.sessionID].finReady    = false;
+                TX_SAR_TABLE[sRXeQry.sessionID].finSent     = false;
+                TX_SAR_TABLE[sRXeQry.sessionID].cwrPending  = false;
+            }
+            else if (txSarEntry.rttValid) {
+                if (sRXeQry.fastRetransmitted) {
+                    //  Karn's algorithm - Do not time a retransmitted segment
+                    TX_SAR_TABLE[sRXeQry.sessionID].rttValid = false;
+                }
+                else if ((ap_int<32>)(sRXeQry.ackd - txSarEntry.rttSeq) >= 0) {
+                    //  This ACK covers the timed segment
+                    updateRto(txSarEntry, tst_tickCnt - txSarEntry.rttStamp);
+                    TX_SAR_TABLE[sRXeQry.sessionID].srtt     = txSarEntry.srtt;
+                    TX_SAR_TABLE[sRXeQry.sessionID].rttvar   = txSarEntry.rttvar;
+                    TX_SAR_TABLE[sRXeQry.sessionID].rto      = txSarEntry.rto;
+                    TX_SAR_TABLE[sRXeQry.sessionID].rttValid = false;
+                    if (DEBUG_LEVEL & TRACE_TST) {
+                        printInfo(myName, "Session #%d - SRTT=%d - RTTVAR=%d - RTO=%d ticks.\n",
+                                  sRXeQry.sessionID.to_int(), (txSarEntry.srtt >> 3).to_uint(),
+                                  (txSarEntry.rttvar >> 2).to_uint(), txSarEntry.rto.to_uint());
+                    }
+                }
+            }
+            TX_SAR_TABLE[sRXeQry.sessionID].ackd        = (sRXeQry.init) ? (TxAckNum)(sRXeQry.ackd-1) : sRXeQry.ackd;
             TX_SAR_TABLE[sRXeQry.sessionID].recv_window = sRXeQry.recv_window;
-            TX_SAR_TABLE[sRXeQry.sessionID].cong_window = sRXeQry.cong_window;
+            if (sRXeQry.rto or (sRXeQry.ccEvent == CC_INIT) or not txSarEntry.rtoPending) {
+                //  Otherwise, the window was computed before the timeout
+                TX_SAR_TABLE[sRXeQry.sessionID].cong_window = sRXeQry.cong_window;
+                TX_SAR_TABLE[sRXeQry.sessionID].rtoPending  = false;
+            }
+            if (sRXeQry.cwr) {
+                TX_SAR_TABLE[sRXeQry.sessionID].cwrPending  = true;
+            }
             TX_SAR_TABLE[sRXeQry.sessionID].count       = sRXeQry.count;
             TX_SAR_TABLE[sRXeQry.sessionID].fastRetransmitted = sRXeQry.fastRetransmitted;
-            // Push ACK to txAppInterface
-            soTAi_PushCmd.write(TStTxSarPush(sRXeQry.sessionID, sRXeQry.ackd));
+            //  The scoreboard always reflects the SACK blocks of the latest ACK
+            TX_SAR_TABLE[sRXeQry.sessionID].sackCnt     = sRXeQry.sackCnt;
+            for (int i=0; i<TOE_SACK_BLOCKS; ++i) {
+            #pragma HLS UNROLL
+                TX_SAR_TABLE[sRXeQry.sessionID].sackBlk[i] = sRXeQry.sackBlk[i];
+            }
+            // Push ACK to txAppInterface (or init it)
+            soTAi_PushCmd.write(TStTxSarPush(sRXeQry.sessionID, sRXeQry.ackd, sRXeQry.init));
         }
         else {
             //-- Read Query
-            soRXe_TxSarRep.write(RXeTxSarReply(TX_SAR_TABLE[sRXeQry.sessionID].ackd,
-                                               TX_SAR_TABLE[sRXeQry.sessionID].unak,
-                                               TX_SAR_TABLE[sRXeQry.sessionID].cong_window,
-                                               TX_SAR_TABLE[sRXeQry.sessionID].slowstart_threshold,
-                                               TX_SAR_TABLE[sRXeQry.sessionID].count,
-                                               TX_SAR_TABLE[sRXeQry.sessionID].fastRetransmitted));
+            RXeTxSarReply rxeTxSarReply(TX_SAR_TABLE[sRXeQry.sessionID].ackd,
+                                        TX_SAR_TABLE[sRXeQry.sessionID].unak,
+                                        TX_SAR_TABLE[sRXeQry.sessionID].cong_window,
+                                        TX_SAR_TABLE[sRXeQry.sessionID].slowstart_threshold,
+                                        TX_SAR_TABLE[sRXeQry.sessionID].count,
+                                        TX_SAR_TABLE[sRXeQry.sessionID].fastRetransmitted);
+            rxeTxSarReply.rtoPending = TX_SAR_TABLE[sRXeQry.sessionID].rtoPending;
+            soRXe_TxSarRep.write(rxeTxSarReply);
         }
     }
 }
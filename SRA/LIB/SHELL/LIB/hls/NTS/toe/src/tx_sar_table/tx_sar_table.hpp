@@ -80,6 +80,19 @@ using namespace hls;
  *          |269|270|271|272|273|274|275|276|277|278|279|280|281|282|283|284|
  *        --+---+---+---+---+---+---+---+---+---+---+---+---+---+---+---+---+--
  *
+ *  The entry also holds the SACK scoreboard of the session, .i.e the blocks of
+ *   bytes located between 'ackd' and 'unak' that were reported as received by
+ *   the most recent ACK of the remote peer (RFC-2018).
+ *  Finally, the entry holds the round-trip time (RTT) estimates of the session
+ *   and the retransmission timeout (RTO) derived from them (RFC-6298). One
+ *   segment per RTT is timed, from its transmission by [TXe] until the ACK
+ *   that covers it is received by [RXe].
+ *  Two flags relay the congestion signals between [TXe] and the Congestion
+ *   Control (CCo). 'rtoPending' tells that a retransmission timeout reset the
+ *   window and was not yet reported to [CCo], while 'cwrPending' tells that
+ *   [CCo] reduced the window upon an ECN-Echo and that [TXe] must set CWR on
+ *   its next new data segment (RFC-3168).
+ *
  * [TODO - The structure is also used to manage the send window...]
  *******************************************************************************/
 class TxSarEntry {
@@ -89,15 +102,31 @@ class TxSarEntry {
     TxAckNum        ackd;        // Bytes TX'ed and ACK'ed
     RemotWinSize    recv_window; // Remote receiver's buffer size (their)
     LocalWinSize    cong_window; // Local  receiver's buffer size (mine)
-    TcpWindow       slowstart_threshold;
+    LocalWinSize    slowstart_threshold;
     ap_uint<2>      count;
     bool            fastRetransmitted;
     bool            finReady;
     bool            finSent;
+    SackCnt         sackCnt;     // Number of valid blocks in the SACK scoreboard
+    SackBlock       sackBlk[TOE_SACK_BLOCKS];
+    TxAckNum        rttSeq;      // ACK number which ends the current RTT measurement
+    RttTicks        rttStamp;    // Time at which the timed segment was sent
+    bool            rttValid;    // An RTT measurement is in progress
+    ap_uint<27>     srtt;        // Smoothed RTT     (x8, in ticks)
+    ap_uint<26>     rttvar;      // RTT variation    (x4, in ticks)
+    RtoTicks        rto;         // Retransmission timeout (in ticks)
+    bool            rtoPending;  // A timeout is not yet reported to [CCo]
+    bool            cwrPending;  // A CWR must be sent with the next new data
     TxSarEntry() {}
 };
 
 
+/*******************************************************************************
+ * RTT ESTIMATOR (RFC-6298) - PROTOTYPE DEFINITION
+ *******************************************************************************/
+void updateRto(TxSarEntry &entry, RttTicks sample);
+
+
 /*******************************************************************************
  *
  * @brief ENTITY - Tx SAR Table (TSt)
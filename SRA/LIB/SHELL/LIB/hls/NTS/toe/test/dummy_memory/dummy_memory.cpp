@@ -56,16 +56,16 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // Set the private data elements for a Read Command
 void DummyMemory::setReadCmd(DmCmd cmd) {
-    this->readAddr = cmd.saddr(15,  0); // Start address
-    this->readId   = cmd.saddr(31, 16); // Buffer address
+    this->readAddr = cmd.saddr(TOE_WINDOW_BITS-1, 0);  // Start address
+    this->readId   = cmd.saddr(31, TOE_WINDOW_BITS);   // Buffer address
     uint16_t tempLen = (uint16_t) cmd.btt(15, 0); // Byte to Transfer
     this->readLen    = (int) tempLen;
 }
 
 // Set the private data elements for a Write Command
 void DummyMemory::setWriteCmd(DmCmd cmd) {
-    this->writeAddr = cmd.saddr(15,  0); // Start address
-    this->writeId   = cmd.saddr(31, 16); // Buffer address
+    this->writeAddr = cmd.saddr(TOE_WINDOW_BITS-1, 0); // Start address
+    this->writeId   = cmd.saddr(31, TOE_WINDOW_BITS);  // Buffer address
 }
 
 // Read a data chunk from the memory
@@ -114,7 +114,7 @@ void DummyMemory::writeChunk(AxisApp &chunk) {
 
 std::map<ap_uint<16>, ap_uint<8>*>::iterator DummyMemory::createBuffer(ap_uint<16> id)
 {
-    ap_uint<8>* array = new ap_uint<8>[65536]; // [255] default
+    ap_uint<8>* array = new ap_uint<8>[TOE_BUFFER_SIZE]; // [255] default
     std::pair<std::map<ap_uint<16>, ap_uint<8>*>::iterator, bool> ret;
 
     ret = storage.insert(std::make_pair(id, array));
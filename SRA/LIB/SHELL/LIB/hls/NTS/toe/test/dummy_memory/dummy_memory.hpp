@@ -73,11 +73,11 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 class DummyMemory {
 
   private: // [FIXME - Use appropriate types]
-    ap_uint<16> readAddr;   // Read Address within a read buffer (16 LSbits -->  64k bytes)
-    ap_uint<16> readId;     // Address of the read buffer in DDR (16 MSbits -->  64k buffer).
-    int         readLen;
-    ap_uint<16> writeAddr;  // Write Address within a write buffer (16 LSbits -->  64k bytes)
-    ap_uint<16> writeId;    // Address of the write buffer in DDR  (16 MSbits -->  64k buffer).
+    ap_uint<TOE_WINDOW_BITS>    readAddr;   // Read Address within a read buffer (TOE_WINDOW_BITS LSbits)
+    ap_uint<16>                 readId;     // Address of the read buffer in DDR (remaining MSbits)
+    int                         readLen;
+    ap_uint<TOE_WINDOW_BITS>    writeAddr;  // Write Address within a write buffer (TOE_WINDOW_BITS LSbits)
+    ap_uint<16>                 writeId;    // Address of the write buffer in DDR  (remaining MSbits)
 
     std::map<ap_uint<16>, ap_uint<8>*>           storage;
     std::map<ap_uint<16>, ap_uint<8>*>::iterator readStorageIt;
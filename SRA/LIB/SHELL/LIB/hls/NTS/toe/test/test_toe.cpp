@@ -544,6 +544,17 @@ void pEmulateTxBufMem(
  *  Examples:
  *    G PARAM SimCycles     <NUM>
  *    G PARAM LocalSocket   <ADDR> <PORT>
+ *    G PARAM OooBench      <NR_SEGS> <LOSS_%> <REORDER_%>
+ *    G PARAM LfpBench      <RATE_GBPS> <RTT_US> <NR_RTTS>
+ *    G PARAM TxLatBench
+ *    G PARAM RxLatBench
+ *    G PARAM PageStats
+ *    G PARAM TsoStats
+ *    G PARAM WrapBench     <NR_SEGS>
+ *    G PARAM EveBench      <NR_SESS> <MSG_LEN>
+ *    G PARAM SpcBench      <NR_SESS> <MSG_LEN>
+ *    G PARAM ConnStorm     <NR_CONNS>
+ *    G PARAM SynStorm      <NR_CLIENTS>
  *******************************************************************************/
 bool setGlobalParameters(const char *callerName, unsigned int startupDelay, ifstream &inputFile)
 {
@@ -638,6 +649,71 @@ bool setGlobalParameters(const char *callerName, unsigned int startupDelay, ifst
                         printInfo(callerName, "Disabling the sorting of the 'soTAIF.gold' file.\n");
                     }
                 }
+                else if (stringVector[2] == "OooBench") {
+                    // The test vector file is requesting an out-of-order goodput benchmark.
+                    gOooBenchSegs    = atoi(stringVector[3].c_str());
+                    gOooBenchLoss    = (stringVector.size() > 4) ? atoi(stringVector[4].c_str()) : 0;
+                    gOooBenchReorder = (stringVector.size() > 5) ? atoi(stringVector[5].c_str()) : 0;
+                    printInfo(myName, "Requesting an out-of-order benchmark of %d segments (Loss=%d%%, Reorder=%d%%).\n",
+                              gOooBenchSegs, gOooBenchLoss, gOooBenchReorder);
+                }
+                else if (stringVector[2] == "LfpBench") {
+                    // The test vector file is requesting a long fat pipe throughput benchmark.
+                    gLfpBenchRate = atoi(stringVector[3].c_str());
+                    gLfpBenchRtt  = (stringVector.size() > 4) ? atoi(stringVector[4].c_str()) : 1000;
+                    gLfpBenchRtts = (stringVector.size() > 5) ? atoi(stringVector[5].c_str()) : 16;
+                    printInfo(myName, "Requesting a long fat pipe benchmark (Rate=%d Gb/s, RTT=%d us, %d RTTs).\n",
+                              gLfpBenchRate, gLfpBenchRtt, gLfpBenchRtts);
+                }
+                else if (stringVector[2] == "TxLatBench") {
+                    // The test vector file is requesting a Tx latency benchmark.
+                    gTxLatBench = true;
+                    printInfo(myName, "Requesting a Tx latency benchmark.\n");
+                }
+                else if (stringVector[2] == "RxLatBench") {
+                    // The test vector file is requesting a Rx latency benchmark.
+                    gRxLatBench = true;
+                    printInfo(myName, "Requesting a Rx latency benchmark.\n");
+                }
+                else if (stringVector[2] == "PageStats") {
+                    // The test vector file is requesting a report of the buffer pages in use.
+                    gPageStats = true;
+                    printInfo(myName, "Requesting a report of the buffer pages in use.\n");
+                }
+                else if (stringVector[2] == "TsoStats") {
+                    // The test vector file is requesting a report of the segmentation offload.
+                    gTsoStats = true;
+                    printInfo(myName, "Requesting a report of the segmentation offload.\n");
+                }
+                else if (stringVector[2] == "WrapBench") {
+                    // The test vector file is requesting a wrap-around stress benchmark.
+                    gWrapBenchSegs = atoi(stringVector[3].c_str());
+                    printInfo(myName, "Requesting a wrap-around stress benchmark of %d segments.\n", gWrapBenchSegs);
+                }
+                else if (stringVector[2] == "EveBench") {
+                    // The test vector file is requesting an event engine benchmark.
+                    gEveBenchSess = atoi(stringVector[3].c_str());
+                    gEveBenchLen  = (stringVector.size() > 4) ? atoi(stringVector[4].c_str()) : 64;
+                    printInfo(myName, "Requesting an event engine benchmark (Sessions=%d, MsgLen=%d bytes).\n",
+                              gEveBenchSess, gEveBenchLen);
+                }
+                else if (stringVector[2] == "SpcBench") {
+                    // The test vector file is requesting a socket pair cache benchmark.
+                    gSpcBenchSess = atoi(stringVector[3].c_str());
+                    gSpcBenchLen  = (stringVector.size() > 4) ? atoi(stringVector[4].c_str()) : 64;
+                    printInfo(myName, "Requesting a socket pair cache benchmark (Sessions=%d, MsgLen=%d bytes).\n",
+                              gSpcBenchSess, gSpcBenchLen);
+                }
+                else if (stringVector[2] == "ConnStorm") {
+                    // The test vector file is requesting a connection storm benchmark.
+                    gPrtBenchConns = atoi(stringVector[3].c_str());
+                    printInfo(myName, "Requesting a connection storm benchmark of %d connections.\n", gPrtBenchConns);
+                }
+                else if (stringVector[2] == "SynStorm") {
+                    // The test vector file is requesting a SYN storm benchmark.
+                    gSynBenchClients = atoi(stringVector[3].c_str());
+                    printInfo(myName, "Requesting a SYN storm benchmark with %d real clients.\n", gSynBenchClients);
+                }
                 else if (stringVector[2] == "FpgaServerSocket") {  // DEPRECATED
                     printFatal(myName, "The global parameter \'FpgaServerSockett\' is not supported anymore.\n\tPLEASE UPDATE YOUR TEST VECTOR FILE ACCORDINGLY.\n");
                 }
@@ -994,6 +1070,9 @@ void pIPRX_FeedTOE(
         for (int p=0; p<noPackets; p++) {
             SimIp4Packet ipRxPacket = ipRxPacketizer.front();
             AxisIp4 ip4Chunk;
+            if (gRxLatBench and (ipRxPacket.sizeOfTcpData() > 0)) {
+                gRxLatInjCycs.push_back(gSimCycCnt);
+            }
             do {
                 ip4Chunk = ipRxPacket.pullChunk();
                 if (not soTOE_Data.full()) {
@@ -1446,6 +1525,7 @@ void pIPTX(
     //-- STATIC VARIABLES ------------------------------------------------------
     static SimIp4Packet iptx_ipPacket;
     static int          iptx_rttSim = RTT_LINK;
+    static unsigned int iptx_pktCycCnt = 0;  // Cycle at which TOE presented the current packet
     // [TODO] static ap_shift_reg<SimIp4Packet, RTT_LINK> rttPktBuffer; // A shift reg. holding RTT packets
 
 
@@ -1461,6 +1541,9 @@ void pIPTX(
     }
 
     if (!siTOE_Data.empty()) {
+        if (iptx_rttSim == RTT_LINK) {
+            iptx_pktCycCnt = gSimCycCnt;
+        }
         //---------------------------------
         //-- STEP-0 : Emulate the link RTT [FIXME - Move before '!siTOE_Data.empty()' check
         //---------------------------------
@@ -1499,6 +1582,11 @@ void pIPTX(
                     tcpBytCntr_TOE_IPTX += tcpPayloadSize;
                     // Write to the IP Tx Gold file
                     iptx_ipPacket.writeTcpDataToDatFile(ofIPTX_Data2);
+                    if (gTxLatBench and !gTxLatSndCycs.empty()) {
+                        // Each APP message of the benchmark is sent in a single segment
+                        gTxLatResults.push_back(iptx_pktCycCnt - gTxLatSndCycs.front());
+                        gTxLatSndCycs.pop_front();
+                    }
                 }
             }
             // Clear the chunk counter and the received IP packet
@@ -1918,8 +2006,13 @@ void pTAIF_Recv(
                 siTOE_Data.read(currChunk);
                 appTxBytCntr += writeAxisAppToFile(currChunk, ofTAIF_Data);
                 // Consume incoming stream until LAST bit is set
-                if (currChunk.getTLast() == 1)
+                if (currChunk.getTLast() == 1) {
+                    if (gRxLatBench and !gRxLatInjCycs.empty()) {
+                        gRxLatResults.push_back(gSimCycCnt - gRxLatInjCycs.front());
+                        gRxLatInjCycs.pop_front();
+                    }
                     tar_fsmState = WAIT_NOTIF;
+                }
             }
             break;
         case ECHO_MODE: // Forward incoming data to the TcpAppSend process (TAs)
@@ -2246,6 +2339,9 @@ void pTAIF_Send(
                     if (appChunk.getTLast()) {
                         // A send request must be sent by TAIF to TOE
                         soTOE_SndReq.write(TcpAppSndReq(tas_openSessList[currSocketPair], tas_simAppData.length()));
+                        if (gTxLatBench) {
+                            gTxLatSndCycs.push_back(gSimCycCnt);
+                        }
                         return;
                     }
                 } while (not appChunk.getTLast());
@@ -2387,6 +2483,7 @@ void pTAIF(
  * @brief A wrapper for the Toplevel of the TCP Offload Engine (TOE).
  *
  * @param[in]  piMMIO_IpAddr     IP4 Address from [MMIO].
+ * @param[in]  piMMIO_CookieKey  The secret key of the SYN cookies from [MMIO].
  * @param[out] soMMIO_RxMemWrErr Reports a Rx memory write error.
  * @param[out] soMMIO_NotifDrop  The value of the notification drop counter.
  * @param[out] soMMIO_MetaDrop   The value of the metadata drop counter.
@@ -2437,6 +2534,7 @@ void pTAIF(
   void toe_top_wrap(
         //-- MMIO Interfaces
         Ip4Addr                                  piMMIO_IpAddr,
+        SynCookieKey                             piMMIO_CookieKey,
         stream<StsBit>                          &soMMIO_RxMemWrErr,
         stream<ap_uint<8> >                     &soMMIO_NotifDropCnt,
         stream<ap_uint<8> >                     &soMMIO_MetaDropCnt,
@@ -2512,6 +2610,7 @@ void pTAIF(
     toe_top(
       //-- MMIO Interfaces
       piMMIO_IpAddr,
+      piMMIO_CookieKey,
       soMMIO_RxMemWrErr,
       soMMIO_NotifDropCnt,
       soMMIO_MetaDropCnt,
@@ -2577,81 +2676,262 @@ void pTAIF(
 }
 #endif
 
-/*****************************************************************************
- * @brief Main function.
+/*******************************************************************************
+ * @brief Reference model of the single-interval out-of-order handling that was
+ *  used by the RxEngine before it could track several out-of-order blocks.
  *
- * @param[in]  mode       The test mode (0=RX_MODE,    1=TX_MODE,
-*                                        2=BIDIR_MODE, 3=ECHO_MODE).
- * @param[in]  inpFile1   The pathname of the input file containing the test
- *                         vectors to be fed to the TOE:
- *                         If (mode==0 || mode=2)
- *                           inpFile1 = siIPRX_<TestName>
- *                         Else
- *                           inpFile1 = siTAIF_<TestName>.
- * @param[in]  inpFile2   The pathname of the second input file containing the
- *                         test vectors to be fed to the TOE:
- *                           inpFile2 == siTAIF_<TestName>.
- * @remark:
- *  The number of input parameters is variable and depends on the testing mode.
- *   Example (see also file '../run_hls.tcl'):
- *    csim_design -argv "0 ../../../../test/testVectors/ipRx_OneSynPkt.dat"
+ * @param[in/out] rcvd    The 'rcvd' pointer of the session.
+ * @param[in/out] ooo     The out-of-order flag of the session.
+ * @param[in/out] oooTail The first byte of the out-of-order run.
+ * @param[in/out] oooHead The next byte after the out-of-order run.
+ * @param[in]     segSeq  The sequence number of the received segment.
+ * @param[in]     segLen  The length of the received segment.
  *
- ******************************************************************************/
-int main(int argc, char *argv[]) {
+ * @return true if the segment is kept, false if it is dropped.
+ *******************************************************************************/
+bool refSingleOooInsert(RxSeqNum &rcvd, bool &ooo, RxSeqNum &oooTail,
+                        RxSeqNum &oooHead, RxSeqNum segSeq, TcpSegLen segLen)
+{
+    RxSeqNum segHead = segSeq + segLen;
+    if (!ooo and (segSeq == rcvd)) {
+        rcvd = segHead;
+        return true;
+    }
+    else if (!ooo and (segSeq > rcvd)) {
+        ooo = true;
+        oooTail = segSeq;
+        oooHead = segHead;
+        return true;
+    }
+    else if (ooo and (segSeq == oooHead)) {
+        oooHead = segHead;
+        return true;
+    }
+    else if (ooo and (segSeq == rcvd) and (segHead < oooTail)) {
+        rcvd = segHead;
+        return true;
+    }
+    else if (ooo and (segSeq == rcvd) and (segHead == oooTail)) {
+        rcvd = oooHead;
+        ooo  = false;
+        return true;
+    }
+    return false;
+}
 
-    //------------------------------------------------------
-    //-- TESTBENCH GLOBAL VARIABLES
-    //------------------------------------------------------
-    gSimCycCnt = 0;  // Simulation cycle counter as a global variable
+/*******************************************************************************
+ * @brief Benchmark the goodput of the out-of-order reassembly of the RxEngine.
+ *
+ * @param[in]  callerName  The name of the caller process (e.g. "TB").
+ * @param[in]  nrSegs      The number of segments to deliver.
+ * @param[in]  lossPct     The probability (in %) of losing a segment.
+ * @param[in]  reorderPct  The probability (in %) of swapping two segments.
+ *
+ * @details
+ *  A sender keeps a window of 'TB_OOO_BENCH_WND' segments in flight. Per round
+ *   trip, it retransmits the first unacknowledged segment (if any) and sends
+ *   the new segments that fit in the window. The same loss and reordering
+ *   process is applied to the multi-interval reassembly of the RxEngine (i.e.
+ *   'rxOooInsert()') and to the former single-interval scheme. The goodput is
+ *   the ratio of delivered over transmitted segments.
+ *******************************************************************************/
+void benchOooReassembly(const char *callerName, unsigned int nrSegs,
+                        unsigned int lossPct, unsigned int reorderPct)
+{
+    char myName[120];
+    strcpy(myName, callerName);
+    strcat(myName, "/benchOooReassembly");
+
+    const char *schemeName[2] = { "Single-interval", "Multi-interval " };
+    unsigned int segIdx[TB_OOO_BENCH_WND+1];
+
+    for (int scheme=0; scheme<2; ++scheme) {
+        srand(TB_OOO_BENCH_SEED);
+        RxSarReply   rxSar(0, 0, 0, 0);
+        bool         ooo     = false;
+        RxSeqNum     oooTail = 0;
+        RxSeqNum     oooHead = 0;
+        unsigned int nrSent  = 0;
+        unsigned int nrRtts  = 0;
+        unsigned int una     = 0;
+        unsigned int nxt     = 0;
+
+        while (una < nrSegs) {
+            //-- Retransmit the first unacknowledged segment, if any
+            unsigned int nrSegsInRtt = 0;
+            if (una < nxt) {
+                segIdx[nrSegsInRtt++] = una;
+            }
+            //-- Send the new segments of the window and apply some reordering
+            unsigned int end = ((una + TB_OOO_BENCH_WND) < nrSegs) ? (una + TB_OOO_BENCH_WND) : nrSegs;
+            unsigned int first = nrSegsInRtt;
+            for (; nxt<end; ++nxt) {
+                segIdx[nrSegsInRtt++] = nxt;
+            }
+            for (unsigned int i=first; i+1<nrSegsInRtt; ++i) {
+                if ((unsigned int)(rand() % 100) < reorderPct) {
+                    unsigned int tmp = segIdx[i];
+                    segIdx[i]   = segIdx[i+1];
+                    segIdx[i+1] = tmp;
+                }
+            }
+            //-- Transmit and apply some loss
+            for (unsigned int i=0; i<nrSegsInRtt; ++i) {
+                nrSent++;
+                if ((unsigned int)(rand() % 100) < lossPct) {
+                    continue;
+                }
+                RxSeqNum  segSeq = segIdx[i] * TB_OOO_BENCH_MSS;
+                TcpSegLen segLen = TB_OOO_BENCH_MSS;
+                if (scheme == 0) {
+                    refSingleOooInsert(rxSar.rcvd, ooo, oooTail, oooHead, segSeq, segLen);
+                }
+                else {
+                    RxSeqNum    newRcvd, newOooHead;
+                    RxOooCnt    newOooCnt;
+                    RxOooBlock  newOooBlk[TOE_OOO_BLOCKS];
+                    OooInsertSts sts = rxOooInsert(rxSar, segSeq, segLen,
+                                                   newRcvd, newOooHead, newOooCnt, newOooBlk);
+                    if ((sts == OOO_IN_ORDER) or (sts == OOO_STORED)) {
+                        rxSar.rcvd    = newRcvd;
+                        rxSar.oooHead = newOooHead;
+                        rxSar.oooCnt  = newOooCnt;
+                        for (int b=0; b<TOE_OOO_BLOCKS; ++b) {
+                            rxSar.oooBlk[b] = newOooBlk[b];
+                        }
+                    }
+                }
+                // The application consumes the data as soon as it is in-order
+                rxSar.appd = rxSar.rcvd(TOE_WINDOW_BITS-1, 0);
+            }
+            //-- Move the window forward according to the cumulative ACK
+            una = rxSar.rcvd.to_uint() / TB_OOO_BENCH_MSS;
+            nrRtts++;
+        }
+        printInfo(myName, "%s : RTTs=%6d - Segments sent=%6d - Goodput=%5.1f%% \n",
+                  schemeName[scheme], nrRtts, nrSent, (100.0 * nrSegs) / nrSent);
+    }
+}
 
-    //------------------------------------------------------
-    //-- DUT SIGNAL INTERFACES
-    //------------------------------------------------------
-    StsBit  sTOE_Ready;
+/*******************************************************************************
+ * @brief Build a segment sent by the remote peer of the long fat pipe benchmark.
+ *
+ * @param[in]  toePkt   The segment of [TOE] that the peer replies to.
+ * @param[in]  seqNumb  The sequence number of the segment.
+ * @param[in]  ackNumb  The acknowledgment number of the segment.
+ * @param[in]  isSyn    Build a SYN_ACK with the MSS and Window Scale options.
+ *
+ * @return the IPv4 packet of a segment without payload.
+ *******************************************************************************/
+SimIp4Packet lfpBenchSegment(SimIp4Packet &toePkt, TcpSeqNum seqNumb, TcpAckNum ackNumb, bool isSyn)
+{
+    // FYI - The options of a SYN_ACK are MSS (4 bytes), NOP (1) and Window Scale (3)
+    int          optLen = (isSyn) ? 8 : 0;
+    SimIp4Packet ipPkt(IP4_HEADER_LEN + TCP_HEADER_LEN + optLen);
+    ipPkt.setIpProtocol(IP4_PROT_TCP);
+    ipPkt.setIpSourceAddress(toePkt.getIpDestinationAddress());
+    ipPkt.setIpDestinationAddress(toePkt.getIpSourceAddress());
+    ipPkt.setTcpSourcePort(toePkt.getTcpDestinationPort());
+    ipPkt.setTcpDestinationPort(toePkt.getTcpSourcePort());
+    ipPkt.setTcpSequenceNumber(seqNumb);
+    ipPkt.setTcpAcknowledgeNumber(ackNumb);
+    ipPkt.setTcpControlSyn(isSyn);
+    ipPkt.setTcpControlAck(1);
+    ipPkt.setTcpWindow(0xFFFF);
+    if (isSyn) {
+        ipPkt.setTcpDataOffset(5 + optLen/4);
+        ap_uint<64> opts = 0;
+        opts( 7,  0) = TCP_OPT_KIND_MSS;
+        opts(15,  8) = 4;
+        opts(23, 16) = (ZYC2_MSS >> 8);
+        opts(31, 24) = (ZYC2_MSS & 0xFF);
+        opts(39, 32) = TCP_OPT_KIND_NOP;
+        opts(47, 40) = TCP_OPT_KIND_WSS;
+        opts(55, 48) = 3;
+        opts(63, 56) = TB_LFP_BENCH_WSS;
+        // The options fill the 6th chunk of the packet
+        deque<AxisIp4> chunks;
+        while (ipPkt.size()) {
+            chunks.push_back(ipPkt.pullChunk());
+        }
+        chunks[5].setLE_TData(opts);
+        for (unsigned int i=0; i<chunks.size(); ++i) {
+            ipPkt.pushChunk(chunks[i]);
+        }
+    }
+    ipPkt.tcpRecalculateChecksum();
+    return ipPkt;
+}
+
+/*******************************************************************************
+ * @brief Benchmark the throughput of a single flow over a long fat pipe.
+ *
+ * @param[in]  callerName  The name of the caller process (e.g. "TB").
+ * @param[in]  rateGbps    The rate of the link (in Gb/s).
+ * @param[in]  rttUs       The round trip time of the link (in us).
+ * @param[in]  nrRtts      The number of round trips to simulate.
+ *
+ * @return false if the bandwidth-delay product exceeds the TCP buffer, if the
+ *          steady-state rate is below the expected rate or if some data were
+ *          never acknowledged.
+ *
+ * @details
+ *  The APP opens a connection to a remote peer and keeps the Tx buffer of the
+ *   session full with messages of 'TB_LFP_BENCH_MSG' bytes. The TOE is run at
+ *   system level (one call of 'toe_top' per cycle) and its segments go over a
+ *   link of 'rateGbps' to the peer, which acknowledges every data segment. An
+ *   ACK reaches the TOE one 'rttUs' after its segment was serialized on the
+ *   link. The peer advertises a window larger than the TCP buffer (RFC-7323).
+ *  The steady-state rate is the acknowledged goodput during the last quarter
+ *   of the run. It is expected to reach the link goodput, unless the window of
+ *   the TOE (TOE_MAX_CONGESTION_WINDOW) does not cover the bandwidth-delay
+ *   product, in which case the benchmark fails. Recompile with
+ *   '-DTOE_DDR_WINDOW_BITS=<NUM>' to get MB-sized windows, and with
+ *   '-DTOE_SIM_TIME_1S_TICKS=<NUM>' to keep the RTO above long round trips
+ *   ('run_hls.tcl' runs 'siIPRX_TcpLongFatPipe.dat' in a project of its own
+ *   that is compiled with 4MB windows).
+ *  This benchmark re-uses the static state of the TOE and of the emulated CAM.
+ *   It must therefore be run after the main loop.
+ *******************************************************************************/
+bool benchLongFatPipe(const char *callerName, unsigned int rateGbps,
+                      unsigned int rttUs, unsigned int nrRtts)
+{
+    char myName[120];
+    strcpy(myName, callerName);
+    strcat(myName, "/benchLongFatPipe");
 
     //------------------------------------------------------
-    //-- DUT STREAM INTERFACES
+    //-- DUT SIGNAL AND STREAM INTERFACES
     //------------------------------------------------------
-
+    StsBit                          sTOE_Ready;
     stream<AxisIp4>                 ssIPRX_TOE_Data      ("ssIPRX_TOE_Data");
-
     stream<AxisIp4>                 ssTOE_IPTX_Data      ("ssTOE_IPTX_Data");
-
     stream<TcpAppData>              ssTAIF_TOE_Data      ("ssTAIF_TOE_Data");
     stream<TcpAppSndReq>            ssTAIF_TOE_SndReq    ("ssTAIF_TOE_SndReq");
     stream<TcpAppSndRep>            ssTOE_TAIF_SndRep    ("ssTOE_TAIF_SndRep");
-
     stream<TcpAppRdReq>             ssTAIF_TOE_DReq      ("ssTAIF_TOE_DReq");
     stream<TcpAppData>              ssTOE_TAIF_Data      ("ssTOE_TAIF_Data");
     stream<TcpAppMeta>              ssTOE_TAIF_Meta      ("ssTOE_TAIF_Meta");
-
     stream<TcpAppLsnReq>            ssTAIF_TOE_LsnReq    ("ssTAIF_TOE_LsnReq");
     stream<TcpAppLsnRep>            ssTOE_TAIF_LsnRep    ("ssTOE_TAIF_LsnRep");
-
     stream<TcpAppOpnReq>            ssTAIF_TOE_OpnReq    ("ssTAIF_TOE_OpnReq");
     stream<TcpAppOpnRep>            ssTOE_TAIF_OpnRep    ("ssTOE_TAIF_OpnRep");
-
     stream<TcpAppNotif>             ssTOE_TAIF_Notif     ("ssTOE_TAIF_Notif");
-
     stream<TcpAppClsReq>            ssTAIF_TOE_ClsReq    ("ssTAIF_TOE_ClsReq");
-
     stream<DmCmd>                   ssTOE_MEM_RxP_RdCmd  ("ssTOE_MEM_RxP_RdCmd");
     stream<AxisApp>                 ssMEM_TOE_RxP_Data   ("ssMEM_TOE_RxP_Data");
     stream<DmSts>                   ssMEM_TOE_RxP_WrSts  ("ssMEM_TOE_RxP_WrSts");
     stream<DmCmd>                   ssTOE_MEM_RxP_WrCmd  ("ssTOE_MEM_RxP_WrCmd");
     stream<AxisApp>                 ssTOE_MEM_RxP_Data   ("ssTOE_MEM_RxP_Data");
-
     stream<DmCmd>                   ssTOE_MEM_TxP_RdCmd  ("ssTOE_MEM_TxP_RdCmd");
     stream<AxisApp>                 ssMEM_TOE_TxP_Data   ("ssMEM_TOE_TxP_Data");
     stream<DmSts>                   ssMEM_TOE_TxP_WrSts  ("ssMEM_TOE_TxP_WrSts");
     stream<DmCmd>                   ssTOE_MEM_TxP_WrCmd  ("ssTOE_MEM_TxP_WrCmd");
     stream<AxisApp>                 ssTOE_MEM_TxP_Data   ("ssTOE_MEM_TxP_Data");
-
     stream<CamSessionLookupRequest> ssTOE_CAM_SssLkpReq  ("ssTOE_CAM_SssLkpReq");
     stream<CamSessionLookupReply>   ssCAM_TOE_SssLkpRep  ("ssCAM_TOE_SssLkpRep");
     stream<CamSessionUpdateRequest> ssTOE_CAM_SssUpdReq  ("ssTOE_CAM_SssUpdReq");
     stream<CamSessionUpdateReply>   ssCAM_TOE_SssUpdRep  ("ssCAM_TOE_SssUpdRep");
-
     stream<StsBit>                  ssTOE_MMIO_RxMemWrErr   ("ssTOE_MMIO_RxMemWrErr");
     stream<ap_uint<8> >             ssTOE_MMIO_NotifDropCnt ("ssTOE_MMIO_NotifDropCnt");
     stream<ap_uint<8> >             ssTOE_MMIO_MetaDropCnt  ("ssTOE_MMIO_MetaDropCnt");
@@ -2659,124 +2939,1733 @@ int main(int argc, char *argv[]) {
     stream<ap_uint<8> >             ssTOE_MMIO_CrcDropCnt   ("ssTOE_MMIO_CrcDropCnt");
     stream<ap_uint<8> >             ssTOE_MMIO_SessDropCnt  ("ssTOE_MMIO_SessDropCnt");
     stream<ap_uint<8> >             ssTOE_MMIO_OooDropCnt   ("ssTOE_MMIO_OooDropCnt");
-
     stream<ap_uint<16> >            ssTOE_OpnSessCount   ("ssTOE_OpnSessCount");
     stream<ap_uint<16> >            ssTOE_ClsSessCount   ("ssTOE_ClsSessCount");
     stream<RxBufPtr>                ssTOE_RxFreeSpace    ("ssTOE_RxFreeSpace");
     stream<ap_uint<32> >            ssTOE_TcpIprxByteCnt ("ssTOE_TcpIprxByteCnt");
     stream<ap_uint< 8> >            ssTOE_OooDebugState  ("ssTOE_OooDebugState");
-    //------------------------------------------------------
-    //-- TB SIGNALS
-    //------------------------------------------------------
-    StsBit                          sTOE_ReadyDly;
-
-    //-----------------------------------------------------
-    //-- TESTBENCH VARIABLES
-    //-----------------------------------------------------
     #if TOE_FEATURE_USED_FOR_DEBUGGING
         ap_uint<32> sTOE_TB_SimCycCnt;
     #endif
 
-    AxisIp4         ipRxData;    // An IP4 chunk
-    AxisApp         tcpTxData;   // A  TCP chunk
-
-    ap_uint<16>     nrOpenedSessions;
-    ap_uint<16>     nrClosedSessions;
-    ap_uint<32>     nrTcpIprxBytes;
-
     DummyMemory     rxMemory;
     DummyMemory     txMemory;
+    int             nrErr = 0;
 
-    map<SocketPair, TcpAckNum>    sessAckList; // [FIXME -Rename to Map]
-    map<SocketPair, TcpSeqNum>    sessSeqList; // [FIXME -Rename to Map]
-
-    //-- Double-ended queue of packets --------------------
-    deque<SimIp4Packet> ipRxPacketizer; // Packets intended for the IPRX interface of TOE
-
-    //-----------------------------------------------------
-    //-- TESTBENCH INPUT & OUTPUT FILE STREAMS
-    //-----------------------------------------------------
-    ifstream    ifIPRX_Data;   // IP4 packets from IPRX
-    ifstream    ifTAIF_Data;   // APP data    from TAIF
-
-    ofstream    ofTAIF_Data;   // APP byte streams delivered to TAIF
-    ofstream    ofTAIF_Gold;   // Gold reference file for 'ofTAIF_Data'
-    ofstream    ofIPTX_Data1;  // Raw IP packets delivered to IPTX
-    ofstream    ofIPTX_Gold1;  // Gold reference file for 'ofIPTX_Data1' (not used)
-    ofstream    ofIPTX_Data2;  // Tcp payload of the IP packets delivered to IPTX
-    ofstream    ofIPTX_Gold2;  // Gold reference file for 'ofIPTX_Data2'
-
-    const char  *ofTAIF_DataName  = "../../../../test/simOutFiles/soTAIF.strm";
-    const char  *ofTAIF_GoldName  = "../../../../test/simOutFiles/soTAIF.gold";
-    const char  *ofIPTX_Data1Name = "../../../../test/simOutFiles/soIPTX.dat";
-    const char  *ofIPTX_Gold1Name = "../../../../test/simOutFiles/soIPTX.gold";
-    const char  *ofIPTX_Data2Name = "../../../../test/simOutFiles/soIPTX_TcpData.strm";
-    const char  *ofIPTX_Gold2Name = "../../../../test/simOutFiles/soIPTX_TcpData.gold";
-
-    string   dataString, keepString;
-
-    int      nrErr = 0;            // Total number of testbench errors
-
-    int      pktCounter_IPRX_TOE = 0;  // Counts the # IP packets from IPRX-to-TOE (all kinds and from all sessions).
-    int      tcpBytCntr_IPRX_TOE = 0;  // Counts the # TCP bytes  from IPRX-to-TOE.
+    //------------------------------------------------------
+    //-- EXPECTED RATE
+    //--  A segment occupies ceil(wireLen/8) cycles on the
+    //--  IPTX interface and wireLen bytes on the link.
+    //------------------------------------------------------
+    const unsigned int wireLen   = IP4_HEADER_LEN + TCP_HEADER_LEN + TB_LFP_BENCH_MSS;
+    const double       ifGbps    = (8.0 * TB_LFP_BENCH_MSS) / (((wireLen + 7) / 8) * TB_LAT_BENCH_CLK_NS);
+    const double       lnkGbps   = ((double)rateGbps * TB_LFP_BENCH_MSS) / wireLen;
+    const double       maxGbps   = (lnkGbps < ifGbps) ? lnkGbps : ifGbps;
+    const double       bdpBytes  = (maxGbps / 8.0) * (rttUs * 1e3);
+    const double       winGbps   = (8.0 * TOE_MAX_CONGESTION_WINDOW) / (rttUs * 1e3);
+    const double       expGbps   = (winGbps < maxGbps) ? winGbps : maxGbps;
+    const double       cycPerByte = 8.0 / (rateGbps * TB_LAT_BENCH_CLK_NS);
+    const unsigned int rttCycs   = (unsigned int)(rttUs * 1e3 / TB_LAT_BENCH_CLK_NS);
+    const unsigned int endCyc    = nrRtts * rttCycs;
+    const unsigned int measCyc   = endCyc - ((nrRtts >= 4) ? (nrRtts / 4) : 1) * rttCycs;
+
+    printInfo(myName, "Link rate=%d Gb/s - RTT=%d us (%d cycles) - BDP=%.0f bytes - %d RTTs.\n",
+              rateGbps, rttUs, rttCycs, bdpBytes, nrRtts);
+    printInfo(myName, "TCP buffer=%d bytes (TOE_WINDOW_BITS=%d, paging=%d) - Max. window=%d bytes - Window scale=%d.\n",
+              TOE_BUFFER_SIZE, TOE_WINDOW_BITS, TOE_PAGED_BUFFERS, TOE_MAX_CONGESTION_WINDOW, TOE_WINDOW_SCALE);
+    if ((TIME_INIT_RTO * TOE_TIMER_TICK_CYCLES) < rttCycs) {
+        printWarn(myName, "The initial RTO (%d cycles) is shorter than the RTT. Recompile with '-DTOE_SIM_TIME_1S_TICKS=<NUM>' to avoid spurious retransmissions.\n",
+                  (TIME_INIT_RTO * TOE_TIMER_TICK_CYCLES).to_uint());
+    }
 
-    int      pktCounter_TOE_IPTX = 0;  // Counts the # IP packets from TOE-to-IPTX (all kinds and from all sessions).
-    int      tcpBytCntr_TOE_IPTX = 0;  // Counts the # TCP bytes  from TOE-to-IPTX.
+    //------------------------------------------------------
+    //-- THE APP, THE LINK AND THE REMOTE PEER
+    //------------------------------------------------------
+    SockAddr      peerSock(gHostIp4Addr, TB_LFP_BENCH_PORT);
+    SessionId     sessId     = 0;
+    bool          isOpen     = false;
+    bool          isWaitRep  = false;
+    unsigned int  datLeft    = 0;   // The bytes of the current message still to write
+    unsigned long appBytes   = 0;   // The bytes accepted by [TAi]
+    unsigned long ackBytes   = 0;   // The bytes acknowledged to [TOE] so far
+    unsigned long measBytes  = 0;   // The bytes acknowledged at the start of the steady state
+    unsigned long endBytes   = 0;   // The bytes acknowledged at the end of the run
+    unsigned int  openCyc    = 0;
+    unsigned int  nrSegs     = 0;
+    unsigned int  nrRetrans  = 0;
+    unsigned int  nrNoSpace  = 0;
+    TcpSeqNum     toeIsn     = 0;
+    TcpSeqNum     rcvNxt     = 0;   // The next sequence number expected by the peer
+    double        linkFree   = 0;   // The cycle at which the link becomes idle
+    SimIp4Packet  toePkt;           // The packet being received from [TOE]
+    SimIp4Packet  peerPkt;          // The packet being fed to [TOE]
+    TcpAckNum     peerAck    = 0;   // The acknowledgment number of 'peerPkt'
+    deque<pair<unsigned int, SimIp4Packet> > wire;  // The cycles at which the segments of the peer reach [TOE]
+
+    ssTAIF_TOE_OpnReq.write(peerSock);
+
+    unsigned int cyc = 0;
+    unsigned int maxCyc = endCyc + 4 * rttCycs + TB_GRACE_TIME;
+    while (cyc < maxCyc) {
+        bool isRunning = (cyc < endCyc);
+        //-- The APP waits for the connection to be established
+        if (!ssTOE_TAIF_OpnRep.empty()) {
+            TcpAppOpnRep opnRep = ssTOE_TAIF_OpnRep.read();
+            if (opnRep.tcpState != ESTABLISHED) {
+                printError(myName, "Failed to open the connection (state=%s).\n", getTcpStateName(opnRep.tcpState));
+                return false;
+            }
+            sessId  = opnRep.sessId;
+            isOpen  = true;
+            openCyc = cyc;
+        }
+        //-- The APP keeps the Tx buffer full
+        if (isOpen and isRunning and !isWaitRep and (datLeft == 0) and
+            ((appBytes - ackBytes + TB_LFP_BENCH_MSG) < TOE_TX_BUFFER_SIZE)) {
+            ssTAIF_TOE_SndReq.write(TcpAppSndReq(sessId, TB_LFP_BENCH_MSG));
+            isWaitRep = true;
+        }
+        if (!ssTOE_TAIF_SndRep.empty()) {
+            TcpAppSndRep sndRep = ssTOE_TAIF_SndRep.read();
+            if (sndRep.error == NO_ERROR) {
+                datLeft   = TB_LFP_BENCH_MSG;
+                appBytes += TB_LFP_BENCH_MSG;
+            }
+            else if (sndRep.error == NO_SPACE) {
+                // [TAi] did not see the latest ACKs yet. Try again.
+                nrNoSpace++;
+            }
+            else {
+                printError(myName, "Session %d is not established.\n", sessId.to_uint());
+                return false;
+            }
+            isWaitRep = false;
+        }
+        if ((datLeft > 0) and !ssTAIF_TOE_Data.full()) {
+            datLeft -= 8;
+            ssTAIF_TOE_Data.write(AxisApp(0x0123456789ABCDEF, 0xFF, (datLeft == 0) ? TLAST : 0));
+        }
 
-    int      tcpBytCnt_APP_TOE = 0;    // Counts the # TCP bytes from APP-to-TOE.
-    int      tcpBytCnt_TOE_APP = 0;    // Counts the # TCP bytes  from TOE-to-APP.
+        //-- The peer receives the segments of [TOE] and replies with an ACK
+        if (!ssTOE_IPTX_Data.empty()) {
+            AxisIp4 ipChunk = ssTOE_IPTX_Data.read();
+            toePkt.pushChunk(ipChunk);
+            if (ipChunk.getTLast()) {
+                if (toePkt.isSYN() and !toePkt.isACK()) {
+                    toeIsn = toePkt.getTcpSequenceNumber();
+                    rcvNxt = toeIsn + 1;
+                    wire.push_back(make_pair(cyc + rttCycs, lfpBenchSegment(toePkt, 0, rcvNxt, true)));
+                }
+                else if (toePkt.sizeOfTcpData() > 0) {
+                    TcpSeqNum seqNumb = toePkt.getTcpSequenceNumber();
+                    int       datLen  = toePkt.sizeOfTcpData();
+                    nrSegs++;
+                    if (seqNumb == rcvNxt) {
+                        rcvNxt += datLen;
+                    }
+                    else {
+                        nrRetrans++;
+                    }
+                    linkFree = ((linkFree > cyc) ? linkFree : cyc) + toePkt.length() * cycPerByte;
+                    wire.push_back(make_pair((unsigned int)linkFree + rttCycs, lfpBenchSegment(toePkt, 1, rcvNxt, false)));
+                }
+                toePkt.clear();
+            }
+        }
 
-    bool     testRxPath      = false; // Indicates if the Rx path is to be tested.
-    bool     testTxPath      = false; // Indicates if the Tx path is to be tested.
+        //-- The segments of the peer reach [TOE] at one chunk per cycle
+        if ((peerPkt.size() == 0) and !wire.empty() and (wire.front().first <= cyc)) {
+            peerPkt = wire.front().second;
+            peerAck = peerPkt.getTcpAcknowledgeNumber();
+            wire.pop_front();
+        }
+        if (peerPkt.size() > 0) {
+            AxisIp4 ipChunk = peerPkt.pullChunk();
+            ssIPRX_TOE_Data.write(ipChunk);
+            if (ipChunk.getTLast() and isOpen) {
+                ackBytes = ((TcpSeqNum)(peerAck - toeIsn - 1)).to_uint();
+            }
+        }
+        if (cyc == measCyc) {
+            measBytes = ackBytes;
+        }
+        if (cyc == endCyc) {
+            endBytes = ackBytes;
+        }
 
-    int      startUpDelay    = TB_STARTUP_TIME;
+        #if HLS_VERSION == 2017
+          toe_top(
+        #else
+          toe_top_wrap(
+        #endif
+            gFpgaIp4Addr,
+            gCookieKey,
+            ssTOE_MMIO_RxMemWrErr,  ssTOE_MMIO_NotifDropCnt, ssTOE_MMIO_MetaDropCnt,
+            ssTOE_MMIO_DataDropCnt, ssTOE_MMIO_CrcDropCnt,   ssTOE_MMIO_SessDropCnt,
+            ssTOE_MMIO_OooDropCnt,
+            sTOE_Ready,
+            ssIPRX_TOE_Data,     ssTOE_IPTX_Data,
+            ssTOE_TAIF_Notif,    ssTAIF_TOE_DReq,     ssTOE_TAIF_Data,    ssTOE_TAIF_Meta,
+            ssTAIF_TOE_LsnReq,   ssTOE_TAIF_LsnRep,
+            ssTAIF_TOE_Data,     ssTAIF_TOE_SndReq,   ssTOE_TAIF_SndRep,
+            ssTAIF_TOE_OpnReq,   ssTOE_TAIF_OpnRep,
+            ssTAIF_TOE_ClsReq,
+            ssTOE_MEM_RxP_RdCmd, ssMEM_TOE_RxP_Data,  ssMEM_TOE_RxP_WrSts, ssTOE_MEM_RxP_WrCmd, ssTOE_MEM_RxP_Data,
+            ssTOE_MEM_TxP_RdCmd, ssMEM_TOE_TxP_Data,  ssMEM_TOE_TxP_WrSts, ssTOE_MEM_TxP_WrCmd, ssTOE_MEM_TxP_Data,
+            ssTOE_CAM_SssLkpReq, ssCAM_TOE_SssLkpRep, ssTOE_CAM_SssUpdReq, ssCAM_TOE_SssUpdRep,
+            ssTOE_ClsSessCount,  ssTOE_OpnSessCount,  ssTOE_RxFreeSpace,   ssTOE_TcpIprxByteCnt,
+            ssTOE_OooDebugState
+            #if TOE_FEATURE_USED_FOR_DEBUGGING
+            ,
+            sTOE_TB_SimCycCnt
+            #endif
+          );
 
-    char     mode            = *argv[1];
-    char     cCurrPath[FILENAME_MAX];
+        pEmulateRxBufMem(
+            &rxMemory,           nrErr,
+            ssTOE_MEM_RxP_WrCmd, ssTOE_MEM_RxP_Data, ssMEM_TOE_RxP_WrSts,
+            ssTOE_MEM_RxP_RdCmd, ssMEM_TOE_RxP_Data);
+        pEmulateTxBufMem(
+            &txMemory,           nrErr,
+            ssTOE_MEM_TxP_WrCmd, ssTOE_MEM_TxP_Data, ssMEM_TOE_TxP_WrSts,
+            ssTOE_MEM_TxP_RdCmd, ssMEM_TOE_TxP_Data);
+        pEmulateCam(
+            ssTOE_CAM_SssLkpReq, ssCAM_TOE_SssLkpRep,
+            ssTOE_CAM_SssUpdReq, ssCAM_TOE_SssUpdRep);
+
+        //-- Drain the debug streams of [TOE]
+        if (!ssTOE_ClsSessCount.empty())   { ssTOE_ClsSessCount.read();   }
+        if (!ssTOE_OpnSessCount.empty())   { ssTOE_OpnSessCount.read();   }
+        if (!ssTOE_RxFreeSpace.empty())    { ssTOE_RxFreeSpace.read();    }
+        if (!ssTOE_TcpIprxByteCnt.empty()) { ssTOE_TcpIprxByteCnt.read(); }
+        if (!ssTOE_OooDebugState.empty())  { ssTOE_OooDebugState.read();  }
+
+        stepSim();
+        cyc++;
+        if (!isOpen and (cyc > (4 * rttCycs + TB_GRACE_TIME))) {
+            printError(myName, "The connection was not established after %d cycles.\n", cyc);
+            return false;
+        }
+        if (!isRunning and (ackBytes == appBytes) and (datLeft == 0) and !isWaitRep) {
+            break;
+        }
+    }
 
     //------------------------------------------------------
-    //-- REMOVE PREVIOUS OLD SIM FILES and OPEN NEW ONES
+    //-- REPORT
     //------------------------------------------------------
-    remove(ofTAIF_DataName);
-    ofTAIF_Data.open(ofTAIF_DataName);
-    if (!ofTAIF_Data) {
-        printError(THIS_NAME, "Cannot open the Application Tx file:  \n\t %s \n", ofTAIF_DataName);
-        return -1;
-    }
-    remove(ofTAIF_GoldName);
-    ofTAIF_Gold.open(ofTAIF_GoldName);
-    if (!ofTAIF_Gold) {
-        printInfo(THIS_NAME, "Cannot open the Application Tx gold file:  \n\t %s \n", ofTAIF_GoldName);
-        return -1;
+    double avgGbps    = (8.0 * endBytes) / ((endCyc - openCyc) * TB_LAT_BENCH_CLK_NS);
+    double steadyGbps = (8.0 * (endBytes - measBytes)) / ((endCyc - measCyc) * TB_LAT_BENCH_CLK_NS);
+    printInfo(myName, "Segments     = %d received by the peer (%d retransmitted) - %d send requests refused for lack of space.\n",
+              nrSegs, nrRetrans, nrNoSpace);
+    printInfo(myName, "Throughput   = %.2f Gb/s on average - %.2f Gb/s in steady state (expected %.2f Gb/s = min(link %.2f, window %.2f)).\n",
+              avgGbps, steadyGbps, expGbps, maxGbps, winGbps);
+
+    if (nrErr) {
+        printError(myName, "Found %d errors in the emulated memories.\n", nrErr);
+        return false;
     }
-    remove(ofIPTX_Data1Name);
-    ofIPTX_Data1.open(ofIPTX_Data1Name);
-    if (!ofIPTX_Data1) {
-        printError(THIS_NAME, "Cannot open the IP Tx file:  \n\t %s \n", ofIPTX_Data1Name);
-        return -1;
+    if (ackBytes != appBytes) {
+        printError(myName, "Only %lu out of %lu bytes were acknowledged.\n", ackBytes, appBytes);
+        return false;
     }
-    remove(ofIPTX_Data2Name);
-    ofIPTX_Data2.open(ofIPTX_Data2Name);
-    if (!ofIPTX_Data2) {
-        printError(THIS_NAME, "Cannot open the IP Tx file:  \n\t %s \n", ofIPTX_Data2Name);
-        return -1;
+    if (bdpBytes > TOE_MAX_CONGESTION_WINDOW) {
+        printError(myName, "The BDP exceeds the window of the TOE. Recompile with '-DTOE_DDR_WINDOW_BITS=<NUM>' to reach the link rate.\n");
+        return false;
     }
-    remove(ofIPTX_Gold2Name);
-    ofIPTX_Gold1.open(ofIPTX_Gold1Name);
-    if (!ofIPTX_Gold1) {
-        printError(THIS_NAME, "Cannot open the IP Tx gold file:  \n\t %s \n", ofIPTX_Gold1Name);
-        return -1;
+    if (steadyGbps < (expGbps * TB_LFP_BENCH_EFF / 100.0)) {
+        printError(myName, "The steady-state rate is below %d%% of the expected rate.\n", TB_LFP_BENCH_EFF);
+        return false;
     }
-    remove(ofIPTX_Gold2Name);
-    ofIPTX_Gold2.open(ofIPTX_Gold2Name);
-    if (!ofIPTX_Gold2) {
-        printError(THIS_NAME, "Cannot open the IP Tx gold file:  \n\t %s \n", ofIPTX_Gold2Name);
-        return -1;
+    return true;
+}
+
+/*******************************************************************************
+ * @brief Print the minimum, average and maximum of a set of latencies.
+ *
+ * @param[in]  callerName  The name of the caller process (e.g. "TB").
+ * @param[in]  latencies   The latencies to report (in cycles).
+ *******************************************************************************/
+void printLatencyStats(const char *callerName, vector<unsigned int> &latencies)
+{
+    unsigned int minLat = latencies[0];
+    unsigned int maxLat = latencies[0];
+    double       sumLat = 0;
+    for (unsigned int i=0; i<latencies.size(); ++i) {
+        if (latencies[i] < minLat) { minLat = latencies[i]; }
+        if (latencies[i] > maxLat) { maxLat = latencies[i]; }
+        sumLat += latencies[i];
     }
+    double avgLat = sumLat / latencies.size();
+    printInfo(callerName, "Measured %d messages - Latency min=%d avg=%.1f max=%d cycles (avg=%.1f ns).\n",
+              (int)latencies.size(), minLat, avgLat, maxLat, avgLat * TB_LAT_BENCH_CLK_NS);
+}
 
-    printInfo(THIS_NAME, "############################################################################\n");
-    printInfo(THIS_NAME, "## TESTBENCH 'test_toe' STARTS HERE                                       ##\n");
-    printInfo(THIS_NAME, "############################################################################\n");
+/*******************************************************************************
+ * @brief Print the configuration of the TCP buffers of the TOE.
+ *
+ * @param[in]  callerName  The name of the caller process (e.g. "TB").
+ *******************************************************************************/
+void printBufferMemory(const char *callerName)
+{
+    if (TOE_BUFFER_MEMORY == TOE_BUFFER_DDR) {
+        printInfo(callerName, "TCP buffers  = DDR (TOE_BUFFER_MEMORY=TOE_BUFFER_DDR). The DDR round trip of the memory model is %d cycles.\n",
+                  MEM_WR_CMD_LATENCY + MEM_WR_STS_LATENCY + MEM_RD_CMD_LATENCY);
+    }
+    else {
+        printInfo(callerName, "TCP buffers  = On-chip %s of %d bytes per session (TOE_BUFFER_MEMORY=%d).\n",
+                  (TOE_BUFFER_MEMORY == TOE_BUFFER_URAM) ? "URAM" : "BRAM", TOE_BUFFER_SIZE, TOE_BUFFER_MEMORY);
+    }
+}
+
+/*******************************************************************************
+ * @brief Report the number of Rx and Tx buffer pages used by the TOE.
+ *
+ * @param[in]  callerName  The name of the caller process (e.g. "TB").
+ *
+ * @details
+ *  The peak number of pages in use is compared with the amount of memory that
+ *   fixed buffer slots would have reserved for all the sessions of the TOE.
+ *   To compare with a larger window per session, run the same test vector
+ *   file again after recompiling with e.g. '-DTOE_DDR_WINDOW_BITS=22'.
+ *******************************************************************************/
+void reportPageStats(const char *callerName)
+{
+    char myName[120];
+    strcpy(myName, callerName);
+    strcat(myName, "/reportPageStats");
+
+    if (not TOE_PAGED_BUFFERS) {
+        printInfo(myName, "The TCP buffers are not paged (TOE_BUFFER_PAGING=%d, TOE_BUFFER_MEMORY=%d).\n",
+                  TOE_BUFFER_PAGING, TOE_BUFFER_MEMORY);
+        return;
+    }
+
+    unsigned long fixedBytes = (unsigned long)TOE_MAX_SESSIONS * TOE_BUFFER_SIZE;
+    printInfo(myName, "Page size    = %d bytes. Window = %d bytes per session and per direction.\n",
+              (int)TOE_PAGE_SIZE, (int)TOE_BUFFER_SIZE);
+    for (int path=PAL_RX_PATH; path<=PAL_TX_PATH; ++path) {
+        unsigned int pagesInUse, peakPagesInUse;
+        getPageAllocatorStats(path, pagesInUse, peakPagesInUse);
+        unsigned long peakBytes = (unsigned long)peakPagesInUse * TOE_PAGE_SIZE;
+        printInfo(myName, "%s buffers   = %d pages in use (peak = %d pages = %lu bytes, %.1f%% of %lu bytes with fixed slots).\n",
+                  (path == PAL_RX_PATH) ? "Rx" : "Tx", pagesInUse, peakPagesInUse,
+                  peakBytes, (100.0 * peakBytes) / fixedBytes, fixedBytes);
+    }
+}
+
+/*******************************************************************************
+ * @brief Report the number of data segments sent by the TOE per reverse lookup.
+ *
+ * @param[in]  callerName  The name of the caller process (e.g. "TB").
+ *
+ * @details
+ *  A TX event is sent as a burst of MSS segments which share a single lookup
+ *   of the socket pair. A message larger than the MSS is therefore expected
+ *   to yield more than one segment per lookup. Furthermore, the socket pair
+ *   of a session is cached by [TXe] after its first lookup, such that the
+ *   steady-state traffic of a session does not issue any lookup anymore.
+ *******************************************************************************/
+void reportTsoStats(const char *callerName)
+{
+    char myName[120];
+    strcpy(myName, callerName);
+    strcat(myName, "/reportTsoStats");
+
+    unsigned int nrDataSegs, nrRevLookups;
+    getTxEngineStats(nrDataSegs, nrRevLookups);
+    printInfo(myName, "Data segments = %d sent with %d reverse lookups to [SLc] (%.2f segments per lookup).\n",
+              nrDataSegs, nrRevLookups, (nrRevLookups) ? ((double)nrDataSegs / nrRevLookups) : 0.0);
+}
+
+/*******************************************************************************
+ * @brief Report the latency of the small messages sent by the application.
+ *
+ * @param[in]  callerName  The name of the caller process (e.g. "TB").
+ *
+ * @return false if some of the messages were not measured, true otherwise.
+ *
+ * @details
+ *  The latency of a message is the number of cycles between its send request
+ *   on the TAIF interface and the first chunk of its segment on the IPTX
+ *   interface. The messages of the test vector file must fit in a single
+ *   segment and must be spaced out in time, such that each message is sent
+ *   alone in its own segment.
+ *  The DDR bypass and the location of the TCP buffers are compile-time options
+ *   of the TOE. To compare the configurations, run the same test vector file
+ *   again after recompiling with '-DTOE_TCP_NODELAY=0' and/or with
+ *   '-DTOE_BUFFER_MEMORY=TOE_BUFFER_BRAM'.
+ *******************************************************************************/
+bool benchTxLatency(const char *callerName)
+{
+    char myName[120];
+    strcpy(myName, callerName);
+    strcat(myName, "/benchTxLatency");
+
+    if (gTxLatResults.empty()) {
+        printError(myName, "No message was measured.\n");
+        return false;
+    }
+
+    printInfo(myName, "Tx path mode = %s (TOE_TCP_NODELAY=%d).\n",
+              (TOE_TCP_NODELAY) ? "DDR bypass" : "DDR buffered", TOE_TCP_NODELAY);
+    printBufferMemory(myName);
+    printLatencyStats(myName, gTxLatResults);
+
+    if (!gTxLatSndCycs.empty()) {
+        printError(myName, "%d messages were not sent in a segment of their own.\n", (int)gTxLatSndCycs.size());
+        return false;
+    }
+    return true;
+}
+
+/*******************************************************************************
+ * @brief Report the latency of the segments received by the application.
+ *
+ * @param[in]  callerName  The name of the caller process (e.g. "TB").
+ *
+ * @return false if some of the segments were not measured, true otherwise.
+ *
+ * @details
+ *  The latency of a segment is the number of cycles between the injection of
+ *   its IPv4 packet on the IPRX interface and the delivery of its last byte on
+ *   the TAIF interface. It includes the 'APP_RSP_LATENCY' of the testbench.
+ *   The data segments of the test vector file must be received in order.
+ *  To compare the location of the TCP buffers, run the same test vector file
+ *   again after recompiling with '-DTOE_BUFFER_MEMORY=TOE_BUFFER_BRAM'.
+ *******************************************************************************/
+bool benchRxLatency(const char *callerName)
+{
+    char myName[120];
+    strcpy(myName, callerName);
+    strcat(myName, "/benchRxLatency");
+
+    if (gRxLatResults.empty()) {
+        printError(myName, "No segment was measured.\n");
+        return false;
+    }
+
+    printBufferMemory(myName);
+    printLatencyStats(myName, gRxLatResults);
+
+    if (!gRxLatInjCycs.empty()) {
+        printError(myName, "%d segments were not delivered to the application.\n", (int)gRxLatInjCycs.size());
+        return false;
+    }
+    return true;
+}
+
+/*******************************************************************************
+ * @brief Stress the memory writer of the RxEngine with split memory accesses.
+ *
+ * @param[in]  callerName  The name of the caller process (e.g. "TB").
+ * @param[in]  nrSegs      The number of segments to write.
+ *
+ * @return false if a buffer was corrupted or if the throughput is too low.
+ *
+ * @details
+ *  Every segment is placed such that it crosses the end of a buffer page (or
+ *   the end of the circular buffer when the buffers are not paged) and must be
+ *   written as two memory buffers. The length of the segments and the offset
+ *   of the split vary from one segment to the next, such that every alignment
+ *   of the 2nd buffer is exercised. The writer 'pRxMemoryWriter()' is run at
+ *   unit level (one call per cycle) because the memory model of the testbench
+ *   serializes the memory commands. The sustained throughput is compared with
+ *   the ideal one of a chunk per cycle on the memory interface.
+ *  This benchmark re-uses the static state of the memory writer of the TOE. It
+ *   must therefore be run after the main simulation loop.
+ *******************************************************************************/
+bool benchWrapAround(const char *callerName, unsigned int nrSegs)
+{
+    char myName[120];
+    strcpy(myName, callerName);
+    strcat(myName, "/benchWrapAround");
+
+    const int          nrBytesPerChunk = ARW/8;
+    const unsigned int nrPagesPerWnd   = TOE_BUFFER_SIZE / TOE_PAGE_SIZE;
+
+    stream<AxisApp>    ssTsdToMwr_Data("ssTsdToMwr_Data");
+    stream<DmCmd>      ssFsmToMwr_WrCmd("ssFsmToMwr_WrCmd");
+    stream<DmCmd>      ssMwrToMEM_WrCmd("ssMwrToMEM_WrCmd");
+    stream<AxisApp>    ssMwrToMEM_WrData("ssMwrToMEM_WrData");
+    stream<FlagBool>   ssMwrToRan_SplitSeg("ssMwrToRan_SplitSeg");
+
+    vector<DmCmd>      expCmds;
+    unsigned long      nrBytes     = 0;
+    unsigned int       idealCycles = 0;
+
+    //-- Build the segments and their memory write commands
+    for (unsigned int seg=0; seg<nrSegs; ++seg) {
+        int          segLen   = TB_WRAP_BENCH_MSS - (seg % nrBytesPerChunk);
+        int          firstLen = 1 + ((seg * 13) % (segLen - 1));
+        unsigned int page     = seg % nrPagesPerWnd;
+        ap_uint<40>  sessAdr  = (ap_uint<40>)(seg % TOE_MAX_SESSIONS) << TOE_WINDOW_BITS;
+        ap_uint<40>  saddr    = TOE_RX_MEMORY_BASE + sessAdr + (page+1) * TOE_PAGE_SIZE - firstLen;
+        ap_uint<40>  nextAdr  = TOE_RX_MEMORY_BASE + sessAdr + ((page+1) % nrPagesPerWnd) * TOE_PAGE_SIZE;
+        ssFsmToMwr_WrCmd.write(DmCmd(saddr, segLen));
+        expCmds.push_back(DmCmd(saddr, firstLen));
+        expCmds.push_back(DmCmd(nextAdr, segLen - firstLen));
+        for (int i=0; i<segLen; i+=nrBytesPerChunk) {
+            int        len = ((segLen - i) > nrBytesPerChunk) ? nrBytesPerChunk : (segLen - i);
+            ap_uint<ARW> data = 0;
+            for (int b=0; b<len; ++b) {
+                data(8*b+7, 8*b) = (seg + i + b) & 0xFF;
+            }
+            ssTsdToMwr_Data.write(AxisApp(data, lenToLE_tKeep(len), (i + len == segLen) ? TLAST : 0));
+        }
+        nrBytes     += segLen;
+        idealCycles += (firstLen + nrBytesPerChunk - 1) / nrBytesPerChunk +
+                       (segLen - firstLen + nrBytesPerChunk - 1) / nrBytesPerChunk;
+    }
+
+    //-- Run the memory writer until all the buffers were written
+    deque<DmCmd>   outCmds;
+    deque<AxisApp> outChunks;
+    unsigned int   nrBufs   = 0;
+    unsigned int   nrCycles = 0;
+    unsigned int   nrErr    = 0;
+    while ((nrBufs < 2*nrSegs) and (nrCycles < 4*idealCycles)) {
+        pRxMemoryWriter(ssTsdToMwr_Data, ssFsmToMwr_WrCmd,
+                        ssMwrToMEM_WrCmd, ssMwrToMEM_WrData, ssMwrToRan_SplitSeg);
+        nrCycles++;
+        if (!ssMwrToMEM_WrCmd.empty()) {
+            outCmds.push_back(ssMwrToMEM_WrCmd.read());
+        }
+        if (!ssMwrToMEM_WrData.empty()) {
+            AxisApp chunk = ssMwrToMEM_WrData.read();
+            outChunks.push_back(chunk);
+            if (chunk.getTLast()) {
+                nrBufs++;
+            }
+        }
+        if (!ssMwrToRan_SplitSeg.empty()) {
+            if (not ssMwrToRan_SplitSeg.read()) {
+                printError(myName, "A segment was not split (cycle #%d).\n", nrCycles);
+                nrErr++;
+            }
+        }
+    }
+    if (nrBufs < 2*nrSegs) {
+        printError(myName, "Only %d out of %d memory buffers were written after %d cycles.\n",
+                   nrBufs, 2*nrSegs, nrCycles);
+        return false;
+    }
+
+    //-- Check the memory commands and the content of the buffers
+    if (outCmds.size() != expCmds.size()) {
+        printError(myName, "Received %d memory commands instead of %d.\n", (int)outCmds.size(), (int)expCmds.size());
+        nrErr++;
+    }
+    for (unsigned int buf=0; (buf<expCmds.size()) and (buf<outCmds.size()); ++buf) {
+        unsigned int seg = buf / 2;
+        if ((outCmds[buf].saddr != expCmds[buf].saddr) or (outCmds[buf].btt != expCmds[buf].btt)) {
+            printError(myName, "Segment #%d - Buffer #%d - Got command (SADDR=0x%9.9lx, BTT=%d) instead of (SADDR=0x%9.9lx, BTT=%d).\n",
+                       seg, buf%2, (unsigned long)outCmds[buf].saddr.to_uint64(), outCmds[buf].btt.to_uint(),
+                       (unsigned long)expCmds[buf].saddr.to_uint64(), expCmds[buf].btt.to_uint());
+            nrErr++;
+        }
+        int offset  = (buf % 2) ? (int)expCmds[buf-1].btt : 0;
+        int bufLen  = 0;
+        bool isLast = false;
+        while (!isLast and !outChunks.empty()) {
+            AxisApp chunk = outChunks.front();
+            outChunks.pop_front();
+            isLast = chunk.getTLast();
+            for (int b=0; b<nrBytesPerChunk; ++b) {
+                if (chunk.getLE_TKeep()[b]) {
+                    if (chunk.getLE_TData(8*b+7, 8*b) != ((seg + offset + bufLen) & 0xFF)) {
+                        nrErr++;
+                    }
+                    bufLen++;
+                }
+            }
+        }
+        if (bufLen != (int)expCmds[buf].btt) {
+            printError(myName, "Segment #%d - Buffer #%d - Wrote %d bytes instead of %d.\n",
+                       seg, buf%2, bufLen, expCmds[buf].btt.to_uint());
+            nrErr++;
+        }
+    }
+
+    double efficiency = (100.0 * idealCycles) / nrCycles;
+    double gbps       = (8.0 * nrBytes) / (nrCycles * TB_LAT_BENCH_CLK_NS);
+    printInfo(myName, "Wrote %d segments of up to %d bytes with a split on every segment.\n",
+              nrSegs, TB_WRAP_BENCH_MSS);
+    printInfo(myName, "Throughput   = %.2f Gb/s @ %.2f MHz (%d cycles for %d chunks, efficiency = %.1f%%).\n",
+              gbps, 1000.0/TB_LAT_BENCH_CLK_NS, nrCycles, idealCycles, efficiency);
+    if (nrErr) {
+        printError(myName, "Found %d errors in the memory commands or in the buffers.\n", nrErr);
+        return false;
+    }
+    if (efficiency < TB_WRAP_BENCH_EFF) {
+        printError(myName, "The efficiency of the memory writer is below %d%%.\n", TB_WRAP_BENCH_EFF);
+        return false;
+    }
+    return true;
+}
+
+/*******************************************************************************
+ * @brief Benchmark the scheduling of the Tx events for many sessions.
+ *
+ * @param[in]  callerName  The name of the caller process (e.g. "TB").
+ * @param[in]  nrSess      The number of sessions sending messages.
+ * @param[in]  msgLen      The length of the messages (in bytes).
+ *
+ * @return false if a message was not sent or if [TXe] idles too often.
+ *
+ * @details
+ *  Every session keeps one message of 'msgLen' bytes pending on the TAi side
+ *   while the RxEngine issues an ACK event every 'TB_EVE_BENCH_ACK_GAP' cycles.
+ *   The EventEngine and the AckDelayer of the TOE are run at unit level (one
+ *   call per cycle) and the TxEngine is modelled as a sink that stays busy for
+ *   the duration of the segments it sends upon every event. The signal of
+ *   [TXe] is returned to [EVe] after 'TB_EVE_BENCH_RTT' cycles to account for
+ *   the FIFOs and the pipelines of the RTL. The utilization of [TXe] is the
+ *   fraction of the cycles during which it is busy while some data are waiting
+ *   to be sent.
+ *  To compare with one Tx event at a time, run the same test vector file
+ *   again after recompiling with '-DTOE_EVE_IN_FLIGHT=1'. To benchmark more
+ *   sessions than TOE_MAX_SESSIONS, recompile with '-DTOE_NR_SESSIONS=<NUM>'
+ *   ('run_hls.tcl' runs 'siTAIF_ThousandSessTx.dat' in a project of its own
+ *   that is compiled with '-DTOE_NR_SESSIONS=1024').
+ *  This benchmark re-uses the static state of the EventEngine and of the
+ *   AckDelayer of the TOE. It must therefore be run after the main loop.
+ *******************************************************************************/
+bool benchEventEngine(const char *callerName, unsigned int nrSess, unsigned int msgLen)
+{
+    char myName[120];
+    strcpy(myName, callerName);
+    strcat(myName, "/benchEventEngine");
+
+    stream<Event>          ssTAiToEVe_Event("ssTAiToEVe_Event");
+    stream<ExtendedEvent>  ssRXeToEVe_Event("ssRXeToEVe_Event");
+    stream<Event>          ssTImToEVe_Event("ssTImToEVe_Event");
+    stream<ExtendedEvent>  ssEVeToAKd_Event("ssEVeToAKd_Event");
+    stream<SigBit>         ssAKdToEVe_RxEventSig("ssAKdToEVe_RxEventSig");
+    stream<SigBit>         ssAKdToEVe_TxEventSig("ssAKdToEVe_TxEventSig");
+    stream<ExtendedEvent>  ssAKdToTXe_Event("ssAKdToTXe_Event");
+    stream<SigBit>         ssTXeToEVe_RxEventSig("ssTXeToEVe_RxEventSig");
+
+    if (nrSess > TOE_MAX_SESSIONS) {
+        printWarn(myName, "Reducing the number of sessions from %d to %d (TOE_MAX_SESSIONS).\n",
+                  nrSess, TOE_MAX_SESSIONS);
+        nrSess = TOE_MAX_SESSIONS;
+    }
+
+    vector<unsigned int> backlog(nrSess, 0);  // The bytes waiting to be sent per session
+    deque<unsigned int>  txeSigCycs;          // The cycles at which the signals of [TXe] reach [EVe]
+    unsigned int  nextSess    = 0;
+    unsigned int  nrMsgsSent  = 0;
+    unsigned int  nrMsgsRcvd  = 0;
+    unsigned long nrBytesSent = 0;
+    unsigned int  nrBytesLeft = 0;
+    unsigned int  busyCnt     = 0;
+    unsigned int  busyCycs    = 0;
+    unsigned int  idleCycs    = 0;
+    unsigned int  nrEvents    = 0;
+    unsigned int  nrTxEvents  = 0;
+    unsigned int  nrDispatched0, nrCoalesced0;
+    getEventEngineStats(nrDispatched0, nrCoalesced0);
+
+    unsigned int cyc = 0;
+    for (cyc=0; cyc<TB_EVE_BENCH_CYCLES+TB_GRACE_TIME; ++cyc) {
+        bool isRunning = (cyc < TB_EVE_BENCH_CYCLES);
+        //-- The APP keeps one message pending per session
+        if (isRunning and (backlog[nextSess] == 0) and (ssTAiToEVe_Event.size() < cDepth_TAiToEVe_Event)) {
+            backlog[nextSess] = msgLen;
+            nrBytesLeft += msgLen;
+            ssTAiToEVe_Event.write(Event(TX_EVENT, nextSess, 0, msgLen));
+            nrMsgsSent++;
+        }
+        nextSess = (nextSess + 1) % nrSess;
+        //-- The signals of [TXe] reach [EVe] after a round trip
+        while (!txeSigCycs.empty() and (txeSigCycs.front() <= cyc)) {
+            txeSigCycs.pop_front();
+            ssTXeToEVe_RxEventSig.write(1);
+        }
+        //-- The RxEngine requests an ACK every now and then
+        if (isRunning and ((cyc % TB_EVE_BENCH_ACK_GAP) == 0)) {
+            ssRXeToEVe_Event.write(Event(ACK_NODELAY_EVENT, (cyc / TB_EVE_BENCH_ACK_GAP) % nrSess));
+        }
+
+        event_engine(ssTAiToEVe_Event, ssRXeToEVe_Event, ssTImToEVe_Event,
+                     ssEVeToAKd_Event, ssAKdToEVe_RxEventSig, ssAKdToEVe_TxEventSig,
+                     ssTXeToEVe_RxEventSig);
+        ack_delay(ssEVeToAKd_Event, ssAKdToEVe_RxEventSig, ssAKdToEVe_TxEventSig,
+                  ssAKdToTXe_Event);
+
+        //-- The TxEngine sends the segments requested by the events
+        if (busyCnt > 0) {
+            busyCnt--;
+            busyCycs++;
+        }
+        else if (!ssAKdToTXe_Event.empty()) {
+            ExtendedEvent ev = ssAKdToTXe_Event.read();
+            txeSigCycs.push_back(cyc + TB_EVE_BENCH_RTT);
+            nrEvents++;
+            unsigned int sess = ev.sessionID.to_uint();
+            unsigned int cost = TB_EVE_BENCH_HDR_CYCS;
+            if ((ev.type == TX_EVENT) and (sess < nrSess)) {
+                nrTxEvents++;
+                //-- Send everything up to the 'app' pointer of the session
+                unsigned int bytes = backlog[sess];
+                cost = (bytes == 0) ? 2 : 0;
+                while (bytes > 0) {
+                    unsigned int segLen = (bytes > (ZYC2_MSS-TCP_HEADER_LEN)) ? (ZYC2_MSS-TCP_HEADER_LEN) : bytes;
+                    cost  += TB_EVE_BENCH_HDR_CYCS + (segLen + 7) / 8;
+                    bytes -= segLen;
+                }
+                if (backlog[sess] > 0) {
+                    nrMsgsRcvd++;
+                    nrBytesSent += backlog[sess];
+                    nrBytesLeft -= backlog[sess];
+                    backlog[sess] = 0;
+                }
+            }
+            busyCnt = cost - 1;
+            busyCycs++;
+        }
+        else if (nrBytesLeft > 0) {
+            idleCycs++;
+        }
+    }
+
+    unsigned int nrDispatched, nrCoalesced;
+    getEventEngineStats(nrDispatched, nrCoalesced);
+    double util = (busyCycs + idleCycs) ? (100.0 * busyCycs) / (busyCycs + idleCycs) : 0.0;
+    double gbps = (8.0 * nrBytesSent) / (cyc * TB_LAT_BENCH_CLK_NS);
+    printInfo(myName, "Sessions     = %d. Message length = %d bytes. Events in flight = %d (TOE_EVE_IN_FLIGHT).\n",
+              nrSess, msgLen, TOE_EVE_IN_FLIGHT);
+    printInfo(myName, "Messages     = %d sent by the APP, %d sent by [TXe] (%.2f Gb/s @ %.2f MHz).\n",
+              nrMsgsSent, nrMsgsRcvd, gbps, 1000.0/TB_LAT_BENCH_CLK_NS);
+    printInfo(myName, "Events       = %d dispatched by [EVe], %d coalesced, %d received by [TXe].\n",
+              nrDispatched - nrDispatched0, nrCoalesced - nrCoalesced0, nrEvents);
+    printInfo(myName, "Tx events    = %d received by [TXe] (%.2f Mevents/s, %.1f per 1000 cycles).\n",
+              nrTxEvents, (1000.0 * nrTxEvents) / (cyc * TB_LAT_BENCH_CLK_NS), (1000.0 * nrTxEvents) / cyc);
+    printInfo(myName, "Utilization  = %.1f%% of [TXe] (%d busy cycles, %d idle cycles with pending data).\n",
+              util, busyCycs, idleCycs);
+
+    if (nrBytesLeft > 0) {
+        printError(myName, "%d bytes were never sent.\n", nrBytesLeft);
+        return false;
+    }
+    if (util < TB_EVE_BENCH_UTIL) {
+        printError(myName, "The utilization of [TXe] is below %d%%.\n", TB_EVE_BENCH_UTIL);
+        return false;
+    }
+    return true;
+}
+
+/*******************************************************************************
+ * @brief Benchmark the socket pair cache of the TxEngine with many open
+ *         sessions.
+ *
+ * @param[in]  callerName  The name of the caller process (e.g. "TB").
+ * @param[in]  nrSess      The number of sessions to open.
+ * @param[in]  msgLen      The length of the messages (in bytes).
+ *
+ * @return false if a segment carries a wrong socket pair, or if the cache of
+ *          [Sps] or the lookups of [SLc] do not behave as expected.
+ *
+ * @details
+ *  The SessionLookupController (SLc), the MetaDataLoader (Mdl) and the
+ *   SocketPairSplitter (Sps) of the TOE are run at unit level (one call per
+ *   cycle) along with the emulated CAM, while the Rx and Tx SAR tables are
+ *   modelled by the testbench.
+ *  The sessions left open by the main loop are released first. Then, 'nrSess'
+ *   sessions are opened by the RxEngine and looked up a second time, which must
+ *   return the same session IDs, while an unknown socket pair must miss. Every
+ *   session then sends a SYN_ACK, which must miss the cache of [Sps] and look
+ *   the socket pair up in [SLc], followed by a message of 'msgLen' bytes, which
+ *   must hit the cache without any reverse lookup. Finally, one session out of
+ *   'TB_SPC_BENCH_RECYCLE' is closed and reopened with another socket pair. It
+ *   gets the session ID of a closed session, and its segments must not carry
+ *   the socket pair of the former owner of that ID.
+ *  With '-DTOE_NR_SESSIONS=1024' and 1024 sessions, all the session IDs are in
+ *   use and every reopened session gets a recycled ID.
+ *  This benchmark re-uses the static state of the SessionLookupController, of
+ *   the TxEngine and of the emulated CAM of the TOE. It must therefore be run
+ *   after the main loop.
+ *******************************************************************************/
+bool benchSockPairCache(const char *callerName, unsigned int nrSess, unsigned int msgLen)
+{
+    char myName[120];
+    strcpy(myName, callerName);
+    strcat(myName, "/benchSockPairCache");
+
+    //-- Session Lookup Controller (SLc)
+    stream<SessionLookupQuery>      ssRXeToSLc_SessLkpReq("ssRXeToSLc_SessLkpReq");
+    stream<SessionLookupReply>      ssSLcToRXe_SessLkpRep("ssSLcToRXe_SessLkpRep");
+    stream<SessionId>               ssSTtToSLc_SessReleaseCmd("ssSTtToSLc_SessReleaseCmd");
+    stream<TcpPort>                 ssSLcToPRt_ClosePortCmd("ssSLcToPRt_ClosePortCmd");
+    stream<SocketPair>              ssTAiToSLc_SessLkpReq("ssTAiToSLc_SessLkpReq");
+    stream<SessionLookupReply>      ssSLcToTAi_SessLkpRep("ssSLcToTAi_SessLkpRep");
+    stream<SessionId>               ssTBToSLc_ReverseLkpReq("ssTBToSLc_ReverseLkpReq");
+    stream<fourTuple>               ssSLcToSps_ReverseLkpRep("ssSLcToSps_ReverseLkpRep");
+    stream<CamSessionLookupRequest> ssSLcToCAM_SessLkpReq("ssSLcToCAM_SessLkpReq");
+    stream<CamSessionLookupReply>   ssCAMToSLc_SessLkpRep("ssCAMToSLc_SessLkpRep");
+    stream<CamSessionUpdateRequest> ssSLcToCAM_SessUpdReq("ssSLcToCAM_SessUpdReq");
+    stream<CamSessionUpdateReply>   ssCAMToSLc_SessUpdRep("ssCAMToSLc_SessUpdRep");
+    stream<ap_uint<16> >            ssSLcToTB_SssRelCnt("ssSLcToTB_SssRelCnt");
+    stream<ap_uint<16> >            ssSLcToTB_SssRegCnt("ssSLcToTB_SssRegCnt");
+    //-- MetaData Loader (Mdl) and Socket Pair Splitter (Sps)
+    stream<ExtendedEvent>           ssAKdToMdl_Event("ssAKdToMdl_Event");
+    stream<SessionId>               ssMdlToRSt_RxSarReq("ssMdlToRSt_RxSarReq");
+    stream<RxSarReply>              ssRStToMdl_RxSarRep("ssRStToMdl_RxSarRep");
+    stream<TXeTxSarQuery>           ssMdlToTSt_TxSarQry("ssMdlToTSt_TxSarQry");
+    stream<TXeTxSarReply>           ssTStToMdl_TxSarRep("ssTStToMdl_TxSarRep");
+    stream<TXeReTransTimerCmd>      ssMdlToTIm_ReTxTimerCmd("ssMdlToTIm_ReTxTimerCmd");
+    stream<SessionId>               ssMdlToTIm_SetProbeTimer("ssMdlToTIm_SetProbeTimer");
+    stream<IhcMeta>                 ssMdlToIhc_Meta("ssMdlToIhc_Meta");
+    stream<TXeMeta>                 ssMdlToPhc_TxeMeta("ssMdlToPhc_TxeMeta");
+    stream<DmCmd>                   ssMdlToMrd_BufferRdCmd("ssMdlToMrd_BufferRdCmd");
+    stream<SessionId>               ssMdlToTB_ReverseLkpReq("ssMdlToTB_ReverseLkpReq");
+    stream<SpsCmd>                  ssMdlToTB_IsLookup("ssMdlToTB_IsLookup");
+    stream<SpsCmd>                  ssTBToSps_IsLookup("ssTBToSps_IsLookup");
+    stream<PayRdCnt>                ssMdlToTss_PayRdCnt("ssMdlToTss_PayRdCnt");
+    stream<TcaCmd>                  ssMdlToTca_CsumCmd("ssMdlToTca_CsumCmd");
+    stream<FlagBool>                ssMdlToBdf_KeepData("ssMdlToBdf_KeepData");
+    stream<FlagBool>                ssMdlToBdf_KeepCsum("ssMdlToBdf_KeepCsum");
+    stream<LE_SocketPair>           ssMdlToSps_RstSockPair("ssMdlToSps_RstSockPair");
+    stream<SigBit>                  ssMdlToEVe_RxEventSig("ssMdlToEVe_RxEventSig");
+    stream<IpAddrPair>              ssSpsToIhc_IpAddrPair("ssSpsToIhc_IpAddrPair");
+    stream<SocketPair>              ssSpsToPhc_SockPair("ssSpsToPhc_SockPair");
+
+    enum BenchPhases { SPC_RELEASE=0, SPC_OPEN, SPC_CHECK, SPC_SYN_ACK, SPC_TX,
+                       SPC_CLOSE, SPC_REOPEN, SPC_RE_SYN_ACK, SPC_RE_TX, SPC_DONE };
+    const char *phaseNames[] = { "RELEASE", "OPEN", "CHECK", "SYN_ACK", "TX",
+                                 "CLOSE", "REOPEN", "RE_SYN_ACK", "RE_TX", "DONE" };
+
+    if (nrSess > TOE_MAX_SESSIONS) {
+        printWarn(myName, "Reducing the number of sessions from %d to %d (TOE_MAX_SESSIONS).\n",
+                  nrSess, TOE_MAX_SESSIONS);
+        nrSess = TOE_MAX_SESSIONS;
+    }
+    if (msgLen > (ZYC2_MSS-TCP_HEADER_LEN)) {
+        printWarn(myName, "Reducing the message length from %d to %d bytes (one segment per message).\n",
+                  msgLen, ZYC2_MSS-TCP_HEADER_LEN);
+        msgLen = ZYC2_MSS-TCP_HEADER_LEN;
+    }
+
+    SockAddr  fpgaSock(gFpgaIp4Addr, gFpgaLsnPort);
+    SocketPair unknownPair(fpgaSock, SockAddr(TB_SPC_BENCH_HOST_IP + (2 << 16), TB_SPC_BENCH_PORT));
+    unsigned int nrRecycled = (nrSess + TB_SPC_BENCH_RECYCLE - 1) / TB_SPC_BENCH_RECYCLE;
+    vector<SocketPair>    sockPairs(nrSess);  // The socket pair of every session (as sent by [TXe])
+    vector<unsigned int>  sessIds(nrSess, 0); // The session ID of every session
+    map<unsigned int, TXeTxSarReply>  txSars; // The emulated Tx SAR table (per session ID)
+    set<unsigned int>     usedIds;            // The session IDs in use
+    set<unsigned int>     closedIds;          // The session IDs closed by the benchmark
+    deque<unsigned int>   expSess;            // The sessions of the segments expected from [Sps]
+    unsigned int  phase       = SPC_RELEASE;
+    unsigned int  idx         = 0;      // The next session of the current phase
+    bool          isWaiting   = false;  // A lookup is waiting for its reply
+    unsigned int  lkpCyc      = 0;      // The cycle of the pending lookup
+    unsigned int  quietCnt    = 0;
+    unsigned int  nrReleased0 = 0;      // The sessions of the main loop released by [SLc]
+    unsigned int  nrClosed    = 0;      // The sessions of the benchmark released by [SLc]
+    unsigned int  nrLookups   = 0;
+    unsigned int  sumLkpLat   = 0;
+    unsigned int  maxLkpLat   = 0;
+    unsigned int  nrMisses    = 0;      // The SPS_LOOKUP commands of [Mdl]
+    unsigned int  nrHits      = 0;      // The SPS_CACHED commands of [Mdl]
+    unsigned int  nrReuses    = 0;      // The SPS_REUSE  commands of [Mdl]
+    unsigned int  nrRevLkps   = 0;      // The reverse lookups forwarded to [SLc]
+    unsigned int  nrSegs      = 0;
+    unsigned int  nrStale     = 0;
+    unsigned int  nrRecycledIds = 0;
+    unsigned int  nrErr       = 0;
+    unsigned int  nrDataSegs0, nrRevLookups0;
+    getTxEngineStats(nrDataSegs0, nrRevLookups0);
+
+    unsigned int cyc = 0;
+    for (cyc=0; (cyc<TB_SPC_BENCH_CYCLES) and (phase != SPC_DONE); ++cyc) {
+        bool         isRecycling = (phase >= SPC_CLOSE);
+        unsigned int nrItems     = (isRecycling) ? nrRecycled : nrSess;
+        unsigned int sess        = (isRecycling) ? idx*TB_SPC_BENCH_RECYCLE : idx;
+        bool         isPhaseDone = false;
+
+        //-- Drive the current phase of the benchmark
+        switch (phase) {
+        case SPC_RELEASE:
+        case SPC_CLOSE:
+            //-- The StateTable releases the sessions, one per cycle
+            if (idx < ((phase == SPC_RELEASE) ? TOE_MAX_SESSIONS : nrItems)) {
+                unsigned int id = (phase == SPC_RELEASE) ? idx : sessIds[sess];
+                ssSTtToSLc_SessReleaseCmd.write(id);
+                if (phase == SPC_CLOSE) {
+                    usedIds.erase(id);
+                    closedIds.insert(id);
+                }
+                idx++;
+                quietCnt = 0;
+            }
+            else if (ssSTtToSLc_SessReleaseCmd.empty()) {
+                isPhaseDone = (++quietCnt >= TB_SPC_BENCH_QUIET);
+            }
+            break;
+        case SPC_OPEN:
+        case SPC_CHECK:
+        case SPC_REOPEN:
+            //-- The RxEngine looks the sessions up, one at a time
+            if (!isWaiting and (idx < nrItems + ((phase == SPC_CHECK) ? 1 : 0))) {
+                if (phase != SPC_CHECK) {
+                    sockPairs[sess] = SocketPair(fpgaSock,
+                                      SockAddr(TB_SPC_BENCH_HOST_IP + (((phase == SPC_REOPEN) ? 1 : 0) << 16) + sess,
+                                               TB_SPC_BENCH_PORT));
+                }
+                SocketPair sockPair = (idx == nrItems) ? unknownPair : sockPairs[sess];
+                ssRXeToSLc_SessLkpReq.write(SessionLookupQuery(LE_SocketPair(
+                        LE_SockAddr(byteSwap32(sockPair.dst.addr), byteSwap16(sockPair.dst.port)),
+                        LE_SockAddr(byteSwap32(sockPair.src.addr), byteSwap16(sockPair.src.port))),
+                        (phase != SPC_CHECK)));
+                isWaiting = true;
+                lkpCyc    = cyc;
+            }
+            else if (isWaiting and !ssSLcToRXe_SessLkpRep.empty()) {
+                SessionLookupReply reply = ssSLcToRXe_SessLkpRep.read();
+                unsigned int id = reply.sessionID.to_uint();
+                nrLookups++;
+                sumLkpLat += (cyc - lkpCyc);
+                maxLkpLat  = max(maxLkpLat, cyc - lkpCyc);
+                if (idx == nrItems) {
+                    if (reply.hit) {
+                        printError(myName, "An unknown socket pair hit session ID #%d in [SLc].\n", id);
+                        nrErr++;
+                    }
+                }
+                else if (not reply.hit) {
+                    printError(myName, "Session #%d was not %s by [SLc] (phase '%s').\n", sess,
+                               (phase == SPC_CHECK) ? "found" : "opened", phaseNames[phase]);
+                    nrErr++;
+                }
+                else if (phase == SPC_CHECK) {
+                    if (id != sessIds[sess]) {
+                        printError(myName, "Session #%d was opened with ID #%d but found with ID #%d.\n",
+                                   sess, sessIds[sess], id);
+                        nrErr++;
+                    }
+                }
+                else {
+                    if (usedIds.count(id)) {
+                        printError(myName, "Session ID #%d was handed out twice by [SLc].\n", id);
+                        nrErr++;
+                    }
+                    if (closedIds.count(id)) {
+                        nrRecycledIds++;
+                    }
+                    usedIds.insert(id);
+                    sessIds[sess] = id;
+                }
+                isWaiting = false;
+                idx++;
+            }
+            else if (!isWaiting) {
+                isPhaseDone = true;
+            }
+            break;
+        case SPC_SYN_ACK:
+        case SPC_TX:
+        case SPC_RE_SYN_ACK:
+        case SPC_RE_TX:
+            //-- The AckDelayer forwards one event per session
+            if (idx < nrItems) {
+                if (ssAKdToMdl_Event.empty()) {
+                    unsigned int id = sessIds[sess];
+                    if ((phase == SPC_TX) or (phase == SPC_RE_TX)) {
+                        //-- The APP wrote a message into the Tx buffer of the session
+                        txSars[id].app += msgLen;
+                        ssAKdToMdl_Event.write(ExtendedEvent(Event(TX_EVENT, id, 0, msgLen)));
+                    }
+                    else {
+                        txSars[id] = TXeTxSarReply(0, 0, 0xFFFF, 0, false, false);
+                        ssAKdToMdl_Event.write(ExtendedEvent(Event(SYN_ACK_EVENT, id)));
+                    }
+                    expSess.push_back(sess);
+                    idx++;
+                }
+            }
+            else {
+                isPhaseDone = expSess.empty();
+            }
+            break;
+        }
+        if (isPhaseDone) {
+            phase++;
+            idx      = 0;
+            quietCnt = 0;
+        }
+
+        //-- Run the DUT
+        session_lookup_controller(
+                ssRXeToSLc_SessLkpReq,   ssSLcToRXe_SessLkpRep,
+                ssSTtToSLc_SessReleaseCmd, ssSLcToPRt_ClosePortCmd,
+                ssTAiToSLc_SessLkpReq,   ssSLcToTAi_SessLkpRep,
+                ssTBToSLc_ReverseLkpReq, ssSLcToSps_ReverseLkpRep,
+                ssSLcToCAM_SessLkpReq,   ssCAMToSLc_SessLkpRep,
+                ssSLcToCAM_SessUpdReq,   ssCAMToSLc_SessUpdRep,
+                ssSLcToTB_SssRelCnt,     ssSLcToTB_SssRegCnt);
+        pEmulateCam(
+                ssSLcToCAM_SessLkpReq,   ssCAMToSLc_SessLkpRep,
+                ssSLcToCAM_SessUpdReq,   ssCAMToSLc_SessUpdRep);
+        pMetaDataLoader(
+                ssAKdToMdl_Event,
+                ssMdlToRSt_RxSarReq,     ssRStToMdl_RxSarRep,
+                ssMdlToTSt_TxSarQry,     ssTStToMdl_TxSarRep,
+                ssMdlToTIm_ReTxTimerCmd, ssMdlToTIm_SetProbeTimer,
+                ssMdlToIhc_Meta,         ssMdlToPhc_TxeMeta,
+                ssMdlToMrd_BufferRdCmd,  ssMdlToTB_ReverseLkpReq,
+                ssMdlToTB_IsLookup,      ssMdlToTss_PayRdCnt,
+                ssMdlToTca_CsumCmd,      ssMdlToBdf_KeepData,
+                ssMdlToBdf_KeepCsum,     ssMdlToSps_RstSockPair,
+                ssMdlToEVe_RxEventSig);
+        pSocketPairSplitter(
+                ssSLcToSps_ReverseLkpRep, ssMdlToSps_RstSockPair,
+                ssTBToSps_IsLookup,
+                ssSpsToIhc_IpAddrPair,    ssSpsToPhc_SockPair);
+
+        //-- The RxSarTable and the TxSarTable reply to [Mdl]
+        if (!ssMdlToRSt_RxSarReq.empty()) {
+            ssMdlToRSt_RxSarReq.read();
+            ssRStToMdl_RxSarRep.write(RxSarReply(0, 0x1000, 0x1000, 0));
+        }
+        if (!ssMdlToTSt_TxSarQry.empty()) {
+            TXeTxSarQuery  query = ssMdlToTSt_TxSarQry.read();
+            TXeTxSarReply &txSar = txSars[query.sessionID.to_uint()];
+            if (query.write == QUERY_RD) {
+                ssTStToMdl_TxSarRep.write(txSar);
+            }
+            else {
+                //-- Every segment is ACKed at once
+                if (query.init) {
+                    txSar.app = query.not_ackd(TOE_WINDOW_BITS-1, 0);
+                }
+                txSar.not_ackd = query.not_ackd;
+                txSar.ackd     = query.not_ackd;
+            }
+        }
+
+        //-- Count the reverse lookups and the hits of the socket pair cache
+        if (!ssMdlToTB_ReverseLkpReq.empty()) {
+            ssTBToSLc_ReverseLkpReq.write(ssMdlToTB_ReverseLkpReq.read());
+            nrRevLkps++;
+        }
+        if (!ssMdlToTB_IsLookup.empty()) {
+            SpsCmd spsCmd = ssMdlToTB_IsLookup.read();
+            bool   isTx   = (phase == SPC_TX) or (phase == SPC_RE_TX);
+            switch (spsCmd.op) {
+            case SPS_LOOKUP:
+                nrMisses++;
+                if (isTx) {
+                    printError(myName, "The message of session ID #%d missed the socket pair cache.\n",
+                               spsCmd.sessId.to_uint());
+                    nrErr++;
+                }
+                break;
+            case SPS_CACHED:
+                nrHits++;
+                if (not isTx) {
+                    printError(myName, "The SYN_ACK of session ID #%d hit the socket pair cache.\n",
+                               spsCmd.sessId.to_uint());
+                    nrErr++;
+                }
+                break;
+            case SPS_REUSE:
+                nrReuses++;
+                break;
+            default:
+                printError(myName, "Received an unexpected command for [Sps] from [Mdl].\n");
+                nrErr++;
+                break;
+            }
+            ssTBToSps_IsLookup.write(spsCmd);
+        }
+
+        //-- Check the socket pair of every segment
+        if (!ssSpsToPhc_SockPair.empty() and !ssSpsToIhc_IpAddrPair.empty()) {
+            SocketPair sockPair = ssSpsToPhc_SockPair.read();
+            IpAddrPair ipPair   = ssSpsToIhc_IpAddrPair.read();
+            nrSegs++;
+            if (expSess.empty()) {
+                printError(myName, "Received an unexpected socket pair from [Sps].\n");
+                nrErr++;
+            }
+            else {
+                unsigned int s = expSess.front();
+                expSess.pop_front();
+                if (not (sockPair.src == sockPairs[s].src) or not (sockPair.dst == sockPairs[s].dst) or
+                    (ipPair.src != sockPairs[s].src.addr) or (ipPair.dst != sockPairs[s].dst.addr)) {
+                    printError(myName, "Session #%d (ID #%d) was sent with the wrong socket pair (phase '%s'):\n",
+                               s, sessIds[s], phaseNames[phase]);
+                    printSockPair(myName, sockPair);
+                    nrStale++;
+                }
+            }
+        }
+
+        //-- Drain the other outputs
+        if (!ssSLcToPRt_ClosePortCmd.empty()) {
+            ssSLcToPRt_ClosePortCmd.read();
+            if (phase == SPC_RELEASE) {
+                nrReleased0++;
+            }
+            else {
+                nrClosed++;
+            }
+            quietCnt = 0;
+        }
+        if (!ssSLcToTAi_SessLkpRep.empty())    { ssSLcToTAi_SessLkpRep.read();    }
+        if (!ssSLcToTB_SssRelCnt.empty())      { ssSLcToTB_SssRelCnt.read();      }
+        if (!ssSLcToTB_SssRegCnt.empty())      { ssSLcToTB_SssRegCnt.read();      }
+        if (!ssMdlToTIm_ReTxTimerCmd.empty())  { ssMdlToTIm_ReTxTimerCmd.read();  }
+        if (!ssMdlToTIm_SetProbeTimer.empty()) { ssMdlToTIm_SetProbeTimer.read(); }
+        if (!ssMdlToIhc_Meta.empty())          { ssMdlToIhc_Meta.read();          }
+        if (!ssMdlToPhc_TxeMeta.empty())       { ssMdlToPhc_TxeMeta.read();       }
+        if (!ssMdlToMrd_BufferRdCmd.empty())   { ssMdlToMrd_BufferRdCmd.read();   }
+        if (!ssMdlToTss_PayRdCnt.empty())      { ssMdlToTss_PayRdCnt.read();      }
+        if (!ssMdlToTca_CsumCmd.empty())       { ssMdlToTca_CsumCmd.read();       }
+        if (!ssMdlToBdf_KeepData.empty())      { ssMdlToBdf_KeepData.read();      }
+        if (!ssMdlToBdf_KeepCsum.empty())      { ssMdlToBdf_KeepCsum.read();      }
+        if (!ssMdlToEVe_RxEventSig.empty())    { ssMdlToEVe_RxEventSig.read();    }
+    }
+
+    unsigned int nrDataSegs, nrRevLookups;
+    getTxEngineStats(nrDataSegs, nrRevLookups);
+    unsigned int nrEvents = nrSess + nrRecycled;  // The number of SYN_ACKs and of messages
+    printInfo(myName, "Sessions     = %d opened through [SLc] (TOE_MAX_SESSIONS = %d), %d left by the main loop.\n",
+              nrSess, TOE_MAX_SESSIONS, nrReleased0);
+    printInfo(myName, "Lookups      = %d forward lookups in [SLc] (avg = %.1f cycles, max = %d cycles).\n",
+              nrLookups, (nrLookups) ? (double)sumLkpLat / nrLookups : 0.0, maxLkpLat);
+    printInfo(myName, "Recycling    = %d sessions closed and reopened, %d of them on a recycled session ID.\n",
+              nrClosed, nrRecycledIds);
+    printInfo(myName, "Socket pairs = %d sent by [Sps]: %d cache misses, %d cache hits, %d reused in a burst.\n",
+              nrSegs, nrMisses, nrHits, nrReuses);
+    printInfo(myName, "Rev. lookups = %d requested from [SLc] (%.2f per segment), %d wrong socket pairs.\n",
+              nrRevLkps, (nrSegs) ? (double)nrRevLkps / nrSegs : 0.0, nrStale);
+
+    if (phase != SPC_DONE) {
+        printError(myName, "The benchmark did not complete within %d cycles (phase '%s').\n",
+                   TB_SPC_BENCH_CYCLES, phaseNames[phase]);
+        nrErr++;
+    }
+    if ((nrMisses != nrEvents) or (nrHits != nrEvents)) {
+        printError(myName, "Expected %d cache misses (one per SYN_ACK) and as many cache hits (one per message).\n",
+                   nrEvents);
+        nrErr++;
+    }
+    if ((nrRevLkps != nrMisses) or ((nrRevLookups - nrRevLookups0) != nrRevLkps)) {
+        printError(myName, "Expected one reverse lookup per cache miss (%d counted by [TXe]).\n",
+                   nrRevLookups - nrRevLookups0);
+        nrErr++;
+    }
+    if (nrClosed != nrRecycled) {
+        printError(myName, "Expected %d sessions to be closed by [SLc].\n", nrRecycled);
+        nrErr++;
+    }
+    if ((nrSess == TOE_MAX_SESSIONS) and (nrRecycledIds != nrRecycled)) {
+        printError(myName, "Expected every reopened session to get a recycled session ID.\n");
+        nrErr++;
+    }
+    if (nrStale) {
+        nrErr++;
+    }
+    return (nrErr == 0);
+}
+
+/*******************************************************************************
+ * @brief Benchmark the allocation of the ephemeral ports upon a storm of
+ *         client connections.
+ *
+ * @param[in]  callerName  The name of the caller process (e.g. "TB").
+ * @param[in]  nrConns     The number of connections to open and close.
+ *
+ * @return false if a port was handed out twice or if a request took too long.
+ *
+ * @details
+ *  A connection is requested every 'TB_PRT_BENCH_REQ_GAP' cycles. Once its
+ *   free port is received, the connection stays open for a random number of
+ *   cycles before its port is released by the SessionLookupController. In the
+ *   meantime, the RxEngine queries the state of an open port every now and then.
+ *   The PortTable of the TOE is run at unit level (one call per cycle) and the
+ *   connect latency is the number of cycles between a free port request and
+ *   its reply. More than 32768 connections are needed to recycle some ports.
+ *  This benchmark re-uses the static state of the PortTable of the TOE. It must
+ *   therefore be run after the main loop.
+ *******************************************************************************/
+bool benchConnectionStorm(const char *callerName, unsigned int nrConns)
+{
+    char myName[120];
+    strcpy(myName, callerName);
+    strcat(myName, "/benchConnectionStorm");
+
+    StsBool                sPRtToTB_Ready;
+    stream<TcpPort>        ssRXeToPRt_PortStateReq("ssRXeToPRt_PortStateReq");
+    stream<RepBit>         ssPRtToRXe_PortStateRep("ssPRtToRXe_PortStateRep");
+    stream<TcpPort>        ssRAiToPRt_OpenLsnPortReq("ssRAiToPRt_OpenLsnPortReq");
+    stream<AckBit>         ssPRtToRAi_OpenLsnPortAck("ssPRtToRAi_OpenLsnPortAck");
+    stream<ReqBit>         ssTAiToPRt_GetFreePortReq("ssTAiToPRt_GetFreePortReq");
+    stream<TcpPort>        ssPRtToTAi_GetFreePortRep("ssPRtToTAi_GetFreePortRep");
+    stream<TcpPort>        ssSLcToPRt_CloseActPortCmd("ssSLcToPRt_CloseActPortCmd");
+
+    deque<unsigned int>              reqCycs;    // The cycles at which the ports were requested
+    multimap<unsigned int, TcpPort>  closeCycs;  // The cycles at which the open ports get closed
+    set<unsigned int>                openPorts;  // The ports of the open connections
+    set<unsigned int>                usedPorts;  // The ports handed out so far
+    deque<unsigned int>              qryPorts;   // The ports queried by [RXe]
+    vector<unsigned int>             latencies;
+    unsigned int  nrReqs     = 0;
+    unsigned int  nrRecycled = 0;
+    unsigned int  maxOpen    = 0;
+    unsigned int  nrQryErr   = 0;
+    unsigned int  nrDupErr   = 0;
+
+    srand(TB_PRT_BENCH_SEED);
+    unsigned int cyc = 0;
+    while ((latencies.size() < nrConns) or !closeCycs.empty()) {
+        //-- The APP requests a new connection
+        if ((nrReqs < nrConns) and ((cyc % TB_PRT_BENCH_REQ_GAP) == 0)) {
+            ssTAiToPRt_GetFreePortReq.write(1);
+            reqCycs.push_back(cyc);
+            nrReqs++;
+        }
+        //-- The connections which are over release their port
+        if (!closeCycs.empty() and (closeCycs.begin()->first <= cyc)) {
+            TcpPort port = closeCycs.begin()->second;
+            closeCycs.erase(closeCycs.begin());
+            openPorts.erase(port.to_uint());
+            ssSLcToPRt_CloseActPortCmd.write(port);
+        }
+        //-- The RxEngine checks the state of an open port
+        if (!openPorts.empty() and ((cyc % TB_PRT_BENCH_QRY_GAP) == 0)) {
+            unsigned int port = *openPorts.begin();
+            ssRXeToPRt_PortStateReq.write(port);
+            qryPorts.push_back(port);
+        }
+
+        port_table(sPRtToTB_Ready,
+                   ssRXeToPRt_PortStateReq,   ssPRtToRXe_PortStateRep,
+                   ssRAiToPRt_OpenLsnPortReq, ssPRtToRAi_OpenLsnPortAck,
+                   ssTAiToPRt_GetFreePortReq, ssPRtToTAi_GetFreePortRep,
+                   ssSLcToPRt_CloseActPortCmd);
+
+        if (!ssPRtToTAi_GetFreePortRep.empty()) {
+            TcpPort port = ssPRtToTAi_GetFreePortRep.read();
+            latencies.push_back(cyc - reqCycs.front() + 1);
+            reqCycs.pop_front();
+            if (openPorts.count(port.to_uint())) {
+                printError(myName, "Port #%d was handed out while it is still open.\n", port.to_uint());
+                nrDupErr++;
+            }
+            if (usedPorts.count(port.to_uint())) {
+                nrRecycled++;
+            }
+            openPorts.insert(port.to_uint());
+            usedPorts.insert(port.to_uint());
+            if (openPorts.size() > maxOpen) {
+                maxOpen = openPorts.size();
+            }
+            unsigned int hold = TB_PRT_BENCH_HOLD_MIN + (rand() % (TB_PRT_BENCH_HOLD_MAX - TB_PRT_BENCH_HOLD_MIN));
+            closeCycs.insert(make_pair(cyc + hold, port));
+        }
+        if (!ssPRtToRXe_PortStateRep.empty()) {
+            RepBit state = ssPRtToRXe_PortStateRep.read();
+            if ((state != ACT_USED_PORT) and openPorts.count(qryPorts.front())) {
+                printError(myName, "Port #%d is open but [PRt] reports it as free.\n", qryPorts.front());
+                nrQryErr++;
+            }
+            qryPorts.pop_front();
+        }
+        cyc++;
+        if (cyc > nrConns * (TB_PRT_BENCH_REQ_GAP + TB_PRT_BENCH_MAX_LAT) + TB_PRT_BENCH_HOLD_MAX + TB_GRACE_TIME) {
+            printError(myName, "Only %d out of %d connections were opened.\n", (int)latencies.size(), nrConns);
+            return false;
+        }
+    }
+
+    sort(latencies.begin(), latencies.end());
+    unsigned int p50  = latencies[latencies.size() * 50 / 100];
+    unsigned int p99  = latencies[latencies.size() * 99 / 100];
+    unsigned int p999 = latencies[latencies.size() * 999 / 1000];
+    unsigned int pMax = latencies.back();
+    printInfo(myName, "Connections  = %d opened and closed in %d cycles (max. %d open at once, %d on a recycled port).\n",
+              nrConns, cyc, maxOpen, nrRecycled);
+    printInfo(myName, "Connect latency of [PRt] - p50=%d p99=%d p99.9=%d max=%d cycles (max=%.1f ns).\n",
+              p50, p99, p999, pMax, pMax * TB_LAT_BENCH_CLK_NS);
+
+    if (nrDupErr or nrQryErr) {
+        return false;
+    }
+    if (pMax > TB_PRT_BENCH_MAX_LAT) {
+        printError(myName, "The latency of a free port request exceeds %d cycles.\n", TB_PRT_BENCH_MAX_LAT);
+        return false;
+    }
+    return true;
+}
+
+/*******************************************************************************
+ * @brief Build the metadata of a segment sent by the SYN storm benchmark.
+ *
+ * @param[in]  seqNumb  The sequence number of the segment.
+ * @param[in]  ackNumb  The acknowledgment number of the segment.
+ * @param[in]  syn      The SYN flag of the segment.
+ * @param[in]  ack      The ACK flag of the segment.
+ *
+ * @return the metadata of a segment without payload nor option.
+ *******************************************************************************/
+RXeMeta synBenchMeta(TcpSeqNum seqNumb, TcpAckNum ackNumb, bool syn, bool ack)
+{
+    RXeMeta meta;
+    meta.seqNumb    = seqNumb;
+    meta.ackNumb    = ackNumb;
+    meta.winSize    = 0xFFFF;
+    meta.length     = 0;
+    meta.ack        = ack;
+    meta.rst        = 0;
+    meta.syn        = syn;
+    meta.fin        = 0;
+    meta.psh        = 0;
+    meta.ece        = 0;
+    meta.cwr        = 0;
+    meta.ce         = false;
+    meta.sackOk     = false;
+    meta.sackCnt    = 0;
+    meta.winScaleOk = false;
+    meta.winScale   = 0;
+    return meta;
+}
+
+/*******************************************************************************
+ * @brief Benchmark the accept latency of real clients upon a SYN storm.
+ *
+ * @param[in]  callerName  The name of the caller process (e.g. "TB").
+ * @param[in]  nrClients   The number of real clients per phase.
+ *
+ * @return false if a client was not accepted or if the storm increased the
+ *          accept latency of the clients.
+ *
+ * @details
+ *  The SynCookieHasher (Sch) and the MetaDataHandler (Mdh) of the RxEngine are
+ *   run at unit level (one call per cycle), while the testbench emulates the
+ *   SessionLookupController with a table of TOE_MAX_SESSIONS entries, the rest
+ *   of the TOE and the clients.
+ *   A real client sends a SYN every 'TB_SYN_BENCH_CLIENT_GAP' cycles, answers
+ *   the SYN_ACK with an ACK after 'TB_SYN_BENCH_RTT' cycles and retransmits its
+ *   SYN every 'TB_SYN_BENCH_SYN_RTO' cycles until it gets accepted. The accept
+ *   latency is the number of cycles between the first SYN of a client and the
+ *   cycle its ACK is forwarded to the FiniteStateMachine. The session is then
+ *   closed right away.
+ *  The clients are run twice, first alone and then upon a storm of spoofed SYNs
+ *   (one every 'TB_SYN_BENCH_SPOOF_GAP' cycles) which are never ACKed. A session
+ *   allocated by a spoofed SYN stays half-open for 'TB_SYN_BENCH_HALF_OPEN'
+ *   cycles. To compare with a session allocated upon every SYN, run the same
+ *   test vector file again after recompiling with '-DTOE_SYN_COOKIES=0'.
+ *  This benchmark re-uses the static state of the [Sch] and [Mdh] of the TOE.
+ *   It must therefore be run after the main loop.
+ *******************************************************************************/
+bool benchSynStorm(const char *callerName, unsigned int nrClients)
+{
+    char myName[120];
+    strcpy(myName, callerName);
+    strcat(myName, "/benchSynStorm");
+
+    stream<RXeMeta>             ssCsaToSch_Meta("ssCsaToSch_Meta");
+    stream<SocketPair>          ssCsaToSch_SockPair("ssCsaToSch_SockPair");
+    stream<RXeMeta>             ssSchToMdh_Meta("ssSchToMdh_Meta");
+    stream<SocketPair>          ssSchToMdh_SockPair("ssSchToMdh_SockPair");
+    stream<RXeCookie>           ssSchToMdh_Cookie("ssSchToMdh_Cookie");
+    stream<SessionLookupQuery>  ssMdhToSLc_SessLkpReq("ssMdhToSLc_SessLkpReq");
+    stream<SessionLookupReply>  ssSLcToMdh_SessLkpRep("ssSLcToMdh_SessLkpRep");
+    stream<StsBit>              ssPRtToMdh_PortSts("ssPRtToMdh_PortSts");
+    stream<ExtendedEvent>       ssMdhToEVe_Event("ssMdhToEVe_Event");
+    stream<CmdBit>              ssMdhToTsd_DropCmd("ssMdhToTsd_DropCmd");
+    stream<RXeFsmMeta>          ssMdhToFsm_Meta("ssMdhToFsm_Meta");
+    stream<ap_uint<8> >         ssMdhToMMIO_SessDropCnt("ssMdhToMMIO_SessDropCnt");
+
+    SockAddr  fpgaSock(gFpgaIp4Addr, gFpgaLsnPort);
+    map<SocketPair, unsigned int>  slcTable;  // The sessions of the emulated [SLc]
+    deque<unsigned int>            freeIds;   // The free session IDs of [SLc]
+    multimap<unsigned int, SocketPair>               halfOpen;  // The cycles at which the sessions expire
+    multimap<unsigned int, pair<SocketPair, RXeMeta> > wire;    // The cycles at which the segments reach [Mdh]
+    deque<pair<unsigned int, SessionLookupReply> >   lkpReps;   // The cycles at which the lookups complete
+    vector<unsigned int>  p99(2, 0);
+    unsigned int  maxUsed[2] = { 0, 0 };
+    unsigned int  nrSent0, nrAccepted0, nrRejected0;
+    getSynCookieStats(nrSent0, nrAccepted0, nrRejected0);
+
+    for (unsigned int id=0; id<TOE_MAX_SESSIONS; ++id) {
+        freeIds.push_back(id);
+    }
+    srand(TB_SYN_BENCH_SEED);
+
+    unsigned int cyc = 0;
+    for (int phase=0; phase<2; ++phase) {
+        bool                  isStorm = (phase == 1);
+        map<unsigned int, unsigned int> clientOf;  // The client index of an IPv4 address
+        vector<SocketPair>    clientPair(nrClients);
+        vector<TcpSeqNum>     clientIsn(nrClients);
+        vector<unsigned int>  synCyc(nrClients, 0);
+        vector<unsigned int>  rtoCyc(nrClients, 0);
+        vector<bool>          accepted(nrClients, false);
+        vector<unsigned int>  latencies;
+        unsigned int  nrSpoofed = 0;
+        unsigned int  nextClient = 0;
+        unsigned int  startCyc = cyc;
+        unsigned int  stormEnd = startCyc + nrClients * TB_SYN_BENCH_CLIENT_GAP;
+
+        while (latencies.size() < nrClients) {
+            unsigned int  elapsed = cyc - startCyc;
+            //-- A new real client connects
+            if ((nextClient < nrClients) and ((elapsed % TB_SYN_BENCH_CLIENT_GAP) == 0)) {
+                unsigned int c = nextClient++;
+                clientPair[c] = SocketPair(SockAddr(byteSwap32(0x0A0D0000 + (phase << 12) + c), byteSwap16(0x8000 + c)),
+                                           fpgaSock);
+                clientIsn[c]  = rand();
+                clientOf[clientPair[c].src.addr.to_uint()] = c;
+                synCyc[c] = cyc;
+                rtoCyc[c] = cyc + TB_SYN_BENCH_SYN_RTO;
+                wire.insert(make_pair(cyc, make_pair(clientPair[c], synBenchMeta(clientIsn[c], 0, 1, 0))));
+            }
+            //-- The real clients retransmit their unanswered SYN
+            for (unsigned int c=0; c<nextClient; ++c) {
+                if (!accepted[c] and (rtoCyc[c] <= cyc)) {
+                    rtoCyc[c] = cyc + TB_SYN_BENCH_SYN_RTO;
+                    wire.insert(make_pair(cyc, make_pair(clientPair[c], synBenchMeta(clientIsn[c], 0, 1, 0))));
+                }
+            }
+            //-- The attacker sends spoofed SYNs
+            if (isStorm and (cyc < stormEnd) and ((elapsed % TB_SYN_BENCH_SPOOF_GAP) == 0)) {
+                SocketPair spoofPair(SockAddr(byteSwap32(0x0B000000 + (rand() & 0xFFFFFF)), rand() & 0xFFFF),
+                                     fpgaSock);
+                wire.insert(make_pair(cyc, make_pair(spoofPair, synBenchMeta(rand(), 0, 1, 0))));
+                nrSpoofed++;
+            }
+            //-- One segment per cycle reaches [Sch]
+            if (!wire.empty() and (wire.begin()->first <= cyc)) {
+                ssCsaToSch_SockPair.write(wire.begin()->second.first);
+                ssCsaToSch_Meta.write(wire.begin()->second.second);
+                ssPRtToMdh_PortSts.write(STS_OPENED);
+                wire.erase(wire.begin());
+            }
+            //-- The half-open sessions expire
+            while (!halfOpen.empty() and (halfOpen.begin()->first <= cyc)) {
+                map<SocketPair, unsigned int>::iterator it = slcTable.find(halfOpen.begin()->second);
+                if (it != slcTable.end()) {
+                    freeIds.push_back(it->second);
+                    slcTable.erase(it);
+                }
+                halfOpen.erase(halfOpen.begin());
+            }
+
+            pSynCookieHasher(ssCsaToSch_Meta,       ssCsaToSch_SockPair,
+                             gCookieKey,
+                             ssSchToMdh_Meta,       ssSchToMdh_SockPair,
+                             ssSchToMdh_Cookie);
+            pMetaDataHandler(ssSchToMdh_Meta,       ssSchToMdh_SockPair,
+                             ssSchToMdh_Cookie,
+                             ssMdhToSLc_SessLkpReq, ssSLcToMdh_SessLkpRep,
+                             ssPRtToMdh_PortSts,    ssMdhToEVe_Event,
+                             ssMdhToTsd_DropCmd,    ssMdhToFsm_Meta,
+                             ssMdhToMMIO_SessDropCnt);
+
+            //-- The SessionLookupController
+            if (!ssMdhToSLc_SessLkpReq.empty()) {
+                SessionLookupQuery qry = ssMdhToSLc_SessLkpReq.read();
+                SocketPair key(SockAddr(byteSwap32(qry.tuple.src.addr), byteSwap16(qry.tuple.src.port)),
+                               SockAddr(byteSwap32(qry.tuple.dst.addr), byteSwap16(qry.tuple.dst.port)));
+                SessionLookupReply rep(0, SESSION_UNKNOWN);
+                map<SocketPair, unsigned int>::iterator it = slcTable.find(key);
+                if (it != slcTable.end()) {
+                    rep = SessionLookupReply(it->second, SESSION_EXISTS);
+                }
+                else if (qry.allowCreation and !freeIds.empty()) {
+                    rep = SessionLookupReply(freeIds.front(), SESSION_EXISTS);
+                    slcTable[key] = freeIds.front();
+                    freeIds.pop_front();
+                    halfOpen.insert(make_pair(cyc + TB_SYN_BENCH_HALF_OPEN, key));
+                    if (slcTable.size() > maxUsed[phase]) {
+                        maxUsed[phase] = slcTable.size();
+                    }
+                }
+                lkpReps.push_back(make_pair(cyc + TB_SYN_BENCH_LKP_CYCS, rep));
+            }
+            if (!lkpReps.empty() and (lkpReps.front().first <= cyc)) {
+                ssSLcToMdh_SessLkpRep.write(lkpReps.front().second);
+                lkpReps.pop_front();
+            }
+            //-- The TxEngine sends the stateless SYN_ACKs
+            if (!ssMdhToEVe_Event.empty()) {
+                SynCookieEvent ev = ssMdhToEVe_Event.read();
+                if ((ev.type == SYN_COOKIE_EVENT) and !ev.hasSessionID()) {
+                    map<unsigned int, unsigned int>::iterator it = clientOf.find(byteSwap32(ev.tuple.dst.addr).to_uint());
+                    if (it != clientOf.end()) {
+                        unsigned int c = it->second;
+                        wire.insert(make_pair(cyc + TB_SYN_BENCH_RTT, make_pair(clientPair[c],
+                                    synBenchMeta(clientIsn[c]+1, ev.seqNumb+1, 0, 1))));
+                    }
+                }
+            }
+            //-- The FiniteStateMachine
+            if (!ssMdhToFsm_Meta.empty()) {
+                RXeFsmMeta fsmMeta = ssMdhToFsm_Meta.read();
+                map<unsigned int, unsigned int>::iterator it = clientOf.find(fsmMeta.ip4SrcAddr.to_uint());
+                if (fsmMeta.meta.syn and !fsmMeta.cookie) {
+                    // The SYN allocated a session --> [TXe] sends a SYN_ACK
+                    if (it != clientOf.end()) {
+                        unsigned int c = it->second;
+                        wire.insert(make_pair(cyc + TB_SYN_BENCH_RTT, make_pair(clientPair[c],
+                                    synBenchMeta(clientIsn[c]+1, TB_SYN_BENCH_ISS+1, 0, 1))));
+                    }
+                }
+                else if (fsmMeta.meta.ack and !fsmMeta.meta.syn and (it != clientOf.end())) {
+                    // The ACK established the session --> Close it right away
+                    unsigned int c = it->second;
+                    if (!accepted[c]) {
+                        accepted[c] = true;
+                        latencies.push_back(cyc - synCyc[c] + 1);
+                    }
+                    map<SocketPair, unsigned int>::iterator sess = slcTable.find(clientPair[c]);
+                    if (sess != slcTable.end()) {
+                        freeIds.push_back(sess->second);
+                        slcTable.erase(sess);
+                    }
+                }
+            }
+            //-- Drain the other outputs of [Mdh]
+            if (!ssMdhToTsd_DropCmd.empty()) {
+                ssMdhToTsd_DropCmd.read();
+            }
+            if (!ssMdhToMMIO_SessDropCnt.empty()) {
+                ssMdhToMMIO_SessDropCnt.read();
+            }
+            cyc++;
+            if ((cyc - startCyc) > (nrClients * TB_SYN_BENCH_CLIENT_GAP + 4 * TB_SYN_BENCH_SYN_RTO + TB_GRACE_TIME)) {
+                printError(myName, "Only %d out of %d real clients were accepted %s the storm.\n",
+                           (int)latencies.size(), nrClients, (isStorm) ? "upon" : "before");
+                return false;
+            }
+        }
+
+        sort(latencies.begin(), latencies.end());
+        p99[phase] = latencies[latencies.size() * 99 / 100];
+        printInfo(myName, "%s - %d clients accepted (%d spoofed SYNs) - Sessions in use = max. %d out of %d.\n",
+                  (isStorm) ? "Storm" : "Calm ", nrClients, nrSpoofed, maxUsed[phase], TOE_MAX_SESSIONS);
+        printInfo(myName, "%s - Accept latency - p50=%d p99=%d max=%d cycles (p99=%.1f ns).\n",
+                  (isStorm) ? "Storm" : "Calm ", latencies[latencies.size() * 50 / 100], p99[phase],
+                  latencies.back(), p99[phase] * TB_LAT_BENCH_CLK_NS);
+    }
+
+    unsigned int nrSent, nrAccepted, nrRejected;
+    getSynCookieStats(nrSent, nrAccepted, nrRejected);
+    printInfo(myName, "SYN cookies  = %d sent, %d accepted, %d rejected (TOE_SYN_COOKIES=%d).\n",
+              nrSent - nrSent0, nrAccepted - nrAccepted0, nrRejected - nrRejected0, TOE_SYN_COOKIES);
+
+    if (p99[1] > p99[0] + TB_SYN_BENCH_MAX_JITTER) {
+        printError(myName, "The storm increased the p99 accept latency by more than %d cycles.\n",
+                   TB_SYN_BENCH_MAX_JITTER);
+        return false;
+    }
+    return true;
+}
+
+/*****************************************************************************
+ * @brief Main function.
+ *
+ * @param[in]  mode       The test mode (0=RX_MODE,    1=TX_MODE,
+*                                        2=BIDIR_MODE, 3=ECHO_MODE).
+ * @param[in]  inpFile1   The pathname of the input file containing the test
+ *                         vectors to be fed to the TOE:
+ *                         If (mode==0 || mode=2)
+ *                           inpFile1 = siIPRX_<TestName>
+ *                         Else
+ *                           inpFile1 = siTAIF_<TestName>.
+ * @param[in]  inpFile2   The pathname of the second input file containing the
+ *                         test vectors to be fed to the TOE:
+ *                           inpFile2 == siTAIF_<TestName>.
+ * @remark:
+ *  The number of input parameters is variable and depends on the testing mode.
+ *   Example (see also file '../run_hls.tcl'):
+ *    csim_design -argv "0 ../../../../test/testVectors/ipRx_OneSynPkt.dat"
+ *
+ ******************************************************************************/
+int main(int argc, char *argv[]) {
+
+    //------------------------------------------------------
+    //-- TESTBENCH GLOBAL VARIABLES
+    //------------------------------------------------------
+    gSimCycCnt = 0;  // Simulation cycle counter as a global variable
+
+    //------------------------------------------------------
+    //-- DUT SIGNAL INTERFACES
+    //------------------------------------------------------
+    StsBit  sTOE_Ready;
+
+    //------------------------------------------------------
+    //-- DUT STREAM INTERFACES
+    //------------------------------------------------------
+
+    stream<AxisIp4>                 ssIPRX_TOE_Data      ("ssIPRX_TOE_Data");
+
+    stream<AxisIp4>                 ssTOE_IPTX_Data      ("ssTOE_IPTX_Data");
+
+    stream<TcpAppData>              ssTAIF_TOE_Data      ("ssTAIF_TOE_Data");
+    stream<TcpAppSndReq>            ssTAIF_TOE_SndReq    ("ssTAIF_TOE_SndReq");
+    stream<TcpAppSndRep>            ssTOE_TAIF_SndRep    ("ssTOE_TAIF_SndRep");
+
+    stream<TcpAppRdReq>             ssTAIF_TOE_DReq      ("ssTAIF_TOE_DReq");
+    stream<TcpAppData>              ssTOE_TAIF_Data      ("ssTOE_TAIF_Data");
+    stream<TcpAppMeta>              ssTOE_TAIF_Meta      ("ssTOE_TAIF_Meta");
+
+    stream<TcpAppLsnReq>            ssTAIF_TOE_LsnReq    ("ssTAIF_TOE_LsnReq");
+    stream<TcpAppLsnRep>            ssTOE_TAIF_LsnRep    ("ssTOE_TAIF_LsnRep");
+
+    stream<TcpAppOpnReq>            ssTAIF_TOE_OpnReq    ("ssTAIF_TOE_OpnReq");
+    stream<TcpAppOpnRep>            ssTOE_TAIF_OpnRep    ("ssTOE_TAIF_OpnRep");
+
+    stream<TcpAppNotif>             ssTOE_TAIF_Notif     ("ssTOE_TAIF_Notif");
+
+    stream<TcpAppClsReq>            ssTAIF_TOE_ClsReq    ("ssTAIF_TOE_ClsReq");
+
+    stream<DmCmd>                   ssTOE_MEM_RxP_RdCmd  ("ssTOE_MEM_RxP_RdCmd");
+    stream<AxisApp>                 ssMEM_TOE_RxP_Data   ("ssMEM_TOE_RxP_Data");
+    stream<DmSts>                   ssMEM_TOE_RxP_WrSts  ("ssMEM_TOE_RxP_WrSts");
+    stream<DmCmd>                   ssTOE_MEM_RxP_WrCmd  ("ssTOE_MEM_RxP_WrCmd");
+    stream<AxisApp>                 ssTOE_MEM_RxP_Data   ("ssTOE_MEM_RxP_Data");
+
+    stream<DmCmd>                   ssTOE_MEM_TxP_RdCmd  ("ssTOE_MEM_TxP_RdCmd");
+    stream<AxisApp>                 ssMEM_TOE_TxP_Data   ("ssMEM_TOE_TxP_Data");
+    stream<DmSts>                   ssMEM_TOE_TxP_WrSts  ("ssMEM_TOE_TxP_WrSts");
+    stream<DmCmd>                   ssTOE_MEM_TxP_WrCmd  ("ssTOE_MEM_TxP_WrCmd");
+    stream<AxisApp>                 ssTOE_MEM_TxP_Data   ("ssTOE_MEM_TxP_Data");
+
+    stream<CamSessionLookupRequest> ssTOE_CAM_SssLkpReq  ("ssTOE_CAM_SssLkpReq");
+    stream<CamSessionLookupReply>   ssCAM_TOE_SssLkpRep  ("ssCAM_TOE_SssLkpRep");
+    stream<CamSessionUpdateRequest> ssTOE_CAM_SssUpdReq  ("ssTOE_CAM_SssUpdReq");
+    stream<CamSessionUpdateReply>   ssCAM_TOE_SssUpdRep  ("ssCAM_TOE_SssUpdRep");
+
+    stream<StsBit>                  ssTOE_MMIO_RxMemWrErr   ("ssTOE_MMIO_RxMemWrErr");
+    stream<ap_uint<8> >             ssTOE_MMIO_NotifDropCnt ("ssTOE_MMIO_NotifDropCnt");
+    stream<ap_uint<8> >             ssTOE_MMIO_MetaDropCnt  ("ssTOE_MMIO_MetaDropCnt");
+    stream<ap_uint<8> >             ssTOE_MMIO_DataDropCnt  ("ssTOE_MMIO_DataDropCnt");
+    stream<ap_uint<8> >             ssTOE_MMIO_CrcDropCnt   ("ssTOE_MMIO_CrcDropCnt");
+    stream<ap_uint<8> >             ssTOE_MMIO_SessDropCnt  ("ssTOE_MMIO_SessDropCnt");
+    stream<ap_uint<8> >             ssTOE_MMIO_OooDropCnt   ("ssTOE_MMIO_OooDropCnt");
+
+    stream<ap_uint<16> >            ssTOE_OpnSessCount   ("ssTOE_OpnSessCount");
+    stream<ap_uint<16> >            ssTOE_ClsSessCount   ("ssTOE_ClsSessCount");
+    stream<RxBufPtr>                ssTOE_RxFreeSpace    ("ssTOE_RxFreeSpace");
+    stream<ap_uint<32> >            ssTOE_TcpIprxByteCnt ("ssTOE_TcpIprxByteCnt");
+    stream<ap_uint< 8> >            ssTOE_OooDebugState  ("ssTOE_OooDebugState");
+    //------------------------------------------------------
+    //-- TB SIGNALS
+    //------------------------------------------------------
+    StsBit                          sTOE_ReadyDly;
+
+    //-----------------------------------------------------
+    //-- TESTBENCH VARIABLES
+    //-----------------------------------------------------
+    #if TOE_FEATURE_USED_FOR_DEBUGGING
+        ap_uint<32> sTOE_TB_SimCycCnt;
+    #endif
+
+    AxisIp4         ipRxData;    // An IP4 chunk
+    AxisApp         tcpTxData;   // A  TCP chunk
+
+    ap_uint<16>     nrOpenedSessions;
+    ap_uint<16>     nrClosedSessions;
+    ap_uint<32>     nrTcpIprxBytes;
+
+    DummyMemory     rxMemory;
+    DummyMemory     txMemory;
+
+    map<SocketPair, TcpAckNum>    sessAckList; // [FIXME -Rename to Map]
+    map<SocketPair, TcpSeqNum>    sessSeqList; // [FIXME -Rename to Map]
+
+    //-- Double-ended queue of packets --------------------
+    deque<SimIp4Packet> ipRxPacketizer; // Packets intended for the IPRX interface of TOE
+
+    //-----------------------------------------------------
+    //-- TESTBENCH INPUT & OUTPUT FILE STREAMS
+    //-----------------------------------------------------
+    ifstream    ifIPRX_Data;   // IP4 packets from IPRX
+    ifstream    ifTAIF_Data;   // APP data    from TAIF
+
+    ofstream    ofTAIF_Data;   // APP byte streams delivered to TAIF
+    ofstream    ofTAIF_Gold;   // Gold reference file for 'ofTAIF_Data'
+    ofstream    ofIPTX_Data1;  // Raw IP packets delivered to IPTX
+    ofstream    ofIPTX_Gold1;  // Gold reference file for 'ofIPTX_Data1' (not used)
+    ofstream    ofIPTX_Data2;  // Tcp payload of the IP packets delivered to IPTX
+    ofstream    ofIPTX_Gold2;  // Gold reference file for 'ofIPTX_Data2'
+
+    const char  *ofTAIF_DataName  = "../../../../test/simOutFiles/soTAIF.strm";
+    const char  *ofTAIF_GoldName  = "../../../../test/simOutFiles/soTAIF.gold";
+    const char  *ofIPTX_Data1Name = "../../../../test/simOutFiles/soIPTX.dat";
+    const char  *ofIPTX_Gold1Name = "../../../../test/simOutFiles/soIPTX.gold";
+    const char  *ofIPTX_Data2Name = "../../../../test/simOutFiles/soIPTX_TcpData.strm";
+    const char  *ofIPTX_Gold2Name = "../../../../test/simOutFiles/soIPTX_TcpData.gold";
+
+    string   dataString, keepString;
+
+    int      nrErr = 0;            // Total number of testbench errors
+
+    int      pktCounter_IPRX_TOE = 0;  // Counts the # IP packets from IPRX-to-TOE (all kinds and from all sessions).
+    int      tcpBytCntr_IPRX_TOE = 0;  // Counts the # TCP bytes  from IPRX-to-TOE.
+
+    int      pktCounter_TOE_IPTX = 0;  // Counts the # IP packets from TOE-to-IPTX (all kinds and from all sessions).
+    int      tcpBytCntr_TOE_IPTX = 0;  // Counts the # TCP bytes  from TOE-to-IPTX.
+
+    int      tcpBytCnt_APP_TOE = 0;    // Counts the # TCP bytes from APP-to-TOE.
+    int      tcpBytCnt_TOE_APP = 0;    // Counts the # TCP bytes  from TOE-to-APP.
+
+    bool     testRxPath      = false; // Indicates if the Rx path is to be tested.
+    bool     testTxPath      = false; // Indicates if the Tx path is to be tested.
+
+    int      startUpDelay    = TB_STARTUP_TIME;
+
+    char     mode            = *argv[1];
+    char     cCurrPath[FILENAME_MAX];
+
+    //------------------------------------------------------
+    //-- REMOVE PREVIOUS OLD SIM FILES and OPEN NEW ONES
+    //------------------------------------------------------
+    remove(ofTAIF_DataName);
+    ofTAIF_Data.open(ofTAIF_DataName);
+    if (!ofTAIF_Data) {
+        printError(THIS_NAME, "Cannot open the Application Tx file:  \n\t %s \n", ofTAIF_DataName);
+        return -1;
+    }
+    remove(ofTAIF_GoldName);
+    ofTAIF_Gold.open(ofTAIF_GoldName);
+    if (!ofTAIF_Gold) {
+        printInfo(THIS_NAME, "Cannot open the Application Tx gold file:  \n\t %s \n", ofTAIF_GoldName);
+        return -1;
+    }
+    remove(ofIPTX_Data1Name);
+    ofIPTX_Data1.open(ofIPTX_Data1Name);
+    if (!ofIPTX_Data1) {
+        printError(THIS_NAME, "Cannot open the IP Tx file:  \n\t %s \n", ofIPTX_Data1Name);
+        return -1;
+    }
+    remove(ofIPTX_Data2Name);
+    ofIPTX_Data2.open(ofIPTX_Data2Name);
+    if (!ofIPTX_Data2) {
+        printError(THIS_NAME, "Cannot open the IP Tx file:  \n\t %s \n", ofIPTX_Data2Name);
+        return -1;
+    }
+    remove(ofIPTX_Gold2Name);
+    ofIPTX_Gold1.open(ofIPTX_Gold1Name);
+    if (!ofIPTX_Gold1) {
+        printError(THIS_NAME, "Cannot open the IP Tx gold file:  \n\t %s \n", ofIPTX_Gold1Name);
+        return -1;
+    }
+    remove(ofIPTX_Gold2Name);
+    ofIPTX_Gold2.open(ofIPTX_Gold2Name);
+    if (!ofIPTX_Gold2) {
+        printError(THIS_NAME, "Cannot open the IP Tx gold file:  \n\t %s \n", ofIPTX_Gold2Name);
+        return -1;
+    }
+
+    printInfo(THIS_NAME, "############################################################################\n");
+    printInfo(THIS_NAME, "## TESTBENCH 'test_toe' STARTS HERE                                       ##\n");
+    printInfo(THIS_NAME, "############################################################################\n");
     printInfo(THIS_NAME, "This testbench will be executed with the following parameters: \n");
     for (int i=1; i<argc; i++) {
         printInfo(THIS_NAME, "\t==> Param[%d] = %s\n", (i-1), argv[i]);
@@ -2867,6 +4756,7 @@ int main(int argc, char *argv[]) {
         #endif
             //-- MMIO Interfaces
             gFpgaIp4Addr,
+            gCookieKey,
             ssTOE_MMIO_RxMemWrErr,
             ssTOE_MMIO_NotifDropCnt,
             ssTOE_MMIO_MetaDropCnt,
@@ -3182,6 +5072,110 @@ int main(int argc, char *argv[]) {
         }
     }
 
+    //---------------------------------------------------------------
+    //-- RUN THE OUT-OF-ORDER GOODPUT BENCHMARK (if requested)
+    //---------------------------------------------------------------
+    if (gOooBenchSegs) {
+        printf("\n");
+        benchOooReassembly(THIS_NAME, gOooBenchSegs, gOooBenchLoss, gOooBenchReorder);
+    }
+
+    //---------------------------------------------------------------
+    //-- RUN THE LONG FAT PIPE THROUGHPUT BENCHMARK (if requested)
+    //---------------------------------------------------------------
+    if (gLfpBenchRate) {
+        printf("\n");
+        if (not benchLongFatPipe(THIS_NAME, gLfpBenchRate, gLfpBenchRtt, gLfpBenchRtts)) {
+            nrErr++;
+        }
+    }
+
+    //---------------------------------------------------------------
+    //-- RUN THE TX LATENCY BENCHMARK (if requested)
+    //---------------------------------------------------------------
+    if (gTxLatBench) {
+        printf("\n");
+        if (not benchTxLatency(THIS_NAME)) {
+            nrErr++;
+        }
+    }
+
+    //---------------------------------------------------------------
+    //-- RUN THE RX LATENCY BENCHMARK (if requested)
+    //---------------------------------------------------------------
+    if (gRxLatBench) {
+        printf("\n");
+        if (not benchRxLatency(THIS_NAME)) {
+            nrErr++;
+        }
+    }
+
+    //---------------------------------------------------------------
+    //-- REPORT THE BUFFER PAGES IN USE (if requested)
+    //---------------------------------------------------------------
+    if (gPageStats) {
+        printf("\n");
+        reportPageStats(THIS_NAME);
+    }
+
+    //---------------------------------------------------------------
+    //-- REPORT THE SEGMENTATION OFFLOAD (if requested)
+    //---------------------------------------------------------------
+    if (gTsoStats) {
+        printf("\n");
+        reportTsoStats(THIS_NAME);
+    }
+
+    //---------------------------------------------------------------
+    //-- RUN THE WRAP-AROUND STRESS BENCHMARK (if requested)
+    //---------------------------------------------------------------
+    if (gWrapBenchSegs) {
+        printf("\n");
+        if (not benchWrapAround(THIS_NAME, gWrapBenchSegs)) {
+            nrErr++;
+        }
+    }
+
+    //---------------------------------------------------------------
+    //-- RUN THE EVENT ENGINE BENCHMARK (if requested)
+    //---------------------------------------------------------------
+    if (gEveBenchSess) {
+        printf("\n");
+        if (not benchEventEngine(THIS_NAME, gEveBenchSess, gEveBenchLen)) {
+            nrErr++;
+        }
+    }
+
+    //---------------------------------------------------------------
+    //-- RUN THE SOCKET PAIR CACHE BENCHMARK (if requested)
+    //---------------------------------------------------------------
+    if (gSpcBenchSess) {
+        printf("\n");
+        if (not benchSockPairCache(THIS_NAME, gSpcBenchSess, gSpcBenchLen)) {
+            nrErr++;
+        }
+    }
+
+    //---------------------------------------------------------------
+    //-- RUN THE CONNECTION STORM BENCHMARK (if requested)
+    //---------------------------------------------------------------
+    if (gPrtBenchConns) {
+        printf("\n");
+        if (not benchConnectionStorm(THIS_NAME, gPrtBenchConns)) {
+            nrErr++;
+        }
+    }
+
+    //---------------------------------------------------------------
+    //-- RUN THE SYN STORM BENCHMARK (if requested)
+    //---------------------------------------------------------------
+    if (gSynBenchClients) {
+        printf("\n");
+        if (not benchSynStorm(THIS_NAME, gSynBenchClients)) {
+            nrErr++;
+        }
+    }
+
     //---------------------------------------------------------------
     //-- PRINT TESTBENCH STATUS
     //---------------------------------------------------------------
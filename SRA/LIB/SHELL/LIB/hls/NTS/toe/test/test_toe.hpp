@@ -56,8 +56,10 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef _TEST_TOE_H_
 #define _TEST_TOE_H_
 
+#include <algorithm>
 #include <ap_shift_reg.h>
 #include <cstdio>
+#include <deque>
 #include <iostream>
 #include <fstream>
 #include <map>
@@ -72,6 +74,13 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "../../../NTS/SimIp4Packet.hpp"
 #include "../../../NTS/toe/src/toe.hpp"
 #include "../../../NTS/toe/src/toe_utils.hpp"
+#include "../../../NTS/toe/src/rx_engine/src/rx_engine.hpp"
+#include "../../../NTS/toe/src/tx_engine/src/tx_engine.hpp"
+#include "../../../NTS/toe/src/session_lookup_controller/session_lookup_controller.hpp"
+#include "../../../NTS/toe/src/event_engine/event_engine.hpp"
+#include "../../../NTS/toe/src/ack_delay/src/ack_delay.hpp"
+#include "../../../NTS/toe/src/page_allocator/src/page_allocator.hpp"
+#include "../../../NTS/toe/src/port_table/port_table.hpp"
 #include "../../../NTS/toe/test/dummy_memory/dummy_memory.hpp"
 
 
@@ -86,6 +95,74 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //#define TB_MIN_SIM_CYCLES 1000
 #define TB_STARTUP_TIME     25
 
+//---------------------------------------------------------
+//-- OUT-OF-ORDER GOODPUT BENCHMARK
+//---------------------------------------------------------
+#define TB_OOO_BENCH_MSS    1024  // Segment size used by the benchmark
+#define TB_OOO_BENCH_WND      16  // Sender window in number of segments
+#define TB_OOO_BENCH_SEED   1234  // Seed of the pseudo random generator
+
+//---------------------------------------------------------
+//-- LONG FAT PIPE THROUGHPUT BENCHMARK
+//---------------------------------------------------------
+#define TB_LFP_BENCH_MSS    (ZYC2_MSS-TCP_HEADER_LEN) // Segment size sent by [TXe]
+#define TB_LFP_BENCH_MSG    16384 // Length of the messages written by the APP
+#define TB_LFP_BENCH_PORT  0x0059 // Listen port of the remote peer = 89
+#define TB_LFP_BENCH_WSS       14 // Window scale of the remote peer (RFC-7323)
+#define TB_LFP_BENCH_EFF       90 // Min. efficiency (in %) of the steady-state rate
+
+//---------------------------------------------------------
+//-- TX AND RX LATENCY BENCHMARKS
+//---------------------------------------------------------
+#define TB_LAT_BENCH_CLK_NS  6.4  // Period of the TOE clock (156.25MHz)
+
+//---------------------------------------------------------
+//-- WRAP-AROUND STRESS BENCHMARK
+//---------------------------------------------------------
+#define TB_WRAP_BENCH_MSS   (ZYC2_MSS-TCP_HEADER_LEN) // Largest segment size used by the benchmark
+#define TB_WRAP_BENCH_EFF     95  // Min. efficiency (in %) expected from the memory writer
+
+//---------------------------------------------------------
+//-- EVENT ENGINE BENCHMARK
+//---------------------------------------------------------
+#define TB_EVE_BENCH_CYCLES 100000  // Duration of the benchmark
+#define TB_EVE_BENCH_ACK_GAP    16  // Cycles between two ACK events of the RxEngine
+#define TB_EVE_BENCH_HDR_CYCS    7  // Cycles taken by the headers of a segment (54 bytes)
+#define TB_EVE_BENCH_RTT         8  // Estimated round trip from [EVe] to [TXe] and back (3 FIFOs and 3 pipelines)
+#define TB_EVE_BENCH_UTIL       95  // Min. utilization (in %) expected from the TxEngine
+
+//---------------------------------------------------------
+//-- SOCKET PAIR CACHE BENCHMARK
+//---------------------------------------------------------
+#define TB_SPC_BENCH_HOST_IP 0x0A0D0000 // First IPv4 address of the remote peers = 10.13.0.0
+#define TB_SPC_BENCH_PORT    0x8000 // TCP port of the remote peers
+#define TB_SPC_BENCH_RECYCLE      8 // One session out of 8 is closed and reopened with another socket pair
+#define TB_SPC_BENCH_QUIET       32 // Cycles without any release to wait for [SLc] to free the session IDs
+#define TB_SPC_BENCH_CYCLES  500000 // Max. duration of the benchmark
+
+//---------------------------------------------------------
+//-- CONNECTION STORM BENCHMARK
+//---------------------------------------------------------
+#define TB_PRT_BENCH_REQ_GAP     2  // Cycles between two connection requests
+#define TB_PRT_BENCH_HOLD_MIN  500  // Min. lifetime of a connection (in cycles)
+#define TB_PRT_BENCH_HOLD_MAX 4000  // Max. lifetime of a connection (in cycles)
+#define TB_PRT_BENCH_QRY_GAP     7  // Cycles between two port state queries of the RxEngine
+#define TB_PRT_BENCH_MAX_LAT     4  // Max. latency (in cycles) expected from a free port request
+#define TB_PRT_BENCH_SEED     4321  // Seed of the pseudo random generator
+
+//---------------------------------------------------------
+//-- SYN STORM BENCHMARK
+//---------------------------------------------------------
+#define TB_SYN_BENCH_CLIENT_GAP  200  // Cycles between two real clients
+#define TB_SYN_BENCH_SPOOF_GAP    16  // Cycles between two spoofed SYNs during the storm
+#define TB_SYN_BENCH_RTT         100  // Round trip time between the TOE and the clients (in cycles)
+#define TB_SYN_BENCH_LKP_CYCS      4  // Latency of a session lookup (in cycles)
+#define TB_SYN_BENCH_SYN_RTO    5000  // Retransmission timeout of a SYN (in cycles)
+#define TB_SYN_BENCH_HALF_OPEN 20000  // Lifetime of a half-open session (in cycles)
+#define TB_SYN_BENCH_ISS  0x1F2E3D4C  // Initial sequence number of a SYN_ACK sent with a session
+#define TB_SYN_BENCH_MAX_JITTER   32  // Max. increase (in cycles) of the p99 accept latency upon a storm
+#define TB_SYN_BENCH_SEED       5678  // Seed of the pseudo random generator
+
 //---------------------------------------------------------
 //-- DEFAULT LOCAL FPGA AND FOREIGN HOST SOCKETS
 //--  By default, the following sockets will be used by the
@@ -142,7 +219,29 @@ TcpPort         gFpgaLsnPort  = DEFAULT_FPGA_LSN_PORT;  // TCP  listen port
 TcpPort         gFpgaSndPort  = TOE_FIRST_EPHEMERAL_PORT_NUM; // TCP source port
 Ip4Addr         gHostIp4Addr  = DEFAULT_HOST_IP4_ADDR;  // IPv4 address (in NETWORK BYTE ORDER)
 TcpPort         gHostLsnPort  = DEFAULT_HOST_LSN_PORT;  // TCP  listen port
+SynCookieKey    gCookieKey("0F0E0D0C0B0A09080706050403020100", 16);  // SipHash key of the SYN cookies
 bool            gSortTaifGold = false;                  // Do not sort soTAIF.gold file
+unsigned int    gOooBenchSegs = 0;                      // No out-of-order goodput benchmark
+unsigned int    gOooBenchLoss = 0;                      // Segment loss rate of the benchmark (in %)
+unsigned int    gOooBenchReorder = 0;                   // Segment reorder rate of the benchmark (in %)
+unsigned int    gLfpBenchRate = 0;                      // No long fat pipe benchmark (link rate in Gb/s)
+unsigned int    gLfpBenchRtt  = 0;                      // Round trip time of the benchmark (in us)
+unsigned int    gLfpBenchRtts = 0;                      // Number of round trips of the benchmark
+bool            gTxLatBench   = false;                  // No Tx latency benchmark
+deque<unsigned int> gTxLatSndCycs;                      // Cycles at which the APP requested to send a message
+vector<unsigned int> gTxLatResults;                     // Send-to-wire latencies of the messages (in cycles)
+bool            gRxLatBench   = false;                  // No Rx latency benchmark
+deque<unsigned int> gRxLatInjCycs;                      // Cycles at which the data segments were injected
+vector<unsigned int> gRxLatResults;                     // Wire-to-APP latencies of the segments (in cycles)
+bool            gPageStats    = false;                  // No report of the buffer pages in use
+bool            gTsoStats     = false;                  // No report of the segmentation offload
+unsigned int    gWrapBenchSegs = 0;                     // No wrap-around stress benchmark
+unsigned int    gEveBenchSess = 0;                      // No event engine benchmark (number of sessions)
+unsigned int    gEveBenchLen  = 0;                      // Message length of the benchmark (in bytes)
+unsigned int    gSpcBenchSess = 0;                      // No socket pair cache benchmark (number of sessions)
+unsigned int    gSpcBenchLen  = 0;                      // Message length of the benchmark (in bytes)
+unsigned int    gPrtBenchConns = 0;                     // No connection storm benchmark (number of connections)
+unsigned int    gSynBenchClients = 0;                   // No SYN storm benchmark (number of real clients)
 
 bool            gTest_RcvdIp4Packet  = true; // Check the received IPv4 packet
 bool            gTest_RcvdIp4TotLen  = true; // Check the received IPv4-Total-Length field
@@ -34,7 +34,7 @@ set xilPartName    "xcku060-ffva1156-2-i"
 
 set ipName         ${projectName}
 set ipDisplayName  "HLS-based CAM for TOE"
-set ipDescription  "A Content-Addressable Memory with small (8) number of entries."
+set ipDescription  "A hash-based Content-Addressable Memory with a small overflow stash."
 set ipVendor       "IBM"
 set ipLibrary      "hls"
 set ipVersion      "1.0"
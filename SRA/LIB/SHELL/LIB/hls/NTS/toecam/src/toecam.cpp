@@ -22,9 +22,10 @@
  * Component : Shell, Network Transport Stack (NTS)
  * Language  : Vivado HLS
  *
- * @note     : This is a fake implementation of a CAM that is used for debugging
- *              purposes. This CAM implements 8 entries in FF and consumes a
- *              total of 2K LUTs.
+ * @note     : This CAM implements a 2-left hash table with a small overflow
+ *              stash (see 'toecam.hpp'). The buckets are stored in BRAM and
+ *              the stash in FF. It sustains one lookup per clock cycle and
+ *              stores up to TOECAM_CAPACITY sessions.
  *
  * \ingroup NTS
  * \addtogroup NTS_TOECAM
@@ -56,18 +57,44 @@ using namespace hls;
 //--   Use numbers >= to those of the 'Co-simulation Report'
 #define MAX_CAM_LATENCY    0
 
-  /************************************************
-   * GLOBAL VARIABLES & DEFINES
-   ************************************************/
-  #define CAM_ARRAY_SIZE  2
-  static KeyValuePair CamArray0;
-  static KeyValuePair CamArray1;
-  static KeyValuePair CamArray2;
-  static KeyValuePair CamArray3;
-  static KeyValuePair CamArray4;
-  static KeyValuePair CamArray5;
-  static KeyValuePair CamArray6;
-  static KeyValuePair CamArray7;
+/************************************************
+ * GLOBAL VARIABLES & DEFINES
+ ************************************************/
+static KeyValuePair CamBank[TOECAM_BANKS][TOECAM_WAYS][TOECAM_BUCKETS];
+static KeyValuePair CamStash[TOECAM_STASH_SIZE];
+
+/*******************************************************************************
+ * @brief Compute the index of the bucket of a key within a given bank.
+ *
+ * @param[in]  key   The key to hash.
+ * @param[in]  bank  The bank to compute the index for.
+ *
+ * @return the bucket index.
+ *
+ * @details
+ *  The four-tuple is considered as a 96-bit vector which is XOR-folded into
+ *   'TOECAM_BUCKET_BITS' bits. Bank #0 folds the bits in their natural order,
+ *   while bank #1 first permutes them with a stride that is co-prime with 96.
+ *   This keeps the two hash functions independent enough for the 2-left scheme
+ *   while costing nothing but a tree of XOR gates.
+ *******************************************************************************/
+CamBucketIdx camHash(FourTuple key, int bank)
+{
+    #pragma HLS INLINE
+
+    const int CAM_HASH_STRIDE = 37;
+
+    ap_uint<96> keyVec = (key.theirPort, key.myPort, key.theirIp, key.myIp);
+    CamBucketIdx hash = 0;
+    for (int b=0; b<96; b++) {
+        #pragma HLS UNROLL
+        int pos = (bank == 0) ? b : ((b * CAM_HASH_STRIDE) % 96);
+        if (keyVec[b] == 1) {
+            hash ^= (CamBucketIdx(1) << (pos % TOECAM_BUCKET_BITS));
+        }
+    }
+    return hash;
+}
 
 /*******************************************************************************
  * @brief Search the CAM array for a key.
@@ -76,44 +103,42 @@ using namespace hls;
  * @param[out] value The value corresponding to that key.
  *
  * @return true if the the key was found.
+ *
+ * @details
+ *  The two candidate buckets and the stash are all probed in parallel.
  *******************************************************************************/
 bool camLookup(FourTuple key, RtlSessId &value)
 {
-    #pragma HLS pipeline II=1 enable_flush
-    if ((CamArray0.key == key) && (CamArray0.valid == true)) {
-        value = CamArray0.value;
-        return true;
-    }
-    else if ((CamArray1.key == key) && (CamArray1.valid == true)) {
-        value = CamArray1.value;
-        return true;
-    }
-    else if ((CamArray2.key == key) && (CamArray2.valid == true)) {
-        value = CamArray2.value;
-        return true;
-    }
-    else if ((CamArray3.key == key) && (CamArray3.valid == true)) {
-            value = CamArray3.value;
-            return true;
-    }
-    else if ((CamArray4.key == key) && (CamArray4.valid == true)) {
-            value = CamArray4.value;
-            return true;
-    }
-    else if ((CamArray5.key == key) && (CamArray5.valid == true)) {
-            value = CamArray5.value;
-            return true;
+    #pragma HLS INLINE
+
+    CamBucketIdx idx[TOECAM_BANKS];
+    #pragma HLS ARRAY_PARTITION variable=idx complete dim=1
+    bool         hit = false;
+
+    for (int b=0; b<TOECAM_BANKS; b++) {
+        #pragma HLS UNROLL
+        idx[b] = camHash(key, b);
     }
-    else if ((CamArray6.key == key) && (CamArray6.valid == true)) {
-            value = CamArray6.value;
-            return true;
+
+    for (int b=0; b<TOECAM_BANKS; b++) {
+        #pragma HLS UNROLL
+        for (int w=0; w<TOECAM_WAYS; w++) {
+            #pragma HLS UNROLL
+            KeyValuePair kvp = CamBank[b][w][idx[b]];
+            if (!hit && kvp.valid && (kvp.key == key)) {
+                value = kvp.value;
+                hit   = true;
+            }
+        }
     }
-    else if ((CamArray7.key == key) && (CamArray7.valid == true)) {
-            value = CamArray7.value;
-            return true;
+    for (int s=0; s<TOECAM_STASH_SIZE; s++) {
+        #pragma HLS UNROLL
+        if (!hit && CamStash[s].valid && (CamStash[s].key == key)) {
+            value = CamStash[s].value;
+            hit   = true;
+        }
     }
-    else
-        return false;
+    return hit;
 }
 
 /*******************************************************************************
@@ -122,46 +147,75 @@ bool camLookup(FourTuple key, RtlSessId &value)
  * @param[in]  KeyValuePair  The key-value pair to insert.
  *
  * @return true if the the key was inserted.
+ *
+ * @details
+ *  If the key already exists, its value is overwritten. Otherwise, the pair is
+ *   written into the first free slot of the less loaded candidate bucket, or
+ *   into the stash if both candidate buckets are full.
  *******************************************************************************/
 bool camInsert(KeyValuePair kVP)
 {
-    #pragma HLS pipeline II=1 enable_flush
+    #pragma HLS INLINE
 
-    if (CamArray0.valid == false) {
-        CamArray0 = kVP;
-        return true;
+    CamBucketIdx idx[TOECAM_BANKS];
+    #pragma HLS ARRAY_PARTITION variable=idx complete dim=1
+    int          load[TOECAM_BANKS];
+    #pragma HLS ARRAY_PARTITION variable=load complete dim=1
+    int          freeWay[TOECAM_BANKS];
+    #pragma HLS ARRAY_PARTITION variable=freeWay complete dim=1
+
+    //-- Update in place if the key already exists
+    for (int b=0; b<TOECAM_BANKS; b++) {
+        #pragma HLS UNROLL
+        idx[b]     = camHash(kVP.key, b);
+        load[b]    = 0;
+        freeWay[b] = -1;
+        for (int w=0; w<TOECAM_WAYS; w++) {
+            #pragma HLS UNROLL
+            KeyValuePair kvp = CamBank[b][w][idx[b]];
+            if (kvp.valid) {
+                load[b]++;
+                if (kvp.key == kVP.key) {
+                    CamBank[b][w][idx[b]] = kVP;
+                    return true;
+                }
+            }
+            else if (freeWay[b] == -1) {
+                freeWay[b] = w;
+            }
+        }
     }
-    else if (CamArray1.valid == false) {
-        CamArray1 = kVP;
-        return true;
+    for (int s=0; s<TOECAM_STASH_SIZE; s++) {
+        #pragma HLS UNROLL
+        if (CamStash[s].valid && (CamStash[s].key == kVP.key)) {
+            CamStash[s] = kVP;
+            return true;
+        }
     }
-    else if (CamArray2.valid == false) {
-         CamArray2 = kVP;
-         return true;
-     }
-    else if (CamArray3.valid == false) {
-         CamArray3 = kVP;
-         return true;
+
+    //-- Insert into the less loaded bucket (ties go left)
+    if ((freeWay[0] != -1) && (load[0] <= load[1])) {
+        CamBank[0][freeWay[0]][idx[0]] = kVP;
+        return true;
     }
-    else if (CamArray4.valid == false) {
-        CamArray4 = kVP;
+    else if (freeWay[1] != -1) {
+        CamBank[1][freeWay[1]][idx[1]] = kVP;
         return true;
     }
-    else if (CamArray5.valid == false) {
-        CamArray5 = kVP;
+    else if (freeWay[0] != -1) {
+        CamBank[0][freeWay[0]][idx[0]] = kVP;
         return true;
     }
-    else if (CamArray6.valid == false) {
-         CamArray6 = kVP;
-         return true;
-     }
-    else if (CamArray7.valid == false) {
-         CamArray7 = kVP;
-         return true;
-     }
-    else {
-        return false;
+
+    //-- Both buckets are full. Fall back to the stash
+    for (int s=0; s<TOECAM_STASH_SIZE; s++) {
+        #pragma HLS UNROLL
+        if (!CamStash[s].valid) {
+            CamStash[s] = kVP;
+            return true;
+        }
     }
+    return false;
 }
 
 /*******************************************************************************
@@ -173,42 +227,31 @@ bool camInsert(KeyValuePair kVP)
   ******************************************************************************/
 bool camDelete(FourTuple key)
 {
-    #pragma HLS pipeline II=1 enable_flush
+    #pragma HLS INLINE
 
-    if ((CamArray0.key == key) && (CamArray0.valid == true)) {
-        CamArray0.valid = false;
-        return true;
-    }
-    else if ((CamArray1.key == key) && (CamArray1.valid == true)) {
-        CamArray1.valid = false;
-        return true;
-    }
-    else if ((CamArray2.key == key) && (CamArray2.valid == true)) {
-        CamArray2.valid = false;
-        return true;
-    }
-    else if ((CamArray3.key == key) && (CamArray3.valid == true)) {
-        CamArray3.valid = false;
-        return true;
-    }
-    else if ((CamArray4.key == key) && (CamArray4.valid == true)) {
-        CamArray4.valid = false;
-        return true;
-    }
-    else if ((CamArray5.key == key) && (CamArray5.valid == true)) {
-        CamArray5.valid = false;
-        return true;
+    CamBucketIdx idx[TOECAM_BANKS];
+    #pragma HLS ARRAY_PARTITION variable=idx complete dim=1
+
+    for (int b=0; b<TOECAM_BANKS; b++) {
+        #pragma HLS UNROLL
+        idx[b] = camHash(key, b);
+        for (int w=0; w<TOECAM_WAYS; w++) {
+            #pragma HLS UNROLL
+            KeyValuePair kvp = CamBank[b][w][idx[b]];
+            if (kvp.valid && (kvp.key == key)) {
+                CamBank[b][w][idx[b]].valid = false;
+                return true;
+            }
+        }
     }
-    else if ((CamArray6.key == key) && (CamArray6.valid == true)) {
-        CamArray6.valid = false;
-        return true;
+    for (int s=0; s<TOECAM_STASH_SIZE; s++) {
+        #pragma HLS UNROLL
+        if (CamStash[s].valid && (CamStash[s].key == key)) {
+            CamStash[s].valid = false;
+            return true;
+        }
     }
-    else if ((CamArray7.key == key) && (CamArray7.valid == true)) {
-         CamArray7.valid = false;
-         return true;
-     }
-    else
-        return false;
+    return false;
 }
 
 /*******************************************************************************
@@ -220,6 +263,13 @@ bool camDelete(FourTuple key)
  * @param[in]  siTOE_SssUpdReq  Session update request from TOE.
  * @param[out] soTOE_SssUpdRep  Session update reply   to   TOE.
  *
+ * @details
+ *  A lookup request is read, executed and replied within the same iteration,
+ *   which gives a throughput of one lookup per cycle. Update requests are only
+ *   served when no lookup is pending and take two cycles (read-modify-write).
+ *  After a reset, the process clears the valid bits of the table one bucket
+ *   per cycle and keeps the 'poMMIO_CamReady' signal low until done.
+ *
  * @warning
  *  About data structure packing: The bit alignment of a packed wide-word
  *    is inferred from the declaration order of the struct fields. The first
@@ -251,33 +301,42 @@ void toecam(
     const char *myName  = concat3(THIS_NAME, "/", "CAM");
 
     //-- STATIC ARRAYS ---------------------------------------------------------
-    #pragma HLS RESET      variable=CamArray0
-    #pragma HLS RESET      variable=CamArray1
-    #pragma HLS RESET      variable=CamArray2
-    #pragma HLS RESET      variable=CamArray3
-    #pragma HLS RESET      variable=CamArray4
-    #pragma HLS RESET      variable=CamArray5
-    #pragma HLS RESET      variable=CamArray6
-    #pragma HLS RESET      variable=CamArray7
+    #pragma HLS ARRAY_PARTITION variable=CamBank  complete dim=1
+    #pragma HLS ARRAY_PARTITION variable=CamBank  complete dim=2
+    #pragma HLS RESOURCE        variable=CamBank  core=RAM_T2P_BRAM
+    #pragma HLS DEPENDENCE      variable=CamBank  inter false
+    #pragma HLS ARRAY_PARTITION variable=CamStash complete dim=1
+    #pragma HLS RESET           variable=CamStash
 
     //-- STATIC CONTROL VARIABLES (with RESET) ---------------------------------
-    static enum FsmStates { CAM_WAIT_4_REQ=0, CAM_LOOKUP_REP, CAM_UPDATE_REP } \
+    static enum FsmStates { CAM_WAIT_4_REQ=0, CAM_UPDATE_REP } \
                                cam_fsmState=CAM_WAIT_4_REQ;
     #pragma HLS RESET variable=cam_fsmState
-    static int                 cam_startupDelay = 100;
-    #pragma HLS RESET variable=cam_startupDelay
+    static bool                cam_isInit=false;
+    #pragma HLS RESET variable=cam_isInit
+    static CamBucketIdx        cam_initIdx=0;
+    #pragma HLS RESET variable=cam_initIdx
 
     //-- STATIC DATAFLOW VARIABLES --------------------------------------------
-    static CamSessionLookupRequest cam_request;
     static CamSessionUpdateRequest cam_update;
     static int                     cam_idleCnt = 0;
 
     //-----------------------------------------------------
-    //-- EMULATE STARTUP OF CAM
+    //-- INITIALIZE THE CAM
     //-----------------------------------------------------
-    if (cam_startupDelay) {
+    if (!cam_isInit) {
         *poMMIO_CamReady = 0;
-        cam_startupDelay--;
+        for (int b=0; b<TOECAM_BANKS; b++) {
+            #pragma HLS UNROLL
+            for (int w=0; w<TOECAM_WAYS; w++) {
+                #pragma HLS UNROLL
+                CamBank[b][w][cam_initIdx].valid = false;
+            }
+        }
+        if (cam_initIdx == (TOECAM_BUCKETS-1)) {
+            cam_isInit = true;
+        }
+        cam_initIdx++;
         return;
     }
     else {
@@ -289,23 +348,8 @@ void toecam(
     //-----------------------------------------------------
     switch (cam_fsmState) {
     case CAM_WAIT_4_REQ:
-        if (!siTOE_SssLkpReq.empty()) {
-            siTOE_SssLkpReq.read(cam_request);
-            cam_idleCnt = MAX_CAM_LATENCY;
-            cam_fsmState = CAM_LOOKUP_REP;
-        }
-        else if (!siTOE_SssUpdReq.empty()) {
-            siTOE_SssUpdReq.read(cam_update);
-            cam_idleCnt = MAX_CAM_LATENCY;
-            cam_fsmState = CAM_UPDATE_REP;
-        }
-        break;
-    case CAM_LOOKUP_REP:
-        //-- Wait some cycles to match the co-simulation --
-        if (cam_idleCnt > 0) {
-            cam_idleCnt--;
-        }
-        else {
+        if (!siTOE_SssLkpReq.empty() and !soTOE_SssLkpRep.full()) {
+            CamSessionLookupRequest cam_request = siTOE_SssLkpReq.read();
             RtlSessId  rtlValue;
             bool hit = camLookup(cam_request.key, rtlValue);
             if (hit)
@@ -319,7 +363,11 @@ void toecam(
                 LE_SockAddr(cam_request.key.myIp,    cam_request.key.myPort));
                 printSockPair(myName, leSocketPair);
             }
-            cam_fsmState = CAM_WAIT_4_REQ;
+        }
+        else if (!siTOE_SssUpdReq.empty()) {
+            siTOE_SssUpdReq.read(cam_update);
+            cam_idleCnt = MAX_CAM_LATENCY;
+            cam_fsmState = CAM_UPDATE_REP;
         }
         break;
     case CAM_UPDATE_REP:
@@ -327,11 +375,13 @@ void toecam(
         if (cam_idleCnt > 0) {
             cam_idleCnt--;
         }
-        else {
-            // [TODO - What if element does not exist]
+        else if (!soTOE_SssUpdRep.full()) {
             if (cam_update.op == INSERT) {
-                //Is there a check if it already exists?
-                camInsert(KeyValuePair(cam_update.key, cam_update.value, true));
+                bool done = camInsert(KeyValuePair(cam_update.key, cam_update.value, true));
+                if (not done) {
+                    printWarn(myName, "Cannot insert session #%d because the CAM is full.\n",
+                              cam_update.value.to_int());
+                }
                 soTOE_SssUpdRep.write(CamSessionUpdateReply(cam_update.value, INSERT, cam_update.source));
             }
             else {  // DELETE
@@ -341,8 +391,8 @@ void toecam(
             if (DEBUG_LEVEL & TRACE_CAM) {
                 printInfo(myName, "Received a session cam_update request (%d) from %d for socket pair: \n",
                           cam_update.op, cam_update.source.to_int());
-                LE_SocketPair leSocketPair(LE_SockAddr(cam_request.key.theirIp, cam_request.key.theirPort),
-                LE_SockAddr(cam_request.key.myIp,    cam_request.key.myPort));
+                LE_SocketPair leSocketPair(LE_SockAddr(cam_update.key.theirIp, cam_update.key.theirPort),
+                LE_SockAddr(cam_update.key.myIp,    cam_update.key.myPort));
                 printSockPair(myName, leSocketPair);
             }
             cam_fsmState = CAM_WAIT_4_REQ;
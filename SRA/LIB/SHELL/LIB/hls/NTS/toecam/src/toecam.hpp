@@ -35,6 +35,30 @@
 #include "../../../NTS/SimNtsUtils.hpp"
 
 
+/*******************************************************************************
+ * CONFIGURATION OF THE SESSION TABLE
+ *******************************************************************************
+ * The session table is a 2-left hash table. It is made of two banks of
+ *  'TOECAM_BUCKETS' buckets, and every bucket holds 'TOECAM_WAYS' key-value
+ *  pairs. A key is hashed with a different function for each bank and is
+ *  inserted into the less loaded of its two candidate buckets (ties go to the
+ *  left bank). The few keys that collide in both banks are kept in a small
+ *  fully-associative stash.
+ *  All the candidate slots of a key are probed in parallel, which allows the
+ *  table to sustain one lookup per clock cycle.
+ *******************************************************************************/
+#define TOECAM_BANKS          2
+#define TOECAM_BUCKET_BITS   10
+#define TOECAM_BUCKETS      (1 << TOECAM_BUCKET_BITS)  // 1024 buckets per bank
+#define TOECAM_WAYS           2
+#define TOECAM_STASH_SIZE     8
+
+//-- Total number of sessions that can be stored by this CAM (=4104)
+#define TOECAM_CAPACITY     (TOECAM_BANKS*TOECAM_BUCKETS*TOECAM_WAYS + TOECAM_STASH_SIZE)
+
+typedef ap_uint<TOECAM_BUCKET_BITS> CamBucketIdx;
+
+
 /*******************************************************************************
  * INTERNAL TYPES and CLASSES USED BY THIS CAM
  *******************************************************************************/
@@ -240,6 +240,100 @@ void pTOE(
 }
 
 
+/*******************************************************************************
+ * @brief Sweep the load factor of the CAM and report its lookup throughput.
+ *
+ * @param[in]  nrErr            A ref to the error counter of main.
+ * @param[in]  camReady         A ref to the CAM ready signal.
+ * //-- TOE / Lookup Request Interfaces
+ * @param[out] soCAM_SssLkpReq  Session lookup request to CAM,
+ * @param[in]  siCAM_SssLkpRep  Session lookup reply from CAM.
+ * //-- TOE / Update Request Interfaces
+ * @param[out] soCAM_SssUpdReq  Session update request to CAM.
+ * @param[in]  siCAM_SssUpdRep  Session update reply from CAM.
+ *
+ * @details
+ *  For every load factor of the sweep, the CAM is filled with random keys up
+ *   to the requested occupancy, and a lookup is issued back-to-back for every
+ *   key stored so far. The number of misses corresponds to the insertions that
+ *   overflowed both candidate buckets and the stash.
+ ******************************************************************************/
+void benchLoadFactor(
+        int                                 &nrErr,
+        ap_uint<1>                          &camReady,
+        stream<CamSessionLookupRequest>     &soCAM_SssLkpReq,
+        stream<CamSessionLookupReply>       &siCAM_SssLkpRep,
+        stream<CamSessionUpdateRequest>     &soCAM_SssUpdReq,
+        stream<CamSessionUpdateReply>       &siCAM_SssUpdRep)
+{
+    const char *myName = concat3(THIS_NAME, "/", "BENCH");
+
+    vector<FourTuple>  keys;  // The keys inserted so far (index = session ID)
+    set<FourTuple>     used;
+    srand(0xCAFE);
+
+    printInfo(myName, "Load-factor sweep of a CAM with %d entries.\n", TOECAM_CAPACITY);
+    printInfo(myName, "\tLF[%%] | Entries | Misses | Cycles | Lookups/Cycle \n");
+    for (int lf=BENCH_LF_MIN; lf<=BENCH_LF_MAX; lf+=BENCH_LF_STEP) {
+        int target = (TOECAM_CAPACITY * lf) / 100;
+
+        //-- Fill the CAM up to the requested load factor
+        int nrUpdReq = 0;
+        while ((int)keys.size() < target) {
+            FourTuple key(rand(), rand(), rand() & 0xFFFF, rand() & 0xFFFF);
+            if (used.count(key)) {
+                continue;
+            }
+            used.insert(key);
+            soCAM_SssUpdReq.write(CamSessionUpdateRequest(key, keys.size(), INSERT, FROM_RXe));
+            keys.push_back(key);
+            nrUpdReq++;
+        }
+        int watchdog = BENCH_MAX_CYCLES;
+        while (nrUpdReq and watchdog--) {
+            toecam_top(&camReady, soCAM_SssLkpReq, siCAM_SssLkpRep,
+                                  soCAM_SssUpdReq, siCAM_SssUpdRep);
+            if (!siCAM_SssUpdRep.empty()) {
+                siCAM_SssUpdRep.read();
+                nrUpdReq--;
+            }
+            stepSim();
+        }
+
+        //-- Lookup all the keys back-to-back
+        for (unsigned i=0; i<keys.size(); i++) {
+            soCAM_SssLkpReq.write(CamSessionLookupRequest(keys[i], FROM_RXe));
+        }
+        unsigned nrRep = 0, nrMiss = 0, nrCyc = 0;
+        watchdog = BENCH_MAX_CYCLES;
+        while ((nrRep < keys.size()) and watchdog--) {
+            toecam_top(&camReady, soCAM_SssLkpReq, siCAM_SssLkpRep,
+                                  soCAM_SssUpdReq, siCAM_SssUpdRep);
+            if (!siCAM_SssLkpRep.empty()) {
+                CamSessionLookupReply lkpReply = siCAM_SssLkpRep.read();
+                if (not lkpReply.hit) {
+                    nrMiss++;
+                }
+                else if (lkpReply.sessionID != nrRep) {
+                    printError(myName, "Lookup #%d returned a wrong session ID (%d).\n",
+                               nrRep, lkpReply.sessionID.to_int());
+                    nrErr++;
+                }
+                nrRep++;
+            }
+            nrCyc++;
+            stepSim();
+        }
+        if (watchdog < 0) {
+            printError(myName, "The benchmark timed out at load factor %d%%.\n", lf);
+            nrErr++;
+            return;
+        }
+        printInfo(myName, "\t %3d  |  %5d  | %5d  | %6d |     %4.2f \n",
+                  lf, (int)keys.size(), nrMiss, nrCyc, (float)keys.size()/nrCyc);
+    }
+}
+
 /*******************************************************************************
  * @brief Main function.
  *
@@ -318,6 +412,19 @@ int main(int argc, char* argv[]) {
         tbRun--;
     } // End of: while()
 
+    //-----------------------------------------------------
+    //-- LOAD-FACTOR BENCHMARK
+    //-----------------------------------------------------
+    if (nrErr == 0) {
+        benchLoadFactor(
+            nrErr,
+            sMMIO_CamReady,
+            ssTOE_CAM_SssLkpReq,
+            ssCAM_TOE_SssLkpRep,
+            ssTOE_CAM_SssUpdReq,
+            ssCAM_TOE_SssUpdRep);
+    }
+
     printInfo(THIS_NAME, "############################################################################\n");
     printInfo(THIS_NAME, "## TESTBENCH 'test_toecam' ENDS HERE                                      ##\n");
     printInfo(THIS_NAME, "############################################################################\n");
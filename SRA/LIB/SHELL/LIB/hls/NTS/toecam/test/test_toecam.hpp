@@ -32,8 +32,11 @@
 
 #include <hls_stream.h>
 #include <map>
+#include <set>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string>
+#include <vector>
 
 #include "../src/toecam.hpp"
 #include "../../../NTS/nts_types.hpp"
@@ -48,7 +51,7 @@
 //    'TB_STARTUP_DELAY' is used to delay the start of the [TB] functions.
 //    'TB_GRACE_TIME'    adds some cycles to drain the DUT at the end before.
 //---------------------------------------------------------
-#define TB_MAX_SIM_CYCLES     250
+#define TB_MAX_SIM_CYCLES    1500
 #define TB_STARTUP_DELAY        0
 #define TB_GRACE_TIME         500
 
@@ -82,6 +85,17 @@ unsigned int    gMaxSimCycles;
 
 #define CAM_SIZE                 2          // Number of CAM entries.
 
+//---------------------------------------------------------
+//-- LOAD-FACTOR BENCHMARK
+//--  The benchmark fills the CAM with random keys up to a
+//--  given load factor (in % of TOECAM_CAPACITY) and then
+//--  issues back-to-back lookups for all of these keys.
+//---------------------------------------------------------
+#define BENCH_LF_MIN            10          // First load factor of the sweep (in %)
+#define BENCH_LF_MAX           100          // Last  load factor of the sweep (in %)
+#define BENCH_LF_STEP           10          // Load factor increment (in %)
+#define BENCH_MAX_CYCLES    100000          // Watchdog for each phase of the benchmark
+
 #endif
 
 /*! \} */
@@ -161,6 +161,7 @@ if { $hlsCSim} {
     csim_design -argv "0 ../../../../test/testVectors/siIPRX_WeirdDatagrams.dat"
     csim_design -argv "0 ../../../../test/testVectors/siIPRX_ShortMix.dat"
     csim_design -argv "0 ../../../../test/testVectors/siIPRX_NoCsum.dat"
+    csim_design -argv "0 ../../../../test/testVectors/siIPRX_FragDatagrams.dat"
     csim_design -argv "1 ../../../../test/testVectors/siUAIF_OneDatagram.dat"
     csim_design -argv "1 ../../../../test/testVectors/siUAIF_RampDgrmSize.dat"
     csim_design -argv "1 ../../../../test/testVectors/siUAIF_LongDatagrams.dat"
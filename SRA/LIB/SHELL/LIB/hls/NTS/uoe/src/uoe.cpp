@@ -77,17 +77,562 @@ using namespace hls;
 #define TRACE_UCC  1 << 7
 #define TRACE_UHA  1 << 8
 #define TRACE_UPT  1 << 9
+#define TRACE_IRA  1 << 10
 #define TRACE_ALL  0xFFFF
 
 #define DEBUG_LEVEL (TRACE_OFF)
 
 /*** RXe PROCESSES *************************************************************/
 
+#ifndef __SYNTHESIS__
+  //-- The number of reassembled datagrams, evicted contexts and dropped fragments of [Ira] (for the testbench only)
+  static unsigned int iraNrDgrms     = 0;
+  static unsigned int iraNrEvictions = 0;
+  static unsigned int iraNrDrops     = 0;
+
+  /*****************************************************************************
+   * @brief Return the statistics of the IPv4 reassembly of [Ira].
+   *
+   * @param[out] nrDgrms     The number of datagrams reassembled and forwarded.
+   * @param[out] nrEvictions The number of contexts evicted upon timeout or inconsistency.
+   * @param[out] nrDrops     The number of fragments and reassembled datagrams dropped.
+   *****************************************************************************/
+  void getUoeReasmStats(unsigned int &nrDgrms, unsigned int &nrEvictions,
+                        unsigned int &nrDrops) {
+      nrDgrms     = iraNrDgrms;
+      nrEvictions = iraNrEvictions;
+      nrDrops     = iraNrDrops;
+  }
+#endif
+
+/*******************************************************************************
+ * IPv4 Reassembler (Ira)
+ *
+ * @param[in]  siIPRX_Data  IP4 data stream from IpRxHandler (IPRX).
+ * @param[out] soIhs_Data   IP4 data stream to IpHeaderStripper (Ihs).
+ *
+ * @details
+ *  This process reassembles the IPv4 fragments of the incoming UDP datagrams.
+ *  The non-fragmented packets are forwarded as is to [Ihs].
+ *  The payload of a fragment is written at its offset into one of the
+ *  'UOE_REASM_CONTEXTS' reassembly buffers of 64KB, and the 16-bit words of
+ *  that payload are summed on the fly. A coverage bitmap of the 8-byte blocks
+ *  of every context tells which blocks were already received. A fragment whose
+ *  blocks are all covered is a duplicate and is ignored, while a fragment which
+ *  only partially overlaps the received blocks evicts the context. The bytes of
+ *  a datagram are therefore written and summed exactly once, and the datagram
+ *  is complete when its blocks are all covered. Only then, its UDP checksum is
+ *  verified with that sum (unless it was sent without one), and the datagram
+ *  is forwarded to [Ihs] as a single non-fragmented IPv4 packet. Because such a
+ *  datagram may exceed the elastic buffer of the UdpChecksumChecker (Ucc), its
+ *  checksum field is cleared on its way out, which makes [Ucc] stream it rather
+ *  than store it.
+ *  A context which does not complete within 'UOE_REASM_TIMEOUT_MS' is evicted.
+ *  The fragments with IPv4 options, the inconsistent fragments and those which
+ *  do not find a free context are dropped.
+ *  Once a context is released, the words of its coverage bitmap which may have
+ *  been set are cleared (one per cycle) before the context can be reused.
+ *******************************************************************************/
+void pIpReassembler(
+        stream<AxisIp4>      &siIPRX_Data,
+        stream<AxisIp4>      &soIhs_Data)
+{
+    //-- DIRECTIVES FOR THIS PROCESS ------------------------------------------
+    #pragma HLS INLINE off
+    #pragma HLS pipeline II=1 enable_flush
+
+    const char *myName  = concat3(THIS_NAME, "/RXe/", "Ira");
+
+    //-- STATIC ARRAYS --------------------------------------------------------
+    static ap_uint<64>              REASM_BUFFER[UOE_REASM_CONTEXTS*UOE_REASM_CHUNKS];
+    #pragma HLS RESOURCE   variable=REASM_BUFFER core=RAM_T2P_BRAM
+    #pragma HLS DEPENDENCE variable=REASM_BUFFER inter false
+    static ap_uint<64>              REASM_COVER[UOE_REASM_CONTEXTS*UOE_REASM_COVER_WORDS];
+    #pragma HLS RESOURCE   variable=REASM_COVER  core=RAM_T2P_BRAM
+    #pragma HLS DEPENDENCE variable=REASM_COVER  inter false
+
+    //-- STATIC CONTROL VARIABLES (with RESET) --------------------------------
+    static enum FsmStates { FSM_IRA_IDLE=0,    FSM_IRA_PASS,
+                            FSM_IRA_FRAG_HDR1, FSM_IRA_FRAG_HDR2,
+                            FSM_IRA_FRAG_DATA, FSM_IRA_FRAG_RESIDUE,
+                            FSM_IRA_FRAG_END,  FSM_IRA_DROP,
+                            FSM_IRA_CSUM,      FSM_IRA_HDR0,
+                            FSM_IRA_HDR1,      FSM_IRA_HDR2,
+                            FSM_IRA_FLUSH,     FSM_IRA_CLEAR } ira_fsmState=FSM_IRA_IDLE;
+    #pragma HLS RESET           variable=ira_fsmState
+    static bool                 ira_ctxValid[UOE_REASM_CONTEXTS];
+    #pragma HLS RESET           variable=ira_ctxValid
+    #pragma HLS ARRAY_PARTITION variable=ira_ctxValid complete dim=1
+    static bool                 ira_ctxDirty[UOE_REASM_CONTEXTS];  // The coverage bitmap must be cleared
+    #pragma HLS RESET           variable=ira_ctxDirty
+    #pragma HLS ARRAY_PARTITION variable=ira_ctxDirty complete dim=1
+    static ap_uint<32>          ira_cycleCnt=0;  // Free-running cycle counter
+    #pragma HLS RESET           variable=ira_cycleCnt
+    static ap_uint<4>           ira_scanIdx=0;
+    #pragma HLS RESET           variable=ira_scanIdx
+
+    //-- STATIC DATAFLOW VARIABLES --------------------------------------------
+    //--  The context of the datagrams being reassembled
+    static Ip4Addr     ira_ctxSrc[UOE_REASM_CONTEXTS];
+    #pragma HLS ARRAY_PARTITION variable=ira_ctxSrc  complete dim=1
+    static Ip4Addr     ira_ctxDst[UOE_REASM_CONTEXTS];
+    #pragma HLS ARRAY_PARTITION variable=ira_ctxDst  complete dim=1
+    static Ip4Ident    ira_ctxId[UOE_REASM_CONTEXTS];
+    #pragma HLS ARRAY_PARTITION variable=ira_ctxId   complete dim=1
+    static Ip4ToS      ira_ctxToS[UOE_REASM_CONTEXTS];
+    #pragma HLS ARRAY_PARTITION variable=ira_ctxToS  complete dim=1
+    static Ip4TtL      ira_ctxTtl[UOE_REASM_CONTEXTS];
+    #pragma HLS ARRAY_PARTITION variable=ira_ctxTtl  complete dim=1
+    static ap_uint<17> ira_ctxRcvd[UOE_REASM_CONTEXTS];  // Bytes covered so far
+    #pragma HLS ARRAY_PARTITION variable=ira_ctxRcvd complete dim=1
+    static ap_uint<17> ira_ctxEnd[UOE_REASM_CONTEXTS];   // Highest end offset of the fragments
+    #pragma HLS ARRAY_PARTITION variable=ira_ctxEnd  complete dim=1
+    static ap_uint<17> ira_ctxLen[UOE_REASM_CONTEXTS];   // Datagram length (set by the last fragment)
+    #pragma HLS ARRAY_PARTITION variable=ira_ctxLen  complete dim=1
+    static bool        ira_ctxLast[UOE_REASM_CONTEXTS];  // The last fragment was received
+    #pragma HLS ARRAY_PARTITION variable=ira_ctxLast complete dim=1
+    static bool        ira_ctxDone[UOE_REASM_CONTEXTS];  // All the fragments were received
+    #pragma HLS ARRAY_PARTITION variable=ira_ctxDone complete dim=1
+    static CsumAcc     ira_ctxSum[UOE_REASM_CONTEXTS];   // One's complement sum of the datagram
+    #pragma HLS ARRAY_PARTITION variable=ira_ctxSum  complete dim=1
+    static ap_uint<32> ira_ctxTime[UOE_REASM_CONTEXTS];  // Cycle of the first fragment
+    #pragma HLS ARRAY_PARTITION variable=ira_ctxTime complete dim=1
+    //--  The fragment being received
+    static ap_uint<4>  ira_ctx;
+    static Ip4ToS      ira_ip4ToS;
+    static Ip4TtL      ira_ip4Ttl;
+    static Ip4Ident    ira_ip4Ident;
+    static Ip4Addr     ira_ip4SrcAddr;
+    static bool        ira_moreFrags;
+    static ap_uint<17> ira_fragOff;   // In bytes
+    static ap_uint<17> ira_fragLen;   // In bytes
+    static ap_uint<17> ira_wrRem;     // Bytes of the fragment not yet written
+    static ap_uint<13> ira_wrIdx;
+    static ap_uint<32> ira_carry;     // The 4 bytes of the previous chunk (LE order)
+    static CsumAcc     ira_fragAcc;   // One's complement sum of the current fragment
+    static ap_uint<17> ira_fragNew;   // Bytes of the fragment which were not yet covered
+    static bool        ira_fragDup;   // Some blocks of the fragment were already covered
+    static bool        ira_covLoad;   // Load the coverage word of the next write
+    static ap_uint<64> ira_covWord;   // The coverage word of the last write
+    //--  The context being cleared
+    static ap_uint<7>  ira_clrIdx;
+    //--  The datagram being flushed
+    static ap_uint<64> ira_word0;
+    static Ip4HdrCsum  ira_ip4HdrCsum;
+    static ap_uint<17> ira_rdRem;     // Bytes of the datagram not yet forwarded
+    static ap_uint<13> ira_rdIdx;
+
+    //-- DYNAMIC VARIABLES ----------------------------------------------------
+    AxisIp4     currChunk;
+    bool        doWrite = false;  // Single write site of 'REASM_BUFFER'
+    ap_uint<64> wrWord;
+    bool        doCover = false;  // Single write site of 'REASM_COVER'
+    ap_uint<7>  covIdx;
+    ap_uint<64> covWord;
+
+    switch(ira_fsmState) {
+    case FSM_IRA_IDLE:
+      {
+        //-- Give priority to the flushing of a reassembled datagram
+        //--  and then to the clearing of a released context
+        bool       isDone   = false;
+        ap_uint<4> doneCtx  = 0;
+        bool       isDirty  = false;
+        ap_uint<4> dirtyCtx = 0;
+        for (int i=UOE_REASM_CONTEXTS-1; i>=0; i--) {
+            #pragma HLS UNROLL
+            if (ira_ctxValid[i] and ira_ctxDone[i]) {
+                isDone  = true;
+                doneCtx = i;
+            }
+            if (ira_ctxDirty[i]) {
+                isDirty  = true;
+                dirtyCtx = i;
+            }
+        }
+        if (UOE_IP_REASM and isDone) {
+            ira_ctx = doneCtx;
+            ira_fsmState = FSM_IRA_CSUM;
+        }
+        else if (UOE_IP_REASM and isDirty) {
+            ira_ctx    = dirtyCtx;
+            ira_clrIdx = 0;
+            ira_fsmState = FSM_IRA_CLEAR;
+        }
+        else if (!siIPRX_Data.empty() and !soIhs_Data.full()) {
+            //-- READ 1st AXI-CHUNK (Frag|Flags|Id|TotLen|ToS|Ver|IHL)
+            siIPRX_Data.read(currChunk);
+            if (UOE_IP_REASM and ((currChunk.getIp4Flags() & IP4_FLAGS_MF) or
+                                  (currChunk.getIp4FragOff() != 0))) {
+                ira_ip4ToS    = currChunk.getIp4ToS();
+                ira_ip4Ident  = currChunk.getIp4Ident();
+                ira_moreFrags = (currChunk.getIp4Flags() & IP4_FLAGS_MF);
+                ira_fragOff   = ((ap_uint<17>)currChunk.getIp4FragOff()) << 3;
+                ira_fragLen   = currChunk.getIp4TotalLen() - IP4_HEADER_LEN;
+                if (currChunk.getIp4HdrLen() != 5) {
+                    printWarn(myName, "FSM_IRA_IDLE - IPv4 fragments with options are not supported. This fragment will be dropped.\n");
+                  #ifndef __SYNTHESIS__
+                    iraNrDrops++;
+                  #endif
+                    ira_fsmState = FSM_IRA_DROP;
+                }
+                else {
+                    if (DEBUG_LEVEL & TRACE_IRA) {
+                        printInfo(myName, "FSM_IRA_IDLE - Received a fragment (Id=0x%4.4X|Off=%d|Len=%d|MF=%d)\n",
+                                  ira_ip4Ident.to_uint(), ira_fragOff.to_uint(),
+                                  ira_fragLen.to_uint(), ira_moreFrags);
+                    }
+                    ira_fsmState = FSM_IRA_FRAG_HDR1;
+                }
+            }
+            else {
+                soIhs_Data.write(currChunk);
+                if (not currChunk.getTLast()) {
+                    ira_fsmState = FSM_IRA_PASS;
+                }
+            }
+        }
+        //-- Evict one stale context per cycle (round-robin scan)
+        if (UOE_IP_REASM and ira_ctxValid[ira_scanIdx] and not ira_ctxDone[ira_scanIdx] and
+            ((ap_uint<32>)(ira_cycleCnt - ira_ctxTime[ira_scanIdx]) >= UOE_REASM_TIMEOUT_CYCLES)) {
+            printWarn(myName, "FSM_IRA_IDLE - Reassembly timeout. The fragments of datagram (Id=0x%4.4X) will be dropped.\n",
+                      ira_ctxId[ira_scanIdx].to_uint());
+            ira_ctxValid[ira_scanIdx] = false;
+            ira_ctxDirty[ira_scanIdx] = true;
+          #ifndef __SYNTHESIS__
+            iraNrEvictions++;
+          #endif
+        }
+        ira_scanIdx = (ira_scanIdx == UOE_REASM_CONTEXTS-1) ? 0 : ira_scanIdx.to_uint()+1;
+        break;
+      }
+    case FSM_IRA_PASS:
+        if (!siIPRX_Data.empty() and !soIhs_Data.full()) {
+            siIPRX_Data.read(currChunk);
+            soIhs_Data.write(currChunk);
+            if (currChunk.getTLast()) {
+                ira_fsmState = FSM_IRA_IDLE;
+            }
+        }
+        break;
+    case FSM_IRA_FRAG_HDR1:
+        if (!siIPRX_Data.empty()) {
+            //-- READ 2nd AXI-CHUNK (SA|HdrCsum|Prot|TTL)
+            siIPRX_Data.read(currChunk);
+            ira_ip4Ttl     = currChunk.getIp4TtL();
+            ira_ip4SrcAddr = currChunk.getIp4SrcAddr();
+            ira_fsmState   = (currChunk.getTLast()) ? FSM_IRA_IDLE : FSM_IRA_FRAG_HDR2;
+        }
+        break;
+    case FSM_IRA_FRAG_HDR2:
+        if (!siIPRX_Data.empty()) {
+            //-- READ 3rd AXI-CHUNK (Data|DA)
+            siIPRX_Data.read(currChunk);
+            Ip4Addr    ip4DstAddr = currChunk.getIp4DstAddr();
+            //-- Lookup the context of this datagram or allocate a new one
+            bool       isHit   = false;
+            ap_uint<4> hitCtx  = 0;
+            bool       isFree  = false;
+            ap_uint<4> freeCtx = 0;
+            for (int i=UOE_REASM_CONTEXTS-1; i>=0; i--) {
+                #pragma HLS UNROLL
+                if (ira_ctxValid[i] and (ira_ctxSrc[i] == ira_ip4SrcAddr) and
+                    (ira_ctxDst[i] == ip4DstAddr) and (ira_ctxId[i] == ira_ip4Ident)) {
+                    isHit  = true;
+                    hitCtx = i;
+                }
+                if (not ira_ctxValid[i] and not ira_ctxDirty[i]) {
+                    isFree  = true;
+                    freeCtx = i;
+                }
+            }
+            bool isValid = (ira_fragLen != 0) and
+                           ((ira_fragOff + ira_fragLen) <= (0xFFFF-IP4_HEADER_LEN)) and
+                           (not ira_moreFrags or (ira_fragLen(2,0) == 0)) and
+                           (not isHit or not ira_ctxDone[hitCtx]);
+            if (not isValid or (not isHit and not isFree)) {
+                if (not isValid) {
+                    printWarn(myName, "FSM_IRA_FRAG_HDR2 - Received an invalid fragment. It will be dropped.\n");
+                }
+                else {
+                    printWarn(myName, "FSM_IRA_FRAG_HDR2 - No reassembly context is available. This fragment will be dropped.\n");
+                }
+              #ifndef __SYNTHESIS__
+                iraNrDrops++;
+              #endif
+                ira_fsmState = (currChunk.getTLast()) ? FSM_IRA_IDLE : FSM_IRA_DROP;
+            }
+            else {
+                if (not isHit) {
+                    ira_ctxValid[freeCtx] = true;
+                    ira_ctxSrc[freeCtx]   = ira_ip4SrcAddr;
+                    ira_ctxDst[freeCtx]   = ip4DstAddr;
+                    ira_ctxId[freeCtx]    = ira_ip4Ident;
+                    ira_ctxToS[freeCtx]   = ira_ip4ToS;
+                    ira_ctxTtl[freeCtx]   = ira_ip4Ttl;
+                    ira_ctxRcvd[freeCtx]  = 0;
+                    ira_ctxEnd[freeCtx]   = 0;
+                    ira_ctxLen[freeCtx]   = 0;
+                    ira_ctxLast[freeCtx]  = false;
+                    ira_ctxDone[freeCtx]  = false;
+                    ira_ctxSum[freeCtx]   = 0;
+                    ira_ctxTime[freeCtx]  = ira_cycleCnt;
+                }
+                ira_ctx   = (isHit) ? hitCtx : freeCtx;
+                ira_wrIdx = ira_fragOff >> 3;
+                ira_wrRem = ira_fragLen;
+                ira_carry = currChunk.getLE_TData().range(63, 32);
+                ira_fragAcc = 0;
+                ira_fragNew = 0;
+                ira_fragDup = false;
+                ira_covLoad = true;
+                ira_fsmState = (currChunk.getTLast()) ? FSM_IRA_FRAG_RESIDUE : FSM_IRA_FRAG_DATA;
+            }
+        }
+        break;
+    case FSM_IRA_FRAG_DATA:
+        if (!siIPRX_Data.empty()) {
+            //-- READ n-th AXI-CHUNK and realign it on the offset of the fragment
+            siIPRX_Data.read(currChunk);
+            if (ira_wrRem != 0) {
+                ap_uint<32> currHalf = currChunk.getLE_TData(31, 0);
+                wrWord  = (currHalf, ira_carry);
+                doWrite = true;
+            }
+            ira_carry = currChunk.getLE_TData().range(63, 32);
+            if (currChunk.getTLast()) {
+                ira_fsmState = (ira_wrRem > 8) ? FSM_IRA_FRAG_RESIDUE : FSM_IRA_FRAG_END;
+            }
+        }
+        break;
+    case FSM_IRA_FRAG_RESIDUE:
+        //-- Write the very last bytes of the fragment
+        wrWord  = (ap_uint<32>(0), ira_carry);
+        doWrite = true;
+        ira_fsmState = FSM_IRA_FRAG_END;
+        break;
+    case FSM_IRA_FRAG_END:
+      {
+        CsumAcc     ctxSum = csumAdd(ira_ctxSum[ira_ctx], ira_fragAcc);
+        ap_uint<17> endOff = ira_fragOff + ira_fragLen;
+        ap_uint<17> ctxEnd = (endOff > ira_ctxEnd[ira_ctx]) ? endOff : ira_ctxEnd[ira_ctx];
+        ap_uint<17> rcvd   = ira_ctxRcvd[ira_ctx] + ira_fragNew;
+        bool        isLast = ira_ctxLast[ira_ctx];
+        ap_uint<17> len    = ira_ctxLen[ira_ctx];
+        bool        isDuplicate  = ira_fragDup and (ira_fragNew == 0);
+        bool        isConsistent = not ira_fragDup or isDuplicate;  // No partial overlap
+        if (not ira_moreFrags) {
+            if (isLast and (len != endOff)) {
+                isConsistent = false;
+            }
+            isLast = true;
+            len    = endOff;
+        }
+        if (isLast and (ctxEnd > len)) {
+            isConsistent = false;
+        }
+        ira_ctxEnd[ira_ctx] = ctxEnd;
+        if (isConsistent and isDuplicate) {
+            printWarn(myName, "FSM_IRA_FRAG_END - Duplicate fragment. It will be ignored.\n");
+          #ifndef __SYNTHESIS__
+            iraNrDrops++;
+          #endif
+        }
+        else if (isConsistent) {
+            //-- The covered bytes all lie below 'len'. They cover it when they add up to it.
+            ira_ctxSum[ira_ctx]  = ctxSum;
+            ira_ctxRcvd[ira_ctx] = rcvd;
+            ira_ctxLast[ira_ctx] = isLast;
+            ira_ctxLen[ira_ctx]  = len;
+            ira_ctxDone[ira_ctx] = isLast and (rcvd == len);
+        }
+        else {
+            printWarn(myName, "FSM_IRA_FRAG_END - Inconsistent fragments. The datagram (Id=0x%4.4X) will be dropped.\n",
+                      ira_ip4Ident.to_uint());
+            ira_ctxValid[ira_ctx] = false;
+            ira_ctxDirty[ira_ctx] = true;
+          #ifndef __SYNTHESIS__
+            iraNrEvictions++;
+          #endif
+        }
+        if (DEBUG_LEVEL & TRACE_IRA) {
+            printInfo(myName, "FSM_IRA_FRAG_END - Context #%d has received %d bytes.\n",
+                      ira_ctx.to_uint(), rcvd.to_uint());
+        }
+        ira_fsmState = FSM_IRA_IDLE;
+        break;
+      }
+    case FSM_IRA_DROP:
+        if (!siIPRX_Data.empty()) {
+            //-- READ and DRAIN all AXI-CHUNKS
+            siIPRX_Data.read(currChunk);
+            if (currChunk.getTLast()) {
+                ira_fsmState = FSM_IRA_IDLE;
+            }
+        }
+        break;
+    case FSM_IRA_CSUM:
+      {
+        //-- Verify the UDP checksum of the reassembled datagram
+        ap_uint<64> word0   = REASM_BUFFER[ira_ctx*UOE_REASM_CHUNKS];
+        UdpCsum     udpCsum = byteSwap16(word0.range(63, 48));
+        UdpLen      udpLen  = byteSwap16(word0.range(47, 32));
+        //--  The datagram includes its own checksum and is valid if the folded
+        //--  sum of the datagram and of its pseudo header is 0xFFFF.
+        CsumAcc     psdSum  = CsumAcc(ira_ctxSrc[ira_ctx].range(31, 16)) + ira_ctxSrc[ira_ctx].range(15, 0) +
+                              ira_ctxDst[ira_ctx].range(31, 16) + ira_ctxDst[ira_ctx].range(15, 0) +
+                              IP4_PROT_UDP + ira_ctxLen[ira_ctx].range(15, 0);
+        Csum        csum    = csumFold(csumAdd(ira_ctxSum[ira_ctx], psdSum));
+        if ((udpLen != ira_ctxLen[ira_ctx]) or
+            ((udpCsum != 0x0000) and (csum != 0xFFFF))) {
+            printWarn(myName, "FSM_IRA_CSUM - The reassembled datagram (Id=0x%4.4X) is corrupted. It will be dropped.\n",
+                      ira_ctxId[ira_ctx].to_uint());
+            ira_ctxValid[ira_ctx] = false;
+            ira_ctxDirty[ira_ctx] = true;
+          #ifndef __SYNTHESIS__
+            iraNrDrops++;
+          #endif
+            ira_fsmState = FSM_IRA_IDLE;
+        }
+        else {
+            // Clear the checksum field for [Ucc] to stream this datagram
+            ira_word0 = word0;
+            ira_word0.range(63, 48) = 0;
+            ira_fsmState = FSM_IRA_HDR0;
+        }
+        break;
+      }
+    case FSM_IRA_HDR0:
+        if (!soIhs_Data.full()) {
+            Ip4TotalLen ip4TotLen = IP4_HEADER_LEN + ira_ctxLen[ira_ctx];
+            AxisIp4 firstIp4Chunk = AxisIp4(0, 0xFF, 0);
+            firstIp4Chunk.setIp4Version(4);
+            firstIp4Chunk.setIp4HdrLen(5);
+            firstIp4Chunk.setIp4ToS(ira_ctxToS[ira_ctx]);
+            firstIp4Chunk.setIp4TotalLen(ip4TotLen);
+            firstIp4Chunk.setIp4Ident(ira_ctxId[ira_ctx]);
+            firstIp4Chunk.setIp4Flags(0);
+            firstIp4Chunk.setIp4FragOff(0);
+            soIhs_Data.write(firstIp4Chunk);
+            //-- Compute the header checksum of the new IPv4 packet
+            CsumAcc csumAcc = CsumAcc((ap_uint<8>(0x45), ira_ctxToS[ira_ctx])) + ip4TotLen +
+                              ira_ctxId[ira_ctx] + (ira_ctxTtl[ira_ctx], ap_uint<8>(IP4_PROT_UDP)) +
+                              ira_ctxSrc[ira_ctx].range(31, 16) + ira_ctxSrc[ira_ctx].range(15, 0) +
+                              ira_ctxDst[ira_ctx].range(31, 16) + ira_ctxDst[ira_ctx].range(15, 0);
+            ira_ip4HdrCsum = csumFinalize(csumAcc);
+            ira_fsmState = FSM_IRA_HDR1;
+            if (DEBUG_LEVEL & TRACE_IRA) { printAxisRaw(myName, "FSM_IRA_HDR0 -", firstIp4Chunk); }
+        }
+        break;
+    case FSM_IRA_HDR1:
+        if (!soIhs_Data.full()) {
+            AxisIp4 secondIp4Chunk = AxisIp4(0, 0xFF, 0);
+            secondIp4Chunk.setIp4TtL(ira_ctxTtl[ira_ctx]);
+            secondIp4Chunk.setIp4Prot(IP4_PROT_UDP);
+            secondIp4Chunk.setIp4HdrCsum(ira_ip4HdrCsum);
+            secondIp4Chunk.setIp4SrcAddr(ira_ctxSrc[ira_ctx]);
+            soIhs_Data.write(secondIp4Chunk);
+            ira_fsmState = FSM_IRA_HDR2;
+            if (DEBUG_LEVEL & TRACE_IRA) { printAxisRaw(myName, "FSM_IRA_HDR1 -", secondIp4Chunk); }
+        }
+        break;
+    case FSM_IRA_HDR2:
+        if (!soIhs_Data.full()) {
+            //-- FYI - The datagram is at least 8 bytes long (.i.e, UDP header)
+            AxisIp4 thirdIp4Chunk = AxisIp4(0, 0xFF, 0);
+            thirdIp4Chunk.setIp4DstAddr(ira_ctxDst[ira_ctx]);
+            thirdIp4Chunk.setLE_TData(ira_word0.range(31, 0), 63, 32);
+            soIhs_Data.write(thirdIp4Chunk);
+            ira_carry = ira_word0.range(63, 32);
+            ira_rdRem = ira_ctxLen[ira_ctx] - 4;
+            ira_rdIdx = 1;
+            ira_fsmState = FSM_IRA_FLUSH;
+            if (DEBUG_LEVEL & TRACE_IRA) { printAxisRaw(myName, "FSM_IRA_HDR2 -", thirdIp4Chunk); }
+        }
+        break;
+    case FSM_IRA_FLUSH:
+        if (!soIhs_Data.full()) {
+            ap_uint<64> word     = REASM_BUFFER[ira_ctx*UOE_REASM_CHUNKS + ira_rdIdx];
+            ap_uint<32> wordHalf = word.range(31, 0);
+            AxisIp4 sendChunk = AxisIp4((wordHalf, ira_carry), 0xFF, 0);
+            if (ira_rdRem <= 8) {
+                sendChunk.setLE_TKeep(lenToLE_tKeep(ira_rdRem));
+                sendChunk.setTLast(TLAST);
+                ira_ctxValid[ira_ctx] = false;
+                ira_ctxDirty[ira_ctx] = true;
+              #ifndef __SYNTHESIS__
+                iraNrDgrms++;
+              #endif
+                ira_fsmState = FSM_IRA_IDLE;
+            }
+            else {
+                ira_rdRem -= 8;
+            }
+            soIhs_Data.write(sendChunk);
+            ira_carry = word.range(63, 32);
+            ira_rdIdx++;
+            if (DEBUG_LEVEL & TRACE_IRA) { printAxisRaw(myName, "FSM_IRA_FLUSH -", sendChunk); }
+        }
+        break;
+    case FSM_IRA_CLEAR:
+        //-- Clear the coverage words of a released context up to its highest end offset
+        doCover = true;
+        covIdx  = ira_clrIdx;
+        covWord = 0;
+        if (((ap_uint<17>)(ira_clrIdx+1) << 9) >= ira_ctxEnd[ira_ctx]) {
+            ira_ctxDirty[ira_ctx] = false;
+            ira_fsmState = FSM_IRA_IDLE;
+        }
+        ira_clrIdx++;
+        break;
+    } // End-of: switch
+
+    //-- ALWAYS
+    if (doWrite) {
+        //-- Look up and set the coverage bit of this block
+        //--  (the coverage word is only read when the write enters a new word)
+        ap_uint<6>  covBit = ira_wrIdx(5, 0);
+        covIdx  = ira_wrIdx(12, 6);
+        covWord = (ira_covLoad or (covBit == 0)) ?
+                  REASM_COVER[ira_ctx*UOE_REASM_COVER_WORDS + covIdx] : ira_covWord;
+        bool isCovered = covWord[covBit];
+        covWord[covBit] = 1;
+        doCover     = true;
+        ira_covWord = covWord;
+        ira_covLoad = false;
+        //-- Clear the bytes beyond the end of the fragment and accumulate the others
+        LE_tKeep    wrKeep = (ira_wrRem >= 8) ? LE_tKeep(0xFF) : lenToLE_tKeep(ira_wrRem);
+        ap_uint<64> cleanWord = 0;
+        for (int b=0; b<8; b++) {
+            #pragma HLS UNROLL
+            if (wrKeep[b]) {
+                cleanWord.range(8*b+7, 8*b) = wrWord.range(8*b+7, 8*b);
+            }
+        }
+        if (isCovered) {
+            //-- Keep the bytes received first
+            ira_fragDup = true;
+        }
+        else {
+            REASM_BUFFER[ira_ctx*UOE_REASM_CHUNKS + ira_wrIdx] = cleanWord;
+            ira_fragAcc = csumAccumulate<ARW>(ira_fragAcc, AxisRaw(cleanWord, wrKeep, 0));
+            ira_fragNew += (ira_wrRem >= 8) ? ap_uint<17>(8) : ira_wrRem;
+        }
+        ira_wrRem = (ira_wrRem >= 8) ? ap_uint<17>(ira_wrRem - 8) : ap_uint<17>(0);
+        ira_wrIdx++;
+    }
+    if (doCover) {
+        REASM_COVER[ira_ctx*UOE_REASM_COVER_WORDS + covIdx] = covWord;
+    }
+    ira_cycleCnt++;
+
+} // End-of: pIpReassembler
+
 /*******************************************************************************
  * IPv4 Header Stripper (Ihs)
  *
  * @param[in]  piMMIO_En       Enable signal from [SHELL/MMIO].
- * @param[in]  siIPRX_Data     IP4 data stream from IpRxHAndler (IPRX).
+ * @param[in]  siIPRX_Data     IP4 data stream from IpReassembler (Ira).
  * @param[out] soUcc_UdpDgrm   UDP datagram stream to UdpChecksumChecker (Ucc).
  * @param[out] soUcc_PsdHdrSum Sum of the pseudo header information to [Ucc].
  * @param[out] soRph_Ip4Hdr    The header part of the IPv4 packet as a stream to [Rph].
@@ -138,7 +683,7 @@ void pIpHeaderStripper(
       static ap_uint<3>    ihs_ipHdrCnt;
       static AxisIp4       ihs_prevChunk;
       static Ip4HdrLen     ihs_ip4HdrLen;
-      static ap_uint<17>   ihs_psdHdrSum;
+      static CsumAcc       ihs_psdHdrSum;
 
       //-- DYNAMIC VARIABLES ----------------------------------------------------
       AxisIp4     currIp4Chunk;
@@ -195,11 +740,9 @@ void pIpHeaderStripper(
               siIPRX_Data.read(currIp4Chunk);
               soRph_Ip4Hdr.write(currIp4Chunk);
               //-- Csum accumulate (SA+Prot)
-              ihs_psdHdrSum  = (0x00, currIp4Chunk.getIp4Prot());
+              ihs_psdHdrSum  = currIp4Chunk.getIp4Prot();
               ihs_psdHdrSum += currIp4Chunk.getIp4SrcAddr().range(31,16);
-              ihs_psdHdrSum  = (ihs_psdHdrSum & 0xFFFF) + (ihs_psdHdrSum >> 16);
               ihs_psdHdrSum += currIp4Chunk.getIp4SrcAddr().range(15, 0);
-              ihs_psdHdrSum  = (ihs_psdHdrSum & 0xFFFF) + (ihs_psdHdrSum >> 16);
               ihs_ip4HdrLen -= 2;
               ihs_fsmState = FSM_IHS_IPW2;
               if (DEBUG_LEVEL & TRACE_IHS) { printAxisRaw(myName, "FSM_IHS_IPW1            -", currIp4Chunk); }
@@ -215,9 +758,7 @@ void pIpHeaderStripper(
               siIPRX_Data.read(currIp4Chunk);
               //-- Csum accumulate (DA)
               ihs_psdHdrSum += currIp4Chunk.getIp4DstAddr().range(31,16);
-              ihs_psdHdrSum  = (ihs_psdHdrSum & 0xFFFF) + (ihs_psdHdrSum >> 16);
               ihs_psdHdrSum += currIp4Chunk.getIp4DstAddr().range(15, 0);
-              ihs_psdHdrSum  = (ihs_psdHdrSum & 0xFFFF) + (ihs_psdHdrSum >> 16);
               if (ihs_ip4HdrLen == 1) {
                   // This a typical IPv4 header with a length of 20 bytes (5*4).
                   soRph_Ip4Hdr.write(AxisIp4(currIp4Chunk.getLE_Ip4DstAddr(), 0x0F, TLAST));
@@ -272,9 +813,8 @@ void pIpHeaderStripper(
               siIPRX_Data.read(currIp4Chunk);
               //-- Csum accumulate (UdpLen)
               ihs_psdHdrSum += currIp4Chunk.getUdpLen();
-              ihs_psdHdrSum  = (ihs_psdHdrSum & 0xFFFF) + (ihs_psdHdrSum >> 16);
               //-- Forward UDP PseudoHeaderCsum to [Ucc]
-              soUcc_PsdHdrSum.write(ihs_psdHdrSum(15, 0));
+              soUcc_PsdHdrSum.write(csumFold(ihs_psdHdrSum));
               //-- Forward the UDP Header (Csum|Len|DP|SP)
               sendChunk.setTKeep(0xFF);
               sendChunk.setTDataHi(ihs_prevChunk.getTDataLo());
@@ -307,9 +847,8 @@ void pIpHeaderStripper(
               AxisUdp  currUdpChunk(currIp4Chunk);
               //-- Csum accumulate (UdpLen)
               ihs_psdHdrSum += currUdpChunk.getUdpLen();
-              ihs_psdHdrSum  = (ihs_psdHdrSum & 0xFFFF) + (ihs_psdHdrSum >> 16);
               //-- Forward UDP PseudoHeaderCsum to [Ucc]
-              soUcc_PsdHdrSum.write(ihs_psdHdrSum(15, 0));
+              soUcc_PsdHdrSum.write(csumFold(ihs_psdHdrSum));
               //-- Forward the UDP Header (Csum|Len|DP|SP)
               soUcc_UdpDgrm.write(currUdpChunk);
               if (currUdpChunk.getTLast()) {
@@ -419,9 +958,11 @@ void pIpHeaderStripper(
  * @param[out] soIhs_ClearToSend Clear to send signal to [Ihs].
  *
  * @details
- *  This process accumulates the checksum over the UDP header and the UDP data.
- *  The computed checksum is compared with the embedded checksum when 'TLAST'
- *  is reached, and the result is forwarded to the RxPacketHandler (Rph).
+ *  This process accumulates the checksum over the UDP header and the UDP data
+ *  with the checksum library of the NTS (see 'nts_csum.hpp'). Because the sum
+ *  includes the embedded checksum, the datagram is valid when the checksum of
+ *  that sum is 0 at 'TLAST'. The result is forwarded to the RxPacketHandler
+ *  (Rph).
  *  This process controls the total amount of data stored in the elastic buffer
  *  of the UOE. When issued, a 'soIhs_ClearToSend' signal indicates that the UOE
  *  is able to accept another datagram of up to MTU bytes.
@@ -442,17 +983,14 @@ void pUdpChecksumChecker(
 
     //-- STATIC CONTROL VARIABLES (with RESET) --------------------------------
     static enum FsmStates { FSM_UCC_INIT=0, FSM_UCC_IDLE,  FSM_UCC_START,
-                            FSM_UCC_CHK0,   FSM_UCC_CHK1,  FSM_UCC_ACCUMULATE,
+                            FSM_UCC_CHK,    FSM_UCC_ACCUMULATE,
                             FSM_UCC_STREAM } ucc_fsmState=FSM_UCC_INIT;
     #pragma HLS RESET               variable=ucc_fsmState
     static ap_uint<10>                       ucc_chunkCount=0;
     #pragma HLS RESET               variable=ucc_chunkCount
 
     //-- STATIC DATAFLOW VARIABLES --------------------------------------------
-    static ap_uint<17>  ucc_csum0;
-    static ap_uint<17>  ucc_csum1;
-    static ap_uint<17>  ucc_csum2;
-    static ap_uint<17>  ucc_csum3;
+    static CsumAcc      ucc_csumAcc;
     static UdpCsum      ucc_psdHdrCsum;
 
     //-- DYNAMIC VARIABLES ----------------------------------------------------
@@ -487,16 +1025,11 @@ void pUdpChecksumChecker(
                 ucc_fsmState = FSM_UCC_STREAM;
             }
             else {
-                // Accumulate the UDP header
-                ucc_csum0  = 0x00000 | currChunk.getUdpSrcPort();
-                ucc_csum0 += ucc_psdHdrCsum;
-                ucc_csum0  = (ucc_csum0 & 0xFFFF) + (ucc_csum0 >> 16);
-                ucc_csum1 = 0x00000 | currChunk.getUdpDstPort();
-                ucc_csum2 = 0x00000 | currChunk.getUdpLen();
-                ucc_csum3 = 0x00000 | currChunk.getUdpCsum();
+                // Accumulate the pseudo header and the UDP header
+                ucc_csumAcc = csumAccumulate<ARW>(ucc_psdHdrCsum, currChunk);
                 if (currChunk.getUdpLen() == 8) {
                     // Payload is empty
-                    ucc_fsmState = FSM_UCC_CHK0;
+                    ucc_fsmState = FSM_UCC_CHK;
                 }
                 else {
                     ucc_fsmState = FSM_UCC_ACCUMULATE;
@@ -519,54 +1052,19 @@ void pUdpChecksumChecker(
         if (!siIhs_UdpDgrm.empty() and !soRph_UdpDgrm.full()) {
             siIhs_UdpDgrm.read(currChunk);
             // Always set the disabled bytes to zero
-            LE_tData cleanChunk = 0;
-            if (currChunk.getLE_TKeep() & 0x01)
-                cleanChunk.range( 7, 0) = (currChunk.getLE_TData()).range( 7, 0);
-            if (currChunk.getLE_TKeep() & 0x02)
-                cleanChunk.range(15, 8) = (currChunk.getLE_TData()).range(15, 8);
-            if (currChunk.getLE_TKeep() & 0x04)
-                cleanChunk.range(23,16) = (currChunk.getLE_TData()).range(23,16);
-            if (currChunk.getLE_TKeep() & 0x08)
-                cleanChunk.range(31,24) = (currChunk.getLE_TData()).range(31,24);
-            if (currChunk.getLE_TKeep() & 0x10)
-                cleanChunk.range(39,32) = (currChunk.getLE_TData()).range(39,32);
-            if (currChunk.getLE_TKeep() & 0x20)
-                cleanChunk.range(47,40) = (currChunk.getLE_TData()).range(47,40);
-            if (currChunk.getLE_TKeep() & 0x40)
-                cleanChunk.range(55,48) = (currChunk.getLE_TData()).range(55,48);
-            if (currChunk.getLE_TKeep() & 0x80)
-                cleanChunk.range(63,56) = (currChunk.getLE_TData()).range(63,56);
-            soRph_UdpDgrm.write(AxisUdp(cleanChunk, currChunk.getLE_TKeep(), currChunk.getLE_TLast()));
-
-            ucc_csum0 += byteSwap16(cleanChunk.range(63, 48));
-            ucc_csum0  = (ucc_csum0 & 0xFFFF) + (ucc_csum0 >> 16);
-            ucc_csum1 += byteSwap16(cleanChunk.range(47, 32));
-            ucc_csum1  = (ucc_csum1 & 0xFFFF) + (ucc_csum1 >> 16);
-            ucc_csum2 += byteSwap16(cleanChunk.range(31, 16));
-            ucc_csum2  = (ucc_csum2 & 0xFFFF) + (ucc_csum2 >> 16);
-            ucc_csum3 += byteSwap16(cleanChunk.range(15,  0));
-            ucc_csum3  = (ucc_csum3 & 0xFFFF) + (ucc_csum3 >> 16);
-
+            currChunk.clearUnusedBytes();
+            soRph_UdpDgrm.write(currChunk);
+            ucc_csumAcc = csumAccumulate<ARW>(ucc_csumAcc, currChunk);
             if (currChunk.getTLast()) {
-              ucc_fsmState = FSM_UCC_CHK0;
-          }
+                ucc_fsmState = FSM_UCC_CHK;
+            }
             if (DEBUG_LEVEL & TRACE_UCC) { printAxisRaw(myName,"FSM_UCC_ACCUMULATE      -", currChunk); }
         }
         break;
-    case FSM_UCC_CHK0:
-        if (DEBUG_LEVEL & TRACE_UCC) { printInfo(myName,"FSM_UCC_CHK0 - \n"); }
-        ucc_csum0 += ucc_csum2;
-        ucc_csum0  = (ucc_csum0 & 0xFFFF) + (ucc_csum0 >> 16);
-        ucc_csum1 += ucc_csum3;
-        ucc_csum1  = (ucc_csum1 & 0xFFFF) + (ucc_csum1 >> 16);
-        ucc_fsmState = FSM_UCC_CHK1;
-        break;
-    case FSM_UCC_CHK1:
+    case FSM_UCC_CHK:
         if (!soRph_CsumVal.full()) {
-            if (DEBUG_LEVEL & TRACE_UCC) { printInfo(myName,"FSM_UCC_CHK1 - \n"); }
-            ucc_csum0 += ucc_csum1;
-            ucc_csum0  = (ucc_csum0 & 0xFFFF) + (ucc_csum0 >> 16);
-            UdpCsum csumChk = ~(ucc_csum0(15, 0));
+            if (DEBUG_LEVEL & TRACE_UCC) { printInfo(myName,"FSM_UCC_CHK - \n"); }
+            UdpCsum csumChk = csumFinalize(ucc_csumAcc);
             if (csumChk == 0) {
                 // The checksum is correct. UDP datagram is valid.
                 soRph_CsumVal.write(true);
@@ -605,6 +1103,12 @@ void pUdpChecksumChecker(
  *  If the destination UDP port is not opened, the incoming IP header and the
  *  first 8 bytes of the datagram are forwarded to the Internet Control Message
  *  Protocol (ICMP) Server which will build a 'Destination Unreachable' message.
+ *  If 'UOE_RX_CUT_THROUGH' is set, the payload of an opened port is forwarded
+ *  without waiting for the checksum verdict of [Ucc]. The metadata and the
+ *  length are still delivered ahead of the data, but the last data chunk is
+ *  held until the verdict is known. A datagram with a wrong checksum is then
+ *  aborted by replacing its last chunk with a chunk that asserts 'tlast' and
+ *  de-asserts all the 'tkeep' bits, which a valid datagram never does.
  *
  *******************************************************************************/
 void pRxPacketHandler(
@@ -630,13 +1134,15 @@ void pRxPacketHandler(
                             FSM_RPH_DRAIN_DATAGRAM_STREAM,FSM_RPH_DRAIN_IP4HDR_STREAM,
                             FSM_RPH_PORT_UNREACHABLE_1ST, FSM_RPH_PORT_UNREACHABLE_2ND,
                             FSM_RPH_PORT_UNREACHABLE_STREAM,
-                            FSM_RPH_PORT_UNREACHABLE_LAST } rph_fsmState=FSM_RPH_IDLE;
+                            FSM_RPH_PORT_UNREACHABLE_LAST,
+                            FSM_RPH_PORT_CLOSED,          FSM_RPH_VERDICT } rph_fsmState=FSM_RPH_IDLE;
     #pragma HLS RESET                              variable=rph_fsmState
 
     //-- STATIC DATAFLOW VARIABLES --------------------------------------------
     static AxisIp4      rph_1stIp4HdrChunk;
     static AxisIp4      rph_2ndIp4HdrChunk;
     static AxisUdp      rph_udpHeaderChunk;
+    static AxisUdp      rph_lastDgrmChunk;  // Held until the checksum verdict
     static FlagBit      rph_emptyPayloadFlag;
     static FlagBool     rph_doneWithIpHdrStream;
     static UdpLen       rph_dgrmLen;
@@ -675,26 +1181,44 @@ void pRxPacketHandler(
         }
         break;
     case FSM_RPH_PORT_LOOKUP:
-        if (!siUpt_PortStateRep.empty() and !siUcc_CsumVal.empty() and
+        if (!siUpt_PortStateRep.empty() and
+            ((UOE_RX_CUT_THROUGH and not rph_emptyPayloadFlag) or !siUcc_CsumVal.empty()) and
             !siIhs_Ip4Hdr.empty() and !soUAIF_DLen.full()) {
-            bool csumResult = siUcc_CsumVal.read();
             bool portLkpRes = siUpt_PortStateRep.read();
             // Read the 2nd IPv4 header chunk and update the metadata structure
             siIhs_Ip4Hdr.read(rph_2ndIp4HdrChunk);
             rph_udpMeta.src.addr = rph_2ndIp4HdrChunk.getIp4SrcAddr();
-            if (DEBUG_LEVEL & TRACE_RPH) {
-                printInfo(myName, "FSM_RPH_PORT_LOOKUP - CsumValid=%d and portLkpRes=%d.\n",
-                          csumResult, portLkpRes);
-            }
-            if(portLkpRes and csumResult) {
-                soUAIF_DLen.write(rph_dgrmLen);
-                rph_fsmState = FSM_RPH_STREAM_FIRST;
-            }
-            else if (not csumResult) {
-                rph_fsmState = FSM_RPH_DRAIN_DATAGRAM_STREAM;
+            if (UOE_RX_CUT_THROUGH and not rph_emptyPayloadFlag) {
+                // Do not wait for the checksum verdict. It is applied to the
+                // last chunk, or it decides upon the ICMP message.
+                if (DEBUG_LEVEL & TRACE_RPH) {
+                    printInfo(myName, "FSM_RPH_PORT_LOOKUP - portLkpRes=%d (cut-through).\n",
+                              portLkpRes);
+                }
+                if (portLkpRes) {
+                    soUAIF_DLen.write(rph_dgrmLen);
+                    rph_fsmState = FSM_RPH_STREAM_FIRST;
+                }
+                else {
+                    rph_fsmState = FSM_RPH_PORT_CLOSED;
+                }
             }
             else {
-                rph_fsmState = FSM_RPH_PORT_UNREACHABLE_1ST;
+                bool csumResult = siUcc_CsumVal.read();
+                if (DEBUG_LEVEL & TRACE_RPH) {
+                    printInfo(myName, "FSM_RPH_PORT_LOOKUP - CsumValid=%d and portLkpRes=%d.\n",
+                              csumResult, portLkpRes);
+                }
+                if(portLkpRes and csumResult) {
+                    soUAIF_DLen.write(rph_dgrmLen);
+                    rph_fsmState = FSM_RPH_STREAM_FIRST;
+                }
+                else if (not csumResult) {
+                    rph_fsmState = FSM_RPH_DRAIN_DATAGRAM_STREAM;
+                }
+                else {
+                    rph_fsmState = FSM_RPH_PORT_UNREACHABLE_1ST;
+                }
             }
         }
         break;
@@ -714,10 +1238,19 @@ void pRxPacketHandler(
                 soUAIF_Meta.write(rph_udpMeta);
                 // Read the 1st datagram chunk and forward to [UAIF]
                 siUcc_UdpDgrm.read(dgrmChunk);
-                soUAIF_Data.write(UdpAppData(dgrmChunk));
+                if (UOE_RX_CUT_THROUGH and dgrmChunk.getTLast()) {
+                    rph_lastDgrmChunk = dgrmChunk;
+                }
+                else {
+                    soUAIF_Data.write(UdpAppData(dgrmChunk));
+                }
             }
             if (dgrmChunk.getTLast() or rph_emptyPayloadFlag) {
-                if (thirdIp4HdrChunk.getTLast()) {
+                if (UOE_RX_CUT_THROUGH and not rph_emptyPayloadFlag) {
+                    // Go and deliver the checksum verdict
+                    rph_fsmState = FSM_RPH_VERDICT;
+                }
+                else if (thirdIp4HdrChunk.getTLast()) {
                     // Both incoming stream are empty. We are done.
                     rph_fsmState = FSM_RPH_IDLE;
                  }
@@ -736,12 +1269,21 @@ void pRxPacketHandler(
             // Forward datagram chunk
             AxisUdp dgrmChunk;
             siUcc_UdpDgrm.read(dgrmChunk);
-            soUAIF_Data.write(UdpAppData(dgrmChunk));
+            if (UOE_RX_CUT_THROUGH and dgrmChunk.getTLast()) {
+                rph_lastDgrmChunk = dgrmChunk;
+            }
+            else {
+                soUAIF_Data.write(UdpAppData(dgrmChunk));
+            }
             if (DEBUG_LEVEL & TRACE_RPH) {
                 printInfo(myName, "FSM_RPH_STREAM\n");
             }
             if (dgrmChunk.getTLast()) {
-                if (rph_doneWithIpHdrStream) {
+                if (UOE_RX_CUT_THROUGH) {
+                    // Go and deliver the checksum verdict
+                    rph_fsmState = FSM_RPH_VERDICT;
+                }
+                else if (rph_doneWithIpHdrStream) {
                     // Both incoming stream are empty. We are done.
                     rph_fsmState = FSM_RPH_IDLE;
                 }
@@ -839,6 +1381,43 @@ void pRxPacketHandler(
             rph_fsmState = FSM_RPH_DRAIN_DATAGRAM_STREAM;
         }
         break;
+    case FSM_RPH_VERDICT:
+        //-- Cut-through mode: Apply the checksum verdict to the last chunk
+        if (!siUcc_CsumVal.empty() and !soUAIF_Data.full()) {
+            bool csumResult = siUcc_CsumVal.read();
+            if (csumResult) {
+                soUAIF_Data.write(UdpAppData(rph_lastDgrmChunk));
+            }
+            else {
+                // Abort the datagram by asserting 'tlast' and de-asserting 'tkeep'
+                soUAIF_Data.write(UdpAppData(0, 0x00, TLAST));
+            }
+            if (DEBUG_LEVEL & TRACE_RPH) {
+                printInfo(myName, "FSM_RPH_VERDICT - CsumValid=%d.\n", csumResult);
+            }
+            if (rph_doneWithIpHdrStream) {
+                rph_fsmState = FSM_RPH_IDLE;
+            }
+            else {
+                rph_fsmState = FSM_RPH_DRAIN_IP4HDR_STREAM;
+            }
+        }
+        break;
+    case FSM_RPH_PORT_CLOSED:
+        //-- Cut-through mode: Wait for the checksum verdict of the datagram
+        if (!siUcc_CsumVal.empty()) {
+            bool csumResult = siUcc_CsumVal.read();
+            if (DEBUG_LEVEL & TRACE_RPH) {
+                printInfo(myName, "FSM_RPH_PORT_CLOSED - CsumValid=%d.\n", csumResult);
+            }
+            if (csumResult) {
+                rph_fsmState = FSM_RPH_PORT_UNREACHABLE_1ST;
+            }
+            else {
+                rph_fsmState = FSM_RPH_DRAIN_DATAGRAM_STREAM;
+            }
+        }
+        break;
     } // End-of: switch()
 }
 
@@ -973,6 +1552,10 @@ void pUdpPortTable(
  * @details
  *  The Rx path of the UdpOffloadEngine (UOE). This is the path from [IPRX]
  *  to the UdpAppInterface (UAIF).
+ *  The fragmented IPv4 packets are reassembled upfront by the IpReassembler
+ *  (Ira) unless 'UOE_IP_REASM' is cleared.
+ *  The datagrams are held until their UDP checksum is verified, unless
+ *  'UOE_RX_CUT_THROUGH' is set (see RxPacketHandler).
  *  To avoid blocking the IPRX engine of the NTS, this process will start
  *  dropping the incoming traffic upon one of the two following conditions:
  *   1) If the internal elastic data buffer defined by 'cUdpRxDataFifoSize' is full or,
@@ -1000,6 +1583,10 @@ void pRxEngine(
     //-- LOCAL STREAMS (Sorted by the name of the modules which generate them)
     //-------------------------------------------------------------------------
 
+    //-- IP Reassembler (Ira)
+    static stream<AxisIp4>      ssIraToIhs_Data         ("ssIraToIhs_Data");
+    #pragma HLS STREAM variable=ssIraToIhs_Data         depth=2
+
     //-- IP Header Stripper (Ihs)
     static stream<AxisIp4>      ssIhsToRph_Ip4Hdr       ("ssIhsToRph_Ip4Hdr");
     #pragma HLS STREAM variable=ssIhsToRph_Ip4Hdr       depth=cIp4RxHdrsFifoSize
@@ -1023,9 +1610,13 @@ void pRxEngine(
     static stream<StsBool>      ssUptToRph_PortStateRep ("ssUptToRph_PortStateRep");
     #pragma HLS STREAM variable=ssUptToRph_PortStateRep depth=2
 
+    pIpReassembler(
+            siIPRX_Data,
+            ssIraToIhs_Data);
+
     pIpHeaderStripper(
             piMMIO_En,
-            siIPRX_Data,
+            ssIraToIhs_Data,
             ssIhsToUcc_UdpDgrm,
             ssIhsToUcc_PsdHdrSum,
             ssIhsToRph_Ip4Hdr,
@@ -1086,6 +1677,9 @@ void pRxEngine(
  *     this process will split the incoming datagram and generate as many
  *     sub-datagrams as required to transport all 'DLen' bytes over Ethernet
  *     frames.
+ *     If the IPv4 fragmentation is enabled (see UOE_IP_FRAG), the datagram is
+ *     only split beyond UDP_FRAG_MDS bytes and the IPv4HeaderAdder (Iha) will
+ *     fragment it into MTU-sized IPv4 packets.
  *  2) STREAMING_MODE: If the 'DLen' field is configured with a length == 0, the
  *     corresponding stream will be forwarded based on the same metadata
  *     information until the 'TLAST' bit of the data stream is set. In this mode,
@@ -1125,7 +1719,7 @@ void pTxApplicationInterface(
     //-- STATIC DATAFLOW VARIABLES --------------------------------------------
     static UdpAppMeta  tai_appMeta;  // The socket-pair information
     static UdpAppDLen  tai_appDLen;  // Application's datagram length (0 to 2^16)
-    static UdpAppDLen  tai_splitCnt; // Split counter (from 0 to 1422-1)
+    static UdpAppDLen  tai_splitCnt; // Split counter (from 0 to UDP_TX_MDS-1)
 
     switch(tai_fsmState) {
     case FSM_TAI_IDLE:
@@ -1155,7 +1749,7 @@ void pTxApplicationInterface(
             UdpAppData currChunk = siUAIF_Data.read();
             tai_appDLen  -= currChunk.getLen();
             tai_splitCnt += currChunk.getLen();
-            if ((tai_appDLen == 0) or (tai_splitCnt == UDP_MDS)) {
+            if ((tai_appDLen == 0) or (tai_splitCnt == UDP_TX_MDS)) {
                 // Always enforce TLAST
                 currChunk.setTLast(TLAST);
                 tai_fsmState = FSM_TAI_DRGM_META;
@@ -1412,6 +2006,17 @@ void pTxDatagramHandler(
     }
 }
 
+/*******************************************************************************
+ * UDP Checksum Accumulator (Uca)
+ *
+ * @param[in]  siTdh_Data  UDP pseudo-packet stream from TxDataHandler (Tdh).
+ * @param[out] soUha_Csum  The checksum of the datagram to UdpHeaderAdder (Uha).
+ *
+ * @details
+ *  This process accumulates the checksum over the pseudo-header, the UDP
+ *  header and the UDP data. The carries of the sum are folded only once, such
+ *  that the checksum is forwarded to [Uha] along with the last chunk.
+ *******************************************************************************/
 void pUdpChecksumAccumulator(
         stream<AxisPsd4>    &siTdh_Data,
         stream<UdpCsum>     &soUha_Csum)
@@ -1423,76 +2028,25 @@ void pUdpChecksumAccumulator(
     const char *myName  = concat3(THIS_NAME, "/TXe/", "Uca");
 
     //-- STATIC CONTROL VARIABLES (with RESET) ---------------------------------
-    static enum FsmStates { FSM_UCA_ACCUMULATE=0, FSM_UCA_LAST, FSM_UCA_DONE } \
-                    uca_fsmState=FSM_UCA_ACCUMULATE;
-    #pragma HLS RESET   variable=uca_fsmState
-    static ap_uint<17>           uca_csum0;
-    #pragma HLS RESET   variable=uca_csum0
-    static ap_uint<17>           uca_csum1;
-    #pragma HLS RESET   variable=uca_csum1
-    static ap_uint<17>           uca_csum2;
-    #pragma HLS RESET   variable=uca_csum2
-    static ap_uint<17>           uca_csum3;
-    #pragma HLS RESET   variable=uca_csum3
-    static AxisPsd4              uca_lastChunk;
-    #pragma HLS RESET   variable=uca_lastChunk
-
-    switch (uca_fsmState) {
-    case FSM_UCA_ACCUMULATE:
-        if (!siTdh_Data.empty()) {
-            AxisPsd4 currChunk = siTdh_Data.read();
-            if (currChunk.getTLast()) {
-                uca_lastChunk = currChunk;
-                uca_lastChunk.clearUnusedBytes();
-                uca_fsmState = FSM_UCA_LAST;
-            }
-            else {
-                uca_csum0 += byteSwap16(currChunk.getLE_TData().range(63, 48));
-                uca_csum0  = (uca_csum0 & 0xFFFF) + (uca_csum0 >> 16);
-                uca_csum1 += byteSwap16(currChunk.getLE_TData().range(47, 32));
-                uca_csum1  = (uca_csum1 & 0xFFFF) + (uca_csum1 >> 16);
-                uca_csum2 += byteSwap16(currChunk.getLE_TData().range(31, 16));
-                uca_csum2  = (uca_csum2 & 0xFFFF) + (uca_csum2 >> 16);
-                uca_csum3 += byteSwap16(currChunk.getLE_TData().range(15,  0));
-                uca_csum3  = (uca_csum3 & 0xFFFF) + (uca_csum3 >> 16);
-            }
-            if (DEBUG_LEVEL & TRACE_UCA) {
-                printAxisRaw(myName, "Received a new pseudo-header chunk: ", currChunk);
-            }
+    static CsumAcc               uca_csumAcc=0;
+    #pragma HLS RESET   variable=uca_csumAcc
+
+    if (!siTdh_Data.empty() and !soUha_Csum.full()) {
+        AxisPsd4 currChunk = siTdh_Data.read();
+        CsumAcc  csumAcc   = csumAccumulate<ARW>(uca_csumAcc, currChunk);
+        if (DEBUG_LEVEL & TRACE_UCA) {
+            printAxisRaw(myName, "Received a new pseudo-header chunk: ", currChunk);
         }
-        break;
-    case FSM_UCA_LAST:
-        uca_csum0 += byteSwap16(uca_lastChunk.getLE_TData().range(63, 48));
-        uca_csum0  = (uca_csum0 & 0xFFFF) + (uca_csum0 >> 16);
-        uca_csum1 += byteSwap16(uca_lastChunk.getLE_TData().range(47, 32));
-        uca_csum1  = (uca_csum1 & 0xFFFF) + (uca_csum1 >> 16);
-        uca_csum2 += byteSwap16(uca_lastChunk.getLE_TData().range(31, 16));
-        uca_csum2  = (uca_csum2 & 0xFFFF) + (uca_csum2 >> 16);
-        uca_csum3 += byteSwap16(uca_lastChunk.getLE_TData().range(15,  0));
-        uca_csum3  = (uca_csum3 & 0xFFFF) + (uca_csum3 >> 16);
-        uca_fsmState = FSM_UCA_DONE;
-        break;
-    case FSM_UCA_DONE:
-        if (!soUha_Csum.full()) {
-            ap_uint<17> csum01, csum23, csum0123;
-            csum01 = uca_csum0 + uca_csum1;
-            csum01 = (csum01 & 0xFFFF) + (csum01 >> 16);
-            csum23 = uca_csum2 + uca_csum3;
-            csum23 = (csum23 & 0xFFFF) + (csum23 >> 16);
-            csum0123 = csum01 + csum23;
-            csum0123 = (csum0123 & 0xFFFF) + (csum0123 >> 16);
-            csum0123 = ~csum0123;
-            soUha_Csum.write(csum0123.range(15, 0));
-            //-- Clear the csum accumulators
-            uca_csum0 = 0;
-            uca_csum1 = 0;
-            uca_csum2 = 0;
-            uca_csum3 = 0;
+        if (currChunk.getTLast()) {
+            soUha_Csum.write(csumFinalize(csumAcc));
+            //-- Clear the csum accumulator
+            uca_csumAcc = 0;
             if (DEBUG_LEVEL & TRACE_UCA) {
                 printInfo(myName, "End of pseudo-header packet.\n");
             }
-            uca_fsmState = FSM_UCA_ACCUMULATE;
-            break;
+        }
+        else {
+            uca_csumAcc = csumAcc;
         }
     }
 }
@@ -1595,6 +2149,11 @@ void pUdpHeaderAdder(
  * @details
  *  This process creates an IPv4 header and prepends it to the UDP datagram
  *  stream coming from the UdpHeaderAdder (Uha).
+ *  If the IPv4 fragmentation is enabled (see UOE_IP_FRAG), a datagram longer
+ *  than IP4_FRAG_LEN bytes is cut into fragments of IP4_FRAG_LEN bytes, each of
+ *  them being prepended with its own IPv4 header. Such fragments are numbered
+ *  with a running identification, while the non-fragmented packets keep an
+ *  identification of zero.
  *******************************************************************************/
 void pIp4HeaderAdder(
         stream<AxisUdp>     &siUha_Data,
@@ -1614,36 +2173,58 @@ void pIp4HeaderAdder(
     #pragma HLS RESET           variable=iha_fsmState
 
 
+    static Ip4Ident             iha_ip4Ident=0;
+    #pragma HLS RESET           variable=iha_ip4Ident
+    static UdpLen               iha_udpRem=0;   // Bytes of the datagram not yet fragmented
+    #pragma HLS RESET           variable=iha_udpRem
+
     //-- STATIC DATAFLOW VARIABLES --------------------------------------------
     static IpAddrPair iha_ipPair;
     static AxisUdp    iha_prevUdpChunk;
-
-    //-- DYNAMIC VARIABLES ----------------------------------------------------
-    static AxisUdp    currUdpChunk;
+    static UdpLen     iha_fragRem;  // Bytes of the current fragment not yet read
+    static UdpLen     iha_fragOff;  // Offset of the current fragment in the datagram
+    static AxisUdp    iha_currUdpChunk;
 
     switch(iha_fsmState) {
     case IPH_IP1:
-        if(!siUha_UdpLen.empty() and !siUha_Data.empty() and !siUha_IpPair.empty() and
-           !soIPTX_Data.full()) {
-            UdpLen    udpLen = siUha_UdpLen.read();
-            Ip4PktLen ip4Len = udpLen + IP4_HEADER_LEN;
+        if((!siUha_UdpLen.empty() or (iha_udpRem != 0)) and !siUha_Data.empty() and
+           (!siUha_IpPair.empty() or (iha_udpRem != 0)) and !soIPTX_Data.full()) {
+            Ip4Ident  ip4Ident = 0;
+            if (iha_udpRem == 0) {
+                //-- A new datagram
+                iha_udpRem  = siUha_UdpLen.read();
+                iha_fragOff = 0;
+                if (UOE_IP_FRAG and (iha_udpRem > IP4_FRAG_LEN)) {
+                    iha_ip4Ident++;
+                }
+            }
+            if (UOE_IP_FRAG and ((iha_fragOff != 0) or (iha_udpRem > IP4_FRAG_LEN))) {
+                ip4Ident = iha_ip4Ident;
+            }
+            iha_fragRem = (UOE_IP_FRAG and (iha_udpRem > IP4_FRAG_LEN)) ? IP4_FRAG_LEN : iha_udpRem;
+            Ip4PktLen ip4Len = iha_fragRem + IP4_HEADER_LEN;
             AxisIp4 firstIp4Chunk = AxisIp4(0, 0xFF, 0);
             firstIp4Chunk.setIp4HdrLen(5);
             firstIp4Chunk.setIp4Version(4);
             firstIp4Chunk.setIp4ToS(0);
             firstIp4Chunk.setIp4TotalLen(ip4Len);
-            firstIp4Chunk.setIp4Ident(0);
-            firstIp4Chunk.setIp4Flags(0);
-            firstIp4Chunk.setIp4FragOff(0);
+            firstIp4Chunk.setIp4Ident(ip4Ident);
+            firstIp4Chunk.setIp4Flags((iha_udpRem > iha_fragRem) ? IP4_FLAGS_MF : 0);
+            firstIp4Chunk.setIp4FragOff(iha_fragOff >> 3);
             soIPTX_Data.write(firstIp4Chunk);
+            iha_udpRem  -= iha_fragRem;
+            iha_fragOff += iha_fragRem;
             iha_fsmState = IPH_IP2;
             if (DEBUG_LEVEL & TRACE_IHA) { printInfo(myName, "IPH_IP1\n"); }
         }
     break;
     case IPH_IP2:
-        if(!siUha_IpPair.empty() and !siUha_Data.empty() and
+        if((!siUha_IpPair.empty() or (iha_fragOff != iha_fragRem)) and !siUha_Data.empty() and
            !soIPTX_Data.full()) {
-            iha_ipPair = siUha_IpPair.read();
+            if (iha_fragOff == iha_fragRem) {
+                //-- This is the first (or only) fragment of the datagram
+                iha_ipPair = siUha_IpPair.read();
+            }
             AxisIp4 secondIp4Chunk = AxisIp4(0, 0xFF, 0);
             secondIp4Chunk.setIp4TtL(0xFF);
             secondIp4Chunk.setIp4Prot(IP4_PROT_UDP);
@@ -1656,33 +2237,58 @@ void pIp4HeaderAdder(
         break;
     case IPH_IP3:
         if(!siUha_Data.empty() and !soIPTX_Data.full()) {
-            currUdpChunk = siUha_Data.read();
+            iha_currUdpChunk = siUha_Data.read();
             AxisIp4 thirdIp4Chunk = AxisIp4(0x0, 0xFF, 0);
             thirdIp4Chunk.setIp4DstAddr(iha_ipPair.ipDa);
-            thirdIp4Chunk.setUdpSrcPort(currUdpChunk.getUdpSrcPort());
-            thirdIp4Chunk.setUdpDstPort(currUdpChunk.getUdpDstPort());
+            // FYI - Holds the UDP ports or the data of a subsequent fragment
+            thirdIp4Chunk.setTDataLo(iha_currUdpChunk.getTDataHi());
+            iha_fragRem -= 8;
+            if (iha_currUdpChunk.getTLast()) {
+                //-- The last fragment is shorter than 8 bytes
+                iha_udpRem = 0;
+                if (iha_currUdpChunk.getTKeepLo() != 0) {
+                    iha_fsmState = IPH_RESIDUE;
+                }
+                else {
+                    thirdIp4Chunk.setTKeepLo(iha_currUdpChunk.getTKeepHi());
+                    thirdIp4Chunk.setTLast(TLAST);
+                    iha_fsmState = IPH_IP1;
+                }
+            }
+            else if (iha_fragRem == 0) {
+                //-- The current fragment ends with this chunk
+                iha_fsmState = IPH_RESIDUE;
+            }
+            else {
+                iha_fsmState = IPH_FORWARD;
+            }
             soIPTX_Data.write(thirdIp4Chunk);
-            iha_fsmState = IPH_FORWARD;
         }
         if (DEBUG_LEVEL & TRACE_IHA) { printInfo(myName, "IPH_IP3\n"); }
         break;
     case IPH_FORWARD:
         if(!siUha_Data.empty() and !soIPTX_Data.full()) {
-            currUdpChunk = siUha_Data.read();
+            iha_currUdpChunk = siUha_Data.read();
             AxisIp4 forwardIp4Chunk = AxisIp4(0x0, 0xFF, 0);
             forwardIp4Chunk.setTDataHi(iha_prevUdpChunk.getTDataLo());
-            forwardIp4Chunk.setTDataLo(    currUdpChunk.getTDataHi());
-            if(currUdpChunk.getTLast()) {
-                if (currUdpChunk.getTKeepLo() != 0) {
+            forwardIp4Chunk.setTDataLo(    iha_currUdpChunk.getTDataHi());
+            iha_fragRem -= 8;
+            if(iha_currUdpChunk.getTLast()) {
+                iha_udpRem = 0;
+                if (iha_currUdpChunk.getTKeepLo() != 0) {
                     iha_fsmState = IPH_RESIDUE;
                 }
                 else {
                     forwardIp4Chunk.setTKeepHi(iha_prevUdpChunk.getTKeepLo());
-                    forwardIp4Chunk.setTKeepLo(currUdpChunk.getTKeepHi());
+                    forwardIp4Chunk.setTKeepLo(iha_currUdpChunk.getTKeepHi());
                     forwardIp4Chunk.setTLast(TLAST);
                     iha_fsmState = IPH_IP1;
                 }
             }
+            else if (iha_fragRem == 0) {
+                //-- The current (non-last) fragment ends with this chunk
+                iha_fsmState = IPH_RESIDUE;
+            }
             soIPTX_Data.write(forwardIp4Chunk);
         }
         if (DEBUG_LEVEL & TRACE_IHA) { printInfo(myName, "IPH_FORWARD\n"); }
@@ -1699,7 +2305,7 @@ void pIp4HeaderAdder(
         if (DEBUG_LEVEL & TRACE_IHA) { printInfo(myName, "IPH_RESIDUE\n"); }
         break;
     }
-    iha_prevUdpChunk = currUdpChunk;
+    iha_prevUdpChunk = iha_currUdpChunk;
 }
 
 /*******************************************************************************
@@ -1742,7 +2348,7 @@ void pTxEngine(
 
     //-- Tx Datagram Handler (Tdh)
     static stream<UdpAppData>      ssTdhToUha_Data    ("ssTdhToUha_Data");
-    #pragma HLS STREAM    variable=ssTdhToUha_Data    depth=1024
+    #pragma HLS STREAM    variable=ssTdhToUha_Data    depth=cUdpTxDataFifoSize
     static stream<UdpAppMeta>      ssTdhToUha_Meta    ("ssTdhToUha_Meta");
     #pragma HLS STREAM    variable=ssTdhToUha_Meta    depth=32
     #pragma HLS DATA_PACK variable=ssTdhToUha_Meta
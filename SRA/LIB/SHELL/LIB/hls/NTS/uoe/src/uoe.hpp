@@ -71,6 +71,27 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //--  FYI: MDS is rounded modulo 8 bytes to match the chunk size.
 static const Ly4Len UDP_MDS = (MTU_ZYC2-IP4_HEADER_LEN-UDP_HEADER_LEN) & ~0x7;  // 1416
 
+//-- The MDS that can be sent by UOE when the IPv4 fragmentation is enabled
+//--  FYI: A fragment carries a multiple of 8 bytes (except the last one).
+static const Ly4Len UDP_FRAG_MDS = (0xFFFF-IP4_HEADER_LEN-UDP_HEADER_LEN) & ~0x7;  // 65504
+static const Ly4Len IP4_FRAG_LEN = (MTU_ZYC2-IP4_HEADER_LEN) & ~0x7;  // 1424
+static const Ly4Len UDP_TX_MDS   = (UOE_IP_FRAG) ? UDP_FRAG_MDS : UDP_MDS;
+
+//-- The More-Fragments (MF) bit of the IPv4 Flags
+static const Ip4Flags IP4_FLAGS_MF = 0x1;
+
+//-- Reassembly of the IPv4 fragments
+//--  One context of 64KB (i.e. 8K chunks) per datagram being reassembled.
+//--  The testbench uses a much shorter timeout.
+static const int UOE_REASM_CHUNKS = (64*1024)/(ARW/8);
+//--  One coverage bit per chunk (i.e. per 8-byte fragment block).
+static const int UOE_REASM_COVER_WORDS = UOE_REASM_CHUNKS/64;
+#ifndef __SYNTHESIS__
+  static const ap_uint<32> UOE_REASM_TIMEOUT_CYCLES = 5000;
+#else
+  static const ap_uint<32> UOE_REASM_TIMEOUT_CYCLES = (UOE_REASM_TIMEOUT_MS*1000/0.0064);
+#endif
+
 //-------------------------------------------------------------------
 //-- DEFINES FOR THE UOE INTERNAL STREAMS (can be changed)
 //-------------------------------------------------------------------
@@ -84,6 +105,7 @@ const int cUdpRxDataFifoSize = (UOE_ELASTIC_DATA_BUFFER)/(ARW/8); // Size of UDP
 const int cUdpRxHdrsFifoSize = (UOE_ELASTIC_HEADER_BUFF); // Size of the UDP Rx header buffer (in UDP headers)
 const int cIp4RxHdrsFifoSize = (cUdpRxHdrsFifoSize * 4);  // Size of the IP4 Rx header buffer (1-header=4-entries in the FiFo)
 const int cMtuSize           = (2*MTU)/(ARW/8);           // Minimum size to store one MTU
+const int cUdpTxDataFifoSize = (UOE_IP_FRAG) ? (64*1024)/(ARW/8) : 1024; // Size of UDP Tx data buffer (in chunks)
 
 /*******************************************************************************
  * INTERNAL TYPES and CLASSES USED BY TOE
@@ -205,6 +227,11 @@ class IpAddrPair {
 
 #endif  // HLS_VERSION
 
+#ifndef __SYNTHESIS__
+  void getUoeReasmStats(unsigned int &nrDgrms, unsigned int &nrEvictions,
+                        unsigned int &nrDrops);
+#endif
+
 #endif
 
 /*! \} */
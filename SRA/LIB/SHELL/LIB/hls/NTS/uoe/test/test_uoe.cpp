@@ -365,6 +365,28 @@ bool readDatagramFromFile(const char *myName,  SimUdpDatagram &appDatagram,
     return endOfDgm;
 }
 
+/*****************************************************************************
+ * @brief Build a UDP datagram from a string of bytes.
+ *
+ * @param[in]  dgrmStr  The bytes of the datagram, header included.
+ *
+ * @return the datagram as a 'SimUdpDatagram'.
+ ******************************************************************************/
+SimUdpDatagram stringToUdpDatagram(string dgrmStr)
+{
+    SimUdpDatagram udpDatagram;
+    for (int i=0; i<dgrmStr.size(); i+=8) {
+        LE_tData leData = 0;
+        LE_tKeep leKeep = 0;
+        for (int b=0; (b<8) and (i+b<dgrmStr.size()); b++) {
+            leData.range(8*b+7, 8*b) = (unsigned char)dgrmStr[i+b];
+            leKeep = leKeep | (0x01 << b);
+        }
+        udpDatagram.pushChunk(AxisUdp(leData, leKeep, (i+8 >= dgrmStr.size()) ? TLAST : 0));
+    }
+    return udpDatagram;
+}
+
 /*****************************************************************************
  * @brief Create the golden IPTX reference file from an input UAIF test file.
  *
@@ -401,6 +423,7 @@ int createGoldenTxFiles(
     int         inpChunks=0,  outChunks=0;
     int         inpDgrms=0,   outPackets=0;
     int         inpBytes=0,   outBytes=0;
+    Ip4Ident    ip4Ident=0;   // The identification of the fragmented datagrams
 
     //-- STEP-1 : OPEN INPUT TEST FILE ----------------------------------------
     if (not isDatFile(inpData_FileName)) {
@@ -457,11 +480,13 @@ int createGoldenTxFiles(
                 //-- Clone the saved UDP header
                 udpHeader.cloneHeader(savedUdpHeader);
                 //-- Adjust the datagram length of the header
-                if (appDatagram.length() <= UDP_MDS) {
+                //--  FYI - Only the datagram mode benefits from the fragmentation
+                UdpLen maxSplitLen = (tbMode == TX_DGRM_MODE) ? UDP_TX_MDS : UDP_MDS;
+                if (appDatagram.length() <= maxSplitLen) {
                     splitLen = appDatagram.length();
                 }
                 else {
-                    splitLen = UDP_MDS;
+                    splitLen = maxSplitLen;
                 }
                 udpHeader.setUdpLength(UDP_HEADER_LEN+splitLen);
                 //-- Append the UDP header
@@ -473,15 +498,38 @@ int createGoldenTxFiles(
                 ipPacket.setIpDestinationAddress(udpAppMeta.ip4DstAddr);
                 ipPacket.setIpTotalLength(ipPacket.length());
                 ipPacket.udpRecalculateChecksum();
-                // Write IPv4 packet to gold file
-                if (not ipPacket.writeToDatFile(ofsDataGold)) {
-                    printError(myName, "Failed to write IP packet to GOLD file.\n");
-                    return NTS_KO;
+                //-- Fragment the IPv4 packet if it exceeds the MTU
+                vector<SimIp4Packet> ipFrags;
+                if (ipPacket.getUdpLength() <= IP4_FRAG_LEN) {
+                    ipFrags.push_back(ipPacket);
                 }
                 else {
-                    outPackets += 1;
-                    outChunks  += ipPacket.size();
-                    outBytes   += ipPacket.length();
+                    string dgrmStr = ipPacket.getIpPayload();
+                    ip4Ident++;
+                    for (int fragOff=0; fragOff<(int)dgrmStr.size(); fragOff+=IP4_FRAG_LEN) {
+                        SimIp4Packet   ipFrag(20);
+                        SimUdpDatagram fragDgrm = stringToUdpDatagram(dgrmStr.substr(fragOff, IP4_FRAG_LEN));
+                        ipFrag.addIpPayload(fragDgrm);
+                        ipFrag.setIpSourceAddress(udpAppMeta.ip4SrcAddr);
+                        ipFrag.setIpDestinationAddress(udpAppMeta.ip4DstAddr);
+                        ipFrag.setIpTotalLength(ipFrag.length());
+                        ipFrag.setIpIdentification(ip4Ident);
+                        ipFrag.setIpFlags((fragOff+IP4_FRAG_LEN < (int)dgrmStr.size()) ? IP4_FLAGS_MF : 0);
+                        ipFrag.setIpFragmentOffset(fragOff/8);
+                        ipFrags.push_back(ipFrag);
+                    }
+                }
+                // Write IPv4 packet(s) to gold file
+                for (int i=0; i<ipFrags.size(); i++) {
+                    if (not ipFrags[i].writeToDatFile(ofsDataGold)) {
+                        printError(myName, "Failed to write IP packet to GOLD file.\n");
+                        return NTS_KO;
+                    }
+                    else {
+                        outPackets += 1;
+                        outChunks  += ipFrags[i].size();
+                        outBytes   += ipFrags[i].length();
+                    }
                 }
             }
         }
@@ -501,6 +549,55 @@ int createGoldenTxFiles(
     return NTS_OK;
 }
 
+/*****************************************************************************
+ * @brief Reassemble the IPv4 fragments of a UDP datagram.
+ *
+ * @param[in]  ip4Frag     The IPv4 fragment to process.
+ * @param[out] udpDatagram The reassembled UDP datagram.
+ * @param[in]  reasmCtxMap A ref to the fragments received so far, indexed by
+ *                          {IP_SA, IP_DA, Identification}.
+ *
+ * @return true if the datagram is complete, otherwise false.
+ ******************************************************************************/
+bool reassembleUdpDatagram(
+        SimIp4Packet           &ip4Frag,
+        SimUdpDatagram         &udpDatagram,
+        map<ReasmKey, ReasmCtx> &reasmCtxMap)
+{
+    const char *myName  = concat3(THIS_NAME, "/", "RUD");
+
+    ReasmKey  key(((unsigned long long)ip4Frag.getIpSourceAddress() << 32) |
+                   ip4Frag.getIpDestinationAddress(), ip4Frag.getIpIdentification());
+    ReasmCtx &ctx    = reasmCtxMap[key];
+    int       fragOff = ip4Frag.getIpFragmentOffset() * 8;
+    string    fragStr = ip4Frag.getIpPayload();
+    ctx.frags[fragOff] = fragStr;
+    if (not (ip4Frag.getIpFlags() & IP4_FLAGS_MF)) {
+        ctx.dgrmLen = fragOff + fragStr.size();
+    }
+    if (ctx.dgrmLen < 0) {
+        return false;
+    }
+    //-- Check that the fragments cover the entire datagram
+    string dgrmStr;
+    for (map<int, string>::iterator it=ctx.frags.begin(); it!=ctx.frags.end(); ++it) {
+        if (it->first != (int)dgrmStr.size()) {
+            return false;
+        }
+        dgrmStr += it->second;
+    }
+    if ((int)dgrmStr.size() != ctx.dgrmLen) {
+        return false;
+    }
+    if (DEBUG_LEVEL & TRACE_CGRF) {
+        printInfo(myName, "Reassembled a datagram of %d bytes from %d fragments.\n",
+                  ctx.dgrmLen, (int)ctx.frags.size());
+    }
+    reasmCtxMap.erase(key);
+    udpDatagram = stringToUdpDatagram(dgrmStr);
+    return true;
+}
+
 /*****************************************************************************
  * @brief Create the golden Rx APP reference files from an input IPRX test file.
  *
@@ -532,6 +629,7 @@ int createGoldenRxFiles(
     int         inpChunks=0,  outChunks=0;
     int         inpPackets=0, outPackets=0;
     int         inpBytes=0,   outBytes=0;
+    map<ReasmKey, ReasmCtx> reasmCtxMap;
 
     //-- STEP-1 : OPEN INPUT TEST FILE ----------------------------------------
     if (not isDatFile(inpData_FileName)) {
@@ -605,8 +703,11 @@ int createGoldenRxFiles(
         } // End-of: while ((ifsData.peek() != EOF) && (!endOfPkt))
 
         // Check consistency of the read packet
+        //  FYI - The UDP length and checksum of a fragment cannot be checked
+        bool isFragment = (ip4DataPkt.getIpFlags() & IP4_FLAGS_MF) or
+                          (ip4DataPkt.getIpFragmentOffset() != 0);
         if (endOfPkt and rc) {
-            if (not ip4DataPkt.isWellFormed(myName)) {
+            if (not ip4DataPkt.isWellFormed(myName, true, true, not isFragment, not isFragment)) {
                 printFatal(myName, "IP packet #%d is malformed!\n", inpPackets);
            }
         }
@@ -620,16 +721,38 @@ int createGoldenRxFiles(
                 continue;
             }
             // Retrieve the UDP datagram from the IPv4 Packet
-            SimUdpDatagram udpDatagram = ip4DataPkt.getUdpDatagram();
+            SimUdpDatagram udpDatagram;
+            if (isFragment) {
+                if (not UOE_IP_REASM) {
+                    printWarn(myName, "IP packet #%d is dropped because it is a fragment.\n", inpPackets);
+                    continue;
+                }
+                if (not reassembleUdpDatagram(ip4DataPkt, udpDatagram, reasmCtxMap)) {
+                    continue;
+                }
+            }
+            else {
+                udpDatagram = ip4DataPkt.getUdpDatagram();
+            }
             // Assess IPv4/UDP/Checksum field vs datagram checksum
-            UdpCsum udpHCsum = ip4DataPkt.getUdpChecksum();
+            UdpCsum udpHCsum = udpDatagram.getUdpChecksum();
             UdpCsum calcCsum = udpDatagram.reCalculateUdpChecksum(ip4DataPkt.getIpSourceAddress(),
                                                                   ip4DataPkt.getIpDestinationAddress());
+            bool csumAbort = false;
             if ((udpHCsum != 0) and (udpHCsum != calcCsum)) {
-                printWarn(myName, "IP packet #%d is dropped because the UDP checksum is invalid.\n", inpPackets);
+                if (UOE_RX_CUT_THROUGH and not isFragment) {
+                    // The payload is forwarded before the verdict which aborts it
+                    printWarn(myName, "IP packet #%d is aborted because the UDP checksum is invalid.\n", inpPackets);
+                    csumAbort = true;
+                }
+                else {
+                    printWarn(myName, "IP packet #%d is dropped because the UDP checksum is invalid.\n", inpPackets);
+                }
                 printInfo(myName, "  Received Checksum = 0x%2.2X\n", udpHCsum.to_ushort());
                 printInfo(myName, "  Expected Checksum = 0x%2.2X\n", calcCsum.to_ushort());
-                continue;
+                if (not csumAbort) {
+                    continue;
+                }
             }
 
             // Part-1: Create Metadata
@@ -645,10 +768,28 @@ int createGoldenRxFiles(
                 }
             }
             // Part-2: Update the UDP container set
-            udpPorts.insert(ip4DataPkt.getUdpDestinationPort());
+            udpPorts.insert(udpDatagram.getUdpDestinationPort());
 
             // Part-3: Write UDP datagram payload to gold file
-            if (udpDatagram.writePayloadToDatFile(ofsDataGold) == false) {
+            //  FYI - In cut-through mode, the last chunk of an invalid datagram
+            //        is replaced by a chunk with 'tlast' set and 'tkeep' cleared.
+            bool wrDone = true;
+            if (csumAbort) {
+                SimUdpDatagram abortDgrm;
+                abortDgrm.clone(udpDatagram);
+                abortDgrm.pullChunk();
+                while (abortDgrm.size() > 1) {
+                    AxisUdp udpChunk = abortDgrm.pullChunk();
+                    AxisRaw rawChunk(udpChunk.getLE_TData(), udpChunk.getLE_TKeep(), 0);
+                    wrDone &= writeAxisRawToFile(rawChunk, ofsDataGold);
+                }
+                AxisRaw abortChunk(0, 0x00, TLAST);
+                wrDone &= writeAxisRawToFile(abortChunk, ofsDataGold);
+            }
+            else {
+                wrDone = udpDatagram.writePayloadToDatFile(ofsDataGold);
+            }
+            if (wrDone == false) {
                 printError(myName, "Failed to write UDP payload to GOLD file.\n");
                 ret = NTS_KO;
             }
@@ -668,6 +809,11 @@ int createGoldenRxFiles(
         } // End-of: if (endOfPkt)
     } // End-of: while ((ifsData.peek() != EOF) && (ret != NTS_KO))
 
+    if (not reasmCtxMap.empty()) {
+        printWarn(myName, "%d fragmented datagram(s) will never complete and are expected to be dropped.\n",
+                  (int)reasmCtxMap.size());
+    }
+
     //-- STEP-4: CLOSE FILES
     ifsData.close();
     ofsDataGold.close();
@@ -1371,7 +1517,8 @@ int main(int argc, char *argv[]) {
         }
 
         //-- RUN SIMULATION FOR IPRX->UOE INPUT TRAFFIC -----------------------
-        int tbRun = (nrErr == 0) ? (nrIPRX_UOE_Chunks + TB_GRACE_TIME) : 0;
+        //  FYI - A reassembled datagram crosses the reassembly buffer twice
+        int tbRun = (nrErr == 0) ? (2*nrIPRX_UOE_Chunks + TB_GRACE_TIME) : 0;
         while (tbRun) {
             #if HLS_VERSION == 2017
             uoe_top(
@@ -1453,6 +1600,11 @@ int main(int argc, char *argv[]) {
                 printError(THIS_NAME, "Failed to drain UOE-to-MMIO drop counter from DUT. \n");
             nrErr++;
         }
+        //-- REPORT THE REASSEMBLY STATISTICS ---------------------------------
+        unsigned int nrReasmDgrms=0, nrReasmEvictions=0, nrReasmDrops=0;
+        getUoeReasmStats(nrReasmDgrms, nrReasmEvictions, nrReasmDrops);
+        printInfo(THIS_NAME, "Reassembled %d datagram(s), evicted %d context(s) and dropped %d fragment(s) or datagram(s).\n\n",
+                  nrReasmDgrms, nrReasmEvictions, nrReasmDrops);
 
         //---------------------------------------------------------------
         //-- COMPARE OUTPUT DAT and GOLD STREAMS
@@ -1531,7 +1683,8 @@ int main(int argc, char *argv[]) {
         }
 
         //-- RUN SIMULATION ---------------------------------------------------
-        int tbRun = (nrErr == 0) ? (nrUAIF_UOE_Chunks + TB_GRACE_TIME) : 0;
+        //  FYI - A fragmented datagram is stored-and-forwarded by [UOE]
+        int tbRun = (nrErr == 0) ? ((UOE_IP_FRAG ? 2 : 1)*nrUAIF_UOE_Chunks + TB_GRACE_TIME) : 0;
         while (tbRun) {
             #if HLS_VERSION == 2017
             uoe_top(
@@ -30,6 +30,7 @@
 #ifndef _TEST_UOE_H_
 #define _TEST_UOE_H_
 
+#include <map>
 #include <set>
 
 #include "../src/uoe.hpp"
@@ -63,6 +64,20 @@ enum TestMode { RX_MODE='0',    TX_DGRM_MODE='1', TX_STRM_MODE='2',
                 OPEN_MODE='3',  BIDIR_MODE='4',   ECHO_MODE='5',
                 SPARE_MODE='6', DROP_MODE='7' };
 
+//---------------------------------------------------------
+//-- TESTBENCH REASSEMBLY OF THE IPV4 FRAGMENTS
+//--  A context is indexed by {{IP_SA,IP_DA},Ident} and
+//--  holds the fragment payloads indexed by their offset.
+//---------------------------------------------------------
+typedef std::pair<unsigned long long, int> ReasmKey;
+
+class ReasmCtx {
+  public:
+    std::map<int, std::string> frags;
+    int                        dgrmLen;  // Set upon the reception of the last fragment
+    ReasmCtx() : dgrmLen(-1) {}
+};
+
 #endif
 
 /*! \} */